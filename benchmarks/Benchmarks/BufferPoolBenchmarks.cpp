@@ -0,0 +1,213 @@
+#include "../Harness/Benchmark.h"
+#include <Renderer/BufferPoolAllocator.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+    using Pool = Renderer::BufferPoolAllocator;
+
+    bool Allocate(Pool& pool, u64 size, Renderer::BufferPoolAllocation& allocation)
+    {
+        if (pool.Allocate(size, allocation))
+            return true;
+
+        pool.AddPage(Pool::GetSizeClass(size));
+        return pool.Allocate(size, allocation);
+    }
+
+    // Every size has to land in the smallest class that fits it
+    bool CheckSizeClasses()
+    {
+        bool result = true;
+
+        result &= !Pool::IsPoolable(0) && !Pool::IsPoolable(Pool::MAX_SLOT_SIZE + 1);
+        result &= Pool::IsPoolable(1) && Pool::IsPoolable(Pool::MAX_SLOT_SIZE);
+
+        for (u32 i = 0; i < Pool::NUM_SIZE_CLASSES; i++)
+        {
+            const u64 slotSize = Pool::GetSlotSize(i);
+            result &= Pool::GetSizeClass(slotSize) == i;
+            result &= i == 0 || Pool::GetSizeClass(Pool::GetSlotSize(i - 1) + 1) == i;
+            result &= slotSize % Pool::MIN_SLOT_SIZE == 0 && Pool::GetSlotsPerPage(i) * slotSize == Pool::PAGE_SIZE;
+        }
+
+        result &= Pool::GetSizeClass(1) == 0;
+        result &= Pool::GetSlotSize(Pool::NUM_SIZE_CLASSES - 1) == Pool::MAX_SLOT_SIZE;
+
+        return result;
+    }
+
+    // Allocations that share a page must not overlap and have to stay within it
+    bool CheckNoOverlap(const std::vector<Renderer::BufferPoolAllocation>& allocations)
+    {
+        std::array<std::vector<std::vector<u8>>, Pool::NUM_SIZE_CLASSES> usedSlots; // Per size class, per page, per slot
+
+        for (const Renderer::BufferPoolAllocation& allocation : allocations)
+        {
+            const u64 slotSize = Pool::GetSlotSize(allocation.sizeClass);
+            if (allocation.offset % slotSize != 0 || allocation.offset + slotSize > Pool::PAGE_SIZE || allocation.size > slotSize)
+                return false;
+
+            std::vector<std::vector<u8>>& pages = usedSlots[allocation.sizeClass];
+            if (pages.size() <= allocation.page)
+                pages.resize(allocation.page + 1);
+
+            std::vector<u8>& slots = pages[allocation.page];
+            if (slots.empty())
+                slots.resize(Pool::GetSlotsPerPage(allocation.sizeClass), 0);
+
+            if (allocation.slot >= slots.size() || slots[allocation.slot] != 0)
+                return false;
+
+            slots[allocation.slot] = 1;
+        }
+
+        return true;
+    }
+}
+
+// Arg is how many allocations of each size class are live at once, 4096 spreads the larger classes over several pages
+NC_BENCHMARK_ARGS(BufferPool, AllocateFree, { 64, 4096 })
+{
+    const u32 numPerClass = static_cast<u32>(state.GetArg());
+
+    bool result = CheckSizeClasses();
+
+    std::vector<Renderer::BufferPoolAllocation> allocations;
+    allocations.reserve(numPerClass * Pool::NUM_SIZE_CLASSES);
+
+    Pool pool;
+    Renderer::BufferPoolStats stats;
+    std::vector<u32> pageCounts(Pool::NUM_SIZE_CLASSES, 0);
+
+    while (state.KeepRunning())
+    {
+        allocations.clear();
+
+        for (u32 i = 0; i < numPerClass; i++)
+        {
+            for (u32 sizeClass = 0; sizeClass < Pool::NUM_SIZE_CLASSES; sizeClass++)
+            {
+                // Just over the previous class so every allocation loses some bytes to rounding up
+                const u64 size = sizeClass == 0 ? 200 : Pool::GetSlotSize(sizeClass - 1) + 1;
+
+                Renderer::BufferPoolAllocation& allocation = allocations.emplace_back();
+                result &= Allocate(pool, size, allocation);
+                result &= allocation.sizeClass == sizeClass;
+            }
+        }
+
+        state.PauseTiming();
+        result &= CheckNoOverlap(allocations);
+        stats = pool.GetStats();
+
+        // Freeing everything and allocating the same again must reuse the pages instead of adding new ones
+        for (u32 sizeClass = 0; sizeClass < Pool::NUM_SIZE_CLASSES; sizeClass++)
+        {
+            const u32 pageCount = pool.GetPageCount(sizeClass);
+            result &= pageCounts[sizeClass] == 0 || pageCounts[sizeClass] == pageCount;
+            pageCounts[sizeClass] = pageCount;
+        }
+        state.ResumeTiming();
+
+        for (const Renderer::BufferPoolAllocation& allocation : allocations)
+        {
+            pool.Free(allocation);
+        }
+    }
+
+    u64 requestedBytes = 0;
+    u64 usedBytes = 0;
+    for (const Renderer::BufferPoolAllocation& allocation : allocations)
+    {
+        requestedBytes += allocation.size;
+        usedBytes += Pool::GetSlotSize(allocation.sizeClass);
+    }
+
+    result &= stats.requestedBytes == requestedBytes && stats.usedBytes == usedBytes;
+    result &= stats.usedBytes <= stats.reservedBytes && stats.GetInternalFragmentation() > 0.0f;
+
+    for (u32 sizeClass = 0; sizeClass < Pool::NUM_SIZE_CLASSES; sizeClass++)
+    {
+        const Renderer::BufferPoolClassStats& classStats = stats.sizeClasses[sizeClass];
+        const u32 expectedPages = (numPerClass + Pool::GetSlotsPerPage(sizeClass) - 1) / Pool::GetSlotsPerPage(sizeClass);
+
+        result &= classStats.usedSlots == numPerClass && classStats.pages == expectedPages;
+    }
+
+    // With everything freed only MAX_EMPTY_PAGES pages per class stay around and nothing is in use
+    const Renderer::BufferPoolStats emptyStats = pool.GetStats();
+    u64 retainedBytes = 0;
+    for (u32 sizeClass = 0; sizeClass < Pool::NUM_SIZE_CLASSES; sizeClass++)
+    {
+        const u32 retainedPages = std::min(stats.sizeClasses[sizeClass].pages, Pool::MAX_EMPTY_PAGES);
+        result &= emptyStats.sizeClasses[sizeClass].pages == retainedPages;
+        retainedBytes += retainedPages * Pool::PAGE_SIZE;
+    }
+
+    result &= emptyStats.reservedBytes == retainedBytes && emptyStats.usedBytes == 0 && emptyStats.requestedBytes == 0;
+    result &= emptyStats.GetOccupancy() == 0.0f;
+
+    if (!result)
+    {
+        state.SkipWithError("BufferPoolAllocator picked the wrong size class, handed out overlapping slots, kept too many empty pages or reported the wrong stats");
+        return;
+    }
+
+    state.SetItemsPerIteration(allocations.size());
+    state.SetCounter("occupancy", stats.GetOccupancy());
+    state.SetCounter("fragmentation", stats.GetInternalFragmentation());
+}
+
+// Frees every other allocation and checks that the holes get filled before any new page is added
+NC_BENCHMARK_ARGS(BufferPool, ReuseFreedSlots, { 1, 4 })
+{
+    const u32 numPages = static_cast<u32>(state.GetArg());
+    const u32 sizeClass = 2;
+    const u64 size = Pool::GetSlotSize(sizeClass);
+    const u32 numAllocations = numPages * Pool::GetSlotsPerPage(sizeClass);
+
+    bool result = true;
+
+    std::vector<Renderer::BufferPoolAllocation> allocations(numAllocations);
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        Pool pool;
+        for (u32 i = 0; i < numAllocations; i++)
+        {
+            result &= Allocate(pool, size, allocations[i]);
+        }
+
+        // The pages are exactly full, the next allocation can't succeed without a new page
+        Renderer::BufferPoolAllocation overflow;
+        result &= pool.GetPageCount(sizeClass) == numPages && !pool.Allocate(size, overflow);
+        state.ResumeTiming();
+
+        for (u32 i = 0; i < numAllocations; i += 2)
+        {
+            pool.Free(allocations[i]);
+        }
+
+        for (u32 i = 0; i < numAllocations; i += 2)
+        {
+            result &= pool.Allocate(size, allocations[i]);
+        }
+
+        state.PauseTiming();
+        result &= pool.GetPageCount(sizeClass) == numPages && CheckNoOverlap(allocations);
+        result &= pool.GetStats().GetOccupancy() == 1.0f && pool.GetStats().GetInternalFragmentation() == 0.0f;
+        state.ResumeTiming();
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("BufferPoolAllocator added a page while freed slots were available");
+        return;
+    }
+
+    state.SetItemsPerIteration(numAllocations);
+}
@@ -0,0 +1,238 @@
+#include "../Harness/Benchmark.h"
+#include "../Fixtures/NullRenderer.h"
+#include "../Generators/CommandStreamGenerator.h"
+#include <Renderer/CommandList.h>
+#include <Renderer/RenderPassMerger.h>
+#include <Memory/StackAllocator.h>
+
+namespace
+{
+    // Feeds a generated stream through the merger the way CommandList does while recording, returns how many pipelines were merged
+    u32 ReplayRenderPasses(const Generators::CommandStream& stream, Renderer::RenderPassMerger& merger)
+    {
+        merger.Reset();
+
+        for (const Generators::GeneratedCommand& command : stream.commands)
+        {
+            switch (command.type)
+            {
+                case Generators::GeneratedCommandType::BEGIN_PIPELINE:
+                    merger.BeginPipeline(command.args[1]);
+                    break;
+                case Generators::GeneratedCommandType::END_PIPELINE:
+                    merger.EndPipeline();
+                    break;
+
+                // Plain state changes, allowed between merged pipelines
+                case Generators::GeneratedCommandType::BIND_DESCRIPTOR_SET:
+                case Generators::GeneratedCommandType::SET_VIEWPORT:
+                case Generators::GeneratedCommandType::SET_SCISSOR_RECT:
+                case Generators::GeneratedCommandType::SET_BUFFER:
+                case Generators::GeneratedCommandType::SET_INDEX_BUFFER:
+                case Generators::GeneratedCommandType::PUSH_CONSTANT:
+                case Generators::GeneratedCommandType::DRAW:
+                case Generators::GeneratedCommandType::DRAW_INDEXED:
+                    break;
+
+                default:
+                    merger.Break();
+                    break;
+            }
+        }
+
+        return merger.GetNumMergedPipelines();
+    }
+
+    // What the merger should come up with, a pipeline is merged if the last command before it that wasn't a state change ended a pipeline with the same render pass
+    u32 CountMergeablePipelines(const Generators::CommandStream& stream)
+    {
+        u32 mergeable = 0;
+        u32 endedRenderPassKey = Renderer::RenderPassMerger::NO_RENDER_PASS;
+        u32 openRenderPassKey = Renderer::RenderPassMerger::NO_RENDER_PASS;
+        bool isPipelineOpen = false;
+
+        for (const Generators::GeneratedCommand& command : stream.commands)
+        {
+            switch (command.type)
+            {
+                case Generators::GeneratedCommandType::BEGIN_PIPELINE:
+                    mergeable += endedRenderPassKey == command.args[1] ? 1 : 0;
+                    openRenderPassKey = command.args[1];
+                    endedRenderPassKey = Renderer::RenderPassMerger::NO_RENDER_PASS;
+                    isPipelineOpen = true;
+                    break;
+                case Generators::GeneratedCommandType::END_PIPELINE:
+                    endedRenderPassKey = openRenderPassKey;
+                    isPipelineOpen = false;
+                    break;
+                case Generators::GeneratedCommandType::BIND_DESCRIPTOR_SET:
+                case Generators::GeneratedCommandType::SET_VIEWPORT:
+                case Generators::GeneratedCommandType::SET_SCISSOR_RECT:
+                case Generators::GeneratedCommandType::SET_BUFFER:
+                case Generators::GeneratedCommandType::SET_INDEX_BUFFER:
+                case Generators::GeneratedCommandType::PUSH_CONSTANT:
+                case Generators::GeneratedCommandType::DRAW:
+                case Generators::GeneratedCommandType::DRAW_INDEXED:
+                    break;
+                default:
+                    if (!isPipelineOpen)
+                    {
+                        endedRenderPassKey = Renderer::RenderPassMerger::NO_RENDER_PASS;
+                    }
+                    break;
+            }
+        }
+
+        return mergeable;
+    }
+}
+
+NC_BENCHMARK_ARGS(CommandList, Record, { 64, 256, 1024 })
+{
+    Generators::CommandStreamGeneratorDesc desc;
+    desc.drawsPerPass = static_cast<u32>(state.GetArg());
+
+    Generators::CommandStream stream;
+    Generators::CommandStreamGenerator::Generate(desc, stream);
+
+    Memory::StackAllocator allocator(stream.estimatedAllocationSize);
+    allocator.Init();
+
+    while (state.KeepRunning())
+    {
+        // Same as the frame allocator, everything recorded gets thrown away at the start of the next frame
+        allocator.Reset();
+
+        Renderer::CommandList commandList(nullptr, &allocator);
+        Generators::CommandStreamGenerator::Record(stream, commandList);
+
+        Benchmark::DoNotOptimize(commandList);
+    }
+
+    state.SetItemsPerIteration(stream.commands.size());
+    state.SetCounter("commands", static_cast<f64>(stream.commands.size()));
+}
+
+// Replays recorded streams through the render pass merge decisions, with every pass switching pipelines as often as the argument says
+NC_BENCHMARK_ARGS(CommandList, MergeRenderPasses, { 1, 4, 16 })
+{
+    Generators::CommandStreamGeneratorDesc desc;
+    desc.numPasses = 64;
+    desc.drawsPerPass = 16;
+    desc.pipelinesPerPass = static_cast<u32>(state.GetArg());
+
+    Generators::CommandStream stream;
+    Generators::CommandStreamGenerator::Generate(desc, stream);
+
+    u32 numPipelines = 0;
+    for (const Generators::GeneratedCommand& command : stream.commands)
+    {
+        numPipelines += command.type == Generators::GeneratedCommandType::BEGIN_PIPELINE ? 1 : 0;
+    }
+
+    Renderer::RenderPassMerger merger;
+    u32 merged = 0;
+    while (state.KeepRunning())
+    {
+        merged = ReplayRenderPasses(stream, merger);
+    }
+
+    if (merged != CountMergeablePipelines(stream) || merger.GetNumRenderPasses() + merged != numPipelines)
+    {
+        state.SkipWithError("The merger didn't merge exactly the pipelines that share a render pass with the pipeline before them");
+        return;
+    }
+
+    state.SetItemsPerIteration(stream.commands.size());
+    state.SetCounter("pipelines", static_cast<f64>(numPipelines));
+    state.SetCounter("renderPasses", static_cast<f64>(merger.GetNumRenderPasses()));
+}
+
+// Executes recorded streams on a renderer that does nothing and checks that BackendDispatch counted every draw, bind, descriptor and copy
+NC_BENCHMARK_ARGS(CommandList, ExecuteNullBackend, { 64, 256 })
+{
+    Generators::CommandStreamGeneratorDesc desc;
+    desc.drawsPerPass = static_cast<u32>(state.GetArg());
+    desc.pipelinesPerPass = 4;
+
+    Generators::CommandStream stream;
+    Generators::CommandStreamGenerator::Generate(desc, stream);
+
+    Fixtures::NullRenderer renderer;
+    Renderer::RenderStats expected;
+    u32 numGraphicsPipelines = 0;
+
+    for (const Generators::GeneratedCommand& command : stream.commands)
+    {
+        switch (command.type)
+        {
+            case Generators::GeneratedCommandType::BEGIN_PIPELINE:
+                if (command.args[0] >= renderer.renderPassKeys.size())
+                {
+                    renderer.renderPassKeys.resize(command.args[0] + 1, Renderer::RenderPassMerger::NO_RENDER_PASS);
+                }
+                renderer.renderPassKeys[command.args[0]] = command.args[1];
+                expected.pipelineBinds++;
+                numGraphicsPipelines++;
+                break;
+            case Generators::GeneratedCommandType::BIND_COMPUTE_PIPELINE:
+                expected.pipelineBinds++;
+                break;
+            case Generators::GeneratedCommandType::BIND_DESCRIPTOR_SET:
+                expected.descriptorWrites += static_cast<u32>(stream.descriptorSets[command.args[1]].GetDescriptors().size());
+                break;
+            case Generators::GeneratedCommandType::DRAW:
+            case Generators::GeneratedCommandType::DRAW_INDEXED:
+                expected.drawCalls++;
+                break;
+            case Generators::GeneratedCommandType::COPY_BUFFER:
+                expected.stagingBytes += command.args[2];
+                break;
+            default:
+                break;
+        }
+    }
+    expected.mergedRenderPasses = CountMergeablePipelines(stream);
+
+    Memory::StackAllocator allocator(stream.estimatedAllocationSize);
+    allocator.Init();
+
+    Renderer::RenderStats stats;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        allocator.Reset();
+        renderer.GetFrameStats().Reset();
+
+        Renderer::CommandList commandList(&renderer, &allocator);
+        Generators::CommandStreamGenerator::Record(stream, commandList);
+        state.ResumeTiming();
+
+        commandList.Execute();
+        stats = renderer.GetFrameStats();
+    }
+
+#if NC_RENDER_PROFILING
+    const bool counted = stats.drawCalls == expected.drawCalls &&
+        stats.pipelineBinds == expected.pipelineBinds &&
+        stats.descriptorWrites == expected.descriptorWrites &&
+        stats.stagingBytes == expected.stagingBytes &&
+        stats.mergedRenderPasses == expected.mergedRenderPasses &&
+        stats.renderPasses + stats.mergedRenderPasses == numGraphicsPipelines;
+#else
+    // With render profiling compiled out nothing may be counted
+    const bool counted = stats.drawCalls == 0 && stats.pipelineBinds == 0 && stats.descriptorWrites == 0 && stats.stagingBytes == 0 && stats.renderPasses == 0;
+#endif
+
+    if (!counted)
+    {
+        state.SkipWithError("The render counters don't match the commands that were executed");
+        return;
+    }
+
+    state.SetItemsPerIteration(stream.commands.size());
+    state.SetCounter("drawCalls", static_cast<f64>(stats.drawCalls));
+    state.SetCounter("pipelineBinds", static_cast<f64>(stats.pipelineBinds));
+    state.SetCounter("descriptorWrites", static_cast<f64>(stats.descriptorWrites));
+    state.SetCounter("renderPasses", static_cast<f64>(stats.renderPasses));
+}
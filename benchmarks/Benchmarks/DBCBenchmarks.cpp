@@ -0,0 +1,277 @@
+#include "../Harness/Benchmark.h"
+#include "../Harness/MemoryUsage.h"
+#include <DataGen/DBCGenerator.h>
+#include <Utils/ByteBuffer.h>
+#include <Utils/StringUtils.h>
+#include <Containers/StringTable.h>
+#include <robin_hood.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+
+#include "../../client/Gameplay/DBC/DBCLoader.h"
+#include "../../client/Gameplay/DBC/DBCTable.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr u32 NUM_ROWS = 100000;
+    constexpr u32 NUM_LOOKUPS = 1000000;
+
+    // Writes a Maps.ndbc with NUM_ROWS rows once per id stride, a stride of 1 gives dense ids
+    fs::path GetDBCPath(u32 idStride)
+    {
+        static robin_hood::unordered_map<u32, fs::path> paths;
+
+        auto itr = paths.find(idStride);
+        if (itr != paths.end())
+            return itr->second;
+
+        const fs::path directory = fs::temp_directory_path() / "NovusCoreBenchmarks" / "DBC";
+        std::error_code errorCode;
+        fs::create_directories(directory, errorCode);
+
+        std::vector<Generators::GeneratedMapEntry> entries(NUM_ROWS);
+        for (u32 i = 0; i < NUM_ROWS; i++)
+        {
+            entries[i].id = i * idStride;
+            entries[i].name = "Map " + std::to_string(i);
+            entries[i].internalName = "Map_" + std::to_string(i);
+        }
+
+        // Extractors don't write rows sorted by id, neither do we
+        std::shuffle(entries.begin(), entries.end(), std::mt19937(idStride));
+
+        fs::path path = directory / ("Maps_" + std::to_string(idStride) + ".ndbc");
+        Generators::DBCGenerator::WriteMapsDBC(path, entries);
+
+        return paths[idStride] = path;
+    }
+
+    // How Maps.ndbc used to be loaded, the whole file copied into memory and the lookups built by hand in robin_hood maps
+    struct CopiedMapTable
+    {
+        std::vector<DBC::Map> rows;
+        StringTable stringTable;
+
+        robin_hood::unordered_map<u32, DBC::Map*> idToRow;
+        robin_hood::unordered_map<u32, DBC::Map*> nameToRow;
+        robin_hood::unordered_map<u32, DBC::Map*> internalNameToRow;
+    };
+
+    bool LoadCopied(const fs::path& path, CopiedMapTable& table)
+    {
+        std::ifstream file(path, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+        if (!file)
+            return false;
+
+        std::vector<u8> data(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+        Bytebuffer buffer(data.data(), data.size());
+        buffer.writtenData = data.size();
+
+        DBC::DBCHeader header;
+        buffer.Get<DBC::DBCHeader>(header);
+
+        u32 numRows = 0;
+        buffer.GetU32(numRows);
+
+        table.rows.resize(numRows);
+        buffer.GetBytes(reinterpret_cast<u8*>(table.rows.data()), sizeof(DBC::Map) * numRows);
+        table.stringTable.Deserialize(&buffer);
+
+        for (DBC::Map& map : table.rows)
+        {
+            table.idToRow[map.Id] = &map;
+            table.nameToRow[table.stringTable.GetStringHash(map.Name)] = &map;
+            table.internalNameToRow[table.stringTable.GetStringHash(map.InternalName)] = &map;
+        }
+
+        return true;
+    }
+
+    bool LoadMapped(const fs::path& path, DBCTable<DBC::Map>& table)
+    {
+        DBC::File file;
+        return DBCLoader::LoadFile(path, file) && table.Load(file);
+    }
+
+    // Ids of existing rows in a random order, with every eighth lookup missing
+    std::vector<u32> GenerateLookupIds(u32 idStride)
+    {
+        std::mt19937 random(1337);
+        std::uniform_int_distribution<u32> rowDistribution(0, NUM_ROWS - 1);
+
+        std::vector<u32> ids(NUM_LOOKUPS);
+        for (u32 i = 0; i < NUM_LOOKUPS; i++)
+        {
+            ids[i] = (i % 8 == 7) ? NUM_ROWS * idStride + i : rowDistribution(random) * idStride;
+        }
+
+        return ids;
+    }
+}
+
+// Loads a 100k row Maps.ndbc the way it used to be loaded, compare against LoadMapped
+NC_BENCHMARK(DBC, LoadCopied)
+{
+    const fs::path path = GetDBCPath(1);
+
+    u64 residentBytes = 0;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        std::unique_ptr<CopiedMapTable> table = std::make_unique<CopiedMapTable>();
+        const u64 residentBefore = Benchmark::MemoryUsage::GetResidentBytes();
+        state.ResumeTiming();
+
+        if (!LoadCopied(path, *table))
+        {
+            state.SkipWithError("Failed to load the generated dbc");
+            return;
+        }
+
+        state.PauseTiming();
+        residentBytes = Benchmark::MemoryUsage::GetResidentBytes() - residentBefore;
+        table = nullptr;
+        state.ResumeTiming();
+    }
+
+    state.SetCounter("residentBytes", static_cast<f64>(residentBytes));
+    state.SetItemsPerIteration(NUM_ROWS);
+}
+
+NC_BENCHMARK(DBC, LoadMapped)
+{
+    const fs::path path = GetDBCPath(1);
+
+    u64 residentBytes = 0;
+    size_t indexBytes = 0;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        std::unique_ptr<DBCTable<DBC::Map>> table = std::make_unique<DBCTable<DBC::Map>>();
+        const u64 residentBefore = Benchmark::MemoryUsage::GetResidentBytes();
+        state.ResumeTiming();
+
+        if (!LoadMapped(path, *table))
+        {
+            state.SkipWithError("Failed to load the generated dbc");
+            return;
+        }
+
+        state.PauseTiming();
+        residentBytes = Benchmark::MemoryUsage::GetResidentBytes() - residentBefore;
+        indexBytes = table->GetIndexMemoryUsage();
+        table = nullptr;
+        state.ResumeTiming();
+    }
+
+    // Resident bytes include the pages of the mapping that building the indexes touched
+    state.SetCounter("residentBytes", static_cast<f64>(residentBytes));
+    state.SetCounter("indexBytes", static_cast<f64>(indexBytes));
+    state.SetItemsPerIteration(NUM_ROWS);
+}
+
+// The argument is the id stride, 1 gives the direct id table and 16 the sorted fallback, compare against LookupByIdHashMap
+NC_BENCHMARK_ARGS(DBC, LookupById, { 1, 16 })
+{
+    const u32 idStride = static_cast<u32>(state.GetArg());
+
+    DBCTable<DBC::Map> table;
+    if (!LoadMapped(GetDBCPath(idStride), table))
+    {
+        state.SkipWithError("Failed to load the generated dbc");
+        return;
+    }
+
+    const std::vector<u32> ids = GenerateLookupIds(idStride);
+
+    u32 numFound = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 id : ids)
+        {
+            const DBC::Map* map = table.GetById(id);
+            numFound += map != nullptr;
+            Benchmark::DoNotOptimize(map);
+        }
+    }
+
+    Benchmark::DoNotOptimize(numFound);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
+
+NC_BENCHMARK_ARGS(DBC, LookupByIdHashMap, { 1, 16 })
+{
+    const u32 idStride = static_cast<u32>(state.GetArg());
+
+    CopiedMapTable table;
+    if (!LoadCopied(GetDBCPath(idStride), table))
+    {
+        state.SkipWithError("Failed to load the generated dbc");
+        return;
+    }
+
+    const std::vector<u32> ids = GenerateLookupIds(idStride);
+
+    u32 numFound = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 id : ids)
+        {
+            auto itr = table.idToRow.find(id);
+            const DBC::Map* map = itr != table.idToRow.end() ? itr->second : nullptr;
+            numFound += map != nullptr;
+            Benchmark::DoNotOptimize(map);
+        }
+    }
+
+    Benchmark::DoNotOptimize(numFound);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
+
+// Secondary index lookups by internal name hash, the way MapLoader::LoadMap finds maps
+NC_BENCHMARK(DBC, LookupByInternalName)
+{
+    DBCTable<DBC::Map> table;
+    if (!LoadMapped(GetDBCPath(1), table))
+    {
+        state.SkipWithError("Failed to load the generated dbc");
+        return;
+    }
+
+    std::mt19937 random(1337);
+    std::uniform_int_distribution<u32> rowDistribution(0, NUM_ROWS - 1);
+
+    std::vector<u32> nameHashes(NUM_LOOKUPS);
+    for (u32& nameHash : nameHashes)
+    {
+        const std::string internalName = "Map_" + std::to_string(rowDistribution(random));
+        nameHash = StringUtils::fnv1a_32(internalName.c_str(), internalName.size());
+    }
+
+    u32 numFound = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 nameHash : nameHashes)
+        {
+            const DBC::Map* map = table.GetByIndex(DBC::Map::InternalNameIndex, nameHash);
+            numFound += map != nullptr;
+            Benchmark::DoNotOptimize(map);
+        }
+    }
+
+    if (numFound == 0)
+    {
+        state.SkipWithError("No internal names were found, the index doesn't match StringTable's hashes");
+        return;
+    }
+
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
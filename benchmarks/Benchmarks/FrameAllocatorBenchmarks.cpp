@@ -0,0 +1,137 @@
+#include "../Harness/Benchmark.h"
+#include <Renderer/FrameAllocator.h>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr size_t ARENA_SIZE = 64 * 1024;
+    constexpr size_t ALLOCATION_SIZE = 48; // Not a multiple of the default alignment so padding gets counted too
+
+    struct Allocation
+    {
+        u8* ptr;
+        size_t size;
+    };
+
+    // Allocates one frame worth of data and tags every allocation with its index so overlapping allocations show up when verifying
+    bool AllocateFrame(Renderer::FrameAllocator& allocator, size_t numAllocations, std::vector<Allocation>& allocations)
+    {
+        allocations.clear();
+
+        for (size_t i = 0; i < numAllocations; i++)
+        {
+            u8* ptr = static_cast<u8*>(allocator.Allocate(ALLOCATION_SIZE));
+            if (ptr == nullptr || reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t) != 0)
+                return false;
+
+            memset(ptr, static_cast<int>(i & 0xff), ALLOCATION_SIZE);
+            allocations.push_back({ ptr, ALLOCATION_SIZE });
+        }
+
+        for (size_t i = 0; i < allocations.size(); i++)
+        {
+            for (size_t j = 0; j < allocations[i].size; j++)
+            {
+                if (allocations[i].ptr[j] != static_cast<u8>(i & 0xff))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+// Arg is allocations per frame, all of them fit in the arena
+NC_BENCHMARK_ARGS(FrameAllocator, AllocateReset, { 64, 1024 })
+{
+    const size_t numAllocations = static_cast<size_t>(state.GetArg());
+
+    Renderer::FrameAllocator allocator(ARENA_SIZE);
+    allocator.Init();
+
+    std::vector<Allocation> allocations;
+    allocations.reserve(numAllocations);
+
+    bool result = true;
+    size_t allocatedBytes = 0;
+
+    while (state.KeepRunning())
+    {
+        allocator.Reset();
+
+        allocator.BeginScope("Frame", 5);
+        result &= AllocateFrame(allocator, numAllocations, allocations);
+        allocator.EndScope();
+
+        allocatedBytes = allocator.GetAllocatedBytes();
+    }
+
+    const Renderer::FrameAllocatorStats& stats = allocator.GetStats();
+    const std::vector<Renderer::FrameAllocatorScopeUsage>& scopeUsage = allocator.GetScopeUsage();
+
+    result &= allocatedBytes >= numAllocations * ALLOCATION_SIZE;
+    result &= stats.overflowBytes == 0 && stats.overflowBlocks == 0 && stats.framesOverflowed == 0;
+    result &= scopeUsage.size() == 1 && scopeUsage[0].bytes == allocatedBytes;
+
+    // Reset has to hand the frame over to the last frame stats and start the next one empty
+    allocator.Reset();
+    result &= allocator.GetAllocatedBytes() == 0 && stats.lastFrameHighWatermark == allocatedBytes && stats.allTimeHighWatermark == allocatedBytes;
+    result &= allocator.GetScopeUsage().empty() && allocator.GetLastFrameScopeUsage().size() == 1;
+
+    if (!result)
+    {
+        state.SkipWithError("FrameAllocator handed out overlapping memory or reported the wrong usage");
+        return;
+    }
+
+    state.SetItemsPerIteration(numAllocations);
+    state.SetCounter("allocated KB", allocatedBytes / 1024.0);
+}
+
+// Arg is how many times the arena size one frame allocates, everything past the arena has to chain into overflow blocks
+NC_BENCHMARK_ARGS(FrameAllocator, Overflow, { 2, 8 })
+{
+    const size_t numAllocations = (ARENA_SIZE * static_cast<size_t>(state.GetArg())) / ALLOCATION_SIZE;
+
+    Renderer::FrameAllocator allocator(ARENA_SIZE);
+    allocator.Init();
+
+    std::vector<Allocation> allocations;
+    allocations.reserve(numAllocations);
+
+    // The first frame creates the overflow blocks, later frames have to reuse them
+    bool result = AllocateFrame(allocator, numAllocations, allocations);
+
+    const u32 overflowBlocks = allocator.GetStats().overflowBlocks;
+    const size_t overflowBytes = allocator.GetStats().overflowBytes;
+    const u8* lastAllocation = allocations.back().ptr;
+
+    result &= overflowBlocks > 0 && overflowBytes > 0 && overflowBytes < allocator.GetAllocatedBytes();
+
+    while (state.KeepRunning())
+    {
+        allocator.Reset();
+        result &= AllocateFrame(allocator, numAllocations, allocations);
+    }
+
+    const Renderer::FrameAllocatorStats& stats = allocator.GetStats();
+    result &= stats.overflowBlocks == overflowBlocks && stats.overflowBytes == overflowBytes;
+    result &= allocations.back().ptr == lastAllocation;
+
+    allocator.Reset();
+    result &= stats.lastFrameOverflowBytes == overflowBytes && stats.allTimeOverflowBytes == overflowBytes;
+    result &= stats.framesOverflowed == stats.frames;
+    result &= stats.overflowBlocks == 0 && allocator.GetAllocatedBytes() == 0;
+
+    if (!result)
+    {
+        state.SkipWithError("FrameAllocator didn't chain and reuse its overflow blocks the way it should");
+        return;
+    }
+
+    state.SetItemsPerIteration(numAllocations);
+    state.SetCounter("overflow blocks", overflowBlocks);
+    state.SetCounter("overflow KB", overflowBytes / 1024.0);
+}
@@ -0,0 +1,527 @@
+#include "../Harness/Benchmark.h"
+#include <InputManager.h>
+#include <Utils/StringUtils.h>
+#include <GLFW/glfw3.h>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <robin_hood.h>
+
+namespace
+{
+    constexpr u32 NUM_KEYBINDS = 500;
+    constexpr u32 NUM_EVENTS = 10000;
+    constexpr u32 NUM_FRAMES = 1000;
+
+    // Keys the generated keybinds are spread over, a handful of keybinds end up on every key
+    const i32 KEYS[] = { GLFW_KEY_A, GLFW_KEY_B, GLFW_KEY_C, GLFW_KEY_D, GLFW_KEY_E, GLFW_KEY_F, GLFW_KEY_G, GLFW_KEY_H, GLFW_KEY_I, GLFW_KEY_J,
+                         GLFW_KEY_K, GLFW_KEY_L, GLFW_KEY_M, GLFW_KEY_N, GLFW_KEY_O, GLFW_KEY_P, GLFW_KEY_Q, GLFW_KEY_R, GLFW_KEY_S, GLFW_KEY_T,
+                         GLFW_KEY_U, GLFW_KEY_V, GLFW_KEY_W, GLFW_KEY_X, GLFW_KEY_Y, GLFW_KEY_Z, GLFW_KEY_F1, GLFW_KEY_F2, GLFW_KEY_F3, GLFW_KEY_F4,
+                         GLFW_KEY_F5, GLFW_KEY_F6, GLFW_KEY_F7, GLFW_KEY_F8, GLFW_KEY_F9, GLFW_KEY_F10, GLFW_KEY_F11, GLFW_KEY_F12, GLFW_KEY_SPACE,
+                         GLFW_KEY_TAB, GLFW_KEY_LEFT_SHIFT, GLFW_KEY_LEFT_CONTROL, GLFW_KEY_LEFT_ALT, GLFW_KEY_ENTER, GLFW_KEY_ESCAPE,
+                         GLFW_KEY_UP, GLFW_KEY_DOWN, GLFW_KEY_LEFT, GLFW_KEY_RIGHT, GLFW_KEY_PAGE_UP };
+    constexpr u32 NUM_KEYS = sizeof(KEYS) / sizeof(KEYS[0]);
+
+    std::string GetKeybindTitle(u32 index)
+    {
+        return "Benchmark Keybind " + std::to_string(index);
+    }
+
+    struct KeyEvent
+    {
+        i32 key;
+        i32 action;
+    };
+
+    // Alternating presses and releases of random keys, with every eighth press repeated while held
+    std::vector<KeyEvent> GenerateEvents()
+    {
+        std::mt19937 random(1337);
+        std::uniform_int_distribution<u32> keyDistribution(0, NUM_KEYS - 1);
+
+        std::vector<KeyEvent> events;
+        events.reserve(NUM_EVENTS);
+
+        while (events.size() + 3 <= NUM_EVENTS)
+        {
+            const i32 key = KEYS[keyDistribution(random)];
+            events.push_back({ key, GLFW_PRESS });
+            if (events.size() % 8 == 1)
+            {
+                events.push_back({ key, GLFW_REPEAT });
+            }
+            events.push_back({ key, GLFW_RELEASE });
+        }
+
+        return events;
+    }
+
+    // How InputManager used to store keybinds, a map per key of shared_ptrs that were copied for every keybind that was dispatched
+    class LegacyKeybindTable
+    {
+    public:
+        struct LegacyKeybind;
+        using Callback = std::function<bool(Window*, std::shared_ptr<LegacyKeybind>)>;
+
+        struct LegacyKeybind
+        {
+            i32 actionMask;
+            i32 modifierMask;
+            i32 state;
+            Callback callback;
+        };
+
+        void Register(const std::string& title, i32 key, i32 actionMask, i32 modifierMask, Callback callback)
+        {
+            const u32 titleHash = StringUtils::fnv1a_32(title.c_str(), title.length());
+
+            std::shared_ptr<LegacyKeybind> keybind = std::make_shared<LegacyKeybind>(LegacyKeybind{ actionMask, modifierMask, 0, callback });
+            _keyToKeybindMap[key][titleHash] = keybind;
+            _titleToKeybindMap[titleHash] = keybind;
+        }
+
+        void KeyboardInputHandler(Window* window, i32 key, i32 actionMask, i32 modifierMask)
+        {
+            for (auto kv : _keyToKeybindMap[key])
+            {
+                auto inputBinding = kv.second;
+
+                if (actionMask == GLFW_RELEASE)
+                    inputBinding->state = 0;
+
+                bool validModifier = inputBinding->modifierMask == KEYBIND_MOD_ANY || inputBinding->modifierMask & modifierMask || inputBinding->modifierMask == 0 && modifierMask == 0;
+                if ((inputBinding->actionMask & (1 << actionMask)) && validModifier)
+                {
+                    inputBinding->state = actionMask == GLFW_RELEASE ? 0 : 1;
+
+                    if (!inputBinding->callback)
+                        continue;
+
+                    if (inputBinding->callback(window, inputBinding))
+                        return;
+                }
+            }
+        }
+
+        bool IsKeyPressed(u32 titleHash)
+        {
+            return _titleToKeybindMap[titleHash]->state;
+        }
+
+    private:
+        robin_hood::unordered_map<i32, robin_hood::unordered_map<u32, std::shared_ptr<LegacyKeybind>>> _keyToKeybindMap;
+        robin_hood::unordered_map<u32, std::shared_ptr<LegacyKeybind>> _titleToKeybindMap;
+    };
+
+    // Every third keybind has a callback, none of them consume the input so every keybind on the key is visited
+    u32 callbackCount = 0;
+
+    void RegisterKeybinds(InputManager& inputManager, std::vector<KeybindHandle>& handles)
+    {
+        for (u32 i = 0; i < NUM_KEYBINDS; i++)
+        {
+            std::function<KeybindCallbackFunc> callback = nullptr;
+            if (i % 3 == 0)
+            {
+                callback = [](Window* window, Keybind* keybind) { callbackCount += keybind->state; return false; };
+            }
+
+            handles.push_back(inputManager.RegisterKeybind(GetKeybindTitle(i), KEYS[i % NUM_KEYS], KEYBIND_ACTION_CLICK, KEYBIND_MOD_ANY, callback));
+        }
+    }
+
+    void RegisterKeybinds(LegacyKeybindTable& table)
+    {
+        for (u32 i = 0; i < NUM_KEYBINDS; i++)
+        {
+            LegacyKeybindTable::Callback callback = nullptr;
+            if (i % 3 == 0)
+            {
+                callback = [](Window* window, std::shared_ptr<LegacyKeybindTable::LegacyKeybind> keybind) { callbackCount += keybind->state; return false; };
+            }
+
+            table.Register(GetKeybindTitle(i), KEYS[i % NUM_KEYS], KEYBIND_ACTION_CLICK, KEYBIND_MOD_ANY, callback);
+        }
+    }
+
+    std::vector<u32> GetTitleHashes()
+    {
+        std::vector<u32> titleHashes(NUM_KEYBINDS);
+        for (u32 i = 0; i < NUM_KEYBINDS; i++)
+        {
+            const std::string title = GetKeybindTitle(i);
+            titleHashes[i] = StringUtils::fnv1a_32(title.c_str(), title.length());
+        }
+
+        return titleHashes;
+    }
+
+    constexpr u32 NUM_SCENARIO_FRAMES = 3600; // A minute at 60 fps
+    constexpr f32 SCENARIO_DELTA_TIME = 1.0f / 60.0f;
+
+    // A flight across the map the way CameraFreeLook flies it and a text box being typed into, with nothing but the InputManager
+    // underneath so the same frames can be replayed without a window. The checksum is compared between the recorded and replayed run
+    class HeadlessScenario
+    {
+    public:
+        HeadlessScenario()
+        {
+            _forwardKeybind = _inputManager.RegisterKeybind("Scenario Forward", GLFW_KEY_W, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+            _backwardKeybind = _inputManager.RegisterKeybind("Scenario Backward", GLFW_KEY_S, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+            _leftKeybind = _inputManager.RegisterKeybind("Scenario Left", GLFW_KEY_A, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+            _rightKeybind = _inputManager.RegisterKeybind("Scenario Right", GLFW_KEY_D, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+            _upKeybind = _inputManager.RegisterKeybind("Scenario Up", GLFW_KEY_SPACE, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+
+            _inputManager.RegisterMousePositionCallback("Scenario MouseLook", [this](Window* window, f32 x, f32 y)
+            {
+                _yaw -= (x - _prevMouseX) * 0.05f;
+                _pitch = std::fmin(std::fmax(_pitch - (y - _prevMouseY) * 0.05f, -89.0f), 89.0f);
+                _prevMouseX = x;
+                _prevMouseY = y;
+            });
+            _inputManager.RegisterMouseScrollCallback("Scenario Speed", [this](Window* window, f32 x, f32 y)
+            {
+                _movementSpeed = std::fmax(_movementSpeed + y * 10.0f, 7.1111f);
+            });
+
+            _inputManager.RegisterCharInputCallback("Scenario Text"_h, [this](Window* window, u32 unicodeKey)
+            {
+                _text.push_back(static_cast<char>(unicodeKey));
+                return true;
+            });
+            _inputManager.RegisterKeybind("Scenario Backspace", GLFW_KEY_BACKSPACE, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
+            {
+                if (!_text.empty())
+                    _text.pop_back();
+
+                return true;
+            });
+        }
+
+        InputManager& GetInputManager() { return _inputManager; }
+
+        void Update()
+        {
+            const f32 yaw = _yaw * 0.0174533f;
+            const f32 pitch = _pitch * 0.0174533f;
+            const vec3 front = vec3(std::cos(yaw) * std::cos(pitch), std::sin(pitch), std::sin(yaw) * std::cos(pitch));
+            const vec3 left = vec3(front.z, 0.0f, -front.x);
+            const f32 distance = _movementSpeed * SCENARIO_DELTA_TIME;
+
+            if (_inputManager.IsKeyPressed(_forwardKeybind))
+                _position += front * distance;
+            if (_inputManager.IsKeyPressed(_backwardKeybind))
+                _position -= front * distance;
+            if (_inputManager.IsKeyPressed(_leftKeybind))
+                _position += left * distance;
+            if (_inputManager.IsKeyPressed(_rightKeybind))
+                _position -= left * distance;
+            if (_inputManager.IsKeyPressed(_upKeybind))
+                _position.y += distance;
+        }
+
+        u32 GetChecksum() const
+        {
+            u32 checksum = StringUtils::fnv1a_32(_text.c_str(), _text.length());
+            checksum ^= StringUtils::fnv1a_32(reinterpret_cast<const char*>(&_position), sizeof(vec3)) * 16777619u;
+            return checksum;
+        }
+
+    private:
+        InputManager _inputManager;
+        KeybindHandle _forwardKeybind;
+        KeybindHandle _backwardKeybind;
+        KeybindHandle _leftKeybind;
+        KeybindHandle _rightKeybind;
+        KeybindHandle _upKeybind;
+
+        vec3 _position = vec3(0.0f, 0.0f, 0.0f);
+        f32 _yaw = 0.0f;
+        f32 _pitch = 0.0f;
+        f32 _prevMouseX = 0.0f;
+        f32 _prevMouseY = 0.0f;
+        f32 _movementSpeed = 7.1111f;
+        std::string _text;
+    };
+
+    // Plays the generated input into the handlers the way GLFW would and records it. Generators send at least one event every
+    // frame, a replay ends with its last recorded event and would otherwise run fewer frames than the recording
+    using GenerateFrameFunc = void(InputManager& inputManager, u32 frame, std::mt19937& random);
+
+    bool RecordScenario(const std::filesystem::path& path, GenerateFrameFunc* generateFrame, u32& checksum)
+    {
+        HeadlessScenario scenario;
+        InputManager& inputManager = scenario.GetInputManager();
+        if (!inputManager.GetRecorder().Open(path))
+            return false;
+
+        std::mt19937 random(1337);
+        for (u32 frame = 0; frame < NUM_SCENARIO_FRAMES; frame++)
+        {
+            if (frame > 0)
+            {
+                inputManager.BeginFrame(nullptr);
+            }
+
+            generateFrame(inputManager, frame, random);
+            scenario.Update();
+        }
+
+        inputManager.GetRecorder().Close();
+        checksum = scenario.GetChecksum();
+        return true;
+    }
+
+    // Forward most of the way with strafing and climbing in bursts, looking around and changing speed as it goes
+    void GenerateFlightFrame(InputManager& inputManager, u32 frame, std::mt19937& random)
+    {
+        if (frame == 0)
+        {
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_W, 0, GLFW_PRESS, 0);
+        }
+        else if (frame % 4 == 0)
+        {
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_W, 0, GLFW_REPEAT, 0);
+        }
+
+        const i32 strafeKey = (frame / 300) % 2 ? GLFW_KEY_A : GLFW_KEY_D;
+        if (frame % 300 == 120)
+        {
+            inputManager.KeyboardInputHandler(nullptr, strafeKey, 0, GLFW_PRESS, 0);
+        }
+        else if (frame % 300 == 200)
+        {
+            inputManager.KeyboardInputHandler(nullptr, strafeKey, 0, GLFW_RELEASE, 0);
+        }
+
+        if (frame % 900 == 450)
+        {
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_SPACE, 0, GLFW_PRESS, 0);
+        }
+        else if (frame % 900 == 570)
+        {
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_SPACE, 0, GLFW_RELEASE, 0);
+        }
+
+        if (frame % 600 == 0)
+        {
+            inputManager.MouseScrollHandler(nullptr, 0.0f, (random() % 2) ? 1.0f : -1.0f);
+        }
+
+        std::uniform_real_distribution<f32> jitter(-1.5f, 1.5f);
+        const f32 x = 960.0f + std::sin(frame * 0.01f) * 400.0f + jitter(random);
+        const f32 y = 540.0f + std::sin(frame * 0.003f) * 100.0f + jitter(random);
+        inputManager.MousePositionHandler(nullptr, x, y);
+    }
+
+    // A few characters a frame with the key presses GLFW sends alongside them, and a word deleted now and then
+    void GenerateTypingFrame(InputManager& inputManager, u32 frame, std::mt19937& random)
+    {
+        std::uniform_int_distribution<u32> letterDistribution(0, 25);
+        const u32 numChars = 1 + frame % 3;
+
+        for (u32 i = 0; i < numChars; i++)
+        {
+            const u32 letter = letterDistribution(random);
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_A + letter, 0, GLFW_PRESS, 0);
+            inputManager.CharInputHandler(nullptr, 'a' + letter);
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_A + letter, 0, GLFW_RELEASE, 0);
+        }
+
+        if (frame % 20 == 19)
+        {
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_BACKSPACE, 0, GLFW_PRESS, 0);
+            for (u32 i = 0; i < 4; i++)
+            {
+                inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_BACKSPACE, 0, GLFW_REPEAT, 0);
+            }
+            inputManager.KeyboardInputHandler(nullptr, GLFW_KEY_BACKSPACE, 0, GLFW_RELEASE, 0);
+        }
+
+        // The cursor rests over the text box
+        inputManager.MousePositionHandler(nullptr, 960.0f, 540.0f);
+    }
+
+    // Records the scenario once, then replays it every iteration without a window and checks that it ends up where the recording did
+    void RunReplay(Benchmark::State& state, const std::string& name, GenerateFrameFunc* generateFrame)
+    {
+        const std::filesystem::path directory = std::filesystem::temp_directory_path() / "NovusCoreBenchmarks";
+        const std::filesystem::path path = directory / (name + ".ncinput");
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(directory, errorCode);
+
+        u32 recordedChecksum = 0;
+        if (!RecordScenario(path, generateFrame, recordedChecksum))
+        {
+            state.SkipWithError("Failed to record the scenario");
+            return;
+        }
+
+        std::shared_ptr<InputReplay> replay = std::make_shared<InputReplay>();
+        if (!replay->Load(path))
+        {
+            state.SkipWithError("Failed to load the recorded scenario");
+            return;
+        }
+
+        bool deterministic = true;
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            std::unique_ptr<HeadlessScenario> scenario = std::make_unique<HeadlessScenario>();
+            InputManager& inputManager = scenario->GetInputManager();
+            inputManager.SetReplay(replay);
+            state.ResumeTiming();
+
+            while (inputManager.IsReplaying())
+            {
+                inputManager.BeginFrame(nullptr);
+                scenario->Update();
+            }
+
+            state.PauseTiming();
+            deterministic &= scenario->GetChecksum() == recordedChecksum;
+            scenario = nullptr;
+            state.ResumeTiming();
+        }
+
+        if (!deterministic)
+        {
+            state.SkipWithError("The replay diverged from the recording");
+            return;
+        }
+
+        state.SetCounter("events", static_cast<f64>(replay->GetEventCount()));
+        state.SetCounter("file KB", static_cast<f64>(std::filesystem::file_size(path, errorCode)) / 1024.0);
+        state.SetItemsPerIteration(replay->GetFrameCount());
+    }
+}
+
+// Key events dispatched to 500 keybinds the way InputManager used to, compare against Dispatch
+NC_BENCHMARK(Input, DispatchLegacy)
+{
+    LegacyKeybindTable table;
+    RegisterKeybinds(table);
+
+    const std::vector<KeyEvent> events = GenerateEvents();
+    while (state.KeepRunning())
+    {
+        for (const KeyEvent& event : events)
+        {
+            table.KeyboardInputHandler(nullptr, event.key, event.action, 0);
+        }
+    }
+
+    Benchmark::DoNotOptimize(callbackCount);
+    state.SetItemsPerIteration(events.size());
+}
+
+NC_BENCHMARK(Input, Dispatch)
+{
+    InputManager inputManager;
+    std::vector<KeybindHandle> handles;
+    RegisterKeybinds(inputManager, handles);
+
+    const std::vector<KeyEvent> events = GenerateEvents();
+    while (state.KeepRunning())
+    {
+        for (const KeyEvent& event : events)
+        {
+            inputManager.KeyboardInputHandler(nullptr, event.key, 0, event.action, 0);
+        }
+    }
+
+    Benchmark::DoNotOptimize(callbackCount);
+    state.SetItemsPerIteration(events.size());
+}
+
+// Every keybind queried once per frame by title hash the way it used to be, compare against QueryByHash and QueryByHandle
+NC_BENCHMARK(Input, QueryLegacy)
+{
+    LegacyKeybindTable table;
+    RegisterKeybinds(table);
+
+    const std::vector<u32> titleHashes = GetTitleHashes();
+
+    u32 numPressed = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+        {
+            table.KeyboardInputHandler(nullptr, KEYS[frame % NUM_KEYS], GLFW_PRESS, 0);
+
+            for (u32 titleHash : titleHashes)
+            {
+                numPressed += table.IsKeyPressed(titleHash);
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(numPressed);
+    state.SetItemsPerIteration(NUM_FRAMES * NUM_KEYBINDS);
+}
+
+// Queries through the hash overload that existing callers use
+NC_BENCHMARK(Input, QueryByHash)
+{
+    InputManager inputManager;
+    std::vector<KeybindHandle> handles;
+    RegisterKeybinds(inputManager, handles);
+
+    const std::vector<u32> titleHashes = GetTitleHashes();
+
+    u32 numPressed = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+        {
+            inputManager.KeyboardInputHandler(nullptr, KEYS[frame % NUM_KEYS], 0, GLFW_PRESS, 0);
+
+            for (u32 titleHash : titleHashes)
+            {
+                numPressed += inputManager.IsKeyPressed(titleHash);
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(numPressed);
+    state.SetItemsPerIteration(NUM_FRAMES * NUM_KEYBINDS);
+}
+
+NC_BENCHMARK(Input, QueryByHandle)
+{
+    InputManager inputManager;
+    std::vector<KeybindHandle> handles;
+    RegisterKeybinds(inputManager, handles);
+
+    u32 numPressed = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 frame = 0; frame < NUM_FRAMES; frame++)
+        {
+            inputManager.KeyboardInputHandler(nullptr, KEYS[frame % NUM_KEYS], 0, GLFW_PRESS, 0);
+
+            for (KeybindHandle handle : handles)
+            {
+                numPressed += inputManager.IsKeyPressed(handle);
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(numPressed);
+    state.SetItemsPerIteration(NUM_FRAMES * NUM_KEYBINDS);
+}
+
+// A minute of flying replayed from a recording, items are frames
+NC_BENCHMARK(Input, ReplayFlight)
+{
+    RunReplay(state, "Flight", &GenerateFlightFrame);
+}
+
+// A minute of typing into a text box replayed from a recording, items are frames
+NC_BENCHMARK(Input, ReplayTyping)
+{
+    RunReplay(state, "Typing", &GenerateTypingFrame);
+}
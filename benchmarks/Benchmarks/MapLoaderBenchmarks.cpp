@@ -0,0 +1,46 @@
+#include "../Harness/Benchmark.h"
+#include "../Fixtures/Fixtures.h"
+#include <entt.hpp>
+
+#include "../../client/Utils/ServiceLocator.h"
+#include "../../client/Gameplay/Map/MapLoader.h"
+#include "../../client/ECS/Components/Singletons/MapSingleton.h"
+
+NC_BENCHMARK(MapLoader, LoadMap)
+{
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    MapSingleton& mapSingleton = registry->ctx<MapSingleton>();
+
+    const std::filesystem::path& dataDirectory = Fixtures::GetMapDataDirectory();
+    const u32 mapInternalNameHash = Fixtures::GetMapInternalNameHash();
+
+    // MapLoader reads from Data/extracted/maps relative to the working directory
+    std::filesystem::path previousDirectory = std::filesystem::current_path();
+    std::filesystem::current_path(dataDirectory);
+
+    size_t numChunks = 0;
+    while (state.KeepRunning())
+    {
+        mapSingleton.loadedMapHash = 0;
+        if (!MapLoader::LoadMap(registry, mapInternalNameHash))
+        {
+            state.SkipWithError("MapLoader::LoadMap failed");
+            break;
+        }
+
+        numChunks = mapSingleton.currentMap.chunks.size();
+    }
+
+    std::filesystem::current_path(previousDirectory);
+
+    u64 numBytes = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(dataDirectory))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == ".nmap")
+            numBytes += entry.file_size();
+    }
+
+    state.SetItemsPerIteration(numChunks);
+    state.SetBytesPerIteration(numBytes);
+    state.SetCounter("chunks", static_cast<f64>(numChunks));
+}
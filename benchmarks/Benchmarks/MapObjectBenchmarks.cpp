@@ -0,0 +1,150 @@
+#include "../Harness/Benchmark.h"
+#include <DataGen/MapObjectGenerator.h>
+#include <glm/gtc/constants.hpp>
+
+#include "../../client/Rendering/MapObjectVertexQuantizer.h"
+
+namespace
+{
+    constexpr f32 MAX_POSITION_ERROR = 0.01f;
+
+    // Worst case for a half precision value in [0..1], half of its 10 bit mantissa step just below 1.0
+    constexpr f32 MAX_UV_ERROR = 1.0f / 4096.0f;
+
+    // Two 16 bit snorms put every normal within a few thousandths of a degree, anything above this means the encoding is broken
+    constexpr f32 MAX_NORMAL_ERROR_DEGREES = 0.01f;
+
+    // Fibonacci sphere, plus the axes and the octahedron edges where the folding is easiest to get wrong
+    std::vector<vec3> GenerateNormals(u32 numNormals)
+    {
+        std::vector<vec3> normals =
+        {
+            vec3(1, 0, 0), vec3(-1, 0, 0), vec3(0, 1, 0), vec3(0, -1, 0), vec3(0, 0, 1), vec3(0, 0, -1),
+            glm::normalize(vec3(1, 1, 0)), glm::normalize(vec3(-1, 1, 0)), glm::normalize(vec3(1, -1, 0)), glm::normalize(vec3(-1, -1, 0)),
+            glm::normalize(vec3(1, 0, -1)), glm::normalize(vec3(0, -1, -1)), glm::normalize(vec3(-1, -1, -1))
+        };
+
+        const f32 goldenAngle = glm::pi<f32>() * (3.0f - glm::sqrt(5.0f));
+        for (u32 i = 0; i < numNormals; i++)
+        {
+            const f32 z = 1.0f - (2.0f * (i + 0.5f) / numNormals);
+            const f32 radius = glm::sqrt(1.0f - z * z);
+            const f32 angle = goldenAngle * i;
+
+            normals.push_back(vec3(glm::cos(angle) * radius, glm::sin(angle) * radius, z));
+        }
+
+        return normals;
+    }
+}
+
+// Arg is quads per box face edge of the generated map object. Reports how much vertex memory the compressed layout saves and the error it costs
+NC_BENCHMARK_ARGS(MapObject, QuantizeVertices, { 2, 8, 32 })
+{
+    Generators::MapObjectGeneratorDesc desc;
+    desc.minSubdivisions = static_cast<u32>(state.GetArg());
+    desc.maxSubdivisions = desc.minSubdivisions;
+
+    Terrain::MapObject mapObject;
+    Generators::MapObjectGenerator::GenerateMapObject(desc, 0, 0, desc.materialCount, mapObject);
+
+    MapObjectVertexQuantizer::QuantizedVertices quantized;
+    MapObjectVertexQuantizer::QuantizationStats stats;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        stats = MapObjectVertexQuantizer::QuantizationStats();
+        result &= MapObjectVertexQuantizer::Quantize(mapObject, MAX_POSITION_ERROR, quantized, stats);
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("The generated map object didn't fit the position error bound");
+        return;
+    }
+
+    // Decode everything again the way mapObject.vs.hlsl does and hold it against what Quantize reported
+    const size_t numVertices = mapObject.vertexPositions.size();
+    for (size_t i = 0; i < numVertices; i++)
+    {
+        const vec3 position = MapObjectVertexQuantizer::DecodePosition(quantized.header, &quantized.positions[i * 4]);
+        result &= glm::length(position - mapObject.vertexPositions[i]) <= stats.maxPositionError;
+
+        const vec3 normal = MapObjectVertexQuantizer::DecodeNormal(quantized.normals[i]);
+        result &= MapObjectVertexQuantizer::GetAngleDegrees(normal, mapObject.vertexNormals[i]) <= MAX_NORMAL_ERROR_DEGREES;
+
+        const vec2 uvError = glm::abs(MapObjectVertexQuantizer::DecodeUV(quantized.uvs[i * MapObjectVertexQuantizer::MAX_UV_SETS]) - mapObject.uvSets[0].vertexUVs[i]);
+        result &= uvError.x <= MAX_UV_ERROR && uvError.y <= MAX_UV_ERROR;
+    }
+
+    if (!result || stats.maxPositionError > MAX_POSITION_ERROR || stats.maxUVError > MAX_UV_ERROR)
+    {
+        state.SkipWithError("Decoded vertices were further off than the encoding allows");
+        return;
+    }
+
+    state.SetItemsPerIteration(numVertices);
+    state.SetCounter("float KB", stats.floatBytes / 1024.0);
+    state.SetCounter("quantized KB", stats.uploadedBytes / 1024.0);
+    state.SetCounter("saved %", 100.0 * stats.GetSavedBytes() / stats.floatBytes);
+    state.SetCounter("max position error", stats.maxPositionError);
+    state.SetCounter("max normal error deg", stats.maxNormalError);
+    state.SetCounter("max uv error", stats.maxUVError);
+}
+
+// Round trips normals from every direction through the octahedral encoding
+NC_BENCHMARK_ARGS(MapObject, NormalRoundTrip, { 1024, 65536 })
+{
+    const std::vector<vec3> normals = GenerateNormals(static_cast<u32>(state.GetArg()));
+
+    f32 maxError = 0.0f;
+    while (state.KeepRunning())
+    {
+        maxError = 0.0f;
+        for (const vec3& normal : normals)
+        {
+            const vec3 decoded = MapObjectVertexQuantizer::DecodeNormal(MapObjectVertexQuantizer::EncodeNormal(normal));
+            maxError = glm::max(maxError, MapObjectVertexQuantizer::GetAngleDegrees(decoded, normal));
+        }
+    }
+
+    if (maxError > MAX_NORMAL_ERROR_DEGREES)
+    {
+        state.SkipWithError("A normal came back further off than the encoding allows");
+        return;
+    }
+
+    state.SetItemsPerIteration(normals.size());
+    state.SetCounter("max normal error deg", maxError);
+}
+
+// A map object far bigger than 16 bits can cover within the bound has to keep the float layout
+NC_BENCHMARK(MapObject, QuantizeOutOfBounds)
+{
+    Generators::MapObjectGeneratorDesc desc;
+    Terrain::MapObject mapObject;
+    Generators::MapObjectGenerator::GenerateMapObject(desc, 0, 0, desc.materialCount, mapObject);
+
+    for (vec3& position : mapObject.vertexPositions)
+    {
+        position *= 1000.0f;
+    }
+
+    MapObjectVertexQuantizer::QuantizedVertices quantized;
+    MapObjectVertexQuantizer::QuantizationStats stats;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        result &= !MapObjectVertexQuantizer::Quantize(mapObject, MAX_POSITION_ERROR, quantized, stats);
+    }
+
+    if (!result || stats.numQuantizedMeshes != 0 || stats.GetSavedBytes() != 0)
+    {
+        state.SkipWithError("A map object was quantized past the position error bound");
+        return;
+    }
+
+    state.SetItemsPerIteration(mapObject.vertexPositions.size());
+}
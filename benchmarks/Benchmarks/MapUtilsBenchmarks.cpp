@@ -0,0 +1,111 @@
+#include "../Harness/Benchmark.h"
+#include "../Fixtures/Fixtures.h"
+
+#include "../../client/Utils/MapUtils.h"
+
+namespace
+{
+    constexpr size_t NUM_POSITIONS = 4096;
+
+    const std::vector<vec3>& GetPositions()
+    {
+        static const std::vector<vec3> positions = Generators::MapGenerator::GeneratePositions(Fixtures::GetMapDesc(), 42, NUM_POSITIONS);
+        return positions;
+    }
+}
+
+NC_BENCHMARK(MapUtils, GetHeightFromWorldPosition)
+{
+    Fixtures::GetMap();
+    const std::vector<vec3>& positions = GetPositions();
+
+    size_t index = 0;
+    f32 heightSum = 0.0f;
+
+    while (state.KeepRunning())
+    {
+        heightSum += Terrain::MapUtils::GetHeightFromWorldPosition(positions[index++ % NUM_POSITIONS]);
+    }
+
+    Benchmark::DoNotOptimize(heightSum);
+    state.SetItemsPerIteration(1);
+}
+
+NC_BENCHMARK(MapUtils, GetTriangleFromWorldPosition)
+{
+    Fixtures::GetMap();
+    const std::vector<vec3>& positions = GetPositions();
+
+    size_t index = 0;
+    u64 numHits = 0;
+
+    while (state.KeepRunning())
+    {
+        Geometry::Triangle triangle;
+        f32 height = 0.0f;
+
+        numHits += Terrain::MapUtils::GetTriangleFromWorldPosition(positions[index++ % NUM_POSITIONS], triangle, height);
+        Benchmark::DoNotOptimize(triangle);
+    }
+
+    Benchmark::DoNotOptimize(numHits);
+    state.SetItemsPerIteration(1);
+}
+
+NC_BENCHMARK(MapUtils, Intersect_AABB_TERRAIN)
+{
+    Fixtures::GetMap();
+    const std::vector<vec3>& positions = GetPositions();
+
+    // Player sized box sitting on the terrain, intersects or barely misses depending on the slope
+    const vec3 halfExtents = vec3(0.5f, 1.0f, 0.5f);
+
+    size_t index = 0;
+    u64 numHits = 0;
+
+    while (state.KeepRunning())
+    {
+        const vec3& position = positions[index++ % NUM_POSITIONS];
+
+        Geometry::AABoundingBox box;
+        box.min = position - halfExtents + vec3(0.0f, 0.5f, 0.0f);
+        box.max = position + halfExtents + vec3(0.0f, 0.5f, 0.0f);
+
+        Geometry::Triangle triangle;
+        f32 height = 0.0f;
+        numHits += Terrain::MapUtils::Intersect_AABB_TERRAIN(position, box, triangle, height);
+    }
+
+    Benchmark::DoNotOptimize(numHits);
+    state.SetItemsPerIteration(1);
+}
+
+NC_BENCHMARK(MapUtils, Intersect_AABB_TERRAIN_SWEEP)
+{
+    Fixtures::GetMap();
+    const std::vector<vec3>& positions = GetPositions();
+
+    const vec3 halfExtents = vec3(0.5f, 1.0f, 0.5f);
+    const vec3 direction = vec3(0.0f, -1.0f, 0.0f);
+
+    size_t index = 0;
+    u64 numHits = 0;
+
+    while (state.KeepRunning())
+    {
+        const vec3& position = positions[index++ % NUM_POSITIONS];
+
+        // Falling towards the terrain from slightly above it
+        Geometry::AABoundingBox box;
+        box.min = position - halfExtents + vec3(0.0f, 3.0f, 0.0f);
+        box.max = position + halfExtents + vec3(0.0f, 3.0f, 0.0f);
+
+        Geometry::Triangle triangle;
+        f32 height = 0.0f;
+        vec3 distanceToCollision = vec3(0.0f);
+        numHits += Terrain::MapUtils::Intersect_AABB_TERRAIN_SWEEP(box, triangle, direction, height, 5.0f, distanceToCollision);
+    }
+
+    Benchmark::DoNotOptimize(numHits);
+    state.SetItemsPerIteration(1);
+}
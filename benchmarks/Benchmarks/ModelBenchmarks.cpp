@@ -0,0 +1,310 @@
+#include "../Harness/Benchmark.h"
+#include <DataGen/MeshOptimizer.h>
+#include <DataGen/ModelGenerator.h>
+#include <NovusTypeHeader.h>
+#include <Renderer/ModelFile.h>
+#include <Utils/ByteBuffer.h>
+#include <Utils/FileReader.h>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    fs::path GetModelPath(const std::string& name, u32 subdivisions)
+    {
+        fs::path directory = fs::temp_directory_path() / "NovusCoreBenchmarks" / name;
+        fs::create_directories(directory);
+
+        return directory / ("Cube_" + std::to_string(subdivisions) + ".novusmodel");
+    }
+
+    // Version 2 of the format, the one ModelHandlerVK read one field at a time
+    void WriteLegacyModel(const fs::path& path, const std::vector<Renderer::Vertex>& vertices, const std::vector<u32>& indices)
+    {
+        std::ofstream output(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+
+        const NovusTypeHeader typeHeader = NovusTypeHeader(42, 2);
+        output.write(reinterpret_cast<const char*>(&typeHeader), sizeof(NovusTypeHeader));
+
+        const u32 vertexCount = static_cast<u32>(vertices.size());
+        output.write(reinterpret_cast<const char*>(&vertexCount), sizeof(u32));
+
+        for (const Renderer::Vertex& vertex : vertices)
+        {
+            output.write(reinterpret_cast<const char*>(&vertex.pos), sizeof(vec3));
+            output.write(reinterpret_cast<const char*>(&vertex.normal), sizeof(vec3));
+            output.write(reinterpret_cast<const char*>(&vertex.texCoord), sizeof(vec2));
+        }
+
+        const i32 indexType = 3;
+        const u32 indexCount = static_cast<u32>(indices.size());
+        output.write(reinterpret_cast<const char*>(&indexType), sizeof(i32));
+        output.write(reinterpret_cast<const char*>(&indexCount), sizeof(u32));
+        output.write(reinterpret_cast<const char*>(indices.data()), sizeof(u32) * indices.size());
+    }
+
+    // ModelHandlerVK::LoadFromFile before the format got bulk blocks, minus the Borrow<32768> that kept it from loading the bigger models
+    bool LoadLegacyModel(const fs::path& path, std::vector<Renderer::Vertex>& vertices, std::vector<u32>& indices, u64& bytes)
+    {
+        FileReader file(path.string(), path.filename().string());
+        if (!file.Open())
+            return false;
+
+        Bytebuffer buffer(nullptr, file.Length());
+        file.Read(&buffer, buffer.size);
+        file.Close();
+        bytes = buffer.size;
+
+        NovusTypeHeader header;
+        if (!buffer.Get<NovusTypeHeader>(header))
+            return false;
+
+        u32 vertexCount;
+        if (!buffer.GetU32(vertexCount))
+            return false;
+
+        vertices.resize(vertexCount);
+        for (u32 i = 0; i < vertexCount; i++)
+        {
+            if (!buffer.Get<vec3>(vertices[i].pos) || !buffer.Get<vec3>(vertices[i].normal) || !buffer.Get<vec2>(vertices[i].texCoord))
+                return false;
+        }
+
+        i32 indexType;
+        u32 indexCount;
+        if (!buffer.GetI32(indexType) || !buffer.GetU32(indexCount))
+            return false;
+
+        indices.resize(indexCount);
+        for (u32 i = 0; i < indexCount; i++)
+        {
+            if (!buffer.GetU32(indices[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Triangles rotated so their smallest index comes first and sorted, reordering triangles keeps this the same while flipping winding doesn't
+    std::vector<std::array<u32, 3>> GetCanonicalTriangles(const std::vector<u32>& indices)
+    {
+        std::vector<std::array<u32, 3>> triangles(indices.size() / 3);
+        for (size_t i = 0; i < triangles.size(); i++)
+        {
+            std::array<u32, 3>& triangle = triangles[i];
+            triangle = { indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2] };
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    // What ModelHandlerVK::LoadFromFile does now
+    bool LoadModel(const fs::path& path, std::vector<Renderer::Vertex>& vertices, std::vector<u32>& indices, u64& bytes)
+    {
+        FileReader file(path.string(), path.filename().string());
+        if (!file.Open())
+            return false;
+
+        Bytebuffer buffer(nullptr, file.Length());
+        file.Read(&buffer, buffer.size);
+        file.Close();
+        bytes = buffer.size;
+
+        i32 indexType;
+        return Renderer::ModelFile::Read(buffer, path.string(), vertices, indices, indexType);
+    }
+}
+
+// Args are quads per cube face edge, 64 is ~800KB of vertices which never fit the old 32KB buffer. Compare MB/s against LoadBulk
+NC_BENCHMARK_ARGS(Model, LoadLegacy, { 8, 64 })
+{
+    Generators::ModelGeneratorDesc desc;
+    desc.subdivisions = static_cast<u32>(state.GetArg());
+
+    std::vector<Renderer::Vertex> vertices;
+    std::vector<u32> indices;
+    Generators::ModelGenerator::GenerateCube(desc, vertices, indices);
+
+    const fs::path path = GetModelPath("ModelLoadLegacy", desc.subdivisions);
+    WriteLegacyModel(path, vertices, indices);
+
+    std::vector<Renderer::Vertex> loadedVertices;
+    std::vector<u32> loadedIndices;
+    u64 bytes = 0;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        result &= LoadLegacyModel(path, loadedVertices, loadedIndices, bytes);
+    }
+
+    if (!result || loadedIndices != indices)
+    {
+        state.SkipWithError("The legacy model didn't load back the way it was written");
+        return;
+    }
+
+    state.SetItemsPerIteration(vertices.size());
+    state.SetBytesPerIteration(bytes);
+}
+
+NC_BENCHMARK_ARGS(Model, LoadBulk, { 8, 64 })
+{
+    Generators::ModelGeneratorDesc desc;
+    desc.subdivisions = static_cast<u32>(state.GetArg());
+
+    std::vector<Renderer::Vertex> vertices;
+    std::vector<u32> indices;
+    Generators::ModelGenerator::GenerateCube(desc, vertices, indices);
+
+    const fs::path path = GetModelPath("ModelLoadBulk", desc.subdivisions);
+    if (!Generators::ModelGenerator::WriteModel(path, vertices, indices))
+    {
+        state.SkipWithError("Failed to write the model");
+        return;
+    }
+
+    std::vector<Renderer::Vertex> loadedVertices;
+    std::vector<u32> loadedIndices;
+    u64 bytes = 0;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        result &= LoadModel(path, loadedVertices, loadedIndices, bytes);
+    }
+
+    if (!result || loadedIndices != indices)
+    {
+        state.SkipWithError("The model didn't load back the way it was written");
+        return;
+    }
+
+    state.SetItemsPerIteration(vertices.size());
+    state.SetBytesPerIteration(bytes);
+}
+
+// Times the converter's index reordering and reports the ACMR of the export order, after vertex cache optimization and after overdraw optimization
+NC_BENCHMARK_ARGS(Model, OptimizeIndices, { 8, 64 })
+{
+    Generators::ModelGeneratorDesc desc;
+    desc.subdivisions = static_cast<u32>(state.GetArg());
+
+    std::vector<Renderer::Vertex> vertices;
+    std::vector<u32> exportIndices;
+    Generators::ModelGenerator::GenerateCube(desc, vertices, exportIndices);
+
+    const u32 numVertices = static_cast<u32>(vertices.size());
+    std::vector<u32> indices;
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        indices = exportIndices;
+        state.ResumeTiming();
+
+        Generators::ModelGenerator::OptimizeModel(desc, vertices, indices);
+    }
+
+    std::vector<u32> vertexCacheIndices = exportIndices;
+    Generators::MeshOptimizer::OptimizeVertexCache(vertexCacheIndices, numVertices);
+
+    if (GetCanonicalTriangles(indices) != GetCanonicalTriangles(exportIndices))
+    {
+        state.SkipWithError("Optimizing changed the triangles instead of only reordering them");
+        return;
+    }
+
+    state.SetItemsPerIteration(exportIndices.size() / 3);
+    state.SetCounter("acmr export", Generators::MeshOptimizer::CalculateACMR(exportIndices, numVertices, desc.cacheSize));
+    state.SetCounter("acmr vertex cache", Generators::MeshOptimizer::CalculateACMR(vertexCacheIndices, numVertices, desc.cacheSize));
+    state.SetCounter("acmr optimized", Generators::MeshOptimizer::CalculateACMR(indices, numVertices, desc.cacheSize));
+}
+
+// Reads a model whose header offsets were patched in memory, anything pointing into the headers or wrapping past the end has to be rejected
+NC_BENCHMARK(Model, RejectCorruptOffsets)
+{
+    Generators::ModelGeneratorDesc desc;
+    desc.subdivisions = 8;
+
+    std::vector<Renderer::Vertex> vertices;
+    std::vector<u32> indices;
+    Generators::ModelGenerator::GenerateCube(desc, vertices, indices);
+
+    const fs::path path = GetModelPath("ModelRejectCorrupt", desc.subdivisions);
+    if (!Generators::ModelGenerator::WriteModel(path, vertices, indices))
+    {
+        state.SkipWithError("Failed to write the model");
+        return;
+    }
+
+    FileReader file(path.string(), path.filename().string());
+    if (!file.Open())
+    {
+        state.SkipWithError("Failed to open the model");
+        return;
+    }
+
+    Bytebuffer buffer(nullptr, file.Length());
+    file.Read(&buffer, buffer.size);
+    file.Close();
+
+    Renderer::ModelFileHeader header;
+    memcpy(&header, buffer.GetDataPointer() + sizeof(NovusTypeHeader), sizeof(Renderer::ModelFileHeader));
+
+    const u64 blocksStart = sizeof(NovusTypeHeader) + sizeof(Renderer::ModelFileHeader);
+    const u64 corruptOffsets[] =
+    {
+        0, // Points at the headers
+        blocksStart - 1,
+        buffer.size + 1,
+        std::numeric_limits<u64>::max() - 3 // Wraps around when the block size is added to it
+    };
+
+    std::vector<Renderer::Vertex> loadedVertices;
+    std::vector<u32> loadedIndices;
+    i32 indexType;
+
+    // Patches one of the offsets, reads and puts the original header back
+    auto readWith = [&](u64 vertexOffset, u64 indexOffset)
+    {
+        Renderer::ModelFileHeader patched = header;
+        patched.vertexOffset = vertexOffset;
+        patched.indexOffset = indexOffset;
+        memcpy(buffer.GetDataPointer() + sizeof(NovusTypeHeader), &patched, sizeof(Renderer::ModelFileHeader));
+
+        buffer.readData = 0;
+        const bool read = Renderer::ModelFile::Read(buffer, path.string(), loadedVertices, loadedIndices, indexType);
+
+        memcpy(buffer.GetDataPointer() + sizeof(NovusTypeHeader), &header, sizeof(Renderer::ModelFileHeader));
+        return read;
+    };
+
+    bool result = true;
+    while (state.KeepRunning())
+    {
+        for (u64 offset : corruptOffsets)
+        {
+            result &= !readWith(offset, header.indexOffset);
+            result &= !readWith(header.vertexOffset, offset);
+        }
+
+        result &= readWith(header.vertexOffset, header.indexOffset);
+    }
+
+    if (!result || loadedIndices != indices)
+    {
+        state.SkipWithError("ModelFile::Read accepted offsets outside of the file or rejected a valid one");
+        return;
+    }
+
+    state.SetItemsPerIteration(std::size(corruptOffsets) * 2 + 1);
+}
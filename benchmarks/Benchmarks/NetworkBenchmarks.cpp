@@ -0,0 +1,540 @@
+#include "../Harness/Benchmark.h"
+#include "../Harness/AllocationCounter.h"
+#include "../Generators/PacketStreamGenerator.h"
+#include <StandIn/EntitySimulator.h>
+#include <entt.hpp>
+#include <Utils/ConcurrentQueue.h>
+#include <Networking/MessageHandler.h>
+#include <Networking/NetworkClient.h>
+#include <asio/io_service.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <random>
+
+#include "../../client/Network/PacketFramer.h"
+#include "../../client/Network/PacketWriter.h"
+#include "../../client/Network/PacketCapture.h"
+#include "../../client/ECS/Systems/Network/ConnectionSystems.h"
+#include "../../client/ECS/Systems/Network/EntityUpdateSystem.h"
+#include "../../client/ECS/Components/Network/ConnectionSingleton.h"
+#include "../../client/ECS/Components/Network/EntityUpdateSingleton.h"
+#include "../../client/ECS/Components/Network/TransformSnapshots.h"
+#include "../../client/Network/Handlers/GameSocket/GameHandlers.h"
+#include "../../client/Utils/ServiceLocator.h"
+#include "../../client/ECS/Components/Transform.h"
+#include "../../client/ECS/Components/LocalplayerSingleton.h"
+#include "../../client/ECS/Components/Singletons/TimeSingleton.h"
+
+namespace
+{
+    // Packets wait in the connection queue until ConnectionUpdateSystem gets to them, this many are kept alive to pin receive blocks the same way
+    constexpr size_t NUM_QUEUED_PACKETS = 1024;
+}
+
+// Streams mixed size packets through the framer the way the socket read handlers do, the argument is the largest read size
+NC_BENCHMARK_ARGS(Network, PacketFramer, { 16, 1460, 65536 })
+{
+    Generators::PacketStreamGeneratorDesc desc;
+    desc.maxFragmentSize = static_cast<u32>(state.GetArg());
+
+    Generators::PacketStream stream;
+    Generators::PacketStreamGenerator::Generate(desc, stream);
+
+    PacketFramer framer;
+    std::vector<std::shared_ptr<NetworkPacket>> queuedPackets(NUM_QUEUED_PACKETS);
+
+    u64 numPackets = 0;
+    u64 payloadBytes = 0;
+    auto OnPacket = [&](std::shared_ptr<NetworkPacket>& packet)
+    {
+        payloadBytes += packet->header.size;
+        queuedPackets[numPackets++ % NUM_QUEUED_PACKETS] = packet;
+    };
+
+    const u64 allocationsBefore = Benchmark::AllocationCounter::GetCount();
+
+    while (state.KeepRunning())
+    {
+        const u8* data = stream.data.data();
+        for (u32 fragmentSize : stream.fragmentSizes)
+        {
+            if (!framer.Receive(data, fragmentSize, OnPacket))
+            {
+                state.SkipWithError("PacketFramer rejected a valid stream");
+                return;
+            }
+
+            data += fragmentSize;
+        }
+    }
+
+    const u64 numAllocations = Benchmark::AllocationCounter::GetCount() - allocationsBefore;
+
+    if (numPackets != stream.numPackets * state.GetIterations() || payloadBytes != stream.payloadBytes * state.GetIterations())
+    {
+        state.SkipWithError("PacketFramer lost or corrupted packets");
+        return;
+    }
+
+    const PacketFramerStats& stats = framer.GetStats();
+
+    state.SetItemsPerIteration(stream.numPackets);
+    state.SetBytesPerIteration(stream.data.size());
+    state.SetCounter("allocations/packet", numPackets ? static_cast<f64>(numAllocations) / numPackets : 0.0);
+    state.SetCounter("sliced packets %", numPackets ? 100.0 * stats.slicedPackets / numPackets : 0.0);
+    state.SetCounter("carried bytes/packet", numPackets ? static_cast<f64>(stats.carriedBytes) / numPackets : 0.0);
+    state.SetCounter("receive blocks", static_cast<f64>(stats.blocksAllocated));
+}
+
+// Nothing handles the packets while the stream comes in, like an update thread that stalls for a while. The ring must stop growing
+// at MAX_BLOCKS and every payload must still be intact, the argument is the number of packets held back
+NC_BENCHMARK_ARGS(Network, PacketFramerBacklog, { 1024, 16384 })
+{
+    Generators::PacketStreamGeneratorDesc desc;
+    desc.numPackets = static_cast<u32>(state.GetArg());
+
+    Generators::PacketStream stream;
+    Generators::PacketStreamGenerator::Generate(desc, stream);
+
+    std::vector<std::shared_ptr<NetworkPacket>> heldPackets;
+    heldPackets.reserve(stream.numPackets);
+
+    auto OnPacket = [&heldPackets](std::shared_ptr<NetworkPacket>& packet)
+    {
+        heldPackets.push_back(packet);
+    };
+
+    PacketFramer framer;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        const u8* data = stream.data.data();
+        for (u32 fragmentSize : stream.fragmentSizes)
+        {
+            result &= framer.Receive(data, fragmentSize, OnPacket);
+            data += fragmentSize;
+        }
+
+        state.PauseTiming();
+        result &= heldPackets.size() == stream.numPackets;
+
+        // The stream is header and payload back to back, walk it and compare against what the framer handed out
+        size_t offset = 0;
+        for (size_t i = 0; i < heldPackets.size() && result; i++)
+        {
+            const NetworkPacket& packet = *heldPackets[i];
+            const u16 size = packet.header.size;
+
+            result &= offset + PacketFramer::HEADER_SIZE + size <= stream.data.size();
+            result &= std::memcmp(&packet.header.opcode, &stream.data[offset], sizeof(Opcode)) == 0;
+            result &= size == 0 || std::memcmp(packet.payload->GetDataPointer(), &stream.data[offset + PacketFramer::HEADER_SIZE], size) == 0;
+
+            offset += PacketFramer::HEADER_SIZE + size;
+        }
+
+        heldPackets.clear();
+        state.ResumeTiming();
+    }
+
+    const PacketFramerStats& stats = framer.GetStats();
+    result &= stats.blocksAllocated <= PacketFramer::MAX_BLOCKS;
+
+    if (!result)
+    {
+        state.SkipWithError("PacketFramer grew past MAX_BLOCKS or corrupted a held back packet");
+        return;
+    }
+
+    state.SetItemsPerIteration(stream.numPackets);
+    state.SetBytesPerIteration(stream.data.size());
+    state.SetCounter("receive blocks", static_cast<f64>(stats.blocksAllocated));
+    state.SetCounter("copied packets %", stats.packets ? 100.0 * stats.copiedPackets / stats.packets : 0.0);
+}
+
+// Every entity sends one movement packet per frame the way MovementSystem does, the argument is the number of entities
+// The send function stands in for the socket, each call is one write
+NC_BENCHMARK_ARGS(Network, PacketWriter, { 1, 64, 1024 })
+{
+    const u32 numEntities = static_cast<u32>(state.GetArg());
+
+    PacketWriter writer;
+
+    u64 numWrites = 0;
+    u64 numBytes = 0;
+    auto Send = [&](std::shared_ptr<Bytebuffer>& buffer)
+    {
+        numWrites++;
+        numBytes += buffer->writtenData;
+        Benchmark::DoNotOptimize(buffer->GetDataPointer());
+    };
+
+    u64 numFrames = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 i = 0; i < numEntities; i++)
+        {
+            std::shared_ptr<Bytebuffer>& buffer = writer.BeginPacket(Opcode::MSG_MOVE_HEARTBEAT_ENTITY, 32);
+            buffer->PutU32(i);
+            buffer->PutU32(0);
+            buffer->Put(vec3(static_cast<f32>(i), 0.0f, 0.0f));
+            buffer->Put(vec3(0.0f, 0.0f, 0.0f));
+            writer.EndPacket();
+        }
+
+        writer.Flush(Send);
+        numFrames++;
+    }
+
+    const PacketWriterStats& stats = writer.GetStats();
+    if (stats.packets != numEntities * numFrames || numBytes != stats.bytes)
+    {
+        state.SkipWithError("PacketWriter lost packets");
+        return;
+    }
+
+    state.SetItemsPerIteration(numEntities);
+    state.SetCounter("writes/frame", numFrames ? static_cast<f64>(numWrites) / numFrames : 0.0);
+    state.SetCounter("writes without coalescing/frame", static_cast<f64>(numEntities));
+    state.SetCounter("bytes/frame", numFrames ? static_cast<f64>(numBytes) / numFrames : 0.0);
+    state.SetCounter("bytes/write", numWrites ? static_cast<f64>(numBytes) / numWrites : 0.0);
+}
+
+// One stand-in server tick of SMSG_UPDATE_ENTITY for every entity, framed and handled the way the socket read handler,
+// ConnectionUpdateSystem and EntityUpdateSystem do it. The time per iteration is the client frame time spent ingesting a tick, the argument is the entity count
+NC_BENCHMARK_ARGS(Network, EntityIngestion, { 100, 1000, 10000 })
+{
+    StandIn::EntitySimulatorDesc desc;
+    desc.numEntities = static_cast<u32>(state.GetArg());
+
+    StandIn::EntitySimulator simulator;
+    simulator.Init(desc);
+
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    registry->set<LocalplayerSingleton>();
+    registry->set<EntityUpdateSingleton>();
+    registry->set<TimeSingleton>();
+
+    // SMSG_CREATE_ENTITY also loads a model, the entities are created directly so only the update path is measured
+    std::vector<entt::entity> entities;
+    entities.reserve(desc.numEntities);
+    for (u32 i = 0; i < desc.numEntities; i++)
+    {
+        entt::entity entity = registry->create(static_cast<entt::entity>(simulator.GetEntityId(i)));
+        registry->emplace<Transform>(entity);
+        entities.push_back(entity);
+    }
+
+    std::vector<u8> tick;
+    const u32 numUpdates = simulator.WriteUpdateEntities(tick);
+
+    PacketFramer framer;
+    moodycamel::ConcurrentQueue<std::shared_ptr<NetworkPacket>> packetQueue(256);
+
+    u64 numHandled = 0;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        result &= framer.Receive(tick.data(), tick.size(), [&packetQueue](std::shared_ptr<NetworkPacket>& packet)
+        {
+            packetQueue.enqueue(packet);
+        });
+
+        std::shared_ptr<NetworkPacket> packet = nullptr;
+        while (packetQueue.try_dequeue(packet))
+        {
+            result &= GameSocket::GameHandlers::HandleUpdateEntity(nullptr, packet);
+            numHandled++;
+        }
+
+        EntityUpdateSystem::Apply(*registry);
+    }
+
+    registry->destroy(entities.begin(), entities.end());
+    registry->unset<TimeSingleton>();
+    registry->unset<EntityUpdateSingleton>();
+    registry->unset<LocalplayerSingleton>();
+
+    if (!result || numHandled != numUpdates * state.GetIterations())
+    {
+        state.SkipWithError("Entity updates were dropped");
+        return;
+    }
+
+    state.SetItemsPerIteration(numUpdates);
+    state.SetBytesPerIteration(tick.size());
+    state.SetCounter("bytes/update", static_cast<f64>(tick.size()) / numUpdates);
+}
+
+// Replays a capture of stand-in server ticks through ConnectionUpdateSystem::Update as fast as possible, the argument is the entity count
+// The capture is written with PacketCapture and loaded with PacketReplay, the same path the client's capture and replay commands use
+NC_BENCHMARK_ARGS(Network, ConnectionUpdateReplay, { 1000, 10000 })
+{
+    namespace fs = std::filesystem;
+    constexpr u32 NUM_TICKS = 20;
+    constexpr u64 TICK_INTERVAL_US = 100000;
+
+    StandIn::EntitySimulatorDesc desc;
+    desc.numEntities = static_cast<u32>(state.GetArg());
+
+    StandIn::EntitySimulator simulator;
+    simulator.Init(desc);
+
+    const fs::path capturePath = fs::temp_directory_path() / "NovusCoreBenchmarks" / ("ConnectionUpdateReplay_" + std::to_string(desc.numEntities) + ".ncpc");
+    {
+        std::error_code errorCode;
+        fs::create_directories(capturePath.parent_path(), errorCode);
+
+        PacketCapture capture;
+        if (!capture.Open(capturePath))
+        {
+            state.SkipWithError("Failed to write the packet capture");
+            return;
+        }
+
+        constexpr size_t packetSize = PacketFramer::HEADER_SIZE + StandIn::EntitySimulator::UPDATE_ENTITY_PAYLOAD_SIZE;
+
+        std::vector<u8> tick;
+        for (u32 i = 0; i < NUM_TICKS; i++)
+        {
+            tick.clear();
+            simulator.Step(TICK_INTERVAL_US / 1000000.0f);
+            simulator.WriteUpdateEntities(tick);
+
+            for (size_t offset = 0; offset < tick.size(); offset += packetSize)
+            {
+                capture.WriteRecord(PacketCaptureConnection::Game, i * TICK_INTERVAL_US, &tick[offset], packetSize);
+            }
+        }
+
+        capture.Close();
+    }
+
+    PacketReplay replay;
+    if (!replay.Load(capturePath))
+    {
+        state.SkipWithError("Failed to load the packet capture");
+        return;
+    }
+
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    registry->set<LocalplayerSingleton>();
+    registry->set<EntityUpdateSingleton>();
+    registry->set<TimeSingleton>();
+    ConnectionSingleton& connectionSingleton = registry->set<ConnectionSingleton>();
+
+    // Never connected, ConnectionUpdateSystem only needs it to exist and to pass the handler status check
+    asio::io_service ioService;
+    connectionSingleton.gameConnection = std::make_shared<NetworkClient>(new asio::ip::tcp::socket(ioService));
+    connectionSingleton.gameConnection->SetStatus(ConnectionStatus::CONNECTED);
+
+    static bool isMessageHandlerSet = []()
+    {
+        MessageHandler* messageHandler = new MessageHandler();
+        GameSocket::GameHandlers::Setup(messageHandler);
+        ServiceLocator::SetGameSocketMessageHandler(messageHandler);
+        return true;
+    }();
+    Benchmark::DoNotOptimize(isMessageHandlerSet);
+
+    // SMSG_CREATE_ENTITY loads a model, the entities are created directly so the capture only has to contain updates
+    std::vector<entt::entity> entities;
+    entities.reserve(desc.numEntities);
+    for (u32 i = 0; i < desc.numEntities; i++)
+    {
+        entt::entity entity = registry->create(static_cast<entt::entity>(simulator.GetEntityId(i)));
+        registry->emplace<Transform>(entity);
+        entities.push_back(entity);
+    }
+
+    while (state.KeepRunning())
+    {
+        // Injected directly instead of through connectionSingleton.packetReplay, which logs every time a replay finishes
+        replay.Start(PacketReplay::Mode::AsFastAsPossible);
+        replay.Update(connectionSingleton);
+        ConnectionUpdateSystem::Update(*registry);
+        EntityUpdateSystem::Update(*registry);
+    }
+
+    const bool stillConnected = connectionSingleton.gameConnection != nullptr;
+
+    registry->destroy(entities.begin(), entities.end());
+    registry->unset<ConnectionSingleton>();
+    registry->unset<TimeSingleton>();
+    registry->unset<EntityUpdateSingleton>();
+    registry->unset<LocalplayerSingleton>();
+
+    if (!stillConnected)
+    {
+        state.SkipWithError("A game handler rejected a replayed packet");
+        return;
+    }
+
+    state.SetItemsPerIteration(replay.GetPacketCount());
+    state.SetCounter("packets", static_cast<f64>(replay.GetPacketCount()));
+}
+
+namespace
+{
+    // The stand-in server ticks at 10Hz, 5000 entities is 50k updates per second
+    constexpr f32 SERVER_TICK_INTERVAL = 0.1f;
+
+    struct EntityUpdateFixture
+    {
+        StandIn::EntitySimulator simulator;
+        std::vector<entt::entity> entities;
+        std::vector<std::shared_ptr<NetworkPacket>> packets;
+        std::vector<u8> tick;
+    };
+
+    // Creates the entities in a shuffled order so their Transforms are not laid out in the order the server sends updates,
+    // the same as entities that were created over the course of a session
+    void CreateEntityUpdateFixture(entt::registry& registry, u32 numEntities, EntityUpdateFixture& fixture)
+    {
+        StandIn::EntitySimulatorDesc desc;
+        desc.numEntities = numEntities;
+        fixture.simulator.Init(desc);
+
+        std::vector<u32> creationOrder(numEntities);
+        for (u32 i = 0; i < numEntities; i++)
+        {
+            creationOrder[i] = i;
+        }
+        std::shuffle(creationOrder.begin(), creationOrder.end(), std::mt19937(desc.seed));
+
+        fixture.entities.reserve(numEntities);
+        for (u32 i : creationOrder)
+        {
+            entt::entity entity = registry.create(static_cast<entt::entity>(fixture.simulator.GetEntityId(i)));
+            registry.emplace<Transform>(entity);
+            fixture.entities.push_back(entity);
+        }
+    }
+
+    // Frames the next server tick the way the game socket read handler does, this is not part of what is being compared
+    bool FrameEntityUpdateTick(EntityUpdateFixture& fixture, PacketFramer& framer)
+    {
+        fixture.tick.clear();
+        fixture.packets.clear();
+
+        fixture.simulator.Step(SERVER_TICK_INTERVAL);
+        fixture.simulator.WriteUpdateEntities(fixture.tick);
+
+        return framer.Receive(fixture.tick.data(), fixture.tick.size(), [&fixture](std::shared_ptr<NetworkPacket>& packet)
+        {
+            fixture.packets.push_back(packet);
+        });
+    }
+}
+
+// Applies one stand-in server tick per iteration by writing every packet straight into its Transform, which is what
+// SMSG_UPDATE_ENTITY used to do. Kept as the reference for EntityUpdateBatched, the argument is the entity count
+NC_BENCHMARK_ARGS(Network, EntityUpdateImmediate, { 1000, 5000 })
+{
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+
+    EntityUpdateFixture fixture;
+    CreateEntityUpdateFixture(*registry, static_cast<u32>(state.GetArg()), fixture);
+
+    PacketFramer framer;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        result &= FrameEntityUpdateTick(fixture, framer);
+        state.ResumeTiming();
+
+        for (std::shared_ptr<NetworkPacket>& packet : fixture.packets)
+        {
+            entt::entity entity = entt::null;
+            packet->payload->Get(entity);
+
+            Transform& transform = registry->get<Transform>(entity);
+            vec3 rotation;
+            packet->payload->Get(transform.position);
+            packet->payload->Get(rotation);
+            packet->payload->Get(transform.scale);
+            transform.yaw = rotation.y;
+            transform.pitch = rotation.z;
+            transform.isDirty = true;
+        }
+    }
+
+    registry->destroy(fixture.entities.begin(), fixture.entities.end());
+
+    if (!result)
+    {
+        state.SkipWithError("PacketFramer rejected a stand-in tick");
+        return;
+    }
+
+    // Every update reads the sparse set and writes into a Transform somewhere in the pool
+    state.SetItemsPerIteration(fixture.entities.size());
+    state.SetCounter("updates/s at 10Hz", fixture.entities.size() / SERVER_TICK_INTERVAL);
+    state.SetCounter("bytes touched/update", static_cast<f64>(sizeof(entt::entity) + sizeof(Transform)));
+}
+
+// Applies one stand-in server tick per iteration through GameHandlers, EntityUpdateSystem::Apply and EntityUpdateSystem::Interpolate
+// The argument is the entity count, compare against EntityUpdateImmediate with the same count
+NC_BENCHMARK_ARGS(Network, EntityUpdateBatched, { 1000, 5000 })
+{
+    entt::registry* registry = ServiceLocator::GetGameRegistry();
+    registry->set<LocalplayerSingleton>();
+    EntityUpdateSingleton& entityUpdateSingleton = registry->set<EntityUpdateSingleton>();
+    TimeSingleton& timeSingleton = registry->set<TimeSingleton>();
+
+    EntityUpdateFixture fixture;
+    CreateEntityUpdateFixture(*registry, static_cast<u32>(state.GetArg()), fixture);
+
+    PacketFramer framer;
+    bool result = true;
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration applyTime = Clock::duration::zero();
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        result &= FrameEntityUpdateTick(fixture, framer);
+        timeSingleton.lifeTimeInS += SERVER_TICK_INTERVAL;
+        state.ResumeTiming();
+
+        for (std::shared_ptr<NetworkPacket>& packet : fixture.packets)
+        {
+            result &= GameSocket::GameHandlers::HandleUpdateEntity(nullptr, packet);
+        }
+
+        Clock::time_point applyStart = Clock::now();
+        EntityUpdateSystem::Apply(*registry);
+        applyTime += Clock::now() - applyStart;
+
+        EntityUpdateSystem::Interpolate(*registry);
+    }
+
+    const size_t batchCapacity = entityUpdateSingleton.entities.capacity();
+
+    registry->destroy(fixture.entities.begin(), fixture.entities.end());
+    registry->unset<TimeSingleton>();
+    registry->unset<EntityUpdateSingleton>();
+    registry->unset<LocalplayerSingleton>();
+
+    if (!result)
+    {
+        state.SkipWithError("A stand-in tick was not handled");
+        return;
+    }
+
+    // Every update appends to the batch, the apply pass then writes one snapshot per entity in entity order
+    // and the interpolation pass reads the snapshots and writes the Transform once per frame
+    const f64 batchBytes = sizeof(entt::entity) + 3 * sizeof(vec3) + sizeof(u32);
+    const f64 snapshotBytes = sizeof(f32) + 3 * sizeof(vec3);
+
+    state.SetItemsPerIteration(fixture.entities.size());
+    state.SetCounter("updates/s at 10Hz", fixture.entities.size() / SERVER_TICK_INTERVAL);
+    state.SetCounter("apply us/tick", state.GetIterations() ? std::chrono::duration<f64, std::micro>(applyTime).count() / state.GetIterations() : 0.0);
+    state.SetCounter("bytes touched/update", batchBytes + snapshotBytes + sizeof(TransformSnapshots) + sizeof(Transform));
+    state.SetCounter("batch capacity", static_cast<f64>(batchCapacity));
+}
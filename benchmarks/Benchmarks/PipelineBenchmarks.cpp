@@ -0,0 +1,165 @@
+#include "../Harness/Benchmark.h"
+#include <Renderer/Descriptors/GraphicsPipelineDesc.h>
+#include <Utils/XXHash64.h>
+#include <robin_hood.h>
+
+namespace
+{
+    constexpr u32 NUM_LOOKUPS = 1000;
+
+    // Same layout PipelineHandlerVK hashes, the render targets are resolved to images before hashing
+    struct GraphicsPipelineCacheDesc
+    {
+        Renderer::GraphicsPipelineDesc::States states;
+
+        Renderer::ImageID renderTargets[Renderer::MAX_RENDER_TARGETS] = { Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid(), Renderer::ImageID::Invalid() };
+        Renderer::DepthImageID depthStencil = Renderer::DepthImageID::Invalid();
+    };
+
+    u64 CalculateCacheDescHash(const Renderer::GraphicsPipelineDesc& desc)
+    {
+        GraphicsPipelineCacheDesc cacheDesc;
+        cacheDesc.states = desc.states;
+
+        for (int i = 0; i < Renderer::MAX_RENDER_TARGETS; i++)
+        {
+            if (desc.renderTargets[i] == Renderer::RenderPassMutableResource::Invalid())
+                break;
+
+            cacheDesc.renderTargets[i] = desc.MutableResourceToImageID(desc.renderTargets[i]);
+        }
+
+        if (desc.depthStencil != Renderer::RenderPassMutableResource::Invalid())
+        {
+            cacheDesc.depthStencil = desc.MutableResourceToDepthImageID(desc.depthStencil);
+        }
+
+        return XXHash64::hash(&cacheDesc, sizeof(cacheDesc), 0);
+    }
+
+    // numPipelines descs the shape of the terrain and UI pipelines, every one with its own shaders, resolved the way RenderGraphResources does it
+    std::vector<Renderer::GraphicsPipelineDesc> GenerateDescs(u32 numPipelines)
+    {
+        std::vector<Renderer::GraphicsPipelineDesc> descs(numPipelines);
+        for (u32 i = 0; i < numPipelines; i++)
+        {
+            Renderer::GraphicsPipelineDesc& desc = descs[i];
+            desc.MutableResourceToImageID = [](Renderer::RenderPassMutableResource resource)
+            {
+                return Renderer::ImageID(static_cast<type_safe::underlying_type<Renderer::ImageID>>(static_cast<type_safe::underlying_type<Renderer::RenderPassMutableResource>>(resource)));
+            };
+            desc.MutableResourceToDepthImageID = [](Renderer::RenderPassMutableResource resource)
+            {
+                return Renderer::DepthImageID(static_cast<type_safe::underlying_type<Renderer::DepthImageID>>(static_cast<type_safe::underlying_type<Renderer::RenderPassMutableResource>>(resource)));
+            };
+
+            desc.states.vertexShader = Renderer::VertexShaderID(static_cast<type_safe::underlying_type<Renderer::VertexShaderID>>(i));
+            desc.states.pixelShader = Renderer::PixelShaderID(static_cast<type_safe::underlying_type<Renderer::PixelShaderID>>(i));
+            desc.states.depthStencilState.depthEnable = i % 2 == 0;
+            desc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
+
+            desc.renderTargets[0] = Renderer::RenderPassMutableResource(0);
+            desc.depthStencil = Renderer::RenderPassMutableResource(1);
+        }
+
+        return descs;
+    }
+}
+
+// CreatePipeline the way it used to find cached pipelines, hashing the desc and scanning every pipeline for the hash
+NC_BENCHMARK_ARGS(Pipeline, LookupLegacy, { 10, 100, 1000 })
+{
+    const u32 numPipelines = static_cast<u32>(state.GetArg());
+    const std::vector<Renderer::GraphicsPipelineDesc> descs = GenerateDescs(numPipelines);
+
+    std::vector<u64> pipelineHashes;
+    for (const Renderer::GraphicsPipelineDesc& desc : descs)
+    {
+        pipelineHashes.push_back(CalculateCacheDescHash(desc));
+    }
+
+    size_t found = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 i = 0; i < NUM_LOOKUPS; i++)
+        {
+            u64 descHash = CalculateCacheDescHash(descs[i % numPipelines]);
+
+            for (size_t id = 0; id < pipelineHashes.size(); id++)
+            {
+                if (pipelineHashes[id] == descHash)
+                {
+                    found += id;
+                    break;
+                }
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(found);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
+
+// CreatePipeline with the hash to ID table, the desc still gets hashed on every call
+NC_BENCHMARK_ARGS(Pipeline, LookupHashed, { 10, 100, 1000 })
+{
+    const u32 numPipelines = static_cast<u32>(state.GetArg());
+    const std::vector<Renderer::GraphicsPipelineDesc> descs = GenerateDescs(numPipelines);
+
+    robin_hood::unordered_map<u64, u16> pipelineHashToID;
+    for (u32 i = 0; i < numPipelines; i++)
+    {
+        pipelineHashToID[CalculateCacheDescHash(descs[i])] = static_cast<u16>(i);
+    }
+
+    if (pipelineHashToID.size() != numPipelines)
+    {
+        state.SkipWithError("Two of the generated pipeline descs hashed the same");
+        return;
+    }
+
+    size_t found = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 i = 0; i < NUM_LOOKUPS; i++)
+        {
+            auto iterator = pipelineHashToID.find(CalculateCacheDescHash(descs[i % numPipelines]));
+            if (iterator != pipelineHashToID.end())
+            {
+                found += iterator->second;
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(found);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
+
+// Renderers holding on to the IDs they got on their first frame, nothing is hashed or looked up after that
+NC_BENCHMARK_ARGS(Pipeline, LookupHeldID, { 10, 100, 1000 })
+{
+    const u32 numPipelines = static_cast<u32>(state.GetArg());
+    const std::vector<Renderer::GraphicsPipelineDesc> descs = GenerateDescs(numPipelines);
+
+    robin_hood::unordered_map<u64, u16> pipelineHashToID;
+    std::vector<Renderer::GraphicsPipelineID> heldIDs(numPipelines, Renderer::GraphicsPipelineID::Invalid());
+
+    size_t found = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 i = 0; i < NUM_LOOKUPS; i++)
+        {
+            Renderer::GraphicsPipelineID& pipeline = heldIDs[i % numPipelines];
+            if (pipeline == Renderer::GraphicsPipelineID::Invalid())
+            {
+                u64 descHash = CalculateCacheDescHash(descs[i % numPipelines]);
+                pipeline = Renderer::GraphicsPipelineID(pipelineHashToID.emplace(descHash, static_cast<u16>(pipelineHashToID.size())).first->second);
+            }
+
+            found += static_cast<type_safe::underlying_type<Renderer::GraphicsPipelineID>>(pipeline);
+        }
+    }
+
+    Benchmark::DoNotOptimize(found);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
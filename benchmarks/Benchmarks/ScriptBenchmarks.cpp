@@ -0,0 +1,651 @@
+#include "../Harness/Benchmark.h"
+#include "../Generators/ScriptGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <entt.hpp>
+#include <functional>
+#include <taskflow/taskflow.hpp>
+#include <Utils/ConcurrentQueue.h>
+
+#include "../../client/Scripting/ScriptHandler.h"
+#include "../../client/Scripting/ScriptEngine.h"
+#include "../../client/Scripting/Addons/scriptbuilder/scriptbuilder.h"
+#include "../../client/Utils/ServiceLocator.h"
+#include "../../client/ECS/Components/Singletons/DataStorageSingleton.h"
+#include "../../client/ECS/Components/Singletons/ScriptSingleton.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    enum class ScriptLoadMode
+    {
+        Cold, // Nothing loaded and no cache files, every script is compiled from source
+        Warm, // Nothing loaded, every script comes from the bytecode cache
+        Reload // Everything loaded and unchanged, what ReloadScripts costs when no script was edited
+    };
+
+    void RunScriptLoad(Benchmark::State& state, ScriptLoadMode mode)
+    {
+        const fs::path directory = fs::temp_directory_path() / "NovusCoreBenchmarks" / ("Scripts_" + std::to_string(state.GetArg()));
+        const fs::path cacheDirectory = directory / "cache";
+        const fs::path scriptDirectory = directory / "scripts";
+
+        std::error_code errorCode;
+        fs::remove_all(directory, errorCode);
+
+        Generators::ScriptGeneratorDesc desc;
+        desc.numScripts = static_cast<u32>(state.GetArg());
+        Generators::ScriptGenerator::Generate(desc, scriptDirectory);
+
+        std::string scriptFolder = scriptDirectory.string();
+        ScriptHandler::SetCacheDirectory(cacheDirectory.string());
+        ScriptHandler::UnloadScripts();
+
+        // Fills the cache and loads everything, which is the starting point for Warm and Reload
+        ScriptHandler::LoadScriptDirectory(scriptFolder);
+
+        bool result = ScriptHandler::GetLoadStats().numScripts == desc.numScripts;
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            if (mode != ScriptLoadMode::Reload)
+            {
+                ScriptHandler::UnloadScripts();
+            }
+            if (mode == ScriptLoadMode::Cold)
+            {
+                fs::remove_all(cacheDirectory, errorCode);
+            }
+            state.ResumeTiming();
+
+            ScriptHandler::LoadScriptDirectory(scriptFolder);
+
+            const ScriptLoadStats& stats = ScriptHandler::GetLoadStats();
+            const u32 numExpected = mode == ScriptLoadMode::Cold ? stats.numCompiled : mode == ScriptLoadMode::Warm ? stats.numFromCache : stats.numUnchanged;
+            result &= stats.numScripts == desc.numScripts && numExpected == desc.numScripts;
+        }
+
+        ScriptHandler::UnloadScripts();
+        ScriptHandler::SetCacheDirectory("");
+
+        if (!result)
+        {
+            state.SkipWithError("Scripts were not loaded the expected way");
+            return;
+        }
+
+        u64 cacheBytes = 0;
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(cacheDirectory, errorCode))
+        {
+            if (entry.is_regular_file())
+            {
+                cacheBytes += entry.file_size();
+            }
+        }
+
+        state.SetItemsPerIteration(desc.numScripts);
+        state.SetCounter("cache KB", cacheBytes / 1024.0);
+    }
+}
+
+// Startup with an empty cache, the argument is the number of generated scripts
+NC_BENCHMARK_ARGS(Script, LoadCold, { 100, 400 })
+{
+    RunScriptLoad(state, ScriptLoadMode::Cold);
+}
+
+// Startup with every script in the bytecode cache, compare against LoadCold with the same argument
+NC_BENCHMARK_ARGS(Script, LoadWarm, { 100, 400 })
+{
+    RunScriptLoad(state, ScriptLoadMode::Warm);
+}
+
+// ReloadScripts when nothing changed, only the dependency hashes are checked and main() is run again
+NC_BENCHMARK_ARGS(Script, ReloadUnchanged, { 100, 400 })
+{
+    RunScriptLoad(state, ScriptLoadMode::Reload);
+}
+
+// Edits the argument's number of scripts out of 100 per iteration and waits for the watcher to swap them in
+// Fails unless exactly the edited modules were recompiled, everything runs headless through ScriptHandler::UpdateReloads
+NC_BENCHMARK_ARGS(Script, HotReload, { 1, 8 })
+{
+    constexpr u32 NUM_SCRIPTS = 100;
+    constexpr auto TIMEOUT = std::chrono::seconds(10);
+
+    const fs::path directory = fs::temp_directory_path() / "NovusCoreBenchmarks" / "ScriptsHotReload";
+    const fs::path scriptDirectory = directory / "scripts";
+
+    std::error_code errorCode;
+    fs::remove_all(directory, errorCode);
+
+    Generators::ScriptGeneratorDesc desc;
+    desc.numScripts = NUM_SCRIPTS;
+    Generators::ScriptGenerator::Generate(desc, scriptDirectory);
+
+    std::string scriptFolder = scriptDirectory.string();
+    ScriptHandler::SetCacheDirectory((directory / "cache").string());
+    ScriptHandler::UnloadScripts();
+    ScriptHandler::LoadScriptDirectory(scriptFolder);
+    ScriptHandler::StartWatching();
+
+    const u32 numEdits = static_cast<u32>(state.GetArg());
+    u32 iteration = 0;
+    f64 compileTime = 0.0;
+    std::string error = "";
+
+    while (state.KeepRunning() && error.empty())
+    {
+        // Different scripts every iteration, appending a comment changes the hash without changing what the script does
+        std::vector<std::string> editedModules;
+        for (u32 i = 0; i < numEdits; i++)
+        {
+            const std::string moduleName = "Script" + std::to_string((iteration * numEdits + i) % NUM_SCRIPTS) + ".as";
+            editedModules.push_back(moduleName);
+
+            std::ofstream file(scriptDirectory / moduleName, std::ofstream::out | std::ofstream::app);
+            file << "// Edit " << iteration << "\n";
+        }
+        std::sort(editedModules.begin(), editedModules.end());
+        iteration++;
+
+        std::vector<std::string> rebuiltModules;
+        const auto start = std::chrono::steady_clock::now();
+
+        while (rebuiltModules.size() < editedModules.size() && std::chrono::steady_clock::now() - start < TIMEOUT)
+        {
+            if (ScriptHandler::UpdateReloads())
+            {
+                for (const ScriptReloadResult& result : ScriptHandler::GetReloadResults())
+                {
+                    rebuiltModules.push_back(result.moduleName);
+                    compileTime += result.msCompileTime;
+                }
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        std::sort(rebuiltModules.begin(), rebuiltModules.end());
+        if (rebuiltModules != editedModules)
+        {
+            error = "Rebuilt " + std::to_string(rebuiltModules.size()) + " modules after editing " + std::to_string(editedModules.size());
+        }
+    }
+
+    ScriptHandler::StopWatching();
+    ScriptHandler::UnloadScripts();
+    ScriptHandler::SetCacheDirectory("");
+
+    if (!error.empty())
+    {
+        state.SkipWithError(error);
+        return;
+    }
+
+    state.SetItemsPerIteration(numEdits);
+    state.SetCounter("compile ms/module", iteration ? compileTime / (iteration * numEdits) : 0.0);
+}
+
+namespace
+{
+    constexpr u32 NUM_CALLBACKS = 100000;
+
+    enum class CallbackDispatchMode
+    {
+        Unpooled, // A context is created and released for every callback
+        Pooled, // Every callback requests a pooled context and prepares it
+        Batched // Callbacks are queued into a ScriptCallbackBatch and run grouped by function, they don't depend on each other's order
+    };
+
+    // Builds a module with the argument's number of callbacks, callbacks are dispatched round robin over them like events on many elements
+    void RunCallbackDispatch(Benchmark::State& state, CallbackDispatchMode mode)
+    {
+        const u32 numFunctions = static_cast<u32>(state.GetArg());
+
+        std::string source;
+        for (u32 i = 0; i < numFunctions; i++)
+        {
+            source += "void Callback" + std::to_string(i) + "(uint value)\n{\n    uint result = value * " + std::to_string(i + 1) + " + 7;\n}\n";
+        }
+
+        asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+        const std::string moduleName = "CallbackDispatch";
+
+        CScriptBuilder builder;
+        if (builder.StartNewModule(scriptEngine, moduleName.c_str()) < 0 || builder.AddSectionFromMemory(moduleName.c_str(), source.c_str()) < 0 || builder.BuildModule() < 0)
+        {
+            state.SkipWithError("Failed to build the callback module");
+            return;
+        }
+
+        asIScriptModule* module = scriptEngine->GetModule(moduleName.c_str());
+
+        std::vector<asIScriptFunction*> functions(numFunctions);
+        for (u32 i = 0; i < numFunctions; i++)
+        {
+            functions[i] = module->GetFunctionByName(("Callback" + std::to_string(i)).c_str());
+        }
+
+        ScriptCallbackBatch batch;
+        u32 numFailed = 0;
+
+        while (state.KeepRunning())
+        {
+            for (u32 i = 0; i < NUM_CALLBACKS; i++)
+            {
+                asIScriptFunction* function = functions[i % numFunctions];
+
+                if (mode == CallbackDispatchMode::Batched)
+                {
+                    batch.Add(function, i);
+                    continue;
+                }
+
+                asIScriptContext* context = mode == CallbackDispatchMode::Pooled ? ScriptEngine::RequestContext() : scriptEngine->CreateContext();
+                context->Prepare(function);
+                context->SetArgDWord(0, i);
+                numFailed += context->Execute() != asEXECUTION_FINISHED;
+
+                if (mode == CallbackDispatchMode::Pooled)
+                {
+                    ScriptEngine::ReturnContext(context);
+                }
+                else
+                {
+                    context->Release();
+                }
+            }
+
+            numFailed += batch.Execute(true);
+        }
+
+        module->Discard();
+
+        if (numFailed > 0)
+        {
+            state.SkipWithError("A callback did not finish");
+            return;
+        }
+
+        state.SetItemsPerIteration(NUM_CALLBACKS);
+    }
+}
+
+// The argument is the number of distinct callback functions, compare against CallbackPooled and CallbackBatched
+NC_BENCHMARK_ARGS(Script, CallbackUnpooled, { 1, 64 })
+{
+    RunCallbackDispatch(state, CallbackDispatchMode::Unpooled);
+}
+
+NC_BENCHMARK_ARGS(Script, CallbackPooled, { 1, 64 })
+{
+    RunCallbackDispatch(state, CallbackDispatchMode::Pooled);
+}
+
+NC_BENCHMARK_ARGS(Script, CallbackBatched, { 1, 64 })
+{
+    RunCallbackDispatch(state, CallbackDispatchMode::Batched);
+}
+
+namespace
+{
+    constexpr u32 NUM_DATA_STORAGE_CALLS = 100000;
+
+    // Every function does count PutU32 and count GetU32 calls spread over the keys set up by Setup
+    const char* DATA_STORAGE_SOURCE = R"(
+array<string> names;
+array<DataStorage::DataKey> keys;
+array<uint> values;
+
+void Setup(uint numKeys)
+{
+    names.resize(numKeys);
+    keys.resize(numKeys);
+    values.resize(numKeys);
+
+    for (uint i = 0; i < numKeys; i++)
+    {
+        names[i] = "BenchmarkKey" + i;
+        keys[i] = DataStorage::Intern(names[i]);
+        values[i] = i;
+    }
+}
+
+uint StringKeys(uint count)
+{
+    uint found = 0;
+    uint value = 0;
+    for (uint i = 0; i < count; i++)
+    {
+        DataStorage::PutU32(names[i % names.length()], i);
+        if (DataStorage::GetU32(names[i % names.length()], value))
+            found++;
+    }
+    return found;
+}
+
+uint InternedKeys(uint count)
+{
+    uint found = 0;
+    uint value = 0;
+    for (uint i = 0; i < count; i++)
+    {
+        DataStorage::PutU32(keys[i % keys.length()], i);
+        if (DataStorage::GetU32(keys[i % keys.length()], value))
+            found++;
+    }
+    return found;
+}
+
+uint Bulk(uint count)
+{
+    uint found = 0;
+    for (uint i = 0; i < count; i += keys.length())
+    {
+        DataStorage::PutU32Array(keys, values);
+        found += DataStorage::GetU32Array(keys, values);
+    }
+    return found;
+}
+
+// Runs on an empty storage before Bulk. The bulk and single key functions have to agree, a bulk only round trip can't catch
+// both sides reading the arrays the same wrong way. Each direction gets its own half of the keys so nothing is overwritten
+bool CheckBulk()
+{
+    const uint half = keys.length() / 2;
+
+    array<DataStorage::DataKey> bulkKeys;
+    array<uint> bulkValues;
+    for (uint i = 0; i < half; i++)
+    {
+        bulkKeys.insertLast(keys[i]);
+        bulkValues.insertLast(i * 7 + 1);
+    }
+
+    DataStorage::PutU32Array(bulkKeys, bulkValues);
+
+    uint value = 0;
+    for (uint i = 0; i < half; i++)
+    {
+        if (!DataStorage::GetU32(keys[i], value) || value != i * 7 + 1)
+            return false;
+    }
+
+    array<DataStorage::DataKey> singleKeys;
+    for (uint i = half; i < keys.length(); i++)
+    {
+        DataStorage::PutU32(keys[i], i * 13 + 5);
+        singleKeys.insertLast(keys[i]);
+    }
+
+    array<uint> readValues;
+    if (DataStorage::GetU32Array(singleKeys, readValues) != singleKeys.length() || readValues.length() != singleKeys.length())
+        return false;
+
+    for (uint i = 0; i < singleKeys.length(); i++)
+    {
+        if (readValues[i] != (half + i) * 13 + 5)
+            return false;
+    }
+
+    return true;
+}
+)";
+
+    // checkFunctionName runs once after Setup and has to return true
+    void RunDataStorageAccess(Benchmark::State& state, const char* functionName, const char* checkFunctionName = nullptr)
+    {
+        const u32 numKeys = static_cast<u32>(state.GetArg());
+
+        entt::registry* registry = ServiceLocator::GetGameRegistry();
+        registry->set<DataStorageSingleton>();
+
+        asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+        const std::string moduleName = "DataStorageAccess";
+
+        CScriptBuilder builder;
+        if (builder.StartNewModule(scriptEngine, moduleName.c_str()) < 0 || builder.AddSectionFromMemory(moduleName.c_str(), DATA_STORAGE_SOURCE) < 0 || builder.BuildModule() < 0)
+        {
+            registry->unset<DataStorageSingleton>();
+            state.SkipWithError("Failed to build the DataStorage module");
+            return;
+        }
+
+        asIScriptModule* module = scriptEngine->GetModule(moduleName.c_str());
+        asIScriptFunction* setupFunction = module->GetFunctionByName("Setup");
+        asIScriptFunction* function = module->GetFunctionByName(functionName);
+
+        asIScriptContext* context = ScriptEngine::RequestContext();
+        context->Prepare(setupFunction);
+        context->SetArgDWord(0, numKeys);
+        bool failed = context->Execute() != asEXECUTION_FINISHED;
+
+        bool isChecked = true;
+        if (!failed && checkFunctionName)
+        {
+            context->Prepare(module->GetFunctionByName(checkFunctionName));
+            failed = context->Execute() != asEXECUTION_FINISHED;
+            isChecked = !failed && context->GetReturnByte() != 0;
+        }
+
+        u32 numFound = 0;
+        while (!failed && isChecked && state.KeepRunning())
+        {
+            context->Prepare(function);
+            context->SetArgDWord(0, NUM_DATA_STORAGE_CALLS);
+            failed = context->Execute() != asEXECUTION_FINISHED;
+            numFound = context->GetReturnDWord();
+        }
+
+        ScriptEngine::ReturnContext(context);
+        module->Discard();
+        registry->unset<DataStorageSingleton>();
+
+        if (!failed && !isChecked)
+        {
+            state.SkipWithError("Bulk and single key DataStorage access disagree");
+            return;
+        }
+
+        if (failed || numFound < NUM_DATA_STORAGE_CALLS)
+        {
+            state.SkipWithError("DataStorage access did not finish or missed keys");
+            return;
+        }
+
+        // One item is a Put and a Get of a single key
+        state.SetItemsPerIteration(NUM_DATA_STORAGE_CALLS);
+    }
+}
+
+// The argument is the number of distinct keys, compare against DataStorageInternedKeys and DataStorageBulk
+NC_BENCHMARK_ARGS(Script, DataStorageStringKeys, { 16, 1024 })
+{
+    RunDataStorageAccess(state, "StringKeys");
+}
+
+NC_BENCHMARK_ARGS(Script, DataStorageInternedKeys, { 16, 1024 })
+{
+    RunDataStorageAccess(state, "InternedKeys");
+}
+
+NC_BENCHMARK_ARGS(Script, DataStorageBulk, { 16, 1024 })
+{
+    RunDataStorageAccess(state, "Bulk", "CheckBulk");
+}
+
+namespace
+{
+    constexpr u32 NUM_TRANSACTIONS = 1000000;
+    constexpr u32 NUM_TRANSACTION_STAGES = 8;
+    constexpr u32 NUM_TRANSACTION_TARGETS = 8;
+
+    enum class TransactionMode
+    {
+        Legacy, // One std::function per transaction in a ConcurrentQueue per stage, what ScriptSingleton used to do
+        Serial, // ScriptSingleton executing every transaction on one thread
+        Parallel // ScriptSingleton executing through a subflow, every target is its own component so the targets run in parallel
+    };
+
+    template <u32 Index>
+    struct TransactionTarget { };
+
+    template <u32... Indices>
+    std::vector<TransactionAccess> GetTargetAccess(std::integer_sequence<u32, Indices...>)
+    {
+        return { ScriptTransactionAccess::Of<TransactionTarget<Indices>>()... };
+    }
+
+    // Stand-in for the legacy design, kept here so the new one has something to be compared against
+    struct LegacyTransactionQueues
+    {
+        LegacyTransactionQueues() : queues(NUM_TRANSACTION_STAGES + 1) { }
+
+        std::atomic<u32> stage = 0;
+        std::vector<moodycamel::ConcurrentQueue<std::function<void()>>> queues;
+    };
+
+    void RunTransactions(Benchmark::State& state, TransactionMode mode)
+    {
+        const u32 numProducers = static_cast<u32>(state.GetArg());
+        const u32 numPerProducer = NUM_TRANSACTIONS / numProducers;
+        const u32 numPerStage = numPerProducer / NUM_TRANSACTION_STAGES;
+
+        const std::vector<TransactionAccess> targetAccess = GetTargetAccess(std::make_integer_sequence<u32, NUM_TRANSACTION_TARGETS>());
+
+        // Padded so the parallel targets don't share cache lines
+        struct alignas(64) Target
+        {
+            u64 value = 0;
+        };
+        std::vector<Target> targets(NUM_TRANSACTION_TARGETS);
+
+        ScriptSingleton scriptSingleton;
+        LegacyTransactionQueues legacyQueues;
+
+        // Producers are tasks on the taskflow workers like the systems are, so every worker keeps its buffer between iterations
+        tf::Taskflow taskflow;
+        tf::Framework producerFramework;
+        for (u32 producer = 0; producer < numProducers; producer++)
+        {
+            producerFramework.emplace([&, producer]()
+            {
+                for (u32 i = 0; i < numPerProducer; i++)
+                {
+                    const u32 targetIndex = (producer + i) % NUM_TRANSACTION_TARGETS;
+                    u64* value = &targets[targetIndex].value;
+                    auto transaction = [value, i]() { *value += i; };
+
+                    if (mode == TransactionMode::Legacy)
+                    {
+                        legacyQueues.queues[legacyQueues.stage].enqueue(transaction);
+                    }
+                    else
+                    {
+                        scriptSingleton.AddTransaction(targetAccess[targetIndex], transaction);
+                    }
+
+                    // Only the first producer completes systems, the others keep producing into whatever stage is current
+                    if (producer == 0 && numPerStage > 0 && (i + 1) % numPerStage == 0 && i + 1 < numPerProducer)
+                    {
+                        legacyQueues.stage = std::min(legacyQueues.stage + 1, NUM_TRANSACTION_STAGES);
+                        scriptSingleton.CompleteSystem();
+                    }
+                }
+            });
+        }
+
+        tf::Framework executeFramework;
+        executeFramework.emplace([&scriptSingleton](tf::SubflowBuilder& subflow)
+        {
+            scriptSingleton.ExecuteTransactions(subflow);
+        });
+
+        Benchmark::Clock::duration enqueueDuration = Benchmark::Clock::duration::zero();
+        Benchmark::Clock::duration executeDuration = Benchmark::Clock::duration::zero();
+        const size_t numAdded = static_cast<size_t>(numPerProducer) * numProducers;
+        bool countsMatch = true;
+
+        while (state.KeepRunning())
+        {
+            Benchmark::Clock::time_point enqueueStart = Benchmark::Clock::now();
+
+            taskflow.run(producerFramework);
+            taskflow.wait_for_all();
+
+            countsMatch &= mode == TransactionMode::Legacy || scriptSingleton.GetNumTransactions() == numAdded;
+
+            Benchmark::Clock::time_point executeStart = Benchmark::Clock::now();
+
+            if (mode == TransactionMode::Legacy)
+            {
+                for (moodycamel::ConcurrentQueue<std::function<void()>>& queue : legacyQueues.queues)
+                {
+                    std::function<void()> transaction;
+                    while (queue.try_dequeue(transaction))
+                    {
+                        transaction();
+                    }
+                }
+
+                legacyQueues.stage = 0;
+            }
+            else if (mode == TransactionMode::Serial)
+            {
+                scriptSingleton.ExecuteTransactions();
+            }
+            else
+            {
+                taskflow.run(executeFramework);
+                taskflow.wait_for_all();
+            }
+
+            scriptSingleton.ResetCompletedSystems();
+            countsMatch &= scriptSingleton.GetNumTransactions() == 0;
+
+            enqueueDuration += executeStart - enqueueStart;
+            executeDuration += Benchmark::Clock::now() - executeStart;
+        }
+
+        u64 total = 0;
+        for (const Target& target : targets)
+        {
+            total += target.value;
+        }
+        Benchmark::DoNotOptimize(total);
+
+        if (!countsMatch)
+        {
+            state.SkipWithError("ScriptSingleton reported the wrong number of recorded transactions");
+            return;
+        }
+
+        const f64 numExecuted = static_cast<f64>(numPerProducer) * numProducers * state.GetIterations();
+        state.SetCounter("enqueueNsPerTransaction", std::chrono::duration<f64, std::nano>(enqueueDuration).count() / numExecuted);
+        state.SetCounter("executeNsPerTransaction", std::chrono::duration<f64, std::nano>(executeDuration).count() / numExecuted);
+        state.SetItemsPerIteration(static_cast<u64>(numPerProducer) * numProducers);
+    }
+}
+
+// Enqueues 1M transactions from the argument's number of producer tasks and executes them, compare against TransactionsSerial and TransactionsParallel
+NC_BENCHMARK_ARGS(Script, TransactionsLegacy, { 1, 4 })
+{
+    RunTransactions(state, TransactionMode::Legacy);
+}
+
+NC_BENCHMARK_ARGS(Script, TransactionsSerial, { 1, 4 })
+{
+    RunTransactions(state, TransactionMode::Serial);
+}
+
+NC_BENCHMARK_ARGS(Script, TransactionsParallel, { 1, 4 })
+{
+    RunTransactions(state, TransactionMode::Parallel);
+}
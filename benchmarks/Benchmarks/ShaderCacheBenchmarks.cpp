@@ -0,0 +1,277 @@
+#include "../Harness/Benchmark.h"
+#include <Renderer/ShaderCache.h>
+#include <Utils/StringUtils.h>
+#include <filesystem>
+#include <fstream>
+#include <robin_hood.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    constexpr u32 NUM_INCLUDES = 8;
+    constexpr u32 NUM_LOOKUPS = 10000;
+
+    struct ShaderTree
+    {
+        fs::path sourceDirectory;
+        fs::path cacheDirectory;
+        fs::path commonInclude;
+        u32 numShaders = 0;
+    };
+
+    void WriteFile(const fs::path& path, const std::string& contents)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+    }
+
+    // numShaders shaders in the shape of the real ones, each including two of NUM_INCLUDES includes that all include one common file
+    // the way terrain.inc.hlsl is shared. The padding stands in for the body of a shader so hashing has something to chew on
+    ShaderTree GenerateShaderTree(const std::string& name, u32 numShaders)
+    {
+        ShaderTree tree;
+        tree.sourceDirectory = fs::temp_directory_path() / "NovusCoreBenchmarks" / name / "shaders";
+        tree.cacheDirectory = fs::temp_directory_path() / "NovusCoreBenchmarks" / name / "cache";
+        tree.commonInclude = tree.sourceDirectory / "common.inc.hlsl";
+        tree.numShaders = numShaders;
+
+        std::error_code errorCode;
+        fs::remove_all(tree.sourceDirectory.parent_path(), errorCode);
+        fs::create_directories(tree.sourceDirectory / "Includes");
+
+        const std::string padding(2048, ' ');
+        WriteFile(tree.commonInclude, "struct Constants\n{\n    float4x4 viewProjection;\n};\n" + padding);
+
+        for (u32 i = 0; i < NUM_INCLUDES; i++)
+        {
+            WriteFile(tree.sourceDirectory / "Includes" / ("include" + std::to_string(i) + ".inc.hlsl"), "#include \"common.inc.hlsl\"\nfloat Function" + std::to_string(i) + "() { return 1.0f; }\n" + padding);
+        }
+
+        for (u32 i = 0; i < numShaders; i++)
+        {
+            std::string source = "#include \"Includes/include" + std::to_string(i % NUM_INCLUDES) + ".inc.hlsl\"\n";
+            source += "  #include \"Includes/include" + std::to_string((i + 1) % NUM_INCLUDES) + ".inc.hlsl\"\n";
+            source += "float4 main() : SV_Target { return float4(" + std::to_string(i) + ", 0, 0, 1); }\n" + padding;
+
+            WriteFile(tree.sourceDirectory / ("shader" + std::to_string(i) + (i % 2 ? ".ps.hlsl" : ".vs.hlsl")), source);
+        }
+
+        return tree;
+    }
+
+    // Stands in for the shader cooker so nothing but the cache is measured, the "SPIR-V" is the source file itself
+    bool CopyCompiler(const fs::path& sourcePath, const fs::path& outputPath, const fs::path& includeDirectory)
+    {
+        std::error_code errorCode;
+        return fs::copy_file(sourcePath, outputPath, fs::copy_options::overwrite_existing, errorCode);
+    }
+
+    bool InitCache(Renderer::ShaderCache& cache, const ShaderTree& tree)
+    {
+        Renderer::ShaderCacheDesc desc;
+        desc.sourceDirectory = tree.sourceDirectory.string();
+        desc.cacheDirectory = tree.cacheDirectory.string();
+
+        cache.SetCompiler(&CopyCompiler);
+        return cache.Init(desc);
+    }
+
+    std::string GetShaderPath(u32 index)
+    {
+        return "Data/shaders/shader" + std::to_string(index) + (index % 2 ? ".ps.hlsl.spv" : ".vs.hlsl.spv");
+    }
+}
+
+// Shader lookups by path the way ShaderHandlerVK used to do them, rehashing the path of every loaded shader, compare against LookupHashed
+NC_BENCHMARK_ARGS(ShaderCache, LookupLegacy, { 16, 64 })
+{
+    const u32 numShaders = static_cast<u32>(state.GetArg());
+
+    std::vector<std::string> paths;
+    for (u32 i = 0; i < numShaders; i++)
+    {
+        paths.push_back(GetShaderPath(i));
+    }
+
+    size_t found = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 i = 0; i < NUM_LOOKUPS; i++)
+        {
+            const std::string& shaderPath = paths[i % numShaders];
+            u32 shaderPathHash = StringUtils::fnv1a_32(shaderPath.c_str(), shaderPath.length());
+
+            for (size_t id = 0; id < paths.size(); id++)
+            {
+                if (StringUtils::fnv1a_32(paths[id].c_str(), paths[id].length()) == shaderPathHash)
+                {
+                    found += id;
+                    break;
+                }
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(found);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
+
+NC_BENCHMARK_ARGS(ShaderCache, LookupHashed, { 16, 64 })
+{
+    const u32 numShaders = static_cast<u32>(state.GetArg());
+
+    std::vector<std::string> paths;
+    robin_hood::unordered_map<u32, u32> pathHashToID;
+    for (u32 i = 0; i < numShaders; i++)
+    {
+        paths.push_back(GetShaderPath(i));
+        pathHashToID[StringUtils::fnv1a_32(paths[i].c_str(), paths[i].length())] = i;
+    }
+
+    size_t found = 0;
+    while (state.KeepRunning())
+    {
+        for (u32 i = 0; i < NUM_LOOKUPS; i++)
+        {
+            const std::string& shaderPath = paths[i % numShaders];
+            auto iterator = pathHashToID.find(StringUtils::fnv1a_32(shaderPath.c_str(), shaderPath.length()));
+            if (iterator != pathHashToID.end())
+            {
+                found += iterator->second;
+            }
+        }
+    }
+
+    Benchmark::DoNotOptimize(found);
+    state.SetItemsPerIteration(NUM_LOOKUPS);
+}
+
+// Scanning and hashing every source and include at startup
+NC_BENCHMARK_ARGS(ShaderCache, Init, { 64, 256 })
+{
+    const ShaderTree tree = GenerateShaderTree("ShaderCacheInit", static_cast<u32>(state.GetArg()));
+
+    bool result = true;
+    while (state.KeepRunning())
+    {
+        Renderer::ShaderCache cache;
+        result &= InitCache(cache, tree) && cache.GetNumShaders() == tree.numShaders;
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("The shader cache didn't find every generated shader");
+        return;
+    }
+
+    state.SetItemsPerIteration(tree.numShaders);
+}
+
+// What a hot reload costs when nothing changed, only the write times are checked
+NC_BENCHMARK_ARGS(ShaderCache, PollUnchanged, { 64, 256 })
+{
+    const ShaderTree tree = GenerateShaderTree("ShaderCachePoll", static_cast<u32>(state.GetArg()));
+
+    Renderer::ShaderCache cache;
+    InitCache(cache, tree);
+
+    std::vector<fs::path> changedShaders;
+    while (state.KeepRunning())
+    {
+        cache.GetChangedShaders(changedShaders);
+    }
+
+    if (!changedShaders.empty())
+    {
+        state.SkipWithError("Shaders were reported as changed without being touched");
+        return;
+    }
+
+    state.SetItemsPerIteration(tree.numShaders);
+}
+
+// Editing the include every shader depends on, every shader has to be found and recompiled and nothing else
+NC_BENCHMARK_ARGS(ShaderCache, ReloadCommonInclude, { 64, 256 })
+{
+    const ShaderTree tree = GenerateShaderTree("ShaderCacheReload", static_cast<u32>(state.GetArg()));
+
+    Renderer::ShaderCache cache;
+    InitCache(cache, tree);
+
+    std::vector<fs::path> dependents;
+    cache.GetDependents(tree.commonInclude, dependents);
+
+    std::vector<fs::path> changedShaders;
+    std::vector<char> binary;
+    bool result = dependents.size() == tree.numShaders;
+    u32 edit = 0;
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        WriteFile(tree.commonInclude, "// Edit " + std::to_string(edit++) + "\nstruct Constants\n{\n    float4x4 viewProjection;\n};\n");
+        changedShaders.clear();
+        state.ResumeTiming();
+
+        cache.GetChangedShaders(changedShaders);
+        for (const fs::path& sourcePath : changedShaders)
+        {
+            result &= cache.Compile(sourcePath, binary);
+        }
+
+        result &= changedShaders.size() == dependents.size();
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("The edited include didn't invalidate exactly the shaders depending on it");
+        return;
+    }
+
+    state.SetItemsPerIteration(tree.numShaders);
+}
+
+// Starting with a cache full of shaders that were recompiled last run, every shader is found in it
+NC_BENCHMARK_ARGS(ShaderCache, WarmLoad, { 64, 256 })
+{
+    const ShaderTree tree = GenerateShaderTree("ShaderCacheWarm", static_cast<u32>(state.GetArg()));
+
+    std::vector<char> binary;
+    {
+        Renderer::ShaderCache cache;
+        InitCache(cache, tree);
+
+        fs::path sourcePath;
+        for (u32 i = 0; i < tree.numShaders; i++)
+        {
+            cache.FindSource(GetShaderPath(i), sourcePath);
+            cache.Compile(sourcePath, binary);
+        }
+    }
+
+    u64 bytes = 0;
+    bool result = true;
+    while (state.KeepRunning())
+    {
+        Renderer::ShaderCache cache;
+        InitCache(cache, tree);
+
+        bytes = 0;
+        fs::path sourcePath;
+        for (u32 i = 0; i < tree.numShaders; i++)
+        {
+            result &= cache.FindSource(GetShaderPath(i), sourcePath) && cache.Load(sourcePath, binary);
+            bytes += binary.size();
+        }
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("A shader compiled last run wasn't found in the cache");
+        return;
+    }
+
+    state.SetItemsPerIteration(tree.numShaders);
+    state.SetBytesPerIteration(bytes);
+}
@@ -0,0 +1,141 @@
+#include "../Harness/Benchmark.h"
+#include "../Fixtures/Fixtures.h"
+#include "../Generators/ScriptGenerator.h"
+#include <filesystem>
+#include <memory>
+#include <entt.hpp>
+#include <taskflow/taskflow.hpp>
+
+#include "../../client/Utils/StartupGraph.h"
+#include "../../client/Gameplay/DBC/DBCLoader.h"
+#include "../../client/Gameplay/Map/MapLoader.h"
+#include "../../client/Scripting/ScriptHandler.h"
+#include "../../client/ECS/Components/Singletons/DBCSingleton.h"
+#include "../../client/ECS/Components/Singletons/MapSingleton.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // The phases of EngineLoop::Run that don't need a window, ClientRenderer is replaced by a null renderer phase that does nothing
+    // so the measured time to first frame is the part of startup that the graph can overlap
+    void RunStartup(Benchmark::State& state, bool serial)
+    {
+        const fs::path& dataDirectory = Fixtures::GetMapDataDirectory();
+        const u32 mapInternalNameHash = Fixtures::GetMapInternalNameHash();
+
+        const fs::path directory = fs::temp_directory_path() / "NovusCoreBenchmarks" / ("Startup_" + std::to_string(state.GetArg()));
+        const fs::path cacheDirectory = directory / "cache";
+        const fs::path scriptDirectory = directory / "scripts";
+
+        std::error_code errorCode;
+        fs::remove_all(directory, errorCode);
+
+        Generators::ScriptGeneratorDesc desc;
+        desc.numScripts = static_cast<u32>(state.GetArg());
+        Generators::ScriptGenerator::Generate(desc, scriptDirectory);
+
+        std::string scriptFolder = scriptDirectory.string();
+        ScriptHandler::SetCacheDirectory(cacheDirectory.string());
+
+        // DBCLoader and MapLoader read from Data/extracted relative to the working directory
+        fs::path previousDirectory = fs::current_path();
+        fs::current_path(dataDirectory);
+
+        tf::Taskflow taskflow;
+        StartupReport report;
+        bool result = true;
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            ScriptHandler::UnloadScripts();
+            fs::remove_all(cacheDirectory, errorCode);
+
+            std::unique_ptr<entt::registry> registry = std::make_unique<entt::registry>();
+            DBCSingleton& dbcSingleton = registry->set<DBCSingleton>();
+            MapSingleton& mapSingleton = registry->set<MapSingleton>();
+
+            StartupGraph startupGraph;
+            StartupGraph::PhaseID dbcPhase = startupGraph.AddPhase("DBC", StartupGraph::Thread::Worker, [&dbcSingleton]()
+            {
+                return DBCLoader::Load(dbcSingleton);
+            });
+            StartupGraph::PhaseID mapPhase = startupGraph.AddPhase("Map", StartupGraph::Thread::Worker, [&mapSingleton, &dbcSingleton]()
+            {
+                return MapLoader::Init(mapSingleton, dbcSingleton);
+            });
+            startupGraph.AddDependency(mapPhase, dbcPhase);
+
+            StartupGraph::PhaseID scriptPrecompilePhase = startupGraph.AddPhase("ScriptPrecompile", StartupGraph::Thread::Worker, [&scriptFolder]()
+            {
+                ScriptHandler::PrecompileScriptDirectory(scriptFolder);
+                return true;
+            });
+
+            StartupGraph::PhaseID rendererPhase = startupGraph.AddPhase("NullRenderer", StartupGraph::Thread::Main, []()
+            {
+                return true;
+            });
+
+            StartupGraph::PhaseID scriptLoadPhase = startupGraph.AddPhase("ScriptLoad", StartupGraph::Thread::Main, [&scriptFolder]()
+            {
+                ScriptHandler::LoadScriptDirectory(scriptFolder);
+                return true;
+            });
+            startupGraph.AddDependency(scriptLoadPhase, rendererPhase);
+            startupGraph.AddDependency(scriptLoadPhase, scriptPrecompilePhase);
+
+            StartupGraph::PhaseID terrainMapPhase = startupGraph.AddPhase("TerrainMap", StartupGraph::Thread::Main, [&registry, mapInternalNameHash]()
+            {
+                return MapLoader::LoadMap(registry.get(), mapInternalNameHash);
+            });
+            startupGraph.AddDependency(terrainMapPhase, rendererPhase);
+            startupGraph.AddDependency(terrainMapPhase, mapPhase);
+            state.ResumeTiming();
+
+            result &= startupGraph.Run(taskflow, serial);
+
+            state.PauseTiming();
+            result &= ScriptHandler::GetLoadStats().numScripts == desc.numScripts;
+
+            // Nothing is presented by the null renderer, the first frame could start as soon as the graph is done
+            report = startupGraph.GetReport();
+            report.msTimeToFirstFrame = report.msTotal;
+
+            registry = nullptr;
+            state.ResumeTiming();
+        }
+
+        fs::current_path(previousDirectory);
+        ScriptHandler::UnloadScripts();
+        ScriptHandler::SetCacheDirectory("");
+
+        if (!result)
+        {
+            state.SkipWithError("A startup phase failed");
+            return;
+        }
+
+        for (const StartupPhaseTiming& phase : report.phases)
+        {
+            state.SetCounter(phase.name + " ms", phase.msDuration);
+        }
+
+        state.SetCounter("serial ms", report.msSerial);
+        state.SetCounter("first frame ms", report.msTimeToFirstFrame);
+        state.SetItemsPerIteration(desc.numScripts);
+    }
+}
+
+// Every phase in order on one thread the way startup used to run, the argument is the number of generated scripts
+NC_BENCHMARK_ARGS(Startup, Serial, { 100, 400 })
+{
+    RunStartup(state, true);
+}
+
+// Compare against Serial with the same argument, "first frame ms" is the wall time and "serial ms" the work it overlapped
+NC_BENCHMARK_ARGS(Startup, Parallel, { 100, 400 })
+{
+    RunStartup(state, false);
+}
@@ -0,0 +1,293 @@
+#include "../Harness/Benchmark.h"
+#include "../Fixtures/Fixtures.h"
+#include "../Generators/FrustumGenerator.h"
+#include <array>
+
+#include "../../client/Utils/CullingUtils.h"
+#include "../../client/Rendering/TerrainHeightQuantizer.h"
+
+namespace
+{
+    std::vector<Generators::Frustum> GenerateFrustums(size_t count)
+    {
+        const Generators::MapGeneratorDesc& mapDesc = Fixtures::GetMapDesc();
+
+        const u16 start = static_cast<u16>((Terrain::MAP_CHUNKS_PER_MAP_STRIDE - mapDesc.chunksPerSide) / 2);
+
+        Generators::FrustumGeneratorDesc desc;
+        desc.seed = mapDesc.seed;
+        desc.minAdt = vec2(start * Terrain::MAP_CHUNK_SIZE);
+        desc.maxAdt = vec2((start + mapDesc.chunksPerSide) * Terrain::MAP_CHUNK_SIZE);
+        desc.minHeight = mapDesc.baseHeight + mapDesc.heightAmplitude;
+        desc.maxHeight = desc.minHeight + 300.0f;
+
+        return Generators::FrustumGenerator::GenerateFrustums(desc, count);
+    }
+
+    // Heights are at most a few thousand yards, where f32 itself can't get closer than this
+    constexpr f32 HEIGHT_ROUNDING_ERROR = 0.001f;
+
+    // Reads a height with the same 4 byte loads and shifts terrain.vs.hlsl uses, so a wrong layout shows up here and not only on screen
+    f32 LoadHeightLikeShader(const TerrainHeightQuantizer::CellHeightHeader& header, const std::vector<u8>& data, u32 vertexID)
+    {
+        auto load = [&data](u32 offset)
+        {
+            u32 value;
+            memcpy(&value, &data[offset], sizeof(u32));
+            return value;
+        };
+
+        if (header.format == TerrainHeightQuantizer::HEIGHT_FORMAT_8BIT)
+        {
+            const u32 quantizedHeight = (load(header.dataOffset + (vertexID & ~3u)) >> ((vertexID & 3) * 8)) & 0xff;
+            return header.heightMin + static_cast<f32>(quantizedHeight) * header.heightStep;
+        }
+        else if (header.format == TerrainHeightQuantizer::HEIGHT_FORMAT_16BIT)
+        {
+            const u32 quantizedHeight = (load(header.dataOffset + ((vertexID * 2) & ~3u)) >> ((vertexID & 1) * 16)) & 0xffff;
+            return header.heightMin + static_cast<f32>(quantizedHeight) * header.heightStep;
+        }
+
+        f32 height;
+        memcpy(&height, &data[header.dataOffset + vertexID * 4], sizeof(f32));
+        return height;
+    }
+
+    // Encodes every cell and checks that both the CPU decode used for collision and the shader style decode stay within maxHeightError
+    bool CompressCells(const std::vector<const f32*>& cells, f32 maxHeightError, std::vector<u8>& data, TerrainHeightQuantizer::QuantizationStats& stats, std::vector<TerrainHeightQuantizer::CellHeightHeader>& headers)
+    {
+        data.clear();
+        headers.clear();
+        stats = TerrainHeightQuantizer::QuantizationStats();
+
+        const f32 heightStep = TerrainHeightQuantizer::GetHeightStep(maxHeightError);
+        for (const f32* heights : cells)
+        {
+            const TerrainHeightQuantizer::HeightFormat format = TerrainHeightQuantizer::ChooseFormat(heights, heightStep);
+            headers.push_back(TerrainHeightQuantizer::EncodeCell(heights, format, heightStep, data, stats));
+        }
+
+        f32 decodedHeights[Terrain::MAP_CELL_TOTAL_GRID_SIZE];
+        for (size_t i = 0; i < cells.size(); i++)
+        {
+            const TerrainHeightQuantizer::CellHeightHeader& header = headers[i];
+            if (header.dataOffset % 4 != 0)
+                return false;
+
+            TerrainHeightQuantizer::DecodeCell(header, data.data(), decodedHeights);
+            for (u32 vertexID = 0; vertexID < Terrain::MAP_CELL_TOTAL_GRID_SIZE; vertexID++)
+            {
+                const f32 height = cells[i][vertexID];
+                if (glm::abs(decodedHeights[vertexID] - height) > maxHeightError + HEIGHT_ROUNDING_ERROR)
+                    return false;
+
+                if (LoadHeightLikeShader(header, data, vertexID) != decodedHeights[vertexID])
+                    return false;
+            }
+        }
+
+        return stats.maxHeightError <= maxHeightError + HEIGHT_ROUNDING_ERROR;
+    }
+
+    // Cells are expected in chunk order, 16 by 16 per chunk. Counts the edge vertices a cell shares with its right and bottom neighbour
+    // that had the same height before encoding but decode to different ones, every one of those would be a crack on screen
+    u32 CountCracks(const std::vector<const f32*>& cells, const std::vector<TerrainHeightQuantizer::CellHeightHeader>& headers, const std::vector<u8>& data)
+    {
+        constexpr u32 CELLS_PER_SIDE = 16;
+        constexpr u32 OUTER_PER_SIDE = 9;
+        constexpr u32 ROW_STRIDE = 17; // 9 outer and 8 inner vertices
+
+        u32 numCracks = 0;
+        for (size_t i = 0; i < cells.size(); i++)
+        {
+            const u32 cellX = static_cast<u32>(i % CELLS_PER_SIDE);
+            const u32 cellY = static_cast<u32>((i / CELLS_PER_SIDE) % CELLS_PER_SIDE);
+
+            auto compare = [&](size_t neighbour, u32 vertexID, u32 neighbourVertexID)
+            {
+                if (cells[i][vertexID] != cells[neighbour][neighbourVertexID])
+                    return;
+
+                const f32 height = TerrainHeightQuantizer::DecodeHeight(headers[i], data.data(), vertexID);
+                const f32 neighbourHeight = TerrainHeightQuantizer::DecodeHeight(headers[neighbour], data.data(), neighbourVertexID);
+                numCracks += height != neighbourHeight;
+            };
+
+            for (u32 j = 0; j < OUTER_PER_SIDE; j++)
+            {
+                if (cellX + 1 < CELLS_PER_SIDE)
+                {
+                    compare(i + 1, j * ROW_STRIDE + (OUTER_PER_SIDE - 1), j * ROW_STRIDE);
+                }
+
+                if (cellY + 1 < CELLS_PER_SIDE)
+                {
+                    compare(i + CELLS_PER_SIDE, (OUTER_PER_SIDE - 1) * ROW_STRIDE + j, j);
+                }
+            }
+        }
+
+        return numCracks;
+    }
+
+    void SetHeightCounters(Benchmark::State& state, const TerrainHeightQuantizer::QuantizationStats& stats)
+    {
+        state.SetCounter("float KB", stats.floatBytes / 1024.0);
+        state.SetCounter("compressed KB", stats.uploadedBytes / 1024.0);
+        state.SetCounter("saved %", 100.0 * stats.GetSavedBytes() / stats.floatBytes);
+        state.SetCounter("8 bit cells", stats.num8BitCells);
+        state.SetCounter("16 bit cells", stats.num16BitCells);
+        state.SetCounter("float cells", stats.numFloatCells);
+        state.SetCounter("max height error", stats.maxHeightError);
+    }
+}
+
+NC_BENCHMARK(Terrain, CullCells)
+{
+    const std::vector<u16>& loadedChunks = Fixtures::GetLoadedChunks();
+    const std::vector<Geometry::AABoundingBox>& cellBoundingBoxes = Fixtures::GetCellBoundingBoxes();
+
+    static const std::vector<Generators::Frustum> frustums = GenerateFrustums(64);
+
+    std::vector<u32> culledInstances;
+    size_t frustumIndex = 0;
+    u64 numVisible = 0;
+
+    while (state.KeepRunning())
+    {
+        const Generators::Frustum& frustum = frustums[frustumIndex++ % frustums.size()];
+
+        Terrain::CullingUtils::CullCells(frustum.planes, loadedChunks, cellBoundingBoxes, culledInstances);
+        numVisible += culledInstances.size();
+
+        Benchmark::DoNotOptimize(culledInstances.data());
+    }
+
+    state.SetItemsPerIteration(cellBoundingBoxes.size());
+    state.SetCounter("cells", static_cast<f64>(cellBoundingBoxes.size()));
+    state.SetCounter("visible_ratio", static_cast<f64>(numVisible) / (static_cast<f64>(state.GetIterations()) * cellBoundingBoxes.size()));
+}
+
+NC_BENCHMARK(Terrain, IsInsideFrustum)
+{
+    const std::vector<Geometry::AABoundingBox>& cellBoundingBoxes = Fixtures::GetCellBoundingBoxes();
+
+    static const std::vector<Generators::Frustum> frustums = GenerateFrustums(1);
+    const vec4* planes = frustums[0].planes;
+
+    size_t boxIndex = 0;
+    u64 numVisible = 0;
+
+    while (state.KeepRunning())
+    {
+        numVisible += Terrain::CullingUtils::IsInsideFrustum(planes, cellBoundingBoxes[boxIndex++ % cellBoundingBoxes.size()]);
+    }
+
+    Benchmark::DoNotOptimize(numVisible);
+    state.SetItemsPerIteration(1);
+}
+
+// Arg is the allowed height error in millimeters. Compresses every cell of the generated map the way TerrainRenderer::LoadChunk does
+NC_BENCHMARK_ARGS(Terrain, CompressHeights, { 1, 10, 50 })
+{
+    const f32 maxHeightError = state.GetArg() / 1000.0f;
+
+    std::vector<const f32*> cells;
+    for (const auto& chunkPair : Fixtures::GetMap().chunks)
+    {
+        for (const Terrain::Cell& cell : chunkPair.second.cells)
+        {
+            cells.push_back(cell.heightData);
+        }
+    }
+
+    std::vector<u8> data;
+    std::vector<TerrainHeightQuantizer::CellHeightHeader> headers;
+    TerrainHeightQuantizer::QuantizationStats stats;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        result &= CompressCells(cells, maxHeightError, data, stats, headers);
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("Decoded heights were further off than the allowed height error");
+        return;
+    }
+
+    if (CountCracks(cells, headers, data) > 0)
+    {
+        state.SkipWithError("Neighbouring cells decoded a shared vertex to different heights");
+        return;
+    }
+
+    state.SetItemsPerIteration(cells.size());
+    SetHeightCounters(state, stats);
+}
+
+// Cells picked to land in every format at a 1cm height error, a flat cell, a gentle slope, a hill, a cliff too tall for 16 bits and noise
+NC_BENCHMARK(Terrain, CompressSyntheticHeights)
+{
+    constexpr f32 maxHeightError = 0.01f;
+    constexpr u32 numCells = 5;
+
+    const TerrainHeightQuantizer::HeightFormat expectedFormats[numCells] =
+    {
+        TerrainHeightQuantizer::HEIGHT_FORMAT_8BIT,
+        TerrainHeightQuantizer::HEIGHT_FORMAT_8BIT,
+        TerrainHeightQuantizer::HEIGHT_FORMAT_16BIT,
+        TerrainHeightQuantizer::HEIGHT_FORMAT_FLOAT,
+        TerrainHeightQuantizer::HEIGHT_FORMAT_16BIT
+    };
+
+    std::vector<std::array<f32, Terrain::MAP_CELL_TOTAL_GRID_SIZE>> heightfields(numCells);
+    u32 randomState = 1337;
+    for (u32 i = 0; i < Terrain::MAP_CELL_TOTAL_GRID_SIZE; i++)
+    {
+        // Rows of 9 outer and 8 inner vertices, same as GetCellSpaceVertexPosition in terrain.inc.hlsl
+        const u32 column = i % 17;
+        const bool isInner = column > 8;
+        const vec2 position = vec2(isInner ? column - 8.5f : column, (i / 17) + (isInner ? 0.5f : 0.0f)) / 8.0f;
+
+        randomState = randomState * 1664525u + 1013904223u;
+        const f32 random = static_cast<f32>(randomState >> 8) / static_cast<f32>(1 << 24);
+
+        heightfields[0][i] = 42.0f;
+        heightfields[1][i] = -100.0f + position.x * 2.0f;
+        heightfields[2][i] = 120.0f + glm::sin(position.x * 3.0f) * glm::cos(position.y * 2.0f) * 60.0f;
+        heightfields[3][i] = position.x < 0.5f ? -500.0f : 1500.0f;
+        heightfields[4][i] = 10.0f + random * 20.0f;
+    }
+
+    std::vector<const f32*> cells;
+    for (const auto& heightfield : heightfields)
+    {
+        cells.push_back(heightfield.data());
+    }
+
+    std::vector<u8> data;
+    std::vector<TerrainHeightQuantizer::CellHeightHeader> headers;
+    TerrainHeightQuantizer::QuantizationStats stats;
+    bool result = true;
+
+    while (state.KeepRunning())
+    {
+        result &= CompressCells(cells, maxHeightError, data, stats, headers);
+    }
+
+    for (u32 i = 0; i < numCells && result; i++)
+    {
+        result &= headers[i].format == expectedFormats[i];
+    }
+
+    if (!result)
+    {
+        state.SkipWithError("A synthetic cell got the wrong format or decoded further off than the allowed height error");
+        return;
+    }
+
+    state.SetItemsPerIteration(numCells);
+    SetHeightCounters(state, stats);
+}
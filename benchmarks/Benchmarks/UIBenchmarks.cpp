@@ -0,0 +1,85 @@
+#include "../Harness/Benchmark.h"
+#include "../Generators/UIGenerator.h"
+#include <entt.hpp>
+
+#include "../../client/UI/ECS/Components/Transform.h"
+#include "../../client/UI/ECS/Components/Text.h"
+#include "../../client/UI/Utils/TransformUtils.h"
+#include "../../client/UI/Utils/TextUtils.h"
+
+NC_BENCHMARK_ARGS(UI, UpdateBounds, { 3, 5, 7 })
+{
+    Generators::UITreeGeneratorDesc desc;
+    desc.depth = static_cast<u32>(state.GetArg());
+    desc.minChildren = 2;
+    desc.maxChildren = 4;
+
+    entt::registry registry;
+    u32 numElements = 0;
+    entt::entity root = Generators::UIGenerator::GenerateTransformTree(desc, registry, numElements);
+
+    UIComponent::Transform* rootTransform = &registry.get<UIComponent::Transform>(root);
+
+    while (state.KeepRunning())
+    {
+        // The root has no parent so this never touches the UIDataSingleton mutexes
+        UIUtils::Transform::UpdateBounds(&registry, rootTransform, false);
+        Benchmark::DoNotOptimize(rootTransform->maxBound);
+    }
+
+    state.SetItemsPerIteration(numElements);
+    state.SetCounter("elements", static_cast<f64>(numElements));
+}
+
+namespace
+{
+    UIComponent::Text CreateText(u32 numWords, bool isMultiline)
+    {
+        Generators::TextGeneratorDesc desc;
+        desc.numWords = numWords;
+
+        UIComponent::Text text;
+        text.text = Generators::UIGenerator::GenerateText(desc);
+        text.fontSize = 16.0f;
+        text.isMultiline = isMultiline;
+
+        static Renderer::Font* font = Generators::UIGenerator::GenerateFont(desc.seed, 16.0f);
+        text.font = font;
+
+        return text;
+    }
+}
+
+NC_BENCHMARK_ARGS(UI, CalculateLineWidthsAndBreaks, { 16, 256, 4096 })
+{
+    UIComponent::Text text = CreateText(static_cast<u32>(state.GetArg()), false);
+
+    std::vector<f32> lineWidths;
+    std::vector<size_t> lineBreakPoints;
+
+    while (state.KeepRunning())
+    {
+        size_t finalCharacter = UIUtils::Text::CalculateLineWidthsAndBreaks(&text, 400.0f, 100000.0f, lineWidths, lineBreakPoints);
+        Benchmark::DoNotOptimize(finalCharacter);
+    }
+
+    state.SetItemsPerIteration(text.text.size());
+    state.SetCounter("lines", static_cast<f64>(lineWidths.size()));
+}
+
+NC_BENCHMARK_ARGS(UI, CalculateAllLineWidthsAndBreaks, { 16, 256, 4096 })
+{
+    UIComponent::Text text = CreateText(static_cast<u32>(state.GetArg()), true);
+
+    std::vector<f32> lineWidths;
+    std::vector<size_t> lineBreakPoints;
+
+    while (state.KeepRunning())
+    {
+        UIUtils::Text::CalculateAllLineWidthsAndBreaks(&text, 400.0f, lineWidths, lineBreakPoints);
+        Benchmark::DoNotOptimize(lineWidths.data());
+    }
+
+    state.SetItemsPerIteration(text.text.size());
+    state.SetCounter("lines", static_cast<f64>(lineWidths.size()));
+}
@@ -0,0 +1,129 @@
+#include "Fixtures.h"
+#include <entt.hpp>
+#include <Utils/DebugHandler.h>
+#include <Utils/StringUtils.h>
+#include <DataGen/DBCGenerator.h>
+
+#include "../../client/Utils/ServiceLocator.h"
+#include "../../client/ECS/Components/Singletons/MapSingleton.h"
+#include "../../client/Gameplay/DBC/DBCLoader.h"
+
+namespace Fixtures
+{
+    Generators::MapGeneratorDesc CreateMapDesc()
+    {
+        Generators::MapGeneratorDesc desc;
+        desc.name = "Benchmark";
+
+        return desc;
+    }
+
+    const Generators::MapGeneratorDesc& GetMapDesc()
+    {
+        static Generators::MapGeneratorDesc desc = CreateMapDesc();
+        return desc;
+    }
+
+    Terrain::Map& GetMap()
+    {
+        MapSingleton& mapSingleton = ServiceLocator::GetGameRegistry()->ctx<MapSingleton>();
+
+        static bool isGenerated = false;
+        if (!isGenerated)
+        {
+            Generators::MapGenerator::GenerateMap(GetMapDesc(), mapSingleton.currentMap);
+            isGenerated = true;
+        }
+
+        return mapSingleton.currentMap;
+    }
+
+    struct BoundingBoxes
+    {
+        BoundingBoxes()
+        {
+            Generators::MapGenerator::CalculateCellBoundingBoxes(GetMap(), loadedChunks, cellBoundingBoxes);
+        }
+
+        std::vector<u16> loadedChunks;
+        std::vector<Geometry::AABoundingBox> cellBoundingBoxes;
+    };
+
+    const BoundingBoxes& GetBoundingBoxes()
+    {
+        static BoundingBoxes boundingBoxes;
+        return boundingBoxes;
+    }
+
+    const std::vector<u16>& GetLoadedChunks()
+    {
+        return GetBoundingBoxes().loadedChunks;
+    }
+
+    const std::vector<Geometry::AABoundingBox>& GetCellBoundingBoxes()
+    {
+        return GetBoundingBoxes().cellBoundingBoxes;
+    }
+
+    std::filesystem::path WriteMapData()
+    {
+        namespace fs = std::filesystem;
+
+        fs::path dataDirectory = fs::temp_directory_path() / "NovusCoreBenchmarks";
+        fs::path mapDirectory = dataDirectory / "Data/extracted/maps" / GetMapDesc().name;
+
+        std::error_code errorCode;
+        fs::remove_all(mapDirectory, errorCode);
+        fs::create_directories(mapDirectory, errorCode);
+        if (errorCode)
+        {
+            NC_LOG_ERROR("Failed to create benchmark map directory %s", mapDirectory.string().c_str());
+            return dataDirectory;
+        }
+
+        Terrain::Map& map = GetMap();
+        for (auto& itr : map.chunks)
+        {
+            u16 x = 0;
+            u16 y = 0;
+            map.GetChunkPositionFromChunkId(itr.first, x, y);
+
+            fs::path chunkPath = mapDirectory / Generators::MapGenerator::GetChunkFileName(GetMapDesc(), x, y);
+            Generators::MapGenerator::WriteChunk(chunkPath, itr.second, map.stringTables[itr.first]);
+        }
+
+        // Register the map through a generated Maps.ndbc, the same way MapLoader::Init does
+        MapSingleton& mapSingleton = ServiceLocator::GetGameRegistry()->ctx<MapSingleton>();
+        if (mapSingleton.mapDBC.GetNumRows() == 0)
+        {
+            fs::path dbcDirectory = dataDirectory / "Data/extracted/Ndbc";
+            fs::create_directories(dbcDirectory, errorCode);
+
+            Generators::GeneratedMapEntry entry;
+            entry.id = 0;
+            entry.name = GetMapDesc().name;
+            entry.internalName = GetMapDesc().name;
+
+            fs::path dbcPath = dbcDirectory / "Maps.ndbc";
+            DBC::File dbcFile;
+            if (!Generators::DBCGenerator::WriteMapsDBC(dbcPath, { entry }) || !DBCLoader::LoadFile(dbcPath, dbcFile) || !mapSingleton.mapDBC.Load(dbcFile))
+            {
+                NC_LOG_ERROR("Failed to register the benchmark map");
+            }
+        }
+
+        return dataDirectory;
+    }
+
+    const std::filesystem::path& GetMapDataDirectory()
+    {
+        static std::filesystem::path dataDirectory = WriteMapData();
+        return dataDirectory;
+    }
+
+    u32 GetMapInternalNameHash()
+    {
+        const std::string& name = GetMapDesc().name;
+        return StringUtils::fnv1a_32(name.c_str(), name.size());
+    }
+}
@@ -0,0 +1,47 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <vector>
+#include <Math/Geometry.h>
+
+#include <DataGen/MapGenerator.h>
+
+// Fixtures are generated once on first use and shared between all benchmarks that use them
+namespace Fixtures
+{
+    const Generators::MapGeneratorDesc& GetMapDesc();
+
+    // The generated map lives in MapSingleton::currentMap so MapUtils can query it
+    Terrain::Map& GetMap();
+
+    // Cell bounding boxes of GetMap, laid out the same way TerrainRenderer stores them
+    const std::vector<u16>& GetLoadedChunks();
+    const std::vector<Geometry::AABoundingBox>& GetCellBoundingBoxes();
+
+    // Writes GetMap to disk and registers it in MapSingleton, returns the directory MapLoader expects as working directory
+    const std::filesystem::path& GetMapDataDirectory();
+    u32 GetMapInternalNameHash();
+}
@@ -0,0 +1,126 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+#include <Renderer/Renderer.h>
+#include <Renderer/RenderPassMerger.h>
+
+namespace Fixtures
+{
+    // Renderer that records nothing, lets CommandList::Execute run through BackendDispatch without a GPU so the render counters can be checked
+    class NullRenderer : public Renderer::Renderer
+    {
+    public:
+        // Render pass key of every graphics pipeline, indexed by pipeline ID. Pipelines not in here never share a render pass
+        std::vector<u32> renderPassKeys;
+
+        void InitWindow(Window* window) override {}
+        void Deinit() override {}
+
+        ::Renderer::BufferID CreateBuffer(::Renderer::BufferDesc& desc) override { return ::Renderer::BufferID::Invalid(); }
+        void QueueDestroyBuffer(::Renderer::BufferID buffer) override {}
+
+        ::Renderer::ImageID CreateImage(::Renderer::ImageDesc& desc) override { return ::Renderer::ImageID::Invalid(); }
+        ::Renderer::DepthImageID CreateDepthImage(::Renderer::DepthImageDesc& desc) override { return ::Renderer::DepthImageID::Invalid(); }
+
+        ::Renderer::SamplerID CreateSampler(::Renderer::SamplerDesc& sampler) override { return ::Renderer::SamplerID::Invalid(); }
+        ::Renderer::GPUSemaphoreID CreateGPUSemaphore() override { return ::Renderer::GPUSemaphoreID::Invalid(); }
+
+        ::Renderer::GraphicsPipelineID CreatePipeline(::Renderer::GraphicsPipelineDesc& desc) override { return ::Renderer::GraphicsPipelineID::Invalid(); }
+        ::Renderer::ComputePipelineID CreatePipeline(::Renderer::ComputePipelineDesc& desc) override { return ::Renderer::ComputePipelineID::Invalid(); }
+
+        u32 GetRenderPassKey(::Renderer::GraphicsPipelineID pipeline) override
+        {
+            const size_t index = static_cast<size_t>(static_cast<::Renderer::GraphicsPipelineID::type>(pipeline));
+            return index < renderPassKeys.size() ? renderPassKeys[index] : ::Renderer::RenderPassMerger::NO_RENDER_PASS;
+        }
+
+        ::Renderer::ModelID CreatePrimitiveModel(::Renderer::PrimitiveModelDesc& desc) override { return ::Renderer::ModelID::Invalid(); }
+        void UpdatePrimitiveModel(::Renderer::ModelID model, ::Renderer::PrimitiveModelDesc& desc) override {}
+
+        ::Renderer::TextureArrayID CreateTextureArray(::Renderer::TextureArrayDesc& desc) override { return ::Renderer::TextureArrayID::Invalid(); }
+
+        ::Renderer::TextureID CreateDataTexture(::Renderer::DataTextureDesc& desc) override { return ::Renderer::TextureID::Invalid(); }
+        ::Renderer::TextureID CreateDataTextureIntoArray(::Renderer::DataTextureDesc& desc, ::Renderer::TextureArrayID textureArray, u32& arrayIndex) override { return ::Renderer::TextureID::Invalid(); }
+
+        ::Renderer::DescriptorSetBackend* CreateDescriptorSetBackend() override { return nullptr; }
+
+        ::Renderer::ModelID LoadModel(::Renderer::ModelDesc& desc) override { return ::Renderer::ModelID::Invalid(); }
+
+        ::Renderer::TextureID LoadTexture(::Renderer::TextureDesc& desc) override { return ::Renderer::TextureID::Invalid(); }
+        ::Renderer::TextureID LoadTextureIntoArray(::Renderer::TextureDesc& desc, ::Renderer::TextureArrayID textureArray, u32& arrayIndex) override { return ::Renderer::TextureID::Invalid(); }
+
+        ::Renderer::VertexShaderID LoadShader(::Renderer::VertexShaderDesc& desc) override { return ::Renderer::VertexShaderID::Invalid(); }
+        ::Renderer::PixelShaderID LoadShader(::Renderer::PixelShaderDesc& desc) override { return ::Renderer::PixelShaderID::Invalid(); }
+        ::Renderer::ComputeShaderID LoadShader(::Renderer::ComputeShaderDesc& desc) override { return ::Renderer::ComputeShaderID::Invalid(); }
+
+        bool InitShaderCache(const ::Renderer::ShaderCacheDesc& desc) override { return true; }
+        u32 ReloadShaders() override { return 0; }
+
+        void FlipFrame(u32 frameIndex) override {}
+
+        ::Renderer::CommandListID BeginCommandList() override { return ::Renderer::CommandListID::Invalid(); }
+        void EndCommandList(::Renderer::CommandListID commandListID) override {}
+        void Clear(::Renderer::CommandListID commandListID, ::Renderer::ImageID image, Color color) override {}
+        void Clear(::Renderer::CommandListID commandListID, ::Renderer::DepthImageID image, ::Renderer::DepthClearFlags clearFlags, f32 depth, u8 stencil) override {}
+        void Draw(::Renderer::CommandListID commandListID, u32 numVertices, u32 numInstances, u32 vertexOffset, u32 instanceOffset) override {}
+        void DrawBindless(::Renderer::CommandListID commandListID, u32 numVertices, u32 numInstances) override {}
+        void DrawIndexedBindless(::Renderer::CommandListID commandListID, ::Renderer::ModelID modelID, u32 numVertices, u32 numInstances) override {}
+        void DrawIndexed(::Renderer::CommandListID commandListID, u32 numIndices, u32 numInstances, u32 indexOffset, u32 vertexOffset, u32 instanceOffset) override {}
+        void DrawIndexedIndirect(::Renderer::CommandListID commandListID, ::Renderer::BufferID argumentBuffer, u32 argumentBufferOffset, u32 drawCount) override {}
+        void DrawIndexedIndirectCount(::Renderer::CommandListID commandListID, ::Renderer::BufferID argumentBuffer, u32 argumentBufferOffset, ::Renderer::BufferID drawCountBuffer, u32 drawCountBufferOffset, u32 maxDrawCount) override {}
+        void Dispatch(::Renderer::CommandListID commandListID, u32 threadGroupCountX, u32 threadGroupCountY, u32 threadGroupCountZ) override {}
+        void DispatchIndirect(::Renderer::CommandListID commandListID, ::Renderer::BufferID argumentBuffer, u32 argumentBufferOffset) override {}
+        void PopMarker(::Renderer::CommandListID commandListID) override {}
+        void PushMarker(::Renderer::CommandListID commandListID, Color color, std::string name) override {}
+        void BeginPipeline(::Renderer::CommandListID commandListID, ::Renderer::GraphicsPipelineID pipeline, bool beginRenderPass) override {}
+        void EndPipeline(::Renderer::CommandListID commandListID, ::Renderer::GraphicsPipelineID pipeline, bool endRenderPass) override {}
+        void SetPipeline(::Renderer::CommandListID commandListID, ::Renderer::ComputePipelineID pipeline) override {}
+        void SetScissorRect(::Renderer::CommandListID commandListID, ::Renderer::ScissorRect scissorRect) override {}
+        void SetViewport(::Renderer::CommandListID commandListID, ::Renderer::Viewport viewport) override {}
+        void SetVertexBuffer(::Renderer::CommandListID commandListID, u32 slot, ::Renderer::BufferID bufferID) override {}
+        void SetIndexBuffer(::Renderer::CommandListID commandListID, ::Renderer::BufferID bufferID, ::Renderer::IndexFormat indexFormat) override {}
+        void SetBuffer(::Renderer::CommandListID commandListID, u32 slot, ::Renderer::BufferID buffer) override {}
+        void BindDescriptorSet(::Renderer::CommandListID commandListID, ::Renderer::DescriptorSetSlot slot, ::Renderer::Descriptor* descriptors, u32 numDescriptors, u32 frameIndex) override {}
+        void MarkFrameStart(::Renderer::CommandListID commandListID, u32 frameIndex) override {}
+        void BeginTrace(::Renderer::CommandListID commandListID, const tracy::SourceLocationData* sourceLocation) override {}
+        void EndTrace(::Renderer::CommandListID commandListID) override {}
+        void AddSignalSemaphore(::Renderer::CommandListID commandListID, ::Renderer::GPUSemaphoreID semaphoreID) override {}
+        void AddWaitSemaphore(::Renderer::CommandListID commandListID, ::Renderer::GPUSemaphoreID semaphoreID) override {}
+        void CopyBuffer(::Renderer::CommandListID commandListID, ::Renderer::BufferID dstBuffer, u64 dstOffset, ::Renderer::BufferID srcBuffer, u64 srcOffset, u64 range) override {}
+        void PipelineBarrier(::Renderer::CommandListID commandListID, ::Renderer::PipelineBarrierType type, ::Renderer::BufferID buffer) override {}
+        void PushConstant(::Renderer::CommandListID commandListID, void* data, u32 offset, u32 size) override {}
+
+        void Present(Window* window, ::Renderer::ImageID image, ::Renderer::GPUSemaphoreID semaphoreID) override {}
+        void Present(Window* window, ::Renderer::DepthImageID image, ::Renderer::GPUSemaphoreID semaphoreID) override {}
+
+        void CopyBuffer(::Renderer::BufferID dstBuffer, u64 dstOffset, ::Renderer::BufferID srcBuffer, u64 srcOffset, u64 range) override {}
+        void* MapBuffer(::Renderer::BufferID buffer) override { return nullptr; }
+        void UnmapBuffer(::Renderer::BufferID buffer) override {}
+
+        void InitImgui() override {}
+        void DrawImgui(::Renderer::CommandListID commandListID) override {}
+    };
+}
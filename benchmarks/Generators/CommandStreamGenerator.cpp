@@ -0,0 +1,191 @@
+#include "CommandStreamGenerator.h"
+#include <Renderer/CommandList.h>
+#include <random>
+
+namespace Generators::CommandStreamGenerator
+{
+    void Generate(const CommandStreamGeneratorDesc& desc, CommandStream& stream)
+    {
+        std::mt19937 rng(desc.seed);
+        std::uniform_real_distribution<f32> chanceDistribution(0.0f, 1.0f);
+        std::uniform_int_distribution<u32> idDistribution(0, 255);
+        std::uniform_int_distribution<u32> descriptorSetDistribution(0, std::max(desc.numDescriptorSets, 1u) - 1);
+        std::uniform_int_distribution<u32> pushConstantSizeDistribution(1, sizeof(stream.pushConstantData) / 4);
+        std::uniform_int_distribution<u32> countDistribution(1, 4096);
+
+        stream.commands.clear();
+        stream.descriptorSets.clear();
+        stream.descriptorSets.resize(std::max(desc.numDescriptorSets, 1u));
+
+        for (Renderer::DescriptorSet& descriptorSet : stream.descriptorSets)
+        {
+            for (u32 i = 0; i < desc.descriptorsPerSet; i++)
+            {
+                descriptorSet.Bind(rng(), Renderer::BufferID(static_cast<Renderer::BufferID::type>(idDistribution(rng))));
+            }
+        }
+
+        auto AddCommand = [&stream](GeneratedCommandType type, u32 arg0 = 0, u32 arg1 = 0, u32 arg2 = 0, u32 arg3 = 0)
+        {
+            stream.commands.push_back({ type, { arg0, arg1, arg2, arg3 } });
+        };
+
+        const u32 numRenderPasses = std::max(desc.numRenderPasses, 1u);
+
+        auto AddDraws = [&]()
+        {
+            for (u32 draw = 0; draw < desc.drawsPerPass; draw++)
+            {
+                // Roughly mirrors what our renderers record per draw, most draws only change a buffer or push constants
+                f32 chance = chanceDistribution(rng);
+                if (chance < 0.25f)
+                {
+                    AddCommand(GeneratedCommandType::BIND_DESCRIPTOR_SET, Renderer::DescriptorSetSlot::PER_DRAW, descriptorSetDistribution(rng));
+                }
+                else if (chance < 0.5f)
+                {
+                    AddCommand(GeneratedCommandType::SET_BUFFER, idDistribution(rng) % 4, idDistribution(rng));
+                }
+                else if (chance < 0.6f)
+                {
+                    AddCommand(GeneratedCommandType::SET_INDEX_BUFFER, idDistribution(rng));
+                }
+                else
+                {
+                    AddCommand(GeneratedCommandType::PUSH_CONSTANT, pushConstantSizeDistribution(rng) * 4);
+                }
+
+                if (chanceDistribution(rng) < 0.8f)
+                {
+                    AddCommand(GeneratedCommandType::DRAW_INDEXED, countDistribution(rng) * 3, 1, countDistribution(rng));
+                }
+                else
+                {
+                    AddCommand(GeneratedCommandType::DRAW, countDistribution(rng) * 3, 1);
+                }
+            }
+        };
+
+        for (u32 pass = 0; pass < desc.numPasses; pass++)
+        {
+            AddCommand(GeneratedCommandType::PUSH_MARKER, pass);
+
+            if (chanceDistribution(rng) < desc.computePassChance)
+            {
+                AddCommand(GeneratedCommandType::BIND_COMPUTE_PIPELINE, idDistribution(rng));
+                AddCommand(GeneratedCommandType::BIND_DESCRIPTOR_SET, Renderer::DescriptorSetSlot::PER_PASS, descriptorSetDistribution(rng));
+                AddCommand(GeneratedCommandType::PUSH_CONSTANT, pushConstantSizeDistribution(rng) * 4);
+                AddCommand(GeneratedCommandType::DISPATCH, countDistribution(rng) / 64 + 1, 1, 1);
+                AddCommand(GeneratedCommandType::PIPELINE_BARRIER, idDistribution(rng));
+                AddCommand(GeneratedCommandType::COPY_BUFFER, idDistribution(rng), idDistribution(rng), countDistribution(rng) * 16);
+            }
+            else
+            {
+                u32 pipelineID = idDistribution(rng);
+
+                AddCommand(GeneratedCommandType::BEGIN_PIPELINE, pipelineID, pipelineID % numRenderPasses);
+                AddCommand(GeneratedCommandType::SET_VIEWPORT);
+                AddCommand(GeneratedCommandType::SET_SCISSOR_RECT);
+                AddCommand(GeneratedCommandType::BIND_DESCRIPTOR_SET, Renderer::DescriptorSetSlot::PER_PASS, descriptorSetDistribution(rng));
+                AddDraws();
+
+                for (u32 pipeline = 1; pipeline < desc.pipelinesPerPass; pipeline++)
+                {
+                    AddCommand(GeneratedCommandType::END_PIPELINE, pipelineID);
+
+                    // Sometimes something that has to happen outside of a render pass is recorded between the pipelines
+                    if (chanceDistribution(rng) < 0.1f)
+                    {
+                        AddCommand(GeneratedCommandType::PIPELINE_BARRIER, idDistribution(rng));
+                    }
+
+                    // Pipelines are spread over the render passes by ID, stepping by numRenderPasses keeps the render pass
+                    u32 nextPipelineID = idDistribution(rng);
+                    if (chanceDistribution(rng) < desc.sameRenderPassChance)
+                    {
+                        nextPipelineID = (nextPipelineID - nextPipelineID % numRenderPasses) + pipelineID % numRenderPasses;
+                    }
+                    pipelineID = nextPipelineID;
+
+                    AddCommand(GeneratedCommandType::BEGIN_PIPELINE, pipelineID, pipelineID % numRenderPasses);
+                    AddCommand(GeneratedCommandType::BIND_DESCRIPTOR_SET, Renderer::DescriptorSetSlot::PER_PASS, descriptorSetDistribution(rng));
+                    AddDraws();
+                }
+
+                AddCommand(GeneratedCommandType::END_PIPELINE, pipelineID);
+            }
+
+            AddCommand(GeneratedCommandType::POP_MARKER);
+        }
+
+        // Every command allocates its command struct plus a function and data pointer, descriptor sets also copy their descriptors
+        constexpr size_t maxCommandSize = 128;
+        stream.estimatedAllocationSize = stream.commands.size() * (maxCommandSize + sizeof(void*) * 2);
+
+        for (const GeneratedCommand& command : stream.commands)
+        {
+            if (command.type == GeneratedCommandType::BIND_DESCRIPTOR_SET)
+            {
+                stream.estimatedAllocationSize += sizeof(Renderer::Descriptor) * desc.descriptorsPerSet;
+            }
+        }
+    }
+
+    void Record(CommandStream& stream, Renderer::CommandList& commandList)
+    {
+        for (const GeneratedCommand& command : stream.commands)
+        {
+            switch (command.type)
+            {
+                case GeneratedCommandType::PUSH_MARKER:
+                    commandList.PushMarker("Pass", Color::White);
+                    break;
+                case GeneratedCommandType::POP_MARKER:
+                    commandList.PopMarker();
+                    break;
+                case GeneratedCommandType::BEGIN_PIPELINE:
+                    commandList.BeginPipeline(Renderer::GraphicsPipelineID(static_cast<Renderer::GraphicsPipelineID::type>(command.args[0])));
+                    break;
+                case GeneratedCommandType::END_PIPELINE:
+                    commandList.EndPipeline(Renderer::GraphicsPipelineID(static_cast<Renderer::GraphicsPipelineID::type>(command.args[0])));
+                    break;
+                case GeneratedCommandType::BIND_COMPUTE_PIPELINE:
+                    commandList.BindPipeline(Renderer::ComputePipelineID(static_cast<Renderer::ComputePipelineID::type>(command.args[0])));
+                    break;
+                case GeneratedCommandType::BIND_DESCRIPTOR_SET:
+                    commandList.BindDescriptorSet(static_cast<Renderer::DescriptorSetSlot>(command.args[0]), &stream.descriptorSets[command.args[1]], 0);
+                    break;
+                case GeneratedCommandType::SET_VIEWPORT:
+                    commandList.SetViewport(0, 0, 1920, 1080, 0.0f, 1.0f);
+                    break;
+                case GeneratedCommandType::SET_SCISSOR_RECT:
+                    commandList.SetScissorRect(0, 1920, 0, 1080);
+                    break;
+                case GeneratedCommandType::SET_BUFFER:
+                    commandList.SetBuffer(command.args[0], Renderer::BufferID(static_cast<Renderer::BufferID::type>(command.args[1])));
+                    break;
+                case GeneratedCommandType::SET_INDEX_BUFFER:
+                    commandList.SetIndexBuffer(Renderer::BufferID(static_cast<Renderer::BufferID::type>(command.args[0])), Renderer::IndexFormat::UInt16);
+                    break;
+                case GeneratedCommandType::PUSH_CONSTANT:
+                    commandList.PushConstant(stream.pushConstantData, 0, command.args[0]);
+                    break;
+                case GeneratedCommandType::DRAW:
+                    commandList.Draw(command.args[0], command.args[1], 0, 0);
+                    break;
+                case GeneratedCommandType::DRAW_INDEXED:
+                    commandList.DrawIndexed(command.args[0], command.args[1], command.args[2], 0, 0);
+                    break;
+                case GeneratedCommandType::DISPATCH:
+                    commandList.Dispatch(command.args[0], command.args[1], command.args[2]);
+                    break;
+                case GeneratedCommandType::COPY_BUFFER:
+                    commandList.CopyBuffer(Renderer::BufferID(static_cast<Renderer::BufferID::type>(command.args[0])), 0, Renderer::BufferID(static_cast<Renderer::BufferID::type>(command.args[1])), 0, command.args[2]);
+                    break;
+                case GeneratedCommandType::PIPELINE_BARRIER:
+                    commandList.PipelineBarrier(Renderer::PipelineBarrierType::ComputeWriteToIndirectArguments, Renderer::BufferID(static_cast<Renderer::BufferID::type>(command.args[0])));
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+#include <Renderer/DescriptorSet.h>
+
+namespace Renderer
+{
+    class CommandList;
+}
+
+namespace Generators
+{
+    enum class GeneratedCommandType : u8
+    {
+        PUSH_MARKER,
+        POP_MARKER,
+        BEGIN_PIPELINE,
+        END_PIPELINE,
+        BIND_COMPUTE_PIPELINE,
+        BIND_DESCRIPTOR_SET,
+        SET_VIEWPORT,
+        SET_SCISSOR_RECT,
+        SET_BUFFER,
+        SET_INDEX_BUFFER,
+        PUSH_CONSTANT,
+        DRAW,
+        DRAW_INDEXED,
+        DISPATCH,
+        COPY_BUFFER,
+        PIPELINE_BARRIER
+    };
+
+    struct GeneratedCommand
+    {
+        GeneratedCommandType type;
+        u32 args[4]; // BEGIN_PIPELINE has the pipeline in args[0] and the render pass key it would get from the renderer in args[1]
+    };
+
+    struct CommandStreamGeneratorDesc
+    {
+        u32 seed = 1337;
+
+        u32 numPasses = 8;
+        u32 drawsPerPass = 256;
+        f32 computePassChance = 0.25f;
+
+        // Graphics passes switch pipelines this many times, the way the UI alternates between panels and text
+        u32 pipelinesPerPass = 1;
+        f32 sameRenderPassChance = 0.75f; // That a pipeline switched to renders into the same framebuffer
+        u32 numRenderPasses = 4;
+
+        u32 numDescriptorSets = 16;
+        u32 descriptorsPerSet = 8;
+    };
+
+    struct CommandStream
+    {
+        std::vector<GeneratedCommand> commands;
+        std::vector<Renderer::DescriptorSet> descriptorSets;
+        u8 pushConstantData[128] = {};
+
+        // Upper bound of what recording the stream allocates from the CommandList allocator
+        size_t estimatedAllocationSize = 0;
+    };
+
+    namespace CommandStreamGenerator
+    {
+        void Generate(const CommandStreamGeneratorDesc& desc, CommandStream& stream);
+
+        // Records the stream into the CommandList, it can be created without a renderer as long as it isn't executed, Fixtures::NullRenderer executes it
+        void Record(CommandStream& stream, Renderer::CommandList& commandList);
+    }
+}
@@ -0,0 +1,60 @@
+#include "FrustumGenerator.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+#include "../../client/Gameplay/Map/Map.h"
+
+namespace Generators::FrustumGenerator
+{
+    void ExtractPlanes(const mat4x4& viewProjectionMatrix, vec4* outPlanes)
+    {
+        const mat4x4 m = glm::transpose(viewProjectionMatrix);
+
+        outPlanes[0] = (m[3] + m[0]); // Left
+        outPlanes[1] = (m[3] - m[0]); // Right
+        outPlanes[2] = (m[3] + m[1]); // Bottom
+        outPlanes[3] = (m[3] - m[1]); // Top
+        outPlanes[4] = (m[3] + m[2]); // Near
+        outPlanes[5] = (m[3] - m[2]); // Far
+    }
+
+    std::vector<Frustum> GenerateFrustums(const FrustumGeneratorDesc& desc, size_t count)
+    {
+        std::mt19937 rng(desc.seed);
+        std::uniform_real_distribution<f32> adtXDistribution(desc.minAdt.x, desc.maxAdt.x);
+        std::uniform_real_distribution<f32> adtYDistribution(desc.minAdt.y, desc.maxAdt.y);
+        std::uniform_real_distribution<f32> heightDistribution(desc.minHeight, desc.maxHeight);
+        std::uniform_real_distribution<f32> yawDistribution(0.0f, glm::two_pi<f32>());
+        std::uniform_real_distribution<f32> pitchDistribution(glm::radians(-60.0f), glm::radians(10.0f));
+
+        const mat4x4 projectionMatrix = glm::perspective(glm::radians(desc.fovY), desc.aspectRatio, desc.nearClip, desc.farClip);
+
+        std::vector<Frustum> frustums;
+        frustums.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            // ADT to world is world = (MAP_HALF_SIZE - adt.y, height, MAP_HALF_SIZE - adt.x)
+            vec3 position;
+            position.x = Terrain::MAP_HALF_SIZE - adtYDistribution(rng);
+            position.y = heightDistribution(rng);
+            position.z = Terrain::MAP_HALF_SIZE - adtXDistribution(rng);
+
+            f32 yaw = yawDistribution(rng);
+            f32 pitch = pitchDistribution(rng);
+
+            vec3 forward;
+            forward.x = glm::cos(pitch) * glm::cos(yaw);
+            forward.y = glm::sin(pitch);
+            forward.z = glm::cos(pitch) * glm::sin(yaw);
+
+            const mat4x4 viewMatrix = glm::lookAt(position, position + forward, vec3(0.0f, 1.0f, 0.0f));
+
+            Frustum& frustum = frustums.emplace_back();
+            frustum.viewProjectionMatrix = projectionMatrix * viewMatrix;
+            ExtractPlanes(frustum.viewProjectionMatrix, frustum.planes);
+        }
+
+        return frustums;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+
+namespace Generators
+{
+    struct Frustum
+    {
+        vec4 planes[6];
+        mat4x4 viewProjectionMatrix;
+    };
+
+    struct FrustumGeneratorDesc
+    {
+        u32 seed = 1337;
+
+        // Cameras are placed inside this ADT space rectangle, use MapGenerator::GeneratePositions bounds to stay above generated terrain
+        vec2 minAdt = vec2(0.0f, 0.0f);
+        vec2 maxAdt = vec2(0.0f, 0.0f);
+
+        f32 minHeight = 50.0f;
+        f32 maxHeight = 400.0f;
+
+        f32 fovY = 75.0f; // degrees
+        f32 aspectRatio = 16.0f / 9.0f;
+        f32 nearClip = 1.0f;
+        f32 farClip = 10000.0f;
+    };
+
+    namespace FrustumGenerator
+    {
+        // Frustum planes are extracted the same way Camera::UpdateFrustumPlanes does it
+        std::vector<Frustum> GenerateFrustums(const FrustumGeneratorDesc& desc, size_t count);
+        void ExtractPlanes(const mat4x4& viewProjectionMatrix, vec4* outPlanes);
+    }
+}
@@ -0,0 +1,59 @@
+#include "PacketStreamGenerator.h"
+#include <Networking/NetworkPacket.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace Generators::PacketStreamGenerator
+{
+    void Generate(const PacketStreamGeneratorDesc& desc, PacketStream& stream)
+    {
+        std::mt19937 rng(desc.seed);
+        std::uniform_real_distribution<f32> chanceDistribution(0.0f, 1.0f);
+        std::uniform_int_distribution<u32> opcodeDistribution(1, 64);
+        std::uniform_int_distribution<u32> smallSizeDistribution(1, desc.maxSmallSize);
+        std::uniform_int_distribution<u32> largeSizeDistribution(desc.maxSmallSize + 1, std::max<u32>(desc.maxLargeSize, desc.maxSmallSize + 1));
+        std::uniform_int_distribution<u32> byteDistribution(0, 255);
+
+        stream.data.clear();
+        stream.fragmentSizes.clear();
+        stream.numPackets = desc.numPackets;
+        stream.payloadBytes = 0;
+
+        for (u32 i = 0; i < desc.numPackets; i++)
+        {
+            const f32 chance = chanceDistribution(rng);
+
+            u16 size = 0;
+            if (chance >= desc.emptyChance)
+            {
+                size = static_cast<u16>(chance < desc.emptyChance + desc.largeChance ? largeSizeDistribution(rng) : smallSizeDistribution(rng));
+            }
+
+            const Opcode opcode = static_cast<Opcode>(opcodeDistribution(rng));
+
+            const size_t offset = stream.data.size();
+            stream.data.resize(offset + sizeof(Opcode) + sizeof(u16) + size);
+
+            u8* packet = &stream.data[offset];
+            std::memcpy(packet, &opcode, sizeof(Opcode));
+            std::memcpy(packet + sizeof(Opcode), &size, sizeof(u16));
+
+            // The content doesn't matter to the framer, a single random byte keeps the generator fast
+            std::memset(packet + sizeof(Opcode) + sizeof(u16), byteDistribution(rng), size);
+
+            stream.payloadBytes += size;
+        }
+
+        std::uniform_int_distribution<u32> fragmentDistribution(std::max(desc.minFragmentSize, 1u), std::max(desc.maxFragmentSize, desc.minFragmentSize));
+
+        size_t remainingBytes = stream.data.size();
+        while (remainingBytes > 0)
+        {
+            const u32 fragmentSize = static_cast<u32>(std::min<size_t>(fragmentDistribution(rng), remainingBytes));
+            stream.fragmentSizes.push_back(fragmentSize);
+
+            remainingBytes -= fragmentSize;
+        }
+    }
+}
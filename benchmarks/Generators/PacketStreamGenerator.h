@@ -0,0 +1,61 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+
+namespace Generators
+{
+    struct PacketStream
+    {
+        // Packets laid out back to back exactly like they arrive on a socket, header followed by payload
+        std::vector<u8> data;
+
+        // How data is split into reads, fragments cut through headers and payloads at arbitrary points
+        std::vector<u32> fragmentSizes;
+
+        u64 numPackets = 0;
+        u64 payloadBytes = 0;
+    };
+
+    struct PacketStreamGeneratorDesc
+    {
+        u32 seed = 1337;
+        u32 numPackets = 1 << 18;
+
+        // Most traffic is small entity updates, with the occasional empty packet and large bulk packet mixed in
+        f32 emptyChance = 0.05f;
+        f32 largeChance = 0.1f;
+        u16 maxSmallSize = 96;
+        u16 maxLargeSize = 4096;
+
+        u32 minFragmentSize = 1;
+        u32 maxFragmentSize = 1460; // TCP MSS on a standard ethernet link
+    };
+
+    namespace PacketStreamGenerator
+    {
+        void Generate(const PacketStreamGeneratorDesc& desc, PacketStream& stream);
+    }
+}
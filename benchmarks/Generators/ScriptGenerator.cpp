@@ -0,0 +1,77 @@
+#include "ScriptGenerator.h"
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace Generators::ScriptGenerator
+{
+    namespace
+    {
+        std::string GenerateStatement(std::mt19937& rng, u32 statementIndex)
+        {
+            std::uniform_int_distribution<u32> typeDistribution(0, 3);
+            std::uniform_int_distribution<i32> valueDistribution(1, 1000);
+
+            const std::string variable = "v" + std::to_string(statementIndex);
+            const std::string value = std::to_string(valueDistribution(rng));
+
+            switch (typeDistribution(rng))
+            {
+                case 0:
+                    return "    int " + variable + " = (result * " + value + " + " + std::to_string(statementIndex) + ") % 7919;\n"
+                           "    result += " + variable + ";\n";
+                case 1:
+                    return "    for (int i = 0; i < " + std::to_string(statementIndex % 8 + 1) + "; i++)\n"
+                           "    {\n"
+                           "        result = (result ^ (i * " + value + ")) & 0xFFFF;\n"
+                           "    }\n";
+                case 2:
+                    return "    string " + variable + " = \"value\" + " + value + ";\n"
+                           "    result += int(" + variable + ".length());\n";
+                default:
+                    return "    array<int> " + variable + " = { " + value + ", result, " + std::to_string(statementIndex) + " };\n"
+                           "    if (" + variable + "[0] > " + variable + "[2])\n"
+                           "        result -= int(" + variable + ".length());\n";
+            }
+        }
+    }
+
+    void Generate(const ScriptGeneratorDesc& desc, const std::filesystem::path& directory)
+    {
+        std::mt19937 rng(desc.seed);
+        std::uniform_int_distribution<u32> functionDistribution(desc.minFunctions, desc.maxFunctions);
+        std::uniform_int_distribution<u32> statementDistribution(desc.minStatements, desc.maxStatements);
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(directory, errorCode);
+
+        for (u32 i = 0; i < desc.numScripts; i++)
+        {
+            std::string source;
+            const u32 numFunctions = functionDistribution(rng);
+
+            for (u32 j = 0; j < numFunctions; j++)
+            {
+                source += "int Function" + std::to_string(j) + "(int result)\n{\n";
+
+                const u32 numStatements = statementDistribution(rng);
+                for (u32 k = 0; k < numStatements; k++)
+                {
+                    source += GenerateStatement(rng, k);
+                }
+
+                source += "    return result;\n}\n\n";
+            }
+
+            source += "void main()\n{\n    int result = " + std::to_string(i) + ";\n";
+            for (u32 j = 0; j < numFunctions; j++)
+            {
+                source += "    result = Function" + std::to_string(j) + "(result);\n";
+            }
+            source += "}\n";
+
+            std::ofstream file(directory / ("Script" + std::to_string(i) + ".as"), std::ofstream::out | std::ofstream::trunc);
+            file << source;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+
+namespace Generators
+{
+    struct ScriptGeneratorDesc
+    {
+        u32 seed = 1337;
+
+        u32 numScripts = 400;
+        u32 minFunctions = 4;
+        u32 maxFunctions = 16;
+        u32 minStatements = 4;
+        u32 maxStatements = 24;
+    };
+
+    namespace ScriptGenerator
+    {
+        // Writes numScripts AngelScript files into directory, every one has a void main() that calls all of its functions
+        // The scripts only use the string and array addons so they compile against the client's script engine without any game state
+        void Generate(const ScriptGeneratorDesc& desc, const std::filesystem::path& directory);
+    }
+}
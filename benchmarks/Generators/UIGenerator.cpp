@@ -0,0 +1,103 @@
+#include "UIGenerator.h"
+#include <entt.hpp>
+#include <random>
+#include <Renderer/Font.h>
+
+#include "../../client/UI/ECS/Components/Transform.h"
+
+namespace Generators::UIGenerator
+{
+    void GenerateChildren(const UITreeGeneratorDesc& desc, entt::registry& registry, std::mt19937& rng, entt::entity parent, u32 depth, u32& numElements)
+    {
+        if (depth >= desc.depth)
+            return;
+
+        std::uniform_int_distribution<u32> childDistribution(desc.minChildren, std::max(desc.minChildren, desc.maxChildren));
+        std::uniform_real_distribution<f32> chanceDistribution(0.0f, 1.0f);
+        std::uniform_real_distribution<f32> positionDistribution(-200.0f, 200.0f);
+        std::uniform_real_distribution<f32> sizeDistribution(8.0f, 300.0f);
+
+        const u32 numChildren = childDistribution(rng);
+        for (u32 i = 0; i < numChildren; i++)
+        {
+            entt::entity entity = registry.create();
+            UIComponent::Transform& transform = registry.emplace<UIComponent::Transform>(entity);
+
+            transform.sortData.entId = entity;
+            transform.sortData.type = UI::UIElementType::UITYPE_PANEL;
+            transform.sortData.depth = static_cast<u16>(depth + 1);
+            transform.parent = parent;
+            transform.localPosition = vec2(positionDistribution(rng), positionDistribution(rng));
+            transform.anchor = vec2(chanceDistribution(rng), chanceDistribution(rng));
+            transform.localAnchor = vec2(chanceDistribution(rng), chanceDistribution(rng));
+            transform.size = vec2(sizeDistribution(rng), sizeDistribution(rng));
+            transform.includeChildBounds = chanceDistribution(rng) < desc.includeChildBoundsChance;
+
+            UIComponent::Transform& parentTransform = registry.get<UIComponent::Transform>(parent);
+            parentTransform.children.push_back({ entity, UI::UIElementType::UITYPE_PANEL });
+            transform.position = parentTransform.position + parentTransform.localPosition;
+
+            numElements++;
+            GenerateChildren(desc, registry, rng, entity, depth + 1, numElements);
+        }
+    }
+
+    entt::entity GenerateTransformTree(const UITreeGeneratorDesc& desc, entt::registry& registry, u32& outNumElements)
+    {
+        std::mt19937 rng(desc.seed);
+
+        entt::entity root = registry.create();
+        UIComponent::Transform& transform = registry.emplace<UIComponent::Transform>(root);
+        transform.sortData.entId = root;
+        transform.sortData.type = UI::UIElementType::UITYPE_PANEL;
+        transform.size = vec2(1920.0f, 1080.0f);
+        transform.includeChildBounds = true;
+
+        outNumElements = 1;
+        GenerateChildren(desc, registry, rng, root, 0, outNumElements);
+
+        return root;
+    }
+
+    std::string GenerateText(const TextGeneratorDesc& desc)
+    {
+        std::mt19937 rng(desc.seed);
+        std::uniform_int_distribution<u32> lengthDistribution(desc.minWordLength, std::max(desc.minWordLength, desc.maxWordLength));
+        std::uniform_int_distribution<u32> characterDistribution('a', 'z');
+        std::uniform_real_distribution<f32> chanceDistribution(0.0f, 1.0f);
+
+        std::string text;
+        text.reserve(desc.numWords * (desc.maxWordLength + 1));
+
+        for (u32 i = 0; i < desc.numWords; i++)
+        {
+            const u32 length = lengthDistribution(rng);
+            for (u32 j = 0; j < length; j++)
+            {
+                text += static_cast<char>(characterDistribution(rng));
+            }
+
+            if (i + 1 < desc.numWords)
+            {
+                text += chanceDistribution(rng) < desc.newlineChance ? '\n' : ' ';
+            }
+        }
+
+        return text;
+    }
+
+    Renderer::Font* GenerateFont(u32 seed, f32 fontSize)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<f32> advanceDistribution(fontSize * 0.3f, fontSize * 0.7f);
+
+        // One advance per printable ASCII character
+        std::vector<f32> advances(95);
+        for (f32& advance : advances)
+        {
+            advance = advanceDistribution(rng);
+        }
+
+        return Renderer::Font::CreateMetricsOnly(fontSize, advances);
+    }
+}
@@ -0,0 +1,68 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <entity/fwd.hpp>
+#include <string>
+#include <vector>
+
+namespace Renderer
+{
+    struct Font;
+}
+
+namespace Generators
+{
+    struct UITreeGeneratorDesc
+    {
+        u32 seed = 1337;
+
+        u32 depth = 4;
+        u32 minChildren = 2;
+        u32 maxChildren = 6;
+
+        f32 includeChildBoundsChance = 0.25f;
+    };
+
+    struct TextGeneratorDesc
+    {
+        u32 seed = 1337;
+
+        u32 numWords = 200;
+        u32 minWordLength = 1;
+        u32 maxWordLength = 12;
+        f32 newlineChance = 0.05f; // Chance per word to be followed by a newline instead of a space
+    };
+
+    namespace UIGenerator
+    {
+        // Creates a tree of UIComponent::Transform components, returns the root entity
+        entt::entity GenerateTransformTree(const UITreeGeneratorDesc& desc, entt::registry& registry, u32& outNumElements);
+
+        std::string GenerateText(const TextGeneratorDesc& desc);
+
+        // Fonts created here have randomized advances and no glyph textures, they are never freed
+        Renderer::Font* GenerateFont(u32 seed, f32 fontSize);
+    }
+}
@@ -0,0 +1,34 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<u64> allocationCount = 0;
+
+    void* CountedAllocate(size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        void* ptr = std::malloc(size ? size : 1);
+        if (!ptr)
+            throw std::bad_alloc();
+
+        return ptr;
+    }
+}
+
+namespace Benchmark::AllocationCounter
+{
+    u64 GetCount()
+    {
+        return allocationCount.load(std::memory_order_relaxed);
+    }
+}
+
+// Replaces the global allocation functions for the whole benchmark executable, the nothrow and sized variants forward to these
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
@@ -0,0 +1,146 @@
+#include "Benchmark.h"
+#include <Utils/DebugHandler.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Benchmark
+{
+    void State::SetCounter(const std::string& name, f64 value)
+    {
+        for (auto& counter : _counters)
+        {
+            if (counter.first == name)
+            {
+                counter.second = value;
+                return;
+            }
+        }
+
+        _counters.emplace_back(name, value);
+    }
+
+    std::vector<BenchmarkInfo>& Registry::GetStorage()
+    {
+        // Function local so registration from other translation units during static initialization is safe
+        static std::vector<BenchmarkInfo> benchmarks;
+        return benchmarks;
+    }
+
+    void Registry::Register(const std::string& name, BenchmarkFunction function, const std::vector<i64>& args)
+    {
+        BenchmarkInfo& info = GetStorage().emplace_back();
+        info.name = name;
+        info.function = function;
+        info.args = args;
+    }
+
+    std::vector<Result> Registry::Run(const RunSettings& settings)
+    {
+        std::vector<Result> results;
+
+        for (const BenchmarkInfo& info : GetStorage())
+        {
+            // Benchmarks without arguments run once with an argument of 0
+            const std::vector<i64> args = info.args.empty() ? std::vector<i64>{ 0 } : info.args;
+
+            for (i64 arg : args)
+            {
+                std::string name = info.args.empty() ? info.name : info.name + "/" + std::to_string(arg);
+                if (!settings.filter.empty() && name.find(settings.filter) == std::string::npos)
+                    continue;
+
+                results.push_back(RunBenchmark(name, info.function, arg, settings));
+            }
+        }
+
+        return results;
+    }
+
+    Result Registry::RunBenchmark(const std::string& name, BenchmarkFunction function, i64 arg, const RunSettings& settings)
+    {
+        Result result;
+        result.name = name;
+
+        // Find an iteration count that makes a single sample take at least minSampleTime
+        u64 iterations = 1;
+        while (true)
+        {
+            State state(iterations, arg);
+            function(state);
+
+            if (!state.GetError().empty())
+            {
+                result.error = state.GetError();
+                NC_LOG_WARNING("%s: %s", name.c_str(), result.error.c_str());
+                return result;
+            }
+
+            f64 elapsed = state.GetElapsedSeconds();
+            if (elapsed >= settings.minSampleTime || iterations >= settings.maxIterations)
+                break;
+
+            // Grow towards the target but never more than 10x at a time, timings of very short runs are noisy
+            f64 multiplier = elapsed > 0.0 ? (settings.minSampleTime / elapsed) * 1.4 : 10.0;
+            multiplier = std::clamp(multiplier, 2.0, 10.0);
+            iterations = std::min(static_cast<u64>(iterations * multiplier), settings.maxIterations);
+        }
+
+        std::vector<f64> sampleNs;
+        sampleNs.reserve(settings.numSamples);
+
+        for (u32 i = 0; i < settings.numSamples; i++)
+        {
+            State state(iterations, arg);
+            function(state);
+
+            // Correctness checks run in every sample, a failure in any of them fails the benchmark
+            if (!state.GetError().empty())
+            {
+                result.error = state.GetError();
+                NC_LOG_WARNING("%s: %s", name.c_str(), result.error.c_str());
+                return result;
+            }
+
+            sampleNs.push_back((state.GetElapsedSeconds() * 1e9) / static_cast<f64>(iterations));
+
+            // Counters and throughput are taken from the last sample, they are expected to be identical between samples
+            if (i == settings.numSamples - 1)
+            {
+                result.counters = state.GetCounters();
+
+                f64 secondsPerIteration = state.GetElapsedSeconds() / static_cast<f64>(iterations);
+                if (secondsPerIteration > 0.0)
+                {
+                    result.itemsPerSecond = state.GetItemsPerIteration() / secondsPerIteration;
+                    result.bytesPerSecond = state.GetBytesPerIteration() / secondsPerIteration;
+                }
+            }
+        }
+
+        result.iterations = iterations;
+        result.samples = settings.numSamples;
+
+        f64 sum = 0.0;
+        for (f64 sample : sampleNs)
+        {
+            sum += sample;
+        }
+        result.meanNs = sum / sampleNs.size();
+
+        f64 variance = 0.0;
+        for (f64 sample : sampleNs)
+        {
+            variance += (sample - result.meanNs) * (sample - result.meanNs);
+        }
+        result.stddevNs = std::sqrt(variance / sampleNs.size());
+
+        std::sort(sampleNs.begin(), sampleNs.end());
+        result.minNs = sampleNs.front();
+        result.maxNs = sampleNs.back();
+
+        size_t middle = sampleNs.size() / 2;
+        result.medianNs = (sampleNs.size() % 2 == 0) ? (sampleNs[middle - 1] + sampleNs[middle]) / 2.0 : sampleNs[middle];
+
+        return result;
+    }
+}
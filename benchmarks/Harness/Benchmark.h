@@ -0,0 +1,185 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Benchmark
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    // Prevents the compiler from optimizing away a value that is only computed for the benchmark
+    template <typename T>
+    inline void DoNotOptimize(const T& value)
+    {
+#if defined(_MSC_VER)
+        const volatile char* ptr = reinterpret_cast<const volatile char*>(&value);
+        (void)*ptr;
+        _ReadWriteBarrier();
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    class State
+    {
+    public:
+        State(u64 iterations, i64 arg)
+            : _iterations(iterations)
+            , _arg(arg)
+        { }
+
+        // The benchmark body loops on this, the timer starts on the first call and stops when it returns false
+        // Everything before the loop is setup and everything after it is teardown, neither is measured
+        __forceinline bool KeepRunning()
+        {
+            if (_currentIteration == 0)
+            {
+                _start = Clock::now();
+            }
+
+            if (_currentIteration < _iterations)
+            {
+                _currentIteration++;
+                return true;
+            }
+
+            _elapsed += Clock::now() - _start;
+            return false;
+        }
+
+        // Excludes per-iteration setup from the measurement
+        void PauseTiming() { _elapsed += Clock::now() - _start; }
+        void ResumeTiming() { _start = Clock::now(); }
+
+        u64 GetIterations() const { return _iterations; }
+        i64 GetArg() const { return _arg; }
+        f64 GetElapsedSeconds() const { return std::chrono::duration<f64>(_elapsed).count(); }
+
+        // Items and bytes are per iteration and get turned into throughput in the results
+        void SetItemsPerIteration(u64 items) { _itemsPerIteration = items; }
+        void SetBytesPerIteration(u64 bytes) { _bytesPerIteration = bytes; }
+        u64 GetItemsPerIteration() const { return _itemsPerIteration; }
+        u64 GetBytesPerIteration() const { return _bytesPerIteration; }
+
+        // Counters are reported as-is, use them for anything that is not a timing (hit rates, memory usage etc)
+        void SetCounter(const std::string& name, f64 value);
+        const std::vector<std::pair<std::string, f64>>& GetCounters() const { return _counters; }
+
+        // Marks the run as failed, the message is reported, the benchmark is excluded from baseline comparison and the run exits with 1
+        void SkipWithError(const std::string& error) { _error = error; _iterations = 0; }
+        const std::string& GetError() const { return _error; }
+
+    private:
+        u64 _iterations = 0;
+        u64 _currentIteration = 0;
+        i64 _arg = 0;
+
+        Clock::time_point _start;
+        Clock::duration _elapsed = Clock::duration::zero();
+
+        u64 _itemsPerIteration = 0;
+        u64 _bytesPerIteration = 0;
+        std::vector<std::pair<std::string, f64>> _counters;
+
+        std::string _error;
+    };
+
+    typedef void (*BenchmarkFunction)(State&);
+
+    struct BenchmarkInfo
+    {
+        std::string name;
+        BenchmarkFunction function = nullptr;
+        std::vector<i64> args;
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::string error;
+
+        u64 iterations = 0;
+        u32 samples = 0;
+
+        // Nanoseconds per iteration over all samples
+        f64 meanNs = 0;
+        f64 medianNs = 0;
+        f64 minNs = 0;
+        f64 maxNs = 0;
+        f64 stddevNs = 0;
+
+        f64 itemsPerSecond = 0;
+        f64 bytesPerSecond = 0;
+
+        std::vector<std::pair<std::string, f64>> counters;
+    };
+
+    struct RunSettings
+    {
+        std::string filter = "";
+        f64 minSampleTime = 0.05; // seconds
+        u32 numSamples = 10;
+        u64 maxIterations = 1000000000;
+    };
+
+    class Registry
+    {
+    public:
+        static void Register(const std::string& name, BenchmarkFunction function, const std::vector<i64>& args);
+        static const std::vector<BenchmarkInfo>& GetBenchmarks() { return GetStorage(); }
+
+        static std::vector<Result> Run(const RunSettings& settings);
+
+    private:
+        static std::vector<BenchmarkInfo>& GetStorage();
+        static Result RunBenchmark(const std::string& name, BenchmarkFunction function, i64 arg, const RunSettings& settings);
+    };
+
+    struct Registration
+    {
+        Registration(const char* name, BenchmarkFunction function, std::vector<i64> args = {})
+        {
+            Registry::Register(name, function, args);
+        }
+    };
+}
+
+// Registers a benchmark named "Group.Name", the body receives a Benchmark::State& named state
+#define NC_BENCHMARK(group, name) \
+    static void group##_##name(Benchmark::State& state); \
+    static Benchmark::Registration group##_##name##_registration(#group "." #name, group##_##name); \
+    static void group##_##name(Benchmark::State& state)
+
+// Registers one benchmark per argument named "Group.Name/Arg", the body reads the argument with state.GetArg()
+#define NC_BENCHMARK_ARGS(group, name, ...) \
+    static void group##_##name(Benchmark::State& state); \
+    static Benchmark::Registration group##_##name##_registration(#group "." #name, group##_##name, __VA_ARGS__); \
+    static void group##_##name(Benchmark::State& state)
@@ -0,0 +1,35 @@
+#include "MemoryUsage.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <unistd.h>
+#endif
+
+namespace Benchmark::MemoryUsage
+{
+    u64 GetResidentBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return counters.WorkingSetSize;
+#elif defined(__linux__)
+        // statm holds the total and resident size in pages
+        std::ifstream statm("/proc/self/statm");
+
+        u64 totalPages = 0;
+        u64 residentPages = 0;
+        if (!(statm >> totalPages >> residentPages))
+            return 0;
+
+        return residentPages * static_cast<u64>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+}
@@ -0,0 +1,284 @@
+#include "ResultWriter.h"
+#include <Utils/DebugHandler.h>
+#include <fstream>
+#include <iomanip>
+
+namespace Benchmark::ResultWriter
+{
+    std::string EscapeJSON(const std::string& string)
+    {
+        std::string escaped;
+        escaped.reserve(string.size());
+
+        for (char c : string)
+        {
+            switch (c)
+            {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\t': escaped += "\\t"; break;
+                default: escaped += c; break;
+            }
+        }
+
+        return escaped;
+    }
+
+    std::string EscapeCSV(const std::string& string)
+    {
+        if (string.find_first_of(",\"\n") == std::string::npos)
+            return string;
+
+        std::string escaped = "\"";
+        for (char c : string)
+        {
+            if (c == '"')
+                escaped += '"';
+
+            escaped += c;
+        }
+        escaped += '"';
+
+        return escaped;
+    }
+
+    void Print(const std::vector<Result>& results)
+    {
+        printf("%-56s %14s %14s %14s %12s %16s\n", "Benchmark", "Median (ns)", "Mean (ns)", "Stddev (ns)", "Iterations", "Items/s");
+        for (const Result& result : results)
+        {
+            if (!result.error.empty())
+            {
+                printf("%-56s ERROR: %s\n", result.name.c_str(), result.error.c_str());
+                continue;
+            }
+
+            printf("%-56s %14.1f %14.1f %14.1f %12llu %16.0f\n", result.name.c_str(), result.medianNs, result.meanNs, result.stddevNs, static_cast<unsigned long long>(result.iterations), result.itemsPerSecond);
+
+            for (const auto& counter : result.counters)
+            {
+                printf("    %-52s %14.3f\n", counter.first.c_str(), counter.second);
+            }
+        }
+    }
+
+    bool WriteJSON(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream output(path, std::ofstream::out | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create benchmark JSON output %s", path.c_str());
+            return false;
+        }
+
+        output << std::setprecision(17);
+        output << "{\n  \"benchmarks\": [\n";
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result& result = results[i];
+
+            output << "    {\n";
+            output << "      \"name\": \"" << EscapeJSON(result.name) << "\",\n";
+
+            if (!result.error.empty())
+            {
+                output << "      \"error\": \"" << EscapeJSON(result.error) << "\"\n";
+            }
+            else
+            {
+                output << "      \"iterations\": " << result.iterations << ",\n";
+                output << "      \"samples\": " << result.samples << ",\n";
+                output << "      \"mean_ns\": " << result.meanNs << ",\n";
+                output << "      \"median_ns\": " << result.medianNs << ",\n";
+                output << "      \"min_ns\": " << result.minNs << ",\n";
+                output << "      \"max_ns\": " << result.maxNs << ",\n";
+                output << "      \"stddev_ns\": " << result.stddevNs << ",\n";
+                output << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+                output << "      \"bytes_per_second\": " << result.bytesPerSecond << ",\n";
+                output << "      \"counters\": {";
+
+                for (size_t j = 0; j < result.counters.size(); j++)
+                {
+                    output << (j == 0 ? " " : ", ") << "\"" << EscapeJSON(result.counters[j].first) << "\": " << result.counters[j].second;
+                }
+
+                output << (result.counters.empty() ? "}\n" : " }\n");
+            }
+
+            output << (i + 1 < results.size() ? "    },\n" : "    }\n");
+        }
+
+        output << "  ]\n}\n";
+        return true;
+    }
+
+    bool WriteCSV(const std::string& path, const std::vector<Result>& results)
+    {
+        std::ofstream output(path, std::ofstream::out | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create benchmark CSV output %s", path.c_str());
+            return false;
+        }
+
+        output << std::setprecision(17);
+        output << "name,iterations,samples,mean_ns,median_ns,min_ns,max_ns,stddev_ns,items_per_second,bytes_per_second,counters,error\n";
+
+        for (const Result& result : results)
+        {
+            std::string counters;
+            for (const auto& counter : result.counters)
+            {
+                if (!counters.empty())
+                    counters += ";";
+
+                counters += counter.first + "=" + std::to_string(counter.second);
+            }
+
+            output << EscapeCSV(result.name) << ","
+                << result.iterations << ","
+                << result.samples << ","
+                << result.meanNs << ","
+                << result.medianNs << ","
+                << result.minNs << ","
+                << result.maxNs << ","
+                << result.stddevNs << ","
+                << result.itemsPerSecond << ","
+                << result.bytesPerSecond << ","
+                << EscapeCSV(counters) << ","
+                << EscapeCSV(result.error) << "\n";
+        }
+
+        return true;
+    }
+
+    std::vector<std::string> SplitCSVLine(const std::string& line)
+    {
+        std::vector<std::string> columns;
+        std::string column;
+        bool inQuotes = false;
+
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            char c = line[i];
+
+            if (inQuotes)
+            {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"')
+                {
+                    column += '"';
+                    i++;
+                }
+                else if (c == '"')
+                {
+                    inQuotes = false;
+                }
+                else
+                {
+                    column += c;
+                }
+            }
+            else if (c == '"')
+            {
+                inQuotes = true;
+            }
+            else if (c == ',')
+            {
+                columns.push_back(column);
+                column.clear();
+            }
+            else if (c != '\r')
+            {
+                column += c;
+            }
+        }
+
+        columns.push_back(column);
+        return columns;
+    }
+
+    bool LoadBaseline(const std::string& path, robin_hood::unordered_map<std::string, f64>& outMedianNs)
+    {
+        std::ifstream input(path);
+        if (!input)
+        {
+            NC_LOG_ERROR("Failed to open benchmark baseline %s", path.c_str());
+            return false;
+        }
+
+        std::string line;
+        if (!std::getline(input, line))
+        {
+            NC_LOG_ERROR("Benchmark baseline %s is empty", path.c_str());
+            return false;
+        }
+
+        std::vector<std::string> header = SplitCSVLine(line);
+        size_t nameColumn = header.size();
+        size_t medianColumn = header.size();
+        size_t errorColumn = header.size();
+
+        for (size_t i = 0; i < header.size(); i++)
+        {
+            if (header[i] == "name")
+                nameColumn = i;
+            else if (header[i] == "median_ns")
+                medianColumn = i;
+            else if (header[i] == "error")
+                errorColumn = i;
+        }
+
+        if (nameColumn == header.size() || medianColumn == header.size())
+        {
+            NC_LOG_ERROR("Benchmark baseline %s is missing the name or median_ns column", path.c_str());
+            return false;
+        }
+
+        while (std::getline(input, line))
+        {
+            if (line.empty())
+                continue;
+
+            std::vector<std::string> columns = SplitCSVLine(line);
+            if (columns.size() <= std::max(nameColumn, medianColumn))
+                continue;
+
+            // Benchmarks that failed when the baseline was recorded have nothing to compare against
+            if (errorColumn < columns.size() && !columns[errorColumn].empty())
+                continue;
+
+            outMedianNs[columns[nameColumn]] = std::stod(columns[medianColumn]);
+        }
+
+        return true;
+    }
+
+    std::vector<Regression> CompareToBaseline(const std::vector<Result>& results, const robin_hood::unordered_map<std::string, f64>& baselineMedianNs, f64 threshold)
+    {
+        std::vector<Regression> regressions;
+
+        for (const Result& result : results)
+        {
+            if (!result.error.empty())
+                continue;
+
+            auto itr = baselineMedianNs.find(result.name);
+            if (itr == baselineMedianNs.end() || itr->second <= 0.0)
+                continue;
+
+            f64 ratio = result.medianNs / itr->second;
+            if (ratio > 1.0 + threshold)
+            {
+                Regression& regression = regressions.emplace_back();
+                regression.name = result.name;
+                regression.baselineNs = itr->second;
+                regression.currentNs = result.medianNs;
+                regression.ratio = ratio;
+            }
+        }
+
+        return regressions;
+    }
+}
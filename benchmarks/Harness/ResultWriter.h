@@ -0,0 +1,55 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <robin_hood.h>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace Benchmark
+{
+    struct Regression
+    {
+        std::string name;
+        f64 baselineNs = 0;
+        f64 currentNs = 0;
+        f64 ratio = 0;
+    };
+
+    namespace ResultWriter
+    {
+        void Print(const std::vector<Result>& results);
+
+        bool WriteJSON(const std::string& path, const std::vector<Result>& results);
+        bool WriteCSV(const std::string& path, const std::vector<Result>& results);
+
+        // Baselines are CSV files previously written by WriteCSV, only the name and median_ns columns are used
+        bool LoadBaseline(const std::string& path, robin_hood::unordered_map<std::string, f64>& outMedianNs);
+
+        // A benchmark regresses when its median is more than threshold (0.1 = 10%) slower than the baseline median
+        std::vector<Regression> CompareToBaseline(const std::vector<Result>& results, const robin_hood::unordered_map<std::string, f64>& baselineMedianNs, f64 threshold);
+    }
+}
@@ -0,0 +1,155 @@
+#include <Utils/DebugHandler.h>
+#include <entt.hpp>
+#include <string>
+#include <SceneManager.h>
+
+#include "Harness/Benchmark.h"
+#include "Harness/ResultWriter.h"
+
+#include "../client/Utils/ServiceLocator.h"
+#include "../client/ECS/Components/Singletons/MapSingleton.h"
+#include "../client/ECS/Components/Singletons/DBCSingleton.h"
+
+void PrintUsage()
+{
+    NC_LOG_MESSAGE("Usage: benchmarks [options]");
+    NC_LOG_MESSAGE("  --list                 List all benchmarks and exit");
+    NC_LOG_MESSAGE("  --filter <text>        Only run benchmarks whose name contains text");
+    NC_LOG_MESSAGE("  --json <path>          Write results as JSON");
+    NC_LOG_MESSAGE("  --csv <path>           Write results as CSV, these files can be used as a baseline");
+    NC_LOG_MESSAGE("  --baseline <path>      Compare against a CSV baseline, exits with 1 on regressions (failed benchmarks always exit with 1)");
+    NC_LOG_MESSAGE("  --threshold <ratio>    Allowed slowdown against the baseline before it counts as a regression (default 0.1)");
+    NC_LOG_MESSAGE("  --min-time <seconds>   Minimum time per sample (default 0.05)");
+    NC_LOG_MESSAGE("  --samples <count>      Samples per benchmark (default 10)");
+}
+
+i32 main(i32 argc, char* argv[])
+{
+    Benchmark::RunSettings settings;
+    std::string jsonPath = "";
+    std::string csvPath = "";
+    std::string baselinePath = "";
+    f64 threshold = 0.1;
+    bool listOnly = false;
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--list")
+        {
+            listOnly = true;
+        }
+        else if (argument == "--filter" && hasValue)
+        {
+            settings.filter = argv[++i];
+        }
+        else if (argument == "--json" && hasValue)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (argument == "--csv" && hasValue)
+        {
+            csvPath = argv[++i];
+        }
+        else if (argument == "--baseline" && hasValue)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (argument == "--threshold" && hasValue)
+        {
+            threshold = std::stod(argv[++i]);
+        }
+        else if (argument == "--min-time" && hasValue)
+        {
+            settings.minSampleTime = std::stod(argv[++i]);
+        }
+        else if (argument == "--samples" && hasValue)
+        {
+            settings.numSamples = std::max(static_cast<u32>(std::stoul(argv[++i])), 1u);
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (listOnly)
+    {
+        for (const Benchmark::BenchmarkInfo& info : Benchmark::Registry::GetBenchmarks())
+        {
+            if (info.args.empty())
+            {
+                NC_LOG_MESSAGE("%s", info.name.c_str());
+                continue;
+            }
+
+            for (i64 arg : info.args)
+            {
+                NC_LOG_MESSAGE("%s/%lld", info.name.c_str(), static_cast<long long>(arg));
+            }
+        }
+
+        return 0;
+    }
+
+    // Benchmarks run against the same singletons as the client, without a window, renderer or extracted data
+    entt::registry gameRegistry;
+    ServiceLocator::SetGameRegistry(&gameRegistry);
+    gameRegistry.set<MapSingleton>();
+    gameRegistry.set<DBCSingleton>();
+
+    // Script engines hook OnSceneLoaded into the SceneManager while registering their interface
+    SceneManager sceneManager;
+    ServiceLocator::SetSceneManager(&sceneManager);
+
+    std::vector<Benchmark::Result> results = Benchmark::Registry::Run(settings);
+    Benchmark::ResultWriter::Print(results);
+
+    // Benchmarks double as correctness checks, any of them failing fails the run even without a baseline
+    u32 numFailed = 0;
+    for (const Benchmark::Result& result : results)
+    {
+        if (result.error.empty())
+            continue;
+
+        NC_LOG_ERROR("Failed %s: %s", result.name.c_str(), result.error.c_str());
+        numFailed++;
+    }
+
+    if (!jsonPath.empty() && !Benchmark::ResultWriter::WriteJSON(jsonPath, results))
+        return 1;
+
+    if (!csvPath.empty() && !Benchmark::ResultWriter::WriteCSV(csvPath, results))
+        return 1;
+
+    if (!baselinePath.empty())
+    {
+        robin_hood::unordered_map<std::string, f64> baselineMedianNs;
+        if (!Benchmark::ResultWriter::LoadBaseline(baselinePath, baselineMedianNs))
+            return 1;
+
+        std::vector<Benchmark::Regression> regressions = Benchmark::ResultWriter::CompareToBaseline(results, baselineMedianNs, threshold);
+        if (!regressions.empty())
+        {
+            for (const Benchmark::Regression& regression : regressions)
+            {
+                NC_LOG_ERROR("Regression in %s: %.1fns -> %.1fns (%.1f%% slower)", regression.name.c_str(), regression.baselineNs, regression.currentNs, (regression.ratio - 1.0) * 100.0);
+            }
+
+            return 1;
+        }
+
+        NC_LOG_SUCCESS("No regressions against %s (threshold %.1f%%)", baselinePath.c_str(), threshold * 100.0);
+    }
+
+    if (numFailed > 0)
+    {
+        NC_LOG_ERROR("%u of %u benchmarks failed", numFailed, static_cast<u32>(results.size()));
+        return 1;
+    }
+
+    return 0;
+}
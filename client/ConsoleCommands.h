@@ -35,6 +35,9 @@
 #include "ConsoleCommands/QuitCommand.h"
 #include "ConsoleCommands/PingCommand.h"
 #include "ConsoleCommands/ScriptCommand.h"
+#include "ConsoleCommands/ConnectCommand.h"
+#include "ConsoleCommands/CaptureCommand.h"
+#include "ConsoleCommands/InputCaptureCommand.h"
 #include "EngineLoop.h"
 
 class ConsoleCommandHandler
@@ -46,6 +49,11 @@ public:
         RegisterCommand("ping"_h, &PingCommand);
         RegisterCommand("reload"_h, &ReloadCommand);
         RegisterCommand("loadmap"_h, &LoadMapCommand);
+        RegisterCommand("connect"_h, &ConnectCommand);
+        RegisterCommand("capture"_h, &CaptureCommand);
+        RegisterCommand("replay"_h, &ReplayCommand);
+        RegisterCommand("inputcapture"_h, &InputCaptureCommand);
+        RegisterCommand("inputreplay"_h, &InputReplayCommand);
     }
 
     void HandleCommand(EngineLoop& engineLoop, std::string& command)
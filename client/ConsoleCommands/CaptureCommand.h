@@ -0,0 +1,80 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2019 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <Utils/DebugHandler.h>
+#include <entt.hpp>
+#include <vector>
+#include "../EngineLoop.h"
+#include "../Utils/ServiceLocator.h"
+#include "../ECS/Components/Network/ConnectionSingleton.h"
+
+// capture <path> starts recording incoming packets to path, capture stop ends it
+void CaptureCommand(EngineLoop& engineLoop, std::vector<std::string> subCommands)
+{
+    if (subCommands.size() == 0)
+    {
+        NC_LOG_WARNING("Usage: capture <path|stop>");
+        return;
+    }
+
+    entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
+    PacketCapture& packetCapture = gameRegistry->ctx<ConnectionSingleton>().packetCapture;
+
+    if (subCommands[0] == "stop")
+    {
+        if (!packetCapture.IsOpen())
+            return;
+
+        packetCapture.Close();
+        NC_LOG_SUCCESS("Captured %llu packets", static_cast<unsigned long long>(packetCapture.GetPacketCount()));
+        return;
+    }
+
+    if (packetCapture.Open(subCommands[0]))
+    {
+        NC_LOG_SUCCESS("Capturing packets to %s", subCommands[0].c_str());
+    }
+}
+
+// replay <path> [fast] injects a capture into the packet queues, at its original timing or all at once with fast
+void ReplayCommand(EngineLoop& engineLoop, std::vector<std::string> subCommands)
+{
+    if (subCommands.size() == 0)
+    {
+        NC_LOG_WARNING("Usage: replay <path> [fast]");
+        return;
+    }
+
+    std::shared_ptr<PacketReplay> packetReplay = std::make_shared<PacketReplay>();
+    if (!packetReplay->Load(subCommands[0]))
+        return;
+
+    bool fast = subCommands.size() > 1 && subCommands[1] == "fast";
+    packetReplay->Start(fast ? PacketReplay::Mode::AsFastAsPossible : PacketReplay::Mode::OriginalTiming);
+
+    entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
+    std::atomic_store(&gameRegistry->ctx<ConnectionSingleton>().packetReplay, packetReplay);
+
+    NC_LOG_SUCCESS("Replaying %u packets over %.2fs", static_cast<u32>(packetReplay->GetPacketCount()), packetReplay->GetDurationUS() / 1000000.0);
+}
@@ -0,0 +1,92 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2019 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <Utils/DebugHandler.h>
+#include <Networking/NetworkClient.h>
+#include <asio/ip/address_v4.hpp>
+#include <entt.hpp>
+#include <charconv>
+#include <limits>
+#include <vector>
+#include "../EngineLoop.h"
+#include "../Utils/ServiceLocator.h"
+#include "../ECS/Components/Network/ConnectionSingleton.h"
+
+// connect <region|game> <address> <port>
+// region starts the login flow on the auth socket, the region server then redirects it to the auth server
+void ConnectCommand(EngineLoop& engineLoop, std::vector<std::string> subCommands)
+{
+    if (subCommands.size() < 3)
+    {
+        NC_LOG_WARNING("Usage: connect <region|game> <address> <port>");
+        return;
+    }
+
+    asio::error_code error;
+    asio::ip::address_v4 address = asio::ip::make_address_v4(subCommands[1], error);
+    if (error)
+    {
+        NC_LOG_WARNING("connect: %s is not a valid IPv4 address", subCommands[1].c_str());
+        return;
+    }
+
+    // from_chars instead of stoul, it doesn't throw and rejects trailing garbage like "3724abc"
+    const std::string& portString = subCommands[2];
+    u32 port = 0;
+    std::from_chars_result parseResult = std::from_chars(portString.data(), portString.data() + portString.size(), port);
+    if (parseResult.ec != std::errc() || parseResult.ptr != portString.data() + portString.size() || port == 0 || port > std::numeric_limits<u16>::max())
+    {
+        NC_LOG_WARNING("connect: %s is not a valid port, expected 1-65535", portString.c_str());
+        return;
+    }
+
+    entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
+    ConnectionSingleton& connectionSingleton = gameRegistry->ctx<ConnectionSingleton>();
+
+    std::shared_ptr<NetworkClient> connection = nullptr;
+    if (subCommands[0] == "region")
+    {
+        connection = connectionSingleton.authConnection;
+    }
+    else if (subCommands[0] == "game")
+    {
+        connection = connectionSingleton.gameConnection;
+    }
+    else
+    {
+        NC_LOG_WARNING("connect: unknown connection %s, expected region or game", subCommands[0].c_str());
+        return;
+    }
+
+    if (!connection)
+    {
+        NC_LOG_WARNING("connect: the %s connection hasn't been created yet", subCommands[0].c_str());
+        return;
+    }
+
+    if (!connection->Connect(address.to_uint(), static_cast<u16>(port)))
+    {
+        NC_LOG_WARNING("connect: failed to connect to %s:%u", subCommands[1].c_str(), port);
+    }
+}
@@ -0,0 +1,82 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2019 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <Utils/DebugHandler.h>
+#include <InputManager.h>
+#include <memory>
+#include <vector>
+#include "../EngineLoop.h"
+#include "../Utils/ServiceLocator.h"
+
+// inputcapture <path> starts recording every input event to path, inputcapture stop ends it
+void InputCaptureCommand(EngineLoop& engineLoop, std::vector<std::string> subCommands)
+{
+    if (subCommands.size() == 0)
+    {
+        NC_LOG_WARNING("Usage: inputcapture <path|stop>");
+        return;
+    }
+
+    InputRecorder& inputRecorder = ServiceLocator::GetInputManager()->GetRecorder();
+
+    if (subCommands[0] == "stop")
+    {
+        if (!inputRecorder.IsOpen())
+            return;
+
+        inputRecorder.Close();
+        NC_LOG_SUCCESS("Captured %llu input events over %u frames", static_cast<unsigned long long>(inputRecorder.GetEventCount()), inputRecorder.GetFrame() + 1);
+        return;
+    }
+
+    if (inputRecorder.Open(subCommands[0]))
+    {
+        NC_LOG_SUCCESS("Capturing input to %s", subCommands[0].c_str());
+    }
+}
+
+// inputreplay <path> feeds a capture into the InputManager one recorded frame per engine frame, inputreplay stop ends it early
+void InputReplayCommand(EngineLoop& engineLoop, std::vector<std::string> subCommands)
+{
+    if (subCommands.size() == 0)
+    {
+        NC_LOG_WARNING("Usage: inputreplay <path|stop>");
+        return;
+    }
+
+    InputManager* inputManager = ServiceLocator::GetInputManager();
+
+    if (subCommands[0] == "stop")
+    {
+        inputManager->SetReplay(nullptr);
+        return;
+    }
+
+    std::shared_ptr<InputReplay> inputReplay = std::make_shared<InputReplay>();
+    if (!inputReplay->Load(subCommands[0]))
+        return;
+
+    inputManager->SetReplay(inputReplay);
+    NC_LOG_SUCCESS("Replaying %u input events over %u frames", static_cast<u32>(inputReplay->GetEventCount()), inputReplay->GetFrameCount());
+}
@@ -3,6 +3,9 @@
 #include <Utils/ConcurrentQueue.h>
 #include <Networking/NetworkPacket.h>
 #include <Networking/NetworkClient.h>
+#include "../../../Network/PacketFramer.h"
+#include "../../../Network/PacketWriter.h"
+#include "../../../Network/PacketCapture.h"
 
 struct ConnectionSingleton
 {
@@ -13,4 +16,21 @@ public:
     std::shared_ptr<NetworkClient> gameConnection;
     moodycamel::ConcurrentQueue<std::shared_ptr<NetworkPacket>> authPacketQueue;
     moodycamel::ConcurrentQueue<std::shared_ptr<NetworkPacket>> gamePacketQueue;
+
+    // Only touched from the socket read handlers
+    PacketFramer authPacketFramer;
+    PacketFramer gamePacketFramer;
+
+    // Outgoing packets are coalesced here during the frame and sent by ConnectionUpdateSystem::Flush
+    PacketWriter authPacketWriter;
+    PacketWriter gamePacketWriter;
+
+    // Records incoming packets while it's open, replays inject into the packet queues from ConnectionUpdateSystem::Update
+    // packetReplay is handed over from the console thread, always access it with std::atomic_load/std::atomic_store
+    PacketCapture packetCapture;
+    std::shared_ptr<PacketReplay> packetReplay;
+
+    // Packets handled by the last ConnectionUpdateSystem::Update and how long it took, this is the client side cost of ingesting them
+    u32 lastUpdatePacketCount = 0;
+    f32 lastUpdateTimeMS = 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <NovusTypes.h>
+#include <entity/fwd.hpp>
+#include <vector>
+
+// SMSG_UPDATE_ENTITY packets received this frame, stored as a structure of arrays
+// GameHandlers only append here, EntityUpdateSystem applies the whole batch to the registry in one pass
+struct EntityUpdateSingleton
+{
+    std::vector<entt::entity> entities;
+    std::vector<vec3> positions;
+    std::vector<vec3> rotations;
+    std::vector<vec3> scales;
+
+    // Scratch space for sorting the batch by entity, kept around so its capacity is reused every frame
+    std::vector<u32> order;
+
+    void Add(entt::entity entity, const vec3& position, const vec3& rotation, const vec3& scale)
+    {
+        entities.push_back(entity);
+        positions.push_back(position);
+        rotations.push_back(rotation);
+        scales.push_back(scale);
+    }
+
+    size_t Size() const { return entities.size(); }
+
+    void Clear()
+    {
+        entities.clear();
+        positions.clear();
+        rotations.clear();
+        scales.clear();
+    }
+};
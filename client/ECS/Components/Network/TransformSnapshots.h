@@ -0,0 +1,72 @@
+#pragma once
+#include <NovusTypes.h>
+#include <glm/gtx/compatibility.hpp>
+
+// Ring of the last server transforms of an entity, Transform is interpolated between them a fixed delay behind the newest one
+// so entities move smoothly between server ticks instead of snapping at the tick rate
+struct TransformSnapshots
+{
+    static constexpr u32 NUM_SNAPSHOTS = 4;
+
+    f32 times[NUM_SNAPSHOTS];
+    vec3 positions[NUM_SNAPSHOTS];
+    vec3 rotations[NUM_SNAPSHOTS];
+    vec3 scales[NUM_SNAPSHOTS];
+
+    u32 newest = 0;
+    u32 count = 0;
+
+    void Push(f32 time, const vec3& position, const vec3& rotation, const vec3& scale)
+    {
+        newest = (newest + 1) % NUM_SNAPSHOTS;
+        count = glm::min(count + 1, NUM_SNAPSHOTS);
+
+        times[newest] = time;
+        positions[newest] = position;
+        rotations[newest] = rotation;
+        scales[newest] = scale;
+    }
+
+    // Snapshots from oldest (0) to newest (count - 1)
+    u32 GetIndex(u32 age) const { return (newest + NUM_SNAPSHOTS - (count - 1 - age)) % NUM_SNAPSHOTS; }
+
+    // Returns false if there is nothing to sample yet, times outside of the ring clamp to the oldest or newest snapshot
+    bool Sample(f32 time, vec3& outPosition, vec3& outRotation, vec3& outScale) const
+    {
+        if (count == 0)
+            return false;
+
+        u32 from = GetIndex(0);
+        if (time <= times[from])
+        {
+            outPosition = positions[from];
+            outRotation = rotations[from];
+            outScale = scales[from];
+            return true;
+        }
+
+        for (u32 i = 1; i < count; i++)
+        {
+            u32 to = GetIndex(i);
+            if (time < times[to])
+            {
+                f32 t = (time - times[from]) / glm::max(times[to] - times[from], 0.0001f);
+
+                outPosition = glm::lerp(positions[from], positions[to], t);
+                outScale = glm::lerp(scales[from], scales[to], t);
+
+                // Rotations are in degrees, take the short way around
+                vec3 delta = glm::mod(rotations[to] - rotations[from] + 180.0f, 360.0f) - 180.0f;
+                outRotation = rotations[from] + delta * t;
+                return true;
+            }
+
+            from = to;
+        }
+
+        outPosition = positions[newest];
+        outRotation = rotations[newest];
+        outScale = scales[newest];
+        return true;
+    }
+};
@@ -25,7 +25,7 @@
 #include <NovusTypes.h>
 #include <robin_hood.h>
 #include "../../../Gameplay/Map/Map.h"
-#include "../../../Gameplay/DBC/DBC.h"
+#include "../../../Gameplay/DBC/DBCTable.h"
 
 struct MapSingleton
 {
@@ -34,10 +34,6 @@ struct MapSingleton
     Terrain::Map currentMap;
 	u32 loadedMapHash = 0;
 
-	robin_hood::unordered_map<u16, DBC::Map*> mapIdToDBC;
-	robin_hood::unordered_map<u32, DBC::Map*> mapNameToDBC;
-	robin_hood::unordered_map<u32, DBC::Map*> mapInternalNameToDBC;
-	std::vector<DBC::Map> mapDBCFiles;
-
-	StringTable mapsDBCStringTable;
+	// Indexed by Id, Name and InternalName hashes, see DBC::Map::Index
+	DBCTable<DBC::Map> mapDBC;
 };
@@ -1,18 +1,26 @@
 #pragma once
 #include <NovusTypes.h>
-#include <vector>
-#include <mutex>
+#include <algorithm>
 #include <atomic>
-#include <functional>
-#include <Utils/ConcurrentQueue.h>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <taskflow/taskflow.hpp>
 
+#include "ScriptTransactionBuffer.h"
+
+// Transactions are recorded by the systems into per-thread buffers during the update and executed together by ScriptSingletonTask
+// A transaction is tagged with the number of systems that had completed when it was added, transactions run in the order of those
+// stages and in the order they were added within a thread. Transactions that declare disjoint component access may run in parallel
+//
+// Lanes share one entt::registry, which is only safe as long as they get or patch components that already exist. Creating or
+// destroying entities, emplacing or removing components and the first access to a component type (which creates its pool) all
+// change the registry as a whole, transactions doing that have to be added without access so they run on their own
 struct ScriptSingleton
 {
-    ScriptSingleton() : _systemCompleteCount(0), _queueCreateLock(), _transactionQueues()
-    {
-        _transactionQueues.reserve(16);
-        _transactionQueues.push_back(moodycamel::ConcurrentQueue<std::function<void()>>());
-    }
+    ScriptSingleton() : _id(_nextId++), _systemCompleteCount(0), _producerLock(), _producers() { }
 
     ScriptSingleton& operator=(const ScriptSingleton& o)
     {
@@ -22,11 +30,6 @@ struct ScriptSingleton
     void CompleteSystem()
     {
         _systemCompleteCount++;
-        if (_systemCompleteCount >= _transactionQueues.size())
-        {
-            std::lock_guard lock(_queueCreateLock);
-            _transactionQueues.push_back(moodycamel::ConcurrentQueue<std::function<void()>>());
-        }
     }
 
     void ResetCompletedSystems()
@@ -34,25 +37,252 @@ struct ScriptSingleton
         _systemCompleteCount = 0;
     }
 
-    void AddTransaction(std::function<void()> const& transaction)
+    template <typename Callable>
+    void AddTransaction(Callable&& transaction)
+    {
+        AddTransaction(0, std::forward<Callable>(transaction));
+    }
+
+    // Use ScriptTransactionAccess::Of<Components...>() for access, transactions added without it are never run in parallel
+    // Only declare access for transactions that get or patch existing components, see the restriction above
+    template <typename Callable>
+    void AddTransaction(TransactionAccess access, Callable&& transaction)
     {
-        _transactionQueues[_systemCompleteCount].enqueue(transaction);
+        GetProducerBuffer().Add(_systemCompleteCount.load(std::memory_order_relaxed), access, std::forward<Callable>(transaction));
     }
 
+    // Executes every recorded transaction on the calling thread
     void ExecuteTransactions()
     {
-        for (moodycamel::ConcurrentQueue<std::function<void()>>& transactionQueue : _transactionQueues)
+        GatherTransactions();
+
+        for (ScriptTransaction* transaction : _executionOrder)
+        {
+            transaction->Execute();
+        }
+
+        ResetTransactions();
+    }
+
+    // Executes every recorded transaction as tasks of subflow. Transactions are split into groups, within a group they are spread over
+    // lanes with disjoint access that run in parallel while every lane runs its transactions in order. Transactions without declared
+    // access can't share a group with more than one lane, so they only ever run in order with everything around them
+    void ExecuteTransactions(tf::SubflowBuilder& subflow)
+    {
+        GatherTransactions();
+
+        const size_t numTransactions = _executionOrder.size();
+        tf::Task previous = subflow.placeholder();
+
+        size_t begin = 0;
+        while (begin < numTransactions)
         {
-            std::function<void()> transaction;
-            while (transactionQueue.try_dequeue(transaction))
+            const size_t end = BuildGroup(begin);
+
+            if (_laneAccess.size() <= 1)
             {
-                transaction();
+                tf::Task task = subflow.emplace([this, begin, end]() { ExecuteRange(begin, end); });
+                previous.precede(task);
+                previous = task;
             }
+            else
+            {
+                // Lanes are independent, so the group can be reordered to make every lane contiguous
+                std::stable_sort(_groupLanes.begin(), _groupLanes.end(), [](const std::pair<u32, ScriptTransaction*>& a, const std::pair<u32, ScriptTransaction*>& b)
+                {
+                    return a.first < b.first;
+                });
+
+                tf::Task join = subflow.placeholder();
+
+                size_t laneBegin = begin;
+                for (size_t i = 0; i < _groupLanes.size(); i++)
+                {
+                    _executionOrder[begin + i] = _groupLanes[i].second;
+
+                    if (i + 1 == _groupLanes.size() || _groupLanes[i + 1].first != _groupLanes[i].first)
+                    {
+                        const size_t laneEnd = begin + i + 1;
+                        tf::Task task = subflow.emplace([this, laneBegin, laneEnd]() { ExecuteLane(laneBegin, laneEnd); });
+                        previous.precede(task);
+                        task.precede(join);
+
+                        laneBegin = laneEnd;
+                    }
+                }
+
+                previous = join;
+            }
+
+            begin = end;
         }
+
+        tf::Task reset = subflow.emplace([this]() { ResetTransactions(); });
+        previous.precede(reset);
+    }
+
+    // Safe to call while systems are still adding transactions, the count may just be behind by whatever is being added right now
+    size_t GetNumTransactions() const
+    {
+        std::lock_guard lock(_producerLock);
+
+        size_t numTransactions = 0;
+        for (const Producer& producer : _producers)
+        {
+            numTransactions += producer.buffer->GetNumTransactions();
+        }
+
+        return numTransactions;
+    }
+
+    // True while the calling thread runs a lane that may run in parallel with others, code making structural registry changes
+    // can assert on this to catch transactions that declared access they shouldn't have
+    static bool IsInParallelLane()
+    {
+        return _inParallelLane;
     }
 
 private:
+    struct Producer
+    {
+        std::thread::id threadId;
+        std::unique_ptr<ScriptTransactionBuffer> buffer;
+    };
+
+    ScriptTransactionBuffer& GetProducerBuffer()
+    {
+        // Ids are never reused, so a stale cache from a destroyed singleton can't match a new one at the same address
+        thread_local u64 cachedId = 0;
+        thread_local ScriptTransactionBuffer* cachedBuffer = nullptr;
+
+        if (cachedId != _id)
+        {
+            std::lock_guard lock(_producerLock);
+
+            const std::thread::id threadId = std::this_thread::get_id();
+            auto itr = std::find_if(_producers.begin(), _producers.end(), [threadId](const Producer& producer) { return producer.threadId == threadId; });
+            if (itr == _producers.end())
+            {
+                _producers.push_back({ threadId, std::make_unique<ScriptTransactionBuffer>() });
+                itr = _producers.end() - 1;
+            }
+
+            cachedId = _id;
+            cachedBuffer = itr->buffer.get();
+        }
+
+        return *cachedBuffer;
+    }
+
+    void GatherTransactions()
+    {
+        std::lock_guard lock(_producerLock);
+
+        _executionOrder.clear();
+        for (const Producer& producer : _producers)
+        {
+            const std::vector<ScriptTransaction*>& transactions = producer.buffer->GetTransactions();
+            _executionOrder.insert(_executionOrder.end(), transactions.begin(), transactions.end());
+        }
+
+        // Stable so transactions keep the order they were added in within a thread
+        std::stable_sort(_executionOrder.begin(), _executionOrder.end(), [](const ScriptTransaction* a, const ScriptTransaction* b)
+        {
+            return a->stage < b->stage;
+        });
+    }
+
+    void ResetTransactions()
+    {
+        std::lock_guard lock(_producerLock);
+
+        for (Producer& producer : _producers)
+        {
+            producer.buffer->Reset();
+        }
+
+        _executionOrder.clear();
+    }
+
+    // Assigns transactions from begin onwards to lanes until one touches more than one lane, returns where the group ends
+    size_t BuildGroup(size_t begin)
+    {
+        _laneAccess.clear();
+        _groupLanes.clear();
+
+        bool hasUndeclaredAccess = false;
+
+        size_t end = begin;
+        for (; end < _executionOrder.size(); end++)
+        {
+            ScriptTransaction* transaction = _executionOrder[end];
+
+            u32 lane = static_cast<u32>(_laneAccess.size());
+            if (transaction->access == 0)
+            {
+                if (_laneAccess.size() > 1)
+                    break;
+
+                hasUndeclaredAccess = true;
+                lane = 0;
+            }
+            else
+            {
+                if (hasUndeclaredAccess)
+                    break;
+
+                u32 numOverlapping = 0;
+                for (u32 i = 0; i < _laneAccess.size(); i++)
+                {
+                    if (_laneAccess[i] & transaction->access)
+                    {
+                        lane = i;
+                        numOverlapping++;
+                    }
+                }
+
+                if (numOverlapping > 1)
+                    break;
+            }
+
+            if (lane == _laneAccess.size())
+            {
+                _laneAccess.push_back(0);
+            }
+
+            _laneAccess[lane] |= transaction->access;
+            _groupLanes.push_back({ lane, transaction });
+        }
+
+        return end;
+    }
+
+    void ExecuteRange(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            _executionOrder[i]->Execute();
+        }
+    }
+
+    void ExecuteLane(size_t begin, size_t end)
+    {
+        _inParallelLane = true;
+        ExecuteRange(begin, end);
+        _inParallelLane = false;
+    }
+
+private:
+    static inline std::atomic<u64> _nextId = 1;
+    static inline thread_local bool _inParallelLane = false;
+
+    const u64 _id;
     std::atomic<u32> _systemCompleteCount;
-    std::mutex _queueCreateLock;
-    std::vector<moodycamel::ConcurrentQueue<std::function<void()>>> _transactionQueues;
-};
\ No newline at end of file
+
+    mutable std::mutex _producerLock;
+    std::vector<Producer> _producers;
+    std::vector<ScriptTransaction*> _executionOrder;
+
+    std::vector<TransactionAccess> _laneAccess;
+    std::vector<std::pair<u32, ScriptTransaction*>> _groupLanes;
+};
@@ -0,0 +1,154 @@
+#pragma once
+#include <NovusTypes.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bit mask of the components a transaction touches, transactions with disjoint masks may execute in parallel
+// A mask of 0 means the access is unknown and the transaction is executed on its own
+using TransactionAccess = u64;
+
+struct ScriptTransactionAccess
+{
+    template <typename... Components>
+    static TransactionAccess Of()
+    {
+        return (GetBit<Components>() | ... | 0);
+    }
+
+private:
+    template <typename Component>
+    static TransactionAccess GetBit()
+    {
+        // Past 64 component types bits are shared, that only makes unrelated transactions look like they overlap
+        static const TransactionAccess bit = TransactionAccess(1) << (_nextBit++ % 64);
+        return bit;
+    }
+
+    static inline std::atomic<u32> _nextBit = 0;
+};
+
+struct ScriptTransaction
+{
+    void Execute()
+    {
+        invoke(reinterpret_cast<u8*>(this) + callableOffset);
+    }
+
+    void (*invoke)(void* callable);
+    void (*destroy)(void* callable); // nullptr for trivially destructible callables
+    TransactionAccess access;
+    u32 stage;
+    u32 callableOffset;
+};
+
+// Transactions recorded by a single thread during a frame, the callables are stored inline in blocks that are kept between frames
+// so recording a transaction doesn't allocate once the buffer has grown to the size of a frame
+class ScriptTransactionBuffer
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    ScriptTransactionBuffer() = default;
+    ScriptTransactionBuffer(const ScriptTransactionBuffer&) = delete;
+    ScriptTransactionBuffer& operator=(const ScriptTransactionBuffer&) = delete;
+    ~ScriptTransactionBuffer() { Reset(); }
+
+    template <typename Callable>
+    void Add(u32 stage, TransactionAccess access, Callable&& callable)
+    {
+        using Function = std::decay_t<Callable>;
+        static_assert(alignof(Function) <= alignof(std::max_align_t), "Transactions can't be over-aligned");
+
+        const size_t callableOffset = AlignUp(sizeof(ScriptTransaction), alignof(Function));
+        u8* memory = Allocate(AlignUp(callableOffset + sizeof(Function), alignof(std::max_align_t)));
+
+        ScriptTransaction* transaction = new (memory) ScriptTransaction();
+        transaction->invoke = [](void* function) { (*static_cast<Function*>(function))(); };
+        transaction->destroy = nullptr;
+        transaction->access = access;
+        transaction->stage = stage;
+        transaction->callableOffset = static_cast<u32>(callableOffset);
+
+        if constexpr (!std::is_trivially_destructible_v<Function>)
+        {
+            transaction->destroy = [](void* function) { static_cast<Function*>(function)->~Function(); };
+        }
+
+        new (memory + callableOffset) Function(std::forward<Callable>(callable));
+        _transactions.push_back(transaction);
+
+        // Only the owning thread writes, so a plain store is enough
+        _numTransactions.store(_transactions.size(), std::memory_order_relaxed);
+    }
+
+    // Destroys every recorded callable, executed or not, and rewinds the blocks
+    void Reset()
+    {
+        for (ScriptTransaction* transaction : _transactions)
+        {
+            if (transaction->destroy)
+            {
+                transaction->destroy(reinterpret_cast<u8*>(transaction) + transaction->callableOffset);
+            }
+        }
+
+        _transactions.clear();
+        _numTransactions.store(0, std::memory_order_relaxed);
+        _blockIndex = 0;
+        _blockOffset = 0;
+    }
+
+    // Transactions in the order they were added, stages never decrease within a frame
+    // Only read this from the owning thread or once the owning thread is done adding
+    const std::vector<ScriptTransaction*>& GetTransactions() const { return _transactions; }
+
+    // Can be read from any thread while transactions are being added
+    size_t GetNumTransactions() const { return _numTransactions.load(std::memory_order_relaxed); }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<u8[]> data;
+        size_t size;
+    };
+
+    static constexpr size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    u8* Allocate(size_t size)
+    {
+        while (_blockIndex < _blocks.size() && _blockOffset + size > _blocks[_blockIndex].size)
+        {
+            _blockIndex++;
+            _blockOffset = 0;
+        }
+
+        if (_blockIndex == _blocks.size())
+        {
+            // Callables larger than a block get a block of their own, it is reused for whatever comes next frame
+            const size_t blockSize = std::max(BLOCK_SIZE, size);
+            _blocks.push_back({ std::make_unique<u8[]>(blockSize), blockSize });
+        }
+
+        u8* memory = &_blocks[_blockIndex].data[_blockOffset];
+        _blockOffset += size;
+        return memory;
+    }
+
+private:
+    std::vector<ScriptTransaction*> _transactions;
+    std::atomic<size_t> _numTransactions = 0;
+
+    std::vector<Block> _blocks;
+    size_t _blockIndex = 0;
+    size_t _blockOffset = 0;
+};
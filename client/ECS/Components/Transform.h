@@ -105,6 +105,7 @@ struct Transform
     bool isDirty = true;
 
     vec3 GetRotation() const { return vec3(0, yaw, pitch); }
+    void SetRotation(const vec3& rotation) { yaw = rotation.y; pitch = rotation.z; }
     mat4x4 GetMatrix()
     {
         // When we pass 1 into the constructor, it will construct an identity matrix
@@ -17,11 +17,21 @@
 #include <glm/gtx/norm.hpp>
 #include <GLFW/glfw3.h>
 
+KeybindHandle MovementSystem::_moveForwardKeybind = KeybindHandle::Invalid;
+KeybindHandle MovementSystem::_moveBackwardKeybind = KeybindHandle::Invalid;
+KeybindHandle MovementSystem::_moveLeftKeybind = KeybindHandle::Invalid;
+KeybindHandle MovementSystem::_moveRightKeybind = KeybindHandle::Invalid;
+
 void MovementSystem::Init(entt::registry& registry)
 {
     InputManager* inputManager = ServiceLocator::GetInputManager();
 
-    inputManager->RegisterKeybind("MovementSystem Increase Speed", GLFW_KEY_PAGE_UP, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [](Window* window, std::shared_ptr<Keybind> keybind)
+    _moveForwardKeybind = inputManager->GetKeybindHandle("Move Forward"_h);
+    _moveBackwardKeybind = inputManager->GetKeybindHandle("Move Backward"_h);
+    _moveLeftKeybind = inputManager->GetKeybindHandle("Move Left"_h);
+    _moveRightKeybind = inputManager->GetKeybindHandle("Move Right"_h);
+
+    inputManager->RegisterKeybind("MovementSystem Increase Speed", GLFW_KEY_PAGE_UP, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [](Window* window, Keybind* keybind)
     {
         CameraOrbital* camera = ServiceLocator::GetCameraOrbital();
         if (!camera->IsActive())
@@ -38,7 +48,7 @@ void MovementSystem::Init(entt::registry& registry)
 
         return true;
     });
-    inputManager->RegisterKeybind("MovementSystem Decrease Speed", GLFW_KEY_PAGE_DOWN, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("MovementSystem Decrease Speed", GLFW_KEY_PAGE_DOWN, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [](Window* window, Keybind* keybind)
     {
         CameraOrbital* camera = ServiceLocator::GetCameraOrbital();
         if (!camera->IsActive())
@@ -79,7 +89,7 @@ void MovementSystem::Update(entt::registry& registry)
 
     f32 terrainHeight = Terrain::MapUtils::GetHeightFromWorldPosition(transform.position);
     bool isGrounded = transform.position.y <= terrainHeight;
-    bool isRightClickDown = inputManager->IsKeyPressed("CameraOrbital Right Mouseclick"_h);
+    bool isRightClickDown = inputManager->IsKeyPressed(camera->GetRightMouseKeybind());
     if (isRightClickDown)
     {
         transform.yaw = camera->GetYaw();
@@ -101,23 +111,23 @@ void MovementSystem::Update(entt::registry& registry)
 
         movementData.AddMoveFlag(MovementFlags::GROUNDED);
 
-        if (inputManager->IsKeyPressed("Move Forward"_h) || (inputManager->IsKeyPressed("CameraOrbital Left Mouseclick"_h) && isRightClickDown))
+        if (inputManager->IsKeyPressed(_moveForwardKeybind) || (inputManager->IsKeyPressed(camera->GetLeftMouseKeybind()) && isRightClickDown))
         {
             movementData.AddMoveFlag(MovementFlags::FORWARD);
             transform.velocityDirection += transform.front;
         }
-        if (inputManager->IsKeyPressed("Move Backward"_h))
+        if (inputManager->IsKeyPressed(_moveBackwardKeybind))
         {
             movementData.AddMoveFlag(MovementFlags::BACKWARD);
             transform.velocityDirection -= transform.front;
         }
 
-        if (inputManager->IsKeyPressed("Move Left"_h))
+        if (inputManager->IsKeyPressed(_moveLeftKeybind))
         {
             movementData.AddMoveFlag(MovementFlags::LEFT);
             transform.velocityDirection += transform.left;
         }
-        if (inputManager->IsKeyPressed("Move Right"_h))
+        if (inputManager->IsKeyPressed(_moveRightKeybind))
         {
             movementData.AddMoveFlag(MovementFlags::RIGHT);
             transform.velocityDirection -= transform.left;
@@ -149,15 +159,12 @@ void MovementSystem::Update(entt::registry& registry)
             {
                 ConnectionSingleton& connectionSingleton = registry.ctx<ConnectionSingleton>();
 
-                std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<128>();
-                buffer->Put(Opcode::MSG_MOVE_STOP_ENTITY);
-                buffer->PutU16(32);
-
+                std::shared_ptr<Bytebuffer>& buffer = connectionSingleton.gamePacketWriter.BeginPacket(Opcode::MSG_MOVE_STOP_ENTITY, 32);
                 buffer->Put(localplayerSingleton.entity);
                 buffer->Put(movementData.flags);
                 buffer->Put(transform.position);
                 buffer->Put(transform.GetRotation());
-                connectionSingleton.gameConnection->Send(buffer);
+                connectionSingleton.gamePacketWriter.EndPacket();
             }
         }
         else
@@ -167,24 +174,14 @@ void MovementSystem::Update(entt::registry& registry)
             // Send Packet
             ConnectionSingleton& connectionSingleton = registry.ctx<ConnectionSingleton>();
 
-            std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<128>();
-            if (movementData.flags != originalFlags)
-            {
-                buffer->Put(Opcode::MSG_MOVE_ENTITY);
-            }
-            else
-            {
-                buffer->Put(Opcode::MSG_MOVE_HEARTBEAT_ENTITY);
-            }
-
-            buffer->PutU16(32);
+            Opcode opcode = movementData.flags != originalFlags ? Opcode::MSG_MOVE_ENTITY : Opcode::MSG_MOVE_HEARTBEAT_ENTITY;
 
+            std::shared_ptr<Bytebuffer>& buffer = connectionSingleton.gamePacketWriter.BeginPacket(opcode, 32);
             buffer->Put(localplayerSingleton.entity);
             buffer->Put(movementData.flags);
             buffer->Put(transform.position);
             buffer->Put(transform.GetRotation());
-
-            connectionSingleton.gameConnection->Send(buffer);
+            connectionSingleton.gamePacketWriter.EndPacket();
         }
     }
     else
@@ -1,9 +1,17 @@
 #pragma once
 #include <entity/fwd.hpp>
+#include <Keybind.h>
 
 class MovementSystem
 {
 public:
     static void Init(entt::registry& registry);
     static void Update(entt::registry& registry);
+
+private:
+    // Resolved once in Init, the keybinds are registered by EngineLoop before it
+    static KeybindHandle _moveForwardKeybind;
+    static KeybindHandle _moveBackwardKeybind;
+    static KeybindHandle _moveLeftKeybind;
+    static KeybindHandle _moveRightKeybind;
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "ConnectionSystems.h"
 #include <entt.hpp>
 #include <tracy/Tracy.hpp>
+#include <Utils/Timer.h>
 #include <Networking/MessageHandler.h>
 #include <Networking/NetworkClient.h>
 #include "../../Components/Network/ConnectionSingleton.h"
@@ -12,6 +13,16 @@ void ConnectionUpdateSystem::Update(entt::registry& registry)
     ZoneScopedNC("ConnectionUpdateSystem::Update", tracy::Color::Blue)
     ConnectionSingleton& connectionSingleton = registry.ctx<ConnectionSingleton>();
 
+    Timer updateTimer;
+    u32 packetCount = 0;
+
+    std::shared_ptr<PacketReplay> packetReplay = std::atomic_load(&connectionSingleton.packetReplay);
+    if (packetReplay && !packetReplay->Update(connectionSingleton))
+    {
+        std::atomic_store(&connectionSingleton.packetReplay, std::shared_ptr<PacketReplay>());
+        NC_LOG_MESSAGE("[Network/Replay]: Finished replaying %u packets", static_cast<u32>(packetReplay->GetPacketCount()));
+    }
+
     if (connectionSingleton.authConnection)
     {
         std::shared_ptr<NetworkPacket> packet = nullptr;
@@ -19,6 +30,8 @@ void ConnectionUpdateSystem::Update(entt::registry& registry)
         MessageHandler* authSocketMessageHandler = ServiceLocator::GetAuthSocketMessageHandler();
         while (connectionSingleton.authPacketQueue.try_dequeue(packet))
         {
+            packetCount++;
+
 #ifdef NC_Debug
             NC_LOG_SUCCESS("[Network/Socket]: CMD: %u, Size: %u", packet->header.opcode, packet->header.size);
 #endif // NC_Debug
@@ -39,6 +52,8 @@ void ConnectionUpdateSystem::Update(entt::registry& registry)
         MessageHandler* gameSocketMessageHandler = ServiceLocator::GetGameSocketMessageHandler();
         while (connectionSingleton.gamePacketQueue.try_dequeue(packet))
         {
+            packetCount++;
+
 #ifdef NC_Debug
             NC_LOG_SUCCESS("[Network/Socket]: CMD: %u, Size: %u", packet->header.opcode, packet->header.size);
 #endif // NC_Debug
@@ -51,6 +66,32 @@ void ConnectionUpdateSystem::Update(entt::registry& registry)
             }
         }
     }
+
+    connectionSingleton.lastUpdatePacketCount = packetCount;
+    connectionSingleton.lastUpdateTimeMS = updateTimer.GetLifeTime() * 1000.0f;
+    TracyPlot("Network Packets Handled", static_cast<i64>(packetCount));
+}
+
+void ConnectionUpdateSystem::Flush(entt::registry& registry)
+{
+    ZoneScopedNC("ConnectionUpdateSystem::Flush", tracy::Color::Blue)
+    ConnectionSingleton& connectionSingleton = registry.ctx<ConnectionSingleton>();
+
+    if (connectionSingleton.authConnection)
+    {
+        connectionSingleton.authPacketWriter.Flush([&connectionSingleton](std::shared_ptr<Bytebuffer>& buffer)
+        {
+            connectionSingleton.authConnection->Send(buffer);
+        });
+    }
+
+    if (connectionSingleton.gameConnection)
+    {
+        connectionSingleton.gamePacketWriter.Flush([&connectionSingleton](std::shared_ptr<Bytebuffer>& buffer)
+        {
+            connectionSingleton.gameConnection->Send(buffer);
+        });
+    }
 }
 
 void ConnectionUpdateSystem::AuthSocket_HandleConnect(BaseSocket* socket, bool connected)
@@ -60,6 +101,9 @@ void ConnectionUpdateSystem::AuthSocket_HandleConnect(BaseSocket* socket, bool c
 
     if (connected)
     {
+        entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
+        gameRegistry->ctx<ConnectionSingleton>().authPacketFramer.Reset();
+
         /* Send Initial Packet */
         std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<512>();
         buffer->Put(Opcode::MSG_REQUEST_ADDRESS);
@@ -76,43 +120,19 @@ void ConnectionUpdateSystem::AuthSocket_HandleRead(BaseSocket* socket)
 
     ConnectionSingleton* connectionSingleton = &gameRegistry->ctx<ConnectionSingleton>();
 
-    while (buffer->GetActiveSize())
+    // Packets may be split across reads, the framer holds on to partial ones until the rest arrives
+    const size_t size = buffer->GetActiveSize();
+    bool result = connectionSingleton->authPacketFramer.Receive(buffer->GetReadPointer(), size, [connectionSingleton](std::shared_ptr<NetworkPacket>& packet)
     {
-        Opcode opcode = Opcode::INVALID;
-        u16 size = 0;
-
-        buffer->Get(opcode);
-        buffer->GetU16(size);
-
-        if (size > NETWORK_BUFFER_SIZE)
-        {
-            socket->Close(asio::error::shut_down);
-            return;
-        }
+        connectionSingleton->packetCapture.Write(PacketCaptureConnection::Auth, *packet);
+        connectionSingleton->authPacketQueue.enqueue(packet);
+    });
+    buffer->readData += size;
 
-        std::shared_ptr<NetworkPacket> packet = NetworkPacket::Borrow();
-        {
-            // Header
-            {
-                packet->header.opcode = opcode;
-                packet->header.size = size;
-            }
-
-            // Payload
-            {
-                if (size)
-                {
-                    packet->payload = Bytebuffer::Borrow<NETWORK_BUFFER_SIZE>();
-                    packet->payload->size = size;
-                    packet->payload->writtenData = size;
-                    std::memcpy(packet->payload->GetDataPointer(), buffer->GetReadPointer(), size);
-                }
-            }
-
-            connectionSingleton->authPacketQueue.enqueue(packet);
-        }
-
-        buffer->readData += size;
+    if (!result)
+    {
+        socket->Close(asio::error::shut_down);
+        return;
     }
 
     socket->AsyncRead();
@@ -125,6 +145,7 @@ void ConnectionUpdateSystem::GameSocket_HandleConnect(BaseSocket* socket, bool c
 {
     entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
     AuthenticationSingleton& authentication = gameRegistry->ctx<AuthenticationSingleton>();
+    gameRegistry->ctx<ConnectionSingleton>().gamePacketFramer.Reset();
     
     /* Send Initial Packet */
     std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<512>();
@@ -161,43 +182,19 @@ void ConnectionUpdateSystem::GameSocket_HandleRead(BaseSocket* socket)
 
     ConnectionSingleton* connectionSingleton = &gameRegistry->ctx<ConnectionSingleton>();
 
-    while (buffer->GetActiveSize())
+    // Packets may be split across reads, the framer holds on to partial ones until the rest arrives
+    const size_t size = buffer->GetActiveSize();
+    bool result = connectionSingleton->gamePacketFramer.Receive(buffer->GetReadPointer(), size, [connectionSingleton](std::shared_ptr<NetworkPacket>& packet)
     {
-        Opcode opcode = Opcode::INVALID;
-        u16 size = 0;
-
-        buffer->Get(opcode);
-        buffer->GetU16(size);
-
-        if (size > NETWORK_BUFFER_SIZE)
-        {
-            socket->Close(asio::error::shut_down);
-            return;
-        }
+        connectionSingleton->packetCapture.Write(PacketCaptureConnection::Game, *packet);
+        connectionSingleton->gamePacketQueue.enqueue(packet);
+    });
+    buffer->readData += size;
 
-        std::shared_ptr<NetworkPacket> packet = NetworkPacket::Borrow();
-        {
-            // Header
-            {
-                packet->header.opcode = opcode;
-                packet->header.size = size;
-            }
-
-            // Payload
-            {
-                if (size)
-                {
-                    packet->payload = Bytebuffer::Borrow<NETWORK_BUFFER_SIZE>();
-                    packet->payload->size = size;
-                    packet->payload->writtenData = size;
-                    std::memcpy(packet->payload->GetDataPointer(), buffer->GetReadPointer(), size);
-                }
-            }
-
-            connectionSingleton->gamePacketQueue.enqueue(packet);
-        }
-
-        buffer->readData += size;
+    if (!result)
+    {
+        socket->Close(asio::error::shut_down);
+        return;
     }
 
     socket->AsyncRead();
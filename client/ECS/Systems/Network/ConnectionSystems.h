@@ -7,6 +7,9 @@ class ConnectionUpdateSystem
 public:
     static void Update(entt::registry& registry);
 
+    // Sends everything the packet writers coalesced during the frame, runs once per tick after the systems that send packets
+    static void Flush(entt::registry& registry);
+
     // Handlers for Network Client
     static void AuthSocket_HandleConnect(BaseSocket* socket, bool connected);
     static void AuthSocket_HandleRead(BaseSocket* socket);
@@ -0,0 +1,80 @@
+#include "EntityUpdateSystem.h"
+#include <entt.hpp>
+#include <algorithm>
+#include <tracy/Tracy.hpp>
+#include "../../Components/Transform.h"
+#include "../../Components/Singletons/TimeSingleton.h"
+#include "../../Components/Network/EntityUpdateSingleton.h"
+#include "../../Components/Network/TransformSnapshots.h"
+
+void EntityUpdateSystem::Update(entt::registry& registry)
+{
+    Apply(registry);
+    Interpolate(registry);
+}
+
+void EntityUpdateSystem::Apply(entt::registry& registry)
+{
+    EntityUpdateSingleton& entityUpdateSingleton = registry.ctx<EntityUpdateSingleton>();
+    if (entityUpdateSingleton.Size() == 0)
+        return;
+
+    ZoneScopedNC("EntityUpdateSystem::Apply", tracy::Color::Blue2);
+
+    TimeSingleton& timeSingleton = registry.ctx<TimeSingleton>();
+    const u32 numUpdates = static_cast<u32>(entityUpdateSingleton.Size());
+
+    // Stable so several updates for the same entity in one frame are pushed in the order they arrived
+    std::vector<u32>& order = entityUpdateSingleton.order;
+    order.resize(numUpdates);
+    for (u32 i = 0; i < numUpdates; i++)
+    {
+        order[i] = i;
+    }
+
+    const std::vector<entt::entity>& entities = entityUpdateSingleton.entities;
+    std::stable_sort(order.begin(), order.end(), [&entities](u32 a, u32 b)
+    {
+        return entities[a] < entities[b];
+    });
+
+    for (u32 index : order)
+    {
+        entt::entity entity = entities[index];
+
+        // The entity can have been deleted by a later packet in the same frame
+        if (!registry.valid(entity) || !registry.has<Transform>(entity))
+            continue;
+
+        TransformSnapshots& snapshots = registry.get_or_emplace<TransformSnapshots>(entity);
+        snapshots.Push(timeSingleton.lifeTimeInS, entityUpdateSingleton.positions[index], entityUpdateSingleton.rotations[index], entityUpdateSingleton.scales[index]);
+    }
+
+    entityUpdateSingleton.Clear();
+}
+
+void EntityUpdateSystem::Interpolate(entt::registry& registry)
+{
+    ZoneScopedNC("EntityUpdateSystem::Interpolate", tracy::Color::Blue2);
+
+    TimeSingleton& timeSingleton = registry.ctx<TimeSingleton>();
+    const f32 renderTime = timeSingleton.lifeTimeInS - INTERPOLATION_DELAY;
+
+    auto view = registry.view<Transform, TransformSnapshots>();
+    view.each([renderTime](Transform& transform, TransformSnapshots& snapshots)
+    {
+        vec3 position;
+        vec3 rotation;
+        vec3 scale;
+        if (!snapshots.Sample(renderTime, position, rotation, scale))
+            return;
+
+        if (position == transform.position && rotation == transform.GetRotation() && scale == transform.scale)
+            return;
+
+        transform.position = position;
+        transform.SetRotation(rotation);
+        transform.scale = scale;
+        transform.isDirty = true;
+    });
+}
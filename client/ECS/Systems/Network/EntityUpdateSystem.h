@@ -0,0 +1,18 @@
+#pragma once
+#include <NovusTypes.h>
+#include <entity/fwd.hpp>
+
+class EntityUpdateSystem
+{
+public:
+    // Transforms are rendered this far behind the newest snapshot so there is normally a later snapshot to interpolate towards
+    static constexpr f32 INTERPOLATION_DELAY = 0.1f;
+
+    static void Update(entt::registry& registry);
+
+    // Moves this frame's EntityUpdateSingleton batch into the TransformSnapshots of every entity, sorted so the registry is walked in order
+    static void Apply(entt::registry& registry);
+
+    // Samples TransformSnapshots into Transform for every entity that has them
+    static void Interpolate(entt::registry& registry);
+};
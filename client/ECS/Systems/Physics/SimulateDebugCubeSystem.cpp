@@ -20,7 +20,7 @@ void SimulateDebugCubeSystem::Init(entt::registry& registry)
 {
     InputManager* inputManager = ServiceLocator::GetInputManager();
 
-    inputManager->RegisterKeybind("SpawnDebugBox", GLFW_KEY_B, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [&registry](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("SpawnDebugBox", GLFW_KEY_B, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [&registry](Window* window, Keybind* keybind)
     {
         Camera* camera = ServiceLocator::GetCamera();
 
@@ -1,14 +1,17 @@
 #include "EngineLoop.h"
 #include <Utils/Timer.h>
+#include <Utils/DebugHandler.h>
 #include "Utils/ServiceLocator.h"
 #include "Utils/EntityUtils.h"
 #include "Utils/MapUtils.h"
+#include "Utils/StartupGraph.h"
 #include <SceneManager.h>
 #include <Networking/InputQueue.h>
 #include <Networking/MessageHandler.h>
 #include <Renderer/Renderer.h>
 #include "Rendering/ClientRenderer.h"
 #include "Rendering/TerrainRenderer.h"
+#include "Rendering/MapObjectRenderer.h"
 #include "Rendering/CameraFreelook.h"
 #include "Rendering/CameraOrbital.h"
 #include "Gameplay/Map/MapLoader.h"
@@ -20,8 +23,11 @@
 #include "ECS/Components/Singletons/ScriptSingleton.h"
 #include "ECS/Components/Singletons/DataStorageSingleton.h"
 #include "ECS/Components/Singletons/SceneManagerSingleton.h"
+#include "ECS/Components/Singletons/DBCSingleton.h"
+#include "ECS/Components/Singletons/MapSingleton.h"
 #include "ECS/Components/Network/ConnectionSingleton.h"
 #include "ECS/Components/Network/AuthenticationSingleton.h"
+#include "ECS/Components/Network/EntityUpdateSingleton.h"
 #include "ECS/Components/LocalplayerSingleton.h"
 
 #include "UI/ECS/Components/Singletons/UIDataSingleton.h"
@@ -33,6 +39,7 @@
 
 // Systems
 #include "ECS/Systems/Network/ConnectionSystems.h"
+#include "ECS/Systems/Network/EntityUpdateSystem.h"
 #include "UI/ECS/Systems/UpdateElementSystem.h"
 #include "ECS/Systems/Rendering/RenderModelSystem.h"
 #include "ECS/Systems/Physics/SimulateDebugCubeSystem.h"
@@ -42,6 +49,7 @@
 #include "Network/Handlers/AuthSocket/AuthHandlers.h"
 #include "Network/Handlers/GameSocket/GameHandlers.h"
 #include "Scripting/ScriptHandler.h"
+#include "Scripting/ScriptEngine.h"
 
 #include <InputManager.h>
 #include <GLFW/glfw3.h>
@@ -105,8 +113,7 @@ void EngineLoop::Run()
     _updateFramework.uiRegistry.create();
     SetupUpdateFramework();
 
-    DBCLoader::Load(&_updateFramework.gameRegistry);
-    MapLoader::Init(&_updateFramework.gameRegistry);
+    Timer startupTimer;
 
     TimeSingleton& timeSingleton = _updateFramework.gameRegistry.set<TimeSingleton>();
     ScriptSingleton& scriptSingleton = _updateFramework.gameRegistry.set<ScriptSingleton>();
@@ -114,9 +121,14 @@ void EngineLoop::Run()
     SceneManagerSingleton& sceneManagerSingleton = _updateFramework.gameRegistry.set<SceneManagerSingleton>();
     ConnectionSingleton& connectionSingleton = _updateFramework.gameRegistry.set<ConnectionSingleton>();
     AuthenticationSingleton& authenticationSingleton = _updateFramework.gameRegistry.set<AuthenticationSingleton>();
+    EntityUpdateSingleton& entityUpdateSingleton = _updateFramework.gameRegistry.set<EntityUpdateSingleton>();
     LocalplayerSingleton& localplayerSingleton = _updateFramework.gameRegistry.set<LocalplayerSingleton>();
     EngineStatsSingleton& statsSingleton = _updateFramework.gameRegistry.set<EngineStatsSingleton>();
 
+    // These are filled by worker phases, so they are set up front and the workers never touch the registry itself
+    DBCSingleton& dbcSingleton = _updateFramework.gameRegistry.set<DBCSingleton>();
+    MapSingleton& mapSingleton = _updateFramework.gameRegistry.set<MapSingleton>();
+
     connectionSingleton.authConnection = _network.authSocket;
     connectionSingleton.gameConnection = _network.gameSocket;
 
@@ -125,64 +137,139 @@ void EngineLoop::Run()
     sceneManager->SetAvailableScenes({ "LoginScreen"_h, "CharacterSelection"_h, "CharacterCreation"_h });
     ServiceLocator::SetSceneManager(sceneManager);
 
-    _clientRenderer = new ClientRenderer();
+    std::string scriptPath = "./Data/scripts";
 
-    CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(-8000.0f, 100.0f, 1600.0f)); // Stormwind Harbor
-    //CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(300.0f, 0.0f, -4700.0f)); // Razor Hill
-    //CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(3308.0f, 0.0f, 5316.0f)); // Borean Tundra
-    //CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(0.0f, 0.0f, 0.0f)); // Center of Map (0, 0)
-    cameraFreeLook->Init();
-    ServiceLocator::SetCameraFreeLook(cameraFreeLook);
+    StartupGraph startupGraph;
 
-    CameraOrbital* cameraOrbital = new CameraOrbital();
-    cameraOrbital->Init();
-    ServiceLocator::SetCameraOrbital(cameraOrbital);
+    StartupGraph::PhaseID dbcPhase = startupGraph.AddPhase("DBC", StartupGraph::Thread::Worker, [&dbcSingleton]()
+    {
+        return DBCLoader::Load(dbcSingleton);
+    });
+    StartupGraph::PhaseID mapPhase = startupGraph.AddPhase("Map", StartupGraph::Thread::Worker, [&mapSingleton, &dbcSingleton]()
+    {
+        return MapLoader::Init(mapSingleton, dbcSingleton);
+    });
+    startupGraph.AddDependency(mapPhase, dbcPhase);
 
-    // Bind Movement Keys
-    InputManager* inputManager = ServiceLocator::GetInputManager();
-    inputManager->RegisterKeybind("Switch Camera Mode", GLFW_KEY_C, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    // Compiles on the worker's own script engine into the bytecode cache, the main thread then only has to load bytecode
+    StartupGraph::PhaseID scriptPrecompilePhase = startupGraph.AddPhase("ScriptPrecompile", StartupGraph::Thread::Worker, [&scriptPath]()
     {
-        Camera* freeLook = ServiceLocator::GetCameraFreeLook();
-        Camera* orbital = ServiceLocator::GetCameraOrbital();
+        ScriptHandler::PrecompileScriptDirectory(scriptPath);
+
+        // The worker stays around for the rest of the session, nothing else runs scripts on it
+        ScriptEngine::Shutdown();
+        return true;
+    });
 
-        bool freeLookActive = freeLook->IsActive();
+    StartupGraph::PhaseID clientRendererPhase = startupGraph.AddPhase("ClientRenderer", StartupGraph::Thread::Main, [this]()
+    {
+        _clientRenderer = new ClientRenderer();
+        return true;
+    });
 
-        freeLook->SetActive(!freeLookActive);
-        orbital->SetActive(freeLookActive);
+    StartupGraph::PhaseID camerasPhase = startupGraph.AddPhase("Cameras", StartupGraph::Thread::Main, []()
+    {
+        CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(-8000.0f, 100.0f, 1600.0f)); // Stormwind Harbor
+        //CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(300.0f, 0.0f, -4700.0f)); // Razor Hill
+        //CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(3308.0f, 0.0f, 5316.0f)); // Borean Tundra
+        //CameraFreeLook* cameraFreeLook = new CameraFreeLook(vec3(0.0f, 0.0f, 0.0f)); // Center of Map (0, 0)
+        cameraFreeLook->Init();
+        ServiceLocator::SetCameraFreeLook(cameraFreeLook);
+
+        CameraOrbital* cameraOrbital = new CameraOrbital();
+        cameraOrbital->Init();
+        ServiceLocator::SetCameraOrbital(cameraOrbital);
+        return true;
+    });
+    startupGraph.AddDependency(camerasPhase, clientRendererPhase);
 
-        if (freeLookActive)
-        {
-            freeLook->Disabled();
-            orbital->Enabled();
-        }
-        else
+    StartupGraph::PhaseID keybindsPhase = startupGraph.AddPhase("Keybinds", StartupGraph::Thread::Main, []()
+    {
+        // Bind Movement Keys
+        InputManager* inputManager = ServiceLocator::GetInputManager();
+        inputManager->RegisterKeybind("Switch Camera Mode", GLFW_KEY_C, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE, [](Window* window, Keybind* keybind)
         {
-            orbital->Disabled();
-            freeLook->Enabled();
-        }
+            Camera* freeLook = ServiceLocator::GetCameraFreeLook();
+            Camera* orbital = ServiceLocator::GetCameraOrbital();
+
+            bool freeLookActive = freeLook->IsActive();
+
+            freeLook->SetActive(!freeLookActive);
+            orbital->SetActive(freeLookActive);
 
+            if (freeLookActive)
+            {
+                freeLook->Disabled();
+                orbital->Enabled();
+            }
+            else
+            {
+                orbital->Disabled();
+                freeLook->Enabled();
+            }
+
+            return true;
+        });
+        inputManager->RegisterKeybind("Move Forward", GLFW_KEY_W, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
+        inputManager->RegisterKeybind("Move Backward", GLFW_KEY_S, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
+        inputManager->RegisterKeybind("Move Left", GLFW_KEY_A, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
+        inputManager->RegisterKeybind("Move Right", GLFW_KEY_D, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
         return true;
     });
-    inputManager->RegisterKeybind("Move Forward", GLFW_KEY_W, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
-    inputManager->RegisterKeybind("Move Backward", GLFW_KEY_S, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
-    inputManager->RegisterKeybind("Move Left", GLFW_KEY_A, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
-    inputManager->RegisterKeybind("Move Right", GLFW_KEY_D, KEYBIND_ACTION_PRESS, KEYBIND_MOD_NONE);
+    startupGraph.AddDependency(keybindsPhase, clientRendererPhase);
 
-    // Initialize Localplayer
-    localplayerSingleton.entity = _updateFramework.gameRegistry.create();
-    Transform& transform = _updateFramework.gameRegistry.emplace<Transform>(localplayerSingleton.entity);
+    StartupGraph::PhaseID localplayerPhase = startupGraph.AddPhase("Localplayer", StartupGraph::Thread::Main, [this, &localplayerSingleton]()
+    {
+        entt::registry& gameRegistry = _updateFramework.gameRegistry;
 
-    transform.position = vec3(-9321.f, 108.11f, 50.f);
-    transform.scale = vec3(0.5f, 2.f, 0.5f); // "Ish" scale for humans
+        localplayerSingleton.entity = gameRegistry.create();
+        Transform& transform = gameRegistry.emplace<Transform>(localplayerSingleton.entity);
 
-    _updateFramework.gameRegistry.emplace<DebugBox>(localplayerSingleton.entity);
-    Model& model = EntityUtils::CreateModelComponent(_updateFramework.gameRegistry, localplayerSingleton.entity, "Data/models/Cube.novusmodel");
+        transform.position = vec3(-9321.f, 108.11f, 50.f);
+        transform.scale = vec3(0.5f, 2.f, 0.5f); // "Ish" scale for humans
 
-    // Load Scripts
-    std::string scriptPath = "./Data/scripts";
-    ScriptHandler::LoadScriptDirectory(scriptPath);
+        gameRegistry.emplace<DebugBox>(localplayerSingleton.entity);
+        EntityUtils::CreateModelComponent(gameRegistry, localplayerSingleton.entity, "Data/models/Cube.novusmodel");
+        return true;
+    });
+    startupGraph.AddDependency(localplayerPhase, clientRendererPhase);
 
-    sceneManager->LoadScene("LoginScreen"_h);
+    StartupGraph::PhaseID scriptLoadPhase = startupGraph.AddPhase("ScriptLoad", StartupGraph::Thread::Main, [&scriptPath]()
+    {
+        ScriptHandler::LoadScriptDirectory(scriptPath);
+        ScriptHandler::StartWatching();
+        return true;
+    });
+    startupGraph.AddDependency(scriptLoadPhase, clientRendererPhase);
+    startupGraph.AddDependency(scriptLoadPhase, scriptPrecompilePhase);
+
+    StartupGraph::PhaseID loadScenePhase = startupGraph.AddPhase("LoadScene", StartupGraph::Thread::Main, [sceneManager]()
+    {
+        sceneManager->LoadScene("LoginScreen"_h);
+        return true;
+    });
+    startupGraph.AddDependency(loadScenePhase, scriptLoadPhase);
+
+    // Added last so the main thread only waits on the map loaders once everything else is done
+    StartupGraph::PhaseID terrainMapPhase = startupGraph.AddPhase("TerrainMap", StartupGraph::Thread::Main, [this]()
+    {
+        return _clientRenderer->GetTerrainRenderer()->LoadMap("Azeroth"_h);
+    });
+    startupGraph.AddDependency(terrainMapPhase, clientRendererPhase);
+    startupGraph.AddDependency(terrainMapPhase, mapPhase);
+
+    if (!startupGraph.Run(_updateFramework.taskflow))
+    {
+        startupGraph.GetReport().Log();
+        NC_LOG_ERROR("[Startup]: Failed, shutting down");
+
+        ScriptHandler::StopWatching();
+
+        Message exitMessage;
+        exitMessage.code = MSG_OUT_EXIT_CONFIRM;
+        _outputQueue.enqueue(exitMessage);
+        return;
+    }
 
     _network.authSocket->SetReadHandler(std::bind(&ConnectionUpdateSystem::AuthSocket_HandleRead, std::placeholders::_1));
     _network.authSocket->SetConnectHandler(std::bind(&ConnectionUpdateSystem::AuthSocket_HandleConnect, std::placeholders::_1, std::placeholders::_2));
@@ -201,6 +288,8 @@ void EngineLoop::Run()
     Timer updateTimer;
     Timer renderTimer;
 
+    bool isFirstFrame = true;
+
     EngineStatsSingleton::Frame timings;
     while (true)
     {
@@ -228,6 +317,15 @@ void EngineLoop::Run()
         Render();
         
         timings.renderFrameTime = renderTimer.GetLifeTime();
+
+        if (isFirstFrame)
+        {
+            StartupReport& startupReport = startupGraph.GetReport();
+            startupReport.msTimeToFirstFrame = startupTimer.GetLifeTime() * 1000;
+            startupReport.Log();
+
+            isFirstFrame = false;
+        }
         
         statsSingleton.AddTimings(timings.deltaTime, timings.simulationFrameTime, timings.renderFrameTime);
 
@@ -248,6 +346,7 @@ void EngineLoop::Run()
     }
 
     // Clean up stuff here
+    ScriptHandler::StopWatching();
 
     Message exitMessage;
     exitMessage.code = MSG_OUT_EXIT_CONFIRM;
@@ -261,6 +360,9 @@ void EngineLoop::RunIoService()
 
 bool EngineLoop::Update(f32 deltaTime)
 {
+    // Replayed input is dispatched before the window is polled, the same point in the frame it was recorded at
+    ServiceLocator::GetInputManager()->BeginFrame(ServiceLocator::GetWindow());
+
     bool shouldExit = _clientRenderer->UpdateWindow(deltaTime) == false;
     if (shouldExit)
         return false;
@@ -306,6 +408,15 @@ bool EngineLoop::Update(f32 deltaTime)
         }
     }
 
+    // Scripts rebuilt in the background are swapped in here, between frames, main() of every module runs again like on a full reload
+    if (ScriptHandler::UpdateReloads())
+    {
+        entt::registry* uiRegistry = ServiceLocator::GetUIRegistry();
+        uiRegistry->ctx<UISingleton::UIDataSingleton>().ClearWidgets();
+
+        ScriptHandler::ExecuteModules();
+    }
+
     UpdateSystems();
     _clientRenderer->Update(deltaTime);
 
@@ -349,6 +460,15 @@ void EngineLoop::SetupUpdateFramework()
         gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
     });
 
+    // EntityUpdateSystem
+    tf::Task entityUpdateSystemTask = framework.emplace([&gameRegistry]()
+    {
+        ZoneScopedNC("EntityUpdateSystem::Update", tracy::Color::Blue2)
+            EntityUpdateSystem::Update(gameRegistry);
+        gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
+    });
+    entityUpdateSystemTask.gather(connectionUpdateSystemTask);
+
     // MovementSystem
     tf::Task movementSystemTask = framework.emplace([&gameRegistry]()
     {
@@ -356,7 +476,7 @@ void EngineLoop::SetupUpdateFramework()
             MovementSystem::Update(gameRegistry);
         gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
     });
-    movementSystemTask.gather(connectionUpdateSystemTask);
+    movementSystemTask.gather(entityUpdateSystemTask);
 
     // SimulateDebugCubeSystem
     tf::Task simulateDebugCubeSystemTask = framework.emplace([this, &gameRegistry]()
@@ -367,6 +487,15 @@ void EngineLoop::SetupUpdateFramework()
     });
     simulateDebugCubeSystemTask.gather(movementSystemTask);
 
+    // ConnectionFlushSystem
+    tf::Task connectionFlushSystemTask = framework.emplace([&gameRegistry]()
+    {
+        ZoneScopedNC("ConnectionUpdateSystem::Flush", tracy::Color::Blue2)
+            ConnectionUpdateSystem::Flush(gameRegistry);
+        gameRegistry.ctx<ScriptSingleton>().CompleteSystem();
+    });
+    connectionFlushSystemTask.gather(movementSystemTask);
+
     // RenderModelSystem
     tf::Task renderModelSystemTask = framework.emplace([this, &gameRegistry]()
     {
@@ -377,14 +506,15 @@ void EngineLoop::SetupUpdateFramework()
     renderModelSystemTask.gather(simulateDebugCubeSystemTask);
 
     // ScriptSingletonTask
-    tf::Task scriptSingletonTask = framework.emplace([&uiRegistry, &gameRegistry]()
+    tf::Task scriptSingletonTask = framework.emplace([&uiRegistry, &gameRegistry](tf::SubflowBuilder& subflow)
     {
         ZoneScopedNC("ScriptSingletonTask::Update", tracy::Color::Blue2)
-        gameRegistry.ctx<ScriptSingleton>().ExecuteTransactions();
+        gameRegistry.ctx<ScriptSingleton>().ExecuteTransactions(subflow);
         gameRegistry.ctx<ScriptSingleton>().ResetCompletedSystems();
     });
     scriptSingletonTask.gather(updateElementSystemTask);
     scriptSingletonTask.gather(renderModelSystemTask);
+    scriptSingletonTask.gather(connectionFlushSystemTask);
 }
 void EngineLoop::SetMessageHandler()
 {
@@ -455,6 +585,9 @@ void EngineLoop::DrawEngineStats(EngineStatsSingleton* stats)
         ImGui::Text("update time : %f ms", average.simulationFrameTime * 1000);
         ImGui::Text("render time (CPU): %f ms", average.renderFrameTime * 1000);
 
+        ConnectionSingleton& connectionSingleton = _updateFramework.gameRegistry.ctx<ConnectionSingleton>();
+        ImGui::Text("network ingest : %u packets, %f ms", connectionSingleton.lastUpdatePacketCount, connectionSingleton.lastUpdateTimeMS);
+
         //read the frame buffer to gather timings for the histograms
         std::vector<float> updateTimes;
         updateTimes.reserve(stats->frameStats.size());
@@ -488,6 +621,20 @@ void EngineLoop::DrawImguiMenuBar()
 
                 ImGui::InputText("Map to load", &mapload);
 
+                TerrainRenderer* terrainRenderer = ServiceLocator::GetClientRenderer()->GetTerrainRenderer();
+                bool compressHeights = terrainRenderer->GetCompressHeights();
+                if (ImGui::Checkbox("Compress terrain heights", &compressHeights))
+                {
+                    terrainRenderer->SetCompressHeights(compressHeights);
+                }
+
+                MapObjectRenderer* mapObjectRenderer = terrainRenderer->GetMapObjectRenderer();
+                bool quantizeVertices = mapObjectRenderer->GetQuantizeVertices();
+                if (ImGui::Checkbox("Quantize map object vertices", &quantizeVertices))
+                {
+                    mapObjectRenderer->SetQuantizeVertices(quantizeVertices);
+                }
+
                 if (ImGui::Button("Load Map"))
                 {
                     u32 namehash = StringUtils::fnv1a_32(mapload.data(), mapload.size());
@@ -0,0 +1,9 @@
+#include "DBC.h"
+
+namespace DBC
+{
+    u32 Map::GetIndexKey(const Map& map, const StringTable& stringTable, u8 index)
+    {
+        return stringTable.GetStringHash(index == NameIndex ? map.Name : map.InternalName);
+    }
+}
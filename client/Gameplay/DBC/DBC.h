@@ -2,6 +2,9 @@
 #include <NovusTypes.h>
 #include <Utils/ByteBuffer.h>
 #include <Containers/StringTable.h>
+#include <memory>
+
+#include "../../Utils/MappedFile.h"
 
 namespace DBC
 {
@@ -14,10 +17,15 @@ namespace DBC
         u32 version;
     };
 
+    // A mapped .ndbc, the tables built from it point straight into the mapping and keep it alive
     struct File
     {
         DBCHeader header;
-        std::shared_ptr<Bytebuffer> buffer;
+        std::shared_ptr<MappedFile> mapping;
+
+        // Everything after the header, this is where the row count and rows start
+        const u8* GetData() const { return mapping->GetData() + sizeof(DBCHeader); }
+        size_t GetSize() const { return mapping->GetSize() - sizeof(DBCHeader); }
     };
 
     struct Map
@@ -29,5 +37,15 @@ namespace DBC
         u32 Flags = 0;
         u32 Expansion = 0;
         u32 MaxPlayers = 0;
+
+        // Secondary indexes DBCTable<Map> builds when it is loaded, the keys are hashes of the strings
+        enum Index : u8
+        {
+            NameIndex,
+            InternalNameIndex,
+            NumIndices
+        };
+
+        static u32 GetIndexKey(const Map& map, const StringTable& stringTable, u8 index);
     };
 }
\ No newline at end of file
@@ -1,10 +1,18 @@
 #include "DBCLoader.h"
+#include <Utils/DebugHandler.h>
+#include <Utils/StringUtils.h>
+#include <cstring>
 
 #include "../../ECS/Components/Singletons/DBCSingleton.h"
 
 namespace fs = std::filesystem;
 
 bool DBCLoader::Load(entt::registry* registry)
+{
+    return Load(registry->set<DBCSingleton>());
+}
+
+bool DBCLoader::Load(DBCSingleton& dbcSingleton)
 {
     fs::path absolutePath = std::filesystem::absolute("Data/extracted/Ndbc");
     if (!fs::is_directory(absolutePath))
@@ -13,8 +21,6 @@ bool DBCLoader::Load(entt::registry* registry)
         return false;
     }
 
-    DBCSingleton& dbcSingleton = registry->set<DBCSingleton>();
-
     size_t loadedDBCs = 0;
     for (const auto& entry : std::filesystem::recursive_directory_iterator(absolutePath))
     {
@@ -22,18 +28,10 @@ bool DBCLoader::Load(entt::registry* registry)
         if (filePath.extension() != ".ndbc")
             continue;
 
-        FileReader dbcFile(entry.path().string(), filePath.filename().string());
-        if (!dbcFile.Open())
-        {
-            NC_LOG_ERROR("Failed to load all maps");
-            return false;
-        }
-
         DBC::File file;
-        file.buffer = Bytebuffer::Borrow<524288>();
-        if (!ExtractFileData(dbcFile, file))
+        if (!LoadFile(filePath, file))
         {
-            NC_LOG_ERROR("Failed to load all maps");
+            NC_LOG_ERROR("Failed to load all dbcs");
             return false;
         }
 
@@ -54,12 +52,19 @@ bool DBCLoader::Load(entt::registry* registry)
     return true;
 }
 
-bool DBCLoader::ExtractFileData(FileReader& reader, DBC::File& file)
+bool DBCLoader::LoadFile(const std::filesystem::path& path, DBC::File& file)
 {
-    file.buffer->size = reader.Length();
-    reader.Read(file.buffer.get(), file.buffer->size);
+    file.mapping = std::make_shared<MappedFile>();
+    if (!file.mapping->Open(path))
+        return false;
+
+    if (file.mapping->GetSize() < sizeof(DBC::DBCHeader))
+    {
+        NC_LOG_ERROR("%s is too small to be a ndbc file", path.string().c_str());
+        return false;
+    }
 
-    file.buffer->Get<DBC::DBCHeader>(file.header);
+    std::memcpy(&file.header, file.mapping->GetData(), sizeof(DBC::DBCHeader));
 
     if (file.header.token != DBC::DBC_TOKEN)
     {
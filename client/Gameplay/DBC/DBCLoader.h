@@ -1,9 +1,10 @@
 #pragma once
 #include <NovusTypes.h>
-#include <Utils/FileReader.h>
 #include <entt.hpp>
+#include <filesystem>
 
 class StringTable;
+struct DBCSingleton;
 namespace DBC
 {
     struct File;
@@ -15,6 +16,9 @@ public:
     DBCLoader() { }
     static bool Load(entt::registry* registry);
 
-private:
-    static bool ExtractFileData(FileReader& reader, DBC::File& file);
+    // Fills a DBCSingleton that is already set in the registry, this doesn't touch the registry so it can run on a worker during startup
+    static bool Load(DBCSingleton& dbcSingleton);
+
+    // Maps a single .ndbc read-only and validates its header, the file stays mapped for as long as anything holds file.mapping
+    static bool LoadFile(const std::filesystem::path& path, DBC::File& file);
 };
\ No newline at end of file
@@ -0,0 +1,212 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Utils/ByteBuffer.h>
+#include <Utils/DebugHandler.h>
+#include <Containers/StringTable.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "DBC.h"
+
+// Typed view of a mapped .ndbc laid out as u32 row count, rows of T, string table
+// Rows are read straight from the mapping, only the string table and the indexes are built at load
+// T declares its secondary indexes with an Index enum ending in NumIndices and a static GetIndexKey(row, stringTable, index)
+template <typename T>
+class DBCTable
+{
+public:
+    static constexpr u32 INVALID_ROW = std::numeric_limits<u32>::max();
+
+    // Id lookups use a direct table when the ids are at most this many times as spread out as there are rows
+    static constexpr u32 MAX_DIRECT_ID_SPREAD = 4;
+
+    static_assert(alignof(T) <= sizeof(u32), "Rows follow the u32 row count and can't need more alignment than that");
+
+    bool Load(const DBC::File& file)
+    {
+        Clear();
+
+        const u8* data = file.GetData();
+        const size_t size = file.GetSize();
+
+        u32 numRows = 0;
+        if (size < sizeof(u32))
+        {
+            NC_LOG_ERROR("DBC is too small to hold a row count");
+            return false;
+        }
+        std::memcpy(&numRows, data, sizeof(u32));
+
+        const size_t rowsSize = static_cast<size_t>(numRows) * sizeof(T);
+        if (numRows == 0 || sizeof(u32) + rowsSize > size)
+        {
+            NC_LOG_ERROR("DBC has %u rows but only room for %u", numRows, static_cast<u32>((size - sizeof(u32)) / sizeof(T)));
+            return false;
+        }
+
+        // The string table is the only part that is copied out of the mapping, Deserialize only reads through the view
+        Bytebuffer stringTableBuffer(const_cast<u8*>(data + sizeof(u32) + rowsSize), size - sizeof(u32) - rowsSize);
+        stringTableBuffer.writtenData = stringTableBuffer.size;
+        _stringTable = std::make_unique<StringTable>();
+        _stringTable->Deserialize(&stringTableBuffer);
+
+        _mapping = file.mapping;
+        _rows = reinterpret_cast<const T*>(data + sizeof(u32));
+        _numRows = numRows;
+
+        BuildIdIndex();
+        BuildSecondaryIndexes();
+        return true;
+    }
+
+    void Clear()
+    {
+        _mapping = nullptr;
+        _rows = nullptr;
+        _numRows = 0;
+
+        _stringTable = nullptr;
+
+        _minId = 0;
+        _idToRow.clear();
+        _sortedIds.clear();
+
+        for (std::vector<std::pair<u32, u32>>& index : _indices)
+        {
+            index.clear();
+        }
+    }
+
+    u32 GetNumRows() const { return _numRows; }
+    const T& GetRow(u32 row) const { return _rows[row]; }
+
+    const T* begin() const { return _rows; }
+    const T* end() const { return _rows + _numRows; }
+
+    // Only valid once the table is loaded
+    const StringTable& GetStringTable() const { return *_stringTable; }
+    const std::string& GetString(u32 stringIndex) const { return _stringTable->GetString(stringIndex); }
+
+    // Returns nullptr if there is no row with the id
+    const T* GetById(u32 id) const
+    {
+        const u32 row = GetRowById(id);
+        return row != INVALID_ROW ? &_rows[row] : nullptr;
+    }
+
+    u32 GetRowById(u32 id) const
+    {
+        if (!_idToRow.empty())
+        {
+            const u32 offset = id - _minId;
+            return id >= _minId && offset < _idToRow.size() ? _idToRow[offset] : INVALID_ROW;
+        }
+
+        auto itr = std::lower_bound(_sortedIds.begin(), _sortedIds.end(), std::pair<u32, u32>(id, 0));
+        return itr != _sortedIds.end() && itr->first == id ? itr->second : INVALID_ROW;
+    }
+
+    // Returns the first row with key in the secondary index, nullptr if there is none
+    const T* GetByIndex(typename T::Index index, u32 key) const
+    {
+        const std::vector<std::pair<u32, u32>>& sortedKeys = _indices[index];
+
+        auto itr = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), std::pair<u32, u32>(key, 0));
+        return itr != sortedKeys.end() && itr->first == key ? &_rows[itr->second] : nullptr;
+    }
+
+    // Calls callback(const T&) for every row with key in the secondary index, in row order
+    template <typename Callback>
+    void ForEachByIndex(typename T::Index index, u32 key, Callback&& callback) const
+    {
+        const std::vector<std::pair<u32, u32>>& sortedKeys = _indices[index];
+
+        for (auto itr = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), std::pair<u32, u32>(key, 0)); itr != sortedKeys.end() && itr->first == key; itr++)
+        {
+            callback(_rows[itr->second]);
+        }
+    }
+
+    // Bytes allocated for the indexes, the rows themselves live in the mapping
+    size_t GetIndexMemoryUsage() const
+    {
+        size_t memoryUsage = (_idToRow.capacity() * sizeof(u32)) + (_sortedIds.capacity() * sizeof(std::pair<u32, u32>));
+        for (const std::vector<std::pair<u32, u32>>& index : _indices)
+        {
+            memoryUsage += index.capacity() * sizeof(std::pair<u32, u32>);
+        }
+
+        return memoryUsage;
+    }
+
+private:
+    void BuildIdIndex()
+    {
+        u32 minId = std::numeric_limits<u32>::max();
+        u32 maxId = 0;
+        for (u32 i = 0; i < _numRows; i++)
+        {
+            minId = std::min(minId, _rows[i].Id);
+            maxId = std::max(maxId, _rows[i].Id);
+        }
+
+        const u64 idSpread = static_cast<u64>(maxId - minId) + 1;
+        if (idSpread <= static_cast<u64>(_numRows) * MAX_DIRECT_ID_SPREAD)
+        {
+            _minId = minId;
+            _idToRow.assign(static_cast<size_t>(idSpread), INVALID_ROW);
+
+            // Duplicate ids resolve to the first row like the sorted index does
+            for (u32 i = _numRows; i-- > 0;)
+            {
+                _idToRow[_rows[i].Id - minId] = i;
+            }
+        }
+        else
+        {
+            _sortedIds.resize(_numRows);
+            for (u32 i = 0; i < _numRows; i++)
+            {
+                _sortedIds[i] = { _rows[i].Id, i };
+            }
+
+            std::sort(_sortedIds.begin(), _sortedIds.end());
+        }
+    }
+
+    void BuildSecondaryIndexes()
+    {
+        for (u8 index = 0; index < T::NumIndices; index++)
+        {
+            std::vector<std::pair<u32, u32>>& sortedKeys = _indices[index];
+            sortedKeys.resize(_numRows);
+
+            for (u32 i = 0; i < _numRows; i++)
+            {
+                sortedKeys[i] = { T::GetIndexKey(_rows[i], *_stringTable, index), i };
+            }
+
+            std::sort(sortedKeys.begin(), sortedKeys.end());
+        }
+    }
+
+private:
+    std::shared_ptr<MappedFile> _mapping = nullptr;
+    const T* _rows = nullptr;
+    u32 _numRows = 0;
+
+    std::unique_ptr<StringTable> _stringTable = nullptr;
+
+    // Only one of these is used, _idToRow when the ids are dense enough and _sortedIds otherwise
+    u32 _minId = 0;
+    std::vector<u32> _idToRow;
+    std::vector<std::pair<u32, u32>> _sortedIds;
+
+    // Sorted (key, row) pairs per secondary index
+    std::array<std::vector<std::pair<u32, u32>>, T::NumIndices> _indices;
+};
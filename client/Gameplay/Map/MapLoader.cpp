@@ -11,6 +11,11 @@
 namespace fs = std::filesystem;
 
 bool MapLoader::Init(entt::registry* registry)
+{
+    return Init(registry->set<MapSingleton>(), registry->ctx<DBCSingleton>());
+}
+
+bool MapLoader::Init(MapSingleton& mapSingleton, const DBCSingleton& dbcSingleton)
 {
     fs::path absolutePath = std::filesystem::absolute("Data/extracted/maps");
     if (!fs::is_directory(absolutePath))
@@ -19,10 +24,7 @@ bool MapLoader::Init(entt::registry* registry)
         return false;
     }
 
-    MapSingleton& mapSingleton = registry->set<MapSingleton>();
-    DBCSingleton& dbcSingleton = registry->ctx<DBCSingleton>();
-
-    if (mapSingleton.mapDBCFiles.size() != 0)
+    if (mapSingleton.mapDBC.GetNumRows() != 0)
     {
         NC_LOG_ERROR("MapLoader::Init can only be called once");
         return false;
@@ -35,22 +37,14 @@ bool MapLoader::Init(entt::registry* registry)
         return false;
     }
 
-    if (!ExtractMapDBC(itr->second, mapSingleton.mapDBCFiles, mapSingleton.mapsDBCStringTable))
+    if (!mapSingleton.mapDBC.Load(itr->second))
     {
         NC_LOG_ERROR("Failed to correctly load Maps.ndbc data");
         return false;
     }
 
-    for (DBC::Map& map : mapSingleton.mapDBCFiles)
-    {
-        u32 mapNameHash = mapSingleton.mapsDBCStringTable.GetStringHash(map.Name);
-        u32 mapInternalNameHash = mapSingleton.mapsDBCStringTable.GetStringHash(map.InternalName);
-
-        mapSingleton.mapIdToDBC[map.Id] = &map;
-        mapSingleton.mapNameToDBC[mapNameHash] = &map;
-        mapSingleton.mapInternalNameToDBC[mapInternalNameHash] = &map;
-    }
-
+    // We always expect to have at least 2 strings per map in our stringtable, the name and internal name
+    assert(mapSingleton.mapDBC.GetStringTable().GetNumStrings() > 0);
     return true;
 }
 
@@ -64,16 +58,14 @@ bool MapLoader::LoadMap(entt::registry* registry, u32 mapInternalNameHash)
         return false; // Don't reload the map we're on
     }
 
-    auto itr = mapSingleton.mapInternalNameToDBC.find(mapInternalNameHash);
-    if (itr == mapSingleton.mapInternalNameToDBC.end())
+    const DBC::Map* map = mapSingleton.mapDBC.GetByIndex(DBC::Map::InternalNameIndex, mapInternalNameHash);
+    if (!map)
     {
         NC_LOG_ERROR("Tried to Load Map with no entry in Maps.ndbc");
         return false;
     }
 
-    const DBC::Map* map = mapSingleton.mapInternalNameToDBC[mapInternalNameHash];
-
-    const std::string& mapInternalName = mapSingleton.mapsDBCStringTable.GetString(map->InternalName);
+    const std::string& mapInternalName = mapSingleton.mapDBC.GetString(map->InternalName);
     fs::path absolutePath = std::filesystem::absolute("Data/extracted/maps/" + mapInternalName);
     if (!fs::is_directory(absolutePath))
     {
@@ -118,8 +110,7 @@ bool MapLoader::LoadMap(entt::registry* registry, u32 mapInternalNameHash)
             mapInternalName += "_" + splitName[i];
         }
 
-        auto itr = mapSingleton.mapInternalNameToDBC.find(mapInternalNameHash);
-        if (itr == mapSingleton.mapInternalNameToDBC.end())
+        if (!mapSingleton.mapDBC.GetByIndex(DBC::Map::InternalNameIndex, mapInternalNameHash))
         {
             NC_LOG_ERROR("Tried to Load Map with no entry in Maps.ndbc (%s, %s)", splitName[0].c_str(), splitName[1].c_str());
             continue;
@@ -145,23 +136,6 @@ bool MapLoader::LoadMap(entt::registry* registry, u32 mapInternalNameHash)
     return true;
 }
 
-bool MapLoader::ExtractMapDBC(DBC::File& file, std::vector<DBC::Map>& maps, StringTable& stringTable)
-{
-    u32 numMaps = 0;
-    file.buffer->GetU32(numMaps);
-
-    if (numMaps == 0)
-        return false;
-    
-    // Resize our vector and fill it with map data
-    maps.resize(numMaps);
-    file.buffer->GetBytes(reinterpret_cast<u8*>(&maps[0]), sizeof(DBC::Map) * numMaps);
-
-    stringTable.Deserialize(file.buffer.get());
-    assert(stringTable.GetNumStrings() > 0); // We always expect to have at least 2 strings per map in our stringtable, a path for the base texture
-    return true;
-}
-
 bool MapLoader::ExtractChunkData(FileReader& reader, Terrain::Chunk& chunk, StringTable& stringTable)
 {
     Bytebuffer buffer(nullptr, reader.Length());
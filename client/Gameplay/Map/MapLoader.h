@@ -28,26 +28,24 @@
 #include <vector>
 
 class StringTable;
+struct MapSingleton;
+struct DBCSingleton;
 namespace Terrain
 {
     struct Chunk;
 }
 
-namespace DBC
-{
-    struct File;
-    struct Map;
-}
-
 class MapLoader
 {
 public:
     MapLoader() { }
 
     static bool Init(entt::registry* registry);
+
+    // Fills a MapSingleton that is already set in the registry, this doesn't touch the registry so it can run on a worker during startup
+    static bool Init(MapSingleton& mapSingleton, const DBCSingleton& dbcSingleton);
     static bool LoadMap(entt::registry* registry, u32 mapInternalNameHash);
 
 private:
-    static bool ExtractMapDBC(DBC::File& file, std::vector<DBC::Map>& maps, StringTable& stringTable);
     static bool ExtractChunkData(FileReader& reader, Terrain::Chunk& chunk, StringTable& stringTable);
 };
\ No newline at end of file
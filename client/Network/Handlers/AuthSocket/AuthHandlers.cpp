@@ -5,6 +5,7 @@
 #include <Utils/ByteBuffer.h>
 #include "../../../Utils/ServiceLocator.h"
 #include "../../../ECS/Components/Network/AuthenticationSingleton.h"
+#include "../../../ECS/Components/Network/ConnectionSingleton.h"
 #include "../../../ECS/Systems/Network/ConnectionSystems.h"
 
 // @TODO: Remove Temporary Includes when they're no longer needed
@@ -30,17 +31,13 @@ namespace AuthSocket
         if (!authenticationSingleton.srp.ProcessChallenge(logonChallenge.s, logonChallenge.B))
             return false;
 
-        std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<36>();
         ClientLogonHandshake clientResponse;
-
         std::memcpy(clientResponse.M1, authenticationSingleton.srp.M, 32);
 
-        buffer->Put(Opcode::CMSG_LOGON_HANDSHAKE);
-        buffer->PutU16(0);
-
-        u16 payloadSize = clientResponse.Serialize(buffer);
-        buffer->Put<u16>(payloadSize, 2);
-        authSocket->Send(buffer);
+        PacketWriter& packetWriter = gameRegistry->ctx<ConnectionSingleton>().authPacketWriter;
+        std::shared_ptr<Bytebuffer>& buffer = packetWriter.BeginPacket(Opcode::CMSG_LOGON_HANDSHAKE, 32);
+        clientResponse.Serialize(buffer);
+        packetWriter.EndPacket();
 
         authSocket->SetStatus(ConnectionStatus::AUTH_HANDSHAKE);
         return true;
@@ -65,10 +62,7 @@ namespace AuthSocket
         }
 
         // Send CMSG_CONNECTED (This will be changed in the future)
-        std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<128>();
-        buffer->Put(Opcode::CMSG_CONNECTED);
-        buffer->PutU16(0);
-        authSocket->Send(buffer);
+        gameRegistry->ctx<ConnectionSingleton>().authPacketWriter.WritePacket(Opcode::CMSG_CONNECTED);
 
         authSocket->SetStatus(ConnectionStatus::AUTH_SUCCESS);
         return true;
@@ -96,15 +90,16 @@ namespace AuthSocket
             authSocket->Close(asio::error::shut_down);
             authSocket->SetConnectHandler(nullptr);
 
+            // Anything still queued was meant for the region server, the framer is reset by the connect handler on the network thread
+            entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
+            PacketWriter& packetWriter = gameRegistry->ctx<ConnectionSingleton>().authPacketWriter;
+            packetWriter.Reset();
+
             if (authSocket->Connect(address, port))
             {
-                entt::registry* gameRegistry = ServiceLocator::GetGameRegistry();
                 AuthenticationSingleton& authentication = gameRegistry->ctx<AuthenticationSingleton>();
 
                 // Send Initial Packet
-
-                std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<512>();
-
                 ClientLogonChallenge logonChallenge;
                 logonChallenge.majorVersion = 3;
                 logonChallenge.patchVersion = 3;
@@ -126,13 +121,9 @@ namespace AuthSocket
                 if (!authentication.srp.StartAuthentication())
                     return false;
 
-                buffer->Put(Opcode::CMSG_LOGON_CHALLENGE);
-                buffer->PutU16(0);
-
-                u16 payloadSize = logonChallenge.Serialize(buffer, authentication.srp.aBuffer);
-
-                buffer->Put<u16>(payloadSize, 2);
-                authSocket->Send(buffer);
+                std::shared_ptr<Bytebuffer>& buffer = packetWriter.BeginPacket(Opcode::CMSG_LOGON_CHALLENGE, 512 - PacketWriter::HEADER_SIZE);
+                logonChallenge.Serialize(buffer, authentication.srp.aBuffer);
+                packetWriter.EndPacket();
 
                 authSocket->SetStatus(ConnectionStatus::AUTH_CHALLENGE);
                 return true;
@@ -7,6 +7,7 @@
 #include "../../../Utils/ServiceLocator.h"
 #include "../../../ECS/Components/Transform.h"
 #include "../../../ECS/Components/LocalplayerSingleton.h"
+#include "../../../ECS/Components/Network/EntityUpdateSingleton.h"
 
 namespace GameSocket
 {
@@ -35,9 +36,12 @@ namespace GameSocket
         entt::entity entity = registry->create(localplayerSingleton.entity);
         Transform& transform = registry->emplace<Transform>(entity);
 
+        // GetRotation returns a copy, read into a local and set it or the rotation is lost
+        vec3 rotation;
         packet->payload->Get(transform.position);
-        packet->payload->Get(transform.GetRotation());
+        packet->payload->Get(rotation);
         packet->payload->Get(transform.scale);
+        transform.SetRotation(rotation);
         transform.isDirty = true;
 
         Model& model = EntityUtils::CreateModelComponent(*registry, entity, "Data/models/Cube.novusmodel");
@@ -64,9 +68,12 @@ namespace GameSocket
         entt::entity entity = registry->create(entityId);
         Transform& transform = registry->emplace<Transform>(entity);
 
+        // GetRotation returns a copy, read into a local and set it or the rotation is lost
+        vec3 rotation;
         packet->payload->Get(transform.position);
-        packet->payload->Get(transform.GetRotation());
+        packet->payload->Get(rotation);
         packet->payload->Get(transform.scale);
+        transform.SetRotation(rotation);
         transform.isDirty = true;
 
         Model& model = EntityUtils::CreateModelComponent(*registry, entity, "Data/models/Cube.novusmodel");
@@ -84,12 +91,15 @@ namespace GameSocket
         if (localplayerSingleton.entity == entityId)
             return true;
 
-        Transform& transform = registry->get<Transform>(entityId);
-        packet->payload->Get(transform.position);
-        packet->payload->Get(transform.GetRotation());
-        packet->payload->Get(transform.scale);
-        transform.isDirty = true;
+        // Only parsed here, EntityUpdateSystem applies the whole frame's batch to the registry in one pass
+        vec3 position;
+        vec3 rotation;
+        vec3 scale;
+        packet->payload->Get(position);
+        packet->payload->Get(rotation);
+        packet->payload->Get(scale);
 
+        registry->ctx<EntityUpdateSingleton>().Add(entityId, position, rotation, scale);
         return true;
     }
     bool GameHandlers::HandleDeleteEntity(std::shared_ptr<NetworkClient> networkClient, std::shared_ptr<NetworkPacket>& packet)
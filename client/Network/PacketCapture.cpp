@@ -0,0 +1,192 @@
+#include "PacketCapture.h"
+#include <Utils/DebugHandler.h>
+#include <limits>
+#include "../ECS/Components/Network/ConnectionSingleton.h"
+
+bool PacketCapture::Open(const std::filesystem::path& path)
+{
+    std::lock_guard lock(_mutex);
+
+    if (_file.is_open())
+    {
+        _file.close();
+    }
+
+    _file.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!_file)
+    {
+        NC_LOG_ERROR("Failed to create packet capture %s", path.string().c_str());
+        _isOpen = false;
+        return false;
+    }
+
+    PacketCaptureHeader header;
+    _file.write(reinterpret_cast<const char*>(&header), sizeof(PacketCaptureHeader));
+
+    _startTime = Clock::now();
+    _packetCount = 0;
+    _isOpen = true;
+    return true;
+}
+
+void PacketCapture::Close()
+{
+    std::lock_guard lock(_mutex);
+
+    _isOpen = false;
+    if (_file.is_open())
+    {
+        _file.close();
+    }
+}
+
+void PacketCapture::Write(PacketCaptureConnection connection, const NetworkPacket& packet)
+{
+    if (!_isOpen)
+        return;
+
+    u8 header[PacketFramer::HEADER_SIZE];
+    std::memcpy(header, &packet.header.opcode, sizeof(Opcode));
+    std::memcpy(header + sizeof(Opcode), &packet.header.size, sizeof(u16));
+
+    const u8 connectionType = static_cast<u8>(connection);
+
+    std::lock_guard lock(_mutex);
+    if (!_file.is_open())
+        return;
+
+    // Open writes _startTime under the same lock, reading it here keeps a capture that gets reopened from seeing a torn or stale start
+    const u64 timestampUS = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - _startTime).count();
+
+    _file.write(reinterpret_cast<const char*>(&timestampUS), sizeof(u64));
+    _file.write(reinterpret_cast<const char*>(&connectionType), sizeof(u8));
+    _file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    if (packet.header.size)
+    {
+        _file.write(reinterpret_cast<const char*>(packet.payload->GetDataPointer()), packet.header.size);
+    }
+
+    _packetCount++;
+}
+
+void PacketCapture::WriteRecord(PacketCaptureConnection connection, u64 timestampUS, const u8* packetData, size_t packetSize)
+{
+    const u8 connectionType = static_cast<u8>(connection);
+
+    std::lock_guard lock(_mutex);
+    if (!_file.is_open())
+        return;
+
+    _file.write(reinterpret_cast<const char*>(&timestampUS), sizeof(u64));
+    _file.write(reinterpret_cast<const char*>(&connectionType), sizeof(u8));
+    _file.write(reinterpret_cast<const char*>(packetData), packetSize);
+
+    _packetCount++;
+}
+
+bool PacketReplay::Load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+    if (!file)
+    {
+        NC_LOG_ERROR("Failed to open packet capture %s", path.string().c_str());
+        return false;
+    }
+
+    PacketCaptureHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(PacketCaptureHeader));
+
+    if (!file || header.magic != PacketCaptureHeader::MAGIC)
+    {
+        NC_LOG_ERROR("%s is not a packet capture", path.string().c_str());
+        return false;
+    }
+
+    if (header.version != PacketCaptureHeader::VERSION)
+    {
+        NC_LOG_ERROR("Packet capture %s has version %u, expected %u", path.string().c_str(), header.version, PacketCaptureHeader::VERSION);
+        return false;
+    }
+
+    _records.clear();
+    _data.clear();
+
+    while (true)
+    {
+        Record record;
+        u8 connectionType = 0;
+        u8 packetHeader[PacketFramer::HEADER_SIZE];
+
+        file.read(reinterpret_cast<char*>(&record.timestampUS), sizeof(u64));
+        if (file.eof())
+            break;
+
+        file.read(reinterpret_cast<char*>(&connectionType), sizeof(u8));
+        file.read(reinterpret_cast<char*>(packetHeader), sizeof(packetHeader));
+
+        u16 payloadSize = 0;
+        std::memcpy(&payloadSize, packetHeader + sizeof(Opcode), sizeof(u16));
+
+        if (!file || connectionType >= static_cast<u8>(PacketCaptureConnection::Count) || payloadSize > NETWORK_BUFFER_SIZE)
+        {
+            NC_LOG_ERROR("Packet capture %s is corrupt after %u packets", path.string().c_str(), static_cast<u32>(_records.size()));
+            return false;
+        }
+
+        record.connection = static_cast<PacketCaptureConnection>(connectionType);
+        record.offset = static_cast<u32>(_data.size());
+        record.size = static_cast<u32>(sizeof(packetHeader) + payloadSize);
+
+        _data.resize(_data.size() + record.size);
+        std::memcpy(&_data[record.offset], packetHeader, sizeof(packetHeader));
+        file.read(reinterpret_cast<char*>(&_data[record.offset + sizeof(packetHeader)]), payloadSize);
+
+        if (!file)
+        {
+            NC_LOG_ERROR("Packet capture %s is truncated after %u packets", path.string().c_str(), static_cast<u32>(_records.size()));
+            return false;
+        }
+
+        _records.push_back(record);
+    }
+
+    return true;
+}
+
+void PacketReplay::Start(Mode mode)
+{
+    _mode = mode;
+    _startTime = PacketCapture::Clock::now();
+    _nextRecord = 0;
+
+    for (PacketFramer& framer : _framers)
+    {
+        framer.Reset();
+    }
+}
+
+bool PacketReplay::Update(ConnectionSingleton& connectionSingleton)
+{
+    u64 elapsedUS = std::numeric_limits<u64>::max();
+    if (_mode == Mode::OriginalTiming)
+    {
+        elapsedUS = std::chrono::duration_cast<std::chrono::microseconds>(PacketCapture::Clock::now() - _startTime).count();
+    }
+
+    moodycamel::ConcurrentQueue<std::shared_ptr<NetworkPacket>>* queues[] = { &connectionSingleton.authPacketQueue, &connectionSingleton.gamePacketQueue };
+
+    for (; _nextRecord < _records.size() && _records[_nextRecord].timestampUS <= elapsedUS; _nextRecord++)
+    {
+        const Record& record = _records[_nextRecord];
+        moodycamel::ConcurrentQueue<std::shared_ptr<NetworkPacket>>* queue = queues[static_cast<u8>(record.connection)];
+
+        // Records were validated by Load, every one of them is exactly one complete packet
+        _framers[static_cast<u8>(record.connection)].Receive(&_data[record.offset], record.size, [queue](std::shared_ptr<NetworkPacket>& packet)
+        {
+            queue->enqueue(packet);
+        });
+    }
+
+    return _nextRecord < _records.size();
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Networking/NetworkPacket.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "PacketFramer.h"
+
+struct ConnectionSingleton;
+
+enum class PacketCaptureConnection : u8
+{
+    Auth,
+    Game,
+    Count
+};
+
+// Capture files start with the header below, followed by one record per packet:
+// u64 microseconds since the capture started, u8 PacketCaptureConnection, then the packet exactly like it came off the socket (opcode, u16 size, payload)
+struct PacketCaptureHeader
+{
+    static constexpr u32 MAGIC = 0x4350434E; // "NCPC"
+    static constexpr u32 VERSION = 1;
+
+    u32 magic = MAGIC;
+    u32 version = VERSION;
+};
+
+// Records incoming packets from the socket read handlers, Write is safe to call from both network threads
+class PacketCapture
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    bool IsOpen() const { return _isOpen; }
+
+    void Write(PacketCaptureConnection connection, const NetworkPacket& packet);
+
+    // Writes a record with an explicit timestamp, packetData holds the header followed by the payload
+    void WriteRecord(PacketCaptureConnection connection, u64 timestampUS, const u8* packetData, size_t packetSize);
+
+    u64 GetPacketCount() const { return _packetCount; }
+
+private:
+    std::atomic<bool> _isOpen = false;
+    std::mutex _mutex;
+    std::ofstream _file;
+    Clock::time_point _startTime;
+    u64 _packetCount = 0;
+};
+
+// Replays a capture into ConnectionSingleton's packet queues, packets go through a PacketFramer so they are built exactly like live ones
+class PacketReplay
+{
+public:
+    enum class Mode : u8
+    {
+        OriginalTiming, // Packets are injected when as much time has passed as when they were recorded
+        AsFastAsPossible // Everything is injected on the first Update
+    };
+
+    bool Load(const std::filesystem::path& path);
+    void Start(Mode mode);
+
+    // Injects every packet that is due into the connection queues, returns false once the whole capture has been injected
+    bool Update(ConnectionSingleton& connectionSingleton);
+
+    size_t GetPacketCount() const { return _records.size(); }
+    u64 GetDurationUS() const { return _records.empty() ? 0 : _records.back().timestampUS; }
+
+private:
+    struct Record
+    {
+        u64 timestampUS;
+        PacketCaptureConnection connection;
+        u32 offset;
+        u32 size;
+    };
+
+    std::vector<Record> _records;
+    std::vector<u8> _data;
+
+    Mode _mode = Mode::OriginalTiming;
+    PacketCapture::Clock::time_point _startTime;
+    size_t _nextRecord = 0;
+
+    PacketFramer _framers[static_cast<u8>(PacketCaptureConnection::Count)];
+};
@@ -0,0 +1,123 @@
+#include "PacketFramer.h"
+#include <atomic>
+
+PacketFramer::PacketFramer()
+{
+    _blocks.push_back(std::make_shared<ReceiveBlock>());
+    _block = _blocks[0];
+    _stats.blocksAllocated = 1;
+}
+
+void PacketFramer::Reset()
+{
+    _readOffset = 0;
+    _writeOffset = 0;
+
+    if (IsBlockFree(_block))
+    {
+        _block->numViews = 0;
+    }
+    else
+    {
+        // Packets from the previous connection may still be queued, leave their block alone
+        _writeOffset = BLOCK_SIZE;
+        _readOffset = BLOCK_SIZE;
+        RotateBlock();
+    }
+}
+
+std::shared_ptr<Bytebuffer> PacketFramer::CreatePayload(const u8* data, u16 size)
+{
+    if (size <= SMALL_PACKET_SIZE || _copyPayloads)
+    {
+        std::shared_ptr<Bytebuffer> payload = size <= SMALL_PACKET_SIZE ? Bytebuffer::Borrow<SMALL_PACKET_SIZE>() : Bytebuffer::Borrow<NETWORK_BUFFER_SIZE>();
+        payload->size = size;
+        payload->writtenData = size;
+        std::memcpy(payload->GetDataPointer(), data, size);
+
+        _stats.copiedPackets++;
+        return payload;
+    }
+
+    assert(_block->numViews < MAX_VIEWS_PER_BLOCK);
+
+    std::optional<Bytebuffer>& view = _block->views[_block->numViews++];
+    view.emplace(const_cast<u8*>(data), size);
+    view->writtenData = size;
+
+    _stats.slicedPackets++;
+
+    // Shares ownership with the block, the block can't be written to again until every view of it is released
+    return std::shared_ptr<Bytebuffer>(_block, &view.value());
+}
+
+void PacketFramer::RotateBlock()
+{
+    std::shared_ptr<ReceiveBlock> nextBlock = nullptr;
+
+    const size_t numBlocks = _blocks.size();
+    for (size_t i = 1; i <= numBlocks; i++)
+    {
+        const size_t index = (_blockIndex + i) % numBlocks;
+        if (_blocks[index] != _block && IsBlockFree(_blocks[index]))
+        {
+            _blockIndex = index;
+            nextBlock = _blocks[index];
+            break;
+        }
+    }
+
+    if (!nextBlock)
+    {
+        if (_blocks.size() < MAX_BLOCKS)
+        {
+            // Every block is pinned by packets that haven't been handled yet, grow the ring
+            _blockIndex = _blocks.size();
+            nextBlock = _blocks.emplace_back(std::make_shared<ReceiveBlock>());
+            _stats.blocksAllocated++;
+        }
+        else
+        {
+            // Nothing was sliced out of this block since the ring hit MAX_BLOCKS, so it can be reused in place
+            assert(IsBlockFree(_block));
+            nextBlock = _block;
+        }
+    }
+
+    // Only the framer pins blocks, so a block that is free now is still free at the next rotation. Without one
+    // (besides the next block) the ring is full and payloads get copied, which keeps the next block free to reuse
+    _copyPayloads = _blocks.size() == MAX_BLOCKS;
+    for (size_t i = 0; i < numBlocks && _copyPayloads; i++)
+    {
+        if (_blocks[i] != nextBlock && IsBlockFree(_blocks[i]))
+        {
+            _copyPayloads = false;
+        }
+    }
+
+    const size_t pendingBytes = _writeOffset - _readOffset;
+    if (pendingBytes)
+    {
+        // memmove since the pending bytes are moved within the same block when it is reused
+        std::memmove(nextBlock->data, &_block->data[_readOffset], pendingBytes);
+        _stats.carriedBytes += pendingBytes;
+    }
+
+    nextBlock->numViews = 0;
+
+    _block = nextBlock;
+    _readOffset = 0;
+    _writeOffset = pendingBytes;
+}
+
+bool PacketFramer::IsBlockFree(const std::shared_ptr<ReceiveBlock>& block) const
+{
+    // _blocks and _block are the only owners of a block that isn't referenced by any packet
+    const long numOwners = block == _block ? 2 : 1;
+    if (block.use_count() != numOwners)
+        return false;
+
+    // Pairs with the release done by the consuming thread when it drops its last packet
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return true;
+}
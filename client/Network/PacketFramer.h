@@ -0,0 +1,155 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Networking/NetworkPacket.h>
+#include <Utils/ByteBuffer.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+struct PacketFramerStats
+{
+    u64 packets = 0;
+    u64 bytesReceived = 0;
+
+    u64 slicedPackets = 0; // Payloads handed out as views into a receive block
+    u64 copiedPackets = 0; // Small payloads, and every payload while the ring is at MAX_BLOCKS, copied into pooled buffers
+    u64 carriedBytes = 0; // Bytes of partial packets moved to the front of the next block
+
+    u32 blocksAllocated = 0;
+};
+
+// Splits a socket byte stream into NetworkPackets, headers and payloads may be split over any number of reads
+// Received bytes are appended to a ring of reference counted blocks, large payloads are Bytebuffer views into those blocks
+// and keep their block alive until the last packet referencing it is released. Small payloads are copied into pooled buffers
+// since that is cheaper than pinning a whole block for a handful of bytes. Once MAX_BLOCKS blocks are pinned every payload is copied,
+// so a backlog of unhandled packets can't grow the ring without bound
+class PacketFramer
+{
+public:
+    static constexpr size_t HEADER_SIZE = sizeof(Opcode) + sizeof(u16);
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t SMALL_PACKET_SIZE = 256;
+    static constexpr size_t MAX_BLOCKS = 16;
+
+    // Every sliced payload is larger than SMALL_PACKET_SIZE, this bounds how many views a single block can hand out
+    static constexpr size_t MAX_VIEWS_PER_BLOCK = BLOCK_SIZE / (HEADER_SIZE + SMALL_PACKET_SIZE + 1) + 1;
+
+    static_assert(HEADER_SIZE + NETWORK_BUFFER_SIZE <= BLOCK_SIZE, "A partial packet must always fit inside a fresh receive block");
+
+    PacketFramer();
+
+    // Appends data to the stream and calls onPacket(std::shared_ptr<NetworkPacket>&) for every packet it completes
+    // Returns false if the stream is corrupt, the connection should be closed since there is no way to resynchronize
+    template <typename Callback>
+    bool Receive(const u8* data, size_t size, Callback&& onPacket)
+    {
+        _stats.bytesReceived += size;
+
+        while (size > 0)
+        {
+            if (_writeOffset == BLOCK_SIZE)
+            {
+                RotateBlock();
+            }
+
+            const size_t numBytes = std::min(size, BLOCK_SIZE - _writeOffset);
+            std::memcpy(&_block->data[_writeOffset], data, numBytes);
+
+            _writeOffset += numBytes;
+            data += numBytes;
+            size -= numBytes;
+
+            if (!Parse(onPacket))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Drops any partial packet, call this when the connection is (re)established
+    void Reset();
+
+    const PacketFramerStats& GetStats() const { return _stats; }
+
+private:
+    struct ReceiveBlock
+    {
+        ReceiveBlock() : views(MAX_VIEWS_PER_BLOCK) { }
+
+        u8 data[BLOCK_SIZE];
+
+        // Sized once and never resized, packets hold aliasing pointers into it
+        std::vector<std::optional<Bytebuffer>> views;
+        size_t numViews = 0;
+    };
+
+    template <typename Callback>
+    bool Parse(Callback& onPacket)
+    {
+        while (_writeOffset - _readOffset >= HEADER_SIZE)
+        {
+            const u8* header = &_block->data[_readOffset];
+
+            Opcode opcode = Opcode::INVALID;
+            u16 size = 0;
+            std::memcpy(&opcode, header, sizeof(Opcode));
+            std::memcpy(&size, header + sizeof(Opcode), sizeof(u16));
+
+            if (size > NETWORK_BUFFER_SIZE)
+                return false;
+
+            if (_writeOffset - _readOffset < HEADER_SIZE + size)
+                break;
+
+            std::shared_ptr<NetworkPacket> packet = NetworkPacket::Borrow();
+            packet->header.opcode = opcode;
+            packet->header.size = size;
+
+            if (size)
+            {
+                packet->payload = CreatePayload(header + HEADER_SIZE, size);
+            }
+            else
+            {
+                // Pooled packets can still hold the payload of their previous use
+                packet->payload = nullptr;
+            }
+
+            _readOffset += HEADER_SIZE + size;
+            _stats.packets++;
+
+            onPacket(packet);
+        }
+
+        // Nothing is pending, start over from the front if no packet is still looking at this block
+        if (_readOffset == _writeOffset && IsBlockFree(_block))
+        {
+            _readOffset = 0;
+            _writeOffset = 0;
+            _block->numViews = 0;
+        }
+
+        return true;
+    }
+
+    std::shared_ptr<Bytebuffer> CreatePayload(const u8* data, u16 size);
+
+    // Moves the partial packet at the end of the current block into the next free block of the ring
+    void RotateBlock();
+    bool IsBlockFree(const std::shared_ptr<ReceiveBlock>& block) const;
+
+private:
+    std::vector<std::shared_ptr<ReceiveBlock>> _blocks;
+    size_t _blockIndex = 0;
+
+    std::shared_ptr<ReceiveBlock> _block = nullptr;
+    size_t _readOffset = 0;
+    size_t _writeOffset = 0;
+
+    bool _copyPayloads = false; // Set while every other block is pinned and the ring is at MAX_BLOCKS, keeps _block free so it can be reused
+
+    PacketFramerStats _stats;
+};
@@ -0,0 +1,70 @@
+#include "PacketWriter.h"
+#include <cassert>
+
+std::shared_ptr<Bytebuffer>& PacketWriter::BeginPacket(Opcode opcode, u16 maxPayloadSize)
+{
+    assert(!_isWritingPacket);
+    assert(HEADER_SIZE + maxPayloadSize <= SEND_BUFFER_SIZE);
+
+    if (_buffer && _buffer->writtenData + HEADER_SIZE + maxPayloadSize > SEND_BUFFER_SIZE)
+    {
+        CloseBuffer();
+    }
+
+    if (!_buffer)
+    {
+        _buffer = Bytebuffer::Borrow<SEND_BUFFER_SIZE>();
+        _bufferStartTime = Clock::now();
+    }
+
+    _packetStart = _buffer->writtenData;
+    _isWritingPacket = true;
+
+    // The size is patched in by EndPacket once the payload is known
+    _buffer->Put(opcode);
+    _buffer->PutU16(0);
+
+    return _buffer;
+}
+
+void PacketWriter::EndPacket()
+{
+    assert(_isWritingPacket);
+    _isWritingPacket = false;
+
+    const size_t packetSize = _buffer->writtenData - _packetStart;
+    _buffer->Put<u16>(static_cast<u16>(packetSize - HEADER_SIZE), _packetStart + sizeof(Opcode));
+
+    _stats.packets++;
+    _stats.bytes += packetSize;
+
+    if (_buffer->writtenData >= _flushSize)
+    {
+        CloseBuffer();
+    }
+}
+
+void PacketWriter::Reset()
+{
+    assert(!_isWritingPacket);
+
+    _buffer = nullptr;
+    _pendingBuffers.clear();
+}
+
+size_t PacketWriter::GetPendingBytes() const
+{
+    size_t pendingBytes = _buffer ? _buffer->writtenData : 0;
+    for (const std::shared_ptr<Bytebuffer>& buffer : _pendingBuffers)
+    {
+        pendingBytes += buffer->writtenData;
+    }
+
+    return pendingBytes;
+}
+
+void PacketWriter::CloseBuffer()
+{
+    _pendingBuffers.push_back(std::move(_buffer));
+    _buffer = nullptr;
+}
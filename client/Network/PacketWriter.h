@@ -0,0 +1,91 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Networking/NetworkPacket.h>
+#include <Utils/ByteBuffer.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+struct PacketWriterStats
+{
+    u64 packets = 0;
+    u64 bytes = 0;
+    u64 sends = 0; // Every send is one socket write
+    u64 flushes = 0;
+};
+
+// Coalesces outgoing packets into per-connection send buffers so a frame's worth of packets goes out in as few writes as possible
+// Packets are written with BeginPacket/EndPacket during the frame and Flush is called once per tick to hand the buffers to the socket
+class PacketWriter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t HEADER_SIZE = sizeof(Opcode) + sizeof(u16);
+    static constexpr size_t SEND_BUFFER_SIZE = 4096;
+
+    // Starts a packet, write the payload into the returned buffer and finish it with EndPacket
+    // maxPayloadSize is only used to decide if the packet still fits in the current send buffer
+    std::shared_ptr<Bytebuffer>& BeginPacket(Opcode opcode, u16 maxPayloadSize);
+    void EndPacket();
+
+    // Writes a packet without a payload
+    void WritePacket(Opcode opcode)
+    {
+        BeginPacket(opcode, 0);
+        EndPacket();
+    }
+
+    // Calls send(std::shared_ptr<Bytebuffer>&) for every send buffer that is due, the buffer being filled is only sent
+    // when force is set or its oldest packet has waited longer than the latency threshold
+    template <typename SendFunction>
+    void Flush(SendFunction&& send, bool force = false)
+    {
+        if (_buffer && (force || Clock::now() - _bufferStartTime >= _maxLatency))
+        {
+            _pendingBuffers.push_back(std::move(_buffer));
+            _buffer = nullptr;
+        }
+
+        if (_pendingBuffers.empty())
+            return;
+
+        for (std::shared_ptr<Bytebuffer>& buffer : _pendingBuffers)
+        {
+            send(buffer);
+        }
+
+        _stats.sends += _pendingBuffers.size();
+        _stats.flushes++;
+        _pendingBuffers.clear();
+    }
+
+    // Drops everything that hasn't been sent yet, used when the connection it was meant for goes away
+    void Reset();
+
+    // A send buffer is closed once it holds this many bytes, every closed buffer becomes one write on the next Flush
+    void SetFlushSize(size_t flushSize) { _flushSize = std::min(flushSize, SEND_BUFFER_SIZE); }
+
+    // How long a partially filled send buffer may be held back to coalesce it with packets from later ticks, 0 sends every tick
+    void SetMaxLatency(Clock::duration maxLatency) { _maxLatency = maxLatency; }
+
+    size_t GetPendingBytes() const;
+    const PacketWriterStats& GetStats() const { return _stats; }
+
+private:
+    void CloseBuffer();
+
+private:
+    std::shared_ptr<Bytebuffer> _buffer = nullptr;
+    std::vector<std::shared_ptr<Bytebuffer>> _pendingBuffers;
+    Clock::time_point _bufferStartTime;
+
+    size_t _packetStart = 0;
+    bool _isWritingPacket = false;
+
+    size_t _flushSize = SEND_BUFFER_SIZE;
+    Clock::duration _maxLatency = Clock::duration::zero();
+
+    PacketWriterStats _stats;
+};
@@ -16,14 +16,14 @@ namespace fs = std::filesystem;
 void CameraFreeLook::Init()
 {
     InputManager* inputManager = ServiceLocator::GetInputManager();
-    inputManager->RegisterKeybind("CameraFreeLook Forward", GLFW_KEY_W, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
-    inputManager->RegisterKeybind("CameraFreeLook Backward", GLFW_KEY_S, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
-    inputManager->RegisterKeybind("CameraFreeLook Left", GLFW_KEY_A, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
-    inputManager->RegisterKeybind("CameraFreeLook Right", GLFW_KEY_D, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
-    inputManager->RegisterKeybind("CameraFreeLook Up", GLFW_KEY_SPACE, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
-    inputManager->RegisterKeybind("CameraFreeLook Down", GLFW_KEY_LEFT_CONTROL, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
-
-    inputManager->RegisterKeybind("CameraFreeLook ToggleMouseCapture", GLFW_KEY_TAB, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    _forwardKeybind = inputManager->RegisterKeybind("CameraFreeLook Forward", GLFW_KEY_W, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+    _backwardKeybind = inputManager->RegisterKeybind("CameraFreeLook Backward", GLFW_KEY_S, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+    _leftKeybind = inputManager->RegisterKeybind("CameraFreeLook Left", GLFW_KEY_A, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+    _rightKeybind = inputManager->RegisterKeybind("CameraFreeLook Right", GLFW_KEY_D, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+    _upKeybind = inputManager->RegisterKeybind("CameraFreeLook Up", GLFW_KEY_SPACE, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+    _downKeybind = inputManager->RegisterKeybind("CameraFreeLook Down", GLFW_KEY_LEFT_CONTROL, KEYBIND_ACTION_PRESS | KEYBIND_ACTION_REPEAT, KEYBIND_MOD_ANY);
+
+    inputManager->RegisterKeybind("CameraFreeLook ToggleMouseCapture", GLFW_KEY_TAB, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
@@ -44,7 +44,7 @@ void CameraFreeLook::Init()
 
         return true;
     });
-    inputManager->RegisterKeybind("CameraFreeLook Right Mouseclick", GLFW_MOUSE_BUTTON_2, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this, inputManager](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("CameraFreeLook Right Mouseclick", GLFW_MOUSE_BUTTON_2, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this, inputManager](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
@@ -81,7 +81,7 @@ void CameraFreeLook::Init()
         }
     });
 
-    inputManager->RegisterKeybind("IncreaseCameraSpeed", GLFW_KEY_PAGE_UP, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("IncreaseCameraSpeed", GLFW_KEY_PAGE_UP, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
@@ -89,7 +89,7 @@ void CameraFreeLook::Init()
         _movementSpeed += 10.0f;
         return true;
     });
-    inputManager->RegisterKeybind("DecreaseCameraSpeed", GLFW_KEY_PAGE_DOWN, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("DecreaseCameraSpeed", GLFW_KEY_PAGE_DOWN, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
@@ -98,7 +98,7 @@ void CameraFreeLook::Init()
         return true;
     });
     
-    inputManager->RegisterKeybind("SaveCameraDefault", GLFW_KEY_F9, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("SaveCameraDefault", GLFW_KEY_F9, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
@@ -106,7 +106,7 @@ void CameraFreeLook::Init()
         SaveToFile("freelook.cameradata");
         return true;
     });  
-    inputManager->RegisterKeybind("LoadCameraDefault", GLFW_KEY_F10, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    inputManager->RegisterKeybind("LoadCameraDefault", GLFW_KEY_F10, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
@@ -137,27 +137,27 @@ void CameraFreeLook::Update(f32 deltaTime, float fovInDegrees, float aspectRatio
     InputManager* inputManager = ServiceLocator::GetInputManager();
 
     // Movement
-    if (inputManager->IsKeyPressed("CameraFreeLook Forward"_h))
+    if (inputManager->IsKeyPressed(_forwardKeybind))
     {
         _position += _front * _movementSpeed * deltaTime;
     }
-    if (inputManager->IsKeyPressed("CameraFreeLook Backward"_h))
+    if (inputManager->IsKeyPressed(_backwardKeybind))
     {
         _position -= _front * _movementSpeed * deltaTime;
     }
-    if (inputManager->IsKeyPressed("CameraFreeLook Left"_h))
+    if (inputManager->IsKeyPressed(_leftKeybind))
     {
         _position += _left * _movementSpeed * deltaTime;
     }
-    if (inputManager->IsKeyPressed("CameraFreeLook Right"_h))
+    if (inputManager->IsKeyPressed(_rightKeybind))
     {
         _position -= _left * _movementSpeed * deltaTime;
     }
-    if (inputManager->IsKeyPressed("CameraFreeLook Up"_h))
+    if (inputManager->IsKeyPressed(_upKeybind))
     {
         _position += worldUp * _movementSpeed * deltaTime;
     }
-    if (inputManager->IsKeyPressed("CameraFreeLook Down"_h))
+    if (inputManager->IsKeyPressed(_downKeybind))
     {
         _position -= worldUp * _movementSpeed * deltaTime;
     }
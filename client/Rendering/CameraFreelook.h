@@ -1,5 +1,6 @@
 #pragma once
 #include <NovusTypes.h>
+#include <Keybind.h>
 #include "Camera.h"
 
 class CameraFreeLook : public Camera
@@ -11,4 +12,12 @@ public:
     void Enabled() override;
     void Disabled() override;
     void Update(f32 deltaTime, float fovInDegrees, float aspectRatioWH) override;
+
+private:
+    KeybindHandle _forwardKeybind = KeybindHandle::Invalid;
+    KeybindHandle _backwardKeybind = KeybindHandle::Invalid;
+    KeybindHandle _leftKeybind = KeybindHandle::Invalid;
+    KeybindHandle _rightKeybind = KeybindHandle::Invalid;
+    KeybindHandle _upKeybind = KeybindHandle::Invalid;
+    KeybindHandle _downKeybind = KeybindHandle::Invalid;
 };
\ No newline at end of file
@@ -69,12 +69,12 @@ void CameraOrbital::Init()
             _prevMousePosition = mousePosition;
         }
     });
-    inputManager->RegisterKeybind("CameraOrbital Left Mouseclick", GLFW_MOUSE_BUTTON_1, KEYBIND_ACTION_CLICK, KEYBIND_MOD_ANY, [this, inputManager](Window* window, std::shared_ptr<Keybind> keybind)
+    _leftMouseKeybind = inputManager->RegisterKeybind("CameraOrbital Left Mouseclick", GLFW_MOUSE_BUTTON_1, KEYBIND_ACTION_CLICK, KEYBIND_MOD_ANY, [this, inputManager](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
 
-        if (inputManager->IsKeyPressed("CameraOrbital Right Mouseclick"_h))
+        if (inputManager->IsKeyPressed(_rightMouseKeybind))
             return false;
 
         if (keybind->state == GLFW_PRESS)
@@ -91,12 +91,12 @@ void CameraOrbital::Init()
         _captureMouse = !_captureMouse;
         return true;
     });
-    inputManager->RegisterKeybind("CameraOrbital Right Mouseclick", GLFW_MOUSE_BUTTON_2, KEYBIND_ACTION_CLICK, KEYBIND_MOD_ANY, [this, inputManager](Window* window, std::shared_ptr<Keybind> keybind)
+    _rightMouseKeybind = inputManager->RegisterKeybind("CameraOrbital Right Mouseclick", GLFW_MOUSE_BUTTON_2, KEYBIND_ACTION_CLICK, KEYBIND_MOD_ANY, [this, inputManager](Window* window, Keybind* keybind)
     {
         if (!IsActive())
             return false;
 
-        if (inputManager->IsKeyPressed("CameraOrbital Left Mouseclick"_h))
+        if (inputManager->IsKeyPressed(_leftMouseKeybind))
             return false;
 
         if (keybind->state == GLFW_PRESS)
@@ -1,5 +1,6 @@
 #pragma once
 #include <NovusTypes.h>
+#include <Keybind.h>
 #include "Camera.h"
 
 class CameraOrbital : public Camera
@@ -18,7 +19,13 @@ public:
     void SetDistance(f32 distance) { _distance = distance; }
     f32 GetDistance() { return _distance; }
 
+    KeybindHandle GetLeftMouseKeybind() const { return _leftMouseKeybind; }
+    KeybindHandle GetRightMouseKeybind() const { return _rightMouseKeybind; }
+
 private:
     u8 _zoomLevel = 1;
     f32 _distance = 15;
+
+    KeybindHandle _leftMouseKeybind = KeybindHandle::Invalid;
+    KeybindHandle _rightMouseKeybind = KeybindHandle::Invalid;
 };
\ No newline at end of file
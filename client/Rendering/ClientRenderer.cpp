@@ -6,6 +6,7 @@
 #include "../Utils/ServiceLocator.h"
 
 #include <Renderer/Renderer.h>
+#include <Renderer/FrameAllocator.h>
 #include <Renderer/Renderers/Vulkan/RendererVK.h>
 #include <Window/Window.h>
 #include <InputManager.h>
@@ -78,6 +79,21 @@ ClientRenderer::ClientRenderer()
     debugTexture.path = "Data/textures/DebugTexture.bmp";
     
     _renderer = new Renderer::RendererVK(debugTexture);
+
+#ifdef NC_SHADER_SOURCE_DIR
+    Renderer::ShaderCacheDesc shaderCacheDesc;
+    shaderCacheDesc.sourceDirectory = NC_SHADER_SOURCE_DIR;
+    shaderCacheDesc.cacheDirectory = "Data/cache/shaders";
+    shaderCacheDesc.compilerPath = NC_SHADER_COOKER_PATH;
+    _renderer->InitShaderCache(shaderCacheDesc);
+
+    _inputManager->RegisterKeybind("ReloadShaders", GLFW_KEY_F4, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
+    {
+        _renderer->ReloadShaders();
+        return true;
+    });
+#endif
+
     _renderer->InitWindow(_window);
 
     InitImgui();
@@ -126,6 +142,7 @@ void ClientRenderer::Render()
     Renderer::RenderGraph renderGraph = _renderer->CreateRenderGraph(renderGraphDesc);
 
     _renderer->FlipFrame(_frameIndex);
+    renderGraph.MarkFrameStart(_frameIndex);
 
     // Update the view matrix to match the new camera position
     _viewConstantBuffer->resource.viewProjectionMatrix = camera->GetViewProjectionMatrix();
@@ -149,10 +166,6 @@ void ClientRenderer::Render()
         },
             [&](DepthPrepassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList) // Execute
         {
-            commandList.MarkFrameStart(_frameIndex);
-
-            GPU_SCOPED_PROFILER_ZONE(commandList, DepthPrepass);
-
             Renderer::GraphicsPipelineDesc pipelineDesc;
             resources.InitializePipelineDesc(pipelineDesc);
 
@@ -243,8 +256,6 @@ void ClientRenderer::Render()
         },
             [&](MainPassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList) // Execute
         {
-            GPU_SCOPED_PROFILER_ZONE(commandList, MainPass);
-
             Renderer::GraphicsPipelineDesc pipelineDesc;
             resources.InitializePipelineDesc(pipelineDesc);
 
@@ -343,6 +354,14 @@ void ClientRenderer::Render()
         _renderer->Present(_window, _mainColor, _sceneRenderedSemaphore); // Wait for the frame to render
     }
 
+#if NC_RENDER_PROFILING
+    // Everything this frame needed from the frame allocator has been allocated by now
+    const Renderer::FrameAllocatorStats& frameAllocatorStats = _frameAllocator->GetStats();
+    TracyPlot("Frame Allocator Bytes", static_cast<i64>(frameAllocatorStats.allocatedBytes));
+    TracyPlot("Frame Allocator Overflow Bytes", static_cast<i64>(frameAllocatorStats.overflowBytes));
+#endif
+    _renderer->EndFrameStats();
+
     // Flip the frameIndex between 0 and 1
     _frameIndex = !_frameIndex;
 }
@@ -411,7 +430,7 @@ void ClientRenderer::CreatePermanentResources()
     _drawDescriptorSet.SetBackend(_renderer->CreateDescriptorSetBackend());
 
     // Frame allocator, this is a fast allocator for data that is only needed this frame
-    _frameAllocator = new Memory::StackAllocator(FRAME_ALLOCATOR_SIZE);
+    _frameAllocator = new Renderer::FrameAllocator(FRAME_ALLOCATOR_SIZE);
     _frameAllocator->Init();
 
     _sceneRenderedSemaphore = _renderer->CreateGPUSemaphore();
@@ -16,11 +16,7 @@
 namespace Renderer
 {
     class Renderer;
-}
-
-namespace Memory
-{
-    class StackAllocator;
+    class FrameAllocator;
 }
 
 class Window;
@@ -55,7 +51,7 @@ private:
     Window* _window;
     InputManager* _inputManager;
     Renderer::Renderer* _renderer;
-    Memory::StackAllocator* _frameAllocator;
+    Renderer::FrameAllocator* _frameAllocator;
 
     u8 _frameIndex = 0;
 
@@ -90,53 +90,57 @@ void DebugRenderer::Add3DPass(Renderer::RenderGraph* renderGraph, Renderer::Buff
 		},
 		[=](TerrainDepthPrepassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList) // Execute
 		{
-			GPU_SCOPED_PROFILER_ZONE(commandList, DebugRender3D);
+			Flush(&commandList);
 
-			Renderer::GraphicsPipelineDesc pipelineDesc;
-			resources.InitializePipelineDesc(pipelineDesc);
+			// The render targets outlive us, so the pipeline is created on the first frame and kept after that
+			if (_pipeline3D == Renderer::GraphicsPipelineID::Invalid())
+			{
+				Renderer::GraphicsPipelineDesc pipelineDesc;
+				resources.InitializePipelineDesc(pipelineDesc);
 
-			Flush(&commandList);
+				// Shader
+				Renderer::VertexShaderDesc vertexShaderDesc;
+				vertexShaderDesc.path = "Data/shaders/debug.vs.hlsl.spv";
 
-			// Shader
-			Renderer::VertexShaderDesc vertexShaderDesc;
-			vertexShaderDesc.path = "Data/shaders/debug.vs.hlsl.spv";
+				Renderer::PixelShaderDesc pixelShaderDesc;
+				pixelShaderDesc.path = "Data/shaders/debug.ps.hlsl.spv";
 
-			Renderer::PixelShaderDesc pixelShaderDesc;
-			pixelShaderDesc.path = "Data/shaders/debug.ps.hlsl.spv";
+				pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
+				pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
 
-			pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
-			pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
+				// Input layouts TODO: Improve on this, if I set state 0 and 3 it won't work etc... Maybe responsibility for this should be moved to ModelHandler and the cooker?
+				pipelineDesc.states.inputLayouts[0].enabled = true;
+				pipelineDesc.states.inputLayouts[0].SetName("Position");
+				pipelineDesc.states.inputLayouts[0].format = Renderer::InputFormat::INPUT_FORMAT_R32G32B32_FLOAT;
+				pipelineDesc.states.inputLayouts[0].inputClassification = Renderer::InputClassification::INPUT_CLASSIFICATION_PER_VERTEX;
+				pipelineDesc.states.inputLayouts[0].alignedByteOffset = 0;
 
-			// Input layouts TODO: Improve on this, if I set state 0 and 3 it won't work etc... Maybe responsibility for this should be moved to ModelHandler and the cooker?
-			pipelineDesc.states.inputLayouts[0].enabled = true;
-			pipelineDesc.states.inputLayouts[0].SetName("Position");
-			pipelineDesc.states.inputLayouts[0].format = Renderer::InputFormat::INPUT_FORMAT_R32G32B32_FLOAT;
-			pipelineDesc.states.inputLayouts[0].inputClassification = Renderer::InputClassification::INPUT_CLASSIFICATION_PER_VERTEX;
-			pipelineDesc.states.inputLayouts[0].alignedByteOffset = 0;
+				pipelineDesc.states.inputLayouts[1].enabled = true;
+				pipelineDesc.states.inputLayouts[1].SetName("Color");
+				pipelineDesc.states.inputLayouts[1].format = Renderer::InputFormat::INPUT_FORMAT_R8G8B8A8_UNORM;
+				pipelineDesc.states.inputLayouts[1].inputClassification = Renderer::InputClassification::INPUT_CLASSIFICATION_PER_VERTEX;
+				pipelineDesc.states.inputLayouts[1].alignedByteOffset = 12;
 
-			pipelineDesc.states.inputLayouts[1].enabled = true;
-			pipelineDesc.states.inputLayouts[1].SetName("Color");
-			pipelineDesc.states.inputLayouts[1].format = Renderer::InputFormat::INPUT_FORMAT_R8G8B8A8_UNORM;
-			pipelineDesc.states.inputLayouts[1].inputClassification = Renderer::InputClassification::INPUT_CLASSIFICATION_PER_VERTEX;
-			pipelineDesc.states.inputLayouts[1].alignedByteOffset = 12;
+				pipelineDesc.states.primitiveTopology = Renderer::PrimitiveTopology::Lines;
 
-			pipelineDesc.states.primitiveTopology = Renderer::PrimitiveTopology::Lines;
+				// Depth state
+				pipelineDesc.states.depthStencilState.depthEnable = true;
+				pipelineDesc.states.depthStencilState.depthWriteEnable = false;
+				pipelineDesc.states.depthStencilState.depthFunc = Renderer::ComparisonFunc::COMPARISON_FUNC_LESS;
 
-			// Depth state
-			pipelineDesc.states.depthStencilState.depthEnable = true;
-			pipelineDesc.states.depthStencilState.depthWriteEnable = false;
-			pipelineDesc.states.depthStencilState.depthFunc = Renderer::ComparisonFunc::COMPARISON_FUNC_LESS;
+				// Rasterizer state
+				pipelineDesc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
+				pipelineDesc.states.rasterizerState.frontFaceMode = Renderer::FrontFaceState::FRONT_FACE_STATE_COUNTERCLOCKWISE;
 
-			// Rasterizer state
-			pipelineDesc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
-			pipelineDesc.states.rasterizerState.frontFaceMode = Renderer::FrontFaceState::FRONT_FACE_STATE_COUNTERCLOCKWISE;
+				pipelineDesc.renderTargets[0] = data.mainColor;
 
-			pipelineDesc.renderTargets[0] = data.mainColor;
+				pipelineDesc.depthStencil = data.mainDepth;
 
-			pipelineDesc.depthStencil = data.mainDepth;
+				_pipeline3D = _renderer->CreatePipeline(pipelineDesc);
+			}
 
 			// Set pipeline
-			Renderer::GraphicsPipelineID pipeline = _renderer->CreatePipeline(pipelineDesc); // This will compile the pipeline and return the ID, or just return ID of cached pipeline
+			Renderer::GraphicsPipelineID pipeline = _pipeline3D;
 			commandList.BeginPipeline(pipeline);
 
 			commandList.SetVertexBuffer(0, _debugVertexBuffer);
@@ -7,6 +7,7 @@
 #include <Renderer/Descriptors/BufferDesc.h>
 #include <Renderer/Descriptors/ImageDesc.h>
 #include <Renderer/Descriptors/DepthImageDesc.h>
+#include <Renderer/Descriptors/GraphicsPipelineDesc.h>
 
 #include <vector>
 
@@ -58,6 +59,7 @@ private:
 	uint32_t _debugVertexCount[DBG_VERTEX_BUFFER_COUNT];
 
 	Renderer::BufferID _debugVertexBuffer;
+	Renderer::GraphicsPipelineID _pipeline3D = Renderer::GraphicsPipelineID::Invalid();
 
 	Renderer::DescriptorSet _passDescriptorSet;
 };
\ No newline at end of file
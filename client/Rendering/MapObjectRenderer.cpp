@@ -42,8 +42,6 @@ void MapObjectRenderer::AddMapObjectPass(Renderer::RenderGraph* renderGraph, Ren
         },
             [=](MapObjectPassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList) // Execute
         {
-            GPU_SCOPED_PROFILER_ZONE(commandList, MapObjectPass);
-
             Renderer::GraphicsPipelineDesc pipelineDesc;
             resources.InitializePipelineDesc(pipelineDesc);
 
@@ -157,10 +155,19 @@ void MapObjectRenderer::LoadMapObjects(const Terrain::Chunk& chunk, StringTable&
     }
 }
 
+void MapObjectRenderer::LogQuantizationStats() const
+{
+    if (!_quantizeVertices || _quantizationStats.numQuantizedMeshes + _quantizationStats.numFloatMeshes == 0)
+        return;
+
+    NC_LOG_MESSAGE("Map object vertices: %u meshes quantized, %u kept as float, %.2f KB saved, max position error %f", _quantizationStats.numQuantizedMeshes, _quantizationStats.numFloatMeshes, _quantizationStats.GetSavedBytes() / 1024.0, _quantizationStats.maxPositionError);
+}
+
 void MapObjectRenderer::Clear()
 {
     _loadedMapObjects.clear();
     _nameHashToIndexMap.clear();
+    _quantizationStats = MapObjectVertexQuantizer::QuantizationStats();
 }
 
 void MapObjectRenderer::CreatePermanentResources()
@@ -539,111 +546,55 @@ bool MapObjectRenderer::LoadMapObject(u32 nameID, StringTable& stringTable, u32&
             }
 
             // -- Create Vertex Buffers --
+            MapObjectVertexQuantizer::QuantizedVertices quantized;
+            if (_quantizeVertices && MapObjectVertexQuantizer::Quantize(mapObject, _maxPositionError, quantized, _quantizationStats))
             {
-                const size_t bufferSize = numVertices * sizeof(vec3);
-
-                // Create buffer
-                Renderer::BufferDesc desc;
-                desc.name = "VertexPositions";
-                desc.size = bufferSize;
-                desc.usage = Renderer::BufferUsage::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_DESTINATION;
-                desc.cpuAccess = Renderer::BufferCPUAccess::None;
-
-                mesh.vertexPositionsBuffer = _renderer->CreateBuffer(desc);
+                mesh.vertexFormat = MapObjectVertexQuantizer::VERTEX_FORMAT_QUANTIZED;
 
-                // Create staging buffer
-                desc.name = "VertexPositionsStaging";
-                desc.size = bufferSize;
-                desc.usage = Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_SOURCE;
-                desc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
-
-                Renderer::BufferID stagingBuffer = _renderer->CreateBuffer(desc);
-
-                // Upload to staging buffer
-                void* dst = _renderer->MapBuffer(stagingBuffer);
-                memcpy(dst, mapObject.vertexPositions.data(), bufferSize);
-                _renderer->UnmapBuffer(stagingBuffer);
+                std::vector<u8> positions(sizeof(MapObjectVertexQuantizer::MeshVertexHeader) + (quantized.positions.size() * sizeof(u16)));
+                memcpy(positions.data(), &quantized.header, sizeof(MapObjectVertexQuantizer::MeshVertexHeader));
+                memcpy(positions.data() + sizeof(MapObjectVertexQuantizer::MeshVertexHeader), quantized.positions.data(), quantized.positions.size() * sizeof(u16));
 
-                // Queue destroy staging buffer
-                _renderer->QueueDestroyBuffer(stagingBuffer);
-                // Copy from staging buffer to buffer
-                _renderer->CopyBuffer(mesh.vertexPositionsBuffer, 0, stagingBuffer, 0, bufferSize);
+                mesh.vertexPositionsBuffer = CreateVertexBuffer("VertexPositions", positions.data(), positions.size());
+                mesh.vertexNormalsBuffer = CreateVertexBuffer("VertexNormals", quantized.normals.data(), quantized.normals.size() * sizeof(u32));
+                mesh.vertexUVsBuffer = CreateVertexBuffer("VertexUVs", quantized.uvs.data(), quantized.uvs.size() * sizeof(u32));
             }
-
+            else
             {
-                const size_t bufferSize = numVertices * sizeof(vec3);
-
-                // Create buffer
-                Renderer::BufferDesc desc;
-                desc.name = "VertexNormals";
-                desc.size = bufferSize;
-                desc.usage = Renderer::BufferUsage::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_DESTINATION;
-                desc.cpuAccess = Renderer::BufferCPUAccess::None;
-
-                mesh.vertexNormalsBuffer = _renderer->CreateBuffer(desc);
-
-                // Create staging buffer
-                desc.name = "VertexPositionsStaging";
-                desc.size = bufferSize;
-                desc.usage = Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_SOURCE;
-                desc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
-
-                Renderer::BufferID stagingBuffer = _renderer->CreateBuffer(desc);
-
-                // Upload to staging buffer
-                void* dst = _renderer->MapBuffer(stagingBuffer);
-                memcpy(dst, mapObject.vertexPositions.data(), bufferSize);
-                _renderer->UnmapBuffer(stagingBuffer);
-
-                // Queue destroy staging buffer
-                _renderer->QueueDestroyBuffer(stagingBuffer);
-                // Copy from staging buffer to buffer
-                _renderer->CopyBuffer(mesh.vertexNormalsBuffer, 0, stagingBuffer, 0, bufferSize);
-            }
-
-            {
-                constexpr size_t maxNumUVsets = 2;
-                const size_t bufferSize = numVertices * maxNumUVsets * sizeof(vec2) ;
-
-                // Create buffer
-                Renderer::BufferDesc desc;
-                desc.name = "VertexUVs";
-                desc.size = bufferSize;
-                desc.usage = Renderer::BufferUsage::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_DESTINATION;
-                desc.cpuAccess = Renderer::BufferCPUAccess::None;
-
-                mesh.vertexUVsBuffer = _renderer->CreateBuffer(desc);
-
-                // Create staging buffer
-                desc.name = "VertexPositionsStaging";
-                desc.size = bufferSize;
-                desc.usage = Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_SOURCE;
-                desc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
+                if (!_quantizeVertices)
+                {
+                    const u64 floatBytes = sizeof(MapObjectVertexQuantizer::MeshVertexHeader) + (numVertices * MapObjectVertexQuantizer::FLOAT_VERTEX_SIZE);
+                    _quantizationStats.floatBytes += floatBytes;
+                    _quantizationStats.uploadedBytes += floatBytes;
+                    _quantizationStats.numFloatMeshes++;
+                }
 
-                Renderer::BufferID stagingBuffer = _renderer->CreateBuffer(desc);
+                mesh.vertexFormat = MapObjectVertexQuantizer::VERTEX_FORMAT_FLOAT;
 
-                // Upload to staging buffer
-                vec2* dst = static_cast<vec2*>(_renderer->MapBuffer(stagingBuffer));
+                // The float layout gets a header as well so mapObject.vs.hlsl can tell the two apart
+                MapObjectVertexQuantizer::MeshVertexHeader header;
+                header.vertexFormat = MapObjectVertexQuantizer::VERTEX_FORMAT_FLOAT;
 
-                memset(dst, 0, bufferSize);
+                std::vector<u8> positions(sizeof(MapObjectVertexQuantizer::MeshVertexHeader) + (numVertices * sizeof(vec3)));
+                memcpy(positions.data(), &header, sizeof(MapObjectVertexQuantizer::MeshVertexHeader));
+                memcpy(positions.data() + sizeof(MapObjectVertexQuantizer::MeshVertexHeader), mapObject.vertexPositions.data(), numVertices * sizeof(vec3));
 
-                for (u32 uvSet = 0; uvSet < mesh.numUVSets; uvSet++)
+                // UV sets are interleaved, sets the MapObject doesn't have are zero
+                std::vector<vec2> uvs(numVertices * MapObjectVertexQuantizer::MAX_UV_SETS, vec2(0.0f));
+                const u32 numUVSets = glm::min(mesh.numUVSets, MapObjectVertexQuantizer::MAX_UV_SETS);
+                for (u32 uvSet = 0; uvSet < numUVSets; uvSet++)
                 {
                     size_t offset = uvSet;
                     for (u32 vertexID = 0; vertexID < numVertices; vertexID++)
                     {
-                        dst[offset] = mapObject.uvSets[uvSet].vertexUVs[vertexID];
-                        offset += maxNumUVsets;
+                        uvs[offset] = mapObject.uvSets[uvSet].vertexUVs[vertexID];
+                        offset += MapObjectVertexQuantizer::MAX_UV_SETS;
                     }
                 }
 
-                //memcpy(dst, mapObject.vertexUVs.data(), bufferSize);
-                _renderer->UnmapBuffer(stagingBuffer);
-
-                // Queue destroy staging buffer
-                _renderer->QueueDestroyBuffer(stagingBuffer);
-                // Copy from staging buffer to buffer
-                _renderer->CopyBuffer(mesh.vertexUVsBuffer, 0, stagingBuffer, 0, bufferSize);
+                mesh.vertexPositionsBuffer = CreateVertexBuffer("VertexPositions", positions.data(), positions.size());
+                mesh.vertexNormalsBuffer = CreateVertexBuffer("VertexNormals", mapObject.vertexNormals.data(), numVertices * sizeof(vec3));
+                mesh.vertexUVsBuffer = CreateVertexBuffer("VertexUVs", uvs.data(), uvs.size() * sizeof(vec2));
             }
         }
     }
@@ -651,3 +602,34 @@ bool MapObjectRenderer::LoadMapObject(u32 nameID, StringTable& stringTable, u32&
     objectID = nextID;
     return true;
 }
+
+Renderer::BufferID MapObjectRenderer::CreateVertexBuffer(const std::string& name, const void* data, size_t bufferSize)
+{
+    // Create buffer
+    Renderer::BufferDesc desc;
+    desc.name = name;
+    desc.size = bufferSize;
+    desc.usage = Renderer::BufferUsage::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_DESTINATION;
+    desc.cpuAccess = Renderer::BufferCPUAccess::None;
+
+    Renderer::BufferID buffer = _renderer->CreateBuffer(desc);
+
+    // Create staging buffer
+    desc.name = name + "Staging";
+    desc.usage = Renderer::BufferUsage::BUFFER_USAGE_TRANSFER_SOURCE;
+    desc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
+
+    Renderer::BufferID stagingBuffer = _renderer->CreateBuffer(desc);
+
+    // Upload to staging buffer
+    void* dst = _renderer->MapBuffer(stagingBuffer);
+    memcpy(dst, data, bufferSize);
+    _renderer->UnmapBuffer(stagingBuffer);
+
+    // Queue destroy staging buffer
+    _renderer->QueueDestroyBuffer(stagingBuffer);
+    // Copy from staging buffer to buffer
+    _renderer->CopyBuffer(buffer, 0, stagingBuffer, 0, bufferSize);
+
+    return buffer;
+}
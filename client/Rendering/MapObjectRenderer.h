@@ -10,6 +10,7 @@
 #include <Renderer/Descriptors/BufferDesc.h>
 
 #include "ViewConstantBuffer.h"
+#include "MapObjectVertexQuantizer.h"
 
 namespace Renderer
 {
@@ -37,9 +38,18 @@ public:
     void LoadMapObjects(const Terrain::Chunk& chunk, StringTable& stringTable);
     void Clear();
 
+    // Opt-in, map objects loaded after this is turned on get the compressed vertex layout as long as it stays within maxPositionError yards
+    void SetQuantizeVertices(bool enabled, f32 maxPositionError = 0.01f) { _quantizeVertices = enabled; _maxPositionError = maxPositionError; }
+    bool GetQuantizeVertices() const { return _quantizeVertices; }
+    const MapObjectVertexQuantizer::QuantizationStats& GetQuantizationStats() const { return _quantizationStats; }
+
+    // Called once every map object of a map is loaded, logs nothing unless quantization is enabled
+    void LogQuantizationStats() const;
+
 private:
     void CreatePermanentResources();
     bool LoadMapObject(u32 nameID, StringTable& stringTable, u32& objectID);
+    Renderer::BufferID CreateVertexBuffer(const std::string& name, const void* data, size_t bufferSize);
 
     struct Material
     {
@@ -61,7 +71,8 @@ private:
         std::vector<u32> materialIDs;
 
         // Per mesh data
-        Renderer::BufferID vertexPositionsBuffer;
+        u32 vertexFormat = MapObjectVertexQuantizer::VERTEX_FORMAT_FLOAT;
+        Renderer::BufferID vertexPositionsBuffer; // Starts with a MapObjectVertexQuantizer::MeshVertexHeader
         Renderer::BufferID vertexNormalsBuffer;
 
         u32 numUVSets;
@@ -92,4 +103,8 @@ private:
     robin_hood::unordered_map<u32, u32> _nameHashToIndexMap;
 
     Renderer::TextureArrayID _mapObjectTextures;
+
+    bool _quantizeVertices = false;
+    f32 _maxPositionError = 0.01f;
+    MapObjectVertexQuantizer::QuantizationStats _quantizationStats;
 };
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "MapObjectVertexQuantizer.h"
+#include <glm/gtc/packing.hpp>
+
+#include "../Gameplay/Map/MapObject.h"
+
+namespace MapObjectVertexQuantizer
+{
+    constexpr f32 MAX_U16 = 65535.0f;
+
+    u32 EncodeNormal(const vec3& normal)
+    {
+        const f32 length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+        if (length <= 0.0f)
+            return glm::packSnorm2x16(vec2(0.0f));
+
+        // Project onto the octahedron and fold the lower half over the upper one
+        vec3 n = normal / length;
+        vec2 encoded = vec2(n.x, n.y);
+
+        if (n.z < 0.0f)
+        {
+            const vec2 signs = vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+            encoded = (vec2(1.0f) - glm::abs(vec2(n.y, n.x))) * signs;
+        }
+
+        return glm::packSnorm2x16(encoded);
+    }
+
+    vec3 DecodeNormal(u32 encoded)
+    {
+        const vec2 e = glm::unpackSnorm2x16(encoded);
+
+        vec3 n = vec3(e.x, e.y, 1.0f - glm::abs(e.x) - glm::abs(e.y));
+        const f32 t = glm::max(-n.z, 0.0f);
+        n.x += n.x >= 0.0f ? -t : t;
+        n.y += n.y >= 0.0f ? -t : t;
+
+        return glm::normalize(n);
+    }
+
+    f32 GetAngleDegrees(const vec3& a, const vec3& b)
+    {
+        // acos of the dot product can't resolve angles this small in 32 bit floats
+        return glm::degrees(glm::atan(glm::length(glm::cross(a, b)), glm::dot(a, b)));
+    }
+
+    vec3 DecodePosition(const MeshVertexHeader& header, const u16* position)
+    {
+        // Same math as mapObject.vs.hlsl so the measured error is the error on screen
+        const vec3 quantized = vec3(position[0], position[1], position[2]);
+        return header.positionMin + quantized * (header.positionExtent / MAX_U16);
+    }
+
+    vec2 DecodeUV(u32 encoded)
+    {
+        return glm::unpackHalf2x16(encoded);
+    }
+
+    bool Quantize(const Terrain::MapObject& mapObject, f32 maxPositionError, QuantizedVertices& quantized, QuantizationStats& stats)
+    {
+        const size_t numVertices = mapObject.vertexPositions.size();
+        const u64 floatBytes = sizeof(MeshVertexHeader) + (numVertices * FLOAT_VERTEX_SIZE);
+
+        stats.floatBytes += floatBytes;
+
+        if (numVertices == 0)
+        {
+            stats.uploadedBytes += floatBytes;
+            stats.numFloatMeshes++;
+            return false;
+        }
+
+        vec3 positionMin = mapObject.vertexPositions[0];
+        vec3 positionMax = mapObject.vertexPositions[0];
+        for (const vec3& position : mapObject.vertexPositions)
+        {
+            positionMin = glm::min(positionMin, position);
+            positionMax = glm::max(positionMax, position);
+        }
+
+        // Rounding to the nearest step is off by at most half a step on every axis
+        const vec3 positionExtent = positionMax - positionMin;
+        const f32 positionErrorBound = glm::length(positionExtent / MAX_U16 * 0.5f);
+
+        if (positionErrorBound > maxPositionError)
+        {
+            stats.uploadedBytes += floatBytes;
+            stats.numFloatMeshes++;
+            return false;
+        }
+
+        MeshVertexHeader header;
+        header.positionMin = positionMin;
+        header.positionExtent = positionExtent;
+        header.vertexFormat = VERTEX_FORMAT_QUANTIZED;
+
+        std::vector<u16> positions(numVertices * 4, 0);
+        std::vector<u32> normals(numVertices, 0);
+        std::vector<u32> uvs(numVertices * MAX_UV_SETS, 0);
+
+        for (size_t i = 0; i < numVertices; i++)
+        {
+            const vec3& position = mapObject.vertexPositions[i];
+            u16* quantizedPosition = &positions[i * 4];
+
+            for (u32 axis = 0; axis < 3; axis++)
+            {
+                const f32 normalized = positionExtent[axis] > 0.0f ? (position[axis] - positionMin[axis]) / positionExtent[axis] : 0.0f;
+                quantizedPosition[axis] = static_cast<u16>(glm::round(glm::clamp(normalized, 0.0f, 1.0f) * MAX_U16));
+            }
+
+            stats.maxPositionError = glm::max(stats.maxPositionError, glm::length(DecodePosition(header, quantizedPosition) - position));
+
+            if (i < mapObject.vertexNormals.size())
+            {
+                const vec3& normal = mapObject.vertexNormals[i];
+                normals[i] = EncodeNormal(normal);
+
+                if (glm::length(normal) > 0.0f)
+                {
+                    stats.maxNormalError = glm::max(stats.maxNormalError, GetAngleDegrees(normal, DecodeNormal(normals[i])));
+                }
+            }
+
+            const u32 numUVSets = glm::min(static_cast<u32>(mapObject.uvSets.size()), MAX_UV_SETS);
+            for (u32 uvSet = 0; uvSet < numUVSets; uvSet++)
+            {
+                const vec2& uv = mapObject.uvSets[uvSet].vertexUVs[i];
+                u32& encodedUV = uvs[i * MAX_UV_SETS + uvSet];
+                encodedUV = glm::packHalf2x16(uv);
+
+                const vec2 uvError = glm::abs(DecodeUV(encodedUV) - uv);
+                stats.maxUVError = glm::max(stats.maxUVError, glm::max(uvError.x, uvError.y));
+            }
+        }
+
+        quantized.header = header;
+        quantized.positions.swap(positions);
+        quantized.normals.swap(normals);
+        quantized.uvs.swap(uvs);
+
+        stats.uploadedBytes += sizeof(MeshVertexHeader) + (numVertices * QUANTIZED_VERTEX_SIZE);
+        stats.numQuantizedMeshes++;
+        return true;
+    }
+}
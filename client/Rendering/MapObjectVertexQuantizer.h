@@ -0,0 +1,70 @@
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+
+namespace Terrain
+{
+    struct MapObject;
+}
+
+// Packs MapObject vertices into the compressed layout mapObject.vs.hlsl decodes, positions become 16 bit unorm relative to the mesh AABB,
+// normals octahedral encoded into two 16 bit snorms and UVs half precision. That is 20 bytes per vertex instead of 40
+namespace MapObjectVertexQuantizer
+{
+    constexpr u32 MAX_UV_SETS = 2;
+
+    enum VertexFormat : u32
+    {
+        VERTEX_FORMAT_FLOAT = 0,
+        VERTEX_FORMAT_QUANTIZED = 1
+    };
+
+    // Sits at the start of every mesh's position buffer so the vertex shader knows how to decode the vertices after it, has to match mapObject.vs.hlsl
+    struct MeshVertexHeader
+    {
+        vec3 positionMin = vec3(0.0f);
+        u32 vertexFormat = VERTEX_FORMAT_FLOAT;
+        vec3 positionExtent = vec3(0.0f);
+        u32 padding = 0;
+    };
+    static_assert(sizeof(MeshVertexHeader) == 32, "MeshVertexHeader has to match the header mapObject.vs.hlsl reads");
+
+    struct QuantizedVertices
+    {
+        MeshVertexHeader header;
+
+        std::vector<u16> positions; // 4 per vertex, the 4th is padding so a vertex is a single 8 byte load
+        std::vector<u32> normals;
+        std::vector<u32> uvs; // MAX_UV_SETS per vertex, sets the MapObject doesn't have are zero
+    };
+
+    struct QuantizationStats
+    {
+        u32 numQuantizedMeshes = 0;
+        u32 numFloatMeshes = 0; // Meshes too big to quantize within the error bound, they keep the float layout
+
+        u64 floatBytes = 0; // What every mesh would have used in the float layout
+        u64 uploadedBytes = 0;
+
+        f32 maxPositionError = 0.0f; // In yards, measured by decoding what was encoded
+        f32 maxNormalError = 0.0f; // In degrees
+        f32 maxUVError = 0.0f;
+
+        u64 GetSavedBytes() const { return floatBytes - uploadedBytes; }
+    };
+
+    // Size of one vertex in every buffer together, not counting the MeshVertexHeader
+    constexpr u32 FLOAT_VERTEX_SIZE = sizeof(vec3) + sizeof(vec3) + (sizeof(vec2) * MAX_UV_SETS);
+    constexpr u32 QUANTIZED_VERTEX_SIZE = (sizeof(u16) * 4) + sizeof(u32) + (sizeof(u32) * MAX_UV_SETS);
+
+    // Returns false and leaves quantized untouched if any position would end up further than maxPositionError from where it was,
+    // the mesh should be uploaded in the float layout then. stats is added to either way
+    bool Quantize(const Terrain::MapObject& mapObject, f32 maxPositionError, QuantizedVertices& quantized, QuantizationStats& stats);
+
+    u32 EncodeNormal(const vec3& normal);
+    vec3 DecodeNormal(u32 encoded);
+    f32 GetAngleDegrees(const vec3& a, const vec3& b);
+
+    vec3 DecodePosition(const MeshVertexHeader& header, const u16* position);
+    vec2 DecodeUV(u32 encoded);
+}
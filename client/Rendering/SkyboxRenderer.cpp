@@ -51,8 +51,6 @@ void SkyboxRenderer::AddSkyboxPass(Renderer::RenderGraph* renderGraph, Renderer:
 
     const auto execute = [=](TerrainPassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList)
     {
-        GPU_SCOPED_PROFILER_ZONE(commandList, SkyboxPass);
-
 
     };
 
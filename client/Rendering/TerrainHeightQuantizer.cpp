@@ -0,0 +1,149 @@
+#include "TerrainHeightQuantizer.h"
+#include <algorithm>
+#include <cassert>
+
+#include "../Gameplay/Map/Cell.h"
+
+namespace TerrainHeightQuantizer
+{
+    constexpr f32 MAX_U8 = 255.0f;
+    constexpr f32 MAX_U16 = 65535.0f;
+
+    f32 GetMaxQuantizedValue(HeightFormat format)
+    {
+        return format == HEIGHT_FORMAT_8BIT ? MAX_U8 : MAX_U16;
+    }
+
+    u32 GetEncodedSize(HeightFormat format)
+    {
+        u32 size = Terrain::MAP_CELL_TOTAL_GRID_SIZE * sizeof(f32);
+
+        if (format == HEIGHT_FORMAT_16BIT)
+        {
+            size = Terrain::MAP_CELL_TOTAL_GRID_SIZE * sizeof(u16);
+        }
+        else if (format == HEIGHT_FORMAT_8BIT)
+        {
+            size = Terrain::MAP_CELL_TOTAL_GRID_SIZE * sizeof(u8);
+        }
+
+        return (size + 3) & ~3u;
+    }
+
+    f32 GetHeightStep(f32 maxHeightError)
+    {
+        // Rounding to the nearest step is off by at most half a step
+        return glm::exp2(glm::floor(glm::log2(maxHeightError * 2.0f)));
+    }
+
+    // Heights in whole steps, exact because dividing by a power of two only changes the exponent
+    f32 SnapToStep(f32 height, f32 heightStep)
+    {
+        return glm::round(height / heightStep);
+    }
+
+    HeightFormat ChooseFormat(const f32* heights, f32 heightStep)
+    {
+        const auto minmax = std::minmax_element(heights, heights + Terrain::MAP_CELL_TOTAL_GRID_SIZE);
+        const f32 numSteps = SnapToStep(*minmax.second, heightStep) - SnapToStep(*minmax.first, heightStep);
+
+        if (numSteps <= MAX_U8)
+            return HEIGHT_FORMAT_8BIT;
+
+        if (numSteps <= MAX_U16)
+            return HEIGHT_FORMAT_16BIT;
+
+        return HEIGHT_FORMAT_FLOAT;
+    }
+
+    f32 DecodeHeight(const CellHeightHeader& header, const u8* data, u32 vertexID)
+    {
+        const u8* cellData = data + header.dataOffset;
+
+        if (header.format == HEIGHT_FORMAT_8BIT)
+        {
+            return header.heightMin + static_cast<f32>(cellData[vertexID]) * header.heightStep;
+        }
+        else if (header.format == HEIGHT_FORMAT_16BIT)
+        {
+            return header.heightMin + static_cast<f32>(reinterpret_cast<const u16*>(cellData)[vertexID]) * header.heightStep;
+        }
+
+        return reinterpret_cast<const f32*>(cellData)[vertexID];
+    }
+
+    void DecodeCell(const CellHeightHeader& header, const u8* data, f32* heights)
+    {
+        for (u32 i = 0; i < Terrain::MAP_CELL_TOTAL_GRID_SIZE; i++)
+        {
+            heights[i] = DecodeHeight(header, data, i);
+        }
+    }
+
+    CellHeightHeader EncodeCell(const f32* heights, HeightFormat format, f32 heightStep, std::vector<u8>& data, QuantizationStats& stats)
+    {
+        assert(format == HEIGHT_FORMAT_FLOAT || heightStep > 0.0f);
+
+        const u32 encodedSize = GetEncodedSize(format);
+
+        CellHeightHeader header;
+        header.format = format;
+        header.dataOffset = static_cast<u32>(data.size());
+
+        data.resize(data.size() + encodedSize, 0);
+        u8* cellData = &data[header.dataOffset];
+
+        if (format == HEIGHT_FORMAT_FLOAT)
+        {
+            f32* cellHeights = reinterpret_cast<f32*>(cellData);
+            for (u32 i = 0; i < Terrain::MAP_CELL_TOTAL_GRID_SIZE; i++)
+            {
+                cellHeights[i] = heightStep > 0.0f ? SnapToStep(heights[i], heightStep) * heightStep : heights[i];
+            }
+
+            stats.numFloatCells++;
+        }
+        else
+        {
+            const f32 minStep = SnapToStep(*std::min_element(heights, heights + Terrain::MAP_CELL_TOTAL_GRID_SIZE), heightStep);
+            const f32 maxQuantizedValue = GetMaxQuantizedValue(format);
+
+            header.heightMin = minStep * heightStep;
+            header.heightStep = heightStep;
+
+            for (u32 i = 0; i < Terrain::MAP_CELL_TOTAL_GRID_SIZE; i++)
+            {
+                const f32 quantized = glm::clamp(SnapToStep(heights[i], heightStep) - minStep, 0.0f, maxQuantizedValue);
+
+                if (format == HEIGHT_FORMAT_16BIT)
+                {
+                    reinterpret_cast<u16*>(cellData)[i] = static_cast<u16>(quantized);
+                }
+                else
+                {
+                    cellData[i] = static_cast<u8>(quantized);
+                }
+            }
+
+            if (format == HEIGHT_FORMAT_16BIT)
+            {
+                stats.num16BitCells++;
+            }
+            else
+            {
+                stats.num8BitCells++;
+            }
+        }
+
+        for (u32 i = 0; i < Terrain::MAP_CELL_TOTAL_GRID_SIZE; i++)
+        {
+            const f32 error = glm::abs(DecodeHeight(header, data.data(), i) - heights[i]);
+            stats.maxHeightError = glm::max(stats.maxHeightError, error);
+        }
+
+        stats.floatBytes += Terrain::MAP_CELL_TOTAL_GRID_SIZE * sizeof(f32);
+        stats.uploadedBytes += encodedSize + sizeof(CellHeightHeader);
+
+        return header;
+    }
+}
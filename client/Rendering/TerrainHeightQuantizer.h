@@ -0,0 +1,60 @@
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+
+// Packs the heights of a terrain cell into the layout terrain.vs.hlsl decodes. Compressed cells store every height as an 8 or 16 bit
+// offset from the cell's lowest height, the precision is picked per cell from how far its heights span
+//
+// Every cell snaps its heights to the same power of two grid, so a vertex shared by two cells decodes to the same height whatever
+// format either cell picked and the terrain can't crack along cell borders. With a power of two step every decode is exact in f32
+namespace TerrainHeightQuantizer
+{
+    enum HeightFormat : u32
+    {
+        HEIGHT_FORMAT_FLOAT = 0,
+        HEIGHT_FORMAT_16BIT = 1,
+        HEIGHT_FORMAT_8BIT = 2
+    };
+
+    // One per cell, indexed by global cell id, has to match the header terrain.vs.hlsl reads
+    struct CellHeightHeader
+    {
+        f32 heightMin = 0.0f; // Always a multiple of heightStep
+        f32 heightStep = 0.0f; // Yards per quantized step, unused by HEIGHT_FORMAT_FLOAT
+        u32 dataOffset = 0; // In bytes from the start of the height buffer
+        u32 format = HEIGHT_FORMAT_FLOAT;
+    };
+    static_assert(sizeof(CellHeightHeader) == 16, "CellHeightHeader has to match the header terrain.vs.hlsl reads");
+
+    struct QuantizationStats
+    {
+        u32 numFloatCells = 0;
+        u32 num16BitCells = 0;
+        u32 num8BitCells = 0;
+
+        u64 floatBytes = 0; // What every cell would have used as plain f32 heights
+        u64 uploadedBytes = 0; // Encoded heights plus their CellHeightHeader
+
+        f32 maxHeightError = 0.0f; // In yards, measured by decoding what was encoded
+
+        u64 GetSavedBytes() const { return floatBytes > uploadedBytes ? floatBytes - uploadedBytes : 0; }
+    };
+
+    // Bytes a cell's heights take in the given format, padded so the next cell starts 4 byte aligned for ByteAddressBuffer loads
+    u32 GetEncodedSize(HeightFormat format);
+
+    // Largest power of two grid step that keeps snapped heights within maxHeightError yards of where they were
+    f32 GetHeightStep(f32 maxHeightError);
+
+    // Smallest format that can hold every height of a cell snapped to heightStep
+    HeightFormat ChooseFormat(const f32* heights, f32 heightStep);
+
+    // Appends the cell's heights to data in the given format and returns the header the vertex shader needs to find and decode them
+    // Heights are snapped to heightStep, HEIGHT_FORMAT_FLOAT cells too so their borders match their neighbours. A heightStep of 0 stores
+    // HEIGHT_FORMAT_FLOAT cells as they are, which is what uncompressed terrain uses
+    CellHeightHeader EncodeCell(const f32* heights, HeightFormat format, f32 heightStep, std::vector<u8>& data, QuantizationStats& stats);
+
+    // Same math as terrain.vs.hlsl, used to give collision the heights that end up on screen
+    f32 DecodeHeight(const CellHeightHeader& header, const u8* data, u32 vertexID);
+    void DecodeCell(const CellHeightHeader& header, const u8* data, f32* heights);
+}
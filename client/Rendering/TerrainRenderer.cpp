@@ -4,6 +4,7 @@
 #include <entt.hpp>
 #include "../Utils/ServiceLocator.h"
 #include "../Utils/MapUtils.h"
+#include "../Utils/CullingUtils.h"
 
 #include "../ECS/Components/Singletons/MapSingleton.h"
 
@@ -58,35 +59,35 @@ TerrainRenderer::TerrainRenderer(Renderer::Renderer* renderer, DebugRenderer* de
     _mapObjectRenderer = new MapObjectRenderer(renderer); // Needs to be created before CreatePermanentResources
     CreatePermanentResources();
 
-    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleCulling", GLFW_KEY_F2, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleCulling", GLFW_KEY_F2, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         s_cullingEnabled = !s_cullingEnabled;
         return true;
     });
 
-    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleGPUCulling", GLFW_KEY_F3, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleGPUCulling", GLFW_KEY_F3, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         s_gpuCullingEnabled = !s_gpuCullingEnabled;
         return true;
     });
 
-    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleLockCullingFrustum", GLFW_KEY_F5, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleLockCullingFrustum", GLFW_KEY_F5, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         s_lockCullingFrustum = !s_lockCullingFrustum;
         return true;
     });
 
-    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleLockDebugPosition", GLFW_KEY_F6, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    ServiceLocator::GetInputManager()->RegisterKeybind("ToggleLockDebugPosition", GLFW_KEY_F6, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         s_lockDebugPosition = !s_lockDebugPosition;
         return true;
     });
-    ServiceLocator::GetInputManager()->RegisterKeybind("DecreaseDebugPositionScale", GLFW_KEY_F7, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    ServiceLocator::GetInputManager()->RegisterKeybind("DecreaseDebugPositionScale", GLFW_KEY_F7, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         s_debugPositionScale -= 0.1f;
         return true;
     });
-    ServiceLocator::GetInputManager()->RegisterKeybind("IncreaseDebugPositionScale", GLFW_KEY_F8, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, std::shared_ptr<Keybind> keybind)
+    ServiceLocator::GetInputManager()->RegisterKeybind("IncreaseDebugPositionScale", GLFW_KEY_F8, KEYBIND_ACTION_PRESS, KEYBIND_MOD_ANY, [this](Window* window, Keybind* keybind)
     {
         s_debugPositionScale += 0.1f;
         return true;
@@ -137,58 +138,6 @@ void TerrainRenderer::Update(f32 deltaTime)
     //_mapObjectRenderer->Update(deltaTime);
 }
 
-__forceinline bool IsInsideFrustum(const vec4* planes, const Geometry::AABoundingBox& boundingBox)
-{
-    // this is why god abandoned us
-    for (int i = 0; i < 6; ++i) 
-    {
-        const vec4& plane = planes[i];
-
-        vec3 vmin, vmax;
-
-        // X axis 
-        if (plane.x > 0) 
-        {
-            vmin.x = boundingBox.min.x;
-            vmax.x = boundingBox.max.x;
-        }
-        else 
-        {
-            vmin.x = boundingBox.max.x;
-            vmax.x = boundingBox.min.x;
-        }
-        // Y axis 
-        if (plane.y > 0) 
-        {
-            vmin.y = boundingBox.min.y;
-            vmax.y = boundingBox.max.y;
-        }
-        else 
-        {
-            vmin.y = boundingBox.max.y;
-            vmax.y = boundingBox.min.y;
-        }
-        // Z axis 
-        if (plane.z > 0) 
-        {
-            vmin.z = boundingBox.min.z;
-            vmax.z = boundingBox.max.z;
-        }
-        else 
-        {
-            vmin.z = boundingBox.max.z;
-            vmax.z = boundingBox.min.z;
-        }
-
-        if (glm::dot(vec3(plane), vmin) + plane.w < 0)
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-
 void TerrainRenderer::CPUCulling(const Camera* camera)
 {
     ZoneScoped;
@@ -202,23 +151,7 @@ void TerrainRenderer::CPUCulling(const Camera* camera)
         lockedViewProjectionMatrix = camera->GetViewProjectionMatrix();
     }
 
-    _culledInstances.clear();
-    _culledInstances.reserve(_loadedChunks.size() * Terrain::MAP_CELLS_PER_CHUNK);
-
-    const size_t chunkCount = _loadedChunks.size();
-    size_t boundingBoxIndex = 0;
-    for (size_t i = 0; i < chunkCount; ++i)
-    {
-        for (u16 cellId = 0; cellId < Terrain::MAP_CELLS_PER_CHUNK; ++cellId)
-        {
-            const Geometry::AABoundingBox& boundingBox = _cellBoundingBoxes[boundingBoxIndex++];
-            if (IsInsideFrustum(frustumPlanes, boundingBox))
-            {
-                const u16 chunkId = _loadedChunks[i];
-                _culledInstances.push_back((chunkId << 16) | cellId);
-            }
-        }
-    }
+    Terrain::CullingUtils::CullCells(frustumPlanes, _loadedChunks, _cellBoundingBoxes, _culledInstances);
 
     _debugRenderer->DrawFrustum(lockedViewProjectionMatrix, 0xff0000ff);
 }
@@ -261,8 +194,6 @@ void TerrainRenderer::AddTerrainPass(Renderer::RenderGraph* renderGraph, Rendere
         },
             [=](TerrainPassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList) // Execute
         {
-            GPU_SCOPED_PROFILER_ZONE(commandList, TerrainPass);
-
             Camera* camera = ServiceLocator::GetCamera();
 
             // Upload culled instances
@@ -288,15 +219,20 @@ void TerrainRenderer::AddTerrainPass(Renderer::RenderGraph* renderGraph, Rendere
             // Cull instances on GPU
             if (s_cullingEnabled && s_gpuCullingEnabled)
             {
-                Renderer::ComputePipelineDesc pipelineDesc;
-                resources.InitializePipelineDesc(pipelineDesc);
+                // Created on the first frame that culls on the GPU and kept after that
+                if (_cullingPipeline == Renderer::ComputePipelineID::Invalid())
+                {
+                    Renderer::ComputePipelineDesc pipelineDesc;
+                    resources.InitializePipelineDesc(pipelineDesc);
+
+                    Renderer::ComputeShaderDesc shaderDesc;
+                    shaderDesc.path = "Data/shaders/terrainCulling.cs.hlsl.spv";
+                    pipelineDesc.computeShader = _renderer->LoadShader(shaderDesc);
 
-                Renderer::ComputeShaderDesc shaderDesc;
-                shaderDesc.path = "Data/shaders/terrainCulling.cs.hlsl.spv";
-                pipelineDesc.computeShader = _renderer->LoadShader(shaderDesc);
+                    _cullingPipeline = _renderer->CreatePipeline(pipelineDesc);
+                }
 
-                Renderer::ComputePipelineID pipeline = _renderer->CreatePipeline(pipelineDesc);
-                commandList.BindPipeline(pipeline);
+                commandList.BindPipeline(_cullingPipeline);
 
                 if (!s_lockCullingFrustum)
                 {
@@ -319,40 +255,46 @@ void TerrainRenderer::AddTerrainPass(Renderer::RenderGraph* renderGraph, Rendere
                 commandList.PipelineBarrier(Renderer::PipelineBarrierType::ComputeWriteToIndirectArguments, _argumentBuffer);
             }
 
-            Renderer::GraphicsPipelineDesc pipelineDesc;
-            resources.InitializePipelineDesc(pipelineDesc);
+            // The render targets outlive us, so the pipeline is created on the first frame and kept after that
+            if (_pipeline == Renderer::GraphicsPipelineID::Invalid())
+            {
+                Renderer::GraphicsPipelineDesc pipelineDesc;
+                resources.InitializePipelineDesc(pipelineDesc);
+
+                // Shaders
+                Renderer::VertexShaderDesc vertexShaderDesc;
+                vertexShaderDesc.path = "Data/shaders/terrain.vs.hlsl.spv";
+                pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
 
-            // Shaders
-            Renderer::VertexShaderDesc vertexShaderDesc;
-            vertexShaderDesc.path = "Data/shaders/terrain.vs.hlsl.spv";
-            pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
+                Renderer::PixelShaderDesc pixelShaderDesc;
+                pixelShaderDesc.path = "Data/shaders/terrain.ps.hlsl.spv";
+                pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
 
-            Renderer::PixelShaderDesc pixelShaderDesc;
-            pixelShaderDesc.path = "Data/shaders/terrain.ps.hlsl.spv";
-            pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
+                // Input layouts TODO: Improve on this, if I set state 0 and 3 it won't work etc... Maybe responsibility for this should be moved to ModelHandler and the cooker?
+                pipelineDesc.states.inputLayouts[0].enabled = true;
+                pipelineDesc.states.inputLayouts[0].SetName("INSTANCEID");
+                pipelineDesc.states.inputLayouts[0].format = Renderer::InputFormat::INPUT_FORMAT_R32_UINT;
+                pipelineDesc.states.inputLayouts[0].inputClassification = Renderer::InputClassification::INPUT_CLASSIFICATION_PER_INSTANCE;
 
-            // Input layouts TODO: Improve on this, if I set state 0 and 3 it won't work etc... Maybe responsibility for this should be moved to ModelHandler and the cooker?
-            pipelineDesc.states.inputLayouts[0].enabled = true;
-            pipelineDesc.states.inputLayouts[0].SetName("INSTANCEID");
-            pipelineDesc.states.inputLayouts[0].format = Renderer::InputFormat::INPUT_FORMAT_R32_UINT;
-            pipelineDesc.states.inputLayouts[0].inputClassification = Renderer::InputClassification::INPUT_CLASSIFICATION_PER_INSTANCE;
+                // Depth state
+                pipelineDesc.states.depthStencilState.depthEnable = true;
+                pipelineDesc.states.depthStencilState.depthWriteEnable = true;
+                pipelineDesc.states.depthStencilState.depthFunc = Renderer::ComparisonFunc::COMPARISON_FUNC_LESS;
 
-            // Depth state
-            pipelineDesc.states.depthStencilState.depthEnable = true;
-            pipelineDesc.states.depthStencilState.depthWriteEnable = true;
-            pipelineDesc.states.depthStencilState.depthFunc = Renderer::ComparisonFunc::COMPARISON_FUNC_LESS;
+                // Rasterizer state
+                pipelineDesc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
+                pipelineDesc.states.rasterizerState.frontFaceMode = Renderer::FrontFaceState::FRONT_FACE_STATE_COUNTERCLOCKWISE;
 
-            // Rasterizer state
-            pipelineDesc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
-            pipelineDesc.states.rasterizerState.frontFaceMode = Renderer::FrontFaceState::FRONT_FACE_STATE_COUNTERCLOCKWISE;
+                // Render targets
+                pipelineDesc.renderTargets[0] = data.mainColor;
 
-            // Render targets
-            pipelineDesc.renderTargets[0] = data.mainColor;
+                pipelineDesc.depthStencil = data.mainDepth;
 
-            pipelineDesc.depthStencil = data.mainDepth;
+                _pipeline = _renderer->CreatePipeline(pipelineDesc);
+            }
 
             // Set pipeline
-            Renderer::GraphicsPipelineID pipeline = _renderer->CreatePipeline(pipelineDesc); // This will compile the pipeline and return the ID, or just return ID of cached pipeline
+            Renderer::GraphicsPipelineID pipeline = _pipeline;
             commandList.BeginPipeline(pipeline);
 
             // Set instance buffer
@@ -367,6 +309,7 @@ void TerrainRenderer::AddTerrainPass(Renderer::RenderGraph* renderGraph, Rendere
             _passDescriptorSet.Bind("_vertexHeights"_h, _vertexBuffer);
             _passDescriptorSet.Bind("_cellData"_h, _cellBuffer);
             _passDescriptorSet.Bind("_cellDataVS"_h, _cellBuffer);
+            _passDescriptorSet.Bind("_cellHeightHeaders"_h, _cellHeightHeaderBuffer);
             _passDescriptorSet.Bind("_chunkData"_h, _chunkBuffer);
 
             // Bind descriptorset
@@ -509,13 +452,22 @@ void TerrainRenderer::CreatePermanentResources()
     }
 
     {
+        // Only a placeholder until a map is loaded, UploadVertexHeights replaces it with one sized to the loaded chunks
         Renderer::BufferDesc desc;
         desc.name = "TerrainVertexBuffer";
-        desc.size = sizeof(f32) * Terrain::NUM_VERTICES_PER_CHUNK * Terrain::MAP_CHUNKS_PER_MAP;
+        desc.size = sizeof(f32) * Terrain::MAP_CELL_TOTAL_GRID_SIZE;
         desc.usage = Renderer::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BUFFER_USAGE_TRANSFER_DESTINATION;
         _vertexBuffer = _renderer->CreateBuffer(desc);
     }
 
+    {
+        Renderer::BufferDesc desc;
+        desc.name = "TerrainCellHeightHeaderBuffer";
+        desc.size = sizeof(TerrainHeightQuantizer::CellHeightHeader) * Terrain::MAP_CELLS_PER_CHUNK * Terrain::MAP_CHUNKS_PER_MAP;
+        desc.usage = Renderer::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BUFFER_USAGE_TRANSFER_DESTINATION;
+        _cellHeightHeaderBuffer = _renderer->CreateBuffer(desc);
+    }
+
     {
         Renderer::BufferDesc desc;
         desc.name = "CellHeightRangeBuffer";
@@ -581,8 +533,7 @@ void TerrainRenderer::CreatePermanentResources()
         _renderer->CopyBuffer(_cellIndexBuffer, 0, indexUploadBuffer, 0, indexUploadBufferDesc.size);
     }
 
-    // Load default map
-    LoadMap("Azeroth"_h);
+    // The default map is loaded by EngineLoop once MapLoader is done, so the renderer can be created while it loads
 }
 
 bool TerrainRenderer::LoadMap(u32 mapInternalNameHash)
@@ -596,6 +547,8 @@ bool TerrainRenderer::LoadMap(u32 mapInternalNameHash)
     // Clear Terrain & WMOs
     _loadedChunks.clear();
     _cellBoundingBoxes.clear();
+    _vertexHeights.clear();
+    _heightQuantizationStats = TerrainHeightQuantizer::QuantizationStats();
     _mapObjectRenderer->Clear();
 
     LoadChunksAround(mapSingleton.currentMap, ivec2(32, 32), 32); // Load everything
@@ -605,6 +558,11 @@ bool TerrainRenderer::LoadMap(u32 mapInternalNameHash)
 
     //LoadChunksAround(map, ivec2(0, 0), 8); // Goldshire
 
+    UploadVertexHeights();
+    _mapObjectRenderer->LogQuantizationStats();
+
+    _loadedMapHash = mapInternalNameHash;
+
     // Upload instance data
     {
         const size_t cellCount = Terrain::MAP_CELLS_PER_CHUNK * _loadedChunks.size();
@@ -637,18 +595,32 @@ bool TerrainRenderer::LoadMap(u32 mapInternalNameHash)
     return true;
 }
 
+void TerrainRenderer::SetCompressHeights(bool enabled, f32 maxHeightError)
+{
+    const bool changed = enabled != _compressHeights || (enabled && maxHeightError != _maxHeightError);
+
+    _compressHeights = enabled;
+    _maxHeightError = maxHeightError;
+
+    // The loaded heights may have been replaced with decoded ones, so they have to come from disk again
+    if (changed && _loadedMapHash != 0)
+    {
+        LoadMap(_loadedMapHash);
+    }
+}
+
 void TerrainRenderer::LoadChunk(Terrain::Map& map, u16 chunkPosX, u16 chunkPosY)
 {
     u16 chunkId;
     map.GetChunkIdFromChunkPosition(chunkPosX, chunkPosY, chunkId);
 
-    const auto chunkIt = map.chunks.find(chunkId);
-    if (chunkIt == map.chunks.cend())
+    auto chunkIt = map.chunks.find(chunkId);
+    if (chunkIt == map.chunks.end())
     {
         return;
     }
 
-    const Terrain::Chunk& chunk = chunkIt->second;
+    Terrain::Chunk& chunk = chunkIt->second;
     StringTable& stringTable = map.stringTables[chunkId];
 
     // Upload cell data.
@@ -727,38 +699,42 @@ void TerrainRenderer::LoadChunk(Terrain::Map& map, u16 chunkPosX, u16 chunkPosY)
         _renderer->CopyBuffer(_chunkBuffer, chunkBufferOffset, chunkUploadBuffer, 0, chunkDataUploadBufferDesc.size);
     }
 
-    // Upload height data.
+    // Encode height data, the heights themselves are uploaded by UploadVertexHeights once every chunk is loaded
     {
-        Renderer::BufferDesc vertexUploadBufferDesc;
-        vertexUploadBufferDesc.name = "TerrainVertexUploadBuffer";
-        vertexUploadBufferDesc.size = sizeof(f32) * Terrain::NUM_VERTICES_PER_CHUNK;
-        vertexUploadBufferDesc.usage = Renderer::BUFFER_USAGE_TRANSFER_SOURCE;
-        vertexUploadBufferDesc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
+        Renderer::BufferDesc headerUploadBufferDesc;
+        headerUploadBufferDesc.name = "TerrainCellHeightHeaderUploadBuffer";
+        headerUploadBufferDesc.size = sizeof(TerrainHeightQuantizer::CellHeightHeader) * Terrain::MAP_CELLS_PER_CHUNK;
+        headerUploadBufferDesc.usage = Renderer::BUFFER_USAGE_TRANSFER_SOURCE;
+        headerUploadBufferDesc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
 
-        Renderer::BufferID vertexUploadBuffer = _renderer->CreateBuffer(vertexUploadBufferDesc);
-        _renderer->QueueDestroyBuffer(vertexUploadBuffer);
+        Renderer::BufferID headerUploadBuffer = _renderer->CreateBuffer(headerUploadBufferDesc);
+        _renderer->QueueDestroyBuffer(headerUploadBuffer);
 
-        void* vertexBufferMemory = _renderer->MapBuffer(vertexUploadBuffer);
-        for (size_t i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; ++i)
+        const f32 heightStep = _compressHeights ? TerrainHeightQuantizer::GetHeightStep(_maxHeightError) : 0.0f;
+
+        TerrainHeightQuantizer::CellHeightHeader* headers = static_cast<TerrainHeightQuantizer::CellHeightHeader*>(_renderer->MapBuffer(headerUploadBuffer));
+        for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i++)
         {
-            void* dstVertices = static_cast<u8*>(vertexBufferMemory) + (i * Terrain::MAP_CELL_TOTAL_GRID_SIZE * sizeof(f32));
-            const void* srcVertices = chunk.cells[i].heightData;
-            memcpy(dstVertices, srcVertices, Terrain::MAP_CELL_TOTAL_GRID_SIZE * sizeof(f32));
+            f32* heights = chunk.cells[i].heightData;
+
+            const TerrainHeightQuantizer::HeightFormat format = _compressHeights ? TerrainHeightQuantizer::ChooseFormat(heights, heightStep) : TerrainHeightQuantizer::HEIGHT_FORMAT_FLOAT;
+            const TerrainHeightQuantizer::CellHeightHeader header = TerrainHeightQuantizer::EncodeCell(heights, format, heightStep, _vertexHeights, _heightQuantizationStats);
+            headers[i] = header;
+
+            // Collision and culling below use the heights the vertex shader will decode, SetCompressHeights reloads the map from disk to undo this
+            if (_compressHeights)
+            {
+                TerrainHeightQuantizer::DecodeCell(header, _vertexHeights.data(), heights);
+            }
         }
 
-        _renderer->UnmapBuffer(vertexUploadBuffer);
-        const u64 chunkVertexBufferOffset = chunkId * sizeof(f32) * Terrain::NUM_VERTICES_PER_CHUNK;
-        _renderer->CopyBuffer(_vertexBuffer, chunkVertexBufferOffset, vertexUploadBuffer, 0, vertexUploadBufferDesc.size);
+        _renderer->UnmapBuffer(headerUploadBuffer);
+        const u64 headerBufferOffset = (static_cast<u64>(chunkId) * Terrain::MAP_CELLS_PER_CHUNK) * sizeof(TerrainHeightQuantizer::CellHeightHeader);
+        _renderer->CopyBuffer(_cellHeightHeaderBuffer, headerBufferOffset, headerUploadBuffer, 0, headerUploadBufferDesc.size);
     }
 
     // Calculate bounding boxes and upload height ranges
     {
-        constexpr float halfWorldSize = 17066.66656f;
-
-        vec2 chunkOrigin;
-        chunkOrigin.x = -((chunkPosY)*Terrain::MAP_CHUNK_SIZE - halfWorldSize);
-        chunkOrigin.y = ((Terrain::MAP_CHUNKS_PER_MAP_STRIDE - chunkPosX) * Terrain::MAP_CHUNK_SIZE - halfWorldSize);
-
         std::vector<TerrainCellHeightRange> heightRanges;
         heightRanges.reserve(Terrain::MAP_CELLS_PER_CHUNK);
 
@@ -767,23 +743,7 @@ void TerrainRenderer::LoadChunk(Terrain::Map& map, u16 chunkPosX, u16 chunkPosY)
             const Terrain::Cell& cell = chunk.cells[cellIndex];
             const auto minmax = std::minmax_element(cell.heightData, cell.heightData + Terrain::MAP_CELL_TOTAL_GRID_SIZE);
 
-            const u16 cellX = cellIndex % Terrain::MAP_CELLS_PER_CHUNK_SIDE;
-            const u16 cellY = cellIndex / Terrain::MAP_CELLS_PER_CHUNK_SIDE;
-
-            vec3 min;
-            vec3 max;
-
-            min.x = chunkOrigin.x - (cellY * Terrain::MAP_CELL_SIZE);
-            min.y = *minmax.first;
-            min.z = chunkOrigin.y - (cellX * Terrain::MAP_CELL_SIZE);
-
-            max.x = chunkOrigin.x - ((cellY + 1) * Terrain::MAP_CELL_SIZE);
-            max.y = *minmax.second;
-            max.z = chunkOrigin.y - ((cellX + 1) * Terrain::MAP_CELL_SIZE);
-
-            Geometry::AABoundingBox boundingBox;
-            boundingBox.min = glm::max(min, max);
-            boundingBox.max = glm::min(min, max);
+            const Geometry::AABoundingBox boundingBox = Terrain::CullingUtils::CalculateCellBoundingBox(chunkPosX, chunkPosY, cellIndex, cell);
             _cellBoundingBoxes.push_back(boundingBox);
 
             TerrainCellHeightRange heightRange;
@@ -823,6 +783,44 @@ void TerrainRenderer::LoadChunk(Terrain::Map& map, u16 chunkPosX, u16 chunkPosY)
     _loadedChunks.push_back(chunkId);
 }
 
+void TerrainRenderer::UploadVertexHeights()
+{
+    _renderer->QueueDestroyBuffer(_vertexBuffer);
+
+    Renderer::BufferDesc desc;
+    desc.name = "TerrainVertexBuffer";
+    desc.size = std::max<u64>(_vertexHeights.size(), sizeof(f32));
+    desc.usage = Renderer::BUFFER_USAGE_STORAGE_BUFFER | Renderer::BUFFER_USAGE_TRANSFER_DESTINATION;
+    _vertexBuffer = _renderer->CreateBuffer(desc);
+
+    if (!_vertexHeights.empty())
+    {
+        Renderer::BufferDesc vertexUploadBufferDesc;
+        vertexUploadBufferDesc.name = "TerrainVertexUploadBuffer";
+        vertexUploadBufferDesc.size = _vertexHeights.size();
+        vertexUploadBufferDesc.usage = Renderer::BUFFER_USAGE_TRANSFER_SOURCE;
+        vertexUploadBufferDesc.cpuAccess = Renderer::BufferCPUAccess::WriteOnly;
+
+        Renderer::BufferID vertexUploadBuffer = _renderer->CreateBuffer(vertexUploadBufferDesc);
+        _renderer->QueueDestroyBuffer(vertexUploadBuffer);
+
+        void* vertexBufferMemory = _renderer->MapBuffer(vertexUploadBuffer);
+        memcpy(vertexBufferMemory, _vertexHeights.data(), vertexUploadBufferDesc.size);
+        _renderer->UnmapBuffer(vertexUploadBuffer);
+
+        _renderer->CopyBuffer(_vertexBuffer, 0, vertexUploadBuffer, 0, vertexUploadBufferDesc.size);
+    }
+
+    if (_compressHeights)
+    {
+        const TerrainHeightQuantizer::QuantizationStats& stats = _heightQuantizationStats;
+        NC_LOG_MESSAGE("Terrain heights: %u cells 8 bit, %u cells 16 bit, %u kept as float, %.2f MB saved, max height error %f", stats.num8BitCells, stats.num16BitCells, stats.numFloatCells, stats.GetSavedBytes() / (1024.0 * 1024.0), stats.maxHeightError);
+    }
+
+    // The GPU copy is all that's needed from here on
+    std::vector<u8>().swap(_vertexHeights);
+}
+
 void TerrainRenderer::LoadChunksAround(Terrain::Map& map, ivec2 middleChunk, u16 drawDistance)
 {
     // Middle position has to be within map grid
@@ -12,11 +12,14 @@
 #include <Renderer/Descriptors/ModelDesc.h>
 #include <Renderer/Descriptors/SamplerDesc.h>
 #include <Renderer/Descriptors/BufferDesc.h>
+#include <Renderer/Descriptors/GraphicsPipelineDesc.h>
+#include <Renderer/Descriptors/ComputePipelineDesc.h>
 #include <Renderer/Buffer.h>
 #include <Renderer/DescriptorSet.h>
 
 #include "../Gameplay/Map/Chunk.h"
 #include "ViewConstantBuffer.h"
+#include "TerrainHeightQuantizer.h"
 
 namespace Terrain
 {
@@ -48,11 +51,20 @@ public:
     void AddTerrainPass(Renderer::RenderGraph* renderGraph, Renderer::Buffer<ViewConstantBuffer>* viewConstantBuffer, Renderer::ImageID renderTarget, Renderer::DepthImageID depthTarget, u8 frameIndex);
 
     bool LoadMap(u32 mapInternalNameHash);
+
+    MapObjectRenderer* GetMapObjectRenderer() { return _mapObjectRenderer; }
+
+    // Opt-in, cell heights are stored as 8 or 16 bit offsets as long as they stay within maxHeightError yards. The loaded map's heights are
+    // replaced with the decoded ones so collision matches what is rendered, so changing this reloads the current map from disk
+    void SetCompressHeights(bool enabled, f32 maxHeightError = 0.01f);
+    bool GetCompressHeights() const { return _compressHeights; }
+    const TerrainHeightQuantizer::QuantizationStats& GetHeightQuantizationStats() const { return _heightQuantizationStats; }
 private:
     void CreatePermanentResources();
 
     void LoadChunk(Terrain::Map& map, u16 chunkPosX, u16 chunkPosY);
     void LoadChunksAround(Terrain::Map& map, ivec2 middleChunk, u16 drawDistance);
+    void UploadVertexHeights();
     void CPUCulling(const Camera* camera);
 
     void DebugRenderCellTriangles(const Camera* camera);
@@ -73,7 +85,8 @@ private:
 
     Renderer::BufferID _chunkBuffer = Renderer::BufferID::Invalid();
     Renderer::BufferID _cellBuffer = Renderer::BufferID::Invalid();
-    Renderer::BufferID _vertexBuffer = Renderer::BufferID::Invalid();
+    Renderer::BufferID _vertexBuffer = Renderer::BufferID::Invalid(); // Sized to the loaded chunks, cells find their heights through _cellHeightHeaderBuffer
+    Renderer::BufferID _cellHeightHeaderBuffer = Renderer::BufferID::Invalid();
 
     Renderer::BufferID _cellIndexBuffer = Renderer::BufferID::Invalid();
     
@@ -83,6 +96,9 @@ private:
     Renderer::SamplerID _alphaSampler;
     Renderer::SamplerID _colorSampler;
 
+    Renderer::GraphicsPipelineID _pipeline = Renderer::GraphicsPipelineID::Invalid();
+    Renderer::ComputePipelineID _cullingPipeline = Renderer::ComputePipelineID::Invalid();
+
     Renderer::DescriptorSet _passDescriptorSet;
     Renderer::DescriptorSet _drawDescriptorSet;
 
@@ -92,6 +108,12 @@ private:
     std::vector<Geometry::AABoundingBox> _cellBoundingBoxes;
 
     std::vector<u32> _culledInstances;
+
+    std::vector<u8> _vertexHeights; // Filled by LoadChunk, uploaded and freed once the map is loaded
+    bool _compressHeights = false;
+    f32 _maxHeightError = 0.01f;
+    u32 _loadedMapHash = 0; // 0 until a map has been loaded
+    TerrainHeightQuantizer::QuantizationStats _heightQuantizationStats;
     
     // Subrenderers
     MapObjectRenderer* _mapObjectRenderer = nullptr;
@@ -83,44 +83,49 @@ void UIRenderer::AddUIPass(Renderer::RenderGraph* renderGraph, Renderer::ImageID
         [=](UIPassData& data, Renderer::RenderGraphResources& resources, Renderer::CommandList& commandList) // Execute
         {
             
-            GPU_SCOPED_PROFILER_ZONE(commandList, UIPass);
+            // The pipelines only depend on the render target, which outlives us, so they're created on the first frame and kept after that
+            if (_imagePipeline == Renderer::GraphicsPipelineID::Invalid())
+            {
+                Renderer::GraphicsPipelineDesc pipelineDesc;
+                resources.InitializePipelineDesc(pipelineDesc);
 
-            Renderer::GraphicsPipelineDesc pipelineDesc;
-            resources.InitializePipelineDesc(pipelineDesc);
+                // Rasterizer state
+                pipelineDesc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
+                //pipelineDesc.states.rasterizerState.frontFaceMode = Renderer::FrontFaceState::FRONT_FACE_STATE_COUNTERCLOCKWISE;
 
-            // Rasterizer state
-            pipelineDesc.states.rasterizerState.cullMode = Renderer::CullMode::CULL_MODE_BACK;
-            //pipelineDesc.states.rasterizerState.frontFaceMode = Renderer::FrontFaceState::FRONT_FACE_STATE_COUNTERCLOCKWISE;
+                // Render targets
+                pipelineDesc.renderTargets[0] = data.renderTarget;
 
-            // Render targets
-            pipelineDesc.renderTargets[0] = data.renderTarget;
+                // Blending
+                pipelineDesc.states.blendState.renderTargets[0].blendEnable = true;
+                pipelineDesc.states.blendState.renderTargets[0].srcBlend = Renderer::BlendMode::BLEND_MODE_SRC_ALPHA;
+                pipelineDesc.states.blendState.renderTargets[0].destBlend = Renderer::BlendMode::BLEND_MODE_INV_SRC_ALPHA;
+                pipelineDesc.states.blendState.renderTargets[0].srcBlendAlpha = Renderer::BlendMode::BLEND_MODE_ZERO;
+                pipelineDesc.states.blendState.renderTargets[0].destBlendAlpha = Renderer::BlendMode::BLEND_MODE_ONE;
 
-            // Blending
-            pipelineDesc.states.blendState.renderTargets[0].blendEnable = true;
-            pipelineDesc.states.blendState.renderTargets[0].srcBlend = Renderer::BlendMode::BLEND_MODE_SRC_ALPHA;
-            pipelineDesc.states.blendState.renderTargets[0].destBlend = Renderer::BlendMode::BLEND_MODE_INV_SRC_ALPHA;
-            pipelineDesc.states.blendState.renderTargets[0].srcBlendAlpha = Renderer::BlendMode::BLEND_MODE_ZERO;
-            pipelineDesc.states.blendState.renderTargets[0].destBlendAlpha = Renderer::BlendMode::BLEND_MODE_ONE;
+                // Panel Shaders
+                Renderer::VertexShaderDesc vertexShaderDesc;
+                vertexShaderDesc.path = "Data/shaders/panel.vs.hlsl.spv";
+                pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
 
-            // Panel Shaders
-            Renderer::VertexShaderDesc vertexShaderDesc;
-            vertexShaderDesc.path = "Data/shaders/panel.vs.hlsl.spv";
-            pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
+                Renderer::PixelShaderDesc pixelShaderDesc;
+                pixelShaderDesc.path = "Data/shaders/panel.ps.hlsl.spv";
+                pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
 
-            Renderer::PixelShaderDesc pixelShaderDesc;
-            pixelShaderDesc.path = "Data/shaders/panel.ps.hlsl.spv";
-            pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
+                _imagePipeline = _renderer->CreatePipeline(pipelineDesc);
 
-            Renderer::GraphicsPipelineID imagePipeline = _renderer->CreatePipeline(pipelineDesc); // This will compile the pipeline and return the ID, or just return ID of cached pipeline
+                // Text Shaders
+                vertexShaderDesc.path = "Data/shaders/text.vs.hlsl.spv";
+                pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
 
-            // Text Shaders
-            vertexShaderDesc.path = "Data/shaders/text.vs.hlsl.spv";
-            pipelineDesc.states.vertexShader = _renderer->LoadShader(vertexShaderDesc);
+                pixelShaderDesc.path = "Data/shaders/text.ps.hlsl.spv";
+                pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
 
-            pixelShaderDesc.path = "Data/shaders/text.ps.hlsl.spv";
-            pipelineDesc.states.pixelShader = _renderer->LoadShader(pixelShaderDesc);
+                _textPipeline = _renderer->CreatePipeline(pipelineDesc);
+            }
 
-            Renderer::GraphicsPipelineID textPipeline = _renderer->CreatePipeline(pipelineDesc); // This will compile the pipeline and return the ID, or just return ID of cached pipeline
+            Renderer::GraphicsPipelineID imagePipeline = _imagePipeline;
+            Renderer::GraphicsPipelineID textPipeline = _textPipeline;
 
             // Set pipeline
             commandList.BeginPipeline(imagePipeline);
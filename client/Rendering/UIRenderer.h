@@ -3,6 +3,7 @@
 
 #include <Renderer/Descriptors/ImageDesc.h>
 #include <Renderer/Descriptors/ModelDesc.h>
+#include <Renderer/Descriptors/GraphicsPipelineDesc.h>
 #include <Renderer/DescriptorSet.h>
 
 namespace Renderer
@@ -29,6 +30,9 @@ private:
     Renderer::SamplerID _linearSampler;
     Renderer::BufferID _indexBuffer;
 
+    Renderer::GraphicsPipelineID _imagePipeline = Renderer::GraphicsPipelineID::Invalid();
+    Renderer::GraphicsPipelineID _textPipeline = Renderer::GraphicsPipelineID::Invalid();
+
     Renderer::DescriptorSet _passDescriptorSet;
     Renderer::DescriptorSet _drawImageDescriptorSet;
     Renderer::DescriptorSet _drawTextDescriptorSet;
@@ -1,7 +1,9 @@
 #include "DataStorageUtils.h"
 #include <entity/registry.hpp>
 #include <angelscript.h>
+#include <algorithm>
 #include "../../ScriptEngine.h"
+#include "../../Addons/scriptarray/scriptarray.h"
 #include "../../../Utils/ServiceLocator.h"
 #include "../../../ECS/Components/Singletons/DataStorageSingleton.h"
 
@@ -15,50 +17,115 @@ namespace ASDataStorageUtils
         r = ScriptEngine::SetNamespace("DataStorage");
         assert(r >= 0);
         {
-            ScriptEngine::RegisterScriptFunction("bool PutU8(string name, uint8 val)", asFUNCTION(PutU8));
-            ScriptEngine::RegisterScriptFunction("void EmplaceU8(string name, uint8 val)", asFUNCTION(EmplaceU8));
-            ScriptEngine::RegisterScriptFunction("bool GetU8(string name, uint8 &out val)", asFUNCTION(GetU8));
-            ScriptEngine::RegisterScriptFunction("bool ClearU8(string name)", asFUNCTION(ClearU8));
-
-            ScriptEngine::RegisterScriptFunction("bool PutU16(string name, uint16 val)", asFUNCTION(PutU16));
-            ScriptEngine::RegisterScriptFunction("void EmplaceU16(string name, uint16 val)", asFUNCTION(EmplaceU16));
-            ScriptEngine::RegisterScriptFunction("bool GetU16(string name, uint16 &out val)", asFUNCTION(GetU16));
-            ScriptEngine::RegisterScriptFunction("bool ClearU16(string name)", asFUNCTION(ClearU16));
-
-            ScriptEngine::RegisterScriptFunction("bool PutU32(string name, uint val)", asFUNCTION(PutU32));
-            ScriptEngine::RegisterScriptFunction("void EmplaceU32(string name, uint val)", asFUNCTION(EmplaceU32));
-            ScriptEngine::RegisterScriptFunction("bool GetU32(string name, uint &out val)", asFUNCTION(GetU32));
-            ScriptEngine::RegisterScriptFunction("bool ClearU32(string name)", asFUNCTION(ClearU32));
-
-            ScriptEngine::RegisterScriptFunction("bool PutU64(string name, uint64 val)", asFUNCTION(PutU64));
-            ScriptEngine::RegisterScriptFunction("void EmplaceU64(string name, uint64 val)", asFUNCTION(EmplaceU64));
-            ScriptEngine::RegisterScriptFunction("bool GetU64(string name, uint64 &out val)", asFUNCTION(GetU64));
-            ScriptEngine::RegisterScriptFunction("bool ClearU64(string name)", asFUNCTION(ClearU64));
-
-            ScriptEngine::RegisterScriptFunction("bool PutF32(string name, float val)", asFUNCTION(PutF32));
-            ScriptEngine::RegisterScriptFunction("void EmplaceF32(string name, float val)", asFUNCTION(EmplaceF32));
-            ScriptEngine::RegisterScriptFunction("bool GetF32(string name, float &out val)", asFUNCTION(GetF32));
-            ScriptEngine::RegisterScriptFunction("bool ClearF32(string name)", asFUNCTION(ClearF32));
-
-            ScriptEngine::RegisterScriptFunction("bool PutF64(string name, double val)", asFUNCTION(PutF64));
-            ScriptEngine::RegisterScriptFunction("void EmplaceF64(string name, double val)", asFUNCTION(EmplaceF64));
-            ScriptEngine::RegisterScriptFunction("bool GetF64(string name, double &out val)", asFUNCTION(GetF64));
-            ScriptEngine::RegisterScriptFunction("bool ClearF64(string name)", asFUNCTION(ClearF64));
-
-            ScriptEngine::RegisterScriptFunction("bool PutString(string name, string val)", asFUNCTION(PutString));
-            ScriptEngine::RegisterScriptFunction("void EmplaceString(string name, string val)", asFUNCTION(EmplaceString));
-            ScriptEngine::RegisterScriptFunction("bool GetString(string name, string &out val)", asFUNCTION(GetString));
-            ScriptEngine::RegisterScriptFunction("bool ClearString(string name)", asFUNCTION(ClearString));
-
-            ScriptEngine::RegisterScriptFunction("bool PutPointer(string name, void_ptr val)", asFUNCTION(PutPointer));
-            ScriptEngine::RegisterScriptFunction("void EmplacePointer(string name, void_ptr val)", asFUNCTION(EmplacePointer));
-            ScriptEngine::RegisterScriptFunction("bool GetPointer(string name, void_ptr &out val)", asFUNCTION(GetPointer));
-            ScriptEngine::RegisterScriptFunction("bool ClearPointer(string name)", asFUNCTION(ClearPointer));
-
-            ScriptEngine::RegisterScriptFunction("bool PutEntity(string name, Entity val)", asFUNCTION(PutEntity));
-            ScriptEngine::RegisterScriptFunction("void EmplaceEntity(string name, Entity val)", asFUNCTION(EmplaceEntity));
-            ScriptEngine::RegisterScriptFunction("bool GetEntity(string name, Entity &out val)", asFUNCTION(GetEntity));
-            ScriptEngine::RegisterScriptFunction("bool ClearEntity(string name)", asFUNCTION(ClearEntity));
+            r = ScriptEngine::RegisterScriptClass("DataKey", sizeof(DataKey), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_PRIMITIVE);
+            assert(r >= 0);
+
+            ScriptEngine::RegisterScriptFunction("bool PutU8(string name, uint8 val)", asFUNCTIONPR(PutU8, (std::string, u8), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU8(string name, uint8 val)", asFUNCTIONPR(EmplaceU8, (std::string, u8), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU8(string name, uint8 &out val)", asFUNCTIONPR(GetU8, (std::string, u8&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU8(string name)", asFUNCTIONPR(ClearU8, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU16(string name, uint16 val)", asFUNCTIONPR(PutU16, (std::string, u16), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU16(string name, uint16 val)", asFUNCTIONPR(EmplaceU16, (std::string, u16), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU16(string name, uint16 &out val)", asFUNCTIONPR(GetU16, (std::string, u16&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU16(string name)", asFUNCTIONPR(ClearU16, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU32(string name, uint val)", asFUNCTIONPR(PutU32, (std::string, u32), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU32(string name, uint val)", asFUNCTIONPR(EmplaceU32, (std::string, u32), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU32(string name, uint &out val)", asFUNCTIONPR(GetU32, (std::string, u32&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU32(string name)", asFUNCTIONPR(ClearU32, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU64(string name, uint64 val)", asFUNCTIONPR(PutU64, (std::string, u64), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU64(string name, uint64 val)", asFUNCTIONPR(EmplaceU64, (std::string, u64), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU64(string name, uint64 &out val)", asFUNCTIONPR(GetU64, (std::string, u64&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU64(string name)", asFUNCTIONPR(ClearU64, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutF32(string name, float val)", asFUNCTIONPR(PutF32, (std::string, f32), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceF32(string name, float val)", asFUNCTIONPR(EmplaceF32, (std::string, f32), void));
+            ScriptEngine::RegisterScriptFunction("bool GetF32(string name, float &out val)", asFUNCTIONPR(GetF32, (std::string, f32&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearF32(string name)", asFUNCTIONPR(ClearF32, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutF64(string name, double val)", asFUNCTIONPR(PutF64, (std::string, f64), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceF64(string name, double val)", asFUNCTIONPR(EmplaceF64, (std::string, f64), void));
+            ScriptEngine::RegisterScriptFunction("bool GetF64(string name, double &out val)", asFUNCTIONPR(GetF64, (std::string, f64&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearF64(string name)", asFUNCTIONPR(ClearF64, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutString(string name, string val)", asFUNCTIONPR(PutString, (std::string, std::string), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceString(string name, string val)", asFUNCTIONPR(EmplaceString, (std::string, std::string), void));
+            ScriptEngine::RegisterScriptFunction("bool GetString(string name, string &out val)", asFUNCTIONPR(GetString, (std::string, std::string&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearString(string name)", asFUNCTIONPR(ClearString, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutPointer(string name, void_ptr val)", asFUNCTIONPR(PutPointer, (std::string, void*), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplacePointer(string name, void_ptr val)", asFUNCTIONPR(EmplacePointer, (std::string, void*), void));
+            ScriptEngine::RegisterScriptFunction("bool GetPointer(string name, void_ptr &out val)", asFUNCTIONPR(GetPointer, (std::string, void*&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearPointer(string name)", asFUNCTIONPR(ClearPointer, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutEntity(string name, Entity val)", asFUNCTIONPR(PutEntity, (std::string, entt::entity), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceEntity(string name, Entity val)", asFUNCTIONPR(EmplaceEntity, (std::string, entt::entity), void));
+            ScriptEngine::RegisterScriptFunction("bool GetEntity(string name, Entity &out val)", asFUNCTIONPR(GetEntity, (std::string, entt::entity&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearEntity(string name)", asFUNCTIONPR(ClearEntity, (std::string), bool));
+
+            ScriptEngine::RegisterScriptFunction("DataKey Intern(const string &in name)", asFUNCTION(Intern));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU8(DataKey key, uint8 val)", asFUNCTIONPR(PutU8, (DataKey, u8), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU8(DataKey key, uint8 val)", asFUNCTIONPR(EmplaceU8, (DataKey, u8), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU8(DataKey key, uint8 &out val)", asFUNCTIONPR(GetU8, (DataKey, u8&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU8(DataKey key)", asFUNCTIONPR(ClearU8, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU16(DataKey key, uint16 val)", asFUNCTIONPR(PutU16, (DataKey, u16), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU16(DataKey key, uint16 val)", asFUNCTIONPR(EmplaceU16, (DataKey, u16), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU16(DataKey key, uint16 &out val)", asFUNCTIONPR(GetU16, (DataKey, u16&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU16(DataKey key)", asFUNCTIONPR(ClearU16, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU32(DataKey key, uint val)", asFUNCTIONPR(PutU32, (DataKey, u32), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU32(DataKey key, uint val)", asFUNCTIONPR(EmplaceU32, (DataKey, u32), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU32(DataKey key, uint &out val)", asFUNCTIONPR(GetU32, (DataKey, u32&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU32(DataKey key)", asFUNCTIONPR(ClearU32, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutU64(DataKey key, uint64 val)", asFUNCTIONPR(PutU64, (DataKey, u64), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceU64(DataKey key, uint64 val)", asFUNCTIONPR(EmplaceU64, (DataKey, u64), void));
+            ScriptEngine::RegisterScriptFunction("bool GetU64(DataKey key, uint64 &out val)", asFUNCTIONPR(GetU64, (DataKey, u64&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearU64(DataKey key)", asFUNCTIONPR(ClearU64, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutF32(DataKey key, float val)", asFUNCTIONPR(PutF32, (DataKey, f32), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceF32(DataKey key, float val)", asFUNCTIONPR(EmplaceF32, (DataKey, f32), void));
+            ScriptEngine::RegisterScriptFunction("bool GetF32(DataKey key, float &out val)", asFUNCTIONPR(GetF32, (DataKey, f32&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearF32(DataKey key)", asFUNCTIONPR(ClearF32, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutF64(DataKey key, double val)", asFUNCTIONPR(PutF64, (DataKey, f64), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceF64(DataKey key, double val)", asFUNCTIONPR(EmplaceF64, (DataKey, f64), void));
+            ScriptEngine::RegisterScriptFunction("bool GetF64(DataKey key, double &out val)", asFUNCTIONPR(GetF64, (DataKey, f64&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearF64(DataKey key)", asFUNCTIONPR(ClearF64, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutString(DataKey key, const string &in val)", asFUNCTIONPR(PutString, (DataKey, const std::string&), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceString(DataKey key, const string &in val)", asFUNCTIONPR(EmplaceString, (DataKey, const std::string&), void));
+            ScriptEngine::RegisterScriptFunction("bool GetString(DataKey key, string &out val)", asFUNCTIONPR(GetString, (DataKey, std::string&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearString(DataKey key)", asFUNCTIONPR(ClearString, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutPointer(DataKey key, void_ptr val)", asFUNCTIONPR(PutPointer, (DataKey, void*), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplacePointer(DataKey key, void_ptr val)", asFUNCTIONPR(EmplacePointer, (DataKey, void*), void));
+            ScriptEngine::RegisterScriptFunction("bool GetPointer(DataKey key, void_ptr &out val)", asFUNCTIONPR(GetPointer, (DataKey, void*&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearPointer(DataKey key)", asFUNCTIONPR(ClearPointer, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("bool PutEntity(DataKey key, Entity val)", asFUNCTIONPR(PutEntity, (DataKey, entt::entity), bool));
+            ScriptEngine::RegisterScriptFunction("void EmplaceEntity(DataKey key, Entity val)", asFUNCTIONPR(EmplaceEntity, (DataKey, entt::entity), void));
+            ScriptEngine::RegisterScriptFunction("bool GetEntity(DataKey key, Entity &out val)", asFUNCTIONPR(GetEntity, (DataKey, entt::entity&), bool));
+            ScriptEngine::RegisterScriptFunction("bool ClearEntity(DataKey key)", asFUNCTIONPR(ClearEntity, (DataKey), bool));
+
+            ScriptEngine::RegisterScriptFunction("uint PutU8Array(const array<DataKey>@ keys, const array<uint8>@ values)", asFUNCTION(PutU8Array));
+            ScriptEngine::RegisterScriptFunction("uint GetU8Array(const array<DataKey>@ keys, array<uint8>@ values)", asFUNCTION(GetU8Array));
+            ScriptEngine::RegisterScriptFunction("uint PutU16Array(const array<DataKey>@ keys, const array<uint16>@ values)", asFUNCTION(PutU16Array));
+            ScriptEngine::RegisterScriptFunction("uint GetU16Array(const array<DataKey>@ keys, array<uint16>@ values)", asFUNCTION(GetU16Array));
+            ScriptEngine::RegisterScriptFunction("uint PutU32Array(const array<DataKey>@ keys, const array<uint>@ values)", asFUNCTION(PutU32Array));
+            ScriptEngine::RegisterScriptFunction("uint GetU32Array(const array<DataKey>@ keys, array<uint>@ values)", asFUNCTION(GetU32Array));
+            ScriptEngine::RegisterScriptFunction("uint PutU64Array(const array<DataKey>@ keys, const array<uint64>@ values)", asFUNCTION(PutU64Array));
+            ScriptEngine::RegisterScriptFunction("uint GetU64Array(const array<DataKey>@ keys, array<uint64>@ values)", asFUNCTION(GetU64Array));
+            ScriptEngine::RegisterScriptFunction("uint PutF32Array(const array<DataKey>@ keys, const array<float>@ values)", asFUNCTION(PutF32Array));
+            ScriptEngine::RegisterScriptFunction("uint GetF32Array(const array<DataKey>@ keys, array<float>@ values)", asFUNCTION(GetF32Array));
+            ScriptEngine::RegisterScriptFunction("uint PutF64Array(const array<DataKey>@ keys, const array<double>@ values)", asFUNCTION(PutF64Array));
+            ScriptEngine::RegisterScriptFunction("uint GetF64Array(const array<DataKey>@ keys, array<double>@ values)", asFUNCTION(GetF64Array));
+            ScriptEngine::RegisterScriptFunction("uint PutEntityArray(const array<DataKey>@ keys, const array<Entity>@ values)", asFUNCTION(PutEntityArray));
+            ScriptEngine::RegisterScriptFunction("uint GetEntityArray(const array<DataKey>@ keys, array<Entity>@ values)", asFUNCTION(GetEntityArray));
         }
 
         r = ScriptEngine::ResetNamespace();
@@ -433,4 +500,299 @@ namespace ASDataStorageUtils
         u32 nameHash = StringUtils::fnv1a_32(name.c_str(), name.length());
         return dataStorageSingleton.storage.ClearEntity(nameHash);
     }
+
+    namespace
+    {
+        DataStorage& GetStorage()
+        {
+            entt::registry* registry = ServiceLocator::GetGameRegistry();
+            return registry->ctx<DataStorageSingleton>().storage;
+        }
+
+        // CScriptArray stores object subtypes like DataKey and Entity as pointers to the objects, only arrays of primitives are contiguous
+        template <typename T>
+        T* GetPrimitiveBuffer(CScriptArray* array)
+        {
+            return (array->GetElementTypeId() & asTYPEID_MASK_OBJECT) ? nullptr : static_cast<T*>(array->GetBuffer());
+        }
+
+        template <typename T>
+        T& GetElement(CScriptArray* array, T* primitiveBuffer, u32 index)
+        {
+            return primitiveBuffer ? primitiveBuffer[index] : *static_cast<T*>(array->At(index));
+        }
+
+        template <typename T, typename PutFunction>
+        u32 PutArray(CScriptArray* keys, CScriptArray* values, PutFunction&& put)
+        {
+            if (!keys || !values)
+                return 0;
+
+            DataStorage& storage = GetStorage();
+            T* valueData = GetPrimitiveBuffer<T>(values);
+
+            const u32 count = std::min(keys->GetSize(), values->GetSize());
+            u32 numPut = 0;
+            for (u32 i = 0; i < count; i++)
+            {
+                const DataKey key = *static_cast<const DataKey*>(keys->At(i));
+                numPut += put(storage, static_cast<u32>(key), GetElement<T>(values, valueData, i));
+            }
+
+            return numPut;
+        }
+
+        // Values of keys that weren't found are set to missingValue, Resize leaves primitives uninitialized
+        template <typename T, typename GetFunction>
+        u32 GetArray(CScriptArray* keys, CScriptArray* values, GetFunction&& get, T missingValue = T())
+        {
+            if (!keys || !values)
+                return 0;
+
+            values->Resize(keys->GetSize());
+
+            DataStorage& storage = GetStorage();
+            T* valueData = GetPrimitiveBuffer<T>(values);
+
+            const u32 count = keys->GetSize();
+            u32 numFound = 0;
+            for (u32 i = 0; i < count; i++)
+            {
+                const DataKey key = *static_cast<const DataKey*>(keys->At(i));
+                T& value = GetElement<T>(values, valueData, i);
+
+                if (get(storage, static_cast<u32>(key), value))
+                {
+                    numFound++;
+                }
+                else
+                {
+                    value = missingValue;
+                }
+            }
+
+            return numFound;
+        }
+    }
+
+    DataKey Intern(const std::string& name)
+    {
+        return static_cast<DataKey>(StringUtils::fnv1a_32(name.c_str(), name.length()));
+    }
+
+    bool PutU8(DataKey key, u8 val)
+    {
+        return GetStorage().PutU8(static_cast<u32>(key), val);
+    }
+    void EmplaceU8(DataKey key, u8 val)
+    {
+        GetStorage().EmplaceU8(static_cast<u32>(key), val);
+    }
+    bool GetU8(DataKey key, u8& val)
+    {
+        return GetStorage().GetU8(static_cast<u32>(key), val);
+    }
+    bool ClearU8(DataKey key)
+    {
+        return GetStorage().ClearU8(static_cast<u32>(key));
+    }
+
+    bool PutU16(DataKey key, u16 val)
+    {
+        return GetStorage().PutU16(static_cast<u32>(key), val);
+    }
+    void EmplaceU16(DataKey key, u16 val)
+    {
+        GetStorage().EmplaceU16(static_cast<u32>(key), val);
+    }
+    bool GetU16(DataKey key, u16& val)
+    {
+        return GetStorage().GetU16(static_cast<u32>(key), val);
+    }
+    bool ClearU16(DataKey key)
+    {
+        return GetStorage().ClearU16(static_cast<u32>(key));
+    }
+
+    bool PutU32(DataKey key, u32 val)
+    {
+        return GetStorage().PutU32(static_cast<u32>(key), val);
+    }
+    void EmplaceU32(DataKey key, u32 val)
+    {
+        GetStorage().EmplaceU32(static_cast<u32>(key), val);
+    }
+    bool GetU32(DataKey key, u32& val)
+    {
+        return GetStorage().GetU32(static_cast<u32>(key), val);
+    }
+    bool ClearU32(DataKey key)
+    {
+        return GetStorage().ClearU32(static_cast<u32>(key));
+    }
+
+    bool PutU64(DataKey key, u64 val)
+    {
+        return GetStorage().PutU64(static_cast<u32>(key), val);
+    }
+    void EmplaceU64(DataKey key, u64 val)
+    {
+        GetStorage().EmplaceU64(static_cast<u32>(key), val);
+    }
+    bool GetU64(DataKey key, u64& val)
+    {
+        return GetStorage().GetU64(static_cast<u32>(key), val);
+    }
+    bool ClearU64(DataKey key)
+    {
+        return GetStorage().ClearU64(static_cast<u32>(key));
+    }
+
+    bool PutF32(DataKey key, f32 val)
+    {
+        return GetStorage().PutF32(static_cast<u32>(key), val);
+    }
+    void EmplaceF32(DataKey key, f32 val)
+    {
+        GetStorage().EmplaceF32(static_cast<u32>(key), val);
+    }
+    bool GetF32(DataKey key, f32& val)
+    {
+        return GetStorage().GetF32(static_cast<u32>(key), val);
+    }
+    bool ClearF32(DataKey key)
+    {
+        return GetStorage().ClearF32(static_cast<u32>(key));
+    }
+
+    bool PutF64(DataKey key, f64 val)
+    {
+        return GetStorage().PutF64(static_cast<u32>(key), val);
+    }
+    void EmplaceF64(DataKey key, f64 val)
+    {
+        GetStorage().EmplaceF64(static_cast<u32>(key), val);
+    }
+    bool GetF64(DataKey key, f64& val)
+    {
+        return GetStorage().GetF64(static_cast<u32>(key), val);
+    }
+    bool ClearF64(DataKey key)
+    {
+        return GetStorage().ClearF64(static_cast<u32>(key));
+    }
+
+    bool PutString(DataKey key, const std::string& val)
+    {
+        return GetStorage().PutString(static_cast<u32>(key), val);
+    }
+    void EmplaceString(DataKey key, const std::string& val)
+    {
+        GetStorage().EmplaceString(static_cast<u32>(key), val);
+    }
+    bool GetString(DataKey key, std::string& val)
+    {
+        return GetStorage().GetString(static_cast<u32>(key), val);
+    }
+    bool ClearString(DataKey key)
+    {
+        return GetStorage().ClearString(static_cast<u32>(key));
+    }
+
+    bool PutPointer(DataKey key, void* val)
+    {
+        return GetStorage().PutPointer(static_cast<u32>(key), val);
+    }
+    void EmplacePointer(DataKey key, void* val)
+    {
+        GetStorage().EmplacePointer(static_cast<u32>(key), val);
+    }
+    bool GetPointer(DataKey key, void*& val)
+    {
+        return GetStorage().GetPointer(static_cast<u32>(key), val);
+    }
+    bool ClearPointer(DataKey key)
+    {
+        return GetStorage().ClearPointer(static_cast<u32>(key));
+    }
+
+    bool PutEntity(DataKey key, entt::entity val)
+    {
+        return GetStorage().PutEntity(static_cast<u32>(key), val);
+    }
+    void EmplaceEntity(DataKey key, entt::entity val)
+    {
+        GetStorage().EmplaceEntity(static_cast<u32>(key), val);
+    }
+    bool GetEntity(DataKey key, entt::entity& val)
+    {
+        return GetStorage().GetEntity(static_cast<u32>(key), val);
+    }
+    bool ClearEntity(DataKey key)
+    {
+        return GetStorage().ClearEntity(static_cast<u32>(key));
+    }
+
+    u32 PutU8Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<u8>(keys, values, [](DataStorage& storage, u32 key, u8 val) { return storage.PutU8(key, val); });
+    }
+    u32 GetU8Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<u8>(keys, values, [](DataStorage& storage, u32 key, u8& val) { return storage.GetU8(key, val); });
+    }
+
+    u32 PutU16Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<u16>(keys, values, [](DataStorage& storage, u32 key, u16 val) { return storage.PutU16(key, val); });
+    }
+    u32 GetU16Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<u16>(keys, values, [](DataStorage& storage, u32 key, u16& val) { return storage.GetU16(key, val); });
+    }
+
+    u32 PutU32Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<u32>(keys, values, [](DataStorage& storage, u32 key, u32 val) { return storage.PutU32(key, val); });
+    }
+    u32 GetU32Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<u32>(keys, values, [](DataStorage& storage, u32 key, u32& val) { return storage.GetU32(key, val); });
+    }
+
+    u32 PutU64Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<u64>(keys, values, [](DataStorage& storage, u32 key, u64 val) { return storage.PutU64(key, val); });
+    }
+    u32 GetU64Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<u64>(keys, values, [](DataStorage& storage, u32 key, u64& val) { return storage.GetU64(key, val); });
+    }
+
+    u32 PutF32Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<f32>(keys, values, [](DataStorage& storage, u32 key, f32 val) { return storage.PutF32(key, val); });
+    }
+    u32 GetF32Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<f32>(keys, values, [](DataStorage& storage, u32 key, f32& val) { return storage.GetF32(key, val); });
+    }
+
+    u32 PutF64Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<f64>(keys, values, [](DataStorage& storage, u32 key, f64 val) { return storage.PutF64(key, val); });
+    }
+    u32 GetF64Array(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<f64>(keys, values, [](DataStorage& storage, u32 key, f64& val) { return storage.GetF64(key, val); });
+    }
+
+    u32 PutEntityArray(CScriptArray* keys, CScriptArray* values)
+    {
+        return PutArray<entt::entity>(keys, values, [](DataStorage& storage, u32 key, entt::entity val) { return storage.PutEntity(key, val); });
+    }
+    u32 GetEntityArray(CScriptArray* keys, CScriptArray* values)
+    {
+        return GetArray<entt::entity>(keys, values, [](DataStorage& storage, u32 key, entt::entity& val) { return storage.GetEntity(key, val); }, entt::null);
+    }
 }
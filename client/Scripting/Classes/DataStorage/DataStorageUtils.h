@@ -2,10 +2,17 @@
 #include <NovusTypes.h>
 #include <entity/fwd.hpp>
 
+class CScriptArray;
+
 namespace ASDataStorageUtils
 {
+    // Scripts intern a key once and pass it to the DataKey overloads, which skip marshalling and hashing the name on every call
+    enum class DataKey : u32 {};
+
     void RegisterNamespace();
 
+    DataKey Intern(const std::string& name);
+
     bool PutU8(std::string name, u8 val);
     void EmplaceU8(std::string name, u8 val);
     bool GetU8(std::string name, u8& val);
@@ -50,4 +57,67 @@ namespace ASDataStorageUtils
     void EmplaceEntity(std::string name, entt::entity val);
     bool GetEntity(std::string name, entt::entity& val);
     bool ClearEntity(std::string name);
+
+    bool PutU8(DataKey key, u8 val);
+    void EmplaceU8(DataKey key, u8 val);
+    bool GetU8(DataKey key, u8& val);
+    bool ClearU8(DataKey key);
+
+    bool PutU16(DataKey key, u16 val);
+    void EmplaceU16(DataKey key, u16 val);
+    bool GetU16(DataKey key, u16& val);
+    bool ClearU16(DataKey key);
+
+    bool PutU32(DataKey key, u32 val);
+    void EmplaceU32(DataKey key, u32 val);
+    bool GetU32(DataKey key, u32& val);
+    bool ClearU32(DataKey key);
+
+    bool PutU64(DataKey key, u64 val);
+    void EmplaceU64(DataKey key, u64 val);
+    bool GetU64(DataKey key, u64& val);
+    bool ClearU64(DataKey key);
+
+    bool PutF32(DataKey key, f32 val);
+    void EmplaceF32(DataKey key, f32 val);
+    bool GetF32(DataKey key, f32& val);
+    bool ClearF32(DataKey key);
+
+    bool PutF64(DataKey key, f64 val);
+    void EmplaceF64(DataKey key, f64 val);
+    bool GetF64(DataKey key, f64& val);
+    bool ClearF64(DataKey key);
+
+    bool PutString(DataKey key, const std::string& val);
+    void EmplaceString(DataKey key, const std::string& val);
+    bool GetString(DataKey key, std::string& val);
+    bool ClearString(DataKey key);
+
+    bool PutPointer(DataKey key, void* val);
+    void EmplacePointer(DataKey key, void* val);
+    bool GetPointer(DataKey key, void*& val);
+    bool ClearPointer(DataKey key);
+
+    bool PutEntity(DataKey key, entt::entity val);
+    void EmplaceEntity(DataKey key, entt::entity val);
+    bool GetEntity(DataKey key, entt::entity& val);
+    bool ClearEntity(DataKey key);
+
+    // Bulk versions take an array of keys and an array of values with one value per key
+    // Put returns how many values were put, Get resizes values to match keys and returns how many keys were found
+    // Get sets the values of keys that weren't found to 0, or to a null entity for GetEntityArray
+    u32 PutU8Array(CScriptArray* keys, CScriptArray* values);
+    u32 GetU8Array(CScriptArray* keys, CScriptArray* values);
+    u32 PutU16Array(CScriptArray* keys, CScriptArray* values);
+    u32 GetU16Array(CScriptArray* keys, CScriptArray* values);
+    u32 PutU32Array(CScriptArray* keys, CScriptArray* values);
+    u32 GetU32Array(CScriptArray* keys, CScriptArray* values);
+    u32 PutU64Array(CScriptArray* keys, CScriptArray* values);
+    u32 GetU64Array(CScriptArray* keys, CScriptArray* values);
+    u32 PutF32Array(CScriptArray* keys, CScriptArray* values);
+    u32 GetF32Array(CScriptArray* keys, CScriptArray* values);
+    u32 PutF64Array(CScriptArray* keys, CScriptArray* values);
+    u32 GetF64Array(CScriptArray* keys, CScriptArray* values);
+    u32 PutEntityArray(CScriptArray* keys, CScriptArray* values);
+    u32 GetEntityArray(CScriptArray* keys, CScriptArray* values);
 };
\ No newline at end of file
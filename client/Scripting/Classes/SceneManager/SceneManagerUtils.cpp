@@ -27,29 +27,19 @@ namespace ASSceneManagerUtils
         entt::registry* registry = ServiceLocator::GetGameRegistry();
         SceneManagerSingleton& scriptSceneSingleton = registry->ctx<SceneManagerSingleton>();
 
+        ScriptCallbackBatch batch;
         for (auto& sceneCallback : scriptSceneSingleton.sceneAnyLoadedCallback)
         {
-            asIScriptContext* context = ScriptEngine::GetScriptContext();
-            {
-                context->Prepare(sceneCallback.callback);
-                {
-                    context->SetArgDWord(0, sceneLoaded);
-                }
-                context->Execute();
-            }
+            batch.Add(sceneCallback.callback, sceneLoaded);
         }
 
         for (auto& sceneCallback : scriptSceneSingleton.sceneLoadedCallback[sceneLoaded])
         {
-            asIScriptContext* context = ScriptEngine::GetScriptContext();
-            {
-                context->Prepare(sceneCallback.callback);
-                {
-                    context->SetArgDWord(0, sceneLoaded);
-                }
-                context->Execute();
-            }
+            batch.Add(sceneCallback.callback, sceneLoaded);
         }
+
+        // The any scene callbacks have to run before the scene specific ones, so keep the order they were added in
+        batch.Execute();
     }
     
     void RegisterSceneLoadedCallback(std::string sceneName, std::string callbackName, asIScriptFunction* callback)
@@ -0,0 +1,433 @@
+#include "ScriptCache.h"
+#include <Utils/DebugHandler.h>
+#include <Utils/XXHash64.h>
+#include <cstring>
+#include <fstream>
+
+#include "Addons/scriptbuilder/scriptbuilder.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    class ByteCodeStream : public asIBinaryStream
+    {
+    public:
+        int Write(const void* ptr, asUINT size) override
+        {
+            const u8* bytes = static_cast<const u8*>(ptr);
+            data.insert(data.end(), bytes, bytes + size);
+            return 0;
+        }
+
+        int Read(void* ptr, asUINT size) override
+        {
+            if (readOffset + size > data.size())
+                return -1;
+
+            std::memcpy(ptr, &data[readOffset], size);
+            readOffset += size;
+            return 0;
+        }
+
+        std::vector<u8> data;
+        size_t readOffset = 0;
+    };
+
+    void HashString(XXHash64& hash, const char* string)
+    {
+        if (string)
+        {
+            hash.add(string, strlen(string) + 1);
+        }
+    }
+
+    void HashFunction(XXHash64& hash, const asIScriptFunction* function)
+    {
+        if (function)
+        {
+            HashString(hash, function->GetDeclaration(true, true, true));
+        }
+    }
+
+    void HashType(XXHash64& hash, const asITypeInfo* type)
+    {
+        HashString(hash, type->GetNamespace());
+        HashString(hash, type->GetName());
+
+        const asQWORD flags = type->GetFlags();
+        const i32 size = type->GetSize();
+        hash.add(&flags, sizeof(flags));
+        hash.add(&size, sizeof(size));
+
+        for (asUINT i = 0; i < type->GetBehaviourCount(); i++)
+        {
+            asEBehaviours behaviour;
+            HashFunction(hash, type->GetBehaviourByIndex(i, &behaviour));
+            hash.add(&behaviour, sizeof(behaviour));
+        }
+
+        for (asUINT i = 0; i < type->GetFactoryCount(); i++)
+        {
+            HashFunction(hash, type->GetFactoryByIndex(i));
+        }
+
+        for (asUINT i = 0; i < type->GetMethodCount(); i++)
+        {
+            HashFunction(hash, type->GetMethodByIndex(i, false));
+        }
+
+        for (asUINT i = 0; i < type->GetPropertyCount(); i++)
+        {
+            HashString(hash, type->GetPropertyDeclaration(i, true));
+        }
+
+        for (asUINT i = 0; i < type->GetEnumValueCount(); i++)
+        {
+            i32 value = 0;
+            HashString(hash, type->GetEnumValueByIndex(i, &value));
+            hash.add(&value, sizeof(value));
+        }
+
+        HashFunction(hash, type->GetFuncdefSignature());
+    }
+}
+
+bool ScriptCache::IsUpToDate(asIScriptEngine* engine, const std::string& moduleName)
+{
+    auto itr = _loadedModules.find(moduleName);
+    if (itr == _loadedModules.end())
+        return false;
+
+    if (!engine->GetModule(moduleName.c_str(), asGM_ONLY_IF_EXISTS) || !AreDependenciesUnchanged(itr->second))
+    {
+        _loadedModules.erase(itr);
+        return false;
+    }
+
+    return true;
+}
+
+bool ScriptCache::IsCached(asIScriptEngine* engine, const fs::path& relativePath)
+{
+    std::ifstream file(GetCachePath(relativePath), std::ifstream::in | std::ifstream::binary);
+    if (!file)
+        return false;
+
+    CacheFileHeader header;
+    std::vector<Dependency> dependencies;
+    return ReadHeader(engine, file, header, dependencies);
+}
+
+bool ScriptCache::Load(asIScriptEngine* engine, const std::string& moduleName, const fs::path& relativePath)
+{
+    std::ifstream file(GetCachePath(relativePath), std::ifstream::in | std::ifstream::binary);
+    if (!file)
+        return false;
+
+    CacheFileHeader header;
+    std::vector<Dependency> dependencies;
+    if (!ReadHeader(engine, file, header, dependencies))
+        return false;
+
+    ByteCodeStream stream;
+    stream.data.resize(header.byteCodeSize);
+    file.read(reinterpret_cast<char*>(stream.data.data()), header.byteCodeSize);
+
+    // A torn or truncated write must never reach LoadByteCode
+    if (!file || XXHash64::hash(stream.data.data(), stream.data.size(), 0) != header.byteCodeHash)
+    {
+        NC_LOG_WARNING("[Script]: Cache file for %s is corrupt, recompiling", moduleName.c_str());
+        return false;
+    }
+
+    asIScriptModule* module = engine->GetModule(moduleName.c_str(), asGM_ALWAYS_CREATE);
+    if (module->LoadByteCode(&stream) < 0)
+    {
+        NC_LOG_WARNING("[Script]: Failed to load cached bytecode for %s, recompiling", moduleName.c_str());
+        module->Discard();
+        return false;
+    }
+
+    _loadedModules[moduleName] = std::move(dependencies);
+    return true;
+}
+
+bool ScriptCache::Save(asIScriptEngine* engine, const std::string& moduleName, const fs::path& relativePath, const CScriptBuilder& builder)
+{
+    std::vector<Dependency> dependencies;
+    if (!GetDependencies(builder, dependencies))
+        return false;
+
+    std::vector<u8> byteCode;
+    if (!SaveByteCode(engine->GetModule(moduleName.c_str(), asGM_ONLY_IF_EXISTS), byteCode))
+        return false;
+
+    if (!Write(engine, relativePath, dependencies, byteCode))
+        return false;
+
+    _loadedModules[moduleName] = std::move(dependencies);
+    return true;
+}
+
+bool ScriptCache::Swap(asIScriptEngine* engine, const std::string& moduleName, const fs::path& relativePath, std::vector<Dependency>& dependencies, const std::vector<u8>& byteCode)
+{
+    ByteCodeStream stream;
+    stream.data = byteCode;
+
+    asIScriptModule* module = engine->GetModule(moduleName.c_str(), asGM_ALWAYS_CREATE);
+    if (module->LoadByteCode(&stream) < 0)
+    {
+        NC_LOG_ERROR("[Script]: Failed to load the rebuilt bytecode for %s", moduleName.c_str());
+        module->Discard();
+        _loadedModules.erase(moduleName);
+        return false;
+    }
+
+    Write(engine, relativePath, dependencies, byteCode);
+
+    _loadedModules[moduleName] = std::move(dependencies);
+    return true;
+}
+
+void ScriptCache::Remove(const std::string& moduleName, const fs::path& relativePath)
+{
+    _loadedModules.erase(moduleName);
+
+    std::error_code errorCode;
+    fs::remove(GetCachePath(relativePath), errorCode);
+}
+
+void ScriptCache::GetDependents(const fs::path& path, std::vector<fs::path>& scriptPaths) const
+{
+    for (auto& [moduleName, dependencies] : _loadedModules)
+    {
+        for (size_t i = 1; i < dependencies.size(); i++)
+        {
+            if (fs::path(dependencies[i].path).lexically_normal() == path)
+            {
+                scriptPaths.push_back(dependencies[0].path);
+                break;
+            }
+        }
+    }
+}
+
+void ScriptCache::GetDependencyPaths(const std::string& moduleName, std::vector<std::string>& paths) const
+{
+    auto itr = _loadedModules.find(moduleName);
+    if (itr == _loadedModules.end())
+        return;
+
+    for (const Dependency& dependency : itr->second)
+    {
+        paths.push_back(dependency.path);
+    }
+}
+
+bool ScriptCache::GetDependencies(const CScriptBuilder& builder, std::vector<Dependency>& dependencies)
+{
+    dependencies.resize(builder.GetSectionCount());
+    for (u32 i = 0; i < dependencies.size(); i++)
+    {
+        Dependency& dependency = dependencies[i];
+        dependency.path = builder.GetSectionName(i);
+
+        if (!HashFile(dependency.path, dependency.hash))
+            return false;
+    }
+
+    return !dependencies.empty();
+}
+
+bool ScriptCache::SaveByteCode(asIScriptModule* module, std::vector<u8>& byteCode)
+{
+    // Debug info is kept so script errors still point at the right line
+    ByteCodeStream stream;
+    if (!module || module->SaveByteCode(&stream, false) < 0)
+        return false;
+
+    byteCode = std::move(stream.data);
+    return true;
+}
+
+bool ScriptCache::Write(asIScriptEngine* engine, const fs::path& relativePath, const std::vector<Dependency>& dependencies, const std::vector<u8>& byteCode)
+{
+    CacheFileHeader header;
+    header.numDependencies = static_cast<u32>(dependencies.size());
+    header.interfaceHash = GetInterfaceHash(engine);
+    header.byteCodeHash = XXHash64::hash(byteCode.data(), byteCode.size(), 0);
+    header.byteCodeSize = byteCode.size();
+
+    const fs::path cachePath = GetCachePath(relativePath);
+    fs::path tempPath = cachePath;
+    tempPath += ".tmp";
+
+    std::error_code errorCode;
+    fs::create_directories(cachePath.parent_path(), errorCode);
+
+    {
+        std::ofstream file(tempPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!file)
+        {
+            NC_LOG_WARNING("[Script]: Failed to create cache file %s", tempPath.string().c_str());
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(CacheFileHeader));
+        for (const Dependency& dependency : dependencies)
+        {
+            const u16 pathLength = static_cast<u16>(dependency.path.size());
+            file.write(reinterpret_cast<const char*>(&pathLength), sizeof(u16));
+            file.write(dependency.path.data(), pathLength);
+            file.write(reinterpret_cast<const char*>(&dependency.hash), sizeof(u64));
+        }
+        file.write(reinterpret_cast<const char*>(byteCode.data()), byteCode.size());
+
+        if (!file)
+        {
+            file.close();
+            fs::remove(tempPath, errorCode);
+            return false;
+        }
+    }
+
+    // Written next to it and renamed over it so a reader never sees a half written file
+    fs::rename(tempPath, cachePath, errorCode);
+    if (errorCode)
+    {
+        fs::remove(tempPath, errorCode);
+        return false;
+    }
+
+    return true;
+}
+
+u64 ScriptCache::GetInterfaceHash(asIScriptEngine* engine)
+{
+    if (_interfaceHashEngine == engine)
+        return _interfaceHash;
+
+    XXHash64 hash(0);
+    HashString(hash, asGetLibraryOptions());
+
+    for (asUINT i = 0; i < engine->GetObjectTypeCount(); i++)
+    {
+        HashType(hash, engine->GetObjectTypeByIndex(i));
+    }
+
+    for (asUINT i = 0; i < engine->GetEnumCount(); i++)
+    {
+        HashType(hash, engine->GetEnumByIndex(i));
+    }
+
+    for (asUINT i = 0; i < engine->GetFuncdefCount(); i++)
+    {
+        HashType(hash, engine->GetFuncdefByIndex(i));
+    }
+
+    for (asUINT i = 0; i < engine->GetTypedefCount(); i++)
+    {
+        HashType(hash, engine->GetTypedefByIndex(i));
+    }
+
+    for (asUINT i = 0; i < engine->GetGlobalFunctionCount(); i++)
+    {
+        HashFunction(hash, engine->GetGlobalFunctionByIndex(i));
+    }
+
+    for (asUINT i = 0; i < engine->GetGlobalPropertyCount(); i++)
+    {
+        const char* name = nullptr;
+        const char* nameSpace = nullptr;
+        i32 typeId = 0;
+        bool isConst = false;
+        engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId, &isConst);
+
+        HashString(hash, nameSpace);
+        HashString(hash, name);
+        HashString(hash, engine->GetTypeDeclaration(typeId, true));
+        hash.add(&isConst, sizeof(bool));
+    }
+
+    _interfaceHashEngine = engine;
+    _interfaceHash = hash.hash();
+    return _interfaceHash;
+}
+
+bool ScriptCache::HashFile(const fs::path& path, u64& hash)
+{
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    if (!file)
+        return false;
+
+    std::vector<char> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(data.data(), data.size());
+
+    if (!file)
+        return false;
+
+    hash = XXHash64::hash(data.data(), data.size(), 0);
+    return true;
+}
+
+bool ScriptCache::ReadHeader(asIScriptEngine* engine, std::ifstream& file, CacheFileHeader& header, std::vector<Dependency>& dependencies)
+{
+    file.seekg(0, std::ifstream::end);
+    const std::streamoff fileSize = file.tellg();
+    file.seekg(0, std::ifstream::beg);
+
+    if (!file || fileSize < static_cast<std::streamoff>(sizeof(CacheFileHeader)))
+        return false;
+
+    file.read(reinterpret_cast<char*>(&header), sizeof(CacheFileHeader));
+
+    if (!file || header.magic != CacheFileHeader::MAGIC || header.version != CacheFileHeader::VERSION ||
+        header.engineVersion != ANGELSCRIPT_VERSION || header.interfaceHash != GetInterfaceHash(engine))
+        return false;
+
+    // The counts come straight from the file, a damaged one must not turn into a huge resize. Whatever doesn't fit is a cache miss
+    constexpr u64 MIN_DEPENDENCY_SIZE = sizeof(u16) + sizeof(u64);
+    u64 remainingBytes = static_cast<u64>(fileSize) - sizeof(CacheFileHeader);
+    if (header.byteCodeSize > remainingBytes || header.numDependencies > (remainingBytes - header.byteCodeSize) / MIN_DEPENDENCY_SIZE)
+        return false;
+
+    u64 pathBytes = remainingBytes - header.byteCodeSize - header.numDependencies * MIN_DEPENDENCY_SIZE;
+
+    dependencies.resize(header.numDependencies);
+    for (Dependency& dependency : dependencies)
+    {
+        u16 pathLength = 0;
+        file.read(reinterpret_cast<char*>(&pathLength), sizeof(u16));
+
+        if (!file || pathLength > pathBytes)
+            return false;
+
+        pathBytes -= pathLength;
+        dependency.path.resize(pathLength);
+        file.read(dependency.path.data(), pathLength);
+        file.read(reinterpret_cast<char*>(&dependency.hash), sizeof(u64));
+    }
+
+    return file && AreDependenciesUnchanged(dependencies);
+}
+
+fs::path ScriptCache::GetCachePath(const fs::path& relativePath) const
+{
+    fs::path cachePath = _directory / relativePath;
+    cachePath += ".asbc";
+    return cachePath;
+}
+
+bool ScriptCache::AreDependenciesUnchanged(const std::vector<Dependency>& dependencies)
+{
+    for (const Dependency& dependency : dependencies)
+    {
+        u64 hash = 0;
+        if (!HashFile(dependency.path, hash) || hash != dependency.hash)
+            return false;
+    }
+
+    return true;
+}
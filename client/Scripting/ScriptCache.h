@@ -0,0 +1,94 @@
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "angelscript.h"
+
+class CScriptBuilder;
+
+// Stores compiled modules as AngelScript bytecode under a cache directory, one file per script mirroring the script folder
+// A cache file is only loaded if it was saved by the same engine version against the same registered interface, and every
+// file the module was built from (the script and anything it #includes) still hashes the same
+class ScriptCache
+{
+public:
+    struct CacheFileHeader
+    {
+        static constexpr u32 MAGIC = 0x4353434E; // "NCSC"
+        static constexpr u32 VERSION = 1;
+
+        u32 magic = MAGIC;
+        u32 version = VERSION;
+        u32 engineVersion = ANGELSCRIPT_VERSION;
+        u32 numDependencies = 0;
+        u64 interfaceHash = 0;
+        u64 byteCodeHash = 0;
+        u64 byteCodeSize = 0;
+    };
+
+    struct Dependency
+    {
+        std::string path;
+        u64 hash = 0;
+    };
+
+    void SetDirectory(const std::filesystem::path& directory) { _directory = directory; }
+    const std::filesystem::path& GetDirectory() const { return _directory; }
+
+    // Returns true if the module is already loaded in the engine and none of its files changed since, it doesn't need to be touched
+    bool IsUpToDate(asIScriptEngine* engine, const std::string& moduleName);
+
+    // Returns true if relativePath has a valid cache file, without loading it
+    bool IsCached(asIScriptEngine* engine, const std::filesystem::path& relativePath);
+
+    // Creates the module from its cache file, returns false if there is no valid cache file and it has to be compiled
+    bool Load(asIScriptEngine* engine, const std::string& moduleName, const std::filesystem::path& relativePath);
+
+    // Saves a module that was just built by builder, failing to save only means it gets compiled again next time
+    bool Save(asIScriptEngine* engine, const std::string& moduleName, const std::filesystem::path& relativePath, const CScriptBuilder& builder);
+
+    // Creates the module from bytecode that was compiled by another engine with the same registered interface and saves it to the cache
+    bool Swap(asIScriptEngine* engine, const std::string& moduleName, const std::filesystem::path& relativePath, std::vector<Dependency>& dependencies, const std::vector<u8>& byteCode);
+
+    // Forgets a module and deletes its cache file, used when its script is removed
+    void Remove(const std::string& moduleName, const std::filesystem::path& relativePath);
+
+    // Forgets which modules are loaded, call this when they are discarded from the engine
+    void Clear() { _loadedModules.clear(); }
+
+    // Returns the script path of every loaded module that #includes path
+    void GetDependents(const std::filesystem::path& path, std::vector<std::filesystem::path>& scriptPaths) const;
+
+    // Paths of every file a loaded module was built from, empty if the module isn't loaded
+    void GetDependencyPaths(const std::string& moduleName, std::vector<std::string>& paths) const;
+
+    // Hash of every type, function and property registered with the engine, bytecode references these by declaration
+    u64 GetInterfaceHash(asIScriptEngine* engine);
+
+    static bool HashFile(const std::filesystem::path& path, u64& hash);
+
+    // The first dependency is always the script the module was built from
+    static bool GetDependencies(const CScriptBuilder& builder, std::vector<Dependency>& dependencies);
+    static bool SaveByteCode(asIScriptModule* module, std::vector<u8>& byteCode);
+
+private:
+    bool Write(asIScriptEngine* engine, const std::filesystem::path& relativePath, const std::vector<Dependency>& dependencies, const std::vector<u8>& byteCode);
+
+    // Reads and validates everything in front of the bytecode
+    bool ReadHeader(asIScriptEngine* engine, std::ifstream& file, CacheFileHeader& header, std::vector<Dependency>& dependencies);
+
+    std::filesystem::path GetCachePath(const std::filesystem::path& relativePath) const;
+    static bool AreDependenciesUnchanged(const std::vector<Dependency>& dependencies);
+
+private:
+    std::filesystem::path _directory;
+
+    // Dependencies of the modules that are currently loaded in the engine, keyed by module name
+    std::unordered_map<std::string, std::vector<Dependency>> _loadedModules;
+
+    asIScriptEngine* _interfaceHashEngine = nullptr;
+    u64 _interfaceHash = 0;
+};
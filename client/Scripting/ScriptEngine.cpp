@@ -14,11 +14,26 @@
 #include "../UI/angelscript/UITypeRegister.h"
 
 #include <entity/entity.hpp>
+#include <algorithm>
 
 
 thread_local asIScriptEngine* ScriptEngine::_scriptEngine = nullptr;
-thread_local asIScriptContext* ScriptEngine::_scriptContext = nullptr;
 thread_local std::string ScriptEngine::_scriptCurrentObjectName = "";
+thread_local std::vector<asIScriptContext*> ScriptEngine::_contextPool;
+
+namespace
+{
+    // AngelScript and its addons request contexts through these when they call back into scripts themselves (array sorting etc)
+    asIScriptContext* RequestContextCallback(asIScriptEngine* engine, void* param)
+    {
+        return ScriptEngine::RequestContext();
+    }
+
+    void ReturnContextCallback(asIScriptEngine* engine, asIScriptContext* context, void* param)
+    {
+        ScriptEngine::ReturnContext(context);
+    }
+}
 
 void ScriptEngine::Initialize()
 {
@@ -26,13 +41,9 @@ void ScriptEngine::Initialize()
     {
         _scriptEngine = asCreateScriptEngine();
         _scriptEngine->SetEngineProperty(asEP_DISALLOW_GLOBAL_VARS, true);
+        _scriptEngine->SetContextCallbacks(RequestContextCallback, ReturnContextCallback, nullptr);
         RegisterFunctions();
     }
-
-    if (!_scriptContext)
-    {
-        _scriptContext = _scriptEngine->CreateContext();
-    }
 }
 
 asIScriptEngine* ScriptEngine::GetScriptEngine()
@@ -41,10 +52,48 @@ asIScriptEngine* ScriptEngine::GetScriptEngine()
     return _scriptEngine;
 }
 
-asIScriptContext* ScriptEngine::GetScriptContext()
+void ScriptEngine::Shutdown()
+{
+    if (!_scriptEngine)
+        return;
+
+    for (asIScriptContext* context : _contextPool)
+    {
+        context->Release();
+    }
+    _contextPool.clear();
+
+    _scriptEngine->ShutDownAndRelease();
+    _scriptEngine = nullptr;
+}
+
+asIScriptContext* ScriptEngine::RequestContext()
 {
     Initialize();
-    return _scriptContext;
+
+    asIScriptContext* context = asGetActiveContext();
+    if (context && context->GetEngine() == _scriptEngine && context->PushState() >= 0)
+        return context;
+
+    if (_contextPool.empty())
+        return _scriptEngine->CreateContext();
+
+    context = _contextPool.back();
+    _contextPool.pop_back();
+    return context;
+}
+
+void ScriptEngine::ReturnContext(asIScriptContext* context)
+{
+    if (context->IsNested())
+    {
+        context->PopState();
+        return;
+    }
+
+    // Unprepare releases whatever the last call left referenced, the context itself is kept for the next request
+    context->Unprepare();
+    _contextPool.push_back(context);
 }
 
 i32 ScriptEngine::SetNamespace(std::string name)
@@ -134,3 +183,63 @@ void ScriptEngine::Print(std::string& message)
 {
     NC_LOG_MESSAGE("[Script]: %s", message.c_str());
 }
+
+void ScriptCallbackBatch::Add(asIScriptFunction* function, void* object)
+{
+    Callback& callback = _callbacks.emplace_back();
+    callback.function = function;
+    callback.object = object;
+    callback.isObject = true;
+}
+
+void ScriptCallbackBatch::Add(asIScriptFunction* function, u32 value)
+{
+    Callback& callback = _callbacks.emplace_back();
+    callback.function = function;
+    callback.value = value;
+}
+
+u32 ScriptCallbackBatch::Execute(bool groupByFunction)
+{
+    if (_callbacks.empty())
+        return 0;
+
+    if (groupByFunction)
+    {
+        std::stable_sort(_callbacks.begin(), _callbacks.end(), [](const Callback& a, const Callback& b)
+        {
+            return a.function < b.function;
+        });
+    }
+
+    u32 numFailed = 0;
+    asIScriptContext* context = ScriptEngine::RequestContext();
+
+    for (size_t i = 0; i < _callbacks.size(); i++)
+    {
+        const Callback& callback = _callbacks[i];
+
+        // Preparing the function the context just ran again is cheap, AngelScript keeps the call setup around
+        context->Prepare(callback.function);
+        {
+            if (callback.isObject)
+            {
+                context->SetArgObject(0, callback.object);
+            }
+            else
+            {
+                context->SetArgDWord(0, callback.value);
+            }
+        }
+
+        if (context->Execute() != asEXECUTION_FINISHED)
+        {
+            numFailed++;
+        }
+    }
+
+    ScriptEngine::ReturnContext(context);
+    _callbacks.clear();
+
+    return numFailed;
+}
@@ -2,6 +2,7 @@
 #include <NovusTypes.h>
 #include "angelscript.h"
 #include <assert.h>
+#include <vector>
 
 class ScriptEngine
 {
@@ -10,7 +11,14 @@ public:
 
     // GetScriptEngine will initialize the thread local engine object if needed
     static asIScriptEngine* GetScriptEngine();
-    static asIScriptContext* GetScriptContext();
+
+    // Releases the calling thread's engine and pooled contexts, for threads that only needed an engine for a while like startup workers
+    static void Shutdown();
+
+    // Contexts are pooled per thread, always hand a requested context back with ReturnContext once the call is done
+    // Requesting a context while a script is running on this thread reuses the running context through PushState, so callbacks can nest
+    static asIScriptContext* RequestContext();
+    static void ReturnContext(asIScriptContext* context);
 
     static i32 SetNamespace(std::string name);
     static i32 ResetNamespace();
@@ -61,6 +69,32 @@ public:
 private:
 private:
     static thread_local asIScriptEngine* _scriptEngine;
-    static thread_local asIScriptContext* _scriptContext;
     static thread_local std::string _scriptCurrentObjectName;
+    static thread_local std::vector<asIScriptContext*> _contextPool;
+};
+
+// Queues script callbacks and runs them on a single context, consecutive callbacks of the same function only have their arguments replaced
+class ScriptCallbackBatch
+{
+public:
+    void Add(asIScriptFunction* function, void* object);
+    void Add(asIScriptFunction* function, u32 value);
+
+    // Runs and clears every queued callback in the order they were added
+    // groupByFunction runs all callbacks of a function back to back instead, only use it when the callbacks don't depend on each other's order
+    // Returns the number of callbacks that did not finish
+    u32 Execute(bool groupByFunction = false);
+
+    size_t Size() const { return _callbacks.size(); }
+
+private:
+    struct Callback
+    {
+        asIScriptFunction* function = nullptr;
+        void* object = nullptr;
+        u32 value = 0;
+        bool isObject = false;
+    };
+
+    std::vector<Callback> _callbacks;
 };
\ No newline at end of file
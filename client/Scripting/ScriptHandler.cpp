@@ -2,6 +2,7 @@
 
 #include <Utils/DebugHandler.h>
 #include <Utils/Timer.h>
+#include <algorithm>
 
 // Angelscript Addons
 #include "Addons/scriptarray/scriptarray.h"
@@ -17,6 +18,14 @@
 
 namespace fs = std::filesystem;
 std::string ScriptHandler::_scriptFolder = "";
+fs::path ScriptHandler::_scriptDirectory;
+std::vector<std::string> ScriptHandler::_moduleOrder;
+ScriptReloader ScriptHandler::_scriptReloader;
+std::vector<ScriptReloadResult> ScriptHandler::_reloadResults;
+robin_hood::unordered_map<std::string, robin_hood::unordered_map<std::string, asIScriptFunction*>> ScriptHandler::_functionCache;
+ScriptCache ScriptHandler::_scriptCache;
+bool ScriptHandler::_isCacheEnabled = true;
+ScriptLoadStats ScriptHandler::_loadStats;
 
 void ScriptHandler::ReloadScripts()
 {
@@ -31,34 +40,260 @@ void ScriptHandler::ReloadScripts()
 void ScriptHandler::LoadScriptDirectory(std::string& scriptFolder)
 {
     _scriptFolder = scriptFolder; 
-    fs::path absolutePath = fs::absolute(scriptFolder);
+    fs::path absolutePath = fs::absolute(scriptFolder).lexically_normal();
     if (!fs::exists(absolutePath))
     {
         fs::create_directory(absolutePath);
     }
 
+    // Section names come from these paths, they have to be normal to be compared against the paths the reloader reports
+    _scriptDirectory = absolutePath;
+    _moduleOrder.clear();
+
+    if (_scriptCache.GetDirectory().empty())
+    {
+        _scriptCache.SetDirectory(GetCacheDirectory(absolutePath));
+    }
+
+    Timer timer;
+    _loadStats = ScriptLoadStats();
+
+    for (auto& scriptPath : fs::recursive_directory_iterator(absolutePath))
+    {
+        if (scriptPath.is_directory())
+            continue;
+
+        if (LoadScript(scriptPath.path(), fs::relative(scriptPath.path(), absolutePath)))
+        {
+            _loadStats.numScripts++;
+        }
+    }
+    _loadStats.msTimeTaken = timer.GetLifeTime() * 1000;
+    NC_LOG_SUCCESS("Loaded %u scripts in %.2f ms (%u compiled, %u from cache, %u unchanged)", _loadStats.numScripts, _loadStats.msTimeTaken, _loadStats.numCompiled, _loadStats.numFromCache, _loadStats.numUnchanged);
+}
+
+u32 ScriptHandler::PrecompileScriptDirectory(const std::string& scriptFolder)
+{
+    if (!_isCacheEnabled)
+        return 0;
+
+    fs::path absolutePath = fs::absolute(scriptFolder).lexically_normal();
+    if (!fs::exists(absolutePath))
+        return 0;
+
+    // The engine is per thread, so this compiles against the calling thread's engine and a cache of its own in the same directory
+    asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+
+    ScriptCache scriptCache;
+    scriptCache.SetDirectory(_scriptCache.GetDirectory().empty() ? GetCacheDirectory(absolutePath) : _scriptCache.GetDirectory());
+
     Timer timer;
-    size_t count = 0;
+    u32 numCompiled = 0;
+
     for (auto& scriptPath : fs::recursive_directory_iterator(absolutePath))
     {
         if (scriptPath.is_directory())
             continue;
 
-        if (LoadScript(scriptPath.path()))
+        const fs::path relativePath = fs::relative(scriptPath.path(), absolutePath);
+        if (scriptCache.IsCached(scriptEngine, relativePath))
+            continue;
+
+        const std::string moduleName = scriptPath.path().filename().string();
+
+        // Errors are logged here, LoadScriptDirectory will find no cache file and log them again when it compiles the script itself
+        CScriptBuilder builder;
+        if (BuildModule(scriptEngine, moduleName, scriptPath.path(), builder) && scriptCache.Save(scriptEngine, moduleName, relativePath, builder))
+        {
+            numCompiled++;
+        }
+
+        if (asIScriptModule* module = scriptEngine->GetModule(moduleName.c_str(), asGM_ONLY_IF_EXISTS))
         {
-            count++;
+            module->Discard();
         }
     }
-    f32 msTimeTaken = timer.GetLifeTime() * 1000;
-    NC_LOG_SUCCESS("Loaded %u scripts in %.2f ms", count, msTimeTaken);
+
+    NC_LOG_SUCCESS("Precompiled %u scripts in %.2f ms", numCompiled, timer.GetLifeTime() * 1000);
+    return numCompiled;
+}
+
+void ScriptHandler::UnloadScripts()
+{
+    asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+    while (scriptEngine->GetModuleCount() > 0)
+    {
+        scriptEngine->GetModuleByIndex(0)->Discard();
+    }
+
+    _scriptCache.Clear();
+    _moduleOrder.clear();
+    _functionCache.clear();
+}
+
+void ScriptHandler::StartWatching()
+{
+    if (_scriptDirectory.empty())
+        return;
+
+    _scriptReloader.Start(_scriptDirectory);
+}
+
+void ScriptHandler::StopWatching()
+{
+    _scriptReloader.Stop();
 }
 
-bool ScriptHandler::LoadScript(fs::path scriptPath)
+bool ScriptHandler::UpdateReloads()
+{
+    if (!_scriptReloader.IsRunning())
+        return false;
+
+    asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+
+    std::vector<fs::path> changedFiles;
+    _scriptReloader.GetChangedFiles(changedFiles);
+
+    if (!changedFiles.empty())
+    {
+        // A changed file rebuilds its own module and every module that #includes it
+        std::vector<fs::path> scriptPaths;
+        for (const fs::path& changedFile : changedFiles)
+        {
+            scriptPaths.push_back(changedFile);
+            _scriptCache.GetDependents(changedFile, scriptPaths);
+        }
+
+        std::sort(scriptPaths.begin(), scriptPaths.end());
+        scriptPaths.erase(std::unique(scriptPaths.begin(), scriptPaths.end()), scriptPaths.end());
+
+        for (const fs::path& scriptPath : scriptPaths)
+        {
+            ScriptCompileJob job;
+            job.moduleName = scriptPath.filename().string();
+            job.scriptPath = scriptPath;
+            job.relativePath = scriptPath.lexically_relative(_scriptDirectory);
+
+            // Saving without changes, or touching the file, doesn't change the hash
+            if (fs::exists(scriptPath) && _scriptCache.IsUpToDate(scriptEngine, job.moduleName))
+                continue;
+
+            // A script that isn't loaded yet only knows its own file until it is built
+            _scriptCache.GetDependencyPaths(job.moduleName, job.dependencyPaths);
+            if (job.dependencyPaths.empty())
+            {
+                job.dependencyPaths.push_back(scriptPath.string());
+            }
+            _scriptReloader.Compile(job);
+        }
+    }
+
+    bool isAnySwapped = false;
+
+    ScriptCompileResult result;
+    while (_scriptReloader.TryGetResult(result))
+    {
+        if (!isAnySwapped)
+        {
+            _reloadResults.clear();
+        }
+
+        ScriptReloadResult& reloadResult = _reloadResults.emplace_back();
+        reloadResult.moduleName = result.moduleName;
+        reloadResult.isRemoved = result.isRemoved;
+        reloadResult.isCompiled = result.isCompiled;
+        reloadResult.msCompileTime = result.msCompileTime;
+
+        Timer timer;
+        auto moduleItr = std::find(_moduleOrder.begin(), _moduleOrder.end(), result.moduleName);
+        _functionCache.erase(result.moduleName);
+
+        if (result.isRemoved)
+        {
+            if (asIScriptModule* module = scriptEngine->GetModule(result.moduleName.c_str(), asGM_ONLY_IF_EXISTS))
+            {
+                module->Discard();
+            }
+
+            _scriptCache.Remove(result.moduleName, result.relativePath);
+            if (moduleItr != _moduleOrder.end())
+            {
+                _moduleOrder.erase(moduleItr);
+            }
+
+            NC_LOG_MESSAGE("[Script]: Removed %s", result.moduleName.c_str());
+            isAnySwapped = true;
+        }
+        else if (!result.isCompiled)
+        {
+            // The errors were already logged by the compile thread, the module that was loaded before keeps running
+            NC_LOG_ERROR("[Script]: Failed to rebuild %s, keeping the previous version", result.moduleName.c_str());
+        }
+        else if (_scriptCache.Swap(scriptEngine, result.moduleName, result.relativePath, result.dependencies, result.byteCode))
+        {
+            if (moduleItr == _moduleOrder.end())
+            {
+                _moduleOrder.push_back(result.moduleName);
+            }
+
+            reloadResult.msSwapTime = timer.GetLifeTime() * 1000;
+            NC_LOG_MESSAGE("[Script]: Rebuilt %s (compile %.2f ms, swap %.2f ms)", result.moduleName.c_str(), reloadResult.msCompileTime, reloadResult.msSwapTime);
+            isAnySwapped = true;
+        }
+    }
+
+    return isAnySwapped;
+}
+
+void ScriptHandler::ExecuteModules()
+{
+    asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+    for (const std::string& moduleName : _moduleOrder)
+    {
+        ExecuteMain(scriptEngine, moduleName);
+    }
+}
+
+bool ScriptHandler::LoadScript(fs::path scriptPath, const fs::path& relativePath)
 {
     asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
     std::string moduleName = scriptPath.filename().string();
 
-    CScriptBuilder builder;
+    if (_isCacheEnabled && _scriptCache.IsUpToDate(scriptEngine, moduleName))
+    {
+        _loadStats.numUnchanged++;
+    }
+    else if (_isCacheEnabled && _scriptCache.Load(scriptEngine, moduleName, relativePath))
+    {
+        _functionCache.erase(moduleName);
+        _loadStats.numFromCache++;
+    }
+    else
+    {
+        _functionCache.erase(moduleName);
+
+        CScriptBuilder builder;
+        if (!BuildModule(scriptEngine, moduleName, scriptPath, builder))
+            return false;
+
+        _loadStats.numCompiled++;
+        if (_isCacheEnabled)
+        {
+            _scriptCache.Save(scriptEngine, moduleName, relativePath, builder);
+        }
+    }
+
+    _moduleOrder.push_back(moduleName);
+    return ExecuteMain(scriptEngine, moduleName);
+}
+
+fs::path ScriptHandler::GetCacheDirectory(const fs::path& scriptDirectory)
+{
+    return scriptDirectory.parent_path() / "cache" / "scripts";
+}
+
+bool ScriptHandler::BuildModule(asIScriptEngine* scriptEngine, const std::string& moduleName, const fs::path& scriptPath, CScriptBuilder& builder)
+{
     int r = builder.StartNewModule(scriptEngine, moduleName.c_str());
     if (r < 0)
     {
@@ -85,8 +320,12 @@ bool ScriptHandler::LoadScript(fs::path scriptPath)
         return false;
     }
 
-    asIScriptModule* mod = scriptEngine->GetModule(moduleName.c_str());
-    asIScriptFunction* func = mod->GetFunctionByDecl("void main()");
+    return true;
+}
+
+bool ScriptHandler::ExecuteMain(asIScriptEngine* scriptEngine, const std::string& moduleName)
+{
+    asIScriptFunction* func = GetFunction(moduleName, "void main()");
     if (func == 0)
     {
         // The function couldn't be found. Instruct the script writer
@@ -95,10 +334,10 @@ bool ScriptHandler::LoadScript(fs::path scriptPath)
         return false;
     }
 
-    // Create our context, prepare it, and then execute
-    asIScriptContext* ctx = scriptEngine->CreateContext();
+    // Request a pooled context, prepare it, and then execute
+    asIScriptContext* ctx = ScriptEngine::RequestContext();
     ctx->Prepare(func);
-    r = ctx->Execute();
+    int r = ctx->Execute();
     if (r != asEXECUTION_FINISHED)
     {
         // The execution didn't complete as expected. Determine what happened.
@@ -106,11 +345,30 @@ bool ScriptHandler::LoadScript(fs::path scriptPath)
         {
             // An exception occurred, let the script writer know what happened so it can be corrected.
             NC_LOG_ERROR("[Script]: An exception '%s' occurred. Please correct the code and try again.\n", ctx->GetExceptionString());
-            ctx->Release();
+            ScriptEngine::ReturnContext(ctx);
             return false;
         }
     }
 
-    ctx->Release();
+    ScriptEngine::ReturnContext(ctx);
     return true;
-}
\ No newline at end of file
+}
+
+asIScriptFunction* ScriptHandler::GetFunction(const std::string& moduleName, const std::string& declaration)
+{
+    robin_hood::unordered_map<std::string, asIScriptFunction*>& functions = _functionCache[moduleName];
+
+    auto itr = functions.find(declaration);
+    if (itr != functions.end())
+        return itr->second;
+
+    asIScriptFunction* function = nullptr;
+    if (asIScriptModule* module = ScriptEngine::GetScriptEngine()->GetModule(moduleName.c_str(), asGM_ONLY_IF_EXISTS))
+    {
+        function = module->GetFunctionByDecl(declaration.c_str());
+    }
+
+    // Misses are cached too, the module is dropped from the cache whenever it is rebuilt
+    functions[declaration] = function;
+    return function;
+}
@@ -1,21 +1,84 @@
 #pragma once
 #include <string>
 #include <filesystem>
+#include <robin_hood.h>
 #include <asio.hpp>
 #include <entt.hpp>
 #include "angelscript.h"
+#include "ScriptCache.h"
+#include "ScriptReloader.h"
+
+class CScriptBuilder;
+
+struct ScriptLoadStats
+{
+    u32 numScripts = 0;
+    u32 numCompiled = 0;
+    u32 numFromCache = 0; // Loaded from bytecode in the cache directory
+    u32 numUnchanged = 0; // Already loaded and unchanged since, only main() was run again
+    f32 msTimeTaken = 0.0f;
+};
+
+struct ScriptReloadResult
+{
+    std::string moduleName;
+    bool isRemoved = false;
+    bool isCompiled = false;
+    f32 msCompileTime = 0.0f; // Time spent on the compile thread
+    f32 msSwapTime = 0.0f; // Time spent on the main thread loading the bytecode
+};
 
 class ScriptHandler
 {
 public:
     static void LoadScriptDirectory(std::string& path);
+
+    // Compiles every script in path that has no valid cache file and saves it to the cache, without keeping or running the modules
+    // Safe to call from a worker thread before LoadScriptDirectory, which then only has to load bytecode. Returns the number compiled
+    static u32 PrecompileScriptDirectory(const std::string& path);
     static void ReloadScripts();
 
+    // Discards every loaded module, the next load comes from the bytecode cache or source
+    static void UnloadScripts();
+
+    static void SetCacheDirectory(const std::string& path) { _scriptCache.SetDirectory(path); }
+    static void SetCacheEnabled(bool enabled) { _isCacheEnabled = enabled; }
+
+    static const ScriptLoadStats& GetLoadStats() { return _loadStats; }
+
+    // Rebuilds scripts in the background as they change on disk instead of waiting for ReloadScripts
+    static void StartWatching();
+    static void StopWatching();
+
+    // Call this at a frame boundary, it queues changed scripts for the compile thread and swaps in the modules it finished
+    // Returns true if any module was swapped, main() has not been run yet so the caller can clear what the scripts created first
+    static bool UpdateReloads();
+    static const std::vector<ScriptReloadResult>& GetReloadResults() { return _reloadResults; }
+
+    // Runs main() of every loaded module in the order they were loaded
+    static void ExecuteModules();
+
+    // Looks up a function by declaration in a loaded module, lookups are cached until the module is rebuilt
+    static asIScriptFunction* GetFunction(const std::string& moduleName, const std::string& declaration);
+
+    // Builds moduleName from scriptPath into scriptEngine, shared by the loader and the compile thread
+    static bool BuildModule(asIScriptEngine* scriptEngine, const std::string& moduleName, const std::filesystem::path& scriptPath, CScriptBuilder& builder);
+
 private:
-    static bool LoadScript(std::filesystem::path path);
+    static bool LoadScript(std::filesystem::path path, const std::filesystem::path& relativePath);
+    static std::filesystem::path GetCacheDirectory(const std::filesystem::path& scriptDirectory);
+    static bool ExecuteMain(asIScriptEngine* scriptEngine, const std::string& moduleName);
 
     ScriptHandler();
 
 private:
     static std::string _scriptFolder;
+    static std::filesystem::path _scriptDirectory;
+    static std::vector<std::string> _moduleOrder;
+    static ScriptReloader _scriptReloader;
+    static std::vector<ScriptReloadResult> _reloadResults;
+    static robin_hood::unordered_map<std::string, robin_hood::unordered_map<std::string, asIScriptFunction*>> _functionCache;
+    static ScriptCache _scriptCache;
+    static bool _isCacheEnabled;
+    static ScriptLoadStats _loadStats;
 };
\ No newline at end of file
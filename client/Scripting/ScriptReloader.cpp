@@ -0,0 +1,284 @@
+#include "ScriptReloader.h"
+#include <Utils/DebugHandler.h>
+#include <Utils/Timer.h>
+#include <algorithm>
+#include <chrono>
+
+#include "Addons/scriptbuilder/scriptbuilder.h"
+#include "ScriptEngine.h"
+#include "ScriptHandler.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Editors write swap and backup files next to the file being edited, only actual scripts are reloaded
+    bool IsScript(const fs::path& path)
+    {
+        return path.extension() == ".as";
+    }
+}
+
+bool ScriptReloader::Start(const fs::path& directory)
+{
+    Stop();
+
+    _directory = fs::absolute(directory).lexically_normal();
+
+#ifdef __linux__
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify < 0)
+    {
+        NC_LOG_ERROR("[Script]: Failed to start watching %s", _directory.string().c_str());
+        return false;
+    }
+#endif
+
+    AddWatches(_directory);
+
+    _isRunning = true;
+    _watchThread = std::thread(&ScriptReloader::WatchThread, this);
+    _compileThread = std::thread(&ScriptReloader::CompileThread, this);
+    return true;
+}
+
+void ScriptReloader::Stop()
+{
+    if (!_isRunning)
+        return;
+
+    {
+        std::lock_guard lock(_jobMutex);
+        _isRunning = false;
+        _jobs.clear();
+    }
+    _jobCondition.notify_all();
+
+    _watchThread.join();
+    _compileThread.join();
+
+#ifdef __linux__
+    close(_inotify);
+    _inotify = -1;
+    _watches.clear();
+#else
+    _writeTimes.clear();
+#endif
+}
+
+void ScriptReloader::GetChangedFiles(std::vector<fs::path>& paths)
+{
+    fs::path path;
+    while (_changedFiles.try_dequeue(path))
+    {
+        paths.push_back(std::move(path));
+    }
+}
+
+void ScriptReloader::Compile(const ScriptCompileJob& job)
+{
+    {
+        std::lock_guard lock(_jobMutex);
+        _jobs.push_back(job);
+    }
+    _jobCondition.notify_one();
+}
+
+void ScriptReloader::WatchThread()
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+
+    while (_isRunning)
+    {
+        pollfd pollDesc = { _inotify, POLLIN, 0 };
+        if (poll(&pollDesc, 1, 100) <= 0)
+            continue;
+
+        const ssize_t length = read(_inotify, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(&buffer[offset]);
+            offset += sizeof(inotify_event) + event->len;
+
+            auto itr = _watches.find(event->wd);
+            if (itr == _watches.end() || event->len == 0)
+                continue;
+
+            const fs::path path = (itr->second / event->name).lexically_normal();
+            if (event->mask & IN_ISDIR)
+            {
+                // Directories that are created or moved in are watched too, and anything already in them counts as added
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                {
+                    AddWatches(path);
+
+                    std::error_code errorCode;
+                    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(path, errorCode))
+                    {
+                        if (entry.is_regular_file() && IsScript(entry.path()))
+                        {
+                            _changedFiles.enqueue(entry.path().lexically_normal());
+                        }
+                    }
+                }
+                continue;
+            }
+
+            // Files are picked up when they are closed after writing, not when they are created empty
+            if (IsScript(path) && !(event->mask & IN_CREATE))
+            {
+                _changedFiles.enqueue(path);
+            }
+        }
+    }
+#else
+    while (_isRunning)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+        std::unordered_map<std::string, fs::file_time_type> writeTimes;
+        writeTimes.reserve(_writeTimes.size());
+
+        std::error_code errorCode;
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(_directory, errorCode))
+        {
+            if (!entry.is_regular_file() || !IsScript(entry.path()))
+                continue;
+
+            const std::string path = entry.path().lexically_normal().string();
+            const fs::file_time_type writeTime = entry.last_write_time(errorCode);
+
+            auto itr = _writeTimes.find(path);
+            if (itr == _writeTimes.end() || itr->second != writeTime)
+            {
+                _changedFiles.enqueue(path);
+            }
+
+            writeTimes[path] = writeTime;
+        }
+
+        for (auto& [path, writeTime] : _writeTimes)
+        {
+            if (writeTimes.find(path) == writeTimes.end())
+            {
+                _changedFiles.enqueue(path);
+            }
+        }
+
+        _writeTimes = std::move(writeTimes);
+    }
+#endif
+}
+
+void ScriptReloader::CompileThread()
+{
+    while (true)
+    {
+        ScriptCompileJob job;
+        {
+            std::unique_lock lock(_jobMutex);
+            _jobCondition.wait(lock, [this]() { return !_isRunning || !_jobs.empty(); });
+
+            if (!_isRunning)
+                break;
+
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+        }
+
+        // This is the compile thread's own engine, nothing here touches the engine the main thread runs scripts on
+        asIScriptEngine* scriptEngine = ScriptEngine::GetScriptEngine();
+
+        Timer timer;
+        ScriptCompileResult result;
+        result.moduleName = job.moduleName;
+        result.scriptPath = job.scriptPath;
+        result.relativePath = job.relativePath;
+        result.isRemoved = !fs::exists(job.scriptPath);
+
+        if (!result.isRemoved)
+        {
+            // Hashed before the build, a file saved while it builds then no longer matches and gets rebuilt
+            // Hashing afterwards would record the new contents as compiled. Includes that are new in this build are only hashed afterwards
+            std::vector<ScriptCache::Dependency> hashedDependencies(job.dependencyPaths.size());
+            for (size_t i = 0; i < job.dependencyPaths.size(); i++)
+            {
+                hashedDependencies[i].path = job.dependencyPaths[i];
+                ScriptCache::HashFile(hashedDependencies[i].path, hashedDependencies[i].hash);
+            }
+
+            CScriptBuilder builder;
+            if (ScriptHandler::BuildModule(scriptEngine, job.moduleName, job.scriptPath, builder))
+            {
+                asIScriptModule* module = scriptEngine->GetModule(job.moduleName.c_str(), asGM_ONLY_IF_EXISTS);
+                result.isCompiled = ScriptCache::GetDependencies(builder, result.dependencies) && ScriptCache::SaveByteCode(module, result.byteCode);
+
+                for (ScriptCache::Dependency& dependency : result.dependencies)
+                {
+                    auto itr = std::find_if(hashedDependencies.begin(), hashedDependencies.end(), [&dependency](const ScriptCache::Dependency& hashedDependency)
+                    {
+                        return fs::path(hashedDependency.path).lexically_normal() == fs::path(dependency.path).lexically_normal();
+                    });
+
+                    if (itr != hashedDependencies.end())
+                    {
+                        dependency.hash = itr->hash;
+                    }
+                }
+            }
+
+            if (asIScriptModule* module = scriptEngine->GetModule(job.moduleName.c_str(), asGM_ONLY_IF_EXISTS))
+            {
+                module->Discard();
+            }
+        }
+
+        result.msCompileTime = timer.GetLifeTime() * 1000;
+        _results.enqueue(std::move(result));
+    }
+
+    // The engine is thread local, nothing else can release it once this thread is gone
+    ScriptEngine::Shutdown();
+}
+
+void ScriptReloader::AddWatches(const fs::path& directory)
+{
+#ifdef __linux__
+    constexpr u32 mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+    i32 watch = inotify_add_watch(_inotify, directory.c_str(), mask);
+    if (watch >= 0)
+    {
+        _watches[watch] = directory;
+    }
+
+    std::error_code errorCode;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(directory, errorCode))
+    {
+        if (!entry.is_directory())
+            continue;
+
+        watch = inotify_add_watch(_inotify, entry.path().c_str(), mask);
+        if (watch >= 0)
+        {
+            _watches[watch] = entry.path().lexically_normal();
+        }
+    }
+#else
+    std::error_code errorCode;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(directory, errorCode))
+    {
+        if (entry.is_regular_file() && IsScript(entry.path()))
+        {
+            _writeTimes[entry.path().lexically_normal().string()] = entry.last_write_time(errorCode);
+        }
+    }
+#endif
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Utils/ConcurrentQueue.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ScriptCache.h"
+
+struct ScriptCompileJob
+{
+    std::string moduleName;
+    std::filesystem::path scriptPath;
+    std::filesystem::path relativePath;
+
+    std::vector<std::string> dependencyPaths; // Files the loaded module was built from, hashed before the build
+};
+
+struct ScriptCompileResult
+{
+    std::string moduleName;
+    std::filesystem::path scriptPath;
+    std::filesystem::path relativePath;
+
+    bool isRemoved = false;
+    bool isCompiled = false;
+
+    std::vector<ScriptCache::Dependency> dependencies;
+    std::vector<u8> byteCode;
+
+    f32 msCompileTime = 0.0f;
+};
+
+// Watches the script folder for scripts that are written, created or removed and compiles them on a worker thread
+// The worker has its own script engine (ScriptEngine is thread local) with the same registered interface, modules are
+// handed back as bytecode so the main thread only has to load them, see ScriptHandler::UpdateReloads
+class ScriptReloader
+{
+public:
+    ~ScriptReloader() { Stop(); }
+
+    bool Start(const std::filesystem::path& directory);
+    void Stop();
+    bool IsRunning() const { return _isRunning; }
+
+    // Scripts that changed on disk since the last call, paths are absolute and lexically normal
+    void GetChangedFiles(std::vector<std::filesystem::path>& paths);
+
+    void Compile(const ScriptCompileJob& job);
+    bool TryGetResult(ScriptCompileResult& result) { return _results.try_dequeue(result); }
+
+private:
+    void WatchThread();
+    void CompileThread();
+
+    void AddWatches(const std::filesystem::path& directory);
+
+private:
+    std::atomic<bool> _isRunning = false;
+    std::filesystem::path _directory;
+
+    std::thread _watchThread;
+    std::thread _compileThread;
+
+    moodycamel::ConcurrentQueue<std::filesystem::path> _changedFiles;
+    moodycamel::ConcurrentQueue<ScriptCompileResult> _results;
+
+    std::mutex _jobMutex;
+    std::condition_variable _jobCondition;
+    std::deque<ScriptCompileJob> _jobs;
+
+#ifdef __linux__
+    i32 _inotify = -1;
+    std::unordered_map<i32, std::filesystem::path> _watches;
+#else
+    // Without inotify the folder is polled, this is the last write time of every script that was seen
+    std::unordered_map<std::string, std::filesystem::file_time_type> _writeTimes;
+#endif
+};
@@ -19,7 +19,7 @@ namespace UIComponent
     private:
         void _OnEvent(asIScriptFunction* callback)
         {
-            asIScriptContext* context = ScriptEngine::GetScriptContext();
+            asIScriptContext* context = ScriptEngine::RequestContext();
             {
                 context->Prepare(callback);
                 {
@@ -27,6 +27,7 @@ namespace UIComponent
                 }
                 context->Execute();
             }
+            ScriptEngine::ReturnContext(context);
         }
     public:
         void OnChecked()
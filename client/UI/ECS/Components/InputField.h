@@ -18,7 +18,7 @@ namespace UIComponent
     private:
         void _OnEvent(asIScriptFunction* callback)
         {
-            asIScriptContext* context = ScriptEngine::GetScriptContext();
+            asIScriptContext* context = ScriptEngine::RequestContext();
             {
                 context->Prepare(callback);
                 {
@@ -26,6 +26,7 @@ namespace UIComponent
                 }
                 context->Execute();
             }
+            ScriptEngine::ReturnContext(context);
         }
     public:
         void OnSubmit()
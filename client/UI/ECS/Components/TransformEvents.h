@@ -33,7 +33,7 @@ namespace UIComponent
     private:
         void _OnEvent(asIScriptFunction* callback)
         {
-            asIScriptContext* context = ScriptEngine::GetScriptContext();
+            asIScriptContext* context = ScriptEngine::RequestContext();
             {
                 context->Prepare(callback);
                 {
@@ -41,6 +41,7 @@ namespace UIComponent
                 }
                 context->Execute();
             }
+            ScriptEngine::ReturnContext(context);
         }
     public:
         void OnClick()
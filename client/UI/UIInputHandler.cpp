@@ -15,7 +15,7 @@
 
 namespace UIInput
 {
-    bool OnMouseClick(Window* window, std::shared_ptr<Keybind> keybind)
+    bool OnMouseClick(Window* window, Keybind* keybind)
     {
         ZoneScoped;
         entt::registry* registry = ServiceLocator::GetUIRegistry();
@@ -0,0 +1,117 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Math/Geometry.h>
+#include <algorithm>
+#include <vector>
+#include "../Gameplay/Map/Chunk.h"
+
+namespace Terrain
+{
+    namespace CullingUtils
+    {
+        __forceinline bool IsInsideFrustum(const vec4* planes, const Geometry::AABoundingBox& boundingBox)
+        {
+            // this is why god abandoned us
+            for (int i = 0; i < 6; ++i)
+            {
+                const vec4& plane = planes[i];
+
+                vec3 vmin, vmax;
+
+                // X axis
+                if (plane.x > 0)
+                {
+                    vmin.x = boundingBox.min.x;
+                    vmax.x = boundingBox.max.x;
+                }
+                else
+                {
+                    vmin.x = boundingBox.max.x;
+                    vmax.x = boundingBox.min.x;
+                }
+                // Y axis
+                if (plane.y > 0)
+                {
+                    vmin.y = boundingBox.min.y;
+                    vmax.y = boundingBox.max.y;
+                }
+                else
+                {
+                    vmin.y = boundingBox.max.y;
+                    vmax.y = boundingBox.min.y;
+                }
+                // Z axis
+                if (plane.z > 0)
+                {
+                    vmin.z = boundingBox.min.z;
+                    vmax.z = boundingBox.max.z;
+                }
+                else
+                {
+                    vmin.z = boundingBox.max.z;
+                    vmax.z = boundingBox.min.z;
+                }
+
+                if (glm::dot(vec3(plane), vmin) + plane.w < 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        inline Geometry::AABoundingBox CalculateCellBoundingBox(u16 chunkPosX, u16 chunkPosY, u32 cellIndex, const Terrain::Cell& cell)
+        {
+            constexpr float halfWorldSize = 17066.66656f;
+
+            vec2 chunkOrigin;
+            chunkOrigin.x = -((chunkPosY)*Terrain::MAP_CHUNK_SIZE - halfWorldSize);
+            chunkOrigin.y = ((Terrain::MAP_CHUNKS_PER_MAP_STRIDE - chunkPosX) * Terrain::MAP_CHUNK_SIZE - halfWorldSize);
+
+            const auto minmax = std::minmax_element(cell.heightData, cell.heightData + Terrain::MAP_CELL_TOTAL_GRID_SIZE);
+
+            const u16 cellX = cellIndex % Terrain::MAP_CELLS_PER_CHUNK_SIDE;
+            const u16 cellY = cellIndex / Terrain::MAP_CELLS_PER_CHUNK_SIDE;
+
+            vec3 min;
+            vec3 max;
+
+            min.x = chunkOrigin.x - (cellY * Terrain::MAP_CELL_SIZE);
+            min.y = *minmax.first;
+            min.z = chunkOrigin.y - (cellX * Terrain::MAP_CELL_SIZE);
+
+            max.x = chunkOrigin.x - ((cellY + 1) * Terrain::MAP_CELL_SIZE);
+            max.y = *minmax.second;
+            max.z = chunkOrigin.y - ((cellX + 1) * Terrain::MAP_CELL_SIZE);
+
+            Geometry::AABoundingBox boundingBox;
+            boundingBox.min = glm::max(min, max);
+            boundingBox.max = glm::min(min, max);
+
+            return boundingBox;
+        }
+
+        // Writes (chunkId << 16) | cellId for every cell inside the frustum, cellBoundingBoxes holds MAP_CELLS_PER_CHUNK boxes per loaded chunk
+        inline void CullCells(const vec4* frustumPlanes, const std::vector<u16>& loadedChunks, const std::vector<Geometry::AABoundingBox>& cellBoundingBoxes, std::vector<u32>& culledInstances)
+        {
+            culledInstances.clear();
+            culledInstances.reserve(loadedChunks.size() * Terrain::MAP_CELLS_PER_CHUNK);
+
+            const size_t chunkCount = loadedChunks.size();
+            size_t boundingBoxIndex = 0;
+            for (size_t i = 0; i < chunkCount; ++i)
+            {
+                for (u16 cellId = 0; cellId < Terrain::MAP_CELLS_PER_CHUNK; ++cellId)
+                {
+                    const Geometry::AABoundingBox& boundingBox = cellBoundingBoxes[boundingBoxIndex++];
+                    if (IsInsideFrustum(frustumPlanes, boundingBox))
+                    {
+                        const u16 chunkId = loadedChunks[i];
+                        culledInstances.push_back((chunkId << 16) | cellId);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include "MappedFile.h"
+#include <Utils/DebugHandler.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::Open(const std::filesystem::path& path)
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE fileHandle = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        NC_LOG_ERROR("Failed to open %s for mapping", path.string().c_str());
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        NC_LOG_ERROR("Failed to map %s, the file is empty", path.string().c_str());
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data)
+    {
+        NC_LOG_ERROR("Failed to map %s", path.string().c_str());
+        if (mappingHandle)
+        {
+            CloseHandle(mappingHandle);
+        }
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    _fileHandle = fileHandle;
+    _mappingHandle = mappingHandle;
+    _data = static_cast<const u8*>(data);
+    _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    i32 fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+    {
+        NC_LOG_ERROR("Failed to open %s for mapping", path.string().c_str());
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        NC_LOG_ERROR("Failed to map %s, the file is empty", path.string().c_str());
+        close(fileDescriptor);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+    // The mapping keeps its own reference to the file
+    close(fileDescriptor);
+
+    if (data == MAP_FAILED)
+    {
+        NC_LOG_ERROR("Failed to map %s", path.string().c_str());
+        return false;
+    }
+
+    _data = static_cast<const u8*>(data);
+    _size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (!_data)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(_fileHandle));
+
+    _fileHandle = nullptr;
+    _mappingHandle = nullptr;
+#else
+    munmap(const_cast<u8*>(_data), _size);
+#endif
+
+    _data = nullptr;
+    _size = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file, pages are only read from disk once they are touched
+class MappedFile
+{
+public:
+    MappedFile() { }
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    bool IsOpen() const { return _data != nullptr; }
+    const u8* GetData() const { return _data; }
+    size_t GetSize() const { return _size; }
+
+private:
+    const u8* _data = nullptr;
+    size_t _size = 0;
+
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+};
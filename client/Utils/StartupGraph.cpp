@@ -0,0 +1,127 @@
+#include "StartupGraph.h"
+#include <Utils/DebugHandler.h>
+#include <cassert>
+
+void StartupReport::Log() const
+{
+    for (const StartupPhaseTiming& phase : phases)
+    {
+        const char* result = phase.skipped ? "skipped" : phase.succeeded ? "ok" : "failed";
+        NC_LOG_MESSAGE("[Startup]: %-16s %-6s %8.2f ms at %8.2f ms (%s)", phase.name.c_str(), phase.isMainThread ? "main" : "worker", phase.msDuration, phase.msStart, result);
+    }
+
+    NC_LOG_SUCCESS("[Startup]: Took %.2f ms, %.2f ms of work, first frame after %.2f ms", msTotal, msSerial, msTimeToFirstFrame);
+}
+
+StartupGraph::PhaseID StartupGraph::AddPhase(const std::string& name, Thread thread, std::function<bool()> function)
+{
+    const PhaseID id = static_cast<PhaseID>(_phases.size());
+
+    Phase& phase = _phases.emplace_back();
+    phase.thread = thread;
+    phase.function = std::move(function);
+
+    StartupPhaseTiming& timing = _report.phases.emplace_back();
+    timing.name = name;
+    timing.isMainThread = thread == Thread::Main;
+
+    return id;
+}
+
+void StartupGraph::AddDependency(PhaseID phase, PhaseID dependency)
+{
+    // Main phases run in the order they were added, a dependency on a later phase could never be met
+    assert(dependency < phase);
+    _phases[phase].dependencies.push_back(dependency);
+}
+
+bool StartupGraph::Run(tf::Taskflow& taskflow, bool serial)
+{
+    _startTime = Clock::now();
+
+    for (Phase& phase : _phases)
+    {
+        phase.finished = std::promise<void>();
+        phase.finishedFuture = phase.finished.get_future().share();
+    }
+
+    if (serial)
+    {
+        for (PhaseID id = 0; id < _phases.size(); id++)
+        {
+            RunPhase(id);
+        }
+    }
+    else
+    {
+        tf::Framework framework;
+        std::vector<tf::Task> tasks(_phases.size());
+
+        for (PhaseID id = 0; id < _phases.size(); id++)
+        {
+            if (_phases[id].thread != Thread::Worker)
+                continue;
+
+            tasks[id] = framework.emplace([this, id]() { RunPhase(id); });
+
+            // Worker dependencies are edges in the graph so a worker is never held up waiting, only waits on main phases block
+            for (PhaseID dependency : _phases[id].dependencies)
+            {
+                if (_phases[dependency].thread == Thread::Worker)
+                {
+                    tasks[dependency].precede(tasks[id]);
+                }
+            }
+        }
+
+        taskflow.run(framework);
+
+        for (PhaseID id = 0; id < _phases.size(); id++)
+        {
+            if (_phases[id].thread == Thread::Main)
+            {
+                RunPhase(id);
+            }
+        }
+
+        taskflow.wait_for_all();
+    }
+
+    _report.msTotal = std::chrono::duration<f32, std::milli>(Clock::now() - _startTime).count();
+    _report.msSerial = 0.0f;
+
+    bool succeeded = true;
+    for (const StartupPhaseTiming& timing : _report.phases)
+    {
+        _report.msSerial += timing.msDuration;
+        succeeded &= timing.succeeded;
+    }
+
+    return succeeded;
+}
+
+void StartupGraph::RunPhase(PhaseID id)
+{
+    Phase& phase = _phases[id];
+    StartupPhaseTiming& timing = _report.phases[id];
+
+    // The timing of a dependency is written before its promise is fulfilled, so it is safe to read once the future is ready
+    timing.skipped = false;
+    for (PhaseID dependency : phase.dependencies)
+    {
+        _phases[dependency].finishedFuture.wait();
+        timing.skipped |= !_report.phases[dependency].succeeded;
+    }
+
+    const Clock::time_point startTime = Clock::now();
+    timing.msStart = std::chrono::duration<f32, std::milli>(startTime - _startTime).count();
+    timing.succeeded = !timing.skipped && phase.function();
+    timing.msDuration = std::chrono::duration<f32, std::milli>(Clock::now() - startTime).count();
+
+    if (!timing.skipped && !timing.succeeded)
+    {
+        NC_LOG_ERROR("[Startup]: %s failed", timing.name.c_str());
+    }
+
+    phase.finished.set_value();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <NovusTypes.h>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+#include <taskflow/taskflow.hpp>
+
+struct StartupPhaseTiming
+{
+    std::string name;
+    bool isMainThread = false;
+    bool succeeded = false;
+    bool skipped = false; // A dependency failed so the phase never ran
+    f32 msStart = 0.0f; // Relative to the start of StartupGraph::Run
+    f32 msDuration = 0.0f;
+};
+
+struct StartupReport
+{
+    std::vector<StartupPhaseTiming> phases;
+    f32 msTotal = 0.0f; // Wall time of StartupGraph::Run
+    f32 msSerial = 0.0f; // Sum of every phase, what startup takes when nothing overlaps
+    f32 msTimeToFirstFrame = 0.0f; // Filled in by whoever presents the first frame
+
+    void Log() const;
+};
+
+// Startup phases and the phases they depend on, worker phases run as tasks on the taskflow executor while main phases run on
+// the thread that calls Run, in the order they were added. Anything that needs the window, the renderer or the script engine that
+// is used for the rest of the session has to be a main phase
+class StartupGraph
+{
+public:
+    enum class Thread : u8
+    {
+        Main,
+        Worker
+    };
+
+    using PhaseID = u32;
+
+    // The function returns false if the phase failed, phases that depend on it are then skipped
+    PhaseID AddPhase(const std::string& name, Thread thread, std::function<bool()> function);
+
+    // A phase can only depend on phases that were added before it
+    void AddDependency(PhaseID phase, PhaseID dependency);
+
+    // Runs every phase and returns false if any of them failed or was skipped, serial runs everything on the calling thread in the
+    // order the phases were added which is how startup used to work
+    bool Run(tf::Taskflow& taskflow, bool serial = false);
+
+    StartupReport& GetReport() { return _report; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase
+    {
+        Thread thread;
+        std::function<bool()> function;
+        std::vector<PhaseID> dependencies;
+
+        std::promise<void> finished;
+        std::shared_future<void> finishedFuture;
+    };
+
+    void RunPhase(PhaseID id);
+
+private:
+    std::vector<Phase> _phases;
+    StartupReport _report;
+    Clock::time_point _startTime;
+};
@@ -0,0 +1,56 @@
+#include "DBCGenerator.h"
+#include <Utils/ByteBuffer.h>
+#include <Utils/DebugHandler.h>
+#include <Containers/StringTable.h>
+#include <fstream>
+
+#include "../../client/Gameplay/DBC/DBC.h"
+
+namespace Generators::DBCGenerator
+{
+    bool WriteMapsDBC(const std::filesystem::path& path, const std::vector<GeneratedMapEntry>& maps)
+    {
+        StringTable stringTable;
+        std::vector<DBC::Map> dbcMaps;
+        dbcMaps.reserve(maps.size());
+
+        size_t stringTableSize = sizeof(u32);
+        for (const GeneratedMapEntry& entry : maps)
+        {
+            DBC::Map& map = dbcMaps.emplace_back();
+            map.Id = entry.id;
+            map.Name = stringTable.AddString(entry.name);
+            map.InternalName = stringTable.AddString(entry.internalName);
+            map.MaxPlayers = 0;
+
+            stringTableSize += entry.name.size() + entry.internalName.size() + 2;
+        }
+
+        const size_t size = sizeof(DBC::DBCHeader) + sizeof(u32) + (sizeof(DBC::Map) * dbcMaps.size()) + stringTableSize;
+
+        DBC::DBCHeader header;
+        header.token = DBC::DBC_TOKEN;
+        header.version = DBC::DBC_VERSION;
+
+        Bytebuffer buffer(nullptr, size);
+        buffer.Put<DBC::DBCHeader>(header);
+
+        buffer.Put<u32>(static_cast<u32>(dbcMaps.size()));
+        for (const DBC::Map& map : dbcMaps)
+        {
+            buffer.Put<DBC::Map>(map);
+        }
+
+        stringTable.Serialize(&buffer);
+
+        std::ofstream output(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create file %s", path.string().c_str());
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(buffer.GetDataPointer()), buffer.writtenData);
+        return true;
+    }
+}
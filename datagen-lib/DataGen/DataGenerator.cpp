@@ -0,0 +1,159 @@
+#include "DataGenerator.h"
+#include <Utils/DebugHandler.h>
+
+#include "DBCGenerator.h"
+#include "TextureGenerator.h"
+
+namespace fs = std::filesystem;
+
+namespace Generators::DataGenerator
+{
+    bool CreateDirectories(const fs::path& path)
+    {
+        std::error_code errorCode;
+        fs::create_directories(path, errorCode);
+
+        if (errorCode)
+        {
+            NC_LOG_ERROR("Failed to create directory %s (%s)", path.string().c_str(), errorCode.message().c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    void AddFileSize(const fs::path& path, DataGeneratorStats& stats)
+    {
+        std::error_code errorCode;
+        u64 size = fs::file_size(path, errorCode);
+
+        if (!errorCode)
+            stats.numBytes += size;
+    }
+
+    bool Generate(const DataGeneratorDesc& desc, const fs::path& outputDirectory, DataGeneratorStats& stats)
+    {
+        stats = DataGeneratorStats();
+
+        const fs::path extractedDirectory = outputDirectory / "Data" / "extracted";
+        const fs::path dbcDirectory = extractedDirectory / "Ndbc";
+        const fs::path mapDirectory = extractedDirectory / "maps" / desc.map.name;
+        const fs::path textureDirectory = extractedDirectory / "Textures";
+        const fs::path mapObjectDirectory = extractedDirectory / "MapObjects";
+
+        if (!CreateDirectories(dbcDirectory) || !CreateDirectories(mapDirectory) || !CreateDirectories(textureDirectory / "Generated") || !CreateDirectories(mapObjectDirectory / "Generated"))
+            return false;
+
+        // Maps.ndbc
+        {
+            GeneratedMapEntry entry;
+            entry.id = 0;
+            entry.name = desc.map.name;
+            entry.internalName = desc.map.name;
+
+            fs::path path = dbcDirectory / "Maps.ndbc";
+            if (!DBCGenerator::WriteMapsDBC(path, { entry }))
+                return false;
+
+            AddFileSize(path, stats);
+        }
+
+        // Chunks are generated and written one at a time so big maps don't have to fit in memory
+        {
+            const u16 chunksPerSide = std::min<u16>(desc.map.chunksPerSide, Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+            const u16 start = static_cast<u16>((Terrain::MAP_CHUNKS_PER_MAP_STRIDE - chunksPerSide) / 2);
+
+            for (u16 y = start; y < start + chunksPerSide; y++)
+            {
+                for (u16 x = start; x < start + chunksPerSide; x++)
+                {
+                    Terrain::Chunk chunk;
+                    StringTable stringTable;
+                    MapGenerator::GenerateChunk(desc.map, x, y, chunk, stringTable);
+
+                    fs::path path = mapDirectory / MapGenerator::GetChunkFileName(desc.map, x, y);
+                    if (!MapGenerator::WriteChunk(path, chunk, stringTable))
+                        return false;
+
+                    AddFileSize(path, stats);
+
+                    if (desc.map.alphaMaps)
+                    {
+                        fs::path alphaMapPath = outputDirectory / MapGenerator::GetAlphaMapPath(desc.map, x, y);
+                        if (!CreateDirectories(alphaMapPath.parent_path()) || !TextureGenerator::WriteAlphaMap(alphaMapPath, desc.map, x, y, desc.alphaMapSize))
+                            return false;
+
+                        AddFileSize(alphaMapPath, stats);
+                        stats.numTextures++;
+                    }
+
+                    stats.numChunks++;
+                    stats.numMapObjectPlacements += static_cast<u32>(chunk.mapObjectPlacements.size());
+                }
+            }
+        }
+
+        // Textures shared by terrain layers and map object materials
+        {
+            const u32 textureCount = std::max({ desc.map.textureCount, desc.mapObject.textureCount, 1u });
+            for (u32 i = 0; i < textureCount; i++)
+            {
+                fs::path path = textureDirectory / MapGenerator::GetTexturePath(i);
+                if (!TextureGenerator::WriteTexture(path, desc.map.seed, i, desc.textureSize))
+                    return false;
+
+                AddFileSize(path, stats);
+                stats.numTextures++;
+            }
+        }
+
+        // Map objects referenced by the chunk placements
+        for (u32 i = 0; i < desc.map.mapObjectCount; i++)
+        {
+            Terrain::MapObjectRoot mapObjectRoot;
+            StringTable textureStringTable;
+            MapObjectGenerator::GenerateMapObjectRoot(desc.mapObject, i, mapObjectRoot, textureStringTable);
+
+            fs::path rootPath = mapObjectDirectory / MapObjectGenerator::GetMapObjectName(i);
+            if (!MapObjectGenerator::WriteMapObjectRoot(rootPath, mapObjectRoot, textureStringTable))
+                return false;
+
+            AddFileSize(rootPath, stats);
+            stats.numMapObjectRoots++;
+
+            for (u32 j = 0; j < mapObjectRoot.numMapObjects; j++)
+            {
+                Terrain::MapObject mapObject;
+                MapObjectGenerator::GenerateMapObject(desc.mapObject, i, j, static_cast<u32>(mapObjectRoot.materials.size()), mapObject);
+
+                fs::path path = mapObjectDirectory / MapObjectGenerator::GetMapObjectGroupName(i, j);
+                if (!MapObjectGenerator::WriteMapObject(path, mapObject))
+                    return false;
+
+                AddFileSize(path, stats);
+                stats.numMapObjects++;
+            }
+        }
+
+        // The model the client uses for entities, written the way the converter writes every .novusmodel
+        {
+            std::vector<Renderer::Vertex> vertices;
+            std::vector<u32> indices;
+            ModelGenerator::GenerateCube(desc.model, vertices, indices);
+
+            if (desc.model.optimize)
+            {
+                ModelGenerator::OptimizeModel(desc.model, vertices, indices);
+            }
+
+            fs::path path = outputDirectory / ModelGenerator::GetCubeModelPath();
+            if (!CreateDirectories(path.parent_path()) || !ModelGenerator::WriteModel(path, vertices, indices))
+                return false;
+
+            AddFileSize(path, stats);
+            stats.numModels++;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,60 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+
+#include "MapGenerator.h"
+#include "MapObjectGenerator.h"
+#include "ModelGenerator.h"
+
+namespace Generators
+{
+    struct DataGeneratorDesc
+    {
+        MapGeneratorDesc map;
+        MapObjectGeneratorDesc mapObject;
+        ModelGeneratorDesc model;
+
+        u32 textureSize = 64;
+        u32 alphaMapSize = 64;
+    };
+
+    struct DataGeneratorStats
+    {
+        u32 numChunks = 0;
+        u32 numMapObjectPlacements = 0;
+        u32 numMapObjectRoots = 0;
+        u32 numMapObjects = 0;
+        u32 numModels = 0;
+        u32 numTextures = 0;
+        u64 numBytes = 0;
+    };
+
+    namespace DataGenerator
+    {
+        // Writes a complete Data/extracted folder below outputDirectory, the client can be started with outputDirectory as working directory
+        bool Generate(const DataGeneratorDesc& desc, const std::filesystem::path& outputDirectory, DataGeneratorStats& stats);
+    }
+}
@@ -0,0 +1,319 @@
+#include "MapGenerator.h"
+#include <Utils/ByteBuffer.h>
+#include <Utils/DebugHandler.h>
+#include <Utils/StringUtils.h>
+#include <fstream>
+#include <random>
+
+#include "MapObjectGenerator.h"
+#include "../../client/Utils/CullingUtils.h"
+
+namespace Generators::MapGenerator
+{
+    // Integer hash to [0..1], used as the lattice for the value noise so the heightfield only depends on the seed and the position
+    f32 HashLattice(i32 x, i32 y, u32 seed)
+    {
+        u32 hash = seed;
+        hash ^= static_cast<u32>(x) * 0x27d4eb2du;
+        hash = (hash ^ (hash >> 15)) * 0x85ebca6bu;
+        hash ^= static_cast<u32>(y) * 0x165667b1u;
+        hash = (hash ^ (hash >> 13)) * 0xc2b2ae35u;
+        hash ^= hash >> 16;
+
+        return static_cast<f32>(hash) / static_cast<f32>(0xffffffffu);
+    }
+
+    f32 ValueNoise(f32 x, f32 y, u32 seed)
+    {
+        f32 floorX = std::floor(x);
+        f32 floorY = std::floor(y);
+
+        i32 x0 = static_cast<i32>(floorX);
+        i32 y0 = static_cast<i32>(floorY);
+
+        f32 fractX = x - floorX;
+        f32 fractY = y - floorY;
+
+        // Smoothstep so the derivative is continuous across lattice cells
+        f32 u = fractX * fractX * (3.0f - 2.0f * fractX);
+        f32 v = fractY * fractY * (3.0f - 2.0f * fractY);
+
+        f32 a = HashLattice(x0, y0, seed);
+        f32 b = HashLattice(x0 + 1, y0, seed);
+        f32 c = HashLattice(x0, y0 + 1, seed);
+        f32 d = HashLattice(x0 + 1, y0 + 1, seed);
+
+        f32 top = a + (b - a) * u;
+        f32 bottom = c + (d - c) * u;
+
+        return (top + (bottom - top) * v) * 2.0f - 1.0f; // [-1..1]
+    }
+
+    f32 SampleHeight(const MapGeneratorDesc& desc, f32 adtX, f32 adtY)
+    {
+        f32 height = 0.0f;
+        f32 amplitude = 1.0f;
+        f32 frequency = desc.noiseFrequency;
+        f32 totalAmplitude = 0.0f;
+
+        for (u8 octave = 0; octave < desc.noiseOctaves; octave++)
+        {
+            height += ValueNoise(adtX * frequency, adtY * frequency, desc.seed + octave) * amplitude;
+            totalAmplitude += amplitude;
+
+            amplitude *= 0.5f;
+            frequency *= 2.0f;
+        }
+
+        if (totalAmplitude > 0.0f)
+        {
+            height /= totalAmplitude;
+        }
+
+        return desc.baseHeight + height * desc.heightAmplitude;
+    }
+
+    void GenerateChunk(const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY, Terrain::Chunk& chunk, StringTable& stringTable)
+    {
+        // Every chunk gets its own generator so the output of a chunk doesn't depend on the order chunks are generated in
+        const u32 chunkId = chunkX + (chunkY * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+        std::mt19937 rng(desc.seed ^ (chunkId * 0x9E3779B9u));
+        std::uniform_real_distribution<f32> chanceDistribution(0.0f, 1.0f);
+
+        chunk.chunkHeader.token = Terrain::MAP_CHUNK_TOKEN;
+        chunk.chunkHeader.version = Terrain::MAP_CHUNK_VERSION;
+
+        chunk.heightHeader.hasHeightBox = 0;
+        chunk.heightHeader.gridMinHeight = std::numeric_limits<f32>::max();
+        chunk.heightHeader.gridMaxHeight = std::numeric_limits<f32>::lowest();
+
+        const u32 textureCount = std::max(desc.textureCount, 1u);
+
+        for (u16 cellIndex = 0; cellIndex < Terrain::MAP_CELLS_PER_CHUNK; cellIndex++)
+        {
+            Terrain::Cell& cell = chunk.cells[cellIndex];
+
+            const u16 cellX = cellIndex % Terrain::MAP_CELLS_PER_CHUNK_SIDE;
+            const u16 cellY = cellIndex / Terrain::MAP_CELLS_PER_CHUNK_SIDE;
+
+            const f32 cellOriginX = (chunkX * Terrain::MAP_CHUNK_SIZE) + (cellX * Terrain::MAP_CELL_SIZE);
+            const f32 cellOriginY = (chunkY * Terrain::MAP_CHUNK_SIZE) + (cellY * Terrain::MAP_CELL_SIZE);
+
+            // Rows of 17 vertices, the first 9 are on the OUTER grid and the last 8 are on the INNER grid offset by half a patch
+            for (u16 vertex = 0; vertex < Terrain::MAP_CELL_TOTAL_GRID_SIZE; vertex++)
+            {
+                const u16 row = vertex / Terrain::MAP_CELL_TOTAL_GRID_STRIDE;
+                const u16 column = vertex % Terrain::MAP_CELL_TOTAL_GRID_STRIDE;
+
+                f32 patchX = static_cast<f32>(column);
+                f32 patchY = static_cast<f32>(row);
+
+                if (column >= Terrain::MAP_CELL_OUTER_GRID_STRIDE)
+                {
+                    patchX = (column - Terrain::MAP_CELL_OUTER_GRID_STRIDE) + 0.5f;
+                    patchY = row + 0.5f;
+                }
+
+                f32 height = SampleHeight(desc, cellOriginX + (patchX * Terrain::MAP_PATCH_SIZE), cellOriginY + (patchY * Terrain::MAP_PATCH_SIZE));
+                cell.heightData[vertex] = height;
+
+                chunk.heightHeader.gridMinHeight = std::min(chunk.heightHeader.gridMinHeight, height);
+                chunk.heightHeader.gridMaxHeight = std::max(chunk.heightHeader.gridMaxHeight, height);
+            }
+
+            cell.areaId = 0;
+            cell.hole = 0;
+
+            if (chanceDistribution(rng) < desc.holeDensity)
+            {
+                // A zero mask would mean no holes, always set at least one bit
+                cell.hole = static_cast<u16>(rng() & 0xFFFF) | 1;
+            }
+
+            const u32 numLayers = 1 + (rng() % 4);
+            for (u32 layer = 0; layer < 4; layer++)
+            {
+                if (layer >= numLayers)
+                {
+                    cell.layers[layer].textureId = Terrain::LayerData::TextureIdInvalid;
+                    continue;
+                }
+
+                std::string texturePath = GetTexturePath(rng() % textureCount);
+                cell.layers[layer].textureId = stringTable.AddString(texturePath);
+            }
+        }
+
+        chunk.alphaMapStringID = std::numeric_limits<u32>::max();
+        if (desc.alphaMaps)
+        {
+            chunk.alphaMapStringID = stringTable.AddString(GetAlphaMapPath(desc, chunkX, chunkY));
+        }
+
+        chunk.mapObjectPlacements.clear();
+        if (desc.mapObjectCount > 0 && desc.mapObjectsPerChunk > 0.0f)
+        {
+            // The fractional part of the density becomes the chance of one extra placement
+            u32 numPlacements = static_cast<u32>(desc.mapObjectsPerChunk);
+            if (chanceDistribution(rng) < desc.mapObjectsPerChunk - static_cast<f32>(numPlacements))
+            {
+                numPlacements++;
+            }
+
+            std::uniform_real_distribution<f32> offsetDistribution(0.0f, Terrain::MAP_CHUNK_SIZE);
+            std::uniform_real_distribution<f32> rotationDistribution(0.0f, 360.0f);
+
+            chunk.mapObjectPlacements.reserve(numPlacements);
+            for (u32 i = 0; i < numPlacements; i++)
+            {
+                const f32 adtX = (chunkX * Terrain::MAP_CHUNK_SIZE) + offsetDistribution(rng);
+                const f32 adtY = (chunkY * Terrain::MAP_CHUNK_SIZE) + offsetDistribution(rng);
+
+                Terrain::MapObjectPlacement& placement = chunk.mapObjectPlacements.emplace_back();
+                placement.nameID = stringTable.AddString(MapObjectGenerator::GetMapObjectName(rng() % desc.mapObjectCount));
+
+                // Placements are stored in [0 .. MAP_SIZE] space, MapObjectRenderer swizzles them into world space
+                placement.position = vec3(adtX, SampleHeight(desc, adtX, adtY), adtY);
+                placement.rotation = vec3(0.0f, rotationDistribution(rng), 0.0f);
+                placement.scale = 1024;
+            }
+        }
+    }
+
+    std::string GetTexturePath(u32 textureIndex)
+    {
+        return "Generated/Texture_" + std::to_string(textureIndex) + ".bmp";
+    }
+
+    std::string GetAlphaMapPath(const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY)
+    {
+        return "Data/extracted/Textures/ChunkAlphaMaps/" + desc.name + "/" + desc.name + "_" + std::to_string(chunkX) + "_" + std::to_string(chunkY) + ".bmp";
+    }
+
+    std::string GetChunkFileName(const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY)
+    {
+        return desc.name + "_" + std::to_string(chunkX) + "_" + std::to_string(chunkY) + ".nmap";
+    }
+
+    void GenerateMap(const MapGeneratorDesc& desc, Terrain::Map& map)
+    {
+        map.Clear();
+        map.id = 0;
+
+        const u16 chunksPerSide = std::min<u16>(desc.chunksPerSide, Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+        const u16 start = static_cast<u16>((Terrain::MAP_CHUNKS_PER_MAP_STRIDE - chunksPerSide) / 2);
+
+        for (u16 y = start; y < start + chunksPerSide; y++)
+        {
+            for (u16 x = start; x < start + chunksPerSide; x++)
+            {
+                const u16 chunkId = x + (y * Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+
+                GenerateChunk(desc, x, y, map.chunks[chunkId], map.stringTables[chunkId]);
+            }
+        }
+    }
+
+    bool WriteChunk(const std::filesystem::path& path, const Terrain::Chunk& chunk, StringTable& stringTable)
+    {
+        size_t stringTableSize = sizeof(u32);
+        for (u32 i = 0; i < stringTable.GetNumStrings(); i++)
+        {
+            // Strings are serialized null terminated
+            stringTableSize += stringTable.GetString(i).size() + 1;
+        }
+
+        const size_t placementsSize = sizeof(Terrain::MapObjectPlacement) * chunk.mapObjectPlacements.size();
+        const size_t size = sizeof(Terrain::ChunkHeader) + sizeof(Terrain::HeightHeader) + sizeof(Terrain::HeightBox) + (sizeof(Terrain::Cell) * Terrain::MAP_CELLS_PER_CHUNK) + sizeof(u32) + sizeof(u32) + placementsSize + stringTableSize;
+
+        Bytebuffer buffer(nullptr, size);
+        buffer.Put<Terrain::ChunkHeader>(chunk.chunkHeader);
+        buffer.Put<Terrain::HeightHeader>(chunk.heightHeader);
+        buffer.Put<Terrain::HeightBox>(chunk.heightBox);
+
+        for (u32 i = 0; i < Terrain::MAP_CELLS_PER_CHUNK; i++)
+        {
+            buffer.Put<Terrain::Cell>(chunk.cells[i]);
+        }
+
+        buffer.Put<u32>(chunk.alphaMapStringID);
+        buffer.Put<u32>(static_cast<u32>(chunk.mapObjectPlacements.size()));
+
+        for (const Terrain::MapObjectPlacement& placement : chunk.mapObjectPlacements)
+        {
+            buffer.Put<Terrain::MapObjectPlacement>(placement);
+        }
+
+        stringTable.Serialize(&buffer);
+
+        std::ofstream output(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create chunk file %s", path.string().c_str());
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(buffer.GetDataPointer()), buffer.writtenData);
+        return true;
+    }
+
+    void CalculateCellBoundingBoxes(const Terrain::Map& map, std::vector<u16>& outChunkIds, std::vector<Geometry::AABoundingBox>& outBoundingBoxes)
+    {
+        outChunkIds.clear();
+        outBoundingBoxes.clear();
+
+        outChunkIds.reserve(map.chunks.size());
+        outBoundingBoxes.reserve(map.chunks.size() * Terrain::MAP_CELLS_PER_CHUNK);
+
+        // Sorted so the layout doesn't depend on the iteration order of the map
+        for (const auto& itr : map.chunks)
+        {
+            outChunkIds.push_back(itr.first);
+        }
+        std::sort(outChunkIds.begin(), outChunkIds.end());
+
+        for (u16 chunkId : outChunkIds)
+        {
+            const u16 chunkX = chunkId % Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+            const u16 chunkY = chunkId / Terrain::MAP_CHUNKS_PER_MAP_STRIDE;
+
+            const Terrain::Chunk& chunk = map.chunks.at(chunkId);
+            for (u32 cellIndex = 0; cellIndex < Terrain::MAP_CELLS_PER_CHUNK; cellIndex++)
+            {
+                outBoundingBoxes.push_back(Terrain::CullingUtils::CalculateCellBoundingBox(chunkX, chunkY, cellIndex, chunk.cells[cellIndex]));
+            }
+        }
+    }
+
+    std::vector<vec3> GeneratePositions(const MapGeneratorDesc& desc, u32 seed, size_t count)
+    {
+        const u16 chunksPerSide = std::min<u16>(desc.chunksPerSide, Terrain::MAP_CHUNKS_PER_MAP_STRIDE);
+        const u16 start = static_cast<u16>((Terrain::MAP_CHUNKS_PER_MAP_STRIDE - chunksPerSide) / 2);
+
+        // Stay slightly inside the generated area so queries never land on a chunk that doesn't exist
+        const f32 minAdt = (start * Terrain::MAP_CHUNK_SIZE) + 1.0f;
+        const f32 maxAdt = ((start + chunksPerSide) * Terrain::MAP_CHUNK_SIZE) - 1.0f;
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<f32> adtDistribution(minAdt, maxAdt);
+
+        std::vector<vec3> positions;
+        positions.reserve(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            f32 adtX = adtDistribution(rng);
+            f32 adtY = adtDistribution(rng);
+
+            // MapUtils converts world to ADT space as adt = (MAP_HALF_SIZE - world.z, MAP_HALF_SIZE - world.x)
+            vec3 position;
+            position.x = Terrain::MAP_HALF_SIZE - adtY;
+            position.y = SampleHeight(desc, adtX, adtY);
+            position.z = Terrain::MAP_HALF_SIZE - adtX;
+
+            positions.push_back(position);
+        }
+
+        return positions;
+    }
+}
@@ -0,0 +1,84 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <Math/Geometry.h>
+
+#include "../../client/Gameplay/Map/Map.h"
+
+namespace Generators
+{
+    struct MapGeneratorDesc
+    {
+        u32 seed = 1337;
+        std::string name = "Generated";
+
+        // Chunks are generated in a square centered on the middle of the map grid
+        u16 chunksPerSide = 8;
+
+        f32 baseHeight = 0.0f;
+        f32 heightAmplitude = 150.0f;
+        f32 noiseFrequency = 1.0f / 200.0f; // Features per yard
+        u8 noiseOctaves = 4;
+
+        f32 holeDensity = 0.0f; // Chance [0..1] for a cell to get holes
+        u32 textureCount = 8;
+
+        // Chunks reference an alpha map at GetAlphaMapPath, TextureGenerator::WriteAlphaMap writes them
+        bool alphaMaps = false;
+
+        // Placements reference MapObjectGenerator::GetMapObjectName(0..mapObjectCount-1)
+        f32 mapObjectsPerChunk = 0.0f;
+        u32 mapObjectCount = 0;
+    };
+
+    namespace MapGenerator
+    {
+        // Generates a full map in memory, chunks get the same ids MapLoader would give them
+        void GenerateMap(const MapGeneratorDesc& desc, Terrain::Map& map);
+        void GenerateChunk(const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY, Terrain::Chunk& chunk, StringTable& stringTable);
+
+        // Heightfield used by the generator, exposed so benchmarks can validate queries against it
+        f32 SampleHeight(const MapGeneratorDesc& desc, f32 adtX, f32 adtY);
+
+        // Texture paths are relative to Data/extracted/Textures, alpha map paths are relative to the working directory like the extractor writes them
+        std::string GetTexturePath(u32 textureIndex);
+        std::string GetAlphaMapPath(const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY);
+
+        // Chunk files are named <Name>_<X>_<Y>.nmap, MapLoader parses the chunk position from that
+        std::string GetChunkFileName(const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY);
+
+        // Writes a chunk in the .nmap format read by MapLoader::ExtractChunkData
+        bool WriteChunk(const std::filesystem::path& path, const Terrain::Chunk& chunk, StringTable& stringTable);
+
+        // Calculates cell bounding boxes the same way TerrainRenderer::LoadChunk does
+        void CalculateCellBoundingBoxes(const Terrain::Map& map, std::vector<u16>& outChunkIds, std::vector<Geometry::AABoundingBox>& outBoundingBoxes);
+
+        // Random world positions on top of the generated chunks
+        std::vector<vec3> GeneratePositions(const MapGeneratorDesc& desc, u32 seed, size_t count);
+    }
+}
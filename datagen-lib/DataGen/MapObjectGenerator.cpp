@@ -0,0 +1,255 @@
+#include "MapObjectGenerator.h"
+#include <Utils/ByteBuffer.h>
+#include <Utils/DebugHandler.h>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "MapGenerator.h"
+
+namespace Generators::MapObjectGenerator
+{
+    std::mt19937 CreateGenerator(u32 seed, u32 mapObjectIndex, u32 groupIndex)
+    {
+        // Seeded per object and group so the objects don't depend on the order they are generated in
+        return std::mt19937(seed ^ (mapObjectIndex * 0x9E3779B9u) ^ ((groupIndex + 1) * 0x85EBCA6Bu));
+    }
+
+    bool WriteBuffer(const std::filesystem::path& path, Bytebuffer& buffer)
+    {
+        std::ofstream output(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create file %s", path.string().c_str());
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(buffer.GetDataPointer()), buffer.writtenData);
+        return true;
+    }
+
+    std::string GetMapObjectName(u32 mapObjectIndex)
+    {
+        return "Generated/MapObject_" + std::to_string(mapObjectIndex) + ".nmor";
+    }
+
+    std::string GetMapObjectGroupName(u32 mapObjectIndex, u32 groupIndex)
+    {
+        // Same naming MapObjectRenderer uses to find the groups of a root
+        std::stringstream ss;
+        ss << "Generated/MapObject_" << mapObjectIndex << "_" << std::setw(3) << std::setfill('0') << groupIndex << ".nmo";
+        return ss.str();
+    }
+
+    void GenerateMapObjectRoot(const MapObjectGeneratorDesc& desc, u32 mapObjectIndex, Terrain::MapObjectRoot& mapObjectRoot, StringTable& textureStringTable)
+    {
+        std::mt19937 rng = CreateGenerator(desc.seed, mapObjectIndex, std::numeric_limits<u32>::max());
+
+        mapObjectRoot.header.token = Terrain::MAP_OBJECT_ROOT_TOKEN;
+        mapObjectRoot.header.version = Terrain::MAP_OBJECT_ROOT_VERSION;
+
+        const u32 textureCount = std::max(desc.textureCount, 1u);
+        const u32 materialCount = std::max(desc.materialCount, 1u);
+
+        mapObjectRoot.materials.resize(materialCount);
+        for (Terrain::MapObjectMaterial& material : mapObjectRoot.materials)
+        {
+            material.materialType = 0;
+            material.transparencyMode = (rng() % 4 == 0) ? 1 : 0;
+            material.textureNameID[0] = textureStringTable.AddString(MapGenerator::GetTexturePath(rng() % textureCount));
+        }
+
+        const u32 minGroups = std::max(desc.minGroups, 1u);
+        std::uniform_int_distribution<u32> groupDistribution(minGroups, std::max(minGroups, desc.maxGroups));
+        mapObjectRoot.numMapObjects = groupDistribution(rng);
+    }
+
+    void GenerateMapObject(const MapObjectGeneratorDesc& desc, u32 mapObjectIndex, u32 groupIndex, u32 materialCount, Terrain::MapObject& mapObject)
+    {
+        std::mt19937 rng = CreateGenerator(desc.seed, mapObjectIndex, groupIndex);
+
+        mapObject.header.token = Terrain::MAP_OBJECT_TOKEN;
+        mapObject.header.version = Terrain::MAP_OBJECT_VERSION;
+
+        const u32 minSubdivisions = std::max(desc.minSubdivisions, 1u);
+        std::uniform_int_distribution<u32> subdivisionDistribution(minSubdivisions, std::max(minSubdivisions, desc.maxSubdivisions));
+        std::uniform_real_distribution<f32> extentDistribution(2.0f, 20.0f);
+        std::uniform_real_distribution<f32> offsetDistribution(-20.0f, 20.0f);
+
+        // Indices are 16 bit, 6 faces of (100 + 1)^2 vertices is the most that fits
+        const u32 subdivisions = std::min(subdivisionDistribution(rng), 100u);
+        const vec3 extents = vec3(extentDistribution(rng), extentDistribution(rng), extentDistribution(rng));
+        const vec3 center = vec3(offsetDistribution(rng), extents.y, offsetDistribution(rng));
+
+        // Normal, tangent and bitangent of every box face
+        const vec3 faces[6][3] =
+        {
+            { vec3( 1, 0, 0), vec3(0, 0, 1), vec3(0, 1, 0) },
+            { vec3(-1, 0, 0), vec3(0, 0,-1), vec3(0, 1, 0) },
+            { vec3( 0, 1, 0), vec3(1, 0, 0), vec3(0, 0, 1) },
+            { vec3( 0,-1, 0), vec3(1, 0, 0), vec3(0, 0,-1) },
+            { vec3( 0, 0, 1), vec3(-1,0, 0), vec3(0, 1, 0) },
+            { vec3( 0, 0,-1), vec3(1, 0, 0), vec3(0, 1, 0) }
+        };
+
+        const u32 verticesPerEdge = subdivisions + 1;
+        const u32 verticesPerFace = verticesPerEdge * verticesPerEdge;
+
+        mapObject.indices.clear();
+        mapObject.vertexPositions.clear();
+        mapObject.vertexNormals.clear();
+        mapObject.uvSets.clear();
+        mapObject.triangleData.clear();
+        mapObject.renderBatches.clear();
+
+        Terrain::UVSet& uvSet = mapObject.uvSets.emplace_back();
+
+        mapObject.vertexPositions.reserve(6 * verticesPerFace);
+        mapObject.vertexNormals.reserve(6 * verticesPerFace);
+        uvSet.vertexUVs.reserve(6 * verticesPerFace);
+
+        // Faces are sorted by material so every material becomes one contiguous render batch
+        std::vector<u8> faceMaterials(6);
+        for (u8& faceMaterial : faceMaterials)
+        {
+            faceMaterial = static_cast<u8>(rng() % std::max(materialCount, 1u));
+        }
+        std::sort(faceMaterials.begin(), faceMaterials.end());
+
+        for (u32 face = 0; face < 6; face++)
+        {
+            const vec3& normal = faces[face][0];
+            const vec3& tangent = faces[face][1];
+            const vec3& bitangent = faces[face][2];
+
+            const u32 firstVertex = static_cast<u32>(mapObject.vertexPositions.size());
+            for (u32 y = 0; y < verticesPerEdge; y++)
+            {
+                for (u32 x = 0; x < verticesPerEdge; x++)
+                {
+                    const f32 u = static_cast<f32>(x) / subdivisions;
+                    const f32 v = static_cast<f32>(y) / subdivisions;
+
+                    vec3 position = normal + tangent * (u * 2.0f - 1.0f) + bitangent * (v * 2.0f - 1.0f);
+                    mapObject.vertexPositions.push_back(center + position * extents);
+                    mapObject.vertexNormals.push_back(normal);
+                    uvSet.vertexUVs.push_back(vec2(u, v));
+                }
+            }
+
+            const u8 materialID = faceMaterials[face];
+            if (mapObject.renderBatches.empty() || mapObject.renderBatches.back().materialID != materialID)
+            {
+                Terrain::RenderBatch& renderBatch = mapObject.renderBatches.emplace_back();
+                renderBatch.startIndex = static_cast<u32>(mapObject.indices.size());
+                renderBatch.indexCount = 0;
+                renderBatch.materialID = materialID;
+            }
+
+            for (u32 y = 0; y < subdivisions; y++)
+            {
+                for (u32 x = 0; x < subdivisions; x++)
+                {
+                    const u16 topLeft = static_cast<u16>(firstVertex + (y * verticesPerEdge) + x);
+                    const u16 topRight = topLeft + 1;
+                    const u16 bottomLeft = static_cast<u16>(topLeft + verticesPerEdge);
+                    const u16 bottomRight = bottomLeft + 1;
+
+                    const u16 quadIndices[6] = { topLeft, bottomLeft, topRight, topRight, bottomLeft, bottomRight };
+                    mapObject.indices.insert(mapObject.indices.end(), quadIndices, quadIndices + 6);
+
+                    for (u32 i = 0; i < 2; i++)
+                    {
+                        Terrain::TriangleData& triangleData = mapObject.triangleData.emplace_back();
+                        triangleData.flags = {};
+                        triangleData.flags.Render = 1;
+                        triangleData.flags.Collision = 1;
+                        triangleData.materialID = materialID;
+                    }
+
+                    mapObject.renderBatches.back().indexCount += 6;
+                }
+            }
+        }
+    }
+
+    bool WriteMapObjectRoot(const std::filesystem::path& path, const Terrain::MapObjectRoot& mapObjectRoot, StringTable& textureStringTable)
+    {
+        size_t stringTableSize = sizeof(u32);
+        for (u32 i = 0; i < textureStringTable.GetNumStrings(); i++)
+        {
+            stringTableSize += textureStringTable.GetString(i).size() + 1;
+        }
+
+        const size_t size = sizeof(Terrain::MapObjectRootHeader) + sizeof(u32) + (sizeof(Terrain::MapObjectMaterial) * mapObjectRoot.materials.size()) + sizeof(u32) + stringTableSize;
+
+        Bytebuffer buffer(nullptr, size);
+        buffer.Put<Terrain::MapObjectRootHeader>(mapObjectRoot.header);
+
+        buffer.Put<u32>(static_cast<u32>(mapObjectRoot.materials.size()));
+        for (const Terrain::MapObjectMaterial& material : mapObjectRoot.materials)
+        {
+            buffer.Put<Terrain::MapObjectMaterial>(material);
+        }
+
+        buffer.Put<u32>(mapObjectRoot.numMapObjects);
+        textureStringTable.Serialize(&buffer);
+
+        return WriteBuffer(path, buffer);
+    }
+
+    bool WriteMapObject(const std::filesystem::path& path, const Terrain::MapObject& mapObject)
+    {
+        const size_t numVertices = mapObject.vertexPositions.size();
+
+        size_t size = sizeof(Terrain::MapObjectHeader);
+        size += sizeof(u32) + (sizeof(u16) * mapObject.indices.size());
+        size += sizeof(u32) + (sizeof(vec3) * numVertices * 2);
+        size += sizeof(u32) + (sizeof(vec2) * numVertices * mapObject.uvSets.size());
+        size += sizeof(u32) + (sizeof(Terrain::TriangleData) * mapObject.triangleData.size());
+        size += sizeof(u32) + (sizeof(Terrain::RenderBatch) * mapObject.renderBatches.size());
+
+        Bytebuffer buffer(nullptr, size);
+        buffer.Put<Terrain::MapObjectHeader>(mapObject.header);
+
+        buffer.Put<u32>(static_cast<u32>(mapObject.indices.size()));
+        for (u16 index : mapObject.indices)
+        {
+            buffer.Put<u16>(index);
+        }
+
+        buffer.Put<u32>(static_cast<u32>(numVertices));
+        for (const vec3& position : mapObject.vertexPositions)
+        {
+            buffer.Put<vec3>(position);
+        }
+        for (const vec3& normal : mapObject.vertexNormals)
+        {
+            buffer.Put<vec3>(normal);
+        }
+
+        buffer.Put<u32>(static_cast<u32>(mapObject.uvSets.size()));
+        for (const Terrain::UVSet& uvSet : mapObject.uvSets)
+        {
+            for (const vec2& uv : uvSet.vertexUVs)
+            {
+                buffer.Put<vec2>(uv);
+            }
+        }
+
+        buffer.Put<u32>(static_cast<u32>(mapObject.triangleData.size()));
+        for (const Terrain::TriangleData& triangleData : mapObject.triangleData)
+        {
+            buffer.Put<Terrain::TriangleData>(triangleData);
+        }
+
+        buffer.Put<u32>(static_cast<u32>(mapObject.renderBatches.size()));
+        for (const Terrain::RenderBatch& renderBatch : mapObject.renderBatches)
+        {
+            buffer.Put<Terrain::RenderBatch>(renderBatch);
+        }
+
+        return WriteBuffer(path, buffer);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <Containers/StringTable.h>
+
+#include "../../client/Gameplay/Map/MapObjectRoot.h"
+#include "../../client/Gameplay/Map/MapObject.h"
+
+namespace Generators
+{
+    struct MapObjectGeneratorDesc
+    {
+        u32 seed = 1337;
+
+        u32 minGroups = 1; // Each group becomes one .nmo file
+        u32 maxGroups = 3;
+
+        u32 minSubdivisions = 2; // Quads per box face edge, vertex count grows quadratically with this
+        u32 maxSubdivisions = 8;
+
+        u32 materialCount = 2;
+        u32 textureCount = 8;
+    };
+
+    namespace MapObjectGenerator
+    {
+        // Names are relative to Data/extracted/MapObjects like the ones chunk placements reference
+        std::string GetMapObjectName(u32 mapObjectIndex);
+        std::string GetMapObjectGroupName(u32 mapObjectIndex, u32 groupIndex);
+
+        void GenerateMapObjectRoot(const MapObjectGeneratorDesc& desc, u32 mapObjectIndex, Terrain::MapObjectRoot& mapObjectRoot, StringTable& textureStringTable);
+
+        // Generates a box made out of subdivided faces with one render batch per material
+        void GenerateMapObject(const MapObjectGeneratorDesc& desc, u32 mapObjectIndex, u32 groupIndex, u32 materialCount, Terrain::MapObject& mapObject);
+
+        // Writes the .nmor and .nmo formats read by MapObjectRenderer::LoadMapObject
+        bool WriteMapObjectRoot(const std::filesystem::path& path, const Terrain::MapObjectRoot& mapObjectRoot, StringTable& textureStringTable);
+        bool WriteMapObject(const std::filesystem::path& path, const Terrain::MapObject& mapObject);
+    }
+}
@@ -0,0 +1,310 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Generators::MeshOptimizer
+{
+    // Constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation", the cache is the LRU the scores are modelled on
+    constexpr u32 SCORE_CACHE_SIZE = 32;
+    constexpr f32 CACHE_DECAY_POWER = 1.5f;
+    constexpr f32 LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr f32 VALENCE_BOOST_SCALE = 2.0f;
+    constexpr f32 VALENCE_BOOST_POWER = 0.5f;
+
+    constexpr u32 INVALID_TRIANGLE = std::numeric_limits<u32>::max();
+
+    f32 GetVertexScore(i32 cachePosition, u32 remainingTriangles)
+    {
+        // Vertices without triangles left should never pull a triangle in
+        if (remainingTriangles == 0)
+            return -1.0f;
+
+        f32 score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // Used by the triangle that was just emitted, scored a bit lower so strips don't get too long and thin
+                score = LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                const f32 scaler = 1.0f / (SCORE_CACHE_SIZE - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+
+        // Vertices with few triangles left get boosted so they are finished off and don't have to be transformed again later
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<f32>(remainingTriangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+
+    f32 CalculateACMR(const std::vector<u32>& indices, u32 numVertices, u32 cacheSize)
+    {
+        if (indices.size() < 3)
+            return 0.0f;
+
+        // A vertex is still cached if fewer than cacheSize misses happened since it was transformed
+        std::vector<u32> timestamps(numVertices, 0);
+        u32 time = cacheSize + 1;
+        u32 misses = 0;
+
+        for (u32 index : indices)
+        {
+            if (time - timestamps[index] > cacheSize)
+            {
+                timestamps[index] = time++;
+                misses++;
+            }
+        }
+
+        return static_cast<f32>(misses) / static_cast<f32>(indices.size() / 3);
+    }
+
+    void OptimizeVertexCache(std::vector<u32>& indices, u32 numVertices)
+    {
+        const u32 numTriangles = static_cast<u32>(indices.size() / 3);
+        if (numTriangles == 0)
+            return;
+
+        // Triangles using every vertex, packed into one array
+        std::vector<u32> triangleCounts(numVertices, 0);
+        for (u32 index : indices)
+        {
+            triangleCounts[index]++;
+        }
+
+        std::vector<u32> triangleOffsets(numVertices, 0);
+        for (u32 i = 1; i < numVertices; i++)
+        {
+            triangleOffsets[i] = triangleOffsets[i - 1] + triangleCounts[i - 1];
+        }
+
+        std::vector<u32> adjacency(indices.size());
+        std::vector<u32> remainingTriangles(numVertices, 0);
+        for (u32 i = 0; i < numTriangles; i++)
+        {
+            for (u32 j = 0; j < 3; j++)
+            {
+                const u32 vertex = indices[i * 3 + j];
+                adjacency[triangleOffsets[vertex] + remainingTriangles[vertex]++] = i;
+            }
+        }
+
+        std::vector<f32> vertexScores(numVertices);
+        for (u32 i = 0; i < numVertices; i++)
+        {
+            vertexScores[i] = GetVertexScore(-1, remainingTriangles[i]);
+        }
+
+        std::vector<u8> emitted(numTriangles, 0);
+        std::vector<u32> output;
+        output.reserve(indices.size());
+
+        // Room for a full cache plus the three vertices pushed in front of it
+        std::vector<u32> cache;
+        std::vector<u32> newCache;
+        cache.reserve(SCORE_CACHE_SIZE + 3);
+        newCache.reserve(SCORE_CACHE_SIZE + 3);
+
+        u32 bestTriangle = 0;
+        u32 nextUnemitted = 0;
+
+        for (u32 emittedTriangles = 0; emittedTriangles < numTriangles; emittedTriangles++)
+        {
+            if (bestTriangle == INVALID_TRIANGLE)
+            {
+                // Nothing in the cache has triangles left, continue with whatever comes next in the input
+                while (emitted[nextUnemitted])
+                {
+                    nextUnemitted++;
+                }
+                bestTriangle = nextUnemitted;
+            }
+
+            emitted[bestTriangle] = 1;
+
+            newCache.clear();
+            for (u32 j = 0; j < 3; j++)
+            {
+                const u32 vertex = indices[bestTriangle * 3 + j];
+                output.push_back(vertex);
+                newCache.push_back(vertex);
+
+                // Swap the triangle out of the vertices remaining triangles
+                u32* triangles = &adjacency[triangleOffsets[vertex]];
+                u32& remaining = remainingTriangles[vertex];
+                for (u32 k = 0; k < remaining; k++)
+                {
+                    if (triangles[k] == bestTriangle)
+                    {
+                        triangles[k] = triangles[remaining - 1];
+                        remaining--;
+                        break;
+                    }
+                }
+            }
+
+            for (u32 vertex : cache)
+            {
+                if (vertex != newCache[0] && vertex != newCache[1] && vertex != newCache[2])
+                {
+                    newCache.push_back(vertex);
+                }
+            }
+
+            // Vertices falling out of the cache lose their cache score
+            for (size_t j = SCORE_CACHE_SIZE; j < newCache.size(); j++)
+            {
+                const u32 vertex = newCache[j];
+                vertexScores[vertex] = GetVertexScore(-1, remainingTriangles[vertex]);
+            }
+
+            if (newCache.size() > SCORE_CACHE_SIZE)
+            {
+                newCache.resize(SCORE_CACHE_SIZE);
+            }
+            std::swap(cache, newCache);
+
+            for (u32 j = 0; j < cache.size(); j++)
+            {
+                const u32 vertex = cache[j];
+                vertexScores[vertex] = GetVertexScore(static_cast<i32>(j), remainingTriangles[vertex]);
+            }
+
+            // Scores are only recomputed for triangles touching the cache, the best of those is emitted next
+            bestTriangle = INVALID_TRIANGLE;
+            f32 bestScore = -1.0f;
+            for (u32 vertex : cache)
+            {
+                const u32* triangles = &adjacency[triangleOffsets[vertex]];
+                for (u32 k = 0; k < remainingTriangles[vertex]; k++)
+                {
+                    const u32 triangle = triangles[k];
+                    const f32 score = vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]] + vertexScores[indices[triangle * 3 + 2]];
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = triangle;
+                    }
+                }
+            }
+        }
+
+        indices.swap(output);
+    }
+
+    void OptimizeOverdraw(std::vector<u32>& indices, const vec3* positions, size_t positionStride, u32 numVertices, u32 cacheSize, f32 threshold)
+    {
+        const u32 numTriangles = static_cast<u32>(indices.size() / 3);
+        if (numTriangles == 0)
+            return;
+
+        auto GetPosition = [&](u32 vertex) -> const vec3&
+        {
+            return *reinterpret_cast<const vec3*>(reinterpret_cast<const u8*>(positions) + vertex * positionStride);
+        };
+
+        // A cluster starts wherever all three vertices of a triangle missed the cache, moving clusters around then barely costs any cache hits
+        std::vector<u32> clusterStarts;
+        {
+            std::vector<u32> timestamps(numVertices, 0);
+            u32 time = cacheSize + 1;
+
+            for (u32 i = 0; i < numTriangles; i++)
+            {
+                u32 misses = 0;
+                for (u32 j = 0; j < 3; j++)
+                {
+                    const u32 vertex = indices[i * 3 + j];
+                    if (time - timestamps[vertex] > cacheSize)
+                    {
+                        timestamps[vertex] = time++;
+                        misses++;
+                    }
+                }
+
+                if (i == 0 || misses == 3)
+                {
+                    clusterStarts.push_back(i);
+                }
+            }
+        }
+
+        const u32 numClusters = static_cast<u32>(clusterStarts.size());
+        if (numClusters < 2)
+            return;
+
+        clusterStarts.push_back(numTriangles);
+
+        // Area weighted centroid and normal of every cluster
+        std::vector<vec3> clusterCentroids(numClusters, vec3(0.0f));
+        std::vector<vec3> clusterNormals(numClusters, vec3(0.0f));
+        std::vector<f32> clusterAreas(numClusters, 0.0f);
+        vec3 meshCentroid = vec3(0.0f);
+        f32 meshArea = 0.0f;
+
+        for (u32 cluster = 0; cluster < numClusters; cluster++)
+        {
+            for (u32 i = clusterStarts[cluster]; i < clusterStarts[cluster + 1]; i++)
+            {
+                const vec3& a = GetPosition(indices[i * 3]);
+                const vec3& b = GetPosition(indices[i * 3 + 1]);
+                const vec3& c = GetPosition(indices[i * 3 + 2]);
+
+                const vec3 normal = glm::cross(b - a, c - a);
+                const f32 area = glm::length(normal);
+                const vec3 centroid = (a + b + c) / 3.0f;
+
+                clusterCentroids[cluster] += centroid * area;
+                clusterNormals[cluster] += normal;
+                clusterAreas[cluster] += area;
+            }
+
+            meshCentroid += clusterCentroids[cluster];
+            meshArea += clusterAreas[cluster];
+        }
+
+        if (meshArea > 0.0f)
+        {
+            meshCentroid /= meshArea;
+        }
+
+        // Clusters facing away from the middle of the mesh are the ones most likely to be in front of the rest, they go first
+        std::vector<f32> clusterSortKeys(numClusters, 0.0f);
+        for (u32 cluster = 0; cluster < numClusters; cluster++)
+        {
+            const f32 normalLength = glm::length(clusterNormals[cluster]);
+            if (clusterAreas[cluster] <= 0.0f || normalLength <= 0.0f)
+                continue;
+
+            const vec3 centroid = clusterCentroids[cluster] / clusterAreas[cluster];
+            clusterSortKeys[cluster] = glm::dot(centroid - meshCentroid, clusterNormals[cluster] / normalLength);
+        }
+
+        std::vector<u32> clusterOrder(numClusters);
+        for (u32 i = 0; i < numClusters; i++)
+        {
+            clusterOrder[i] = i;
+        }
+
+        std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](u32 a, u32 b)
+        {
+            return clusterSortKeys[a] > clusterSortKeys[b];
+        });
+
+        std::vector<u32> output;
+        output.reserve(indices.size());
+        for (u32 cluster : clusterOrder)
+        {
+            output.insert(output.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + clusterStarts[cluster + 1] * 3);
+        }
+
+        if (CalculateACMR(output, numVertices, cacheSize) > CalculateACMR(indices, numVertices, cacheSize) * threshold)
+            return;
+
+        indices.swap(output);
+    }
+}
@@ -0,0 +1,46 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <vector>
+
+namespace Generators
+{
+    // Index reordering done once at conversion time so the GPU doesn't pay for badly ordered exports every frame
+    namespace MeshOptimizer
+    {
+        // Size of the FIFO post-transform cache ACMR is measured against, what most GPUs behave like
+        constexpr u32 DEFAULT_CACHE_SIZE = 16;
+
+        // Average cache miss ratio, vertices transformed per triangle. 3.0 is the worst case, ~0.5 the best a regular grid can do
+        f32 CalculateACMR(const std::vector<u32>& indices, u32 numVertices, u32 cacheSize = DEFAULT_CACHE_SIZE);
+
+        // Reorders triangles to be post-transform vertex cache friendly using Tom Forsyth's linear-speed algorithm
+        void OptimizeVertexCache(std::vector<u32>& indices, u32 numVertices);
+
+        // Splits cache optimized indices into clusters where the cache went cold and sorts those so outward facing clusters are drawn first,
+        // positionStride is in bytes. Keeps the input order if the ACMR would get worse than threshold times what it was
+        void OptimizeOverdraw(std::vector<u32>& indices, const vec3* positions, size_t positionStride, u32 numVertices, u32 cacheSize = DEFAULT_CACHE_SIZE, f32 threshold = 1.05f);
+    }
+}
@@ -0,0 +1,124 @@
+#include "ModelGenerator.h"
+#include <NovusTypeHeader.h>
+#include <Utils/DebugHandler.h>
+#include <fstream>
+
+#include "MeshOptimizer.h"
+
+namespace Generators::ModelGenerator
+{
+    std::string GetCubeModelPath()
+    {
+        return "Data/models/Cube.novusmodel";
+    }
+
+    void GenerateCube(const ModelGeneratorDesc& desc, std::vector<Renderer::Vertex>& vertices, std::vector<u32>& indices)
+    {
+        const u32 subdivisions = std::max(desc.subdivisions, 1u);
+
+        // Normal, tangent and bitangent of every cube face
+        const vec3 faces[6][3] =
+        {
+            { vec3( 1, 0, 0), vec3(0, 0, 1), vec3(0, 1, 0) },
+            { vec3(-1, 0, 0), vec3(0, 0,-1), vec3(0, 1, 0) },
+            { vec3( 0, 1, 0), vec3(1, 0, 0), vec3(0, 0, 1) },
+            { vec3( 0,-1, 0), vec3(1, 0, 0), vec3(0, 0,-1) },
+            { vec3( 0, 0, 1), vec3(-1,0, 0), vec3(0, 1, 0) },
+            { vec3( 0, 0,-1), vec3(1, 0, 0), vec3(0, 1, 0) }
+        };
+
+        const u32 verticesPerEdge = subdivisions + 1;
+        const u32 verticesPerFace = verticesPerEdge * verticesPerEdge;
+
+        vertices.clear();
+        indices.clear();
+        vertices.reserve(6 * verticesPerFace);
+        indices.reserve(6 * subdivisions * subdivisions * 6);
+
+        for (u32 face = 0; face < 6; face++)
+        {
+            const vec3& normal = faces[face][0];
+            const vec3& tangent = faces[face][1];
+            const vec3& bitangent = faces[face][2];
+
+            const u32 firstVertex = static_cast<u32>(vertices.size());
+            for (u32 y = 0; y < verticesPerEdge; y++)
+            {
+                for (u32 x = 0; x < verticesPerEdge; x++)
+                {
+                    const f32 u = static_cast<f32>(x) / subdivisions;
+                    const f32 v = static_cast<f32>(y) / subdivisions;
+
+                    Renderer::Vertex& vertex = vertices.emplace_back();
+                    vertex.pos = (normal + tangent * (u * 2.0f - 1.0f) + bitangent * (v * 2.0f - 1.0f)) * 0.5f;
+                    vertex.normal = normal;
+                    vertex.texCoord = vec2(u, v);
+                }
+            }
+
+            for (u32 y = 0; y < subdivisions; y++)
+            {
+                for (u32 x = 0; x < subdivisions; x++)
+                {
+                    const u32 topLeft = firstVertex + (y * verticesPerEdge) + x;
+                    const u32 topRight = topLeft + 1;
+                    const u32 bottomLeft = topLeft + verticesPerEdge;
+                    const u32 bottomRight = bottomLeft + 1;
+
+                    const u32 quadIndices[6] = { topLeft, bottomLeft, topRight, topRight, bottomLeft, bottomRight };
+                    indices.insert(indices.end(), quadIndices, quadIndices + 6);
+                }
+            }
+        }
+    }
+
+    void OptimizeModel(const ModelGeneratorDesc& desc, const std::vector<Renderer::Vertex>& vertices, std::vector<u32>& indices)
+    {
+        if (vertices.empty())
+            return;
+
+        const u32 numVertices = static_cast<u32>(vertices.size());
+
+        MeshOptimizer::OptimizeVertexCache(indices, numVertices);
+        MeshOptimizer::OptimizeOverdraw(indices, &vertices[0].pos, sizeof(Renderer::Vertex), numVertices, desc.cacheSize);
+    }
+
+    bool WriteModel(const std::filesystem::path& path, const std::vector<Renderer::Vertex>& vertices, const std::vector<u32>& indices)
+    {
+        std::ofstream output(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create file %s", path.string().c_str());
+            return false;
+        }
+
+        const NovusTypeHeader typeHeader = NovusTypeHeader(Renderer::ModelFileHeader::TYPE_ID, Renderer::ModelFileHeader::VERSION);
+
+        // Both blocks start 8 byte aligned no matter what size the NovusTypeHeader is
+        const u64 headerSize = sizeof(NovusTypeHeader) + sizeof(Renderer::ModelFileHeader);
+        const u64 vertexBytes = sizeof(Renderer::Vertex) * vertices.size();
+
+        Renderer::ModelFileHeader header;
+        header.vertexCount = static_cast<u32>(vertices.size());
+        header.indexCount = static_cast<u32>(indices.size());
+        header.vertexOffset = (headerSize + 7) & ~7ull;
+        header.indexOffset = (header.vertexOffset + vertexBytes + 7) & ~7ull;
+
+        const char padding[8] = {};
+
+        output.write(reinterpret_cast<const char*>(&typeHeader), sizeof(NovusTypeHeader));
+        output.write(reinterpret_cast<const char*>(&header), sizeof(Renderer::ModelFileHeader));
+        output.write(padding, header.vertexOffset - headerSize);
+        output.write(reinterpret_cast<const char*>(vertices.data()), vertexBytes);
+        output.write(padding, header.indexOffset - (header.vertexOffset + vertexBytes));
+        output.write(reinterpret_cast<const char*>(indices.data()), sizeof(u32) * indices.size());
+
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to write model %s", path.string().c_str());
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,56 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../../render-lib/Renderer/Descriptors/ModelDesc.h"
+
+namespace Generators
+{
+    struct ModelGeneratorDesc
+    {
+        u32 subdivisions = 8; // Quads per cube face edge
+
+        bool optimize = true; // Reorders the indices for the vertex cache and overdraw before writing, turn off to get the export order
+        u32 cacheSize = 16;
+    };
+
+    namespace ModelGenerator
+    {
+        // Relative to the working directory like the paths in ModelDesc
+        std::string GetCubeModelPath();
+
+        // Generates a unit cube made out of subdivided faces, triangles are in row order the way most exporters write grids
+        void GenerateCube(const ModelGeneratorDesc& desc, std::vector<Renderer::Vertex>& vertices, std::vector<u32>& indices);
+
+        // What the converter does before writing, vertex cache optimization followed by overdraw optimization
+        void OptimizeModel(const ModelGeneratorDesc& desc, const std::vector<Renderer::Vertex>& vertices, std::vector<u32>& indices);
+
+        // Writes the .novusmodel format read by Renderer::ModelFile::Read
+        bool WriteModel(const std::filesystem::path& path, const std::vector<Renderer::Vertex>& vertices, const std::vector<u32>& indices);
+    }
+}
@@ -0,0 +1,141 @@
+#include "TextureGenerator.h"
+#include <Utils/ByteBuffer.h>
+#include <Utils/DebugHandler.h>
+#include <fstream>
+#include <random>
+
+#include "MapGenerator.h"
+
+namespace Generators::TextureGenerator
+{
+#pragma pack(push, 1)
+    struct BMPFileHeader
+    {
+        u16 type = 0x4D42; // "BM"
+        u32 size = 0;
+        u16 reserved1 = 0;
+        u16 reserved2 = 0;
+        u32 offset = 0;
+    };
+
+    struct BMPInfoHeader
+    {
+        u32 size = sizeof(BMPInfoHeader);
+        i32 width = 0;
+        i32 height = 0;
+        u16 planes = 1;
+        u16 bitCount = 32;
+        u32 compression = 0; // BI_RGB
+        u32 imageSize = 0;
+        i32 xPixelsPerMeter = 2835;
+        i32 yPixelsPerMeter = 2835;
+        u32 colorsUsed = 0;
+        u32 colorsImportant = 0;
+    };
+#pragma pack(pop)
+
+    bool WriteBMP(const std::filesystem::path& path, u32 width, u32 height, const std::vector<u8>& rgbaPixels)
+    {
+        const u32 imageSize = width * height * 4;
+        if (rgbaPixels.size() < imageSize)
+        {
+            NC_LOG_ERROR("Tried to write %s with %u bytes of pixels, expected %u", path.string().c_str(), rgbaPixels.size(), imageSize);
+            return false;
+        }
+
+        BMPFileHeader fileHeader;
+        fileHeader.offset = sizeof(BMPFileHeader) + sizeof(BMPInfoHeader);
+        fileHeader.size = fileHeader.offset + imageSize;
+
+        BMPInfoHeader infoHeader;
+        infoHeader.width = static_cast<i32>(width);
+        infoHeader.height = -static_cast<i32>(height); // Negative height means rows are stored top to bottom
+        infoHeader.imageSize = imageSize;
+
+        Bytebuffer buffer(nullptr, fileHeader.size);
+        buffer.Put<BMPFileHeader>(fileHeader);
+        buffer.Put<BMPInfoHeader>(infoHeader);
+
+        // BMP stores BGRA
+        for (u32 i = 0; i < width * height; i++)
+        {
+            const u8* pixel = &rgbaPixels[i * 4];
+            buffer.Put<u8>(pixel[2]);
+            buffer.Put<u8>(pixel[1]);
+            buffer.Put<u8>(pixel[0]);
+            buffer.Put<u8>(pixel[3]);
+        }
+
+        std::ofstream output(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        if (!output)
+        {
+            NC_LOG_ERROR("Failed to create file %s", path.string().c_str());
+            return false;
+        }
+
+        output.write(reinterpret_cast<const char*>(buffer.GetDataPointer()), buffer.writtenData);
+        return true;
+    }
+
+    bool WriteTexture(const std::filesystem::path& path, u32 seed, u32 textureIndex, u32 size)
+    {
+        std::mt19937 rng(seed ^ ((textureIndex + 1) * 0x9E3779B9u));
+        std::uniform_int_distribution<u32> colorDistribution(64, 255);
+        std::uniform_int_distribution<i32> noiseDistribution(-16, 16);
+
+        const u8 tint[3] = { static_cast<u8>(colorDistribution(rng)), static_cast<u8>(colorDistribution(rng)), static_cast<u8>(colorDistribution(rng)) };
+        const u32 checkerSize = std::max(size / 8, 1u);
+
+        std::vector<u8> pixels(size * size * 4);
+        for (u32 y = 0; y < size; y++)
+        {
+            for (u32 x = 0; x < size; x++)
+            {
+                const bool isDark = ((x / checkerSize) + (y / checkerSize)) % 2 == 1;
+                u8* pixel = &pixels[((y * size) + x) * 4];
+
+                for (u32 channel = 0; channel < 3; channel++)
+                {
+                    i32 value = isDark ? tint[channel] / 2 : tint[channel];
+                    pixel[channel] = static_cast<u8>(std::clamp(value + noiseDistribution(rng), 0, 255));
+                }
+                pixel[3] = 255;
+            }
+        }
+
+        return WriteBMP(path, size, size, pixels);
+    }
+
+    bool WriteAlphaMap(const std::filesystem::path& path, const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY, u32 size)
+    {
+        std::vector<u8> pixels(size * size * 4);
+
+        // Offset every channel so the layers don't blend in lockstep
+        MapGeneratorDesc channelDescs[4] = { desc, desc, desc, desc };
+        for (u32 channel = 0; channel < 4; channel++)
+        {
+            channelDescs[channel].seed = desc.seed + 1000 + channel;
+            channelDescs[channel].baseHeight = 0.0f;
+            channelDescs[channel].heightAmplitude = 1.0f;
+        }
+
+        const f32 pixelSize = Terrain::MAP_CHUNK_SIZE / size;
+        for (u32 y = 0; y < size; y++)
+        {
+            for (u32 x = 0; x < size; x++)
+            {
+                const f32 adtX = (chunkX * Terrain::MAP_CHUNK_SIZE) + (x * pixelSize);
+                const f32 adtY = (chunkY * Terrain::MAP_CHUNK_SIZE) + (y * pixelSize);
+
+                u8* pixel = &pixels[((y * size) + x) * 4];
+                for (u32 channel = 0; channel < 4; channel++)
+                {
+                    f32 weight = MapGenerator::SampleHeight(channelDescs[channel], adtX, adtY) * 0.5f + 0.5f;
+                    pixel[channel] = static_cast<u8>(std::clamp(weight * 255.0f, 0.0f, 255.0f));
+                }
+            }
+        }
+
+        return WriteBMP(path, size, size, pixels);
+    }
+}
@@ -0,0 +1,44 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <vector>
+
+namespace Generators
+{
+    struct MapGeneratorDesc;
+
+    namespace TextureGenerator
+    {
+        // Placeholder textures are uncompressed 32 bit BMP files, TextureHandlerVK loads them through stb_image
+        bool WriteBMP(const std::filesystem::path& path, u32 width, u32 height, const std::vector<u8>& rgbaPixels);
+
+        // Tinted checkerboard, every texture index gets its own color so layers are distinguishable
+        bool WriteTexture(const std::filesystem::path& path, u32 seed, u32 textureIndex, u32 size);
+
+        // Every channel holds the blend weight of one cell layer, sampled from noise over the whole chunk
+        bool WriteAlphaMap(const std::filesystem::path& path, const MapGeneratorDesc& desc, u16 chunkX, u16 chunkY, u32 size);
+    }
+}
@@ -0,0 +1,124 @@
+#include <Utils/DebugHandler.h>
+#include <Utils/Timer.h>
+#include <string>
+
+#include <DataGen/DataGenerator.h>
+
+void PrintUsage()
+{
+    NC_LOG_MESSAGE("Usage: datagen-tool [options]");
+    NC_LOG_MESSAGE("  --output <path>           Directory to write Data/extracted into (default current directory)");
+    NC_LOG_MESSAGE("  --seed <value>            Seed for all generated data (default 1337)");
+    NC_LOG_MESSAGE("  --name <name>             Internal name of the generated map (default Generated)");
+    NC_LOG_MESSAGE("  --chunks <count>          Chunks per map side, up to 64 (default 8)");
+    NC_LOG_MESSAGE("  --height <yards>          Heightfield amplitude (default 150)");
+    NC_LOG_MESSAGE("  --frequency <value>       Heightfield noise features per yard (default 0.005)");
+    NC_LOG_MESSAGE("  --octaves <count>         Heightfield noise octaves (default 4)");
+    NC_LOG_MESSAGE("  --holes <chance>          Chance [0..1] for a cell to have holes (default 0)");
+    NC_LOG_MESSAGE("  --textures <count>        Number of placeholder textures (default 8)");
+    NC_LOG_MESSAGE("  --texture-size <pixels>   Size of placeholder textures (default 64)");
+    NC_LOG_MESSAGE("  --alpha-maps              Generate a terrain alpha map per chunk");
+    NC_LOG_MESSAGE("  --objects <count>         Number of distinct map objects (default 0)");
+    NC_LOG_MESSAGE("  --object-density <value>  Map object placements per chunk (default 0)");
+    NC_LOG_MESSAGE("  --object-detail <value>   Max quads per map object face edge (default 8)");
+    NC_LOG_MESSAGE("  --model-detail <value>    Quads per face edge of the cube model (default 8)");
+    NC_LOG_MESSAGE("  --no-model-optimize       Write model indices in export order instead of optimizing them");
+}
+
+i32 main(i32 argc, char* argv[])
+{
+    Generators::DataGeneratorDesc desc;
+    std::string outputDirectory = ".";
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--alpha-maps")
+        {
+            desc.map.alphaMaps = true;
+        }
+        else if (argument == "--no-model-optimize")
+        {
+            desc.model.optimize = false;
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            outputDirectory = argv[++i];
+        }
+        else if (argument == "--seed" && hasValue)
+        {
+            desc.map.seed = static_cast<u32>(std::stoul(argv[++i]));
+            desc.mapObject.seed = desc.map.seed;
+        }
+        else if (argument == "--name" && hasValue)
+        {
+            desc.map.name = argv[++i];
+        }
+        else if (argument == "--chunks" && hasValue)
+        {
+            desc.map.chunksPerSide = static_cast<u16>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--height" && hasValue)
+        {
+            desc.map.heightAmplitude = std::stof(argv[++i]);
+        }
+        else if (argument == "--frequency" && hasValue)
+        {
+            desc.map.noiseFrequency = std::stof(argv[++i]);
+        }
+        else if (argument == "--octaves" && hasValue)
+        {
+            desc.map.noiseOctaves = static_cast<u8>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--holes" && hasValue)
+        {
+            desc.map.holeDensity = std::stof(argv[++i]);
+        }
+        else if (argument == "--textures" && hasValue)
+        {
+            desc.map.textureCount = static_cast<u32>(std::stoul(argv[++i]));
+            desc.mapObject.textureCount = desc.map.textureCount;
+        }
+        else if (argument == "--texture-size" && hasValue)
+        {
+            desc.textureSize = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--objects" && hasValue)
+        {
+            desc.map.mapObjectCount = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--object-density" && hasValue)
+        {
+            desc.map.mapObjectsPerChunk = std::stof(argv[++i]);
+        }
+        else if (argument == "--object-detail" && hasValue)
+        {
+            desc.mapObject.maxSubdivisions = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--model-detail" && hasValue)
+        {
+            desc.model.subdivisions = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    Timer timer;
+
+    Generators::DataGeneratorStats stats;
+    if (!Generators::DataGenerator::Generate(desc, outputDirectory, stats))
+    {
+        NC_LOG_ERROR("Failed to generate data in %s", outputDirectory.c_str());
+        return 1;
+    }
+
+    timer.Tick();
+    NC_LOG_SUCCESS("Generated %u chunks, %u placements, %u map object roots, %u map objects, %u models and %u textures (%.2f MB) in %.2fs", stats.numChunks, stats.numMapObjectPlacements, stats.numMapObjectRoots, stats.numMapObjects, stats.numModels, stats.numTextures, stats.numBytes / (1024.0 * 1024.0), timer.GetLifeTime());
+
+    return 0;
+}
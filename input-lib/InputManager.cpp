@@ -1,186 +1,93 @@
 #include "InputManager.h"
 #include <Utils/StringUtils.h>
+#include <Utils/DebugHandler.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
 
-InputManager::InputManager() : _keyToKeybindMap(), _titleToKeybindMap(), _keyboardInputCallbackMap(), _charInputCallbackMap()
-{
-    // Mouse
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_1] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_2] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_3] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_4] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_5] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_6] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_7] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_MOUSE_BUTTON_8] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-
-    // Keyboard
-    _keyToKeybindMap[GLFW_KEY_SPACE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_APOSTROPHE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_COMMA] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_MINUS] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_PERIOD] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_SLASH] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_0] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_1] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_2] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_3] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_4] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_5] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_6] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_7] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_8] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_9] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_SEMICOLON] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_EQUAL] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_A] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_B] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_C] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_D] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_E] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_G] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_H] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_I] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_J] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_K] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_L] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_M] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_N] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_O] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_P] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_Q] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_R] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_S] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_T] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_U] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_V] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_W] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_X] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_Y] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_Z] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_LEFT_BRACKET] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_BACKSLASH] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_RIGHT_BRACKET] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_GRAVE_ACCENT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_WORLD_1] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_WORLD_2] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_ESCAPE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_ENTER] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_TAB] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_BACKSPACE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_INSERT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_DELETE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_RIGHT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_LEFT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_DOWN] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_UP] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_PAGE_UP] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_PAGE_DOWN] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_HOME] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_END] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_CAPS_LOCK] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_SCROLL_LOCK] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_NUM_LOCK] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_PRINT_SCREEN] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_PAUSE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F1] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F2] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F3] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F4] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F5] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F6] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F7] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F8] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F9] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F10] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F11] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F12] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F13] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F14] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F15] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F16] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F17] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F18] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F19] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F20] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F21] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F22] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F23] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F24] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_F25] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_0] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_1] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_2] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_3] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_4] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_5] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_6] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_7] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_8] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_9] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_DECIMAL] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_DIVIDE] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_MULTIPLY] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_SUBTRACT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_ADD] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_ENTER] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_KP_EQUAL] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_LEFT_SHIFT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_LEFT_CONTROL] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_LEFT_ALT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_LEFT_SUPER] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_RIGHT_SHIFT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_RIGHT_CONTROL] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_RIGHT_ALT] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_RIGHT_SUPER] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-    _keyToKeybindMap[GLFW_KEY_MENU] = robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>();
-
-    // Micro Optimization (Pre Allocate Memory for 8 InputBindings)
-    for (auto inputBinding : _keyToKeybindMap)
-    {
-        inputBinding.second.reserve(8);
-    }
+static_assert(GLFW_KEY_LAST < InputManager::MAX_KEYS && GLFW_MOUSE_BUTTON_LAST < InputManager::MAX_KEYS, "MAX_KEYS has to cover every GLFW key and mouse button");
 
+InputManager::InputManager() : _keybinds(), _freeKeybinds(), _pressedKeybinds(), _keyToKeybinds(), _titleToKeybindMap(), _keyboardInputCallbackMap(), _charInputCallbackMap()
+{
+    _keybinds.reserve(64);
     _titleToKeybindMap.reserve(64);
     _keyboardInputCallbackMap.reserve(8);
 }
 
-void InputManager::KeyboardInputHandler(Window* window, i32 key, i32 /*scanCode*/, i32 actionMask, i32 modifierMask)
+void InputManager::BeginFrame(Window* window)
 {
-    for (auto kv : _keyboardInputCallbackMap)
+    _recorder.NextFrame();
+
+    std::shared_ptr<InputReplay> replay = std::atomic_load(&_replay);
+    if (!replay)
+        return;
+
+    if (!replay->Update(*this, window))
+    {
+        // Only clear it if it wasn't replaced while we were dispatching
+        std::atomic_compare_exchange_strong(&_replay, &replay, std::shared_ptr<InputReplay>(nullptr));
+        NC_LOG_MESSAGE("Input replay finished after %u frames", replay->GetFrameCount());
+    }
+}
+
+void InputManager::KeyboardInputHandler(Window* window, i32 key, i32 scancode, i32 actionMask, i32 modifierMask)
+{
+    if (_recorder.IsOpen())
+    {
+        InputEvent event;
+        event.type = InputEventType::Key;
+        event.key = key;
+        event.scancode = scancode;
+        event.action = actionMask;
+        event.modifiers = modifierMask;
+        _recorder.Write(event);
+    }
+
+    for (auto& kv : _keyboardInputCallbackMap)
     {
         //If this returns true it consumed the input.
         if (kv.second(window, key, actionMask, modifierMask))
             return;
     }
 
-    for (auto kv : _keyToKeybindMap[key])
+    if (key < 0 || key >= MAX_KEYS)
+        return;
+
+    // Indexed rather than iterated, a callback may register keybinds on the same key
+    const std::vector<KeybindHandle>& keybinds = _keyToKeybinds[key];
+    for (size_t i = 0; i < keybinds.size(); i++)
     {
-        auto inputBinding = kv.second;
+        Keybind& inputBinding = _keybinds[static_cast<u32>(keybinds[i])];
 
         // We always want to update the state of the keybind on release as we cannot be certain that the keybind has bound release as an action
         if (actionMask == GLFW_RELEASE)
-            inputBinding->state = 0;
+            SetKeybindState(inputBinding, 0);
 
         // Validate ActionMask and then check Modifier Mask
-        bool validModifier = inputBinding->modifierMask == KEYBIND_MOD_ANY || inputBinding->modifierMask & modifierMask || inputBinding->modifierMask == 0 && modifierMask == 0;
-        if ((inputBinding->actionMask & (1 << actionMask)) && validModifier)
+        bool validModifier = inputBinding.modifierMask == KEYBIND_MOD_ANY || inputBinding.modifierMask & modifierMask || inputBinding.modifierMask == 0 && modifierMask == 0;
+        if ((inputBinding.actionMask & (1 << actionMask)) && validModifier)
         {
-            inputBinding->state = actionMask == GLFW_RELEASE ? 0 : 1;
+            SetKeybindState(inputBinding, actionMask == GLFW_RELEASE ? 0 : 1);
 
-            if (!inputBinding->callback)
+            if (!inputBinding.callback)
                 continue;
 
             //If this returns true it consumed the input.
-            if (inputBinding->callback(window, inputBinding))
+            if (inputBinding.callback(window, &inputBinding))
                 return;
         }
     }
 }
 void InputManager::CharInputHandler(Window* window, u32 unicodeKey)
 {
-    for (auto kv : _charInputCallbackMap)
+    if (_recorder.IsOpen())
+    {
+        InputEvent event;
+        event.type = InputEventType::Char;
+        event.key = static_cast<i32>(unicodeKey);
+        _recorder.Write(event);
+    }
+
+    for (auto& kv : _charInputCallbackMap)
     {
         //If this returns true it consumed the input.
         if (kv.second(window, unicodeKey))
@@ -189,71 +96,136 @@ void InputManager::CharInputHandler(Window* window, u32 unicodeKey)
 }
 void InputManager::MouseInputHandler(Window* window, i32 button, i32 actionMask, i32 modifierMask)
 {
+    if (_recorder.IsOpen())
+    {
+        InputEvent event;
+        event.type = InputEventType::MouseButton;
+        event.key = button;
+        event.action = actionMask;
+        event.modifiers = modifierMask;
+        _recorder.Write(event);
+    }
+
     _mouseState = actionMask == GLFW_RELEASE ? 0 : 1;
 
-    for (auto kv : _keyToKeybindMap[button])
+    if (button < 0 || button >= MAX_KEYS)
+        return;
+
+    const std::vector<KeybindHandle>& keybinds = _keyToKeybinds[button];
+    for (size_t i = 0; i < keybinds.size(); i++)
     {
-        auto inputBinding = kv.second;
+        Keybind& inputBinding = _keybinds[static_cast<u32>(keybinds[i])];
 
         // Validate ActionMask and then check Modifier Mask
-        bool validModifier = inputBinding->modifierMask == KEYBIND_MOD_ANY || inputBinding->modifierMask & modifierMask || inputBinding->modifierMask == 0 && modifierMask == 0;
-        if ((inputBinding->actionMask & (1 << actionMask)) && validModifier)
+        bool validModifier = inputBinding.modifierMask == KEYBIND_MOD_ANY || inputBinding.modifierMask & modifierMask || inputBinding.modifierMask == 0 && modifierMask == 0;
+        if ((inputBinding.actionMask & (1 << actionMask)) && validModifier)
         {
-            inputBinding->state = _mouseState;
+            SetKeybindState(inputBinding, _mouseState);
 
-            if (!inputBinding->callback)
+            if (!inputBinding.callback)
                 continue;
 
-            inputBinding->callback(window, inputBinding);
+            inputBinding.callback(window, &inputBinding);
         }
     }
 }
 void InputManager::MousePositionHandler(Window* window, f32 x, f32 y)
 {
+    if (_recorder.IsOpen())
+    {
+        InputEvent event;
+        event.type = InputEventType::MousePosition;
+        event.x = x;
+        event.y = y;
+        _recorder.Write(event);
+    }
+
     _mousePositionX = x;
     _mousePositionY = y;
 
-    for (auto kv : _mousePositionUpdateCallbacks)
+    for (auto& kv : _mousePositionUpdateCallbacks)
     {
         kv.second(window, x, y);
     }
 }
 void InputManager::MouseScrollHandler(Window* window, f32 x, f32 y)
 {
-    for (auto kv : _mouseScrollUpdateCallbacks)
+    if (_recorder.IsOpen())
+    {
+        InputEvent event;
+        event.type = InputEventType::MouseScroll;
+        event.x = x;
+        event.y = y;
+        _recorder.Write(event);
+    }
+
+    for (auto& kv : _mouseScrollUpdateCallbacks)
     {
         kv.second(window, x, y);
     }
 }
 
-bool InputManager::RegisterKeybind(std::string keybindTitle, i32 key, i32 actionMask, i32 modifierMask, std::function<KeybindCallbackFunc> callback)
+void InputManager::SetReplay(std::shared_ptr<InputReplay> replay)
+{
+    if (replay)
+    {
+        replay->Start();
+    }
+
+    std::atomic_store(&_replay, replay);
+}
+
+KeybindHandle InputManager::RegisterKeybind(std::string keybindTitle, i32 key, i32 actionMask, i32 modifierMask, std::function<KeybindCallbackFunc> callback)
 {
     u32 keybindTitleHash = StringUtils::fnv1a_32(keybindTitle.c_str(), keybindTitle.length());
 
-    for (auto kv : _keyToKeybindMap)
+    if (key < 0 || key >= MAX_KEYS)
+        return KeybindHandle::Invalid;
+
+    auto iterator = _titleToKeybindMap.find(keybindTitleHash);
+    if (iterator != _titleToKeybindMap.end())
+        return KeybindHandle::Invalid;
+
+    KeybindHandle handle;
+    if (!_freeKeybinds.empty())
+    {
+        handle = _freeKeybinds.back();
+        _freeKeybinds.pop_back();
+    }
+    else
     {
-        auto iterator = kv.second.find(keybindTitleHash);
-        if (iterator != kv.second.end())
-            return false;
+        handle = static_cast<KeybindHandle>(_keybinds.size());
+        _keybinds.emplace_back();
+        _pressedKeybinds.resize((_keybinds.size() + 63) / 64, 0);
     }
 
-    std::shared_ptr<Keybind> keybind = std::make_shared<Keybind>(keybindTitle, actionMask, key, modifierMask, callback);
-    _keyToKeybindMap[key][keybindTitleHash] = keybind;
-    _titleToKeybindMap[keybindTitleHash] = keybind;
+    Keybind& keybind = _keybinds[static_cast<u32>(handle)];
+    keybind = Keybind(keybindTitle, actionMask, key, modifierMask, callback);
+    keybind.handle = handle;
 
-    return true;
+    _keyToKeybinds[key].push_back(handle);
+    _titleToKeybindMap[keybindTitleHash] = handle;
+
+    return handle;
 }
 bool InputManager::UnregisterKeybind(std::string keybindTitle)
 {
     u32 keybindTitleHash = StringUtils::fnv1a_32(keybindTitle.c_str(), keybindTitle.length());
-
-    auto iterator = _titleToKeybindMap.find(keybindTitleHash);
-    if (iterator == _titleToKeybindMap.end())
+    return UnregisterKeybind(GetKeybindHandle(keybindTitleHash));
+}
+bool InputManager::UnregisterKeybind(KeybindHandle handle)
+{
+    Keybind* keybind = GetKeybind(handle);
+    if (!keybind)
         return false;
 
-    i32 key = _titleToKeybindMap[keybindTitleHash]->key;
-    _keyToKeybindMap[key].erase(keybindTitleHash);
-    _titleToKeybindMap.erase(keybindTitleHash);
+    std::vector<KeybindHandle>& keybinds = _keyToKeybinds[keybind->key];
+    keybinds.erase(std::find(keybinds.begin(), keybinds.end(), handle));
+    _titleToKeybindMap.erase(keybind->hashedName);
+
+    SetKeybindState(*keybind, 0);
+    *keybind = Keybind();
+    _freeKeybinds.push_back(handle);
     return true;
 }
 
@@ -341,16 +313,28 @@ bool InputManager::UnregisterMouseScrollCallback(std::string callbackName)
     return true;
 }
 
-bool InputManager::GetKeybind(std::string keybindTitle, std::shared_ptr<Keybind>& keybind)
+KeybindHandle InputManager::GetKeybindHandle(u32 keybindTitleHash) const
 {
-    u32 keybindTitleHash = StringUtils::fnv1a_32(keybindTitle.c_str(), keybindTitle.length());
-
     auto iterator = _titleToKeybindMap.find(keybindTitleHash);
     if (iterator == _titleToKeybindMap.end())
-        return false;
+        return KeybindHandle::Invalid;
 
-    keybind = _titleToKeybindMap[keybindTitleHash];
-    return true;
+    return iterator->second;
+}
+
+Keybind* InputManager::GetKeybind(KeybindHandle handle)
+{
+    const u32 index = static_cast<u32>(handle);
+    if (index >= _keybinds.size() || _keybinds[index].handle != handle)
+        return nullptr;
+
+    return &_keybinds[index];
+}
+
+Keybind* InputManager::GetKeybind(std::string keybindTitle)
+{
+    u32 keybindTitleHash = StringUtils::fnv1a_32(keybindTitle.c_str(), keybindTitle.length());
+    return GetKeybind(GetKeybindHandle(keybindTitleHash));
 }
 
 bool InputManager::IsKeyPressedInWindow(GLFWwindow* window, i32 key)
@@ -364,5 +348,21 @@ bool InputManager::IsKeyPressedByTitle(std::string keybindTitle)
 }
 bool InputManager::IsKeyPressed(u32 keybindTitleHash)
 {
-    return _titleToKeybindMap[keybindTitleHash]->state;
+    return IsKeyPressed(GetKeybindHandle(keybindTitleHash));
+}
+
+void InputManager::SetKeybindState(Keybind& keybind, i32 state)
+{
+    keybind.state = state;
+
+    const u32 index = static_cast<u32>(keybind.handle);
+    const u64 bit = u64(1) << (index % 64);
+    if (state)
+    {
+        _pressedKeybinds[index / 64] |= bit;
+    }
+    else
+    {
+        _pressedKeybinds[index / 64] &= ~bit;
+    }
 }
\ No newline at end of file
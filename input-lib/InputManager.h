@@ -1,8 +1,11 @@
 #pragma once
 #include <NovusTypes.h>
 #include <robin_hood.h>
+#include <array>
 #include <memory>
+#include <vector>
 #include "Keybind.h"
+#include "InputRecording.h"
 
 class Window;
 struct GLFWwindow;
@@ -15,15 +18,24 @@ typedef bool CharInputCallbackFunc(Window* window, u32 unicodeKey);
 class InputManager
 {
 public:
+    // Covers every GLFW key code up to GLFW_KEY_LAST as well as the mouse buttons, which GLFW numbers from 0
+    static constexpr i32 MAX_KEYS = 512;
+
     InputManager();
+
+    // Call once per frame before polling window events, this advances the recording frame and dispatches the events the replay has due
+    void BeginFrame(Window* window);
+
     void KeyboardInputHandler(Window* window, i32 key, i32 scancode, i32 actionMask, i32 modifierMask);
     void CharInputHandler(Window* window, u32 unicodeKey);
     void MouseInputHandler(Window* window, i32 button, i32 actionMask, i32 modifierMask);
     void MousePositionHandler(Window* window, f32 x, f32 y);
     void MouseScrollHandler(Window* window, f32 x, f32 y);
 
-    bool RegisterKeybind(std::string keybindTitle, i32 key, i32 actionMask, i32 modifierMask, std::function<KeybindCallbackFunc> callback = nullptr);
+    // Returns KeybindHandle::Invalid if a keybind with the same title exists, keep the handle around to query the keybind every frame
+    KeybindHandle RegisterKeybind(std::string keybindTitle, i32 key, i32 actionMask, i32 modifierMask, std::function<KeybindCallbackFunc> callback = nullptr);
     bool UnregisterKeybind(std::string keybindTitle);
+    bool UnregisterKeybind(KeybindHandle handle);
 
     bool RegisterKeyboardInputCallback(u32 callbackNameHash, std::function<KeyboardInputCallbackFunc> callback);
     bool UnregisterKeyboardInputCallback(u32 callbackNameHash);
@@ -37,18 +49,38 @@ public:
     bool RegisterMouseScrollCallback(std::string callbackName, std::function<MouseScrollUpdateFunc> callback);
     bool UnregisterMouseScrollCallback(std::string callbackName);
 
-    bool GetKeybind(std::string keybindTitle, std::shared_ptr<Keybind>& keybind);
+    KeybindHandle GetKeybindHandle(u32 keybindTitleHash) const;
+    Keybind* GetKeybind(KeybindHandle handle);
+    Keybind* GetKeybind(std::string keybindTitle);
+
     bool IsKeyPressedInWindow(GLFWwindow* window, i32 key);
     bool IsKeyPressedByTitle(std::string keybindTitle);
     bool IsKeyPressed(u32 keybindTitleHash);
+    bool IsKeyPressed(KeybindHandle handle) const
+    {
+        const u32 index = static_cast<u32>(handle);
+        return index < _keybinds.size() && (_pressedKeybinds[index / 64] >> (index % 64)) & 1;
+    }
 
     vec2 GetMousePosition() { return vec2(_mousePositionX, _mousePositionY); }
     f32 GetMousePositionX() { return _mousePositionX; }
     f32 GetMousePositionY() { return _mousePositionY; }
     bool IsMousePressed() { return _mouseState; }
+
+    InputRecorder& GetRecorder() { return _recorder; }
+    // Replaces the running replay, pass nullptr to stop it. Safe to call from another thread, the replay starts on the next BeginFrame
+    void SetReplay(std::shared_ptr<InputReplay> replay);
+    bool IsReplaying() const { return std::atomic_load(&_replay) != nullptr; }
+private:
+    void SetKeybindState(Keybind& keybind, i32 state);
+
 private:
-    robin_hood::unordered_map<i32, robin_hood::unordered_map<u32, std::shared_ptr<Keybind>>> _keyToKeybindMap;
-    robin_hood::unordered_map<u32, std::shared_ptr<Keybind>> _titleToKeybindMap;
+    // Keybinds are indexed by their handle, unregistered keybinds leave a hole that is reused by the next registration
+    std::vector<Keybind> _keybinds;
+    std::vector<KeybindHandle> _freeKeybinds;
+    std::vector<u64> _pressedKeybinds; // One bit per keybind, set while its state is pressed
+    std::array<std::vector<KeybindHandle>, MAX_KEYS> _keyToKeybinds;
+    robin_hood::unordered_map<u32, KeybindHandle> _titleToKeybindMap;
     robin_hood::unordered_map<u32, std::function<KeyboardInputCallbackFunc>> _keyboardInputCallbackMap;
     robin_hood::unordered_map<u32, std::function<CharInputCallbackFunc>> _charInputCallbackMap;
     robin_hood::unordered_map<u32, std::function<MousePositionUpdateFunc>> _mousePositionUpdateCallbacks;
@@ -56,4 +88,7 @@ private:
     f32 _mousePositionX = 0;
     f32 _mousePositionY = 0;
     bool _mouseState = false;
+
+    InputRecorder _recorder;
+    std::shared_ptr<InputReplay> _replay = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "InputRecording.h"
+#include "InputManager.h"
+#include <Utils/DebugHandler.h>
+
+bool InputRecorder::Open(const std::filesystem::path& path)
+{
+    std::lock_guard lock(_mutex);
+
+    if (_file.is_open())
+    {
+        _file.close();
+    }
+
+    _file.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!_file)
+    {
+        NC_LOG_ERROR("Failed to create input recording %s", path.string().c_str());
+        _isOpen = false;
+        return false;
+    }
+
+    InputRecordingHeader header;
+    _file.write(reinterpret_cast<const char*>(&header), sizeof(InputRecordingHeader));
+
+    _frame = 0;
+    _eventCount = 0;
+    _isOpen = true;
+    return true;
+}
+
+void InputRecorder::Close()
+{
+    std::lock_guard lock(_mutex);
+
+    _isOpen = false;
+    if (_file.is_open())
+    {
+        _file.close();
+    }
+}
+
+void InputRecorder::Write(InputEvent& event)
+{
+    if (!_isOpen)
+        return;
+
+    event.frame = _frame;
+
+    std::lock_guard lock(_mutex);
+    if (!_file.is_open())
+        return;
+
+    _file.write(reinterpret_cast<const char*>(&event), sizeof(InputEvent));
+    _eventCount++;
+}
+
+bool InputReplay::Load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary);
+    if (!file)
+    {
+        NC_LOG_ERROR("Failed to open input recording %s", path.string().c_str());
+        return false;
+    }
+
+    InputRecordingHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(InputRecordingHeader));
+
+    if (!file || header.magic != InputRecordingHeader::MAGIC)
+    {
+        NC_LOG_ERROR("%s is not an input recording", path.string().c_str());
+        return false;
+    }
+
+    if (header.version != InputRecordingHeader::VERSION)
+    {
+        NC_LOG_ERROR("Input recording %s has version %u, expected %u", path.string().c_str(), header.version, InputRecordingHeader::VERSION);
+        return false;
+    }
+
+    _events.clear();
+
+    InputEvent event;
+    while (file.read(reinterpret_cast<char*>(&event), sizeof(InputEvent)))
+    {
+        // Frames never decrease in a recording, anything else means the file is damaged
+        if (event.type >= InputEventType::Count || (!_events.empty() && event.frame < _events.back().frame))
+        {
+            NC_LOG_ERROR("Input recording %s is corrupt after %u events", path.string().c_str(), static_cast<u32>(_events.size()));
+            return false;
+        }
+
+        _events.push_back(event);
+    }
+
+    if (file.gcount() != 0)
+    {
+        NC_LOG_ERROR("Input recording %s is truncated after %u events", path.string().c_str(), static_cast<u32>(_events.size()));
+        return false;
+    }
+
+    Start();
+    return true;
+}
+
+bool InputReplay::Update(InputManager& inputManager, Window* window)
+{
+    for (; _nextEvent < _events.size() && _events[_nextEvent].frame <= _frame; _nextEvent++)
+    {
+        const InputEvent& event = _events[_nextEvent];
+
+        switch (event.type)
+        {
+            case InputEventType::Key:
+                inputManager.KeyboardInputHandler(window, event.key, event.scancode, event.action, event.modifiers);
+                break;
+            case InputEventType::Char:
+                inputManager.CharInputHandler(window, static_cast<u32>(event.key));
+                break;
+            case InputEventType::MouseButton:
+                inputManager.MouseInputHandler(window, event.key, event.action, event.modifiers);
+                break;
+            case InputEventType::MousePosition:
+                inputManager.MousePositionHandler(window, event.x, event.y);
+                break;
+            case InputEventType::MouseScroll:
+                inputManager.MouseScrollHandler(window, event.x, event.y);
+                break;
+            default:
+                break;
+        }
+    }
+
+    _frame++;
+    return _nextEvent < _events.size();
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <NovusTypes.h>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+class Window;
+class InputManager;
+
+enum class InputEventType : u8
+{
+    Key,
+    Char,
+    MouseButton,
+    MousePosition,
+    MouseScroll,
+    Count
+};
+
+// Recording files start with the header below, followed by one InputEvent per event in the order they reached the InputManager
+struct InputRecordingHeader
+{
+    static constexpr u32 MAGIC = 0x5249434E; // "NCIR"
+    static constexpr u32 VERSION = 1;
+
+    u32 magic = MAGIC;
+    u32 version = VERSION;
+};
+
+// Written to disk as is, the padding is zeroed so identical sessions produce identical files
+struct InputEvent
+{
+    u32 frame = 0; // Frames since the recording was opened, see InputManager::BeginFrame
+    InputEventType type = InputEventType::Key;
+    u8 padding[3] = { 0, 0, 0 };
+    i32 key = 0; // Key code, unicode codepoint or mouse button depending on type
+    i32 scancode = 0;
+    i32 action = 0;
+    i32 modifiers = 0;
+    f32 x = 0.0f; // Cursor position or scroll offset
+    f32 y = 0.0f;
+};
+static_assert(sizeof(InputEvent) == 32, "InputEvent is written to disk as is and can't change size without a new version");
+
+// Records every event that reaches the InputManager handlers, Open and Close are safe to call from the console thread
+class InputRecorder
+{
+public:
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    bool IsOpen() const { return _isOpen; }
+
+    // Stamps the event with the current frame
+    void Write(InputEvent& event);
+    void NextFrame() { _frame++; }
+
+    u32 GetFrame() const { return _frame; }
+    u64 GetEventCount() const { return _eventCount; }
+
+private:
+    std::atomic<bool> _isOpen = false;
+    std::mutex _mutex;
+    std::ofstream _file;
+    std::atomic<u32> _frame = 0;
+    u64 _eventCount = 0;
+};
+
+// Feeds a recording into the InputManager handlers frame by frame, without GLFW and independent of how long the frames take
+class InputReplay
+{
+public:
+    bool Load(const std::filesystem::path& path);
+    void Start() { _frame = 0; _nextEvent = 0; }
+
+    // Dispatches every event recorded in the current replay frame and advances it, returns false once every event was dispatched
+    bool Update(InputManager& inputManager, Window* window);
+
+    size_t GetEventCount() const { return _events.size(); }
+    u32 GetFrameCount() const { return _events.empty() ? 0 : _events.back().frame + 1; }
+
+private:
+    std::vector<InputEvent> _events;
+    u32 _frame = 0;
+    size_t _nextEvent = 0;
+};
@@ -2,7 +2,7 @@
 #include <NovusTypes.h>
 #include <functional>
 #include <Utils/StringUtils.h>
-#include <Memory>
+#include <string>
 
 enum KeybindAction
 {
@@ -25,9 +25,17 @@ enum KeybindModifier
     KEYBIND_MOD_ANY = KEYBIND_MOD_NONE | KEYBIND_MOD_SHIFT | KEYBIND_MOD_CONTROL | KEYBIND_MOD_ALT
 };
 
+// Index of a keybind in the InputManager, it stays valid until the keybind is unregistered after which it may be reused
+enum class KeybindHandle : u32
+{
+    Invalid = 0xFFFFFFFF
+};
+
 class Window;
 class Keybind;
-typedef bool KeybindCallbackFunc(Window*, std::shared_ptr<Keybind>);
+
+// The keybind is only valid for the duration of the callback, registering keybinds may move it
+typedef bool KeybindCallbackFunc(Window*, Keybind*);
 class Keybind
 {
 public:
@@ -35,6 +43,7 @@ public:
     Keybind(std::string inTitle, i32 inActionMask, i32 inKey, i32 inModifierMask, std::function<KeybindCallbackFunc> inCallback) : title(inTitle), hashedName(StringUtils::fnv1a_32(title.c_str(), title.length())), actionMask(inActionMask), key(inKey), modifierMask(inModifierMask), state(0), callback(inCallback) { }
 
 public:
+    KeybindHandle handle = KeybindHandle::Invalid;
     std::string title;
     u32 hashedName;
     i32 actionMask;
@@ -50,6 +50,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::Draw* actualData = static_cast<const Commands::Draw*>(data);
         renderer->Draw(commandList, actualData->vertexCount, actualData->instanceCount, actualData->vertexOffset, actualData->instanceOffset);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), drawCalls, 1);
     }
 
     void BackendDispatch::DrawBindless(Renderer * renderer, CommandListID commandList, const void* data)
@@ -57,6 +58,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::DrawBindless* actualData = static_cast<const Commands::DrawBindless*>(data);
         renderer->DrawBindless(commandList, actualData->numVertices, actualData->numInstances);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), drawCalls, 1);
     }
 
     void BackendDispatch::DrawIndexedBindless(Renderer* renderer, CommandListID commandList, const void* data)
@@ -64,6 +66,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::DrawIndexedBindless* actualData = static_cast<const Commands::DrawIndexedBindless*>(data);
         renderer->DrawIndexedBindless(commandList, actualData->modelID, actualData->numVertices, actualData->numInstances);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), drawCalls, 1);
     }
 
     void BackendDispatch::DrawIndexed(Renderer* renderer, CommandListID commandList, const void* data)
@@ -71,6 +74,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::DrawIndexed* actualData = static_cast<const Commands::DrawIndexed*>(data);
         renderer->DrawIndexed(commandList, actualData->indexCount, actualData->instanceCount, actualData->indexOffset, actualData->vertexOffset, actualData->instanceOffset);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), drawCalls, 1);
     }
 
     void BackendDispatch::DrawIndexedIndirect(Renderer* renderer, CommandListID commandList, const void* data)
@@ -78,6 +82,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::DrawIndexedIndirect* actualData = static_cast<const Commands::DrawIndexedIndirect*>(data);
         renderer->DrawIndexedIndirect(commandList, actualData->argumentBuffer, actualData->argumentBufferOffset, actualData->drawCount);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), drawCalls, actualData->drawCount);
     }
 
     void BackendDispatch::DrawIndexedIndirectCount(Renderer* renderer, CommandListID commandList, const void* data)
@@ -85,6 +90,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::DrawIndexedIndirectCount* actualData = static_cast<const Commands::DrawIndexedIndirectCount*>(data);
         renderer->DrawIndexedIndirectCount(commandList, actualData->argumentBuffer, actualData->argumentBufferOffset, actualData->drawCountBuffer, actualData->drawCountBufferOffset, actualData->maxDrawCount);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), drawCalls, 1);
     }
 
     void BackendDispatch::Dispatch(Renderer* renderer, CommandListID commandList, const void* data)
@@ -138,14 +144,17 @@ namespace Renderer
     {
         ZoneScopedC(tracy::Color::Red3);
         const Commands::BeginGraphicsPipeline* actualData = static_cast<const Commands::BeginGraphicsPipeline*>(data);
-        renderer->BeginPipeline(commandList, actualData->pipeline);
+        renderer->BeginPipeline(commandList, actualData->pipeline, actualData->beginRenderPass);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), pipelineBinds, 1);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), renderPasses, actualData->beginRenderPass ? 1 : 0);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), mergedRenderPasses, actualData->beginRenderPass ? 0 : 1);
     }
 
     void BackendDispatch::EndGraphicsPipeline(Renderer* renderer, CommandListID commandList, const void* data)
     {
         ZoneScopedC(tracy::Color::Red3);
         const Commands::EndGraphicsPipeline* actualData = static_cast<const Commands::EndGraphicsPipeline*>(data);
-        renderer->EndPipeline(commandList, actualData->pipeline);
+        renderer->EndPipeline(commandList, actualData->pipeline, actualData->endRenderPass);
     }
 
     void BackendDispatch::SetComputePipeline(Renderer* renderer, CommandListID commandList, const void* data)
@@ -153,6 +162,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::SetComputePipeline* actualData = static_cast<const Commands::SetComputePipeline*>(data);
         renderer->SetPipeline(commandList, actualData->pipeline);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), pipelineBinds, 1);
     }
 
     void BackendDispatch::BindDescriptorSet(Renderer* renderer, CommandListID commandList, const void* data)
@@ -160,6 +170,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::BindDescriptorSet* actualData = static_cast<const Commands::BindDescriptorSet*>(data);
         renderer->BindDescriptorSet(commandList, actualData->slot, actualData->descriptors, actualData->numDescriptors, actualData->frameIndex);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), descriptorWrites, actualData->numDescriptors);
     }
 
     void BackendDispatch::SetScissorRect(Renderer* renderer, CommandListID commandList, const void* data)
@@ -216,6 +227,7 @@ namespace Renderer
         ZoneScopedC(tracy::Color::Red3);
         const Commands::CopyBuffer* actualData = static_cast<const Commands::CopyBuffer*>(data);
         renderer->CopyBuffer(commandList, actualData->dstBuffer, actualData->dstBufferOffset, actualData->srcBuffer, actualData->srcBufferOffset, actualData->region);
+        NC_RENDER_STAT_ADD(renderer->GetFrameStats(), stagingBytes, actualData->region);
     }
 
     void BackendDispatch::PipelineBarrier(Renderer* renderer, CommandListID commandList, const void* data)
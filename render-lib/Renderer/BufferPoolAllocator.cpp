@@ -0,0 +1,131 @@
+#include "BufferPoolAllocator.h"
+#include <cassert>
+
+namespace Renderer
+{
+    u32 BufferPoolAllocator::GetSizeClass(u64 size)
+    {
+        assert(IsPoolable(size));
+
+        u32 sizeClass = 0;
+        while (GetSlotSize(sizeClass) < size)
+        {
+            sizeClass++;
+        }
+
+        return sizeClass;
+    }
+
+    bool BufferPoolAllocator::Allocate(u64 size, BufferPoolAllocation& outAllocation)
+    {
+        const u32 sizeClassIndex = GetSizeClass(size);
+        SizeClass& sizeClass = _sizeClasses[sizeClassIndex];
+
+        // Prefer the most recently added pages, the older ones are likely to be the fullest
+        for (size_t i = sizeClass.pages.size(); i > 0; i--)
+        {
+            Page& page = sizeClass.pages[i - 1];
+            if (page.freeSlots.empty())
+                continue; // Full or released
+
+            if (page.freeSlots.size() == GetSlotsPerPage(sizeClassIndex))
+                sizeClass.emptyPages--;
+
+            const u32 slot = page.freeSlots.back();
+            page.freeSlots.pop_back();
+
+            sizeClass.usedSlots++;
+            sizeClass.requestedBytes += size;
+
+            outAllocation.sizeClass = sizeClassIndex;
+            outAllocation.page = static_cast<u32>(i - 1);
+            outAllocation.slot = slot;
+            outAllocation.offset = slot * GetSlotSize(sizeClassIndex);
+            outAllocation.size = size;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool BufferPoolAllocator::Free(const BufferPoolAllocation& allocation)
+    {
+        SizeClass& sizeClass = _sizeClasses[allocation.sizeClass];
+        assert(allocation.page < sizeClass.pages.size());
+
+        const u32 slotsPerPage = GetSlotsPerPage(allocation.sizeClass);
+
+        Page& page = sizeClass.pages[allocation.page];
+        assert(page.freeSlots.size() < slotsPerPage); // Double free
+
+        page.freeSlots.push_back(allocation.slot);
+
+        sizeClass.usedSlots--;
+        sizeClass.requestedBytes -= allocation.size;
+
+        if (page.freeSlots.size() < slotsPerPage)
+            return false;
+
+        if (sizeClass.emptyPages < MAX_EMPTY_PAGES)
+        {
+            sizeClass.emptyPages++;
+            return false;
+        }
+
+        page.freeSlots.clear();
+        sizeClass.releasedPages.push_back(allocation.page);
+        return true;
+    }
+
+    u32 BufferPoolAllocator::AddPage(u32 sizeClassIndex)
+    {
+        SizeClass& sizeClass = _sizeClasses[sizeClassIndex];
+        const u32 slotsPerPage = GetSlotsPerPage(sizeClassIndex);
+
+        u32 pageIndex = static_cast<u32>(sizeClass.pages.size());
+        if (!sizeClass.releasedPages.empty())
+        {
+            pageIndex = sizeClass.releasedPages.back();
+            sizeClass.releasedPages.pop_back();
+        }
+        else
+        {
+            sizeClass.pages.emplace_back();
+        }
+
+        Page& page = sizeClass.pages[pageIndex];
+        page.freeSlots.reserve(slotsPerPage);
+
+        // Push in reverse so slots get handed out front to back
+        for (u32 i = slotsPerPage; i > 0; i--)
+        {
+            page.freeSlots.push_back(i - 1);
+        }
+
+        sizeClass.emptyPages++;
+        return pageIndex;
+    }
+
+    BufferPoolStats BufferPoolAllocator::GetStats() const
+    {
+        BufferPoolStats stats;
+
+        for (u32 i = 0; i < NUM_SIZE_CLASSES; i++)
+        {
+            const SizeClass& sizeClass = _sizeClasses[i];
+            BufferPoolClassStats& classStats = stats.sizeClasses[i];
+
+            classStats.slotSize = GetSlotSize(i);
+            classStats.pages = GetPageCount(i);
+            classStats.usedSlots = sizeClass.usedSlots;
+            classStats.totalSlots = classStats.pages * GetSlotsPerPage(i);
+            classStats.requestedBytes = sizeClass.requestedBytes;
+
+            stats.reservedBytes += classStats.pages * PAGE_SIZE;
+            stats.usedBytes += classStats.usedSlots * classStats.slotSize;
+            stats.requestedBytes += classStats.requestedBytes;
+        }
+
+        return stats;
+    }
+}
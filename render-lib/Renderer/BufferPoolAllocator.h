@@ -0,0 +1,84 @@
+#pragma once
+#include <NovusTypes.h>
+#include <array>
+#include <vector>
+
+namespace Renderer
+{
+    struct BufferPoolAllocation
+    {
+        u32 sizeClass = 0;
+        u32 page = 0;
+        u32 slot = 0;
+        u64 offset = 0; // Offset into the page
+        u64 size = 0; // Size that was requested, the slot itself is GetSlotSize(sizeClass) bytes
+    };
+
+    struct BufferPoolClassStats
+    {
+        u64 slotSize = 0;
+        u32 pages = 0;
+        u32 usedSlots = 0;
+        u32 totalSlots = 0;
+        u64 requestedBytes = 0;
+    };
+
+    struct BufferPoolStats
+    {
+        static constexpr u32 NUM_SIZE_CLASSES = 9;
+        std::array<BufferPoolClassStats, NUM_SIZE_CLASSES> sizeClasses;
+
+        u64 reservedBytes = 0; // Bytes in all pages
+        u64 usedBytes = 0; // Bytes in occupied slots
+        u64 requestedBytes = 0; // Bytes callers asked for, the difference to usedBytes is lost to rounding up to the slot size
+
+        f32 GetOccupancy() const { return reservedBytes > 0 ? static_cast<f32>(usedBytes) / static_cast<f32>(reservedBytes) : 0.0f; }
+        f32 GetInternalFragmentation() const { return usedBytes > 0 ? 1.0f - static_cast<f32>(requestedBytes) / static_cast<f32>(usedBytes) : 0.0f; }
+    };
+
+    // Bookkeeping for sub-allocating small buffers out of larger pages, it knows nothing about the GPU so the policy can be reasoned about (and tested) on its own
+    // Sizes are rounded up to a power of two size class between MIN_SLOT_SIZE and MAX_SLOT_SIZE, every page holds PAGE_SIZE bytes worth of slots of a single class
+    class BufferPoolAllocator
+    {
+    public:
+        static constexpr u32 NUM_SIZE_CLASSES = BufferPoolStats::NUM_SIZE_CLASSES;
+        static constexpr u64 MIN_SLOT_SIZE = 256; // Matches the largest minUniformBufferOffsetAlignment and minStorageBufferOffsetAlignment we have seen, so every slot is aligned for both
+        static constexpr u64 MAX_SLOT_SIZE = MIN_SLOT_SIZE << (NUM_SIZE_CLASSES - 1); // 64 KB
+        static constexpr u64 PAGE_SIZE = 1024 * 1024; // 1 MB
+        static constexpr u32 MAX_EMPTY_PAGES = 1; // Empty pages kept per size class so buffers that get recreated every frame don't go back to VMA each time
+
+        static bool IsPoolable(u64 size) { return size > 0 && size <= MAX_SLOT_SIZE; }
+        static u32 GetSizeClass(u64 size);
+        static u64 GetSlotSize(u32 sizeClass) { return MIN_SLOT_SIZE << sizeClass; }
+        static u32 GetSlotsPerPage(u32 sizeClass) { return static_cast<u32>(PAGE_SIZE / GetSlotSize(sizeClass)); }
+
+        // Returns false when every page of the size class is full, call AddPage and try again
+        bool Allocate(u64 size, BufferPoolAllocation& outAllocation);
+
+        // Returns true when the page became empty past MAX_EMPTY_PAGES and got released, the caller has to free the memory behind it
+        bool Free(const BufferPoolAllocation& allocation);
+
+        // Returns the index of the new page within its size class, indices of released pages are handed out again before new ones
+        u32 AddPage(u32 sizeClass);
+        u32 GetPageCount(u32 sizeClass) const { return static_cast<u32>(_sizeClasses[sizeClass].pages.size() - _sizeClasses[sizeClass].releasedPages.size()); }
+
+        BufferPoolStats GetStats() const;
+
+    private:
+        struct Page
+        {
+            std::vector<u32> freeSlots;
+        };
+
+        struct SizeClass
+        {
+            std::vector<Page> pages;
+            std::vector<u32> releasedPages; // Released pages keep their index so allocations in the other pages stay valid
+            u32 emptyPages = 0;
+            u32 usedSlots = 0;
+            u64 requestedBytes = 0;
+        };
+
+        std::array<SizeClass, NUM_SIZE_CLASSES> _sizeClasses;
+    };
+}
@@ -65,23 +65,31 @@ namespace Renderer
 
     void CommandList::MarkFrameStart(u32 frameIndex)
     {
+        _renderPassMerger.Break();
+
         Commands::MarkFrameStart* command = AddCommand<Commands::MarkFrameStart>();
         command->frameIndex = frameIndex;
     }
 
     void CommandList::BeginTrace(const tracy::SourceLocationData* sourceLocation)
     {
+        _renderPassMerger.Break();
+
         Commands::BeginTrace* command = AddCommand<Commands::BeginTrace>();
         command->sourceLocation = sourceLocation;
     }
 
     void CommandList::EndTrace()
     {
+        _renderPassMerger.Break();
+
         AddCommand<Commands::EndTrace>();
     }
 
     void CommandList::PushMarker(std::string marker, Color color)
     {
+        _renderPassMerger.Break();
+
         Commands::PushMarker* command = AddCommand<Commands::PushMarker>();
         assert(marker.length() < 16); // Max length of marker names is enforced to 15 chars since we have to store the string internally
         strcpy_s(command->marker, marker.c_str());
@@ -92,6 +100,8 @@ namespace Renderer
 
     void CommandList::PopMarker()
     {
+        _renderPassMerger.Break();
+
         AddCommand<Commands::PopMarker>();
 
         assert(_markerScope > 0); // We tried to pop a marker we never pushed
@@ -100,18 +110,32 @@ namespace Renderer
 
     void CommandList::BeginPipeline(GraphicsPipelineID pipelineID)
     {
+        u32 renderPassKey = _renderer != nullptr ? _renderer->GetRenderPassKey(pipelineID) : RenderPassMerger::NO_RENDER_PASS;
+        bool continuesRenderPass = _renderPassMerger.BeginPipeline(renderPassKey);
+
+        if (continuesRenderPass)
+        {
+            _endedPipeline->endRenderPass = false;
+        }
+
         Commands::BeginGraphicsPipeline* command = AddCommand<Commands::BeginGraphicsPipeline>();
         command->pipeline = pipelineID;
+        command->beginRenderPass = !continuesRenderPass;
     }
 
     void CommandList::EndPipeline(GraphicsPipelineID pipelineID)
     {
         Commands::EndGraphicsPipeline* command = AddCommand<Commands::EndGraphicsPipeline>();
         command->pipeline = pipelineID;
+
+        _renderPassMerger.EndPipeline();
+        _endedPipeline = command;
     }
 
     void CommandList::BindPipeline(ComputePipelineID pipelineID)
     {
+        _renderPassMerger.Break();
+
         Commands::SetComputePipeline* command = AddCommand<Commands::SetComputePipeline>();
         command->pipeline = pipelineID;
     }
@@ -175,6 +199,8 @@ namespace Renderer
 
     void CommandList::Clear(ImageID imageID, Color color)
     {
+        _renderPassMerger.Break();
+
         Commands::ClearImage* command = AddCommand<Commands::ClearImage>();                                                                                                       
         command->image = imageID;
         command->color = color;
@@ -182,6 +208,8 @@ namespace Renderer
 
     void CommandList::Clear(DepthImageID imageID, f32 depth, DepthClearFlags flags, u8 stencil)
     {
+        _renderPassMerger.Break();
+
         Commands::ClearDepthImage* command = AddCommand<Commands::ClearDepthImage>();                                                                                                      
         command->image = imageID;
         command->depth = depth;
@@ -251,6 +279,8 @@ namespace Renderer
 
     void CommandList::Dispatch(u32 numThreadGroupsX, u32 numThreadGroupsY, u32 numThreadGroupsZ)
     {
+        _renderPassMerger.Break();
+
         assert(numThreadGroupsX > 0);
         assert(numThreadGroupsY > 0);
         assert(numThreadGroupsZ > 0);
@@ -262,6 +292,8 @@ namespace Renderer
 
     void CommandList::DispatchIndirect(BufferID argumentBuffer, u32 argumentBufferOffset)
     {
+        _renderPassMerger.Break();
+
         assert(argumentBuffer != BufferID::Invalid());
         Commands::DispatchIndirect* command = AddCommand<Commands::DispatchIndirect>();
         command->argumentBuffer = argumentBuffer;
@@ -282,6 +314,8 @@ namespace Renderer
 
     void CommandList::CopyBuffer(BufferID dstBuffer, u64 dstBufferOffset, BufferID srcBuffer, u64 srcBufferOffset, u64 region)
     {
+        _renderPassMerger.Break();
+
         assert(dstBuffer != BufferID::Invalid());
         assert(srcBuffer != BufferID::Invalid());
         Commands::CopyBuffer* command = AddCommand<Commands::CopyBuffer>();
@@ -294,6 +328,8 @@ namespace Renderer
 
     void CommandList::PipelineBarrier(PipelineBarrierType type, BufferID buffer)
     {
+        _renderPassMerger.Break();
+
         assert(buffer != BufferID::Invalid());
         Commands::PipelineBarrier* command = AddCommand<Commands::PipelineBarrier>();
         command->barrierType = type;
@@ -303,6 +339,8 @@ namespace Renderer
 
     void CommandList::DrawImgui()
     {
+        _renderPassMerger.Break();
+
         Commands::DrawImgui* command = AddCommand<Commands::DrawImgui>();
     }    
     
@@ -314,4 +352,4 @@ namespace Renderer
         command->offset = offset;
         command->size = size;
     }
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <tracy/Tracy.hpp>
 #include <tracy/TracyVulkan.hpp>
 #include <Renderer/DescriptorSet.h>
+#include "RenderPassMerger.h"
 
 #include "Descriptors/BufferDesc.h"
 #include "Descriptors/ModelDesc.h"
@@ -33,6 +34,11 @@ namespace Renderer
     class DescriptorSet;
     class CommandList;
 
+    namespace Commands
+    {
+        struct EndGraphicsPipeline;
+    }
+
     struct ScopedGPUProfilerZone
     {
         ScopedGPUProfilerZone(CommandList& commandList, const tracy::SourceLocationData* sourceLocation);
@@ -144,6 +150,10 @@ namespace Renderer
 
         bool _isTracing = false;
 
+        // Consecutive pipelines rendering into the same framebuffer share one render pass
+        RenderPassMerger _renderPassMerger;
+        Commands::EndGraphicsPipeline* _endedPipeline = nullptr;
+
         friend class RenderGraph;
     };
 
@@ -12,6 +12,7 @@ namespace Renderer
             static const BackendDispatchFunction DISPATCH_FUNCTION;
 
             GraphicsPipelineID pipeline = GraphicsPipelineID::Invalid();
+            bool beginRenderPass = true; // False if the pipeline is bound inside the render pass of the previous pipeline
         };
 
         struct EndGraphicsPipeline
@@ -19,6 +20,7 @@ namespace Renderer
             static const BackendDispatchFunction DISPATCH_FUNCTION;
 
             GraphicsPipelineID pipeline = GraphicsPipelineID::Invalid();
+            bool endRenderPass = true; // False if the next pipeline continues the render pass
         };
         
         struct SetComputePipeline
@@ -12,6 +12,23 @@ namespace Renderer
         vec2 texCoord;
     };
 
+    // Follows the NovusTypeHeader of a .novusmodel, the vertex and index blocks are stored as-is at 8 byte aligned offsets so they can be copied out in one go
+    struct ModelFileHeader
+    {
+        static constexpr u32 TYPE_ID = 42;
+        static constexpr u32 VERSION = 3; // Bump this when the layout changes, the datagen converter writes it and ModelHandlerVK expects it
+
+        u32 vertexCount = 0;
+        u32 indexCount = 0;
+        i32 indexType = 3;
+        u32 vertexStride = sizeof(Vertex);
+
+        // From the start of the file
+        u64 vertexOffset = 0;
+        u64 indexOffset = 0;
+    };
+    static_assert(sizeof(ModelFileHeader) % 8 == 0, "ModelFileHeader has to keep the blocks after it 8 byte aligned");
+
     struct ModelDesc
     {
         std::string path;
@@ -0,0 +1,12 @@
+#pragma once
+#include <NovusTypes.h>
+
+namespace Renderer
+{
+    struct ShaderCacheDesc
+    {
+        std::string sourceDirectory; // The HLSL sources, shaders are only loaded from the cache if this is set
+        std::string cacheDirectory; // Where recompiled shaders are kept between runs
+        std::string compilerPath; // The standalone shader cooker, without it changed shaders can't be recompiled at runtime
+    };
+}
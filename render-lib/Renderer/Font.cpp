@@ -77,8 +77,31 @@ namespace Renderer
         return _fonts[hash];
     }
 
+    Font* Font::CreateMetricsOnly(f32 fontSize, const std::vector<f32>& advances)
+    {
+        assert(!advances.empty());
+
+        Font* font = new Font();
+        font->desc.size = fontSize;
+
+        for (int i = 32; i < 127; i++)
+        {
+            FontChar fontChar;
+            fontChar.advance = advances[(i - 32) % advances.size()];
+            fontChar.data = nullptr;
+
+            font->_chars[i] = fontChar;
+        }
+
+        return font;
+    }
+
     bool Font::InitChar(char character, FontChar& fontChar)
     {
+        // Metrics only fonts can't create new glyphs
+        if (_renderer == nullptr)
+            return false;
+
         fontChar.data = stbtt_GetCodepointSDF(fontInfo, scale, character, desc.padding, 128, 64.0f, &fontChar.width, &fontChar.height, &fontChar.xOffset, &fontChar.yOffset);
 
         if (fontChar.width == 0 && fontChar.height == 0)
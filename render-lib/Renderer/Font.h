@@ -1,6 +1,7 @@
 #pragma once
 #include <NovusTypes.h>
 #include <robin_hood.h>
+#include <vector>
 #include "Descriptors/TextureArrayDesc.h"
 #include "Descriptors/FontDesc.h"
 
@@ -26,13 +27,16 @@ namespace Renderer
     {
         FontDesc desc;
 
-        stbtt_fontinfo* fontInfo;
-        float scale;
+        stbtt_fontinfo* fontInfo = nullptr;
+        float scale = 1.0f;
 
         FontChar& GetChar(char character);
         TextureArrayID GetTextureArray();
 
         static Font* GetFont(Renderer* renderer, const std::string& fontPath, f32 fontSize);
+
+        // Creates a font that only has advances for char 32 to 126 and no glyph textures, for laying out text without a renderer
+        static Font* CreateMetricsOnly(f32 fontSize, const std::vector<f32>& advances);
         
     private:
         Font() = default;
@@ -45,7 +49,7 @@ namespace Renderer
 
         TextureArrayID _textureArray = TextureArrayID::Invalid();
 
-        Renderer* _renderer;
+        Renderer* _renderer = nullptr;
 
         friend class Renderer;
     };
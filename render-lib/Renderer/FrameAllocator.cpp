@@ -0,0 +1,182 @@
+#include "FrameAllocator.h"
+#include <Utils/DebugHandler.h>
+#include <Utils/StringUtils.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+
+namespace Renderer
+{
+    FrameAllocator::FrameAllocator(const size_t totalSize)
+        : Memory::Allocator(totalSize)
+    {
+        _stats.capacity = totalSize;
+    }
+
+    FrameAllocator::~FrameAllocator()
+    {
+        FreeBlocks();
+    }
+
+    void FrameAllocator::Init()
+    {
+        FreeBlocks();
+
+        Block& mainBlock = _blocks.emplace_back();
+        mainBlock.memory = static_cast<u8*>(malloc(_stats.capacity));
+        mainBlock.capacity = _stats.capacity;
+
+        if (mainBlock.memory == nullptr)
+        {
+            NC_LOG_FATAL("FrameAllocator failed to allocate its %llu byte arena", static_cast<u64>(_stats.capacity));
+        }
+
+        _currentBlock = 0;
+        _stats.allocatedBytes = 0;
+        _stats.overflowBytes = 0;
+        _stats.overflowBlocks = 0;
+    }
+
+    void* FrameAllocator::Allocate(const size_t size, const size_t alignment)
+    {
+        assert(!_blocks.empty()); // You need to call Init before allocating
+
+        const size_t actualAlignment = alignment == 0 ? alignof(std::max_align_t) : alignment;
+
+        size_t consumed = 0;
+        void* ptr = AllocateFromBlock(_blocks[_currentBlock], size, actualAlignment, consumed);
+
+        // Move on to the next overflow block, reusing blocks from earlier frames before creating new ones
+        while (ptr == nullptr)
+        {
+            _currentBlock++;
+
+            if (_currentBlock == _blocks.size())
+            {
+                Block& overflowBlock = _blocks.emplace_back();
+                overflowBlock.capacity = std::max(_stats.capacity / 4, size + actualAlignment);
+                overflowBlock.memory = static_cast<u8*>(malloc(overflowBlock.capacity));
+
+                if (overflowBlock.memory == nullptr)
+                {
+                    NC_LOG_FATAL("FrameAllocator failed to allocate a %llu byte overflow block", static_cast<u64>(overflowBlock.capacity));
+                    return nullptr;
+                }
+            }
+
+            Block& block = _blocks[_currentBlock];
+            block.offset = 0;
+
+            ptr = AllocateFromBlock(block, size, actualAlignment, consumed);
+        }
+
+        _stats.allocatedBytes += consumed;
+        if (_currentBlock > 0)
+        {
+            _stats.overflowBytes += consumed;
+            _stats.overflowBlocks = static_cast<u32>(_currentBlock);
+        }
+
+        if (_currentScope >= 0)
+        {
+            _scopeUsage[_currentScope].bytes += consumed;
+        }
+
+        return ptr;
+    }
+
+    void FrameAllocator::Free(void* /*ptr*/)
+    {
+        // Individual allocations are never freed, everything is released by Reset
+    }
+
+    void FrameAllocator::Reset()
+    {
+        _stats.frames++;
+        _stats.lastFrameHighWatermark = _stats.allocatedBytes;
+        _stats.lastFrameOverflowBytes = _stats.overflowBytes;
+        _stats.allTimeHighWatermark = std::max(_stats.allTimeHighWatermark, _stats.allocatedBytes);
+
+        if (_stats.overflowBytes > 0)
+        {
+            _stats.framesOverflowed++;
+
+            // Only report when the overflow grows, a frame that keeps overflowing by the same amount would flood the log otherwise
+            if (_stats.overflowBytes > _stats.allTimeOverflowBytes)
+            {
+                _stats.allTimeOverflowBytes = _stats.overflowBytes;
+                NC_LOG_WARNING("FrameAllocator overflowed its %llu byte arena by %llu bytes in %u overflow blocks, consider making it bigger", static_cast<u64>(_stats.capacity), static_cast<u64>(_stats.overflowBytes), _stats.overflowBlocks);
+            }
+        }
+
+        for (Block& block : _blocks)
+        {
+            block.offset = 0;
+        }
+
+        _currentBlock = 0;
+        _stats.allocatedBytes = 0;
+        _stats.overflowBytes = 0;
+        _stats.overflowBlocks = 0;
+
+        _lastFrameScopeUsage.swap(_scopeUsage);
+        _scopeUsage.clear();
+        _currentScope = -1;
+    }
+
+    void FrameAllocator::BeginScope(const char* name, u8 nameLength)
+    {
+        assert(_currentScope == -1); // Scopes don't nest
+        assert(nameLength < 16);
+
+        u32 nameHash = StringUtils::fnv1a_32(name, nameLength);
+
+        for (size_t i = 0; i < _scopeUsage.size(); i++)
+        {
+            if (_scopeUsage[i].nameHash == nameHash)
+            {
+                _currentScope = static_cast<i32>(i);
+                return;
+            }
+        }
+
+        FrameAllocatorScopeUsage& usage = _scopeUsage.emplace_back();
+        memcpy(usage.name, name, nameLength);
+        usage.name[nameLength] = '\0';
+        usage.nameHash = nameHash;
+
+        _currentScope = static_cast<i32>(_scopeUsage.size() - 1);
+    }
+
+    void FrameAllocator::EndScope()
+    {
+        _currentScope = -1;
+    }
+
+    void* FrameAllocator::AllocateFromBlock(Block& block, const size_t size, const size_t alignment, size_t& outConsumed)
+    {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block.memory) + block.offset;
+        const size_t padding = (alignment - (address % alignment)) % alignment;
+
+        if (block.offset + padding + size > block.capacity)
+            return nullptr;
+
+        void* ptr = block.memory + block.offset + padding;
+        block.offset += padding + size;
+        outConsumed = padding + size;
+
+        return ptr;
+    }
+
+    void FrameAllocator::FreeBlocks()
+    {
+        for (Block& block : _blocks)
+        {
+            free(block.memory);
+        }
+
+        _blocks.clear();
+    }
+}
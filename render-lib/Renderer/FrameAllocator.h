@@ -0,0 +1,77 @@
+#pragma once
+#include <NovusTypes.h>
+#include <Memory/Allocator.h>
+#include <vector>
+
+namespace Renderer
+{
+    struct FrameAllocatorScopeUsage
+    {
+        char name[16];
+        u32 nameHash = 0;
+        size_t bytes = 0;
+    };
+
+    struct FrameAllocatorStats
+    {
+        size_t capacity = 0; // Size of the main arena
+        size_t allocatedBytes = 0; // Allocated so far this frame including alignment padding and overflow
+        size_t overflowBytes = 0; // The part of allocatedBytes that did not fit in the main arena
+        u32 overflowBlocks = 0; // Overflow blocks currently chained behind the main arena
+
+        size_t lastFrameHighWatermark = 0;
+        size_t lastFrameOverflowBytes = 0;
+        size_t allTimeHighWatermark = 0;
+        size_t allTimeOverflowBytes = 0; // Largest overflow any single frame has needed
+
+        u64 frames = 0; // Number of times Reset has been called
+        u64 framesOverflowed = 0;
+    };
+
+    // Linear allocator for data that only needs to live for a single frame, nothing is freed individually and Reset releases everything at once
+    // When the main arena runs out it chains into overflow blocks instead of failing, Reset reports the overflow and keeps the blocks around for the next frame
+    class FrameAllocator : public Memory::Allocator
+    {
+    public:
+        FrameAllocator(const size_t totalSize);
+        ~FrameAllocator();
+
+        void Init() override;
+        void* Allocate(const size_t size, const size_t alignment = 0) override;
+        void Free(void* ptr) override;
+
+        void Reset();
+
+        // Allocations made between BeginScope and EndScope are attributed to that name in the per-scope usage, scopes don't nest
+        void BeginScope(const char* name, u8 nameLength);
+        void EndScope();
+
+        size_t GetAllocatedBytes() const { return _stats.allocatedBytes; }
+        size_t GetCapacity() const { return _stats.capacity; }
+
+        const FrameAllocatorStats& GetStats() const { return _stats; }
+        const std::vector<FrameAllocatorScopeUsage>& GetScopeUsage() const { return _scopeUsage; }
+        const std::vector<FrameAllocatorScopeUsage>& GetLastFrameScopeUsage() const { return _lastFrameScopeUsage; }
+
+    private:
+        struct Block
+        {
+            u8* memory = nullptr;
+            size_t capacity = 0;
+            size_t offset = 0;
+        };
+
+        void* AllocateFromBlock(Block& block, const size_t size, const size_t alignment, size_t& outConsumed);
+        void FreeBlocks();
+
+    private:
+        std::vector<Block> _blocks; // _blocks[0] is the main arena, the rest are overflow blocks
+        size_t _currentBlock = 0;
+
+        FrameAllocatorStats _stats;
+
+        std::vector<FrameAllocatorScopeUsage> _scopeUsage;
+        std::vector<FrameAllocatorScopeUsage> _lastFrameScopeUsage;
+        i32 _currentScope = -1;
+    };
+}
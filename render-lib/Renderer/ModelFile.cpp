@@ -0,0 +1,77 @@
+#include "ModelFile.h"
+#include <NovusTypeHeader.h>
+#include <Utils/DebugHandler.h>
+
+namespace Renderer::ModelFile
+{
+    namespace
+    {
+        constexpr u64 BLOCKS_START = sizeof(NovusTypeHeader) + sizeof(ModelFileHeader);
+
+        // Written so that nothing can wrap, the offsets come straight from the file
+        bool IsBlockInFile(u64 offset, u64 bytes, u64 fileSize)
+        {
+            return offset >= BLOCKS_START && offset <= fileSize && bytes <= fileSize - offset;
+        }
+    }
+
+    bool Read(Bytebuffer& buffer, const std::string& name, std::vector<Vertex>& vertices, std::vector<u32>& indices, i32& indexType)
+    {
+        const NovusTypeHeader expectedTypeHeader = NovusTypeHeader(ModelFileHeader::TYPE_ID, ModelFileHeader::VERSION);
+
+        NovusTypeHeader typeHeader;
+        if (!buffer.Get<NovusTypeHeader>(typeHeader))
+        {
+            NC_LOG_ERROR("Model file %s did not have a valid NovusTypeHeader", name.c_str());
+            return false;
+        }
+
+        if (typeHeader.typeID != expectedTypeHeader.typeID)
+        {
+            NC_LOG_ERROR("Model file %s had an invalid TypeID in its NovusTypeHeader, %u != %u", name.c_str(), typeHeader.typeID, expectedTypeHeader.typeID);
+            return false;
+        }
+
+        if (typeHeader.typeVersion != expectedTypeHeader.typeVersion)
+        {
+            NC_LOG_ERROR("Model file %s had an invalid TypeVersion in its NovusTypeHeader, %u != %u, rerun the converter", name.c_str(), typeHeader.typeVersion, expectedTypeHeader.typeVersion);
+            return false;
+        }
+
+        ModelFileHeader header;
+        if (!buffer.Get<ModelFileHeader>(header))
+        {
+            NC_LOG_ERROR("Model file %s did not have a valid ModelFileHeader", name.c_str());
+            return false;
+        }
+
+        if (header.vertexStride != sizeof(Vertex))
+        {
+            NC_LOG_ERROR("Model file %s has a vertex stride of %u instead of the expected %u", name.c_str(), header.vertexStride, static_cast<u32>(sizeof(Vertex)));
+            return false;
+        }
+
+        const u64 vertexBytes = static_cast<u64>(header.vertexCount) * sizeof(Vertex);
+        const u64 indexBytes = static_cast<u64>(header.indexCount) * sizeof(u32);
+
+        const u64 fileSize = static_cast<u64>(buffer.size);
+        if (!IsBlockInFile(header.vertexOffset, vertexBytes, fileSize) || !IsBlockInFile(header.indexOffset, indexBytes, fileSize))
+        {
+            NC_LOG_ERROR("Model file %s is truncated or corrupt, its blocks don't fit between the headers and the end of its %llu bytes", name.c_str(), static_cast<unsigned long long>(fileSize));
+            return false;
+        }
+
+        indexType = header.indexType;
+
+        // Both blocks are stored exactly like they are uploaded, so each is a single copy
+        vertices.resize(header.vertexCount);
+        buffer.readData = header.vertexOffset;
+        buffer.GetBytes(reinterpret_cast<u8*>(vertices.data()), vertexBytes);
+
+        indices.resize(header.indexCount);
+        buffer.readData = header.indexOffset;
+        buffer.GetBytes(reinterpret_cast<u8*>(indices.data()), indexBytes);
+
+        return true;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <NovusTypes.h>
+#include <string>
+#include <Utils/ByteBuffer.h>
+#include <vector>
+#include "Descriptors/ModelDesc.h"
+
+namespace Renderer
+{
+    // Parses .novusmodel files, this is kept out of the backend so models can be loaded without a device
+    namespace ModelFile
+    {
+        // Returns false if buffer doesn't hold a complete model of the current ModelFileHeader::VERSION, name is only used for logging
+        bool Read(Bytebuffer& buffer, const std::string& name, std::vector<Vertex>& vertices, std::vector<u32>& indices, i32& indexType);
+    }
+}
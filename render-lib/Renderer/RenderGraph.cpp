@@ -1,15 +1,44 @@
 #include "RenderGraph.h"
 #include "RenderGraphBuilder.h"
+#include "RenderStats.h"
+#include "FrameAllocator.h"
+#include <Utils/StringUtils.h>
+#include <robin_hood.h>
 #include <tracy/Tracy.hpp>
 
 #include "Renderer.h"
 
 namespace Renderer
 {
+#if NC_RENDER_PROFILING && TRACY_ENABLE
+    // Passes live in the frame allocator but Tracy resolves GPU zone source locations long after the frame is gone,
+    // so we keep one source location per pass name alive for the rest of the program
+    const tracy::SourceLocationData* GetPassSourceLocation(const IRenderPass* pass)
+    {
+        static robin_hood::unordered_map<u32, tracy::SourceLocationData*> sourceLocations;
+
+        u32 nameHash = StringUtils::fnv1a_32(pass->_name, pass->_nameLength);
+
+        auto itr = sourceLocations.find(nameHash);
+        if (itr != sourceLocations.end())
+            return itr->second;
+
+        char* name = new char[pass->_nameLength + 1];
+        memcpy(name, pass->_name, pass->_nameLength);
+        name[pass->_nameLength] = '\0';
+
+        tracy::SourceLocationData* sourceLocation = new tracy::SourceLocationData{ name, "RenderGraph::Execute", __FILE__, __LINE__, tracy::Color::Yellow2 };
+        sourceLocations[nameHash] = sourceLocation;
+
+        return sourceLocation;
+    }
+#endif
+
     bool RenderGraph::Init(RenderGraphDesc& desc)
     {
         _desc = desc;
         assert(desc.allocator != nullptr); // You need to set an allocator
+        _frameAllocator = dynamic_cast<FrameAllocator*>(desc.allocator);
 
         _renderGraphBuilder = Memory::Allocator::New<RenderGraphBuilder>(desc.allocator, desc.allocator, _renderer);
 
@@ -39,6 +68,12 @@ namespace Renderer
         _waitSemaphores.Insert(semaphoreID);
     }
 
+    void RenderGraph::MarkFrameStart(u32 frameIndex)
+    {
+        _markFrameStart = true;
+        _frameIndex = frameIndex;
+    }
+
     void RenderGraph::Setup()
     {
         ZoneScopedNC("RenderGraph::Setup", tracy::Color::Red2)
@@ -47,10 +82,16 @@ namespace Renderer
             ZoneScopedC(tracy::Color::Red2)
             ZoneName(pass->_name, pass->_nameLength)
 
+            if (_frameAllocator != nullptr)
+                _frameAllocator->BeginScope(pass->_name, pass->_nameLength);
+
             if (pass->Setup(_renderGraphBuilder))
             {
                 _executingPasses.Insert(pass);
             }
+
+            if (_frameAllocator != nullptr)
+                _frameAllocator->EndScope();
         }
     }
 
@@ -74,6 +115,11 @@ namespace Renderer
             commandList.AddWaitSemaphore(waitSemaphore);
         }
 
+        if (_markFrameStart)
+        {
+            commandList.MarkFrameStart(_frameIndex);
+        }
+
         // TODO: Parallel_for this
         commandList.PushMarker("RenderGraph", Color(0.0f, 0.0f, 0.4f));
         for (IRenderPass* pass : _executingPasses)
@@ -81,7 +127,19 @@ namespace Renderer
             ZoneScopedC(tracy::Color::Red2)
             ZoneName(pass->_name, pass->_nameLength)
 
+            if (_frameAllocator != nullptr)
+                _frameAllocator->BeginScope(pass->_name, pass->_nameLength);
+
+#if NC_RENDER_PROFILING && TRACY_ENABLE
+            commandList.BeginTrace(GetPassSourceLocation(pass));
             pass->Execute(resources, commandList);
+            commandList.EndTrace();
+#else
+            pass->Execute(resources, commandList);
+#endif
+
+            if (_frameAllocator != nullptr)
+                _frameAllocator->EndScope();
         }
         commandList.PopMarker();
         
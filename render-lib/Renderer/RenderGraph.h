@@ -14,6 +14,7 @@ namespace Renderer
 {
     class Renderer;
     class RenderGraphBuilder;
+    class FrameAllocator;
 
     // Acyclic Graph for rendering
     class RenderGraph
@@ -31,6 +32,9 @@ namespace Renderer
         void AddSignalSemaphore(GPUSemaphoreID semaphoreID);
         void AddWaitSemaphore(GPUSemaphoreID semaphoreID);
 
+        // Records MarkFrameStart ahead of every pass, the GPU profiler collects its timings there so it can't be inside a pass zone
+        void MarkFrameStart(u32 frameIndex);
+
         void Setup();
         void Execute();
 
@@ -61,8 +65,12 @@ namespace Renderer
         DynamicArray<GPUSemaphoreID> _signalSemaphores;
         DynamicArray<GPUSemaphoreID> _waitSemaphores;
 
+        bool _markFrameStart = false;
+        u32 _frameIndex = 0;
+
         Renderer* _renderer;
         RenderGraphBuilder* _renderGraphBuilder;
+        FrameAllocator* _frameAllocator = nullptr; // Set when the allocator is a FrameAllocator so allocations can be attributed to passes
 
         friend class Renderer; // To have access to the constructor
     };
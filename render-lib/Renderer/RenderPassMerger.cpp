@@ -0,0 +1,49 @@
+#include "RenderPassMerger.h"
+
+namespace Renderer
+{
+    bool RenderPassMerger::BeginPipeline(u32 renderPassKey)
+    {
+        bool continues = _canContinue && renderPassKey != NO_RENDER_PASS && renderPassKey == _renderPassKey;
+
+        _renderPassKey = renderPassKey;
+        _isPipelineOpen = true;
+        _canContinue = false;
+
+        if (continues)
+        {
+            _numMergedPipelines++;
+        }
+        else
+        {
+            _numRenderPasses++;
+        }
+
+        return continues;
+    }
+
+    void RenderPassMerger::EndPipeline()
+    {
+        _canContinue = _isPipelineOpen;
+        _isPipelineOpen = false;
+    }
+
+    void RenderPassMerger::Break()
+    {
+        // Inside of a pipeline nothing changes, whatever was recorded has to be valid in its render pass anyway
+        if (!_isPipelineOpen)
+        {
+            _canContinue = false;
+        }
+    }
+
+    void RenderPassMerger::Reset()
+    {
+        _renderPassKey = NO_RENDER_PASS;
+        _isPipelineOpen = false;
+        _canContinue = false;
+
+        _numRenderPasses = 0;
+        _numMergedPipelines = 0;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <NovusTypes.h>
+#include <limits>
+
+namespace Renderer
+{
+    // Decides while a command list is recorded which EndPipeline/BeginPipeline pairs can stay in one render pass, that is when both pipelines
+    // render into the same render pass and framebuffer and nothing that has to happen outside of a render pass was recorded between them
+    // It only sees render pass keys so recorded command streams can be replayed through it without a renderer
+    class RenderPassMerger
+    {
+    public:
+        static constexpr u32 NO_RENDER_PASS = std::numeric_limits<u32>::max(); // Never merged with anything
+
+        // Returns true if the pipeline continues the render pass of the pipeline ended right before it
+        bool BeginPipeline(u32 renderPassKey);
+        void EndPipeline();
+
+        // Call for every command between pipelines that isn't a plain state change, the next pipeline will begin a new render pass
+        void Break();
+
+        void Reset();
+
+        u32 GetNumRenderPasses() const { return _numRenderPasses; }
+        u32 GetNumMergedPipelines() const { return _numMergedPipelines; }
+
+    private:
+        u32 _renderPassKey = NO_RENDER_PASS; // Of the last pipeline that was begun
+        bool _isPipelineOpen = false;
+        bool _canContinue = false;
+
+        u32 _numRenderPasses = 0;
+        u32 _numMergedPipelines = 0;
+    };
+}
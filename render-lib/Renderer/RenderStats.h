@@ -0,0 +1,57 @@
+#pragma once
+#include <NovusTypes.h>
+#include <tracy/Tracy.hpp>
+
+// NC_RENDER_PROFILING toggles the render counters, per-pass GPU zones and GPU memory tracking
+// It is set by the NC_RENDER_PROFILING CMake option and falls back to following TRACY_ENABLE, when it is 0 all of it compiles away
+#ifndef NC_RENDER_PROFILING
+#if TRACY_ENABLE
+#define NC_RENDER_PROFILING 1
+#else
+#define NC_RENDER_PROFILING 0
+#endif
+#endif
+
+#if NC_RENDER_PROFILING
+#define NC_RENDER_STAT_ADD(stats, counter, amount) (stats).counter += (amount)
+#define NC_RENDER_TRACK_ALLOC(ptr, size, pool) TracyAllocN(ptr, size, pool)
+#define NC_RENDER_TRACK_FREE(ptr, pool) TracyFreeN(ptr, pool)
+#else
+#define NC_RENDER_STAT_ADD(stats, counter, amount) ((void)0)
+#define NC_RENDER_TRACK_ALLOC(ptr, size, pool) ((void)0)
+#define NC_RENDER_TRACK_FREE(ptr, pool) ((void)0)
+#endif
+
+namespace Renderer
+{
+    // Counters gathered while command lists are executed, they accumulate until the frame is ended with Renderer::EndFrameStats
+    struct RenderStats
+    {
+        u32 drawCalls = 0;
+        u32 descriptorWrites = 0;
+        u32 pipelineBinds = 0;
+        u32 pipelineLookups = 0; // CreatePipeline calls, renderers that hold on to their pipeline IDs don't add to this
+        u32 renderPasses = 0;
+        u32 mergedRenderPasses = 0; // Pipelines bound in the render pass of the previous pipeline, each one is a render pass that wasn't begun
+        u64 stagingBytes = 0;
+
+        void Reset()
+        {
+            drawCalls = 0;
+            descriptorWrites = 0;
+            pipelineBinds = 0;
+            pipelineLookups = 0;
+            renderPasses = 0;
+            mergedRenderPasses = 0;
+            stagingBytes = 0;
+        }
+    };
+
+    namespace MemoryPools
+    {
+        // Tracy identifies memory pools by pointer, inline variables give every translation unit the same address
+        inline constexpr char Buffers[] = "GPU Buffers";
+        inline constexpr char Textures[] = "GPU Textures";
+        inline constexpr char Images[] = "GPU Images";
+    }
+}
@@ -18,4 +18,35 @@ namespace Renderer
     {
         return nullptr;
     }
+
+    BufferPoolStats Renderer::GetBufferPoolStats(BufferCPUAccess /*cpuAccess*/) const
+    {
+        return BufferPoolStats();
+    }
+
+    void Renderer::EndFrameStats()
+    {
+#if NC_RENDER_PROFILING
+        TracyPlot("Draw Calls", static_cast<i64>(_frameStats.drawCalls));
+        TracyPlot("Descriptor Writes", static_cast<i64>(_frameStats.descriptorWrites));
+        TracyPlot("Pipeline Binds", static_cast<i64>(_frameStats.pipelineBinds));
+        TracyPlot("Pipeline Lookups", static_cast<i64>(_frameStats.pipelineLookups));
+        TracyPlot("Render Passes", static_cast<i64>(_frameStats.renderPasses));
+        TracyPlot("Merged Render Passes", static_cast<i64>(_frameStats.mergedRenderPasses));
+        TracyPlot("Staging Bytes", static_cast<i64>(_frameStats.stagingBytes));
+
+        u64 poolReservedBytes = 0;
+        u64 poolUsedBytes = 0;
+        for (BufferCPUAccess cpuAccess : { BufferCPUAccess::None, BufferCPUAccess::WriteOnly, BufferCPUAccess::ReadOnly })
+        {
+            BufferPoolStats poolStats = GetBufferPoolStats(cpuAccess);
+            poolReservedBytes += poolStats.reservedBytes;
+            poolUsedBytes += poolStats.usedBytes;
+        }
+        TracyPlot("Buffer Pool Reserved Bytes", static_cast<i64>(poolReservedBytes));
+        TracyPlot("Buffer Pool Used Bytes", static_cast<i64>(poolUsedBytes));
+
+        _frameStats.Reset();
+#endif
+    }
 }
\ No newline at end of file
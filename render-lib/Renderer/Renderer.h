@@ -8,6 +8,8 @@
 #include "RenderStates.h"
 #include "Font.h"
 #include "DescriptorSet.h"
+#include "RenderStats.h"
+#include "BufferPoolAllocator.h"
 
 // Descriptors
 #include "Descriptors/BufferDesc.h"
@@ -23,6 +25,7 @@
 #include "Descriptors/SamplerDesc.h"
 #include "Descriptors/GPUSemaphoreDesc.h"
 #include "Descriptors/FontDesc.h"
+#include "Descriptors/ShaderCacheDesc.h"
 
 class Window;
 
@@ -55,6 +58,9 @@ namespace Renderer
         virtual GraphicsPipelineID CreatePipeline(GraphicsPipelineDesc& desc) = 0;
         virtual ComputePipelineID CreatePipeline(ComputePipelineDesc& desc) = 0;
 
+        // Pipelines with the same key render into the same render pass and framebuffer, CommandList merges consecutive ones into one render pass
+        virtual u32 GetRenderPassKey(GraphicsPipelineID pipeline) = 0;
+
         virtual ModelID CreatePrimitiveModel(PrimitiveModelDesc& desc) = 0;
         virtual void UpdatePrimitiveModel(ModelID model, PrimitiveModelDesc& desc) = 0;
 
@@ -75,6 +81,11 @@ namespace Renderer
         virtual PixelShaderID LoadShader(PixelShaderDesc& desc) = 0;
         virtual ComputeShaderID LoadShader(ComputeShaderDesc& desc) = 0;
 
+        // Call before InitWindow so every shader can be loaded from the cache
+        virtual bool InitShaderCache(const ShaderCacheDesc& desc) = 0;
+        // Recompiles the shaders whose source changed and recreates the pipelines using them, returns how many shaders were reloaded
+        virtual u32 ReloadShaders() = 0;
+
         virtual void FlipFrame(u32 frameIndex) = 0;
 
         // Command List Functions
@@ -92,8 +103,8 @@ namespace Renderer
         virtual void DispatchIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset) = 0;
         virtual void PopMarker(CommandListID commandListID) = 0;
         virtual void PushMarker(CommandListID commandListID, Color color, std::string name) = 0;
-        virtual void BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipeline) = 0;
-        virtual void EndPipeline(CommandListID commandListID, GraphicsPipelineID pipeline) = 0;
+        virtual void BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipeline, bool beginRenderPass) = 0;
+        virtual void EndPipeline(CommandListID commandListID, GraphicsPipelineID pipeline, bool endRenderPass) = 0;
         virtual void SetPipeline(CommandListID commandListID, ComputePipelineID pipeline) = 0;
         virtual void SetScissorRect(CommandListID commandListID, ScissorRect scissorRect) = 0;
         virtual void SetViewport(CommandListID commandListID, Viewport viewport) = 0;
@@ -122,7 +133,15 @@ namespace Renderer
         virtual void InitImgui() = 0;
         virtual void DrawImgui(CommandListID commandListID) = 0;
 
+        // Stats
+        virtual BufferPoolStats GetBufferPoolStats(BufferCPUAccess cpuAccess) const;
+        RenderStats& GetFrameStats() { return _frameStats; }
+        const RenderStats& GetFrameStats() const { return _frameStats; }
+        void EndFrameStats(); // Plots the counters of the frame to Tracy and resets them, call once per frame after the last command list has executed
+
     protected:
         Renderer() {}; // Pure virtual class, disallow creation of it
+
+        RenderStats _frameStats;
     };
 }
\ No newline at end of file
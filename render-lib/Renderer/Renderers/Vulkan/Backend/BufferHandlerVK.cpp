@@ -1,10 +1,13 @@
 #include "BufferHandlerVK.h"
 #include "RenderDeviceVK.h"
 #include "DebugMarkerUtilVK.h"
+#include "../../../RenderStats.h"
 
 #include "vulkan/vulkan.h"
+#include <string>
 
 constexpr size_t MaxBufferCount = 65535;
+constexpr VkDeviceSize BUFFER_POOL_BLOCK_SIZE = 16 * 1024 * 1024; // Each VMA block holds 16 pool pages
 
 static_assert(MaxBufferCount <= std::numeric_limits<Renderer::BufferID::type>::max(), "Too many buffers to fit inside BufferID");
 
@@ -12,6 +15,16 @@ namespace Renderer
 {
     namespace Backend
     {
+        static VmaMemoryUsage GetMemoryUsage(BufferCPUAccess cpuAccess)
+        {
+            switch (cpuAccess)
+            {
+                case BufferCPUAccess::ReadOnly: return VMA_MEMORY_USAGE_GPU_TO_CPU;
+                case BufferCPUAccess::WriteOnly: return VMA_MEMORY_USAGE_CPU_ONLY;
+                default: return VMA_MEMORY_USAGE_GPU_ONLY;
+            }
+        }
+
         BufferHandlerVK::BufferHandlerVK()
         {
             _buffers = new Buffer[MaxBufferCount];
@@ -32,6 +45,22 @@ namespace Renderer
         {
             assert(_bufferCount == 0);
 
+            for (BufferPool& pool : _bufferPools)
+            {
+                for (std::vector<PoolPage>& pages : pool.pages)
+                {
+                    for (PoolPage& page : pages)
+                    {
+                        DestroyPoolPage(page);
+                    }
+                }
+
+                if (pool.vmaPool != VK_NULL_HANDLE)
+                {
+                    vmaDestroyPool(_device->_allocator, pool.vmaPool);
+                }
+            }
+
             delete[] _buffers;
             delete[] _indices;
         }
@@ -66,6 +95,12 @@ namespace Renderer
             return _buffers[static_cast<BufferID::type>(bufferID)].buffer;
         }
 
+        VkDeviceSize BufferHandlerVK::GetBufferOffset(BufferID bufferID) const
+        {
+            assert(bufferID != BufferID::Invalid());
+            return _buffers[static_cast<BufferID::type>(bufferID)].offset;
+        }
+
         VkDeviceSize BufferHandlerVK::GetBufferSize(BufferID bufferID) const
         {
             assert(bufferID != BufferID::Invalid());
@@ -123,41 +158,177 @@ namespace Renderer
             bufferInfo.usage = usage;
             bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
             
-            VmaMemoryUsage memoryUsage = VMA_MEMORY_USAGE_GPU_ONLY;
-            if (desc.cpuAccess == BufferCPUAccess::ReadOnly)
-            {
-                memoryUsage = VMA_MEMORY_USAGE_GPU_TO_CPU;
-            }
-            else if (desc.cpuAccess == BufferCPUAccess::WriteOnly)
+            const BufferID bufferID = AcquireNewBufferID();
+            Buffer& buffer = _buffers[(BufferID::type)bufferID];
+            buffer.size = desc.size;
+            buffer.cpuAccess = desc.cpuAccess;
+
+            // Small buffers share pages instead of getting their own VkBuffer and allocation
+            if (BufferPoolAllocator::IsPoolable(desc.size))
             {
-                memoryUsage = VMA_MEMORY_USAGE_CPU_ONLY;
+                if (!CreatePooledBuffer(desc, bufferID))
+                {
+                    ReturnBufferID(bufferID);
+                    return BufferID::Invalid();
+                }
+
+                return bufferID;
             }
 
             VmaAllocationCreateInfo allocInfo = {};
-            allocInfo.usage = memoryUsage;
+            allocInfo.usage = GetMemoryUsage(desc.cpuAccess);
 
-            const BufferID bufferID = AcquireNewBufferID();
-            Buffer& buffer = _buffers[(BufferID::type)bufferID];
-            buffer.size = desc.size;
+            buffer.offset = 0;
+            buffer.isPooled = false;
 
-            if (vmaCreateBuffer(_device->_allocator, &bufferInfo, &allocInfo, &buffer.buffer, &buffer.allocation, nullptr) != VK_SUCCESS)
+            VmaAllocationInfo allocationInfo;
+            if (vmaCreateBuffer(_device->_allocator, &bufferInfo, &allocInfo, &buffer.buffer, &buffer.allocation, &allocationInfo) != VK_SUCCESS)
             {
                 NC_LOG_FATAL("Failed to create buffer!");
                 return BufferID::Invalid();
             }
+            NC_RENDER_TRACK_ALLOC(buffer.allocation, allocationInfo.size, MemoryPools::Buffers);
 
             DebugMarkerUtilVK::SetObjectName(_device->_device, (u64)buffer.buffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, desc.name.c_str());
 
             return bufferID;
         }
 
+        bool BufferHandlerVK::CreatePooledBuffer(const BufferDesc& desc, BufferID bufferID)
+        {
+            Buffer& buffer = _buffers[(BufferID::type)bufferID];
+            BufferPool& pool = _bufferPools[static_cast<u8>(desc.cpuAccess)];
+
+            // Pages can hold any kind of buffer, so they get every usage flag we support
+            VkBufferCreateInfo pageInfo = {};
+            pageInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            pageInfo.size = BufferPoolAllocator::PAGE_SIZE;
+            pageInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            pageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            VmaAllocationCreateInfo allocInfo = {};
+            allocInfo.usage = GetMemoryUsage(desc.cpuAccess);
+
+            if (pool.vmaPool == VK_NULL_HANDLE)
+            {
+                u32 memoryTypeIndex;
+                if (vmaFindMemoryTypeIndexForBufferInfo(_device->_allocator, &pageInfo, &allocInfo, &memoryTypeIndex) != VK_SUCCESS)
+                {
+                    NC_LOG_FATAL("Failed to find a memory type for the buffer pool!");
+                    return false;
+                }
+
+                VmaPoolCreateInfo poolInfo = {};
+                poolInfo.memoryTypeIndex = memoryTypeIndex;
+                poolInfo.blockSize = BUFFER_POOL_BLOCK_SIZE;
+
+                if (vmaCreatePool(_device->_allocator, &poolInfo, &pool.vmaPool) != VK_SUCCESS)
+                {
+                    NC_LOG_FATAL("Failed to create buffer pool!");
+                    return false;
+                }
+            }
+
+            BufferPoolAllocation& poolAllocation = buffer.poolAllocation;
+            if (!pool.allocator.Allocate(desc.size, poolAllocation))
+            {
+                const u32 sizeClass = BufferPoolAllocator::GetSizeClass(desc.size);
+
+                PoolPage page;
+                allocInfo.pool = pool.vmaPool;
+
+                VmaAllocationInfo allocationInfo;
+                if (vmaCreateBuffer(_device->_allocator, &pageInfo, &allocInfo, &page.buffer, &page.allocation, &allocationInfo) != VK_SUCCESS)
+                {
+                    NC_LOG_FATAL("Failed to create buffer pool page!");
+                    return false;
+                }
+                NC_RENDER_TRACK_ALLOC(page.allocation, allocationInfo.size, MemoryPools::Buffers);
+
+                std::string pageName = "BufferPoolPage_" + std::to_string(BufferPoolAllocator::GetSlotSize(sizeClass));
+                DebugMarkerUtilVK::SetObjectName(_device->_device, (u64)page.buffer, VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, pageName.c_str());
+
+                // Released pages leave a hole in pages so the indices of the others stay valid, AddPage fills those first
+                const u32 pageIndex = pool.allocator.AddPage(sizeClass);
+                if (pageIndex < pool.pages[sizeClass].size())
+                {
+                    pool.pages[sizeClass][pageIndex] = page;
+                }
+                else
+                {
+                    pool.pages[sizeClass].push_back(page);
+                }
+
+                bool didAllocate = pool.allocator.Allocate(desc.size, poolAllocation);
+                assert(didAllocate); // A fresh page always has a free slot
+            }
+
+            const PoolPage& page = pool.pages[poolAllocation.sizeClass][poolAllocation.page];
+            buffer.buffer = page.buffer;
+            buffer.allocation = page.allocation;
+            buffer.offset = poolAllocation.offset;
+            buffer.isPooled = true;
+
+            return true;
+        }
+
         void BufferHandlerVK::DestroyBuffer(BufferID bufferID)
         {
             Buffer& buffer = _buffers[(BufferID::type)bufferID];
 
-            vmaDestroyBuffer(_device->_allocator, buffer.buffer, buffer.allocation);
+            if (buffer.isPooled)
+            {
+                // Up to MAX_EMPTY_PAGES empty pages stay alive for the next buffer of the same size class, the rest go back to VMA
+                BufferPool& pool = _bufferPools[static_cast<u8>(buffer.cpuAccess)];
+                if (pool.allocator.Free(buffer.poolAllocation))
+                {
+                    DestroyPoolPage(pool.pages[buffer.poolAllocation.sizeClass][buffer.poolAllocation.page]);
+                }
+            }
+            else
+            {
+                NC_RENDER_TRACK_FREE(buffer.allocation, MemoryPools::Buffers);
+                vmaDestroyBuffer(_device->_allocator, buffer.buffer, buffer.allocation);
+            }
 
             ReturnBufferID(bufferID);
         }
+
+        void BufferHandlerVK::DestroyPoolPage(PoolPage& page)
+        {
+            if (page.buffer == VK_NULL_HANDLE)
+                return;
+
+            NC_RENDER_TRACK_FREE(page.allocation, MemoryPools::Buffers);
+            vmaDestroyBuffer(_device->_allocator, page.buffer, page.allocation);
+
+            page.buffer = VK_NULL_HANDLE;
+            page.allocation = VK_NULL_HANDLE;
+        }
+
+        void* BufferHandlerVK::MapBuffer(BufferID bufferID)
+        {
+            const Buffer& buffer = _buffers[(BufferID::type)bufferID];
+
+            void* mappedMemory;
+            if (vmaMapMemory(_device->_allocator, buffer.allocation, &mappedMemory) != VK_SUCCESS)
+            {
+                NC_LOG_ERROR("vmaMapMemory failed!\n");
+                return nullptr;
+            }
+
+            return static_cast<u8*>(mappedMemory) + buffer.offset;
+        }
+
+        void BufferHandlerVK::UnmapBuffer(BufferID bufferID)
+        {
+            const Buffer& buffer = _buffers[(BufferID::type)bufferID];
+            vmaUnmapMemory(_device->_allocator, buffer.allocation);
+        }
+
+        BufferPoolStats BufferHandlerVK::GetPoolStats(BufferCPUAccess cpuAccess) const
+        {
+            return _bufferPools[static_cast<u8>(cpuAccess)].allocator.GetStats();
+        }
     }
 }
@@ -2,10 +2,12 @@
 #include <NovusTypes.h>
 
 #include "../../../Descriptors/BufferDesc.h"
+#include "../../../BufferPoolAllocator.h"
 
 #include "vk_mem_alloc.h"
 #include "vulkan/vulkan_core.h"
 
+#include <array>
 #include <vector>
 
 namespace Renderer
@@ -22,26 +24,61 @@ namespace Renderer
 
             void Init(RenderDeviceVK* device);
 
+            // Small buffers are sub-allocated from shared pages, so GetBuffer can return a VkBuffer that other BufferIDs use too
+            // Anything binding or copying it needs to add GetBufferOffset
             VkBuffer GetBuffer(BufferID bufferID) const;
+            VkDeviceSize GetBufferOffset(BufferID bufferID) const;
             VkDeviceSize GetBufferSize(BufferID bufferID) const;
             VmaAllocation GetBufferAllocation(BufferID bufferID) const;
 
             BufferID CreateBuffer(BufferDesc& desc);
             void DestroyBuffer(BufferID bufferID);
 
+            // Maps the memory of the buffer, the returned pointer already has the offset of the buffer applied
+            void* MapBuffer(BufferID bufferID);
+            void UnmapBuffer(BufferID bufferID);
+
+            BufferPoolStats GetPoolStats(BufferCPUAccess cpuAccess) const;
+
         private:
             BufferID AcquireNewBufferID();
             void ReturnBufferID(BufferID bufferID);
 
+            bool CreatePooledBuffer(const BufferDesc& desc, BufferID bufferID);
+
             RenderDeviceVK* _device = nullptr;
 
             struct Buffer
             {
                 VmaAllocation allocation;
                 VkBuffer buffer;
+                VkDeviceSize offset = 0;
                 VkDeviceSize size;
+
+                bool isPooled = false;
+                BufferCPUAccess cpuAccess = BufferCPUAccess::None;
+                BufferPoolAllocation poolAllocation;
+            };
+
+            struct PoolPage
+            {
+                VmaAllocation allocation = VK_NULL_HANDLE;
+                VkBuffer buffer = VK_NULL_HANDLE; // VK_NULL_HANDLE once the page has been released
+            };
+
+            void DestroyPoolPage(PoolPage& page);
+
+            // One pool per BufferCPUAccess since they need different memory types, each pool allocates its pages from a custom VMA pool
+            struct BufferPool
+            {
+                VmaPool vmaPool = VK_NULL_HANDLE;
+                BufferPoolAllocator allocator;
+                std::array<std::vector<PoolPage>, BufferPoolAllocator::NUM_SIZE_CLASSES> pages;
             };
 
+            static constexpr u32 NUM_BUFFER_POOLS = 3;
+            std::array<BufferPool, NUM_BUFFER_POOLS> _bufferPools;
+
             struct Index {
                 u32 next;
             };
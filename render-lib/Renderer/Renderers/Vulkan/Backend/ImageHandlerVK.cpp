@@ -4,6 +4,7 @@
 #include "RenderDeviceVK.h"
 #include "FormatConverterVK.h"
 #include "DebugMarkerUtilVK.h"
+#include "../../../RenderStats.h"
 
 namespace Renderer
 {
@@ -23,6 +24,7 @@ namespace Renderer
                 {
                     // Destroy old image
                     vkDestroyImageView(_device->_device, image.colorView, nullptr);
+                    NC_RENDER_TRACK_FREE(image.allocation, MemoryPools::Images);
                     vmaDestroyImage(_device->_allocator, image.image, image.allocation);
                     
                     // Create new
@@ -37,6 +39,7 @@ namespace Renderer
                 {
                     // Destroy old image
                     vkDestroyImageView(_device->_device, image.depthView, nullptr);
+                    NC_RENDER_TRACK_FREE(image.allocation, MemoryPools::Images);
                     vmaDestroyImage(_device->_allocator, image.image, image.allocation);
 
                     // Create new
@@ -190,10 +193,12 @@ namespace Renderer
             VmaAllocationCreateInfo allocInfo = {};
             allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
-            if (vmaCreateImage(_device->_allocator, &imageInfo, &allocInfo, &image.image, &image.allocation, nullptr) != VK_SUCCESS)
+            VmaAllocationInfo allocationInfo;
+            if (vmaCreateImage(_device->_allocator, &imageInfo, &allocInfo, &image.image, &image.allocation, &allocationInfo) != VK_SUCCESS)
             {
                 NC_LOG_FATAL("Failed to create image!");
             }
+            NC_RENDER_TRACK_ALLOC(image.allocation, allocationInfo.size, MemoryPools::Images);
 
             // Create Color View
             VkImageViewCreateInfo colorViewInfo = {};
@@ -269,10 +274,12 @@ namespace Renderer
             VmaAllocationCreateInfo allocInfo = {};
             allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
-            if (vmaCreateImage(_device->_allocator, &imageInfo, &allocInfo, &image.image, &image.allocation, nullptr) != VK_SUCCESS)
+            VmaAllocationInfo allocationInfo;
+            if (vmaCreateImage(_device->_allocator, &imageInfo, &allocInfo, &image.image, &image.allocation, &allocationInfo) != VK_SUCCESS)
             {
                 NC_LOG_FATAL("Failed to create image!");
             }
+            NC_RENDER_TRACK_ALLOC(image.allocation, allocationInfo.size, MemoryPools::Images);
 
             // Create Depth View
             VkImageViewCreateInfo depthViewInfo = {};
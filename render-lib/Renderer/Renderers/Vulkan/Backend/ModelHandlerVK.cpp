@@ -6,6 +6,7 @@
 #include "RenderDeviceVK.h"
 #include "DebugMarkerUtilVK.h"
 #include "BufferHandlerVK.h"
+#include "../../../ModelFile.h"
 
 namespace Renderer
 {
@@ -84,6 +85,17 @@ namespace Renderer
             return _bufferHandler->GetBuffer(model.vertexBuffer);
         }
 
+        VkDeviceSize ModelHandlerVK::GetVertexBufferOffset(ModelID modelID)
+        {
+            using type = type_safe::underlying_type<ModelID>;
+
+            // Lets make sure this id exists
+            assert(_models.size() > static_cast<type>(modelID));
+
+            Model& model = _models[static_cast<type>(modelID)];
+            return _bufferHandler->GetBufferOffset(model.vertexBuffer);
+        }
+
         u32 ModelHandlerVK::GetNumIndices(ModelID modelID)
         {
             using type = type_safe::underlying_type<ModelID>;
@@ -112,6 +124,17 @@ namespace Renderer
             return _bufferHandler->GetBuffer(model.indexBuffer);
         }
 
+        VkDeviceSize ModelHandlerVK::GetIndexBufferOffset(ModelID modelID)
+        {
+            using type = type_safe::underlying_type<ModelID>;
+
+            // Lets make sure this id exists
+            assert(_models.size() > static_cast<type>(modelID));
+
+            Model& model = _models[static_cast<type>(modelID)];
+            return _bufferHandler->GetBufferOffset(model.indexBuffer);
+        }
+
         void ModelHandlerVK::LoadFromFile(const ModelDesc& desc, TempModelData& data)
         {
             // Open header
@@ -122,80 +145,14 @@ namespace Renderer
                 NC_LOG_FATAL("Could not open Model file %s", desc.path.c_str());
             }
 
-            assert(file.Length() > sizeof(NovusTypeHeader));
-
-            std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<32768>();
-            file.Read(buffer.get(), file.Length());
-
-            // Read header
-            NovusTypeHeader header;
-            if (!buffer->Get<NovusTypeHeader>(header))
-            {
-                NC_LOG_FATAL("Model file %s did not have a valid NovusTypeHeader", desc.path.c_str());
-            }
-
-            if (header != EXPECTED_TYPE_HEADER)
-            {
-                if (header.typeID != EXPECTED_TYPE_HEADER.typeID)
-                {
-                    NC_LOG_FATAL("Model file %s had an invalid TypeID in its NovusTypeHeader, %u != %u", header.typeID, EXPECTED_TYPE_HEADER.typeID);
-                }
-                if (header.typeVersion != EXPECTED_TYPE_HEADER.typeVersion)
-                {
-                    NC_LOG_FATAL("Model file %s had an invalid TypeVersion in its NovusTypeHeader, %u != %u", header.typeVersion, EXPECTED_TYPE_HEADER.typeVersion);
-                }
-            }
-
-            // Read vertex count
-            u32 vertexCount;
-            if (!buffer->GetU32(vertexCount))
-            {
-                NC_LOG_FATAL("Model file %s did not have a valid vertexCount", desc.path.c_str());
-            }
-            
-            // Read vertices
-            data.vertices.resize(vertexCount);
-            
-            for (u32 i = 0; i < vertexCount; i++)
-            {
-                if (!buffer->Get<vec3>(data.vertices[i].pos))
-                {
-                    NC_LOG_FATAL("Model file %s failed to read vertex %u position", desc.path.c_str(), i);
-                }
-
-                if (!buffer->Get<vec3>(data.vertices[i].normal))
-                {
-                    NC_LOG_FATAL("Model file %s failed to read vertex %u normal", desc.path.c_str(), i);
-                }
-
-                if (!buffer->Get<vec2>(data.vertices[i].texCoord))
-                {
-                    NC_LOG_FATAL("Model file %s failed to read vertex %u texCoord", desc.path.c_str(), i);
-                }
-            }
+            // Sized to the file instead of borrowing a fixed buffer, so models aren't capped in size
+            Bytebuffer buffer(nullptr, file.Length());
+            file.Read(&buffer, buffer.size);
+            file.Close();
 
-            // Read index type
-            if (!buffer->GetI32(data.indexType))
+            if (!ModelFile::Read(buffer, desc.path, data.vertices, data.indices, data.indexType))
             {
-                NC_LOG_FATAL("Model file %s did not have a valid indexType", desc.path.c_str());
-            }
-
-            // Read index count
-            u32 indexCount;
-            if (!buffer->GetU32(indexCount))
-            {
-                NC_LOG_FATAL("Model file %s did not have a valid indexCount", desc.path.c_str());
-            }
-
-            // Read indices
-            data.indices.resize(indexCount);
-
-            for (u32 i = 0; i < indexCount; i++)
-            {
-                if (!buffer->GetU32(data.indices[i]))
-                {
-                    NC_LOG_FATAL("Model file %s failed to read index %u", desc.path.c_str(), i);
-                }
+                NC_LOG_FATAL("Failed to load Model file %s", desc.path.c_str());
             }
         }
 
@@ -214,8 +171,6 @@ namespace Renderer
                 bufferDesc.usage = BUFFER_USAGE_TRANSFER_DESTINATION | BUFFER_USAGE_VERTEX_BUFFER;
                 model.vertexBuffer = _bufferHandler->CreateBuffer(bufferDesc);
 
-                DebugMarkerUtilVK::SetObjectName(_device->_device, (u64)_bufferHandler->GetBuffer(model.vertexBuffer), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, model.debugName.c_str());
-
                 UpdateVertices(model, data.vertices);
             }
             
@@ -228,8 +183,6 @@ namespace Renderer
                 bufferDesc.usage = BUFFER_USAGE_TRANSFER_DESTINATION | BUFFER_USAGE_INDEX_BUFFER;
                 model.indexBuffer = _bufferHandler->CreateBuffer(bufferDesc);
 
-                DebugMarkerUtilVK::SetObjectName(_device->_device, (u64)_bufferHandler->GetBuffer(model.vertexBuffer), VK_DEBUG_REPORT_OBJECT_TYPE_BUFFER_EXT, model.debugName.c_str());
-
                 UpdateIndices(model, data.indices);
             }
 
@@ -265,16 +218,13 @@ namespace Renderer
             bufferDesc.cpuAccess = BufferCPUAccess::WriteOnly;
             BufferID stagingBuffer = _bufferHandler->CreateBuffer(bufferDesc);
 
-            VmaAllocation allocation = _bufferHandler->GetBufferAllocation(stagingBuffer);
-
             // Copy our vertex data into the staging buffer
-            void* vertexData;
-            vmaMapMemory(_device->_allocator, allocation, &vertexData);
+            void* vertexData = _bufferHandler->MapBuffer(stagingBuffer);
             memcpy(vertexData, vertices.data(), (size_t)bufferDesc.size);
-            vmaUnmapMemory(_device->_allocator, allocation);
+            _bufferHandler->UnmapBuffer(stagingBuffer);
 
             // Copy the vertex data from our staging buffer to our vertex buffer
-            _device->CopyBuffer(_bufferHandler->GetBuffer(model.vertexBuffer), 0, _bufferHandler->GetBuffer(stagingBuffer), 0, bufferDesc.size);
+            _device->CopyBuffer(_bufferHandler->GetBuffer(model.vertexBuffer), _bufferHandler->GetBufferOffset(model.vertexBuffer), _bufferHandler->GetBuffer(stagingBuffer), _bufferHandler->GetBufferOffset(stagingBuffer), bufferDesc.size);
 
             // Destroy and free our staging buffer
             _bufferHandler->DestroyBuffer(stagingBuffer);
@@ -291,13 +241,12 @@ namespace Renderer
             BufferID stagingBuffer = _bufferHandler->CreateBuffer(bufferDesc);
 
             // Copy our index data into the staging buffer
-            void* indexData;
-            vmaMapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(stagingBuffer), &indexData);
+            void* indexData = _bufferHandler->MapBuffer(stagingBuffer);
             memcpy(indexData, indices.data(), (size_t)bufferDesc.size);
-            vmaUnmapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(stagingBuffer));
+            _bufferHandler->UnmapBuffer(stagingBuffer);
 
             // Copy the index data from our staging buffer to our vertex buffer
-            _device->CopyBuffer(_bufferHandler->GetBuffer(model.indexBuffer), 0, _bufferHandler->GetBuffer(stagingBuffer), 0, bufferDesc.size);
+            _device->CopyBuffer(_bufferHandler->GetBuffer(model.indexBuffer), _bufferHandler->GetBufferOffset(model.indexBuffer), _bufferHandler->GetBuffer(stagingBuffer), _bufferHandler->GetBufferOffset(stagingBuffer), bufferDesc.size);
 
             // Destroy and free our staging buffer
             _bufferHandler->DestroyBuffer(stagingBuffer);
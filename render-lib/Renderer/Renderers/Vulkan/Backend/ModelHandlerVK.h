@@ -1,6 +1,5 @@
 #pragma once
 #include <NovusTypes.h>
-#include <NovusTypeHeader.h>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include "vk_mem_alloc.h"
@@ -17,8 +16,6 @@ namespace Renderer
 
         class ModelHandlerVK
         {
-            // Update the second value of this when the format exported from the converter gets changed
-            const NovusTypeHeader EXPECTED_TYPE_HEADER = NovusTypeHeader(42, 2);
         public:
             void Init(RenderDeviceVK* device, BufferHandlerVK* bufferHandler);
 
@@ -28,9 +25,11 @@ namespace Renderer
             ModelID LoadModel(const ModelDesc& desc);
 
             VkBuffer GetVertexBuffer(ModelID modelID);
+            VkDeviceSize GetVertexBufferOffset(ModelID modelID);
 
             u32 GetNumIndices(ModelID modelID);
             VkBuffer GetIndexBuffer(ModelID modelID);
+            VkDeviceSize GetIndexBufferOffset(ModelID modelID);
             
         private:
             struct Model
@@ -7,6 +7,7 @@
 #include "ImageHandlerVK.h"
 #include "SpirvReflect.h"
 #include "DescriptorSetBuilderVK.h"
+#include <algorithm>
 
 
 namespace Renderer
@@ -22,10 +23,10 @@ namespace Renderer
 
         void PipelineHandlerVK::OnWindowResize()
         {
-            for (auto& pipeline : _graphicsPipelines)
+            for (Framebuffer& framebuffer : _framebuffers)
             {
-                vkDestroyFramebuffer(_device->_device, pipeline.framebuffer, nullptr);
-                CreateFramebuffer(pipeline);
+                vkDestroyFramebuffer(_device->_device, framebuffer.framebuffer, nullptr);
+                CreateFramebuffer(framebuffer);
             }
         }
 
@@ -52,93 +53,30 @@ namespace Renderer
             pipeline.desc = desc;
             pipeline.cacheDescHash = cacheDescHash;
 
-            // -- Get number of render targets and attachments --
-            u8 numAttachments = 0;
+            // -- Get number of render targets --
             for (int i = 0; i < MAX_RENDER_TARGETS; i++)
             {
                 if (desc.renderTargets[i] == RenderPassMutableResource::Invalid())
                     break;
 
                 pipeline.numRenderTargets++;
-                numAttachments++;
             }
 
-            // -- Create Render Pass --
-            std::vector<VkAttachmentDescription> attachments(numAttachments);
-            std::vector< VkAttachmentReference> colorAttachmentRefs(numAttachments);
-            for (int i = 0; i < numAttachments; i++)
-            {
-                ImageID imageID = desc.MutableResourceToImageID(desc.renderTargets[i]);
-                const ImageDesc& imageDesc = _imageHandler->GetImageDesc(imageID);
-                attachments[i].format = FormatConverterVK::ToVkFormat(imageDesc.format);
-                attachments[i].samples = FormatConverterVK::ToVkSampleCount(imageDesc.sampleCount);
-                attachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
-                attachments[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-                attachments[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-                attachments[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-                attachments[i].initialLayout = VK_IMAGE_LAYOUT_GENERAL;
-                attachments[i].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-                colorAttachmentRefs[i].attachment = i;
-                colorAttachmentRefs[i].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-            }
-
-            VkSubpassDescription subpass = {};
-            subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-            subpass.colorAttachmentCount = numAttachments;
-            subpass.pColorAttachments = colorAttachmentRefs.data();
-
-            VkAttachmentReference depthDescriptionRef = {};
-
-            // If we have a depthstencil, add an attachment for that
-            if (desc.depthStencil != RenderPassMutableResource::Invalid())
+            // -- Get Render Pass and Framebuffer, pipelines rendering into the same images share them --
+            Framebuffer framebuffer;
+            framebuffer.numRenderTargets = pipeline.numRenderTargets;
+            for (u32 i = 0; i < pipeline.numRenderTargets; i++)
             {
-                DepthImageID depthImageID = desc.MutableResourceToDepthImageID(desc.depthStencil);
-                const DepthImageDesc& imageDesc = _imageHandler->GetDepthImageDesc(depthImageID);
-
-                u32 attachmentSlot = numAttachments++;
-                
-                VkAttachmentDescription& depthDescription = attachments.emplace_back();
-                depthDescription = {};
-                depthDescription.format = FormatConverterVK::ToVkFormat(imageDesc.format);
-                depthDescription.samples = FormatConverterVK::ToVkSampleCount(imageDesc.sampleCount);
-                depthDescription.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
-                depthDescription.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-                depthDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-                depthDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-                depthDescription.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-                depthDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-                depthDescriptionRef.attachment = attachmentSlot;
-                depthDescriptionRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-                subpass.pDepthStencilAttachment = &depthDescriptionRef;
+                framebuffer.renderTargets[i] = desc.MutableResourceToImageID(desc.renderTargets[i]);
             }
 
-            VkSubpassDependency dependency = {};
-            dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-            dependency.dstSubpass = 0;
-            dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dependency.srcAccessMask = 0;
-            dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-            VkRenderPassCreateInfo renderPassInfo = {};
-            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-            renderPassInfo.attachmentCount = numAttachments;
-            renderPassInfo.pAttachments = attachments.data();
-            renderPassInfo.subpassCount = 1;
-            renderPassInfo.pSubpasses = &subpass;
-            renderPassInfo.dependencyCount = 1;
-            renderPassInfo.pDependencies = &dependency;
-
-            if (vkCreateRenderPass(_device->_device, &renderPassInfo, nullptr, &pipeline.renderPass) != VK_SUCCESS)
+            if (desc.depthStencil != RenderPassMutableResource::Invalid())
             {
-                NC_LOG_FATAL("Failed to create render pass!");
+                framebuffer.depthStencil = desc.MutableResourceToDepthImageID(desc.depthStencil);
             }
 
-            // -- Create Framebuffer --
-            CreateFramebuffer(pipeline);
+            pipeline.framebufferIndex = GetOrCreateFramebuffer(framebuffer);
+            pipeline.renderPass = _framebuffers[pipeline.framebufferIndex].renderPass;
 
             // -- Get Reflection data from shader --
             std::vector<BindInfo> bindInfos;
@@ -193,6 +131,139 @@ namespace Renderer
                 range.stageFlags = pushConstant.stageFlags;
             }
 
+            VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            pipelineLayoutInfo.setLayoutCount = static_cast<u32>(pipeline.descriptorSetLayouts.size());
+            pipelineLayoutInfo.pSetLayouts = pipeline.descriptorSetLayouts.data();
+            pipelineLayoutInfo.pushConstantRangeCount = static_cast<u32>(pipeline.pushConstantRanges.size()); // Optional
+            pipelineLayoutInfo.pPushConstantRanges = pipeline.pushConstantRanges.data();
+
+            if (vkCreatePipelineLayout(_device->_device, &pipelineLayoutInfo, nullptr, &pipeline.pipelineLayout) != VK_SUCCESS)
+            {
+                NC_LOG_FATAL("Failed to create pipeline layout!");
+            }
+
+            CreatePipelineObject(pipeline);
+
+            GraphicsPipelineID pipelineID = GraphicsPipelineID(static_cast<gIDType>(nextID));
+            pipeline.descriptorSetBuilder = new DescriptorSetBuilderVK(pipelineID, this, _shaderHandler, _device->_descriptorMegaPool);
+
+            _graphicsPipelines.push_back(pipeline);
+            _graphicsPipelineHashToID[cacheDescHash] = static_cast<gIDType>(nextID);
+
+            pipeline.descriptorSetBuilder->InitReflectData(); // Needs to happen after push_back
+
+
+            return pipelineID;
+        }
+
+        ComputePipelineID PipelineHandlerVK::CreatePipeline(const ComputePipelineDesc& desc)
+        {
+            // Check the cache
+            size_t nextID;
+            u64 cacheDescHash = CalculateCacheDescHash(desc);
+            if (TryFindExistingCPipeline(cacheDescHash, nextID))
+            {
+                return ComputePipelineID(static_cast<ComputePipelineID::type>(nextID));
+            }
+            nextID = _computePipelines.size();
+
+            ComputePipeline pipeline;
+            pipeline.desc = desc;
+            pipeline.cacheDescHash = cacheDescHash;
+
+            std::vector<BindInfo> bindInfos;
+
+            const BindReflection& bindReflection = _shaderHandler->GetBindReflection(desc.computeShader);
+            bindInfos.insert(bindInfos.end(), bindReflection.dataBindings.begin(), bindReflection.dataBindings.end());
+
+            for (BindInfo& bindInfo : bindInfos)
+            {
+                DescriptorSetLayoutData& layout = GetDescriptorSet(bindInfo.set, pipeline.descriptorSetLayoutDatas);
+                VkDescriptorSetLayoutBinding layoutBinding = {};
+
+                layoutBinding.binding = bindInfo.binding;
+                layoutBinding.descriptorType = bindInfo.descriptorType;
+                layoutBinding.descriptorCount = bindInfo.count;
+                layoutBinding.stageFlags = bindInfo.stageFlags;
+
+                layout.bindings.push_back(layoutBinding);
+            }
+
+            size_t numDescriptorSets = pipeline.descriptorSetLayoutDatas.size();
+            pipeline.descriptorSetLayouts.resize(numDescriptorSets);
+
+            for (size_t i = 0; i < numDescriptorSets; i++)
+            {
+                pipeline.descriptorSetLayoutDatas[i].createInfo.bindingCount = static_cast<u32>(pipeline.descriptorSetLayoutDatas[i].bindings.size());
+                pipeline.descriptorSetLayoutDatas[i].createInfo.pBindings = pipeline.descriptorSetLayoutDatas[i].bindings.data();
+
+                if (vkCreateDescriptorSetLayout(_device->_device, &pipeline.descriptorSetLayoutDatas[i].createInfo, nullptr, &pipeline.descriptorSetLayouts[i]) != VK_SUCCESS)
+                {
+                    NC_LOG_FATAL("Failed to create descriptor set layout!");
+                }
+            }
+
+            VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
+            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            pipelineLayoutInfo.setLayoutCount = static_cast<u32>(pipeline.descriptorSetLayouts.size());
+            pipelineLayoutInfo.pSetLayouts = pipeline.descriptorSetLayouts.data();
+            pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
+            pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
+
+            if (vkCreatePipelineLayout(_device->_device, &pipelineLayoutInfo, nullptr, &pipeline.pipelineLayout) != VK_SUCCESS)
+            {
+                NC_LOG_FATAL("Failed to create pipeline layout!");
+            }
+
+            CreatePipelineObject(pipeline);
+
+            ComputePipelineID pipelineID = ComputePipelineID(static_cast<cIDType>(nextID));
+            pipeline.descriptorSetBuilder = new DescriptorSetBuilderVK(pipelineID, this, _shaderHandler, _device->_descriptorMegaPool);
+
+            _computePipelines.push_back(pipeline);
+            _computePipelineHashToID[cacheDescHash] = static_cast<cIDType>(nextID);
+
+            pipeline.descriptorSetBuilder->InitReflectData(); // Needs to happen after push_back
+
+            return pipelineID;
+        }
+
+        u32 PipelineHandlerVK::RecreatePipelines(const ReloadedShaders& reloadedShaders)
+        {
+            u32 numRecreated = 0;
+
+            for (GraphicsPipeline& pipeline : _graphicsPipelines)
+            {
+                const GraphicsPipelineDesc::States& states = pipeline.desc.states;
+
+                bool usesVertexShader = std::find(reloadedShaders.vertexShaders.begin(), reloadedShaders.vertexShaders.end(), states.vertexShader) != reloadedShaders.vertexShaders.end();
+                bool usesPixelShader = std::find(reloadedShaders.pixelShaders.begin(), reloadedShaders.pixelShaders.end(), states.pixelShader) != reloadedShaders.pixelShaders.end();
+                if (!usesVertexShader && !usesPixelShader)
+                    continue;
+
+                vkDestroyPipeline(_device->_device, pipeline.pipeline, nullptr);
+                CreatePipelineObject(pipeline);
+                numRecreated++;
+            }
+
+            for (ComputePipeline& pipeline : _computePipelines)
+            {
+                if (std::find(reloadedShaders.computeShaders.begin(), reloadedShaders.computeShaders.end(), pipeline.desc.computeShader) == reloadedShaders.computeShaders.end())
+                    continue;
+
+                vkDestroyPipeline(_device->_device, pipeline.pipeline, nullptr);
+                CreatePipelineObject(pipeline);
+                numRecreated++;
+            }
+
+            return numRecreated;
+        }
+
+        void PipelineHandlerVK::CreatePipelineObject(GraphicsPipeline& pipeline)
+        {
+            const GraphicsPipelineDesc& desc = pipeline.desc;
+
             std::vector<VkPipelineShaderStageCreateInfo> shaderStages;
             if (desc.states.vertexShader != VertexShaderID::Invalid())
             {
@@ -396,18 +467,6 @@ namespace Renderer
             colorBlending.blendConstants[2] = 0.0f; // TODO: Blend constants
             colorBlending.blendConstants[3] = 0.0f; // TODO: Blend constants
             
-            VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
-            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-            pipelineLayoutInfo.setLayoutCount = static_cast<u32>(pipeline.descriptorSetLayouts.size());
-            pipelineLayoutInfo.pSetLayouts = pipeline.descriptorSetLayouts.data();
-            pipelineLayoutInfo.pushConstantRangeCount = static_cast<u32>(pipeline.pushConstantRanges.size()); // Optional
-            pipelineLayoutInfo.pPushConstantRanges = pipeline.pushConstantRanges.data();
-
-            if (vkCreatePipelineLayout(_device->_device, &pipelineLayoutInfo, nullptr, &pipeline.pipelineLayout) != VK_SUCCESS)
-            {
-                NC_LOG_FATAL("Failed to create pipeline layout!");
-            }
-
             // Set up dynamic viewport and scissor
             std::vector<VkDynamicState> dynamicStates;
             dynamicStates.reserve(2);
@@ -442,76 +501,11 @@ namespace Renderer
             {
                 NC_LOG_FATAL("Failed to create graphics pipeline!");
             }
-
-            GraphicsPipelineID pipelineID = GraphicsPipelineID(static_cast<gIDType>(nextID));
-            pipeline.descriptorSetBuilder = new DescriptorSetBuilderVK(pipelineID, this, _shaderHandler, _device->_descriptorMegaPool);
-
-            _graphicsPipelines.push_back(pipeline);
-
-            pipeline.descriptorSetBuilder->InitReflectData(); // Needs to happen after push_back
-
-
-            return pipelineID;
         }
 
-        ComputePipelineID PipelineHandlerVK::CreatePipeline(const ComputePipelineDesc& desc)
+        void PipelineHandlerVK::CreatePipelineObject(ComputePipeline& pipeline)
         {
-            // Check the cache
-            size_t nextID;
-            u64 cacheDescHash = CalculateCacheDescHash(desc);
-            if (TryFindExistingCPipeline(cacheDescHash, nextID))
-            {
-                return ComputePipelineID(static_cast<ComputePipelineID::type>(nextID));
-            }
-            nextID = _computePipelines.size();
-
-            ComputePipeline pipeline;
-            pipeline.desc = desc;
-            pipeline.cacheDescHash = cacheDescHash;
-
-            std::vector<BindInfo> bindInfos;
-
-            const BindReflection& bindReflection = _shaderHandler->GetBindReflection(desc.computeShader);
-            bindInfos.insert(bindInfos.end(), bindReflection.dataBindings.begin(), bindReflection.dataBindings.end());
-
-            for (BindInfo& bindInfo : bindInfos)
-            {
-                DescriptorSetLayoutData& layout = GetDescriptorSet(bindInfo.set, pipeline.descriptorSetLayoutDatas);
-                VkDescriptorSetLayoutBinding layoutBinding = {};
-
-                layoutBinding.binding = bindInfo.binding;
-                layoutBinding.descriptorType = bindInfo.descriptorType;
-                layoutBinding.descriptorCount = bindInfo.count;
-                layoutBinding.stageFlags = bindInfo.stageFlags;
-
-                layout.bindings.push_back(layoutBinding);
-            }
-
-            size_t numDescriptorSets = pipeline.descriptorSetLayoutDatas.size();
-            pipeline.descriptorSetLayouts.resize(numDescriptorSets);
-
-            for (size_t i = 0; i < numDescriptorSets; i++)
-            {
-                pipeline.descriptorSetLayoutDatas[i].createInfo.bindingCount = static_cast<u32>(pipeline.descriptorSetLayoutDatas[i].bindings.size());
-                pipeline.descriptorSetLayoutDatas[i].createInfo.pBindings = pipeline.descriptorSetLayoutDatas[i].bindings.data();
-
-                if (vkCreateDescriptorSetLayout(_device->_device, &pipeline.descriptorSetLayoutDatas[i].createInfo, nullptr, &pipeline.descriptorSetLayouts[i]) != VK_SUCCESS)
-                {
-                    NC_LOG_FATAL("Failed to create descriptor set layout!");
-                }
-            }
-
-            VkPipelineLayoutCreateInfo pipelineLayoutInfo = {};
-            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-            pipelineLayoutInfo.setLayoutCount = static_cast<u32>(pipeline.descriptorSetLayouts.size());
-            pipelineLayoutInfo.pSetLayouts = pipeline.descriptorSetLayouts.data();
-            pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
-            pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
-
-            if (vkCreatePipelineLayout(_device->_device, &pipelineLayoutInfo, nullptr, &pipeline.pipelineLayout) != VK_SUCCESS)
-            {
-                NC_LOG_FATAL("Failed to create pipeline layout!");
-            }
+            const ComputePipelineDesc& desc = pipeline.desc;
 
             VkPipelineShaderStageCreateInfo shaderStage = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
             shaderStage.module = _shaderHandler->GetShaderModule(desc.computeShader);
@@ -526,15 +520,6 @@ namespace Renderer
             {
                 NC_LOG_FATAL("Failed to create compute pipeline!");
             }
-
-            ComputePipelineID pipelineID = ComputePipelineID(static_cast<cIDType>(nextID));
-            pipeline.descriptorSetBuilder = new DescriptorSetBuilderVK(pipelineID, this, _shaderHandler, _device->_descriptorMegaPool);
-
-            _computePipelines.push_back(pipeline);
-
-            pipeline.descriptorSetBuilder->InitReflectData(); // Needs to happen after push_back
-
-            return pipelineID;
         }
 
         u64 PipelineHandlerVK::CalculateCacheDescHash(const GraphicsPipelineDesc& desc)
@@ -572,34 +557,22 @@ namespace Renderer
 
         bool PipelineHandlerVK::TryFindExistingGPipeline(u64 descHash, size_t& id)
         {
-            id = 0;
-
-            for (auto& pipeline : _graphicsPipelines)
-            {
-                if (descHash == pipeline.cacheDescHash)
-                {
-                    return true;
-                }
-                id++;
-            }
+            auto iterator = _graphicsPipelineHashToID.find(descHash);
+            if (iterator == _graphicsPipelineHashToID.end())
+                return false;
 
-            return false;
+            id = static_cast<size_t>(iterator->second);
+            return true;
         }
 
         bool PipelineHandlerVK::TryFindExistingCPipeline(u64 descHash, size_t& id)
         {
-            id = 0;
-
-            for (auto& pipeline : _computePipelines)
-            {
-                if (descHash == pipeline.cacheDescHash)
-                {
-                    return true;
-                }
-                id++;
-            }
+            auto iterator = _computePipelineHashToID.find(descHash);
+            if (iterator == _computePipelineHashToID.end())
+                return false;
 
-            return false;
+            id = static_cast<size_t>(iterator->second);
+            return true;
         }
 
         DescriptorSetLayoutData& PipelineHandlerVK::GetDescriptorSet(i32 setNumber, std::vector<DescriptorSetLayoutData>& sets)
@@ -617,11 +590,143 @@ namespace Renderer
             return sets[setNumber];
         }
 
-        void PipelineHandlerVK::CreateFramebuffer(GraphicsPipeline& pipeline)
+        u32 PipelineHandlerVK::GetOrCreateFramebuffer(Framebuffer& framebuffer)
         {
-            u32 numAttachments = pipeline.numRenderTargets;
-            
-            if (pipeline.desc.depthStencil != RenderPassMutableResource::Invalid())
+            RenderPassCacheDesc renderPassDesc;
+            renderPassDesc.numRenderTargets = framebuffer.numRenderTargets;
+            for (u32 i = 0; i < framebuffer.numRenderTargets; i++)
+            {
+                const ImageDesc& imageDesc = _imageHandler->GetImageDesc(framebuffer.renderTargets[i]);
+                renderPassDesc.colorFormats[i] = FormatConverterVK::ToVkFormat(imageDesc.format);
+                renderPassDesc.colorSampleCounts[i] = FormatConverterVK::ToVkSampleCount(imageDesc.sampleCount);
+            }
+
+            if (framebuffer.depthStencil != DepthImageID::Invalid())
+            {
+                const DepthImageDesc& imageDesc = _imageHandler->GetDepthImageDesc(framebuffer.depthStencil);
+                renderPassDesc.hasDepthStencil = 1;
+                renderPassDesc.depthFormat = FormatConverterVK::ToVkFormat(imageDesc.format);
+                renderPassDesc.depthSampleCount = FormatConverterVK::ToVkSampleCount(imageDesc.sampleCount);
+            }
+
+            u64 renderPassHash = XXHash64::hash(&renderPassDesc, sizeof(renderPassDesc), 0);
+
+            // The framebuffer is identified by its render pass and the images it renders into
+            u64 framebufferKey[MAX_RENDER_TARGETS + 2] = {};
+            framebufferKey[0] = renderPassHash;
+            for (u32 i = 0; i < framebuffer.numRenderTargets; i++)
+            {
+                framebufferKey[i + 1] = static_cast<type_safe::underlying_type<ImageID>>(framebuffer.renderTargets[i]);
+            }
+            framebufferKey[MAX_RENDER_TARGETS + 1] = static_cast<type_safe::underlying_type<DepthImageID>>(framebuffer.depthStencil);
+
+            u64 framebufferHash = XXHash64::hash(framebufferKey, sizeof(framebufferKey), 0);
+
+            auto framebufferIterator = _framebufferHashToIndex.find(framebufferHash);
+            if (framebufferIterator != _framebufferHashToIndex.end())
+                return framebufferIterator->second;
+
+            auto renderPassIterator = _renderPasses.find(renderPassHash);
+            if (renderPassIterator != _renderPasses.end())
+            {
+                framebuffer.renderPass = renderPassIterator->second;
+            }
+            else
+            {
+                framebuffer.renderPass = CreateRenderPass(renderPassDesc);
+                _renderPasses[renderPassHash] = framebuffer.renderPass;
+            }
+
+            CreateFramebuffer(framebuffer);
+
+            u32 index = static_cast<u32>(_framebuffers.size());
+            _framebuffers.push_back(framebuffer);
+            _framebufferHashToIndex[framebufferHash] = index;
+
+            return index;
+        }
+
+        VkRenderPass PipelineHandlerVK::CreateRenderPass(const RenderPassCacheDesc& desc)
+        {
+            u32 numAttachments = desc.numRenderTargets;
+
+            std::vector<VkAttachmentDescription> attachments(numAttachments);
+            std::vector<VkAttachmentReference> colorAttachmentRefs(numAttachments);
+            for (u32 i = 0; i < numAttachments; i++)
+            {
+                attachments[i].format = desc.colorFormats[i];
+                attachments[i].samples = desc.colorSampleCounts[i];
+                attachments[i].loadOp = desc.loadOp;
+                attachments[i].storeOp = desc.storeOp;
+                attachments[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                attachments[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                attachments[i].initialLayout = VK_IMAGE_LAYOUT_GENERAL;
+                attachments[i].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+                colorAttachmentRefs[i].attachment = i;
+                colorAttachmentRefs[i].layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            }
+
+            VkSubpassDescription subpass = {};
+            subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.colorAttachmentCount = numAttachments;
+            subpass.pColorAttachments = colorAttachmentRefs.data();
+
+            VkAttachmentReference depthDescriptionRef = {};
+
+            // If we have a depthstencil, add an attachment for that
+            if (desc.hasDepthStencil)
+            {
+                u32 attachmentSlot = numAttachments++;
+
+                VkAttachmentDescription& depthDescription = attachments.emplace_back();
+                depthDescription = {};
+                depthDescription.format = desc.depthFormat;
+                depthDescription.samples = desc.depthSampleCount;
+                depthDescription.loadOp = desc.loadOp;
+                depthDescription.storeOp = desc.storeOp;
+                depthDescription.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                depthDescription.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                depthDescription.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+                depthDescription.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+                depthDescriptionRef.attachment = attachmentSlot;
+                depthDescriptionRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+                subpass.pDepthStencilAttachment = &depthDescriptionRef;
+            }
+
+            VkSubpassDependency dependency = {};
+            dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+            dependency.dstSubpass = 0;
+            dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dependency.srcAccessMask = 0;
+            dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+            VkRenderPassCreateInfo renderPassInfo = {};
+            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+            renderPassInfo.attachmentCount = numAttachments;
+            renderPassInfo.pAttachments = attachments.data();
+            renderPassInfo.subpassCount = 1;
+            renderPassInfo.pSubpasses = &subpass;
+            renderPassInfo.dependencyCount = 1;
+            renderPassInfo.pDependencies = &dependency;
+
+            VkRenderPass renderPass;
+            if (vkCreateRenderPass(_device->_device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS)
+            {
+                NC_LOG_FATAL("Failed to create render pass!");
+            }
+
+            return renderPass;
+        }
+
+        void PipelineHandlerVK::CreateFramebuffer(Framebuffer& framebuffer)
+        {
+            u32 numAttachments = framebuffer.numRenderTargets;
+
+            if (framebuffer.depthStencil != DepthImageID::Invalid())
             {
                 numAttachments += 1;
             }
@@ -629,30 +734,28 @@ namespace Renderer
             std::vector<VkImageView> attachmentViews(numAttachments);
 
             // Add all color rendertargets as attachments
-            for (u32 i = 0; i < pipeline.numRenderTargets; i++)
+            for (u32 i = 0; i < framebuffer.numRenderTargets; i++)
             {
-                ImageID imageID = pipeline.desc.MutableResourceToImageID(pipeline.desc.renderTargets[i]);
-                attachmentViews[i] = _imageHandler->GetColorView(imageID);
+                attachmentViews[i] = _imageHandler->GetColorView(framebuffer.renderTargets[i]);
             }
             // Add depthstencil as attachment
-            if (pipeline.desc.depthStencil != RenderPassMutableResource::Invalid())
+            if (framebuffer.depthStencil != DepthImageID::Invalid())
             {
-                DepthImageID depthImageID = pipeline.desc.MutableResourceToDepthImageID(pipeline.desc.depthStencil);
-                attachmentViews[pipeline.numRenderTargets] = _imageHandler->GetDepthView(depthImageID);
+                attachmentViews[framebuffer.numRenderTargets] = _imageHandler->GetDepthView(framebuffer.depthStencil);
             }
 
             uvec2 renderSize = _device->GetMainWindowSize();
 
             VkFramebufferCreateInfo framebufferInfo = {};
             framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-            framebufferInfo.renderPass = pipeline.renderPass;
+            framebufferInfo.renderPass = framebuffer.renderPass;
             framebufferInfo.attachmentCount = static_cast<u32>(attachmentViews.size());
             framebufferInfo.pAttachments = attachmentViews.data();
             framebufferInfo.width = renderSize.x;
             framebufferInfo.height = renderSize.y;
             framebufferInfo.layers = 1;
 
-            if (vkCreateFramebuffer(_device->_device, &framebufferInfo, nullptr, &pipeline.framebuffer) != VK_SUCCESS)
+            if (vkCreateFramebuffer(_device->_device, &framebufferInfo, nullptr, &framebuffer.framebuffer) != VK_SUCCESS)
             {
                 NC_LOG_FATAL("Failed to create framebuffer!");
             }
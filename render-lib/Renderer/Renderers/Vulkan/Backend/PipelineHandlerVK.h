@@ -15,6 +15,7 @@ namespace Renderer
         class ShaderHandlerVK;
         class ImageHandlerVK;
         class DescriptorSetBuilderVK;
+        struct ReloadedShaders;
 
         struct DescriptorSetLayoutData
         {
@@ -34,6 +35,9 @@ namespace Renderer
             GraphicsPipelineID CreatePipeline(const GraphicsPipelineDesc& desc);
             ComputePipelineID CreatePipeline(const ComputePipelineDesc& desc);
 
+            // Recreates the VkPipeline of every pipeline using one of the shaders, its layout and render pass are kept. Returns how many were recreated
+            u32 RecreatePipelines(const ReloadedShaders& reloadedShaders);
+
             const GraphicsPipelineDesc& GetDescriptor(GraphicsPipelineID id) { return _graphicsPipelines[static_cast<gIDType>(id)].desc; }
             const ComputePipelineDesc& GetDescriptor(ComputePipelineID id) { return _computePipelines[static_cast<gIDType>(id)].desc; }
 
@@ -41,7 +45,10 @@ namespace Renderer
             VkPipeline GetPipeline(ComputePipelineID id) { return _computePipelines[static_cast<cIDType>(id)].pipeline; }
 
             VkRenderPass GetRenderPass(GraphicsPipelineID id) { return _graphicsPipelines[static_cast<gIDType>(id)].renderPass; }
-            VkFramebuffer GetFramebuffer(GraphicsPipelineID id) { return _graphicsPipelines[static_cast<gIDType>(id)].framebuffer; }
+            VkFramebuffer GetFramebuffer(GraphicsPipelineID id) { return _framebuffers[_graphicsPipelines[static_cast<gIDType>(id)].framebufferIndex].framebuffer; }
+
+            // Pipelines with the same key share their render pass and framebuffer, so one can be bound inside the render pass of the other
+            u32 GetRenderPassKey(GraphicsPipelineID id) { return _graphicsPipelines[static_cast<gIDType>(id)].framebufferIndex; }
 
             DescriptorSetLayoutData& GetDescriptorSetLayoutData(GraphicsPipelineID id, u32 index) { return _graphicsPipelines[static_cast<gIDType>(id)].descriptorSetLayoutDatas[index]; }
 
@@ -67,7 +74,7 @@ namespace Renderer
                 VkPipeline pipeline;
 
                 u32 numRenderTargets = 0;
-                VkFramebuffer framebuffer;
+                u32 framebufferIndex = 0; // Into _framebuffers, the render pass is owned by the cache as well
 
                 std::vector<DescriptorSetLayoutData> descriptorSetLayoutDatas;
                 std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
@@ -80,6 +87,30 @@ namespace Renderer
                 DescriptorSetBuilderVK* descriptorSetBuilder;
             };
 
+            // Everything render passes are cached by, it gets hashed so it can't have any padding
+            struct RenderPassCacheDesc
+            {
+                VkFormat colorFormats[MAX_RENDER_TARGETS] = {};
+                VkSampleCountFlagBits colorSampleCounts[MAX_RENDER_TARGETS] = {};
+                VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+                VkSampleCountFlagBits depthSampleCount = VK_SAMPLE_COUNT_1_BIT;
+                VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+                VkAttachmentStoreOp storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+                u32 numRenderTargets = 0;
+                u32 hasDepthStencil = 0;
+            };
+
+            // The images are kept instead of resolving them through the desc again, the RenderGraph that desc came from is long gone when the window is resized
+            struct Framebuffer
+            {
+                ImageID renderTargets[MAX_RENDER_TARGETS] = { ImageID::Invalid(), ImageID::Invalid(), ImageID::Invalid(), ImageID::Invalid(), ImageID::Invalid(), ImageID::Invalid(), ImageID::Invalid(), ImageID::Invalid() };
+                DepthImageID depthStencil = DepthImageID::Invalid();
+                u32 numRenderTargets = 0;
+
+                VkRenderPass renderPass = VK_NULL_HANDLE;
+                VkFramebuffer framebuffer = VK_NULL_HANDLE;
+            };
+
             struct GraphicsPipelineCacheDesc
             {
                 GraphicsPipelineDesc::States states;
@@ -114,7 +145,14 @@ namespace Renderer
             bool TryFindExistingCPipeline(u64 descHash, size_t& id);
             DescriptorSetLayoutData& GetDescriptorSet(i32 setNumber, std::vector<DescriptorSetLayoutData>& sets);
             
-            void CreateFramebuffer(GraphicsPipeline& pipeline);
+            // Returns the index of the framebuffer rendering into the same images, creating it and its render pass if there is none
+            u32 GetOrCreateFramebuffer(Framebuffer& framebuffer);
+            VkRenderPass CreateRenderPass(const RenderPassCacheDesc& desc);
+            void CreateFramebuffer(Framebuffer& framebuffer);
+
+            // Creates pipeline.pipeline from its desc, the layout, render pass and descriptor set layouts have to exist already
+            void CreatePipelineObject(GraphicsPipeline& pipeline);
+            void CreatePipelineObject(ComputePipeline& pipeline);
 
         private:
             RenderDeviceVK* _device;
@@ -123,6 +161,14 @@ namespace Renderer
 
             std::vector<GraphicsPipeline> _graphicsPipelines;
             std::vector<ComputePipeline> _computePipelines;
+
+            // Renderers look their pipelines up by desc every frame, these keep that from scanning every pipeline
+            robin_hood::unordered_map<u64, gIDType> _graphicsPipelineHashToID;
+            robin_hood::unordered_map<u64, cIDType> _computePipelineHashToID;
+
+            robin_hood::unordered_map<u64, VkRenderPass> _renderPasses;
+            std::vector<Framebuffer> _framebuffers;
+            robin_hood::unordered_map<u64, u32> _framebufferHashToIndex;
         };
     }
 }
\ No newline at end of file
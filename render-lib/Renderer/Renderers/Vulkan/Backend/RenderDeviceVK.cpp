@@ -11,6 +11,7 @@
 #include "../../../Descriptors/VertexShaderDesc.h"
 #include "../../../Descriptors/PixelShaderDesc.h"
 #include "DescriptorSetBuilderVK.h"
+#include "../../../RenderStats.h"
 
 #pragma warning (push)
 #pragma warning(disable : 4005)
@@ -1211,11 +1212,13 @@ namespace Renderer
             vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
             EndSingleTimeCommands(commandBuffer);
+
+            NC_RENDER_STAT_ADD(*_renderStats, stagingBytes, range);
         }
 
-        void RenderDeviceVK::CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkFormat format, u32 width, u32 height, u32 numLayers, u32 numMipLevels)
+        void RenderDeviceVK::CopyBufferToImage(VkBuffer srcBuffer, VkDeviceSize srcOffset, VkImage dstImage, VkFormat format, u32 width, u32 height, u32 numLayers, u32 numMipLevels)
         {
-            VkDeviceSize bufferOffset = 0;
+            VkDeviceSize bufferOffset = srcOffset;
 
             VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
 
@@ -18,6 +18,8 @@ namespace tracy
 
 namespace Renderer
 {
+    struct RenderStats;
+
     namespace Backend
     {
         struct SwapChainVK;
@@ -82,7 +84,7 @@ namespace Renderer
             void EndSingleTimeCommands(VkCommandBuffer commandBuffer);
 
             void CopyBuffer(VkBuffer dstBuffer, u64 dstOffset, VkBuffer srcBuffer, u64 srcOffset, u64 range);
-            void CopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkFormat format, u32 width, u32 height, u32 numLayers, u32 numMipLevels);
+            void CopyBufferToImage(VkBuffer srcBuffer, VkDeviceSize srcOffset, VkImage dstImage, VkFormat format, u32 width, u32 height, u32 numLayers, u32 numMipLevels);
             void TransitionImageLayout(VkImage image, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout, u32 numLayers, u32 numMipLevels);
             void TransitionImageLayout(VkCommandBuffer commandBuffer, VkImage image, VkImageAspectFlags aspects, VkImageLayout oldLayout, VkImageLayout newLayout, u32 numLayers, u32 numMipLevels);
 
@@ -111,6 +113,7 @@ namespace Renderer
             DescriptorMegaPoolVK* _descriptorMegaPool;
 
             tracy::VkCtx* _tracyContext = nullptr;
+            RenderStats* _renderStats = nullptr; // Points at the frame stats of the owning renderer, immediate uploads count towards them
             struct ImguiContext* _imguiContext = nullptr;
             friend class RendererVK;
             friend class BufferHandlerVK;
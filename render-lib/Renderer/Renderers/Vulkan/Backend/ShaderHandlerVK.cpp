@@ -8,24 +8,190 @@ namespace Renderer
 {
     namespace Backend
     {
+        static bool IsSameLayout(const BindReflection& a, const BindReflection& b)
+        {
+            if (a.dataBindings.size() != b.dataBindings.size() || a.pushConstants.size() != b.pushConstants.size())
+                return false;
+
+            for (size_t i = 0; i < a.dataBindings.size(); i++)
+            {
+                const BindInfo& bindA = a.dataBindings[i];
+                const BindInfo& bindB = b.dataBindings[i];
+
+                if (bindA.nameHash != bindB.nameHash || bindA.descriptorType != bindB.descriptorType || bindA.set != bindB.set || bindA.binding != bindB.binding || bindA.count != bindB.count)
+                    return false;
+            }
+
+            for (size_t i = 0; i < a.pushConstants.size(); i++)
+            {
+                if (a.pushConstants[i].offset != b.pushConstants[i].offset || a.pushConstants[i].size != b.pushConstants[i].size)
+                    return false;
+            }
+
+            return true;
+        }
+
         void ShaderHandlerVK::Init(RenderDeviceVK* device)
         {
             _device = device;
         }
 
+        bool ShaderHandlerVK::InitCache(const ShaderCacheDesc& desc)
+        {
+            if (!_cache.Init(desc))
+            {
+                NC_LOG_WARNING("Shader sources not found in %s, shaders won't be reloaded", desc.sourceDirectory.c_str());
+                return false;
+            }
+
+            return true;
+        }
+
         VertexShaderID ShaderHandlerVK::LoadShader(const VertexShaderDesc& desc)
         {
-            return LoadShader<VertexShaderID>(desc.path, _vertexShaders);
+            return LoadShader<VertexShaderID>(desc.path, _vertexShaders, _vertexShaderPathHashToID);
         }
 
         PixelShaderID ShaderHandlerVK::LoadShader(const PixelShaderDesc& desc)
         {
-            return LoadShader<PixelShaderID>(desc.path, _pixelShaders);
+            return LoadShader<PixelShaderID>(desc.path, _pixelShaders, _pixelShaderPathHashToID);
         }
 
         ComputeShaderID ShaderHandlerVK::LoadShader(const ComputeShaderDesc& desc)
         {
-            return LoadShader<ComputeShaderID>(desc.path, _computeShaders);
+            return LoadShader<ComputeShaderID>(desc.path, _computeShaders, _computeShaderPathHashToID);
+        }
+
+        void ShaderHandlerVK::ReloadShaders(ReloadedShaders& reloadedShaders)
+        {
+            std::vector<std::filesystem::path> changedSources;
+            _cache.GetChangedShaders(changedSources);
+
+            if (changedSources.empty())
+                return;
+
+            ReloadShaders(_vertexShaders, changedSources, reloadedShaders.vertexShaders);
+            ReloadShaders(_pixelShaders, changedSources, reloadedShaders.pixelShaders);
+            ReloadShaders(_computeShaders, changedSources, reloadedShaders.computeShaders);
+        }
+
+        void ShaderHandlerVK::ReadShader(Shader& shader)
+        {
+            if (_cache.IsEnabled() && _cache.FindSource(shader.path, shader.sourcePath))
+            {
+                // The cache only has a binary if this version of the source was recompiled at runtime, otherwise the build output is current
+                if (_cache.Load(shader.sourcePath, shader.spirv))
+                    return;
+            }
+
+            ReadFile(shader.path, shader.spirv);
+        }
+
+        void ShaderHandlerVK::CreateShader(Shader& shader)
+        {
+            shader.module = CreateShaderModule(shader.spirv);
+            shader.bindReflection.dataBindings.clear();
+            shader.bindReflection.pushConstants.clear();
+
+            // Reflect descriptor sets
+            SpvReflectShaderModule reflectModule;
+            SpvReflectResult result = spvReflectCreateShaderModule(shader.spirv.size(), shader.spirv.data(), &reflectModule);
+
+            if (result != SPV_REFLECT_RESULT_SUCCESS)
+            {
+                NC_LOG_FATAL("We failed to reflect the spirv of %s", shader.path.c_str());
+            }
+
+            uint32_t descriptorSetCount = 0;
+            result = spvReflectEnumerateDescriptorSets(&reflectModule, &descriptorSetCount, NULL);
+
+            if (result != SPV_REFLECT_RESULT_SUCCESS)
+            {
+                NC_LOG_FATAL("We failed to reflect the spirv descriptor set count of %s", shader.path.c_str());
+            }
+
+            
+            if (descriptorSetCount > 0)
+            {
+                std::vector<SpvReflectDescriptorSet*> descriptorSets(descriptorSetCount);
+                
+                result = spvReflectEnumerateDescriptorSets(&reflectModule, &descriptorSetCount, descriptorSets.data());
+
+                if (result != SPV_REFLECT_RESULT_SUCCESS)
+                {
+                    NC_LOG_FATAL("We failed to reflect the spirv descriptor sets of %s", shader.path.c_str());
+                }
+
+                for (auto* descriptorSet : descriptorSets)
+                {
+                    for (uint32_t binding = 0; binding < descriptorSet->binding_count; binding++)
+                    {
+                        const SpvReflectDescriptorBinding* reflectionBinding = descriptorSet->bindings[binding];
+                        BindInfo bindInfo;
+                        bindInfo.descriptorType = static_cast<VkDescriptorType>(reflectionBinding->descriptor_type);
+                        bindInfo.set = descriptorSet->set;
+                        bindInfo.binding = reflectionBinding->binding;
+                        bindInfo.count = reflectionBinding->count;
+                        bindInfo.stageFlags = static_cast<VkShaderStageFlagBits>(reflectModule.shader_stage);
+
+                        bindInfo.name = reflectionBinding->name;
+                        bindInfo.nameHash = StringUtils::fnv1a_32(bindInfo.name.c_str(), bindInfo.name.length());
+
+                        shader.bindReflection.dataBindings.push_back(bindInfo);
+                    }
+                }
+            }
+
+            uint32_t pushConstantCount = 0;
+            result = spvReflectEnumeratePushConstantBlocks(&reflectModule, &pushConstantCount, NULL);
+
+            if (result != SPV_REFLECT_RESULT_SUCCESS)
+            {
+                NC_LOG_FATAL("We failed to reflect the spirv push constant count of %s", shader.path.c_str());
+            }
+
+            if (pushConstantCount > 0)
+            {
+                std::vector<SpvReflectBlockVariable*> blockVariables(pushConstantCount);
+
+                result = spvReflectEnumeratePushConstantBlocks(&reflectModule, &pushConstantCount, blockVariables.data());
+
+                for (SpvReflectBlockVariable* variable : blockVariables)
+                {
+                    BindInfoPushConstant& pushConstant = shader.bindReflection.pushConstants.emplace_back();
+                    pushConstant.offset = variable->offset;
+                    pushConstant.size = variable->size;
+                    pushConstant.stageFlags = static_cast<VkShaderStageFlagBits>(reflectModule.shader_stage);
+                }
+            }
+
+            spvReflectDestroyShaderModule(&reflectModule);
+        }
+
+        bool ShaderHandlerVK::ReloadShader(Shader& shader)
+        {
+            Shader reloadedShader;
+            reloadedShader.path = shader.path;
+            reloadedShader.sourcePath = shader.sourcePath;
+
+            if (!_cache.Compile(shader.sourcePath, reloadedShader.spirv))
+                return false;
+
+            CreateShader(reloadedShader);
+
+            // Pipeline layouts and descriptor sets are built from the reflection, those are not recreated
+            if (!IsSameLayout(shader.bindReflection, reloadedShader.bindReflection))
+            {
+                NC_LOG_WARNING("%s changed its bindings, restart to use the new version", shader.path.c_str());
+                vkDestroyShaderModule(_device->_device, reloadedShader.module, nullptr);
+                return false;
+            }
+
+            vkDestroyShaderModule(_device->_device, shader.module, nullptr);
+            shader = std::move(reloadedShader);
+
+            NC_LOG_SUCCESS("Reloaded %s", shader.path.c_str());
+            return true;
         }
 
         void ShaderHandlerVK::ReadFile(const std::string& filename, ShaderBinary& binary)
@@ -61,22 +227,5 @@ namespace Renderer
 
             return shaderModule;
         }
-
-        bool ShaderHandlerVK::TryFindExistingShader(const std::string& shaderPath, std::vector<Shader>& shaders, size_t& id)
-        {
-            u32 shaderPathHash = StringUtils::fnv1a_32(shaderPath.c_str(), shaderPath.length());
-
-            id = 0;
-            for (Shader& existingShader : shaders)
-            {
-                if (StringUtils::fnv1a_32(existingShader.path.c_str(), existingShader.path.length()) == shaderPathHash)
-                {
-                    return true;
-                }
-                id++;
-            }
-
-            return false;
-        }
     }
 }
\ No newline at end of file
@@ -1,14 +1,19 @@
 #pragma once
 #include <NovusTypes.h>
 #include <vulkan/vulkan.h>
+#include <robin_hood.h>
+#include <algorithm>
+#include <filesystem>
 #include <vector>
 #include <unordered_map>
 #include <cassert>
 #include "../../../Descriptors/VertexShaderDesc.h"
 #include "../../../Descriptors/PixelShaderDesc.h"
 #include "../../../Descriptors/ComputeShaderDesc.h"
+#include "../../../ShaderCache.h"
 #include "SpirvReflect.h"
 #include <Utils/DebugHandler.h>
+#include <Utils/StringUtils.h>
 
 namespace Renderer
 {
@@ -43,6 +48,16 @@ namespace Renderer
             std::vector<BindInfoPushConstant> pushConstants;
         };
 
+        // The shaders ShaderHandlerVK::ReloadShaders swapped, every pipeline using one of them has to be recreated
+        struct ReloadedShaders
+        {
+            std::vector<VertexShaderID> vertexShaders;
+            std::vector<PixelShaderID> pixelShaders;
+            std::vector<ComputeShaderID> computeShaders;
+
+            bool IsEmpty() const { return vertexShaders.empty() && pixelShaders.empty() && computeShaders.empty(); }
+        };
+
         class ShaderHandlerVK
         {
             using vsIDType = type_safe::underlying_type<VertexShaderID>;
@@ -52,10 +67,17 @@ namespace Renderer
         public:
             void Init(RenderDeviceVK* device);
 
+            // Shaders with a source under desc.sourceDirectory are loaded from the shader cache when it has a newer build of them
+            bool InitCache(const ShaderCacheDesc& desc);
+            ShaderCache& GetCache() { return _cache; }
+
             VertexShaderID LoadShader(const VertexShaderDesc& desc);
             PixelShaderID LoadShader(const PixelShaderDesc& desc);
             ComputeShaderID LoadShader(const ComputeShaderDesc& desc);
 
+            // Recompiles every loaded shader whose source or includes changed and swaps in the new modules, the GPU has to be idle
+            void ReloadShaders(ReloadedShaders& reloadedShaders);
+
             VkShaderModule GetShaderModule(const VertexShaderID id) { return _vertexShaders[static_cast<vsIDType>(id)].module; }
             VkShaderModule GetShaderModule(const PixelShaderID id) { return _pixelShaders[static_cast<psIDType>(id)].module; }
             VkShaderModule GetShaderModule(const ComputeShaderID id) { return _computeShaders[static_cast<csIDType>(id)].module; }
@@ -70,13 +92,14 @@ namespace Renderer
             }
             const BindReflection& GetBindReflection(const ComputeShaderID id)
             {
-                return _computeShaders[static_cast<psIDType>(id)].bindReflection;
+                return _computeShaders[static_cast<csIDType>(id)].bindReflection;
             }
 
         private:
             struct Shader
             {
                 std::string path;
+                std::filesystem::path sourcePath; // Empty if the shader cache doesn't know the source
                 VkShaderModule module;
                 ShaderBinary spirv;
 
@@ -85,111 +108,69 @@ namespace Renderer
 
         private:
             template <typename T>
-            T LoadShader(const std::string& shaderPath, std::vector<Shader>& shaders)
+            T LoadShader(const std::string& shaderPath, std::vector<Shader>& shaders, robin_hood::unordered_map<u32, u32>& pathHashToID)
             {
-                size_t id;
                 using idType = type_safe::underlying_type<T>;
 
                 // If shader is already loaded, return ID of already loaded version
-                if (TryFindExistingShader(shaderPath, shaders, id))
+                u32 shaderPathHash = StringUtils::fnv1a_32(shaderPath.c_str(), shaderPath.length());
+
+                auto iterator = pathHashToID.find(shaderPathHash);
+                if (iterator != pathHashToID.end())
                 {
-                    return T(static_cast<idType>(id));
+                    return T(static_cast<idType>(iterator->second));
                 }
 
-                id = shaders.size();
+                size_t id = shaders.size();
                 assert(id < T::MaxValue());
 
-                shaders.emplace_back();
-                Shader& shader = shaders.back();
-                ReadFile(shaderPath, shader.spirv);
+                Shader& shader = shaders.emplace_back();
                 shader.path = shaderPath;
-                shader.module = CreateShaderModule(shader.spirv);
+                ReadShader(shader);
+                CreateShader(shader);
 
-                // Reflect descriptor sets
-                SpvReflectShaderModule reflectModule;
-                SpvReflectResult result = spvReflectCreateShaderModule(shader.spirv.size(), shader.spirv.data(), &reflectModule);
-
-                if (result != SPV_REFLECT_RESULT_SUCCESS)
-                {
-                    NC_LOG_FATAL("We failed to reflect the spirv of %s", shaderPath.c_str());
-                }
-
-                uint32_t descriptorSetCount = 0;
-                result = spvReflectEnumerateDescriptorSets(&reflectModule, &descriptorSetCount, NULL);
+                pathHashToID[shaderPathHash] = static_cast<u32>(id);
+                return T(static_cast<idType>(id));
+            }
 
-                if (result != SPV_REFLECT_RESULT_SUCCESS)
-                {
-                    NC_LOG_FATAL("We failed to reflect the spirv descriptor set count of %s", shaderPath.c_str());
-                }
+            template <typename T>
+            void ReloadShaders(std::vector<Shader>& shaders, const std::vector<std::filesystem::path>& changedSources, std::vector<T>& reloadedIDs)
+            {
+                using idType = type_safe::underlying_type<T>;
 
-                
-                if (descriptorSetCount > 0)
+                for (size_t i = 0; i < shaders.size(); i++)
                 {
-                    std::vector<SpvReflectDescriptorSet*> descriptorSets(descriptorSetCount);
-                    
-                    result = spvReflectEnumerateDescriptorSets(&reflectModule, &descriptorSetCount, descriptorSets.data());
+                    Shader& shader = shaders[i];
+                    if (shader.sourcePath.empty() || std::find(changedSources.begin(), changedSources.end(), shader.sourcePath) == changedSources.end())
+                        continue;
 
-                    if (result != SPV_REFLECT_RESULT_SUCCESS)
+                    if (ReloadShader(shader))
                     {
-                        NC_LOG_FATAL("We failed to reflect the spirv descriptor sets of %s", shaderPath.c_str());
-                    }
-
-                    for (auto* descriptorSet : descriptorSets)
-                    {
-                        for (uint32_t binding = 0; binding < descriptorSet->binding_count; binding++)
-                        {
-                            const SpvReflectDescriptorBinding* reflectionBinding = descriptorSet->bindings[binding];
-                            BindInfo bindInfo;
-                            bindInfo.descriptorType = static_cast<VkDescriptorType>(reflectionBinding->descriptor_type);
-                            bindInfo.set = descriptorSet->set;
-                            bindInfo.binding = reflectionBinding->binding;
-                            bindInfo.count = reflectionBinding->count;
-                            bindInfo.stageFlags = static_cast<VkShaderStageFlagBits>(reflectModule.shader_stage);
-
-                            bindInfo.name = reflectionBinding->name;
-                            bindInfo.nameHash = StringUtils::fnv1a_32(bindInfo.name.c_str(), bindInfo.name.length());
-
-                            shader.bindReflection.dataBindings.push_back(bindInfo);
-                        }
+                        reloadedIDs.push_back(T(static_cast<idType>(i)));
                     }
                 }
+            }
 
-                uint32_t pushConstantCount = 0;
-                result = spvReflectEnumeratePushConstantBlocks(&reflectModule, &pushConstantCount, NULL);
-
-                if (result != SPV_REFLECT_RESULT_SUCCESS)
-                {
-                    NC_LOG_FATAL("We failed to reflect the spirv push constant count of %s", shaderPath.c_str());
-                }
-
-                if (pushConstantCount > 0)
-                {
-                    std::vector<SpvReflectBlockVariable*> blockVariables(pushConstantCount);
-
-                    result = spvReflectEnumeratePushConstantBlocks(&reflectModule, &pushConstantCount, blockVariables.data());
+            // Reads the SPIR-V from the shader cache if it has it and from shader.path otherwise
+            void ReadShader(Shader& shader);
+            // Creates the module and reflects its bindings from shader.spirv
+            void CreateShader(Shader& shader);
+            bool ReloadShader(Shader& shader);
 
-                    for (SpvReflectBlockVariable* variable : blockVariables)
-                    {
-                        BindInfoPushConstant& pushConstant = shader.bindReflection.pushConstants.emplace_back();
-                        pushConstant.offset = variable->offset;
-                        pushConstant.size = variable->size;
-                        pushConstant.stageFlags = static_cast<VkShaderStageFlagBits>(reflectModule.shader_stage);
-                    }
-                }
-                
-                return T(static_cast<idType>(id));
-            }
-            
             void ReadFile(const std::string& filename, ShaderBinary& binary);
             VkShaderModule CreateShaderModule(const ShaderBinary& binary);
-            bool TryFindExistingShader(const std::string& shaderPath, std::vector<Shader>& shaders, size_t& id);
 
         private:
             RenderDeviceVK* _device;
+            ShaderCache _cache;
 
             std::vector<Shader> _vertexShaders;
             std::vector<Shader> _pixelShaders;
             std::vector<Shader> _computeShaders;
+
+            robin_hood::unordered_map<u32, u32> _vertexShaderPathHashToID;
+            robin_hood::unordered_map<u32, u32> _pixelShaderPathHashToID;
+            robin_hood::unordered_map<u32, u32> _computeShaderPathHashToID;
         };
     }
 }
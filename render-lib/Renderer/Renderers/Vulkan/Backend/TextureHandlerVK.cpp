@@ -7,6 +7,7 @@
 #include "DebugMarkerUtilVK.h"
 #include <gli/gli.hpp>
 #include "BufferHandlerVK.h"
+#include "../../../RenderStats.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -308,10 +309,9 @@ namespace Renderer
             bufferDesc.cpuAccess = BufferCPUAccess::WriteOnly;
             BufferID stagingBuffer = _bufferHandler->CreateBuffer(bufferDesc);
 
-            void* data;
-            vmaMapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(stagingBuffer), &data);
+            void* data = _bufferHandler->MapBuffer(stagingBuffer);
             memcpy(data, pixels, texture.fileSize);
-            vmaUnmapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(stagingBuffer));
+            _bufferHandler->UnmapBuffer(stagingBuffer);
 
             delete[] pixels;
 
@@ -335,16 +335,19 @@ namespace Renderer
             VmaAllocationCreateInfo allocInfo = {};
             allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 
-            if (vmaCreateImage(_device->_allocator, &imageInfo, &allocInfo, &texture.image, &texture.allocation, nullptr) != VK_SUCCESS)
+            VmaAllocationInfo allocationInfo;
+            if (vmaCreateImage(_device->_allocator, &imageInfo, &allocInfo, &texture.image, &texture.allocation, &allocationInfo) != VK_SUCCESS)
             {
                 NC_LOG_FATAL("Failed to create image!");
             }
+            NC_RENDER_TRACK_ALLOC(texture.allocation, allocationInfo.size, MemoryPools::Textures);
 
             DebugMarkerUtilVK::SetObjectName(_device->_device, (u64)texture.image, VK_DEBUG_REPORT_OBJECT_TYPE_IMAGE_EXT, texture.debugName.c_str());
 
             // Copy data from stagingBuffer into image
             _device->TransitionImageLayout(texture.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, texture.layers, texture.mipLevels);
-            _device->CopyBufferToImage(_bufferHandler->GetBuffer(stagingBuffer), texture.image, texture.format, static_cast<u32>(texture.width), static_cast<u32>(texture.height), texture.layers, texture.mipLevels);
+            _device->CopyBufferToImage(_bufferHandler->GetBuffer(stagingBuffer), _bufferHandler->GetBufferOffset(stagingBuffer), texture.image, texture.format, static_cast<u32>(texture.width), static_cast<u32>(texture.height), texture.layers, texture.mipLevels);
+            NC_RENDER_STAT_ADD(*_device->_renderStats, stagingBytes, bufferDesc.size);
             _device->TransitionImageLayout(texture.image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texture.layers, texture.mipLevels);
 
             _bufferHandler->DestroyBuffer(stagingBuffer);
@@ -40,6 +40,7 @@ namespace Renderer
         _semaphoreHandler = new Backend::SemaphoreHandlerVK();
 
         // Init
+        _device->_renderStats = &_frameStats;
         _device->Init();
         _bufferHandler->Init(_device);
         _imageHandler->Init(_device);
@@ -63,8 +64,8 @@ namespace Renderer
     {
         _device->FlushGPU(); // Make sure it has finished rendering
 
+        delete(_bufferHandler); // Destroys the buffer pool pages through the device's allocator, so it has to go first
         delete(_device);
-        delete(_bufferHandler);
         delete(_imageHandler);
         delete(_textureHandler);
         delete(_modelHandler);
@@ -107,14 +108,21 @@ namespace Renderer
 
     GraphicsPipelineID RendererVK::CreatePipeline(GraphicsPipelineDesc& desc)
     {
+        NC_RENDER_STAT_ADD(_frameStats, pipelineLookups, 1);
         return _pipelineHandler->CreatePipeline(desc);
     }
 
     ComputePipelineID RendererVK::CreatePipeline(ComputePipelineDesc& desc)
     {
+        NC_RENDER_STAT_ADD(_frameStats, pipelineLookups, 1);
         return _pipelineHandler->CreatePipeline(desc);
     }
 
+    u32 RendererVK::GetRenderPassKey(GraphicsPipelineID pipeline)
+    {
+        return _pipelineHandler->GetRenderPassKey(pipeline);
+    }
+
     ModelID RendererVK::CreatePrimitiveModel(PrimitiveModelDesc& desc)
     {
         return _modelHandler->CreatePrimitiveModel(desc);
@@ -175,6 +183,29 @@ namespace Renderer
         return _shaderHandler->LoadShader(desc);
     }
 
+    bool RendererVK::InitShaderCache(const ShaderCacheDesc& desc)
+    {
+        return _shaderHandler->InitCache(desc);
+    }
+
+    u32 RendererVK::ReloadShaders()
+    {
+        // The old modules and pipelines may still be in use by frames in flight
+        _device->FlushGPU();
+
+        Backend::ReloadedShaders reloadedShaders;
+        _shaderHandler->ReloadShaders(reloadedShaders);
+
+        if (reloadedShaders.IsEmpty())
+            return 0;
+
+        u32 numPipelines = _pipelineHandler->RecreatePipelines(reloadedShaders);
+        u32 numShaders = static_cast<u32>(reloadedShaders.vertexShaders.size() + reloadedShaders.pixelShaders.size() + reloadedShaders.computeShaders.size());
+
+        NC_LOG_MESSAGE("Reloaded %u shaders and recreated %u pipelines", numShaders, numPipelines);
+        return numShaders;
+    }
+
     void RendererVK::FlipFrame(u32 /*frameIndex*/)
     {
         ZoneScopedC(tracy::Color::Red3);
@@ -318,7 +349,7 @@ namespace Renderer
         {
             // Bind index buffer
             VkBuffer indexBuffer = _modelHandler->GetIndexBuffer(modelID);
-            vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+            vkCmdBindIndexBuffer(commandBuffer, indexBuffer, _modelHandler->GetIndexBufferOffset(modelID), VK_INDEX_TYPE_UINT32);
 
             _boundModelIndexBuffer = modelID;
         }
@@ -349,8 +380,9 @@ namespace Renderer
         }
 
         VkBuffer vkArgumentBuffer = _bufferHandler->GetBuffer(argumentBuffer);
+        VkDeviceSize vkArgumentBufferOffset = _bufferHandler->GetBufferOffset(argumentBuffer) + argumentBufferOffset;
 
-        vkCmdDrawIndexedIndirect(commandBuffer, vkArgumentBuffer, argumentBufferOffset, drawCount, sizeof(VkDrawIndexedIndirectCommand));
+        vkCmdDrawIndexedIndirect(commandBuffer, vkArgumentBuffer, vkArgumentBufferOffset, drawCount, sizeof(VkDrawIndexedIndirectCommand));
     }
 
     void RendererVK::DrawIndexedIndirectCount(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset, BufferID drawCountBuffer, u32 drawCountBufferOffset, u32 maxDrawCount)
@@ -363,9 +395,11 @@ namespace Renderer
         }
 
         VkBuffer vkArgumentBuffer = _bufferHandler->GetBuffer(argumentBuffer);
+        VkDeviceSize vkArgumentBufferOffset = _bufferHandler->GetBufferOffset(argumentBuffer) + argumentBufferOffset;
         VkBuffer vkDrawCountBuffer = _bufferHandler->GetBuffer(drawCountBuffer);
+        VkDeviceSize vkDrawCountBufferOffset = _bufferHandler->GetBufferOffset(drawCountBuffer) + drawCountBufferOffset;
 
-        vkCmdDrawIndexedIndirectCount(commandBuffer, vkArgumentBuffer, argumentBufferOffset, vkDrawCountBuffer, drawCountBufferOffset, maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
+        vkCmdDrawIndexedIndirectCount(commandBuffer, vkArgumentBuffer, vkArgumentBufferOffset, vkDrawCountBuffer, vkDrawCountBufferOffset, maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
     }
 
     void RendererVK::Dispatch(CommandListID commandListID, u32 threadGroupCountX, u32 threadGroupCountY, u32 threadGroupCountZ)
@@ -379,8 +413,9 @@ namespace Renderer
     {
         VkCommandBuffer commandBuffer = _commandListHandler->GetCommandBuffer(commandListID);
         VkBuffer vkArgumentBuffer = _bufferHandler->GetBuffer(argumentBuffer);
+        VkDeviceSize vkArgumentBufferOffset = _bufferHandler->GetBufferOffset(argumentBuffer) + argumentBufferOffset;
 
-        vkCmdDispatchIndirect(commandBuffer, vkArgumentBuffer, argumentBufferOffset);
+        vkCmdDispatchIndirect(commandBuffer, vkArgumentBuffer, vkArgumentBufferOffset);
     }
 
     void RendererVK::PopMarker(CommandListID commandListID)
@@ -395,14 +430,11 @@ namespace Renderer
         Backend::DebugMarkerUtilVK::PushMarker(commandBuffer, color, name);
     }
 
-    void RendererVK::BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipelineID)
+    void RendererVK::BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipelineID, bool beginRenderPass)
     {
         VkCommandBuffer commandBuffer = _commandListHandler->GetCommandBuffer(commandListID);
 
-        GraphicsPipelineDesc pipelineDesc = _pipelineHandler->GetDescriptor(pipelineID);
         VkPipeline pipeline = _pipelineHandler->GetPipeline(pipelineID);
-        VkRenderPass renderPass = _pipelineHandler->GetRenderPass(pipelineID);
-        VkFramebuffer frameBuffer = _pipelineHandler->GetFramebuffer(pipelineID);
 
         if (_renderPassOpenCount != 0)
         {
@@ -410,18 +442,25 @@ namespace Renderer
         }
         _renderPassOpenCount++;
 
-        uvec2 renderSize = _device->GetMainWindowSize();
+        // If the previous pipeline rendered into the same framebuffer its render pass was left open for us
+        if (beginRenderPass)
+        {
+            VkRenderPass renderPass = _pipelineHandler->GetRenderPass(pipelineID);
+            VkFramebuffer frameBuffer = _pipelineHandler->GetFramebuffer(pipelineID);
 
-        // Set up renderpass
-        VkRenderPassBeginInfo renderPassInfo = {};
-        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPass;
-        renderPassInfo.framebuffer = frameBuffer;
-        renderPassInfo.renderArea.offset = { 0, 0 };
-        renderPassInfo.renderArea.extent = { renderSize.x, renderSize.y };
+            uvec2 renderSize = _device->GetMainWindowSize();
 
-        // Start renderpass
-        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+            // Set up renderpass
+            VkRenderPassBeginInfo renderPassInfo = {};
+            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            renderPassInfo.renderPass = renderPass;
+            renderPassInfo.framebuffer = frameBuffer;
+            renderPassInfo.renderArea.offset = { 0, 0 };
+            renderPassInfo.renderArea.extent = { renderSize.x, renderSize.y };
+
+            // Start renderpass
+            vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        }
 
         // Bind pipeline
         vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
@@ -432,7 +471,7 @@ namespace Renderer
         _boundModelIndexBuffer = ModelID::Invalid();
     }
 
-    void RendererVK::EndPipeline(CommandListID commandListID, GraphicsPipelineID /*pipelineID*/)
+    void RendererVK::EndPipeline(CommandListID commandListID, GraphicsPipelineID /*pipelineID*/, bool endRenderPass)
     {
         VkCommandBuffer commandBuffer = _commandListHandler->GetCommandBuffer(commandListID);
 
@@ -442,7 +481,10 @@ namespace Renderer
         }
         _renderPassOpenCount--;
 
-        vkCmdEndRenderPass(commandBuffer);
+        if (endRenderPass)
+        {
+            vkCmdEndRenderPass(commandBuffer);
+        }
     }
 
     void RendererVK::SetPipeline(CommandListID commandListID, ComputePipelineID pipelineID)
@@ -488,7 +530,7 @@ namespace Renderer
 
         // Bind vertex buffer
         VkBuffer vertexBuffer = _bufferHandler->GetBuffer(bufferID);
-        VkDeviceSize offsets[] = { 0 };
+        VkDeviceSize offsets[] = { _bufferHandler->GetBufferOffset(bufferID) };
         vkCmdBindVertexBuffers(commandBuffer, slot, 1, &vertexBuffer, offsets);
     }
 
@@ -498,7 +540,7 @@ namespace Renderer
 
         // Bind index buffer
         VkBuffer indexBuffer = _bufferHandler->GetBuffer(bufferID);
-        vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, Backend::FormatConverterVK::ToVkIndexType(indexFormat));
+        vkCmdBindIndexBuffer(commandBuffer, indexBuffer, _bufferHandler->GetBufferOffset(bufferID), Backend::FormatConverterVK::ToVkIndexType(indexFormat));
     }
 
     void RendererVK::SetBuffer(CommandListID commandListID, u32 slot, BufferID buffer)
@@ -507,7 +549,7 @@ namespace Renderer
 
         // Bind buffer
         VkBuffer vkBuffer = _bufferHandler->GetBuffer(buffer);
-        VkDeviceSize offsets[] = { 0 };
+        VkDeviceSize offsets[] = { _bufferHandler->GetBufferOffset(buffer) };
         vkCmdBindVertexBuffers(commandBuffer, slot, 1, &vkBuffer, offsets);
     }
 
@@ -618,6 +660,7 @@ namespace Renderer
         {
             VkDescriptorBufferInfo bufferInfo = {};
             bufferInfo.buffer = _bufferHandler->GetBuffer(descriptor.bufferID);
+            bufferInfo.offset = _bufferHandler->GetBufferOffset(descriptor.bufferID);
             bufferInfo.range = _bufferHandler->GetBufferSize(descriptor.bufferID);
 
             builder->BindBuffer(descriptor.nameHash, bufferInfo);
@@ -771,8 +814,8 @@ namespace Renderer
         VkBuffer vkSrcBuffer = _bufferHandler->GetBuffer(srcBuffer);
 
         VkBufferCopy copyRegion = {};
-        copyRegion.srcOffset = srcOffset;
-        copyRegion.dstOffset = dstOffset;
+        copyRegion.srcOffset = _bufferHandler->GetBufferOffset(srcBuffer) + srcOffset;
+        copyRegion.dstOffset = _bufferHandler->GetBufferOffset(dstBuffer) + dstOffset;
         copyRegion.size = range;
         vkCmdCopyBuffer(commandBuffer, vkSrcBuffer, vkDstBuffer, 1, &copyRegion);
     }
@@ -786,7 +829,8 @@ namespace Renderer
 
         VkBufferMemoryBarrier bufferBarrier = { VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER };
         bufferBarrier.buffer = _bufferHandler->GetBuffer(buffer);
-        bufferBarrier.size = VK_WHOLE_SIZE;
+        bufferBarrier.offset = _bufferHandler->GetBufferOffset(buffer);
+        bufferBarrier.size = _bufferHandler->GetBufferSize(buffer);
 
         switch (type)
         {
@@ -1011,25 +1055,24 @@ namespace Renderer
     {
         VkBuffer vkDstBuffer = _bufferHandler->GetBuffer(dstBuffer);
         VkBuffer vkSrcBuffer = _bufferHandler->GetBuffer(srcBuffer);
-        _device->CopyBuffer(vkDstBuffer, dstOffset, vkSrcBuffer, srcOffset, range);
+        _device->CopyBuffer(vkDstBuffer, _bufferHandler->GetBufferOffset(dstBuffer) + dstOffset, vkSrcBuffer, _bufferHandler->GetBufferOffset(srcBuffer) + srcOffset, range);
 
         DestroyObjects(_destroyLists[_destroyListIndex]);
     }
 
     void* RendererVK::MapBuffer(BufferID buffer)
     {
-        void* mappedMemory;
-        if (vmaMapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(buffer), &mappedMemory) != VK_SUCCESS)
-        {
-            NC_LOG_ERROR("vmaMapMemory failed!\n");
-            return nullptr;
-        }
-        return mappedMemory;
+        return _bufferHandler->MapBuffer(buffer);
     }
     
     void RendererVK::UnmapBuffer(BufferID buffer)
     {
-        vmaUnmapMemory(_device->_allocator, _bufferHandler->GetBufferAllocation(buffer));
+        _bufferHandler->UnmapBuffer(buffer);
+    }
+
+    BufferPoolStats RendererVK::GetBufferPoolStats(BufferCPUAccess cpuAccess) const
+    {
+        return _bufferHandler->GetPoolStats(cpuAccess);
     }
 
     void RendererVK::InitImgui()
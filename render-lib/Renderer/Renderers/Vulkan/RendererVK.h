@@ -45,6 +45,8 @@ namespace Renderer
         GraphicsPipelineID CreatePipeline(GraphicsPipelineDesc& desc) override;
         ComputePipelineID CreatePipeline(ComputePipelineDesc& desc) override;
 
+        u32 GetRenderPassKey(GraphicsPipelineID pipeline) override;
+
         ModelID CreatePrimitiveModel(PrimitiveModelDesc& desc) override;
         void UpdatePrimitiveModel(ModelID modelID, PrimitiveModelDesc& desc) override;
 
@@ -65,6 +67,9 @@ namespace Renderer
         PixelShaderID LoadShader(PixelShaderDesc& desc) override;
         ComputeShaderID LoadShader(ComputeShaderDesc& desc) override;
 
+        bool InitShaderCache(const ShaderCacheDesc& desc) override;
+        u32 ReloadShaders() override;
+
         void FlipFrame(u32 frameIndex) override;
 
         // Command List Functions
@@ -82,8 +87,8 @@ namespace Renderer
         void DispatchIndirect(CommandListID commandListID, BufferID argumentBuffer, u32 argumentBufferOffset) override;
         void PopMarker(CommandListID commandListID) override;
         void PushMarker(CommandListID commandListID, Color color, std::string name) override;
-        void BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipeline) override;
-        void EndPipeline(CommandListID commandListID, GraphicsPipelineID pipeline) override;
+        void BeginPipeline(CommandListID commandListID, GraphicsPipelineID pipeline, bool beginRenderPass) override;
+        void EndPipeline(CommandListID commandListID, GraphicsPipelineID pipeline, bool endRenderPass) override;
         void SetPipeline(CommandListID commandListID, ComputePipelineID pipeline) override;
         void SetScissorRect(CommandListID commandListID, ScissorRect scissorRect) override;
         void SetViewport(CommandListID commandListID, Viewport viewport) override;
@@ -112,6 +117,9 @@ namespace Renderer
         void InitImgui() override;
         void DrawImgui(CommandListID commandListID) override;
 
+        // Stats
+        BufferPoolStats GetBufferPoolStats(BufferCPUAccess cpuAccess) const override;
+
     private:
         bool ReflectDescriptorSet(const std::string& name, u32 nameHash, u32 type, i32& set, const std::vector<Backend::BindInfo>& bindInfos, u32& outBindInfoIndex, VkDescriptorSetLayoutBinding* outDescriptorLayoutBinding);
         void BindDescriptor(Backend::DescriptorSetBuilderVK* builder, void* imageInfosArraysVoid, Descriptor& descriptor, u32 frameIndex);
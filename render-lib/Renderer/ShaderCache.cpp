@@ -0,0 +1,352 @@
+#include "ShaderCache.h"
+#include <Utils/DebugHandler.h>
+#include <Utils/XXHash64.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace Renderer
+{
+    bool ShaderCache::Init(const ShaderCacheDesc& desc)
+    {
+        _files.clear();
+        _shaderNames.clear();
+        _shaderKeys.clear();
+
+        std::error_code errorCode;
+        if (desc.sourceDirectory.empty() || !fs::is_directory(desc.sourceDirectory, errorCode))
+        {
+            _sourceDirectory.clear();
+            return false;
+        }
+
+        _sourceDirectory = fs::path(desc.sourceDirectory).lexically_normal();
+        _cacheDirectory = fs::path(desc.cacheDirectory).lexically_normal();
+        _compilerPath = desc.compilerPath;
+
+        fs::create_directories(_cacheDirectory, errorCode);
+
+        if (!_compiler)
+        {
+            _compiler = [this](const fs::path& sourcePath, const fs::path& outputPath, const fs::path& includeDirectory)
+            {
+                return RunCompiler(sourcePath, outputPath, includeDirectory);
+            };
+        }
+
+        Scan();
+        for (auto& kv : _shaderNames)
+        {
+            _shaderKeys[kv.second] = GetShaderKey(_files[kv.second].path);
+        }
+
+        return true;
+    }
+
+    bool ShaderCache::FindSource(const std::string& shaderPath, fs::path& sourcePath) const
+    {
+        fs::path path = shaderPath;
+        if (path.extension() != ".spv")
+            return false;
+
+        auto iterator = _shaderNames.find(path.stem().string());
+        if (iterator == _shaderNames.end())
+            return false;
+
+        sourcePath = _files.at(iterator->second).path;
+        return true;
+    }
+
+    bool ShaderCache::Load(const fs::path& sourcePath, std::vector<char>& binary)
+    {
+        u64 shaderKey = GetShaderKey(sourcePath);
+        if (shaderKey == 0)
+            return false;
+
+        std::ifstream file(GetCachePath(sourcePath, shaderKey), std::ios::ate | std::ios::binary);
+        if (!file.is_open())
+            return false;
+
+        size_t fileSize = static_cast<size_t>(file.tellg());
+        binary.resize(fileSize);
+
+        file.seekg(0);
+        file.read(binary.data(), fileSize);
+
+        return file.good() && fileSize > 0;
+    }
+
+    bool ShaderCache::Compile(const fs::path& sourcePath, std::vector<char>& binary)
+    {
+        u64 shaderKey = GetShaderKey(sourcePath);
+        if (shaderKey == 0)
+        {
+            NC_LOG_ERROR("Can't compile %s, it isn't in the shader source directory", sourcePath.string().c_str());
+            return false;
+        }
+
+        fs::path cachePath = GetCachePath(sourcePath, shaderKey);
+        fs::path tempPath = cachePath;
+        tempPath += ".tmp";
+
+        std::error_code errorCode;
+        if (!_compiler || !_compiler(sourcePath, tempPath, _sourceDirectory))
+        {
+            NC_LOG_ERROR("Failed to compile %s", sourcePath.string().c_str());
+            fs::remove(tempPath, errorCode);
+            return false;
+        }
+
+        fs::rename(tempPath, cachePath, errorCode);
+        if (errorCode)
+        {
+            NC_LOG_ERROR("Failed to move the compiled %s into the shader cache", sourcePath.string().c_str());
+            return false;
+        }
+
+        // Binaries compiled from older versions of this shader are never loaded again
+        const std::string prefix = sourcePath.filename().string() + ".";
+        const std::string cacheName = cachePath.filename().string();
+        for (const fs::directory_entry& entry : fs::directory_iterator(_cacheDirectory, errorCode))
+        {
+            const std::string name = entry.path().filename().string();
+            if (name != cacheName && name.compare(0, prefix.length(), prefix) == 0 && entry.path().extension() == ".spv")
+            {
+                fs::remove(entry.path(), errorCode);
+            }
+        }
+
+        return Load(sourcePath, binary);
+    }
+
+    void ShaderCache::GetChangedShaders(std::vector<fs::path>& sourcePaths)
+    {
+        if (!IsEnabled() || !Scan())
+            return;
+
+        for (auto& kv : _shaderNames)
+        {
+            const SourceFile& file = _files[kv.second];
+            u64 shaderKey = GetShaderKey(file.path);
+
+            u64& previousKey = _shaderKeys[kv.second];
+            if (previousKey != shaderKey)
+            {
+                previousKey = shaderKey;
+                sourcePaths.push_back(file.path);
+            }
+        }
+    }
+
+    void ShaderCache::GetDependents(const fs::path& path, std::vector<fs::path>& sourcePaths) const
+    {
+        const std::string fileKey = GetFileKey(path);
+
+        std::vector<u64> hashes;
+        std::vector<std::string> visited;
+        for (auto& kv : _shaderNames)
+        {
+            if (kv.second == fileKey)
+                continue;
+
+            hashes.clear();
+            visited.clear();
+            AppendKey(kv.second, hashes, visited);
+
+            if (std::find(visited.begin(), visited.end(), fileKey) != visited.end())
+            {
+                sourcePaths.push_back(_files.at(kv.second).path);
+            }
+        }
+    }
+
+    u64 ShaderCache::GetShaderKey(const fs::path& sourcePath) const
+    {
+        const std::string fileKey = GetFileKey(sourcePath);
+        if (_files.find(fileKey) == _files.end())
+            return 0;
+
+        std::vector<u64> hashes;
+        std::vector<std::string> visited;
+        AppendKey(fileKey, hashes, visited);
+
+        return XXHash64::hash(hashes.data(), hashes.size() * sizeof(u64), VERSION);
+    }
+
+    bool ShaderCache::Scan()
+    {
+        bool changed = false;
+        std::unordered_set<std::string> seen;
+
+        std::error_code errorCode;
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(_sourceDirectory, errorCode))
+        {
+            if (!entry.is_regular_file(errorCode) || entry.path().extension() != ".hlsl")
+                continue;
+
+            const fs::path path = entry.path().lexically_normal();
+            const std::string fileKey = GetFileKey(path);
+            seen.insert(fileKey);
+
+            fs::file_time_type writeTime = entry.last_write_time(errorCode);
+
+            auto iterator = _files.find(fileKey);
+            if (iterator != _files.end() && iterator->second.writeTime == writeTime)
+                continue;
+
+            SourceFile file;
+            file.path = path;
+            file.writeTime = writeTime;
+            file.isShader = path.stem().extension() != ".inc";
+
+            if (!ReadFile(path, file))
+                continue;
+
+            // Saving a file without changing it doesn't count
+            if (iterator == _files.end() || iterator->second.hash != file.hash || iterator->second.includes != file.includes)
+            {
+                changed = true;
+            }
+
+            if (file.isShader)
+            {
+                _shaderNames[path.filename().string()] = fileKey;
+            }
+
+            _files[fileKey] = std::move(file);
+        }
+
+        for (auto iterator = _files.begin(); iterator != _files.end();)
+        {
+            if (seen.find(iterator->first) != seen.end())
+            {
+                iterator++;
+                continue;
+            }
+
+            if (iterator->second.isShader)
+            {
+                _shaderNames.erase(iterator->second.path.filename().string());
+                _shaderKeys.erase(iterator->first);
+            }
+
+            iterator = _files.erase(iterator);
+            changed = true;
+        }
+
+        return changed;
+    }
+
+    bool ShaderCache::ReadFile(const fs::path& path, SourceFile& file) const
+    {
+        std::ifstream stream(path, std::ios::ate | std::ios::binary);
+        if (!stream.is_open())
+            return false;
+
+        std::string source;
+        source.resize(static_cast<size_t>(stream.tellg()));
+
+        stream.seekg(0);
+        stream.read(source.data(), source.size());
+
+        file.hash = XXHash64::hash(source.data(), source.size(), 0);
+
+        // Only quoted includes are followed, that is all the shader cooker resolves
+        size_t lineStart = 0;
+        while (lineStart < source.size())
+        {
+            size_t lineEnd = source.find('\n', lineStart);
+            if (lineEnd == std::string::npos)
+            {
+                lineEnd = source.size();
+            }
+
+            size_t directive = source.find_first_not_of(" \t", lineStart);
+            if (directive < lineEnd && source.compare(directive, 8, "#include") == 0)
+            {
+                size_t nameStart = source.find('"', directive + 8);
+                size_t nameEnd = nameStart < lineEnd ? source.find('"', nameStart + 1) : std::string::npos;
+
+                if (nameEnd < lineEnd)
+                {
+                    std::string include = source.substr(nameStart + 1, nameEnd - nameStart - 1);
+                    file.includes.push_back(GetFileKey(ResolveInclude(path, include)));
+                }
+            }
+
+            lineStart = lineEnd + 1;
+        }
+
+        return true;
+    }
+
+    fs::path ShaderCache::ResolveInclude(const fs::path& includingPath, const std::string& include) const
+    {
+        std::error_code errorCode;
+
+        fs::path path = includingPath.parent_path() / include;
+        if (fs::exists(path, errorCode))
+            return path.lexically_normal();
+
+        return (_sourceDirectory / include).lexically_normal();
+    }
+
+    void ShaderCache::AppendKey(const std::string& fileKey, std::vector<u64>& hashes, std::vector<std::string>& visited) const
+    {
+        // Include guards mean a file only counts once no matter how often it is included
+        if (std::find(visited.begin(), visited.end(), fileKey) != visited.end())
+            return;
+
+        visited.push_back(fileKey);
+
+        auto iterator = _files.find(fileKey);
+        if (iterator == _files.end())
+        {
+            // A missing include still changes the key, it will fail to compile until it exists
+            hashes.push_back(0);
+            return;
+        }
+
+        hashes.push_back(iterator->second.hash);
+        for (const std::string& include : iterator->second.includes)
+        {
+            AppendKey(include, hashes, visited);
+        }
+    }
+
+    fs::path ShaderCache::GetCachePath(const fs::path& sourcePath, u64 shaderKey) const
+    {
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(shaderKey));
+
+        return _cacheDirectory / (sourcePath.filename().string() + "." + key + ".spv");
+    }
+
+    std::string ShaderCache::GetFileKey(const fs::path& path)
+    {
+        return path.lexically_normal().generic_string();
+    }
+
+    bool ShaderCache::RunCompiler(const fs::path& sourcePath, const fs::path& outputPath, const fs::path& includeDirectory) const
+    {
+        if (_compilerPath.empty())
+        {
+            NC_LOG_ERROR("No shader compiler was set up, can't recompile %s", sourcePath.string().c_str());
+            return false;
+        }
+
+        // Same arguments as the shaders target passes it
+        std::string command = "\"" + _compilerPath.string() + "\" \"" + sourcePath.string() + "\" \"" + outputPath.string() + "\" \"" + includeDirectory.string() + "\"";
+#ifdef _WIN32
+        // cmd strips the outer quotes when the command starts with one
+        command = "\"" + command + "\"";
+#endif
+
+        std::error_code errorCode;
+        return std::system(command.c_str()) == 0 && fs::exists(outputPath, errorCode);
+    }
+}
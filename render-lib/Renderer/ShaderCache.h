@@ -0,0 +1,81 @@
+#pragma once
+#include <NovusTypes.h>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Descriptors/ShaderCacheDesc.h"
+
+namespace Renderer
+{
+    // Keeps compiled SPIR-V under the cache directory keyed by a hash of the HLSL source and everything it #includes, so editing
+    // an .inc.hlsl invalidates every shader that includes it and a shader recompiled at runtime is still used after a restart
+    // Nothing in here touches the GPU, the backend turns the binaries into shader modules
+    class ShaderCache
+    {
+    public:
+        static constexpr u32 VERSION = 1; // Bump this to invalidate every cached shader
+
+        // Compiles sourcePath into outputPath, includes that aren't relative to the source are resolved from includeDirectory
+        using CompileFunc = std::function<bool(const std::filesystem::path& sourcePath, const std::filesystem::path& outputPath, const std::filesystem::path& includeDirectory)>;
+
+        // Scans every shader under the source directory, returns false and stays disabled if there are no sources
+        bool Init(const ShaderCacheDesc& desc);
+        bool IsEnabled() const { return !_sourceDirectory.empty(); }
+
+        // Replaces running the shader cooker, set this before compiling anything
+        void SetCompiler(CompileFunc compiler) { _compiler = compiler; }
+
+        // Maps a compiled shader path like Data/shaders/terrain.vs.hlsl.spv to the source it was compiled from
+        bool FindSource(const std::string& shaderPath, std::filesystem::path& sourcePath) const;
+
+        // Loads the binary compiled from the current version of sourcePath and its includes, returns false if there is none
+        bool Load(const std::filesystem::path& sourcePath, std::vector<char>& binary);
+
+        // Compiles the current version of sourcePath into the cache and loads the result
+        bool Compile(const std::filesystem::path& sourcePath, std::vector<char>& binary);
+
+        // Rescans the source directory and returns every shader whose source or includes changed since Init or the previous call
+        void GetChangedShaders(std::vector<std::filesystem::path>& sourcePaths);
+
+        // Returns every shader that includes path, directly or through other includes
+        void GetDependents(const std::filesystem::path& path, std::vector<std::filesystem::path>& sourcePaths) const;
+
+        // Hash of the source and all of its includes, this is what cached binaries are keyed by
+        u64 GetShaderKey(const std::filesystem::path& sourcePath) const;
+
+        size_t GetNumShaders() const { return _shaderNames.size(); }
+
+    private:
+        struct SourceFile
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type writeTime;
+            u64 hash = 0;
+            std::vector<std::string> includes; // Keys into _files
+            bool isShader = false; // False for .inc.hlsl, those are only ever compiled as part of a shader
+        };
+
+        // Rehashes every file that was written since the last scan, returns true if anything was added, changed or removed
+        bool Scan();
+        bool ReadFile(const std::filesystem::path& path, SourceFile& file) const;
+        std::filesystem::path ResolveInclude(const std::filesystem::path& includingPath, const std::string& include) const;
+
+        void AppendKey(const std::string& fileKey, std::vector<u64>& hashes, std::vector<std::string>& visited) const;
+        std::filesystem::path GetCachePath(const std::filesystem::path& sourcePath, u64 shaderKey) const;
+        static std::string GetFileKey(const std::filesystem::path& path);
+
+        bool RunCompiler(const std::filesystem::path& sourcePath, const std::filesystem::path& outputPath, const std::filesystem::path& includeDirectory) const;
+
+    private:
+        std::filesystem::path _sourceDirectory;
+        std::filesystem::path _cacheDirectory;
+        std::filesystem::path _compilerPath;
+        CompileFunc _compiler = nullptr;
+
+        std::unordered_map<std::string, SourceFile> _files;
+        std::unordered_map<std::string, std::string> _shaderNames; // File name to key into _files, compiled shaders are flattened into one folder
+        std::unordered_map<std::string, u64> _shaderKeys; // The key of every shader as of the last GetChangedShaders
+    };
+}
@@ -15,9 +15,23 @@ struct InstanceData
     float4x4 instanceMatrix;
 };
 
+// Matches MapObjectVertexQuantizer::MeshVertexHeader, sits at the start of _vertexPositions
+struct MeshVertexHeader
+{
+    float3 positionMin;
+    uint vertexFormat;
+    float3 positionExtent;
+    uint padding;
+};
+
+#define VERTEX_FORMAT_FLOAT (0)
+#define VERTEX_FORMAT_QUANTIZED (1)
+#define MESH_VERTEX_HEADER_SIZE (32)
+
 struct Vertex
 {
     float3 position;
+    float3 normal;
     float2 uv0;
     float2 uv1;
 };
@@ -44,16 +58,54 @@ InstanceData LoadInstanceData(uint instanceID)
     return instanceData;
 }
 
+float3 DecodeOctahedralNormal(uint packed)
+{
+    // Two 16 bit snorms, same layout as glm::packSnorm2x16
+    float2 encoded = max(float2(asint(uint2(packed << 16, packed)) >> 16) / 32767.0f, -1.0f);
+
+    float3 normal = float3(encoded.x, encoded.y, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+
+    return normalize(normal);
+}
+
+float2 DecodeHalf2(uint packed)
+{
+    return float2(f16tof32(packed), f16tof32(packed >> 16));
+}
+
 Vertex LoadVertex(uint vertexID)
 {
     Vertex vertex;
 
-    vertex.position = _vertexPositions.Load<float3>(vertexID * 12); // 12 = sizeof(float3)
-    vertex.uv0 = _vertexUVs.Load<float2>(vertexID * 16); // 16 = sizeof(float2) * 2 because we have 2 sets of UVs
-    vertex.uv1 = _vertexUVs.Load<float2>(vertexID * 16 + 8); // 16 = sizeof(float2) * 2 because we have 2 sets of UVs
+    MeshVertexHeader header = _vertexPositions.Load<MeshVertexHeader>(0);
+
+    if (header.vertexFormat == VERTEX_FORMAT_QUANTIZED)
+    {
+        // 16 bit unorm positions relative to the mesh AABB, the 4th component is padding
+        uint2 packedPosition = _vertexPositions.Load2(MESH_VERTEX_HEADER_SIZE + vertexID * 8); // 8 = sizeof(u16) * 4
+        float3 quantizedPosition = float3(packedPosition.x & 0xFFFF, packedPosition.x >> 16, packedPosition.y & 0xFFFF);
+        vertex.position = header.positionMin + quantizedPosition * (header.positionExtent / 65535.0f);
+
+        vertex.normal = DecodeOctahedralNormal(_vertexNormals.Load(vertexID * 4)); // 4 = sizeof(u32)
+
+        uint2 packedUVs = _vertexUVs.Load2(vertexID * 8); // 8 = sizeof(u32) * 2 because we have 2 sets of UVs
+        vertex.uv0 = DecodeHalf2(packedUVs.x);
+        vertex.uv1 = DecodeHalf2(packedUVs.y);
+    }
+    else
+    {
+        vertex.position = _vertexPositions.Load<float3>(MESH_VERTEX_HEADER_SIZE + vertexID * 12); // 12 = sizeof(float3)
+        vertex.normal = _vertexNormals.Load<float3>(vertexID * 12); // 12 = sizeof(float3)
+        vertex.uv0 = _vertexUVs.Load<float2>(vertexID * 16); // 16 = sizeof(float2) * 2 because we have 2 sets of UVs
+        vertex.uv1 = _vertexUVs.Load<float2>(vertexID * 16 + 8); // 16 = sizeof(float2) * 2 because we have 2 sets of UVs
+    }
 
     // TODO: Remove this from the shader, we want to do this in the dataextractor instead
     vertex.position = float3(-vertex.position.x, vertex.position.z, -vertex.position.y);
+    vertex.normal = float3(-vertex.normal.x, vertex.normal.z, -vertex.normal.y);
 
     return vertex;
 }
@@ -6,6 +6,20 @@
 };
 [[vk::binding(1, PER_PASS)]] ByteAddressBuffer _vertexHeights;
 [[vk::binding(2, PER_PASS)]] ByteAddressBuffer _cellDataVS;
+[[vk::binding(9, PER_PASS)]] ByteAddressBuffer _cellHeightHeaders;
+
+#define HEIGHT_FORMAT_FLOAT (0)
+#define HEIGHT_FORMAT_16BIT (1)
+#define HEIGHT_FORMAT_8BIT (2)
+
+// Has to match TerrainHeightQuantizer::CellHeightHeader
+struct CellHeightHeader
+{
+    float heightMin;
+    float heightStep;
+    uint dataOffset;
+    uint format;
+};
 
 struct VSInput
 {
@@ -26,12 +40,33 @@ struct Vertex
     float2 uv;
 };
 
+// heightMin and heightStep are on a power of two grid every cell shares, so the decode is exact and neighbouring cells agree on shared vertices
+float LoadHeight(uint globalCellID, uint vertexID)
+{
+    const CellHeightHeader header = _cellHeightHeaders.Load<CellHeightHeader>(globalCellID * 16); // 16 = sizeof(CellHeightHeader)
+
+    if (header.format == HEIGHT_FORMAT_8BIT)
+    {
+        // Four heights per uint, loads have to be 4 byte aligned
+        const uint packedHeights = _vertexHeights.Load(header.dataOffset + (vertexID & ~3u));
+        const uint quantizedHeight = (packedHeights >> ((vertexID & 3) * 8)) & 0xff;
+        return header.heightMin + float(quantizedHeight) * header.heightStep;
+    }
+    else if (header.format == HEIGHT_FORMAT_16BIT)
+    {
+        const uint packedHeights = _vertexHeights.Load(header.dataOffset + ((vertexID * 2) & ~3u)); // 2 = sizeof(u16)
+        const uint quantizedHeight = (packedHeights >> ((vertexID & 1) * 16)) & 0xffff;
+        return header.heightMin + float(quantizedHeight) * header.heightStep;
+    }
+
+    return _vertexHeights.Load<float>(header.dataOffset + vertexID * 4); // 4 = sizeof(float)
+}
+
 Vertex LoadVertex(uint chunkID, uint cellID, uint vertexID)
 {
     // Load height
     const uint globalCellID = GetGlobalCellID(chunkID, cellID);
-    const uint heightIndex = (globalCellID * NUM_VERTICES_PER_CELL) + vertexID;
-    const float height = _vertexHeights.Load<float>(heightIndex * 4); // 4 = sizeof(float) 
+    const float height = LoadHeight(globalCellID, vertexID);
 
     float2 cellPos = GetCellPosition(chunkID, cellID);
     float2 vertexPos = GetCellSpaceVertexPosition(vertexID);
@@ -0,0 +1,117 @@
+#include "EntitySimulator.h"
+#include <glm/gtc/constants.hpp>
+#include <cstring>
+#include <random>
+
+namespace StandIn
+{
+    constexpr vec3 ENTITY_SCALE = vec3(0.5f, 2.0f, 0.5f);
+
+    static void AppendHeader(std::vector<u8>& out, Opcode opcode, u16 payloadSize)
+    {
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(Opcode) + sizeof(u16));
+
+        std::memcpy(&out[offset], &opcode, sizeof(Opcode));
+        std::memcpy(&out[offset + sizeof(Opcode)], &payloadSize, sizeof(u16));
+    }
+
+    template <typename T>
+    static void Append(std::vector<u8>& out, const T& value)
+    {
+        const size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(&out[offset], &value, sizeof(T));
+    }
+
+    void EntitySimulator::Init(const EntitySimulatorDesc& desc)
+    {
+        _desc = desc;
+
+        std::mt19937 rng(desc.seed);
+        std::uniform_real_distribution<f32> unitDistribution(0.0f, 1.0f);
+
+        _entities.resize(desc.numEntities);
+        for (Entity& entity : _entities)
+        {
+            const f32 centerAngle = unitDistribution(rng) * glm::two_pi<f32>();
+            const f32 centerDistance = unitDistribution(rng) * desc.radius;
+
+            entity.orbitCenter = desc.center + vec3(glm::cos(centerAngle), 0.0f, glm::sin(centerAngle)) * centerDistance;
+            entity.orbitRadius = 2.0f + unitDistribution(rng) * 18.0f;
+            entity.angle = unitDistribution(rng) * glm::two_pi<f32>();
+
+            const f32 speed = desc.minSpeed + unitDistribution(rng) * (desc.maxSpeed - desc.minSpeed);
+            entity.angularSpeed = (unitDistribution(rng) < 0.5f ? -speed : speed) / entity.orbitRadius;
+        }
+
+        Step(0.0f);
+    }
+
+    void EntitySimulator::Step(f32 deltaTime)
+    {
+        for (Entity& entity : _entities)
+        {
+            entity.angle = glm::mod(entity.angle + entity.angularSpeed * deltaTime, glm::two_pi<f32>());
+
+            entity.position = entity.orbitCenter + vec3(glm::cos(entity.angle), 0.0f, glm::sin(entity.angle)) * entity.orbitRadius;
+
+            // Face along the orbit
+            entity.rotation = vec3(0.0f, glm::degrees(entity.angle) + (entity.angularSpeed < 0.0f ? 180.0f : 0.0f), 0.0f);
+        }
+    }
+
+    void EntitySimulator::WriteCreatePlayer(u32 playerId, std::vector<u8>& out) const
+    {
+        WriteCreate(Opcode::SMSG_CREATE_PLAYER, playerId, _desc.center, vec3(0.0f), out);
+    }
+
+    void EntitySimulator::WriteCreateEntities(std::vector<u8>& out) const
+    {
+        out.reserve(out.size() + _entities.size() * (sizeof(Opcode) + sizeof(u16) + CREATE_ENTITY_PAYLOAD_SIZE));
+
+        for (u32 i = 0; i < _entities.size(); i++)
+        {
+            WriteCreate(Opcode::SMSG_CREATE_ENTITY, GetEntityId(i), _entities[i].position, _entities[i].rotation, out);
+        }
+    }
+
+    u32 EntitySimulator::WriteUpdateEntities(std::vector<u8>& out) const
+    {
+        out.reserve(out.size() + _entities.size() * (sizeof(Opcode) + sizeof(u16) + UPDATE_ENTITY_PAYLOAD_SIZE));
+
+        for (u32 i = 0; i < _entities.size(); i++)
+        {
+            AppendHeader(out, Opcode::SMSG_UPDATE_ENTITY, UPDATE_ENTITY_PAYLOAD_SIZE);
+            Append(out, GetEntityId(i));
+            Append(out, _entities[i].position);
+            Append(out, _entities[i].rotation);
+            Append(out, ENTITY_SCALE);
+        }
+
+        return static_cast<u32>(_entities.size());
+    }
+
+    void EntitySimulator::WriteDeleteEntities(std::vector<u8>& out) const
+    {
+        for (u32 i = 0; i < _entities.size(); i++)
+        {
+            AppendHeader(out, Opcode::SMSG_DELETE_ENTITY, sizeof(u32));
+            Append(out, GetEntityId(i));
+        }
+    }
+
+    void EntitySimulator::WriteCreate(Opcode opcode, u32 entityId, const vec3& position, const vec3& rotation, std::vector<u8>& out) const
+    {
+        constexpr u8 ENTITY_TYPE = 0;
+        constexpr u32 ENTRY_ID = 0;
+
+        AppendHeader(out, opcode, CREATE_ENTITY_PAYLOAD_SIZE);
+        Append(out, entityId);
+        Append(out, ENTITY_TYPE);
+        Append(out, ENTRY_ID);
+        Append(out, position);
+        Append(out, rotation);
+        Append(out, ENTITY_SCALE);
+    }
+}
@@ -0,0 +1,90 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <Networking/Opcode.h>
+#include <vector>
+
+namespace StandIn
+{
+    struct EntitySimulatorDesc
+    {
+        u32 seed = 1337;
+        u32 numEntities = 0;
+
+        // Entities circle around random points inside this radius of center
+        vec3 center = vec3(-9321.f, 108.11f, 50.f);
+        f32 radius = 100.0f;
+        f32 minSpeed = 2.0f; // yards per second
+        f32 maxSpeed = 7.0f;
+
+        // Entity ids start here so they can't collide with the player id
+        u32 firstEntityId = 1;
+    };
+
+    // Deterministic synthetic entities, everything is derived from the seed and the elapsed time so two runs send identical packets
+    // Packets are written exactly like a NovusCore game server writes them, opcode and payload size followed by the payload
+    class EntitySimulator
+    {
+    public:
+        void Init(const EntitySimulatorDesc& desc);
+        void Step(f32 deltaTime);
+
+        // The player is created at center, it's the entity the client controls
+        void WriteCreatePlayer(u32 playerId, std::vector<u8>& out) const;
+
+        // One SMSG_CREATE_ENTITY per entity
+        void WriteCreateEntities(std::vector<u8>& out) const;
+
+        // One SMSG_UPDATE_ENTITY per entity, returns the number of updates written
+        u32 WriteUpdateEntities(std::vector<u8>& out) const;
+
+        // One SMSG_DELETE_ENTITY per entity
+        void WriteDeleteEntities(std::vector<u8>& out) const;
+
+        u32 GetNumEntities() const { return static_cast<u32>(_entities.size()); }
+        u32 GetEntityId(u32 index) const { return _desc.firstEntityId + index; }
+
+        static constexpr u16 CREATE_ENTITY_PAYLOAD_SIZE = sizeof(u32) + sizeof(u8) + sizeof(u32) + sizeof(vec3) * 3;
+        static constexpr u16 UPDATE_ENTITY_PAYLOAD_SIZE = sizeof(u32) + sizeof(vec3) * 3;
+
+    private:
+        struct Entity
+        {
+            vec3 orbitCenter;
+            f32 orbitRadius;
+            f32 angle;
+            f32 angularSpeed;
+
+            vec3 position;
+            vec3 rotation;
+        };
+
+        void WriteCreate(Opcode opcode, u32 entityId, const vec3& position, const vec3& rotation, std::vector<u8>& out) const;
+
+    private:
+        EntitySimulatorDesc _desc;
+        std::vector<Entity> _entities;
+    };
+}
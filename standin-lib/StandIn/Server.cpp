@@ -0,0 +1,419 @@
+#include "Server.h"
+#include <asio.hpp>
+#include <Networking/NetworkPacket.h>
+#include <Networking/MessageHandler.h>
+#include <Networking/NetworkClient.h>
+#include <Utils/ByteBuffer.h>
+#include <Utils/DebugHandler.h>
+#include <Utils/srp.h>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace StandIn
+{
+    constexpr size_t HEADER_SIZE = sizeof(Opcode) + sizeof(u16);
+    constexpr u32 PLAYER_ENTITY_ID = 0;
+
+    struct Server::Listener
+    {
+        Listener(asio::io_service& ioService, Role inRole) : acceptor(ioService), role(inRole) { }
+
+        asio::ip::tcp::acceptor acceptor;
+        Role role;
+    };
+
+    class Session : public std::enable_shared_from_this<Session>
+    {
+    public:
+        Session(Server* server, Server::Role role, asio::ip::tcp::socket socket)
+            : _server(server)
+            , _role(role)
+            , _socket(std::move(socket))
+            , _updateTimer(_socket.get_executor())
+        { }
+
+        void Start()
+        {
+            _server->_connections++;
+            ReadHeader();
+        }
+
+    private:
+        void ReadHeader()
+        {
+            std::shared_ptr<Session> self = shared_from_this();
+            asio::async_read(_socket, asio::buffer(_header, HEADER_SIZE), [this, self](const asio::error_code& error, size_t)
+            {
+                if (error)
+                    return Close();
+
+                std::memcpy(&_opcode, _header, sizeof(Opcode));
+                std::memcpy(&_payloadSize, _header + sizeof(Opcode), sizeof(u16));
+
+                if (_payloadSize > NETWORK_BUFFER_SIZE)
+                {
+                    NC_LOG_WARNING("[StandIn]: Closing connection, payload of %u bytes is too large", _payloadSize);
+                    return Close();
+                }
+
+                _payload = Bytebuffer::Borrow<NETWORK_BUFFER_SIZE>();
+                _payload->size = _payloadSize;
+                _payload->writtenData = _payloadSize;
+
+                if (_payloadSize == 0)
+                    return OnPacket();
+
+                asio::async_read(_socket, asio::buffer(_payload->GetDataPointer(), _payloadSize), [this, self](const asio::error_code& error, size_t)
+                {
+                    if (error)
+                        return Close();
+
+                    OnPacket();
+                });
+            });
+        }
+
+        void OnPacket()
+        {
+            _server->_packetsReceived++;
+
+            bool result = false;
+            switch (_role)
+            {
+                case Server::Role::Region: result = HandleRegionPacket(); break;
+                case Server::Role::Auth: result = HandleAuthPacket(); break;
+                case Server::Role::Game: result = HandleGamePacket(); break;
+            }
+
+            if (!result)
+                return Close();
+
+            ReadHeader();
+        }
+
+        bool HandleRegionPacket()
+        {
+            if (_opcode != Opcode::MSG_REQUEST_ADDRESS)
+                return true;
+
+            asio::error_code error;
+            const asio::ip::address_v4 address = asio::ip::make_address_v4(_server->_desc.address, error);
+            if (error)
+            {
+                NC_LOG_ERROR("[StandIn]: %s is not a valid IPv4 address", _server->_desc.address.c_str());
+                return false;
+            }
+
+            const u8 status = 1;
+            const u32 authAddress = address.to_uint();
+            const u16 authPort = _server->_desc.authPort;
+
+            std::shared_ptr<std::vector<u8>> packet = BeginPacket(Opcode::SMSG_SEND_ADDRESS);
+            Append(*packet, status);
+            Append(*packet, authAddress);
+            Append(*packet, authPort);
+            EndPacket(*packet, 0);
+
+            Send(packet, 1);
+            return true;
+        }
+
+        bool HandleAuthPacket()
+        {
+            if (_opcode == Opcode::CMSG_LOGON_CHALLENGE)
+            {
+                ClientLogonChallenge logonChallenge;
+                logonChallenge.Deserialize(_payload);
+
+                // There is no account database, the salt and verifier are derived from the configured password for whoever logs in
+                if (!_srp.CreateSaltAndVerifier(logonChallenge.username, _server->_desc.password))
+                    return false;
+
+                if (!_srp.StartVerification(logonChallenge.A))
+                {
+                    NC_LOG_WARNING("[StandIn]: Rejected logon challenge from %s, A failed the SRP safety check", logonChallenge.username.c_str());
+                    return false;
+                }
+
+                ServerLogonChallenge serverChallenge;
+                serverChallenge.status = 0;
+                std::memcpy(serverChallenge.s, _srp.s, sizeof(serverChallenge.s));
+                std::memcpy(serverChallenge.B, _srp.B, sizeof(serverChallenge.B));
+
+                SendSerialized(Opcode::SMSG_LOGON_CHALLENGE, serverChallenge);
+                return true;
+            }
+            else if (_opcode == Opcode::CMSG_LOGON_HANDSHAKE)
+            {
+                ClientLogonHandshake logonHandshake;
+                logonHandshake.Deserialize(_payload);
+
+                if (!_srp.VerifySession(logonHandshake.M1))
+                {
+                    NC_LOG_WARNING("[StandIn]: Rejected logon handshake, the client proof does not match");
+                    return false;
+                }
+
+                ServerLogonHandshake serverHandshake;
+                std::memcpy(serverHandshake.HAMK, _srp.HAMK, sizeof(serverHandshake.HAMK));
+
+                SendSerialized(Opcode::SMSG_LOGON_HANDSHAKE, serverHandshake);
+                return true;
+            }
+            else if (_opcode == Opcode::CMSG_CONNECTED)
+            {
+                _server->_logins++;
+                return true;
+            }
+
+            return true;
+        }
+
+        bool HandleGamePacket()
+        {
+            // Movement from the client is only counted, the stand-in has no world to apply it to
+            if (_worldCreated)
+                return true;
+
+            _worldCreated = true;
+            _simulator.Init(_server->_desc.entities);
+
+            std::shared_ptr<std::vector<u8>> packets = std::make_shared<std::vector<u8>>();
+            _simulator.WriteCreatePlayer(PLAYER_ENTITY_ID, *packets);
+            _simulator.WriteCreateEntities(*packets);
+            Send(packets, 1 + _simulator.GetNumEntities());
+
+            if (_server->_desc.updateRate > 0.0f && _simulator.GetNumEntities() > 0)
+            {
+                _lastUpdate = std::chrono::steady_clock::now();
+                ScheduleUpdate();
+            }
+
+            return true;
+        }
+
+        void ScheduleUpdate()
+        {
+            const auto interval = std::chrono::duration<f32>(1.0f / _server->_desc.updateRate);
+            _updateTimer.expires_after(std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval));
+
+            std::shared_ptr<Session> self = shared_from_this();
+            _updateTimer.async_wait([this, self](const asio::error_code& error)
+            {
+                if (error || !_socket.is_open())
+                    return;
+
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                _simulator.Step(std::chrono::duration<f32>(now - _lastUpdate).count());
+                _lastUpdate = now;
+
+                // One write per tick no matter how many entities there are, the same way a real server batches its updates
+                std::shared_ptr<std::vector<u8>> packets = std::make_shared<std::vector<u8>>();
+                const u32 numUpdates = _simulator.WriteUpdateEntities(*packets);
+                Send(packets, numUpdates);
+
+                _server->_entityUpdatesSent += numUpdates;
+                ScheduleUpdate();
+            });
+        }
+
+        template <typename T>
+        void SendSerialized(Opcode opcode, T& message)
+        {
+            std::shared_ptr<Bytebuffer> buffer = Bytebuffer::Borrow<NETWORK_BUFFER_SIZE>();
+            message.Serialize(buffer);
+
+            std::shared_ptr<std::vector<u8>> packet = BeginPacket(opcode);
+            packet->insert(packet->end(), buffer->GetDataPointer(), buffer->GetDataPointer() + buffer->writtenData);
+            EndPacket(*packet, 0);
+
+            Send(packet, 1);
+        }
+
+        static std::shared_ptr<std::vector<u8>> BeginPacket(Opcode opcode)
+        {
+            std::shared_ptr<std::vector<u8>> packet = std::make_shared<std::vector<u8>>(HEADER_SIZE);
+            std::memcpy(packet->data(), &opcode, sizeof(Opcode));
+            return packet;
+        }
+
+        static void EndPacket(std::vector<u8>& packet, size_t packetStart)
+        {
+            const u16 payloadSize = static_cast<u16>(packet.size() - packetStart - HEADER_SIZE);
+            std::memcpy(&packet[packetStart + sizeof(Opcode)], &payloadSize, sizeof(u16));
+        }
+
+        template <typename T>
+        static void Append(std::vector<u8>& out, const T& value)
+        {
+            const size_t offset = out.size();
+            out.resize(offset + sizeof(T));
+            std::memcpy(&out[offset], &value, sizeof(T));
+        }
+
+        void Send(std::shared_ptr<std::vector<u8>> data, u32 numPackets)
+        {
+            _server->_packetsSent += numPackets;
+            _server->_bytesSent += data->size();
+
+            // Writes are queued so only one async_write is in flight at a time, they would interleave otherwise
+            _writeQueue.push_back(std::move(data));
+            if (_writeQueue.size() == 1)
+            {
+                Write();
+            }
+        }
+
+        void Write()
+        {
+            std::shared_ptr<Session> self = shared_from_this();
+            asio::async_write(_socket, asio::buffer(*_writeQueue.front()), [this, self](const asio::error_code& error, size_t)
+            {
+                if (error)
+                    return Close();
+
+                _writeQueue.pop_front();
+                if (!_writeQueue.empty())
+                {
+                    Write();
+                }
+            });
+        }
+
+        void Close()
+        {
+            if (!_socket.is_open())
+                return;
+
+            asio::error_code error;
+            _socket.shutdown(asio::ip::tcp::socket::shutdown_both, error);
+            _socket.close(error);
+            _updateTimer.cancel();
+
+            _server->_connections--;
+        }
+
+    private:
+        Server* _server;
+        Server::Role _role;
+        asio::ip::tcp::socket _socket;
+        asio::steady_timer _updateTimer;
+
+        u8 _header[HEADER_SIZE];
+        Opcode _opcode = Opcode::INVALID;
+        u16 _payloadSize = 0;
+        std::shared_ptr<Bytebuffer> _payload = nullptr;
+
+        std::deque<std::shared_ptr<std::vector<u8>>> _writeQueue;
+
+        SRPVerifier _srp;
+
+        bool _worldCreated = false;
+        EntitySimulator _simulator;
+        std::chrono::steady_clock::time_point _lastUpdate;
+    };
+
+    Server::Server(const ServerDesc& desc) : _desc(desc)
+    {
+        _listeners[static_cast<u8>(Role::Region)] = std::make_unique<Listener>(_ioService, Role::Region);
+        _listeners[static_cast<u8>(Role::Auth)] = std::make_unique<Listener>(_ioService, Role::Auth);
+        _listeners[static_cast<u8>(Role::Game)] = std::make_unique<Listener>(_ioService, Role::Game);
+    }
+
+    Server::~Server()
+    {
+        Stop();
+    }
+
+    bool Server::Start()
+    {
+        if (_isRunning)
+            return true;
+
+        asio::error_code error;
+        const asio::ip::address address = asio::ip::make_address(_desc.address, error);
+        if (error)
+        {
+            NC_LOG_ERROR("[StandIn]: %s is not a valid address", _desc.address.c_str());
+            return false;
+        }
+
+        const u16 ports[3] = { _desc.regionPort, _desc.authPort, _desc.gamePort };
+        for (u8 i = 0; i < 3; i++)
+        {
+            asio::ip::tcp::acceptor& acceptor = _listeners[i]->acceptor;
+            const asio::ip::tcp::endpoint endpoint(address, ports[i]);
+
+            acceptor.open(endpoint.protocol(), error);
+            if (!error) acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true), error);
+            if (!error) acceptor.bind(endpoint, error);
+            if (!error) acceptor.listen(asio::socket_base::max_listen_connections, error);
+
+            if (error)
+            {
+                NC_LOG_ERROR("[StandIn]: Failed to listen on %s:%u (%s)", _desc.address.c_str(), ports[i], error.message().c_str());
+                Stop();
+                return false;
+            }
+
+            Accept(*_listeners[i]);
+        }
+
+        _isRunning = true;
+        _thread = std::thread([this]()
+        {
+            _ioService.run();
+        });
+
+        NC_LOG_SUCCESS("[StandIn]: Listening on %s, region %u, auth %u, game %u", _desc.address.c_str(), _desc.regionPort, _desc.authPort, _desc.gamePort);
+        return true;
+    }
+
+    void Server::Stop()
+    {
+        _ioService.stop();
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+
+        for (std::unique_ptr<Listener>& listener : _listeners)
+        {
+            asio::error_code error;
+            listener->acceptor.close(error);
+        }
+
+        _ioService.restart();
+        _isRunning = false;
+    }
+
+    ServerStats Server::GetStats() const
+    {
+        ServerStats stats;
+        stats.connections = _connections;
+        stats.logins = _logins;
+        stats.packetsReceived = _packetsReceived;
+        stats.packetsSent = _packetsSent;
+        stats.bytesSent = _bytesSent;
+        stats.entityUpdatesSent = _entityUpdatesSent;
+
+        return stats;
+    }
+
+    void Server::Accept(Listener& listener)
+    {
+        listener.acceptor.async_accept([this, &listener](const asio::error_code& error, asio::ip::tcp::socket socket)
+        {
+            if (error)
+                return;
+
+            asio::error_code optionError;
+            socket.set_option(asio::ip::tcp::no_delay(true), optionError);
+
+            std::make_shared<Session>(this, listener.role, std::move(socket))->Start();
+            Accept(listener);
+        });
+    }
+}
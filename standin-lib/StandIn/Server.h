@@ -0,0 +1,112 @@
+/*
+    MIT License
+
+    Copyright (c) 2018-2020 NovusCore
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+*/
+#pragma once
+#include <NovusTypes.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <asio/io_service.hpp>
+
+#include "EntitySimulator.h"
+
+namespace StandIn
+{
+    struct ServerDesc
+    {
+        // Only ever listens on this address, the region server hands it out as the auth server address
+        std::string address = "127.0.0.1";
+        u16 regionPort = 3724;
+        u16 authPort = 3725;
+        u16 gamePort = 4500;
+
+        // Every username is accepted as long as the SRP exchange proves this password
+        std::string password = "test";
+
+        EntitySimulatorDesc entities;
+
+        // SMSG_UPDATE_ENTITY packets per entity per second, 0 only creates the entities
+        f32 updateRate = 10.0f;
+    };
+
+    struct ServerStats
+    {
+        u32 connections = 0;
+        u32 logins = 0;
+
+        u64 packetsReceived = 0;
+        u64 packetsSent = 0;
+        u64 bytesSent = 0;
+        u64 entityUpdatesSent = 0;
+    };
+
+    class Session;
+
+    // Stand-in for the NovusCore region, auth and game servers, it speaks the same opcodes the client handlers expect
+    // Region: MSG_REQUEST_ADDRESS is answered with SMSG_SEND_ADDRESS pointing at the auth port
+    // Auth: CMSG_LOGON_CHALLENGE and CMSG_LOGON_HANDSHAKE complete a real SRP-6a exchange
+    // Game: the first packet creates the player and the synthetic entities, which are then updated at updateRate
+    class Server
+    {
+    public:
+        Server(const ServerDesc& desc);
+        ~Server();
+
+        // Binds all listeners and starts serving on a background thread
+        bool Start();
+        void Stop();
+
+        bool IsRunning() const { return _isRunning; }
+        ServerStats GetStats() const;
+        const ServerDesc& GetDesc() const { return _desc; }
+
+    private:
+        enum class Role : u8
+        {
+            Region,
+            Auth,
+            Game
+        };
+
+        struct Listener;
+        void Accept(Listener& listener);
+
+    private:
+        ServerDesc _desc;
+        bool _isRunning = false;
+
+        asio::io_service _ioService;
+        std::unique_ptr<Listener> _listeners[3];
+        std::thread _thread;
+
+        std::atomic<u32> _connections = 0;
+        std::atomic<u32> _logins = 0;
+        std::atomic<u64> _packetsReceived = 0;
+        std::atomic<u64> _packetsSent = 0;
+        std::atomic<u64> _bytesSent = 0;
+        std::atomic<u64> _entityUpdatesSent = 0;
+
+        friend class Session;
+    };
+}
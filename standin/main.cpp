@@ -0,0 +1,105 @@
+#include <Utils/DebugHandler.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <StandIn/Server.h>
+
+void PrintUsage()
+{
+    NC_LOG_MESSAGE("Usage: standin-server [options]");
+    NC_LOG_MESSAGE("  --address <ip>            Address to listen on and to hand out to the client (default 127.0.0.1)");
+    NC_LOG_MESSAGE("  --region-port <port>      Region server port (default 3724)");
+    NC_LOG_MESSAGE("  --auth-port <port>        Auth server port (default 3725)");
+    NC_LOG_MESSAGE("  --game-port <port>        Game server port (default 4500)");
+    NC_LOG_MESSAGE("  --password <password>     Password every account logs in with (default test)");
+    NC_LOG_MESSAGE("  --entities <count>        Synthetic entities created for every game connection (default 0)");
+    NC_LOG_MESSAGE("  --rate <hz>               Entity updates per entity per second (default 10)");
+    NC_LOG_MESSAGE("  --seed <value>            Seed for the synthetic entities (default 1337)");
+    NC_LOG_MESSAGE("  --radius <yards>          Radius the entities are spread over (default 100)");
+    NC_LOG_MESSAGE("  --duration <seconds>      Exit after this many seconds, runs until killed by default");
+}
+
+i32 main(i32 argc, char* argv[])
+{
+    StandIn::ServerDesc desc;
+    f32 duration = 0.0f;
+
+    for (i32 i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--address" && hasValue)
+        {
+            desc.address = argv[++i];
+        }
+        else if (argument == "--region-port" && hasValue)
+        {
+            desc.regionPort = static_cast<u16>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--auth-port" && hasValue)
+        {
+            desc.authPort = static_cast<u16>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--game-port" && hasValue)
+        {
+            desc.gamePort = static_cast<u16>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--password" && hasValue)
+        {
+            desc.password = argv[++i];
+        }
+        else if (argument == "--entities" && hasValue)
+        {
+            desc.entities.numEntities = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--rate" && hasValue)
+        {
+            desc.updateRate = std::stof(argv[++i]);
+        }
+        else if (argument == "--seed" && hasValue)
+        {
+            desc.entities.seed = static_cast<u32>(std::stoul(argv[++i]));
+        }
+        else if (argument == "--radius" && hasValue)
+        {
+            desc.entities.radius = std::stof(argv[++i]);
+        }
+        else if (argument == "--duration" && hasValue)
+        {
+            duration = std::stof(argv[++i]);
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    StandIn::Server server(desc);
+    if (!server.Start())
+        return 1;
+
+    // Prints what was sent every second, entity updates/s is the rate the client has to ingest
+    StandIn::ServerStats lastStats = server.GetStats();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    while (duration <= 0.0f || std::chrono::steady_clock::now() - startTime < std::chrono::duration<f32>(duration))
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+
+        StandIn::ServerStats stats = server.GetStats();
+        NC_LOG_MESSAGE("[StandIn]: %u connections, %u logins, %llu packets/s received, %llu packets/s sent, %.2f KB/s sent, %llu entity updates/s",
+            stats.connections, stats.logins,
+            static_cast<unsigned long long>(stats.packetsReceived - lastStats.packetsReceived),
+            static_cast<unsigned long long>(stats.packetsSent - lastStats.packetsSent),
+            (stats.bytesSent - lastStats.bytesSent) / 1024.0,
+            static_cast<unsigned long long>(stats.entityUpdatesSent - lastStats.entityUpdatesSent));
+
+        lastStats = stats;
+    }
+
+    server.Stop();
+    return 0;
+}